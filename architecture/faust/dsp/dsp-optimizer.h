@@ -192,6 +192,21 @@ class dsp_optimizer_real {
                 fVecOptionsTable.push_back(t1);
             }
             
+            // vec -lv 1 -simd 4/8 (explicit vector IR)
+            for (int lanes = 4; lanes <= 8; lanes *= 2) {
+                for (int size = lanes; size <= fBufferSize; size *= 2) {
+                    std::vector <std::string> t1;
+                    t1.push_back("-vec");
+                    t1.push_back("-lv");
+                    t1.push_back("1");
+                    t1.push_back("-vs");
+                    t1.push_back(std::to_string(size));
+                    t1.push_back("-simd");
+                    t1.push_back(std::to_string(lanes));
+                    fVecOptionsTable.push_back(t1);
+                }
+            }
+            
             /*
             // vec -lv 1 -g
             for (int size = 4; size <= fBufferSize; size *= 2) {
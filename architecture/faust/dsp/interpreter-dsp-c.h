@@ -230,6 +230,17 @@ extern "C"
      * @return true if success, false otherwise.
      */
     LIBFAUST_API bool writeCInterpreterDSPFactoryToBitcodeFile(interpreter_dsp_factory* factory, const char* bit_code_path);
+
+    /**
+     * Write a Faust DSP factory into a binary container file. The binary container can be loaded
+     * without parsing, and is accepted by readCInterpreterDSPFactoryFromBitcodeFile.
+     *
+     * @param factory - the DSP factory
+     * @param binary_path - the binary file pathname (using the .fbc extension)
+     *
+     * @return true if success, false otherwise.
+     */
+    LIBFAUST_API bool writeCInterpreterDSPFactoryToBinaryFile(interpreter_dsp_factory* factory, const char* binary_path);
     
     /**
      * Instance functions.
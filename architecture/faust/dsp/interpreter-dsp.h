@@ -219,6 +219,9 @@ LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromFile(const
  * allocated factories so that the compilation of same DSP code (that is same source code and 
  * same set of 'normalized' compilations options) will return the same (reference counted) factory pointer. You will have to explicitly
  * use deleteInterpreterDSPFactory to properly decrement reference counter when the factory is no more needed.
+ * When the FAUST_DSP_CACHE environment variable names a directory, the compiled bytecode is also kept
+ * there and directly reloaded by later runs, as long as the source, the compilation options, the target
+ * and the content of all imported library files are unchanged.
  * 
  * @param name_app - the name of the Faust program
  * @param dsp_content - the Faust program as a string
@@ -303,6 +306,8 @@ LIBFAUST_API std::vector<std::string> getAllInterpreterDSPFactories();
 
 /**
  * Start multi-thread access mode (since by default the library is not 'multi-thread' safe).
+ * Each compilation then runs in its own context, so factories can be created concurrently
+ * from several threads: only the factory table accesses are serialized.
  *
  * @return true if 'multi-thread' safe access is started.
  */
@@ -358,6 +363,27 @@ LIBFAUST_API interpreter_dsp_factory* readInterpreterDSPFactoryFromBitcodeFile(c
  */
 LIBFAUST_API bool writeInterpreterDSPFactoryToBitcodeFile(interpreter_dsp_factory* factory, const std::string& bit_code_path);
 
+/**
+ * Write a Faust DSP factory into a binary container string. The binary container can be loaded
+ * without parsing, and is accepted by readInterpreterDSPFactoryFromBitcode.
+ *
+ * @param factory - the DSP factory
+ *
+ * @return the binary container as a string.
+ */
+LIBFAUST_API std::string writeInterpreterDSPFactoryToBinary(interpreter_dsp_factory* factory);
+
+/**
+ * Write a Faust DSP factory into a binary container file. The binary container can be loaded
+ * without parsing, and is accepted by readInterpreterDSPFactoryFromBitcodeFile.
+ *
+ * @param factory - the DSP factory
+ * @param binary_path - the binary file pathname (using the .fbc extension)
+ *
+ * @return true if success, false otherwise.
+ */
+LIBFAUST_API bool writeInterpreterDSPFactoryToBinaryFile(interpreter_dsp_factory* factory, const std::string& binary_path);
+
 /*!
  @}
  */
@@ -229,6 +229,27 @@ LIBFAUST_API interpreter_dsp_factory* readInterpreterDSPFactoryFromBitcodeFile(c
  */
 LIBFAUST_API bool writeInterpreterDSPFactoryToBitcodeFile(interpreter_dsp_factory* factory, const std::string& bitcode_path);
 
+/**
+ * Write a Faust DSP factory into a binary container string. The binary container can be loaded
+ * without parsing, and is accepted by readInterpreterDSPFactoryFromBitcode.
+ *
+ * @param factory - the DSP factory
+ *
+ * @return the binary container as a string.
+ */
+LIBFAUST_API std::string writeInterpreterDSPFactoryToBinary(interpreter_dsp_factory* factory);
+
+/**
+ * Write a Faust DSP factory into a binary container file. The binary container can be loaded
+ * without parsing, and is accepted by readInterpreterDSPFactoryFromBitcodeFile.
+ *
+ * @param factory - the DSP factory
+ * @param binary_path - the binary file pathname (using the .fbc extension)
+ *
+ * @return true if success, false otherwise.
+ */
+LIBFAUST_API bool writeInterpreterDSPFactoryToBinaryFile(interpreter_dsp_factory* factory, const std::string& binary_path);
+
 /*!
  @}
  */
@@ -240,6 +240,10 @@ LIBFAUST_API llvm_dsp_factory* createDSPFactoryFromFile(const std::string& filen
  * allocated factories so that the compilation of the same DSP code (that is same source code and 
  * same set of 'normalized' compilations options) will return the same (reference counted) factory pointer. You will have to explicitly
  * use deleteDSPFactory to properly decrement reference counter when the factory is no more needed.
+ * When the FAUST_DSP_CACHE environment variable names a directory, the compiled machine code is also kept
+ * there and directly reloaded by later runs, as long as the source, the compilation options, the target
+ * and the content of all imported library files are unchanged. Factories compiled in lazy mode
+ * (FAUST_LLVM_LAZY) are not kept there, since they have no machine code for their whole module.
  * 
  * @param name_app - the name of the Faust program
  * @param dsp_content - the Faust program as a string
@@ -343,6 +347,8 @@ LIBFAUST_API std::vector<std::string> getAllDSPFactories();
 
 /**
  * Start multi-thread access mode (since by default the library is not 'multi-thread' safe).
+ * Each compilation (and its JIT) then runs in its own context, so factories can be created
+ * concurrently from several threads: only the factory table accesses are serialized.
  * 
  * @return true if 'multi-thread' safe access is started.
  */ 
@@ -0,0 +1,538 @@
+/*******************************************************************************
+********************************************************************************
+
+    compactdigraph : frozen directed graph in compressed sparse row form
+
+    Copyright © 2023 GRAME, Centre National de Creation Musicale
+
+ *******************************************************************************
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DirectedGraph.hh"
+#include "Schedule.hh"
+
+//===========================================================
+// compactdigraph : an immutable version of digraph<N> for
+// large graphs. The nodes are interned to dense integers
+// 0..size()-1, numbered in the order of digraph<N>::nodes()
+// (that is by increasing N), so that the algorithms below
+// visit the nodes in the same order as their digraph<N>
+// counterparts and produce the same results.
+//
+// The connections of node i are stored contiguously,
+// sorted by destination, in the connections range
+// [first(i), last(i)). Each connection has a sorted set
+// of weights.
+//
+// USAGE :
+//      compactdigraph<N>::builder b;
+//      b.add(n1, n2, 0); ...
+//      compactdigraph<N> g(b);
+// or   compactdigraph<N> g(mydigraph);
+//===========================================================
+
+template <typename N>
+class compactdigraph {
+   public:
+    // A range of integers (node indexes or weights) stored in the graph
+    class range {
+        const int* fBegin;
+        const int* fEnd;
+
+       public:
+        range(const int* b, const int* e) : fBegin(b), fEnd(e) {}
+        [[nodiscard]] const int* begin() const { return fBegin; }
+        [[nodiscard]] const int* end() const { return fEnd; }
+        [[nodiscard]] size_t     size() const { return fEnd - fBegin; }
+        [[nodiscard]] bool       empty() const { return fBegin == fEnd; }
+    };
+
+    //--------------------------------------------------------------------------
+    // builder : collects nodes and connections with the same interface as
+    // digraph<N>. Nodes are interned in a hash table, connections are kept
+    // in a flat vector until the graph is frozen.
+    //--------------------------------------------------------------------------
+    class builder {
+        friend class compactdigraph;
+
+        std::unordered_map<N, int>             fIndex;
+        std::vector<N>                         fNodes;
+        std::vector<std::tuple<int, int, int>> fConnections;  // (source, destination, weight)
+
+       public:
+        int add(const N& n)
+        {
+            auto r = fIndex.emplace(n, int(fNodes.size()));
+            if (r.second) {
+                fNodes.push_back(n);
+            }
+            return r.first->second;
+        }
+
+        builder& add(const N& n1, const N& n2, int d = 0)
+        {
+            int i1 = add(n1);
+            int i2 = add(n2);
+            fConnections.emplace_back(i1, i2, d);
+            return *this;
+        }
+
+        builder& add(const N& n1, const N& n2, const std::set<int>& w)
+        {
+            int i1 = add(n1);
+            int i2 = add(n2);
+            for (int d : w) {
+                fConnections.emplace_back(i1, i2, d);
+            }
+            return *this;
+        }
+    };
+
+   private:
+    std::vector<N>   fNodes;         // nodes sorted by increasing N
+    std::vector<int> fFirst;         // connections of node i are [fFirst[i], fFirst[i+1])
+    std::vector<int> fDestinations;  // destination of each connection
+    std::vector<int> fFirstWeight;   // weights of connection c start at fFirstWeight[c]
+    std::vector<int> fWeights;       // the weights of all the connections
+
+    // Build the compressed rows from the nodes (already sorted) and a list of
+    // (source, destination, weight) using indexes in fNodes
+    void freeze(std::vector<std::tuple<int, int, int>>& connections)
+    {
+        std::sort(connections.begin(), connections.end());
+        connections.erase(std::unique(connections.begin(), connections.end()), connections.end());
+
+        fFirst.assign(fNodes.size() + 1, 0);
+        fFirstWeight.clear();
+        fDestinations.clear();
+        fWeights.clear();
+        fWeights.reserve(connections.size());
+
+        int prevsrc = -1;
+        int prevdst = -1;
+        for (const auto& c : connections) {
+            int src = std::get<0>(c);
+            int dst = std::get<1>(c);
+            if (src != prevsrc || dst != prevdst) {
+                fDestinations.push_back(dst);
+                fFirstWeight.push_back(int(fWeights.size()));
+                fFirst[src + 1]++;
+                prevsrc = src;
+                prevdst = dst;
+            }
+            fWeights.push_back(std::get<2>(c));
+        }
+        fFirstWeight.push_back(int(fWeights.size()));
+        for (size_t i = 0; i < fNodes.size(); i++) {
+            fFirst[i + 1] += fFirst[i];
+        }
+    }
+
+   public:
+    compactdigraph() : fFirst(1, 0), fFirstWeight(1, 0) {}
+
+    // Freeze the content of a builder
+    explicit compactdigraph(const builder& b)
+    {
+        // number the nodes by increasing N
+        std::vector<int> order(b.fNodes.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = int(i);
+        }
+        std::sort(order.begin(), order.end(),
+                  [&b](int i, int j) { return b.fNodes[i] < b.fNodes[j]; });
+
+        std::vector<int> rank(order.size());
+        fNodes.reserve(order.size());
+        for (size_t r = 0; r < order.size(); r++) {
+            rank[order[r]] = int(r);
+            fNodes.push_back(b.fNodes[order[r]]);
+        }
+
+        std::vector<std::tuple<int, int, int>> connections;
+        connections.reserve(b.fConnections.size());
+        for (const auto& c : b.fConnections) {
+            connections.emplace_back(rank[std::get<0>(c)], rank[std::get<1>(c)], std::get<2>(c));
+        }
+        freeze(connections);
+    }
+
+    // Freeze a digraph
+    explicit compactdigraph(const digraph<N>& g) : fNodes(g.nodes().begin(), g.nodes().end())
+    {
+        std::vector<std::tuple<int, int, int>> connections;
+        for (size_t i = 0; i < fNodes.size(); i++) {
+            for (const auto& c : g.destinations(fNodes[i])) {
+                int j = index(c.first);
+                for (int d : c.second) {
+                    connections.emplace_back(int(i), j, d);
+                }
+            }
+        }
+        freeze(connections);
+    }
+
+    //--------------------------------------------------------------------------
+    // Methods used to visit the graph
+    //--------------------------------------------------------------------------
+
+    // number of nodes of the graph
+    [[nodiscard]] int size() const { return int(fNodes.size()); }
+
+    // the nodes of the graph, the position of a node being its index
+    [[nodiscard]] const std::vector<N>& nodes() const { return fNodes; }
+
+    // the node of index i
+    [[nodiscard]] const N& node(int i) const { return fNodes[i]; }
+
+    // the index of node n, -1 if n is not in the graph
+    [[nodiscard]] int index(const N& n) const
+    {
+        auto p = std::lower_bound(fNodes.begin(), fNodes.end(), n);
+        return (p != fNodes.end() && !(n < *p)) ? int(p - fNodes.begin()) : -1;
+    }
+
+    // the connections of node i are [first(i), last(i))
+    [[nodiscard]] int first(int i) const { return fFirst[i]; }
+    [[nodiscard]] int last(int i) const { return fFirst[i + 1]; }
+
+    // the destination of connection c
+    [[nodiscard]] int destination(int c) const { return fDestinations[c]; }
+
+    // the indexes of the destinations of node i, sorted
+    [[nodiscard]] range destinations(int i) const
+    {
+        return range(fDestinations.data() + fFirst[i], fDestinations.data() + fFirst[i + 1]);
+    }
+
+    // the weights of connection c, sorted
+    [[nodiscard]] range weights(int c) const
+    {
+        return range(fWeights.data() + fFirstWeight[c], fWeights.data() + fFirstWeight[c + 1]);
+    }
+
+    //--------------------------------------------------------------------------
+    // Methods used to query the graph
+    //--------------------------------------------------------------------------
+
+    // true is there is any connection between nodes i and j.
+    // The smallest weight is returned in d.
+    bool areConnected(int i, int j, int& d) const
+    {
+        const int* b = fDestinations.data() + fFirst[i];
+        const int* e = fDestinations.data() + fFirst[i + 1];
+        const int* p = std::lower_bound(b, e, j);
+        if (p != e && *p == j) {
+            d = *weights(int(p - fDestinations.data())).begin();
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    [[nodiscard]] bool areConnected(int i, int j) const
+    {
+        int d;
+        return areConnected(i, j, d);
+    }
+};
+
+//===========================================================
+//===========================================================
+// Algorithms on compact graphs. They follow the ones of
+// DirectedGraphAlgorythm.hh and Schedule.hh but work on
+// node indexes, use vectors instead of maps and explicit
+// stacks instead of recursion.
+//===========================================================
+//===========================================================
+
+template <typename N>
+inline std::vector<N> roots(const compactdigraph<N>& G)
+{
+    std::vector<int> R(G.size(), 0);
+    for (int i = 0; i < G.size(); i++) {
+        for (int j : G.destinations(i)) {
+            R[j]++;
+        }
+    }
+    std::vector<N> V;
+    for (int i = 0; i < G.size(); i++) {
+        if (R[i] == 0) {
+            V.push_back(G.node(i));
+        }
+    }
+    return V;
+}
+
+template <typename N>
+inline std::vector<N> leaves(const compactdigraph<N>& G)
+{
+    std::vector<N> L;
+    for (int i = 0; i < G.size(); i++) {
+        if (G.destinations(i).empty()) {
+            L.push_back(G.node(i));
+        }
+    }
+    return L;
+}
+
+/**
+ * @brief Deep first post-order visit of G starting from the node 'start'.
+ * Calls 'post' on every newly visited node after all its destinations.
+ */
+template <typename N, typename F>
+inline void dfvisit(const compactdigraph<N>& G, int start, std::vector<char>& visited, F post)
+{
+    if (visited[start]) {
+        return;
+    }
+    std::vector<std::pair<int, int>> stack;  // (node, next connection)
+    visited[start] = 1;
+    stack.emplace_back(start, G.first(start));
+    while (!stack.empty()) {
+        int n = stack.back().first;
+        int c = stack.back().second;
+        if (c < G.last(n)) {
+            stack.back().second++;
+            int m = G.destination(c);
+            if (!visited[m]) {
+                visited[m] = 1;
+                stack.emplace_back(m, G.first(m));
+            }
+        } else {
+            stack.pop_back();
+            post(n);
+        }
+    }
+}
+
+/**
+ * @brief Deep-first scheduling of a DAG G, same result as dfschedule(digraph<N>)
+ */
+template <typename N>
+inline schedule<N> dfschedule(const compactdigraph<N>& G)
+{
+    schedule<N>       S;
+    std::vector<char> V(G.size(), 0);  // visited nodes
+    std::vector<int>  R(G.size(), 0);  // number of sources of each node
+
+    for (int i = 0; i < G.size(); i++) {
+        for (int j : G.destinations(i)) {
+            R[j]++;
+        }
+    }
+    for (int i = 0; i < G.size(); i++) {
+        if (R[i] == 0) {
+            dfvisit(G, i, V, [&S, &G](int n) { S.append(G.node(n)); });
+        }
+    }
+    return S;
+}
+
+/**
+ * @brief Topological sort of G, same result as serialize(digraph<N>)
+ */
+template <typename N>
+inline std::vector<N> serialize(const compactdigraph<N>& G)
+{
+    std::vector<N>    S;
+    std::vector<char> V(G.size(), 0);
+    for (int i = 0; i < G.size(); i++) {
+        dfvisit(G, i, V, [&S, &G](int n) { S.push_back(G.node(n)); });
+    }
+    return S;
+}
+
+/**
+ * @brief Sequential vector of parallel vectors of nodes of a DAG, same result as
+ * parallelize(digraph<N>)
+ */
+template <typename N>
+inline std::vector<std::vector<N>> parallelize(const compactdigraph<N>& G)
+{
+    std::vector<int>  L(G.size(), 0);  // level of each node
+    std::vector<char> V(G.size(), 0);
+    int               l = -1;
+    for (int i = 0; i < G.size(); i++) {
+        dfvisit(G, i, V, [&L, &G](int n) {
+            int m = -1;
+            for (int j : G.destinations(n)) {
+                m = std::max(m, L[j]);
+            }
+            L[n] = m + 1;
+        });
+        l = std::max(l, L[i]);
+    }
+    std::vector<std::vector<N>> P(l + 1);
+    for (int i = 0; i < G.size(); i++) {
+        P[L[i]].push_back(G.node(i));
+    }
+    return P;
+}
+
+/**
+ * @brief Strongly connected components of G (iterative Tarjan algorithm).
+ *
+ * @param G the graph
+ * @param component filled with the component number of each node. Components are numbered
+ * in reverse topological order : a component only depends on components of smaller numbers.
+ * @return the number of components
+ */
+template <typename N>
+inline int components(const compactdigraph<N>& G, std::vector<int>& component)
+{
+    std::vector<int>                 num(G.size(), -1);
+    std::vector<int>                 low(G.size(), 0);
+    std::vector<int>                 stack;
+    std::vector<std::pair<int, int>> call;  // (node, next connection)
+    int                              counter = 0;
+    int                              count   = 0;
+
+    component.assign(G.size(), -1);
+    for (int r = 0; r < G.size(); r++) {
+        if (num[r] >= 0) {
+            continue;
+        }
+        num[r] = low[r] = counter++;
+        stack.push_back(r);
+        call.emplace_back(r, G.first(r));
+        while (!call.empty()) {
+            int v = call.back().first;
+            int c = call.back().second;
+            if (c < G.last(v)) {
+                call.back().second++;
+                int w = G.destination(c);
+                if (num[w] < 0) {
+                    num[w] = low[w] = counter++;
+                    stack.push_back(w);
+                    call.emplace_back(w, G.first(w));
+                } else if (component[w] < 0) {
+                    low[v] = std::min(low[v], num[w]);
+                }
+            } else {
+                call.pop_back();
+                if (!call.empty()) {
+                    int u  = call.back().first;
+                    low[u] = std::min(low[u], low[v]);
+                }
+                if (low[v] == num[v]) {
+                    int w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        component[w] = count;
+                    } while (w != v);
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief counts the number of cycles of G, same result as cycles(digraph<N>)
+ */
+template <typename N>
+inline int cycles(const compactdigraph<N>& G)
+{
+    std::vector<int> component;
+    int              n = components(G, component);
+    std::vector<int> size(n, 0);
+    std::vector<int> loop(n, 0);
+    for (int i = 0; i < G.size(); i++) {
+        size[component[i]]++;
+        if (G.areConnected(i, i)) {
+            loop[component[i]] = 1;
+        }
+    }
+    int count = 0;
+    for (int c = 0; c < n; c++) {
+        count += (size[c] > 1 || loop[c]) ? 1 : 0;
+    }
+    return count;
+}
+
+/**
+ * @brief reverse all the connections of a graph, keeping their weights
+ */
+template <typename N>
+inline compactdigraph<N> reverse(const compactdigraph<N>& G)
+{
+    typename compactdigraph<N>::builder B;
+    for (int i = 0; i < G.size(); i++) {
+        B.add(G.node(i));
+    }
+    for (int i = 0; i < G.size(); i++) {
+        for (int c = G.first(i); c < G.last(i); c++) {
+            for (int d : G.weights(c)) {
+                B.add(G.node(G.destination(c)), G.node(i), d);
+            }
+        }
+    }
+    return compactdigraph<N>(B);
+}
+
+/**
+ * @brief Convert back to a digraph
+ */
+template <typename N>
+inline digraph<N> expand(const compactdigraph<N>& G)
+{
+    digraph<N> R;
+    for (int i = 0; i < G.size(); i++) {
+        R.add(G.node(i));
+        for (int c = G.first(i); c < G.last(i); c++) {
+            for (int d : G.weights(c)) {
+                R.add(G.node(i), G.node(G.destination(c)), d);
+            }
+        }
+    }
+    return R;
+}
+
+//===========================================================
+//===========================================================
+// file << graph : print graph on a stream, same format as
+// digraph<N>
+//===========================================================
+//===========================================================
+
+template <typename N>
+inline std::ostream& operator<<(std::ostream& file, const compactdigraph<N>& g)
+{
+    std::string sep = "";
+
+    file << "Graph {";
+    for (int i = 0; i < g.size(); i++) {
+        bool hascnx = false;
+        for (int c = g.first(i); c < g.last(i); c++) {
+            hascnx = true;
+            file << sep << g.node(i) << "-set{";
+            std::string wsep = "";
+            for (int d : g.weights(c)) {
+                file << wsep << d;
+                wsep = ", ";
+            }
+            file << "}->" << g.node(g.destination(c));
+            sep = ", ";
+        }
+        if (!hascnx) {
+            file << sep << g.node(i);
+        }
+        sep = ", ";
+    }
+
+    return file << "}";
+}
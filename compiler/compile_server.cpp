@@ -0,0 +1,299 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "compatibility.hh"
+#include "compile_server.hh"
+#include "dsp_factory.hh"
+#include "global.hh"
+#include "libsnapshot.hh"
+
+using namespace std;
+
+#ifndef _WIN32
+
+/**
+ * Buffered reading and writing of the requests and responses on file descriptors.
+ */
+class ServerChannel {
+   private:
+    int    fIn;
+    int    fOut;
+    string fBuffer;
+    size_t fPos = 0;
+
+    bool fill()
+    {
+        char    buffer[65536];
+        ssize_t size;
+        do {
+            size = ::read(fIn, buffer, sizeof(buffer));
+        } while (size < 0 && errno == EINTR);
+        if (size <= 0) {
+            return false;
+        }
+        fBuffer.erase(0, fPos);
+        fPos = 0;
+        fBuffer.append(buffer, size_t(size));
+        return true;
+    }
+
+   public:
+    ServerChannel(int in, int out) : fIn(in), fOut(out) {}
+
+    bool readLine(string& line)
+    {
+        size_t end;
+        while ((end = fBuffer.find('\n', fPos)) == string::npos) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        line = fBuffer.substr(fPos, end - fPos);
+        fPos = end + 1;
+        return true;
+    }
+
+    bool readBytes(size_t size, string& res)
+    {
+        while (fBuffer.size() - fPos < size) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        res = fBuffer.substr(fPos, size);
+        fPos += size;
+        return true;
+    }
+
+    bool write(const string& data)
+    {
+        size_t done = 0;
+        while (done < data.size()) {
+            ssize_t size = ::write(fOut, data.data() + done, data.size() - done);
+            if (size < 0 && errno == EINTR) {
+                continue;
+            }
+            if (size <= 0) {
+                return false;
+            }
+            done += size_t(size);
+        }
+        return true;
+    }
+};
+
+/**
+ * Compile a DSP, returns the error message (empty if the compilation succeeded).
+ */
+static string compileRequest(const string& name, const vector<string>& args, const string& code,
+                             string& output, string& warnings)
+{
+    vector<const char*> argv;
+    argv.push_back("faust");
+    for (const auto& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+    argv.push_back(nullptr);
+
+    // What the compiler prints on cout is the output of the request
+    stringstream out;
+    streambuf*   prev = cout.rdbuf(out.rdbuf());
+    string       error_msg;
+    dsp_factory_base* factory =
+        createFactory(name, code, int(argv.size()) - 1, argv.data(), error_msg, true);
+    cout.flush();
+    cout.rdbuf(prev);
+    // The timeout only applies to the compilation
+    faust_alarm(0);
+
+    output = out.str();
+    if (factory) {
+        if (global::isAllWarning(int(argv.size()) - 1, argv.data())) {
+            set<string> warnings_set;
+            for (const auto& it : factory->getWarningMessages()) {
+                warnings_set.insert(it);
+            }
+            for (const auto& it : warnings_set) {
+                warnings += it;
+            }
+        }
+        delete factory;
+    }
+    return error_msg;
+}
+
+/**
+ * Serve the requests of a channel, returns false when the server has to stop.
+ */
+static bool serveRequests(ServerChannel& channel)
+{
+    string line;
+    while (channel.readLine(line)) {
+        stringstream request(line);
+        string       command, name;
+        size_t       argc = 0, size = 0;
+        request >> command;
+        if (command == "quit") {
+            return false;
+        }
+        request >> name >> argc >> size;
+        if (command != "compile" || request.fail()) {
+            string error = "ERROR : incorrect compile server request '" + line + "'\n";
+            channel.write("error " + to_string(error.size()) + "\n" + error);
+            // The content of the request cannot be skipped
+            return true;
+        }
+
+        vector<string> args(argc);
+        string         code;
+        for (size_t i = 0; i < argc; i++) {
+            if (!channel.readLine(args[i])) {
+                return true;
+            }
+        }
+        if (!channel.readBytes(size, code)) {
+            return true;
+        }
+
+        string output, warnings;
+        string error = compileRequest(name, args, code, output, warnings);
+        bool   res;
+        if (error == "") {
+            res = channel.write("ok " + to_string(output.size()) + " " +
+                                to_string(warnings.size()) + "\n" + output + warnings);
+        } else {
+            res = channel.write("error " + to_string(error.size()) + "\n" + error);
+        }
+        if (!res) {
+            return true;
+        }
+    }
+    return true;
+}
+
+static int serveSocket(const string& path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        cerr << "ERROR : socket path '" << path << "' is too long\n";
+        return EXIT_FAILURE;
+    }
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        cerr << "ERROR : cannot create socket : " << strerror(errno) << "\n";
+        return EXIT_FAILURE;
+    }
+    unlink(path.c_str());
+    if (::bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 8) < 0) {
+        cerr << "ERROR : cannot listen on socket '" << path << "' : " << strerror(errno) << "\n";
+        close(fd);
+        return EXIT_FAILURE;
+    }
+    // A client closing its connection must not stop the server
+    signal(SIGPIPE, SIG_IGN);
+
+    // Clients are served one at a time, compilations being sequential anyway
+    bool running = true;
+    while (running) {
+        int client = accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        ServerChannel channel(client, client);
+        running = serveRequests(channel);
+        close(client);
+    }
+    close(fd);
+    unlink(path.c_str());
+    return EXIT_SUCCESS;
+}
+
+int compileServerMain(int argc, const char* argv[])
+{
+    string socket_path;
+    string snapshot_path;
+    for (int i = 2; i < argc; i++) {
+        if (string(argv[i]) == "-socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if ((string(argv[i]) == "-lib-snapshot" || string(argv[i]) == "--library-snapshot") &&
+                   i + 1 < argc) {
+            snapshot_path = argv[++i];
+        } else {
+            cerr << "ERROR : unknown compile server option '" << argv[i] << "'\n";
+            cerr << "usage : faust -server [-socket <file>] [-lib-snapshot <file>]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The parsed library files are kept for the server lifetime
+    LibrarySnapshot snapshot(snapshot_path);
+    LibrarySnapshot::setResident(&snapshot);
+
+    int res = EXIT_SUCCESS;
+    if (socket_path != "") {
+        res = serveSocket(socket_path);
+    } else {
+        // Responses use the original standard output, everything else written on it during the
+        // compilations goes to the standard error
+        int out = dup(1);
+        dup2(2, 1);
+        ServerChannel channel(0, out);
+        serveRequests(channel);
+        close(out);
+    }
+
+    snapshot.save();
+    LibrarySnapshot::setResident(nullptr);
+    return res;
+}
+
+#else
+
+int compileServerMain(int argc, const char* argv[])
+{
+    cerr << "ERROR : the compile server is not supported on this platform\n";
+    return EXIT_FAILURE;
+}
+
+#endif
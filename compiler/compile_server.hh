@@ -0,0 +1,50 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _COMPILE_SERVER_H
+#define _COMPILE_SERVER_H
+
+/**
+ * Resident compile server (faust -server).
+ *
+ * A long-lived compiler process that serves compilation requests on stdin/stdout, or on a local
+ * Unix socket (-socket <file>). Each request is compiled with createFactory in a fresh
+ * compilation context, but the process is started once and the parsed library files are kept in
+ * a resident LibrarySnapshot, so that only the DSP code of the request has to be parsed again
+ * (the resident snapshot can be initialized from and saved to a -lib-snapshot <file>).
+ *
+ * Requests and responses are length-prefixed:
+ *
+ *  compile <name> <argument count> <code size>\n
+ *  <argument>\n                                    (one line per compiler argument)
+ *  <code>                                          (<code size> bytes of DSP code)
+ *
+ *  ok <output size> <warnings size>\n<output><warnings>
+ *  error <message size>\n<message>
+ *
+ * <name> is the name of the DSP (used as its 'filename' metadata). When <code size> is 0, the
+ * DSP files are given in the arguments, like on the command line. The output is what the
+ * compiler would have printed on its standard output (the generated code when no -o option is
+ * used). The 'quit' request stops the server.
+ */
+int compileServerMain(int argc, const char* argv[]);
+
+#endif
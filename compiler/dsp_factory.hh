@@ -37,8 +37,6 @@
 #define COMPILATION_OPTIONS_KEY "compile_options"
 #define COMPILATION_OPTIONS "declare compile_options "
 
-extern std::vector<std::string> gWarningMessages;
-
 /*
  In order to better separate compilation and execution for dynamic backends (LLVM, Interpreter,
  WebAssembly). A dsp_factory_base* object will either be generated by the compiler from a DSP, or by
@@ -64,7 +62,8 @@ struct dsp_factory_base {
 
     virtual std::string getCompileOptions() = 0;
 
-    virtual std::vector<std::string> getWarningMessages() = 0;
+    virtual std::vector<std::string> getWarningMessages()                                     = 0;
+    virtual void                     setWarningMessages(const std::vector<std::string>& msgs) = 0;
 
     virtual dsp* createDSPInstance(dsp_factory* factory) = 0;
 
@@ -91,6 +90,9 @@ class dsp_factory_imp : public dsp_factory_base {
     std::string fSHAKey;
     std::string fExpandedDSP;
 
+    // Warnings of the compilation which produced the factory
+    std::vector<std::string> fWarningMessages;
+
     dsp_memory_manager* fManager;
 
    public:
@@ -128,7 +130,11 @@ class dsp_factory_imp : public dsp_factory_base {
 
     virtual std::string getCompileOptions() { return ""; };
 
-    virtual std::vector<std::string> getWarningMessages() { return gWarningMessages; }
+    virtual std::vector<std::string> getWarningMessages() { return fWarningMessages; }
+    virtual void setWarningMessages(const std::vector<std::string>& msgs)
+    {
+        fWarningMessages = msgs;
+    }
 
     virtual dsp* createDSPInstance(dsp_factory* factory)
     {
@@ -200,9 +206,11 @@ class CTree;
 typedef CTree*              Signal;
 typedef std::vector<Signal> tvec;
 
+// When 'library_files' is given, it receives the pathnames of the imported library files
 dsp_factory_base* createFactory(const std::string& name_app, const std::string& dsp_content,
                                 int argc, const char* argv[], std::string& error_msg,
-                                bool generate);
+                                bool                      generate,
+                                std::vector<std::string>* library_files = nullptr);
 
 dsp_factory_base* createFactory(const std::string& name_app, tvec signals, int argc,
                                 const char* argv[], std::string& error_msg);
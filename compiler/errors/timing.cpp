@@ -24,7 +24,9 @@
 #include <iostream>
 #include <sstream>
 #ifndef _WIN32
+#include <sys/resource.h>
 #include <sys/time.h>
+#include <time.h>
 #endif
 #include "Text.hh"
 #include "compatibility.hh"
@@ -33,12 +35,16 @@
 
 using namespace std;
 
-// Timing can be used outside of the scope of 'gGlobal'
-bool     gTimingSwitch;
-int      gTimingIndex;
-double   gStartTime[1024];
-double   gEndTime[1024];
-ostream* gTimingLog = 0;
+// Timing can be used outside of the scope of 'gGlobal', and is kept per compilation thread
+thread_local bool     gTimingSwitch;
+thread_local int      gTimingIndex;
+thread_local double   gStartTime[1024];
+thread_local double   gEndTime[1024];
+thread_local ostream* gTimingLog = 0;
+
+// Profile kept open by PhaseProfilerScope after the destruction of the compilation context
+static thread_local PhaseProfiler* gScopeProfiler  = nullptr;
+static thread_local int            gProfilerScopes = 0;
 
 #ifndef _WIN32
 double mysecond()
@@ -49,13 +55,46 @@ double mysecond()
     return ((double)tp.tv_sec + (double)tp.tv_usec * 1.e-6);
 }
 
+static double mycputime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ((double)ts.tv_sec + (double)ts.tv_nsec * 1.e-9);
+}
+
+static long mypeakrss()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
 #else
 double mysecond()
 {
     return 0;
 }
+
+static double mycputime()
+{
+    return 0;
+}
+
+static long mypeakrss()
+{
+    return 0;
+}
 #endif
 
+static PhaseProfiler* getPhaseProfiler()
+{
+    return (gGlobal) ? gGlobal->gPhaseProfiler : gScopeProfiler;
+}
+
 void startTiming(const char* msg)
 {
     // timing
@@ -64,6 +103,10 @@ void startTiming(const char* msg)
         *gTimingLog << endl;
     }
 
+    if (PhaseProfiler* profiler = getPhaseProfiler()) {
+        profiler->start(msg);
+    }
+
     if (gTimingSwitch) {
         faustassert(gTimingIndex < 1023);
         if (gTimingLog) {
@@ -79,6 +122,10 @@ void startTiming(const char* msg)
 
 void endTiming(const char* msg)
 {
+    if (PhaseProfiler* profiler = getPhaseProfiler()) {
+        profiler->end(msg);
+    }
+
     if (gTimingSwitch) {
         faustassert(gTimingIndex > 0);
         gEndTime[--gTimingIndex] = mysecond();
@@ -92,3 +139,153 @@ void endTiming(const char* msg)
         }
     }
 }
+
+/*****************************************************************************
+                            PhaseProfiler
+*****************************************************************************/
+
+PhaseProfiler::PhaseProfiler(const string& file, bool trace)
+    : fFile(file), fTrace(trace), fOrigin(mysecond())
+{
+}
+
+// Keep the current counters in 'phase', trees are only counted in a compilation context
+void PhaseProfiler::snapshot(Phase& phase)
+{
+    phase.fWall       = mysecond();
+    phase.fCPU        = mycputime();
+    phase.fPeakRSS    = mypeakrss();
+    phase.fTrees      = 0;
+    phase.fLookups    = 0;
+    phase.fHits       = 0;
+    phase.fProperties = 0;
+    if (gGlobal) {
+        const TreeHashTable::Stats& stats = gGlobal->gTreeTable.getStats();
+        phase.fTrees                      = gGlobal->gTreeSerialCounter;
+        phase.fLookups                    = stats.fHits + stats.fMisses;
+        phase.fHits                       = stats.fHits;
+    }
+#ifdef PROPERTY_STATS
+    phase.fProperties = gPropertyAccesses;
+#endif
+}
+
+void PhaseProfiler::start(const char* name)
+{
+    Phase phase;
+    phase.fName  = name;
+    phase.fDepth = int(fStack.size());
+    snapshot(phase);
+    phase.fStart = phase.fWall - fOrigin;
+    fStack.push_back(phase);
+}
+
+void PhaseProfiler::end(const char* name)
+{
+    if (fStack.empty()) return;
+    Phase phase = fStack.back();
+    Phase now;
+    fStack.pop_back();
+    snapshot(now);
+    phase.fWall       = now.fWall - phase.fWall;
+    phase.fCPU        = now.fCPU - phase.fCPU;
+    phase.fPeakRSS    = now.fPeakRSS;
+    phase.fTrees      = now.fTrees - phase.fTrees;
+    phase.fLookups    = now.fLookups - phase.fLookups;
+    phase.fHits       = now.fHits - phase.fHits;
+    phase.fProperties = now.fProperties - phase.fProperties;
+    fPhases.push_back(phase);
+}
+
+static string jsonString(const string& str)
+{
+    stringstream res;
+    res << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') res << '\\';
+        res << c;
+    }
+    res << '"';
+    return res.str();
+}
+
+void PhaseProfiler::writeJSON(ostream& out)
+{
+    out << "{\n  \"version\": " << jsonString(FAUSTVERSION) << ",\n  \"phases\": [";
+    for (size_t i = 0; i < fPhases.size(); i++) {
+        const Phase& phase = fPhases[i];
+        out << ((i > 0) ? ",\n" : "\n") << "    { \"name\": " << jsonString(phase.fName)
+            << ", \"depth\": " << phase.fDepth << ", \"start\": " << phase.fStart
+            << ", \"wall\": " << phase.fWall << ", \"cpu\": " << phase.fCPU
+            << ", \"peak_rss_kb\": " << phase.fPeakRSS << ", \"trees\": " << phase.fTrees
+            << ", \"hashcons_lookups\": " << phase.fLookups
+            << ", \"hashcons_hits\": " << phase.fHits
+            << ", \"hashcons_hit_rate\": "
+            << ((phase.fLookups) ? double(phase.fHits) / phase.fLookups : 0.);
+#ifdef PROPERTY_STATS
+        out << ", \"property_accesses\": " << phase.fProperties;
+#endif
+        out << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// See the 'Trace Event Format' specification, phases are 'complete' events in microseconds
+void PhaseProfiler::writeTrace(ostream& out)
+{
+    out << "{\n  \"traceEvents\": [";
+    for (size_t i = 0; i < fPhases.size(); i++) {
+        const Phase& phase = fPhases[i];
+        out << ((i > 0) ? ",\n" : "\n") << "    { \"name\": " << jsonString(phase.fName)
+            << ", \"cat\": \"faust\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": "
+            << int64_t(phase.fStart * 1e6) << ", \"dur\": " << int64_t(phase.fWall * 1e6)
+            << ", \"args\": { \"cpu_us\": " << int64_t(phase.fCPU * 1e6)
+            << ", \"peak_rss_kb\": " << phase.fPeakRSS << ", \"trees\": " << phase.fTrees
+            << ", \"hashcons_lookups\": " << phase.fLookups
+            << ", \"hashcons_hits\": " << phase.fHits;
+#ifdef PROPERTY_STATS
+        out << ", \"property_accesses\": " << phase.fProperties;
+#endif
+        out << " } }";
+    }
+    out << "\n  ],\n  \"displayTimeUnit\": \"ms\"\n}\n";
+}
+
+void PhaseProfiler::write()
+{
+    ofstream out(fFile.c_str());
+    if (!out.is_open()) {
+        cerr << "WARNING : cannot write compilation phases in " << fFile << endl;
+        return;
+    }
+    if (fTrace) {
+        writeTrace(out);
+    } else {
+        writeJSON(out);
+    }
+}
+
+void closePhaseProfiler(PhaseProfiler* profiler)
+{
+    if (gProfilerScopes > 0) {
+        delete gScopeProfiler;
+        gScopeProfiler = profiler;
+    } else {
+        profiler->write();
+        delete profiler;
+    }
+}
+
+PhaseProfilerScope::PhaseProfilerScope()
+{
+    gProfilerScopes++;
+}
+
+PhaseProfilerScope::~PhaseProfilerScope()
+{
+    if (--gProfilerScopes == 0 && gScopeProfiler) {
+        gScopeProfiler->write();
+        delete gScopeProfiler;
+        gScopeProfiler = nullptr;
+    }
+}
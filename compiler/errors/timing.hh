@@ -22,10 +22,68 @@
 #ifndef __TIMING__
 #define __TIMING__
 
+#include <iostream>
+#include <string>
+#include <vector>
+
 // use startTiming("foo") and endTiming("foo") to measure the execution time of a portion of code
 // edit timing.cpp to unactivate the code
 
 void startTiming(const char* msg);
 void endTiming(const char* msg);
 
+/**
+ * Records the compilation phases delimited by startTiming/endTiming, with their wall and
+ * CPU time, peak RSS, number of trees created, hash-consing lookups and hits, and property
+ * accesses (when compiled with PROPERTY_STATS), to be written in JSON or Chrome trace format
+ * (see -time-json and -time-trace).
+ */
+class PhaseProfiler {
+   private:
+    struct Phase {
+        std::string fName;
+        int         fDepth;
+        double      fStart;       // in seconds from the profiler creation
+        double      fWall;        // in seconds
+        double      fCPU;         // in seconds
+        long        fPeakRSS;     // in KB, at the end of the phase
+        size_t      fTrees;       // trees created during the phase
+        size_t      fLookups;     // hash-consing lookups done during the phase
+        size_t      fHits;        // hash-consing lookups finding an existing tree
+        size_t      fProperties;  // property accesses done during the phase
+    };
+
+    std::string        fFile;
+    bool               fTrace;
+    double             fOrigin;
+    std::vector<Phase> fStack;   // running phases
+    std::vector<Phase> fPhases;  // completed phases
+
+    void snapshot(Phase& phase);
+    void writeJSON(std::ostream& out);
+    void writeTrace(std::ostream& out);
+
+   public:
+    PhaseProfiler(const std::string& file, bool trace);
+
+    void start(const char* name);
+    void end(const char* name);
+
+    // Write the completed phases in the output file
+    void write();
+};
+
+// Write and delete 'profiler' at the end of a compilation, or keep it in the calling thread
+// while a PhaseProfilerScope is open
+void closePhaseProfiler(PhaseProfiler* profiler);
+
+/**
+ * Keeps the profile of the compilation done in its scope open, so that the phases following
+ * the destruction of the compilation context (like the LLVM JIT) are recorded in it.
+ */
+struct PhaseProfilerScope {
+    PhaseProfilerScope();
+    ~PhaseProfilerScope();
+};
+
 #endif
@@ -731,7 +731,7 @@ static Tree realeval(Tree exp, Tree visited, Tree localValEnv)
             stringstream error;
             error << "WARNING : no modulation of: '" << *elabel
                   << "' took place in: " << boxpp(ebody) << endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
 
         // if we have a slot, we need to wrap the modulation body in a symbolic box
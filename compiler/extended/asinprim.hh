@@ -41,7 +41,7 @@ class AsinPrim : public xtended {
         if (i.isValid() && gGlobal->gMathExceptions && (i.lo() < -1 || i.hi() > 1)) {
             std::stringstream error;
             error << "WARNING : potential out of domain in asin(" << i << ")" << std::endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
         return castInterval(t, gAlgebra.Asin(i));
     }
@@ -43,7 +43,7 @@ class FmodPrim : public xtended {
             std::stringstream error;
             error << "WARNING : potential division by zero in fmod(" << i << ", " << j << ")"
                   << std::endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
 
         return castInterval(floatCast(args[0] | args[1]), gAlgebra.Mod(i, j));
@@ -41,7 +41,7 @@ class Log10Prim : public xtended {
         if (i.isValid() && i.lo() < 0 && gGlobal->gMathExceptions) {
             std::stringstream error;
             error << "WARNING : potential out of domain in log10(" << i << ")" << std::endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
         return castInterval(floatCast(t), gAlgebra.Log10(i));
     }
@@ -42,7 +42,7 @@ class LogPrim : public xtended {
         if (i.isValid() && i.lo() < 0 && gGlobal->gMathExceptions) {
             std::stringstream error;
             error << "WARNING : potential out of domain in log(" << i << ")" << std::endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
         return castInterval(floatCast(t), gAlgebra.Log(i));
     }
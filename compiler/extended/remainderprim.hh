@@ -44,7 +44,7 @@ class RemainderPrim : public xtended {
             std::stringstream error;
             error << "WARNING : potential division by zero in remainder(" << i << ", " << j << ")"
                   << std::endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
 
         return castInterval(floatCast(args[0] | args[1]),
@@ -41,7 +41,7 @@ class SqrtPrim : public xtended {
         if (i.isValid() && i.lo() < 0 && gGlobal->gMathExceptions) {
             std::stringstream error;
             error << "WARNING : potential out of domain in sqrt(" << i << ")" << std::endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
         return castInterval(floatCast(t), gAlgebra.Sqrt(i));
     }
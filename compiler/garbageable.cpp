@@ -0,0 +1,180 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#include <stdlib.h>
+
+#include "garbageable.hh"
+
+// HACK : add 16 bytes to avoid unsolved memory smashing bug...
+#define GARBAGE_PADDING 16
+
+typedef GarbageableArena::Header Header;
+
+static inline void* headerToObject(Header* header)
+{
+    return header + 1;
+}
+
+static inline Header* objectToHeader(void* ptr)
+{
+    return static_cast<Header*>(ptr) - 1;
+}
+
+GarbageableArena::GarbageableArena()
+    : fCur(nullptr), fEnd(nullptr), fAllocated(0), fLiveCount(0), fCleanup(false)
+{
+    fLive.fPrev  = &fLive;
+    fLive.fNext  = &fLive;
+    fLive.fArena = this;
+    fLive.fSize  = 0;
+    for (size_t i = 0; i < kSizeClasses; i++) {
+        fFree[i] = nullptr;
+    }
+}
+
+GarbageableArena::~GarbageableArena()
+{
+    cleanup();
+}
+
+void GarbageableArena::link(Header* header)
+{
+    header->fArena     = this;
+    header->fPrev      = &fLive;
+    header->fNext      = fLive.fNext;
+    fLive.fNext->fPrev = header;
+    fLive.fNext        = header;
+    fLiveCount++;
+}
+
+void GarbageableArena::unlink(Header* header)
+{
+    header->fPrev->fNext = header->fNext;
+    header->fNext->fPrev = header->fPrev;
+    fLiveCount--;
+}
+
+void GarbageableArena::newChunk()
+{
+    char* chunk = static_cast<char*>(malloc(kChunkSize));
+    if (!chunk) throw std::bad_alloc();
+    fChunks.push_back(chunk);
+    fCur = chunk;
+    fEnd = chunk + kChunkSize;
+}
+
+void* GarbageableArena::allocate(size_t size)
+{
+    size_t block = sizeof(Header) + size + GARBAGE_PADDING;
+    block        = (block + kGranularity - 1) & ~(kGranularity - 1);
+    size_t klass = block / kGranularity - 1;
+
+    Header* header;
+    if (klass < kSizeClasses) {
+        if (fFree[klass]) {
+            // Recycle a previously released block of the same size
+            header       = fFree[klass];
+            fFree[klass] = header->fNext;
+        } else {
+            if (fCur + block > fEnd) newChunk();
+            header = reinterpret_cast<Header*>(fCur);
+            fCur += block;
+        }
+        header->fSize = klass;
+    } else {
+        // Large blocks are directly allocated
+        header = static_cast<Header*>(malloc(block));
+        if (!header) throw std::bad_alloc();
+        header->fSize = kLargeBlock;
+    }
+
+    link(header);
+    fAllocated += block;
+    return headerToObject(header);
+}
+
+void GarbageableArena::release(void* ptr)
+{
+    // Objects deleted by destructors during cleanup are released with the chunks
+    if (fCleanup) return;
+    Header* header = objectToHeader(ptr);
+    unlink(header);
+    if (header->fSize == kLargeBlock) {
+        free(header);
+    } else {
+        header->fNext        = fFree[header->fSize];
+        fFree[header->fSize] = header;
+    }
+}
+
+void GarbageableArena::cleanup()
+{
+    // Objects are destroyed in reverse allocation order
+    fCleanup       = true;
+    Header* header = fLive.fNext;
+    while (header != &fLive) {
+        Header* next = header->fNext;
+#ifndef _WIN32
+        // On Windows, "this" and actual pointer are not the same: destructor cannot be called...
+        static_cast<Garbageable*>(headerToObject(header))->~Garbageable();
+#endif
+        if (header->fSize == kLargeBlock) {
+            free(header);
+        }
+        header = next;
+    }
+
+    fLive.fPrev = &fLive;
+    fLive.fNext = &fLive;
+    for (size_t i = 0; i < kSizeClasses; i++) {
+        fFree[i] = nullptr;
+    }
+    for (char* chunk : fChunks) {
+        free(chunk);
+    }
+    fChunks.clear();
+    fCur       = nullptr;
+    fEnd       = nullptr;
+    fAllocated = 0;
+    fLiveCount = 0;
+    fCleanup   = false;
+}
+
+void* GarbageableArena::allocateNoContext(size_t size)
+{
+    Header* header = static_cast<Header*>(malloc(sizeof(Header) + size + GARBAGE_PADDING));
+    if (!header) throw std::bad_alloc();
+    header->fPrev  = nullptr;
+    header->fNext  = nullptr;
+    header->fArena = nullptr;
+    header->fSize  = kLargeBlock;
+    return headerToObject(header);
+}
+
+void GarbageableArena::releaseAny(void* ptr)
+{
+    Header* header = objectToHeader(ptr);
+    if (header->fArena) {
+        header->fArena->release(ptr);
+    } else {
+        free(header);
+    }
+}
@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <new>
+#include <vector>
 
 #include "exception.hh"
 #include "faust/export.h"
@@ -43,6 +44,62 @@ class LIBFAUST_API Garbageable {
     static void cleanup();
 };
 
+/**
+ * Arena used to allocate the Garbageable objects of a compilation context.
+ * Objects are bump allocated in large chunks and linked in a list of living objects,
+ * so that deleting an object is O(1): it is unlinked and its block is recycled in a
+ * per size free list. The destructors of the living objects are called by 'cleanup',
+ * then all chunks are released at once.
+ */
+class GarbageableArena {
+   public:
+    // Block header, placed before each object (keeps 16 bytes alignment)
+    struct alignas(16) Header {
+        Header*           fPrev;
+        Header*           fNext;
+        GarbageableArena* fArena;  // nullptr for objects allocated outside of any context
+        size_t            fSize;   // size class index, or kLargeBlock
+    };
+
+    static const size_t kChunkSize   = 1 << 20;
+    static const size_t kGranularity = 16;
+    static const size_t kSizeClasses = 64;  // blocks up to 1024 bytes are recycled
+    static const size_t kLargeBlock  = size_t(-1);
+
+   private:
+    std::vector<char*> fChunks;
+    char*              fCur;
+    char*              fEnd;
+    Header             fLive;  // sentinel of the circular list of living objects
+    Header*            fFree[kSizeClasses];
+    size_t             fAllocated;
+    size_t             fLiveCount;
+    bool               fCleanup;
+
+    void link(Header* header);
+    void unlink(Header* header);
+    void newChunk();
+
+   public:
+    GarbageableArena();
+    ~GarbageableArena();
+
+    void* allocate(size_t size);
+    void  release(void* ptr);
+
+    // Call the destructors of all living objects, then release all chunks
+    void cleanup();
+
+    bool isCleaningUp() const { return fCleanup; }
+
+    // Bytes allocated since the last cleanup
+    size_t getAllocatedBytes() const { return fAllocated; }
+    size_t getLiveObjects() const { return fLiveCount; }
+
+    static void* allocateNoContext(size_t size);
+    static void  releaseAny(void* ptr);
+};
+
 template <class P>
 class GarbageablePtr : public virtual Garbageable {
    private:
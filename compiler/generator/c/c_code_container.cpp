@@ -25,6 +25,7 @@
 #include "c_code_container.hh"
 #include "exception.hh"
 #include "fir_function_builder.hh"
+#include "fir_simd.hh"
 #include "floats.hh"
 #include "global.hh"
 
@@ -43,7 +44,7 @@ using namespace std;
  architecture file (doing the proper cast on arguments and return value when needed)
  */
 
-map<string, bool> CInstVisitor::gFunctionSymbolTable;
+thread_local map<string, bool> CInstVisitor::gFunctionSymbolTable;
 
 dsp_factory_base* CCodeContainer::produceFactory()
 {
@@ -230,6 +231,12 @@ void CCodeContainer::produceClass()
     *fOut << "#endif" << endl;
     tab(n, *fOut);
 
+    // Vector types and helpers for explicit SIMD code
+    if (gGlobal->gSIMDLanes > 0) {
+        generateSIMDPrelude(fOut, gGlobal->gSIMDLanes);
+        tab(n, *fOut);
+    }
+
     // Libraries
     printLibrary(*fOut);
     printIncludeFile(*fOut);
@@ -632,6 +639,12 @@ void CScalarCodeContainer1::produceClass()
     *fOut << "#endif" << endl;
     tab(n, *fOut);
 
+    // Vector types and helpers for explicit SIMD code
+    if (gGlobal->gSIMDLanes > 0) {
+        generateSIMDPrelude(fOut, gGlobal->gSIMDLanes);
+        tab(n, *fOut);
+    }
+
     // Libraries
     printLibrary(*fOut);
     printIncludeFile(*fOut);
@@ -873,7 +886,11 @@ void CVectorCodeContainer::generateComputeAux(int n)
     // Generates local variables declaration and setup
     generateComputeBlock(fCodeProducer);
 
-    // Generates the DSP loop
+    // Generates the DSP loop, possibly with explicit SIMD code
+    if (gGlobal->gSIMDLanes > 0) {
+        SIMDVectorizer vectorizer(gGlobal->gSIMDLanes);
+        fDAGBlock = vectorizer.getCode(fDAGBlock);
+    }
     fDAGBlock->accept(fCodeProducer);
 
     back(1, *fOut);
@@ -903,7 +920,11 @@ void CVectorCodeContainer1::generateComputeAux(int n)
     // Generates local variables declaration and setup
     generateComputeBlock(fCodeProducer);
 
-    // Generates the DSP loop
+    // Generates the DSP loop, possibly with explicit SIMD code
+    if (gGlobal->gSIMDLanes > 0) {
+        SIMDVectorizer vectorizer(gGlobal->gSIMDLanes);
+        fDAGBlock = vectorizer.getCode(fDAGBlock);
+    }
     fDAGBlock->accept(fCodeProducer);
 
     back(1, *fOut);
@@ -98,7 +98,7 @@ CodeContainer::CodeContainer()
     }
 }
 
-int ZoneArray::gInternalMemorySize = 0;
+thread_local int ZoneArray::gInternalMemorySize = 0;
 
 CodeContainer::~CodeContainer()
 {
@@ -460,6 +460,13 @@ void CodeContainer::processFIR(void)
         }
     }
 
+    // Possibly optimize the DSP loop code
+    if (gGlobal->gFIROptimize == 1) {
+        startTiming("optimizeDSPLoop");
+        optimizeDSPLoop();
+        endTiming("optimizeDSPLoop");
+    }
+
     // Possibly rewrite arrays access using iZone/fZone
     rewriteInZones();
 
@@ -538,6 +545,54 @@ void CodeContainer::rewriteInZones()
     }
 }
 
+// CSE, loop invariant code motion and dead store elimination in the scalar DSP loop
+void CodeContainer::optimizeDSPLoop()
+{
+    // Vector, one sample and external control modes, or types not handled by TypingVisitor
+    if (gGlobal->gVectorSwitch || gGlobal->gOneSample || gGlobal->gOneSampleControl ||
+        gGlobal->gExtControl || gGlobal->gFloatSize > 2 || gGlobal->gOutputLang == "jax" ||
+        fCurLoop->fExtraLoops.size() > 0) {
+        return;
+    }
+
+    BlockInst* loop_code = new BlockInst();
+    fCurLoop->pushBlock(fCurLoop->fPreInst, loop_code);
+    fCurLoop->pushBlock(fCurLoop->fComputeInst, loop_code);
+    fCurLoop->pushBlock(fCurLoop->fPostInst, loop_code);
+
+    // Memory possibly written with variable addresses or methods
+    WrittenVarsCollector writer;
+    loop_code->accept(&writer);
+    if (writer.fUnsafe) {
+        return;
+    }
+    writer.fWritten.insert(fCurLoop->fLoopIndex);
+    gGlobal->setVarType(fCurLoop->fLoopIndex, Typed::kInt32);
+
+    // Stack variables available before the loop
+    set<string> defined;
+    for (const auto& it : fComputeBlockInstructions->fCode) {
+        DeclareVarInst* declare = dynamic_cast<DeclareVarInst*>(it);
+        if (declare && declare->fAddress->isStack()) {
+            defined.insert(declare->getName());
+        }
+    }
+
+    LoopInvariantMover mover(writer.fWritten, defined);
+    loop_code = mover.getCode(loop_code);
+    for (const auto& it : mover.fMoved->fCode) {
+        fComputeBlockInstructions->pushBackInst(it);
+    }
+
+    CommonSubexpressionEliminator eliminator;
+    loop_code = eliminator.getCode(loop_code);
+
+    DeadStoreRemover remover;
+    fCurLoop->fPreInst     = new BlockInst();
+    fCurLoop->fComputeInst = remover.getCode(loop_code);
+    fCurLoop->fPostInst    = new BlockInst();
+}
+
 void CodeContainer::mergeSubContainers()
 {
     for (const auto& it : fSubContainers) {
@@ -235,6 +235,7 @@ class CodeContainer : public virtual Garbageable {
 
     void createMemoryLayout();
     void rewriteInZones();
+    void optimizeDSPLoop();
 
    public:
     CodeContainer();
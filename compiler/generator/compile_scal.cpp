@@ -79,7 +79,7 @@ static Klass* signal2klass(Klass* parent, const string& name, Tree sig)
  getFreshID
  *****************************************************************************/
 
-map<string, int> ScalarCompiler::fIDCounters;
+thread_local map<string, int> ScalarCompiler::fIDCounters;
 
 string ScalarCompiler::getFreshID(const string& prefix)
 {
@@ -462,7 +462,7 @@ void ScalarCompiler::compileMultiSignal(Tree L)
     }
 
     // force a specific compilation order
-    auto G = immediateGraph(L);
+    auto G = immediateCompactGraph(L);
     auto S = dfschedule(G);
     // register the compilation order S for debug purposes
     {
@@ -539,7 +539,7 @@ void ScalarCompiler::compileSingleSignal(Tree sig)
     std::cerr << "\nSTART COMPILING SINGLE SIGNAL: " << ppsig(sig, 20) << std::endl;
 #endif
     // force a specific compilation order
-    auto G = immediateGraph(cons(sig, gGlobal->nil));
+    auto G = immediateCompactGraph(cons(sig, gGlobal->nil));
     auto S = dfschedule(G);
 #ifdef TRACE
     std::cerr << "\nBEFORE COMPILING SINGLE SIGNAL" << std::endl;
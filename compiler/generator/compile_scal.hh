@@ -52,7 +52,7 @@ class ScalarCompiler : public Compiler {
     std::map<Tree, Tree>
         fConditionProperty;  // used with the new X,Y:enable --> sigControl(X*Y,Y>0) primitive
 
-    static std::map<std::string, int>  fIDCounters;
+    static thread_local std::map<std::string, int> fIDCounters;
     Tree                               fSharingKey;
     OccMarkup*                         fOccMarkup;
     int                                fMaxIota;
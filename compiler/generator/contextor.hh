@@ -38,8 +38,8 @@
  *	An automatic stack of contexts
  */
 class contextor {
-    static int top;
-    static int pile[1024];
+    static thread_local int top;
+    static thread_local int pile[1024];
 
    public:
     contextor(int n)
@@ -43,7 +43,7 @@ using namespace std;
  architecture file (doing the proper cast on arguments and return value when needed)
  */
 
-map<string, bool> CPPInstVisitor::gFunctionSymbolTable;
+thread_local map<string, bool> CPPInstVisitor::gFunctionSymbolTable;
 
 dsp_factory_base* CPPCodeContainer::produceFactory()
 {
@@ -932,7 +932,11 @@ void CPPVectorCodeContainer::generateCompute(int n)
     // Generates local variables declaration and setup
     generateComputeBlock(fCodeProducer);
 
-    // Generates the DSP loop
+    // Generates the DSP loop, possibly with explicit SIMD code
+    if (gGlobal->gSIMDLanes > 0) {
+        SIMDVectorizer vectorizer(gGlobal->gSIMDLanes);
+        fDAGBlock = vectorizer.getCode(fDAGBlock);
+    }
     fDAGBlock->accept(fCodeProducer);
 
     back(1, *fOut);
@@ -25,6 +25,7 @@
 #include "code_container.hh"
 #include "cpp_instructions.hh"
 #include "dsp_factory.hh"
+#include "fir_simd.hh"
 #include "omp_code_container.hh"
 #include "opencl_instructions.hh"
 #include "vec_code_container.hh"
@@ -75,6 +76,12 @@ class CPPCodeContainer : public virtual CodeContainer {
         *fOut << "#else" << std::endl;
         *fOut << "#define RESTRICT __restrict__" << std::endl;
         *fOut << "#endif" << std::endl;
+
+        // Vector types and helpers for explicit SIMD code
+        if (gGlobal->gSIMDLanes > 0) {
+            tab(n, *fOut);
+            generateSIMDPrelude(fOut, gGlobal->gSIMDLanes);
+        }
     }
 
     void generateAllocateFun(int n)
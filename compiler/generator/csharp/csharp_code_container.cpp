@@ -28,8 +28,8 @@
 
 using namespace std;
 
-map<string, bool>   CSharpInstVisitor::gFunctionSymbolTable;
-map<string, string> CSharpInstVisitor::gMathLibTable;
+thread_local map<string, bool>   CSharpInstVisitor::gFunctionSymbolTable;
+thread_local map<string, string> CSharpInstVisitor::gMathLibTable;
 
 dsp_factory_base* CSharpCodeContainer::produceFactory()
 {
@@ -32,8 +32,8 @@ class CSharpInstVisitor : public TextInstVisitor {
      Global functions names table as a static variable in the visitor
      so that each function prototype is generated as most once in the module.
      */
-    static std::map<std::string, bool>        gFunctionSymbolTable;
-    static std::map<std::string, std::string> gMathLibTable;
+    static thread_local std::map<std::string, bool>        gFunctionSymbolTable;
+    static thread_local std::map<std::string, std::string> gMathLibTable;
 
    public:
     using TextInstVisitor::visit;
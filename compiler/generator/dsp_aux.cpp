@@ -237,7 +237,6 @@ Same DSP code and same normalized compilation options will generate the same SHA
 LIBFAUST_API string expandDSPFromString(const string& name_app, const string& dsp_content, int argc,
                                         const char* argv[], string& sha_key, string& error_msg)
 {
-    LOCK_API
     if (startWith(dsp_content, COMPILATION_OPTIONS)) {
         if (extractCompilationOptions(dsp_content) == reorganizeCompilationOptions(argc, argv)) {
             // Same compilation options as the ones kept in the expanded version
@@ -278,7 +277,6 @@ LIBFAUST_API bool generateAuxFilesFromFile(const string& filename, int argc, con
 LIBFAUST_API bool generateAuxFilesFromString(const string& name_app, const string& dsp_content,
                                              int argc, const char* argv[], string& error_msg)
 {
-    LOCK_API
     int         argc1 = 0;
     const char* argv1[64];
     argv1[argc1++] = "faust";
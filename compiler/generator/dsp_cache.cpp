@@ -0,0 +1,151 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "dsp_cache.hh"
+#include "faust/export.h"
+#include "libfaust.h"
+
+using namespace std;
+
+/*
+ An entry is a single '<key>.fcache' file:
+
+    faust_dsp_cache 1
+    <number of library files>
+    <sha1> <path>
+    ...
+    <code size>
+    <code>
+*/
+
+#define DSP_CACHE_MAGIC "faust_dsp_cache"
+#define DSP_CACHE_VERSION 1
+
+static bool readFile(const string& path, string& content)
+{
+    ifstream file(path.c_str(), ifstream::binary);
+    if (!file.is_open()) return false;
+    stringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+static string entryPath(const string& dir, const string& key)
+{
+    return dir + "/" + key + ".fcache";
+}
+
+string dsp_cache::getDirectory()
+{
+    const char* dir = getenv("FAUST_DSP_CACHE");
+    return (dir) ? dir : "";
+}
+
+string dsp_cache::makeKey(const string& sha_key, const string& target)
+{
+    return generateSHA1(sha_key + target + FAUSTVERSION);
+}
+
+bool dsp_cache::read(const string& key, string& code)
+{
+    string dir = getDirectory();
+    if (dir == "") return false;
+
+    ifstream entry(entryPath(dir, key).c_str(), ifstream::binary);
+    if (!entry.is_open()) return false;
+
+    string magic;
+    int    version = 0;
+    entry >> magic >> version;
+    if (magic != DSP_CACHE_MAGIC || version != DSP_CACHE_VERSION) return false;
+
+    // Check that the library files have not changed since the entry was written
+    size_t deps = 0;
+    entry >> deps;
+    for (size_t i = 0; i < deps && entry.good(); i++) {
+        string sha1, path, content;
+        entry >> sha1;
+        entry.get();  // Skip the separator, the path may contain spaces
+        getline(entry, path);
+        if (!readFile(path, content) || generateSHA1(content) != sha1) return false;
+    }
+
+    size_t size = 0;
+    entry >> size;
+    entry.get();  // Skip the end of line
+    if (!entry.good()) return false;
+    code.resize(size);
+    entry.read(&code[0], size);
+    return size_t(entry.gcount()) == size;
+}
+
+bool dsp_cache::write(const string& key, const string& code, const vector<string>& library_files)
+{
+    string dir = getDirectory();
+    if (dir == "") return false;
+
+    stringstream entry;
+    entry << DSP_CACHE_MAGIC << " " << DSP_CACHE_VERSION << "\n";
+    entry << library_files.size() << "\n";
+    for (const auto& path : library_files) {
+        string content;
+        // A library that cannot be read again (like an URL) cannot be checked later on
+        if (!readFile(path, content)) return false;
+        entry << generateSHA1(content) << " " << path << "\n";
+    }
+    entry << code.size() << "\n";
+    entry << code;
+
+    // Write in a temporary file then rename it, so that concurrent readers never see a partial
+    // entry
+    stringstream tmp_path;
+    tmp_path << entryPath(dir, key) << ".tmp." << getpid() << "."
+             << hash<thread::id>()(this_thread::get_id());
+    {
+        ofstream tmp(tmp_path.str().c_str(), ofstream::binary);
+        if (!tmp.is_open()) return false;
+        tmp << entry.rdbuf();
+        if (!tmp.good()) {
+            tmp.close();
+            remove(tmp_path.str().c_str());
+            return false;
+        }
+    }
+    if (rename(tmp_path.str().c_str(), entryPath(dir, key).c_str()) != 0) {
+        remove(tmp_path.str().c_str());
+        return false;
+    }
+    return true;
+}
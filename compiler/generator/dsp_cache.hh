@@ -0,0 +1,51 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _DSP_CACHE_H
+#define _DSP_CACHE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Persistent on-disk cache of compiled factories, shared between processes.
+ *
+ * The cache is enabled by setting the FAUST_DSP_CACHE environment variable to a directory.
+ * An entry is keyed on the DSP source, the compilation options, the target and the compiler
+ * version, and records the SHA1 of every imported library file: an entry is only reused when
+ * all its library files are still unchanged on disk.
+ */
+struct dsp_cache {
+    // Returns the cache directory, or an empty string when the cache is disabled
+    static std::string getDirectory();
+
+    // Build the entry key from the SHA1 key of the DSP (see sha1FromDSP) and a target name
+    static std::string makeKey(const std::string& sha_key, const std::string& target);
+
+    // Read the code of an entry, returns false if missing or if a library file has changed
+    static bool read(const std::string& key, std::string& code);
+
+    // Atomically write an entry with the library files its code depends on
+    static bool write(const std::string& key, const std::string& code,
+                      const std::vector<std::string>& library_files);
+};
+
+#endif
@@ -24,13 +24,6 @@
 
 #include "faust/export.h"
 
-/*
-    Global outside of the global context, compiled here
-    to be defined in libfaust and libfaustmachine libraries.
-*/
-std::vector<std::string> gWarningMessages;
-bool                     gAllWarning = false;
-
 // External libfaust API
 
 extern "C" LIBFAUST_API const char* getCLibFaustVersion()
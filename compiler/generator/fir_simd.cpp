@@ -0,0 +1,677 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#include <climits>
+
+#include "fir_simd.hh"
+#include "Text.hh"
+#include "global.hh"
+#include "typing_instructions.hh"
+
+using namespace std;
+
+// Checks if a value reads the loop index, a vector local or an array written in the loop
+struct LoopDependencyChecker : public DispatchVisitor {
+    SIMDVectorizer* fVectorizer;
+    bool            fDepends;
+
+    LoopDependencyChecker(SIMDVectorizer* vectorizer) : fVectorizer(vectorizer), fDepends(false)
+    {
+    }
+
+    void check(const string& name)
+    {
+        fDepends = fDepends || (name == fVectorizer->fIndex) ||
+                   (fVectorizer->fLocals.find(name) != fVectorizer->fLocals.end()) ||
+                   (fVectorizer->fStored.find(name) != fVectorizer->fStored.end());
+    }
+
+    virtual void visit(LoadVarInst* inst)
+    {
+        check(inst->getName());
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(LoadVarAddressInst* inst)
+    {
+        check(inst->getName());
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(TeeVarInst* inst)
+    {
+        check(inst->getName());
+        DispatchVisitor::visit(inst);
+    }
+};
+
+static bool isSIMDType(Typed::VarType type)
+{
+    return (type == Typed::kFloat || type == Typed::kDouble || type == Typed::kInt32);
+}
+
+static bool isSIMDRealType(Typed::VarType type)
+{
+    return (type == Typed::kFloat || type == Typed::kDouble);
+}
+
+string getSIMDHelper(int lanes, const string& model, Typed::VarType type)
+{
+    string name = (type == Typed::kInt32) ? "int" : ((type == Typed::kFloat) ? "float" : "double");
+    return "faustvec" + to_string(lanes) + "_" + subst(model, name);
+}
+
+string SIMDVectorizer::getHelper(const string& model, Typed::VarType type)
+{
+    return getSIMDHelper(fLanes, model, type);
+}
+
+VectorTyped* SIMDVectorizer::getVectorType(Typed::VarType type)
+{
+    // A unique type per variable is expected by DeclareVarInst
+    if (fVectorTypes.find(type) == fVectorTypes.end()) {
+        fVectorTypes[type] = IB::genVectorTyped(IB::genBasicTyped(type), fLanes);
+    }
+    return fVectorTypes[type];
+}
+
+// With a vector size, vectors have the size of the target ones
+bool SIMDVectorizer::isVectorType(Typed::VarType type)
+{
+    return isSIMDType(type) &&
+           (fVectorSize == 0 || ((type == Typed::kDouble) ? 8 : 4) * fLanes == fVectorSize);
+}
+
+bool SIMDVectorizer::isIndex(ValueInst* inst)
+{
+    LoadVarInst* load = dynamic_cast<LoadVarInst*>(inst);
+    return load && dynamic_cast<NamedAddress*>(load->fAddress) && (load->getName() == fIndex);
+}
+
+bool SIMDVectorizer::getConstant(ValueInst* inst, int& res)
+{
+    Int32NumInst* num  = dynamic_cast<Int32NumInst*>(inst);
+    LoadVarInst*  load = dynamic_cast<LoadVarInst*>(inst);
+    if (num) {
+        res = num->fNum;
+        return true;
+    } else if (load && dynamic_cast<NamedAddress*>(load->fAddress) &&
+               fConstants.find(load->getName()) != fConstants.end()) {
+        res = fConstants[load->getName()];
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool SIMDVectorizer::dependsOnLoop(ValueInst* inst)
+{
+    LoopDependencyChecker checker(this);
+    inst->accept(&checker);
+    return checker.fDepends;
+}
+
+/*
+ 'i' with added or subtracted loop invariant terms ('i + k', 'k + i', 'k + (i - 3)'...), 'known'
+ when the sum of these terms is the constant 'offset'
+*/
+bool SIMDVectorizer::isAffineIndex(ValueInst* index, bool& known, int& offset)
+{
+    if (isIndex(index)) {
+        known  = true;
+        offset = 0;
+        return true;
+    }
+    BinopInst* binop = dynamic_cast<BinopInst*>(index);
+    if (!binop || (binop->fOpcode != kAdd && binop->fOpcode != kSub)) {
+        return false;
+    }
+    int        value = 0;
+    ValueInst* term  = nullptr;
+    if (!dependsOnLoop(binop->fInst2) && isAffineIndex(binop->fInst1, known, offset)) {
+        term = binop->fInst2;
+    } else if (binop->fOpcode == kAdd && !dependsOnLoop(binop->fInst1) &&
+               isAffineIndex(binop->fInst2, known, offset)) {
+        term = binop->fInst1;
+    } else {
+        return false;
+    }
+    known = known && getConstant(term, value);
+    offset += (binop->fOpcode == kAdd) ? value : -value;
+    return true;
+}
+
+bool SIMDVectorizer::isVectorAccess(IndexedAddress* address)
+{
+    bool known;
+    int  offset;
+    if (isStructType(address->getName()) || !isAffineIndex(address->getIndex(), known, offset)) {
+        return false;
+    }
+    // Arrays written in the loop can only be read at the index they are written at
+    auto it = fStored.find(address->getName());
+    return (it == fStored.end()) || (known && offset == it->second);
+}
+
+// Call of a helper, whose 'res' type is kept for the backends typing the generated code
+ValueInst* SIMDVectorizer::genHelperCall(const string& model, Typed::VarType type,
+                                         Typed::VarType res, const Values& args)
+{
+    string name = getHelper(model, type);
+    gGlobal->setVarType(name, res);
+    return IB::genFunCallInst(name, args);
+}
+
+ValueInst* SIMDVectorizer::genVector(ValueInst* inst, bool vec, Typed::VarType type)
+{
+    return (vec) ? inst : genHelperCall("set_$0", type, getVectorType(type)->getType(), {inst});
+}
+
+// Load 'lanes' values of an array as a vector of 'type'
+ValueInst* SIMDVectorizer::genArrayLoad(LoadVarInst* inst, Typed::VarType type)
+{
+    IndexedAddress* address = dynamic_cast<IndexedAddress*>(inst->fAddress);
+    if (!address || !isVectorAccess(address) || !isVectorType(type)) {
+        return nullptr;
+    }
+
+    BasicCloneVisitor cloner;
+    ValueInst*        ptr  = IB::genLoadVarAddressInst(address->clone(&cloner));
+    Typed::VarType    elem = Typed::getTypeFromPtr(gGlobal->getVarType(address->getName()));
+    Typed::VarType    res  = getVectorType(type)->getType();
+    if (elem == Typed::kFloatMacro && isSIMDRealType(type)) {
+        return genHelperCall("load_faustfloat_to_$0", type, res, {ptr});
+    } else if (elem == type) {
+        return genHelperCall("load_$0", type, res, {ptr});
+    } else {
+        return nullptr;
+    }
+}
+
+// Math functions with a vector version in explicit mode
+ValueInst* SIMDVectorizer::genMathCall(FunCallInst* inst, bool& vec)
+{
+    static map<string, string> math_table = {
+        {"fabsf", "abs_$0"},     {"fabs", "abs_$0"},   {"sqrtf", "sqrt_$0"}, {"sqrt", "sqrt_$0"},
+        {"floorf", "floor_$0"},  {"floor", "floor_$0"}, {"ceilf", "ceil_$0"}, {"ceil", "ceil_$0"},
+        {"rintf", "nearest_$0"}, {"rint", "nearest_$0"}, {"min_f", "min_$0"}, {"min_", "min_$0"},
+        {"max_f", "max_$0"},     {"max_", "max_$0"}};
+
+    if (!fExplicit || math_table.find(inst->fName) == math_table.end()) {
+        return nullptr;
+    }
+    Typed::VarType type = TypingVisitor::getType(inst->fArgs.front());
+    if (!isSIMDRealType(type) || !isVectorType(type)) {
+        return nullptr;
+    }
+    // Loop invariant arguments are broadcasted
+    Values args;
+    vec = false;
+    for (const auto& it : inst->fArgs) {
+        bool       vec1;
+        ValueInst* value = (TypingVisitor::getType(it) == type) ? vectorize(it, vec1) : nullptr;
+        if (!value) {
+            return nullptr;
+        }
+        args.push_back(genVector(value, vec1, type));
+        vec = vec || vec1;
+    }
+    return genHelperCall(math_table[inst->fName], type, getVectorType(type)->getType(), args);
+}
+
+ValueInst* SIMDVectorizer::vectorize(ValueInst* inst, bool& vec)
+{
+    BasicCloneVisitor cloner;
+
+    // Loop invariant values are kept as scalars
+    vec = false;
+    if (!dependsOnLoop(inst)) {
+        return inst->clone(&cloner);
+    }
+
+    LoadVarInst* load    = dynamic_cast<LoadVarInst*>(inst);
+    ::CastInst*  cast    = dynamic_cast<::CastInst*>(inst);
+    BinopInst*   binop   = dynamic_cast<BinopInst*>(inst);
+    MinusInst*   minus   = dynamic_cast<MinusInst*>(inst);
+    FunCallInst* funcall = dynamic_cast<FunCallInst*>(inst);
+
+    if (load) {
+        vec = true;
+        if (dynamic_cast<NamedAddress*>(load->fAddress)) {
+            // Vector local, the loop index itself cannot be used as a value
+            return (fLocals.find(load->getName()) != fLocals.end())
+                       ? IB::genLoadVarInst(IB::genNamedAddress(getVectorName(load->getName()),
+                                                                Address::kStack))
+                       : nullptr;
+        } else {
+            return genArrayLoad(load, TypingVisitor::getType(load));
+        }
+
+    } else if (cast) {
+        Typed::VarType type = cast->fType->getType();
+        LoadVarInst*   arg  = dynamic_cast<LoadVarInst*>(cast->fInst);
+        if (arg && TypingVisitor::getType(arg) == Typed::kFloatMacro) {
+            vec = true;
+            return genArrayLoad(arg, type);
+        }
+        bool       vec1;
+        ValueInst* value = vectorize(cast->fInst, vec1);
+        if (!value || !vec1) {
+            return (value) ? IB::genCastInst(value, cast->fType) : nullptr;
+        }
+        Typed::VarType from = TypingVisitor::getType(cast->fInst);
+        vec                 = true;
+        if (!isVectorType(from) || !isVectorType(type)) {
+            return nullptr;
+        } else if (from == type) {
+            return value;
+        } else if (from == Typed::kInt32 && isSIMDRealType(type)) {
+            return genHelperCall("int_to_$0", type, getVectorType(type)->getType(), {value});
+        } else if (isSIMDRealType(from) && type == Typed::kInt32) {
+            return genHelperCall("$0_to_int", from, getVectorType(type)->getType(), {value});
+        } else {
+            return nullptr;
+        }
+
+    } else if (binop) {
+        Typed::VarType type    = TypingVisitor::getType(binop);
+        int            op      = binop->fOpcode;
+        bool           real_op = (op == kAdd || op == kSub || op == kMul || op == kDiv);
+        bool           int_op  = (op == kRem || op == kAND || op == kOR || op == kXOR ||
+                                  op == kLsh || op == kARsh);
+        if (!isVectorType(type) || !(real_op || (int_op && type == Typed::kInt32)) ||
+            TypingVisitor::getType(binop->fInst1) != type ||
+            TypingVisitor::getType(binop->fInst2) != type) {
+            return nullptr;
+        }
+        bool       vec1, vec2;
+        ValueInst* value1 = vectorize(binop->fInst1, vec1);
+        ValueInst* value2 = (value1) ? vectorize(binop->fInst2, vec2) : nullptr;
+        if (!value2) {
+            return nullptr;
+        }
+        vec = vec1 || vec2;
+        if (!fExplicit) {
+            return IB::genBinopInst(op, value1, value2);
+        }
+        // Integer division and remainder have no vector version, shift counts are scalars
+        static map<int, string> op_table = {{kAdd, "add_$0"}, {kSub, "sub_$0"}, {kMul, "mul_$0"},
+                                            {kDiv, "div_$0"}, {kAND, "and_$0"}, {kOR, "or_$0"},
+                                            {kXOR, "xor_$0"}, {kLsh, "shl_$0"}, {kARsh, "shr_$0"}};
+        bool shift = (op == kLsh || op == kARsh);
+        if (op == kRem || (op == kDiv && type == Typed::kInt32) || (shift && vec2)) {
+            return nullptr;
+        }
+        return genHelperCall(
+            op_table[op], type, getVectorType(type)->getType(),
+            {genVector(value1, vec1, type), (shift) ? value2 : genVector(value2, vec2, type)});
+
+    } else if (minus) {
+        ValueInst* value = vectorize(minus->fInst, vec);
+        if (!value || !fExplicit) {
+            return (value) ? IB::genMinusInst(value) : nullptr;
+        }
+        Typed::VarType type = TypingVisitor::getType(minus->fInst);
+        return genHelperCall("neg_$0", type, getVectorType(type)->getType(), {value});
+
+    } else if (funcall) {
+        return genMathCall(funcall, vec);
+
+    } else {
+        // Select, comparisons...
+        return nullptr;
+    }
+}
+
+StatementInst* SIMDVectorizer::vectorize(StatementInst* inst)
+{
+    BasicCloneVisitor cloner;
+
+    DeclareVarInst* declare = dynamic_cast<DeclareVarInst*>(inst);
+    StoreVarInst*   store   = dynamic_cast<StoreVarInst*>(inst);
+
+    if (dynamic_cast<LabelInst*>(inst) || dynamic_cast<NullStatementInst*>(inst)) {
+        return inst->clone(&cloner);
+
+    } else if (declare) {
+        if (!declare->fValue || !declare->fAddress->isStack()) {
+            return nullptr;
+        }
+        bool       vec;
+        ValueInst* value = vectorize(declare->fValue, vec);
+        if (!value || !vec) {
+            // Loop invariant locals are kept as scalars
+            return (value) ? inst->clone(&cloner) : nullptr;
+        }
+        Typed::VarType type = declare->fType->getType();
+        if (!isVectorType(type)) {
+            return nullptr;
+        }
+        fLocals[declare->getName()] = type;
+        return IB::genDeclareVarInst(
+            IB::genNamedAddress(getVectorName(declare->getName()), Address::kStack),
+            getVectorType(type), value);
+
+    } else if (store) {
+        IndexedAddress* address = dynamic_cast<IndexedAddress*>(store->fAddress);
+        bool            known;
+        int             offset;
+        if (!address || isStructType(address->getName()) ||
+            !isAffineIndex(address->getIndex(), known, offset) ||
+            (known ? offset : INT_MAX) != fStored[address->getName()]) {
+            return nullptr;
+        }
+        Typed::VarType type  = Typed::getTypeFromPtr(gGlobal->getVarType(address->getName()));
+        ValueInst*     value = store->fValue;
+        string         model;
+        if (type == Typed::kFloatMacro) {
+            // FAUSTFLOAT outputs are written with a cast
+            ::CastInst* cast = dynamic_cast<::CastInst*>(value);
+            if (!cast) {
+                return nullptr;
+            }
+            value = cast->fInst;
+            type  = TypingVisitor::getType(value);
+            model = "store_$0_to_faustfloat";
+            if (!isSIMDRealType(type)) {
+                return nullptr;
+            }
+        } else if (TypingVisitor::getType(value) == type) {
+            model = "store_$0";
+        } else {
+            return nullptr;
+        }
+        bool       vec;
+        ValueInst* res = (isVectorType(type)) ? vectorize(value, vec) : nullptr;
+        if (!res) {
+            return nullptr;
+        }
+        return IB::genDropInst(
+            genHelperCall(model, type, Typed::kVoid,
+                          {IB::genLoadVarAddressInst(address->clone(&cloner)),
+                           genVector(res, vec, type)}));
+
+    } else {
+        return nullptr;
+    }
+}
+
+StatementInst* SIMDVectorizer::vectorizeLoop(ForLoopInst* inst)
+{
+    if (inst->fIsRecursive) {
+        return nullptr;
+    }
+
+    // 'for (int i = 0; i < size; i = i + 1)' with 'size' a multiple of the lanes number, or any
+    // loop invariant 'size' in remainder mode
+    DeclareVarInst* init      = dynamic_cast<DeclareVarInst*>(inst->fInit);
+    BinopInst*      end       = dynamic_cast<BinopInst*>(inst->fEnd);
+    StoreVarInst*   increment = dynamic_cast<StoreVarInst*>(inst->fIncrement);
+    int             start, size, step;
+    if (!init || !init->fValue || !getConstant(init->fValue, start) || start != 0) {
+        return nullptr;
+    }
+    fIndex = init->getName();
+    fStored.clear();
+    fLocals.clear();
+    if (!end || end->fOpcode != kLT || !isIndex(end->fInst1)) {
+        return nullptr;
+    }
+    bool constant = getConstant(end->fInst2, size) && (size % fLanes == 0);
+    if (!constant && !(fRemainder && !dependsOnLoop(end->fInst2))) {
+        return nullptr;
+    }
+    BinopInst* next = (increment) ? dynamic_cast<BinopInst*>(increment->fValue) : nullptr;
+    if (!next || increment->getName() != fIndex || next->fOpcode != kAdd ||
+        !isIndex(next->fInst1) || !getConstant(next->fInst2, step) || step != 1) {
+        return nullptr;
+    }
+
+    // Arrays are first marked as written, then with the offset of their (single) written index,
+    // or INT_MAX for an index with a loop invariant offset (like outputs) then never read back
+    for (const auto& it : inst->fCode->fCode) {
+        StoreVarInst* store = dynamic_cast<StoreVarInst*>(it);
+        if (store) {
+            fStored[store->getName()] = INT_MIN;
+        }
+    }
+    map<string, int> stored;
+    for (const auto& it : inst->fCode->fCode) {
+        StoreVarInst*   store   = dynamic_cast<StoreVarInst*>(it);
+        IndexedAddress* address = (store) ? dynamic_cast<IndexedAddress*>(store->fAddress) : nullptr;
+        bool            known;
+        int             offset;
+        if (!store) {
+            continue;
+        } else if (!address || !isAffineIndex(address->getIndex(), known, offset) ||
+                   (stored.find(store->getName()) != stored.end() &&
+                    (!known || stored[store->getName()] != offset))) {
+            return nullptr;
+        }
+        stored[store->getName()] = (known) ? offset : INT_MAX;
+    }
+    fStored = stored;
+
+    BlockInst* code = IB::genBlockInst();
+    for (const auto& it : inst->fCode->fCode) {
+        StatementInst* res = vectorize(it);
+        if (!res) {
+            return nullptr;
+        }
+        code->pushBackInst(res);
+    }
+
+    // 'for (int i = 0; i < size; i = i + lanes)', or 'i < (size & -lanes)' in remainder mode
+    BasicCloneVisitor cloner;
+    ValueInst*        index   = IB::genLoadVarInst(increment->fAddress->clone(&cloner));
+    ValueInst*        vec_end = (constant) ? end->clone(&cloner)
+                                           : IB::genLessThan(end->fInst1->clone(&cloner),
+                                                      IB::genAnd(end->fInst2->clone(&cloner),
+                                                                 IB::genInt32NumInst(-fLanes)));
+    ForLoopInst* loop = IB::genForLoopInst(
+        init->clone(&cloner), vec_end,
+        IB::genStoreVarInst(increment->fAddress->clone(&cloner), IB::genAdd(index, fLanes)), code,
+        false);
+
+    StatementInst* vec_code = loop;
+    if (!constant) {
+        // The remaining frames are computed by the scalar loop starting at 'size & -lanes'. Both
+        // loops are guarded, since some backends (like wasm) test the loop condition at the end
+        ForLoopInst* remainder = IB::genForLoopInst(
+            IB::genDeclareVarInst(init->fAddress->clone(&cloner), init->fType->clone(&cloner),
+                                  IB::genAnd(end->fInst2->clone(&cloner),
+                                             IB::genInt32NumInst(-fLanes))),
+            end->clone(&cloner), increment->clone(&cloner),
+            static_cast<BlockInst*>(inst->fCode->clone(&cloner)), false);
+        BlockInst* block = IB::genBlockInst();
+        block->pushBackInst(IB::genIfInst(
+            IB::genGreaterEqual(end->fInst2->clone(&cloner), IB::genInt32NumInst(fLanes)),
+            IB::genBlockInst({loop})));
+        block->pushBackInst(IB::genIfInst(
+            IB::genNotEqual(IB::genAnd(end->fInst2->clone(&cloner), IB::genInt32NumInst(fLanes - 1)),
+                            IB::genInt32NumInst(0)),
+            IB::genBlockInst({remainder})));
+        vec_code = block;
+    }
+    if (fExplicit) {
+        return vec_code;
+    }
+
+    // The scalar loop is kept for compilers without vector extensions
+    BlockInst* block = IB::genBlockInst();
+    block->pushBackInst(IB::genLabelInst("#ifdef FAUSTVEC"));
+    block->pushBackInst(IB::genLabelInst("FAUSTVEC_PSABI_PUSH"));
+    block->pushBackInst(vec_code);
+    block->pushBackInst(IB::genLabelInst("FAUSTVEC_PSABI_POP"));
+    block->pushBackInst(IB::genLabelInst("#else"));
+    block->pushBackInst(inst->clone(&cloner));
+    block->pushBackInst(IB::genLabelInst("#endif"));
+    return block;
+}
+
+StatementInst* SIMDVectorizer::visit(DeclareVarInst* inst)
+{
+    Int32NumInst* num = dynamic_cast<Int32NumInst*>(inst->fValue);
+    if (num && inst->fType->getType() == Typed::kInt32) {
+        fConstants[inst->getName()] = num->fNum;
+    } else {
+        fConstants.erase(inst->getName());
+    }
+    return BasicCloneVisitor::visit(inst);
+}
+
+StatementInst* SIMDVectorizer::visit(StoreVarInst* inst)
+{
+    fConstants.erase(inst->getName());
+    return BasicCloneVisitor::visit(inst);
+}
+
+StatementInst* SIMDVectorizer::visit(ForLoopInst* inst)
+{
+    StatementInst* res = vectorizeLoop(inst);
+    return (res) ? res : BasicCloneVisitor::visit(inst);
+}
+
+SIMDAlignedVersion::SIMDAlignedVersion(int lanes, const set<string>& buffers)
+    : fLanes(lanes), fRenamed(0), fBuffers(buffers)
+{
+    static map<string, string> model_table = {{"load_$0", "loada_$0"},
+                                              {"store_$0", "storea_$0"},
+                                              {"load_faustfloat_to_$0", "loada_faustfloat_to_$0"},
+                                              {"store_$0_to_faustfloat", "storea_$0_to_faustfloat"}};
+    for (Typed::VarType type : {Typed::kFloat, Typed::kDouble}) {
+        for (const auto& it : model_table) {
+            fAligned[getSIMDHelper(lanes, it.first, type)] = getSIMDHelper(lanes, it.second, type);
+        }
+    }
+}
+
+ValueInst* SIMDAlignedVersion::visit(FunCallInst* inst)
+{
+    FunCallInst* res = static_cast<FunCallInst*>(BasicCloneVisitor::visit(inst));
+    auto         it  = fAligned.find(inst->fName);
+    if (it == fAligned.end()) {
+        return res;
+    }
+
+    // Only 'buffer[i]' accesses, with 'i' the vector loop index, are aligned
+    LoadVarAddressInst* ptr = dynamic_cast<LoadVarAddressInst*>(inst->fArgs.front());
+    IndexedAddress* address = (ptr) ? dynamic_cast<IndexedAddress*>(ptr->fAddress) : nullptr;
+    LoadVarInst*    index   = (address) ? dynamic_cast<LoadVarInst*>(address->getIndex()) : nullptr;
+    if (index && index->fAddress->isLoop() &&
+        fBuffers.find(address->getName()) != fBuffers.end()) {
+        gGlobal->setVarType(it->second, gGlobal->getVarType(inst->fName));
+        fRenamed++;
+        return IB::genFunCallInst(it->second, res->fArgs);
+    }
+    return res;
+}
+
+BlockInst* SIMDAlignedVersion::getCode(BlockInst* src, const Values& buffers)
+{
+    BlockInst* aligned = static_cast<BlockInst*>(src->clone(this));
+    if (fRenamed == 0) {
+        return src;
+    }
+    string name = getSIMDHelper(fLanes, "aligned_$0", itfloat());
+    gGlobal->setVarType(name, Typed::kInt32);
+    return IB::genBlockInst({IB::genIfInst(IB::genFunCallInst(name, buffers), aligned, src)});
+}
+
+void generateSIMDPrelude(std::ostream* out, int lanes)
+{
+    string n = to_string(lanes);
+    *out << "#if !defined(FAUSTVEC_NOSIMD) && (defined(__clang__) || (defined(__GNUC__) && "
+            "__GNUC__ >= 9))"
+         << endl;
+    *out << "#define FAUSTVEC" << endl;
+    *out << "#endif" << endl;
+    // Vectors wider than the target ones are passed in memory by the (static inline) helpers, the
+    // ABI warning is only silenced for their definitions and the vectorized loops calling them
+    *out << "#if defined(FAUSTVEC) && !defined(FAUSTVEC_PSABI_PUSH)" << endl;
+    *out << "#if defined(__clang__)" << endl;
+    *out << "#define FAUSTVEC_PSABI_PUSH" << endl;
+    *out << "#define FAUSTVEC_PSABI_POP" << endl;
+    *out << "#else" << endl;
+    *out << "#define FAUSTVEC_PSABI_PUSH _Pragma(\"GCC diagnostic push\") "
+            "_Pragma(\"GCC diagnostic ignored \\\"-Wpsabi\\\"\")"
+         << endl;
+    *out << "#define FAUSTVEC_PSABI_POP _Pragma(\"GCC diagnostic pop\")" << endl;
+    *out << "#endif" << endl;
+    *out << "#endif" << endl;
+    *out << subst("#if defined(FAUSTVEC) && !defined(__FAUSTVEC$0__)", n) << endl;
+    *out << subst("#define __FAUSTVEC$0__", n) << endl;
+    *out << "FAUSTVEC_PSABI_PUSH" << endl;
+    for (const auto& it : {"float", "double", "int", "FAUSTFLOAT"}) {
+        string type = it;
+        string name = (type == "FAUSTFLOAT") ? "faustfloat" : type;
+        *out << subst("typedef $1 faustvec$0_$2 __attribute__((vector_size($0 * sizeof($1))));", n,
+                      type, name)
+             << endl;
+    }
+    for (const auto& it : {"float", "double", "int"}) {
+        string type = it;
+        *out << subst(
+                    "static inline faustvec$0_$1 faustvec$0_load_$1(const $1* p) { faustvec$0_$1 "
+                    "v; __builtin_memcpy(&v, p, sizeof(v)); return v; }",
+                    n, type)
+             << endl;
+        *out << subst(
+                    "static inline void faustvec$0_store_$1($1* p, faustvec$0_$1 v) { "
+                    "__builtin_memcpy(p, &v, sizeof(v)); }",
+                    n, type)
+             << endl;
+        *out << subst(
+                    "static inline faustvec$0_$1 faustvec$0_set_$1($1 x) { faustvec$0_$1 v; for "
+                    "(int i = 0; i < $0; i++) v[i] = x; return v; }",
+                    n, type)
+             << endl;
+    }
+    // GCC reports the wider vectors returned by __builtin_convertvector at the end of the translation
+    // unit (so outside of the pragma scope), the widening conversions are done lane by lane
+    for (const auto& it : {"float", "double"}) {
+        string type = it;
+        *out << subst(
+                    "static inline faustvec$0_$1 faustvec$0_load_faustfloat_to_$1(const "
+                    "FAUSTFLOAT* p) { faustvec$0_$1 v; for (int i = 0; i < $0; i++) v[i] = p[i]; "
+                    "return v; }",
+                    n, type)
+             << endl;
+        *out << subst(
+                    "static inline void faustvec$0_store_$1_to_faustfloat(FAUSTFLOAT* p, "
+                    "faustvec$0_$1 v) { faustvec$0_faustfloat r = __builtin_convertvector(v, "
+                    "faustvec$0_faustfloat); __builtin_memcpy(p, &r, sizeof(r)); }",
+                    n, type)
+             << endl;
+        *out << subst(
+                    "static inline faustvec$0_int faustvec$0_$1_to_int(faustvec$0_$1 v) { return "
+                    "__builtin_convertvector(v, faustvec$0_int); }",
+                    n, type)
+             << endl;
+        *out << subst(
+                    "static inline faustvec$0_$1 faustvec$0_int_to_$1(faustvec$0_int v) { "
+                    "faustvec$0_$1 r; for (int i = 0; i < $0; i++) r[i] = v[i]; return r; }",
+                    n, type)
+             << endl;
+    }
+    *out << "FAUSTVEC_PSABI_POP" << endl;
+    *out << "#endif" << endl;
+}
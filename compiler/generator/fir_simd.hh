@@ -0,0 +1,145 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _FIR_SIMD_H
+#define _FIR_SIMD_H
+
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+
+#include "instructions.hh"
+
+/*
+ Explicit SIMD code for the vectorizable loops of the -vec mode (-simd <n> option).
+
+ A non recursive 'for (int i = 0; i < size; i = i + 1)' loop, where 'size' is a constant (or a
+ variable declared with a constant like 'vsize' in the main loop) multiple of the number of lanes,
+ is rewritten as a loop stepping 'lanes' samples at a time where:
+ - arr[i], arr[i + k] and arr[i - k] (with k loop invariant) accesses are done with the
+   'faustvec<n>_load_<type>' and 'faustvec<n>_store_<type>' helpers,
+ - FAUSTFLOAT inputs/outputs are converted with 'faustvec<n>_load_faustfloat_to_<type>' and
+   'faustvec<n>_store_<type>_to_faustfloat',
+ - local variables become 'faustvec<n>_<type>' vectors,
+ - arithmetic (+, -, *, / and integer %, &, |, ^, <<, >>) is done on vectors, loop invariant
+   scalars being implicitly broadcasted, and int/real casts use 'faustvec<n>_<type1>_to_<type2>'.
+
+ Loops containing anything else (function calls, select, comparisons, scalar stores, arrays read
+ at another index than the one they are written at...) are kept unchanged, like the remaining
+ frames loop whose size is not constant.
+
+ The types and helpers (using GCC/Clang vector extensions) are generated by generateSIMDPrelude,
+ which only defines FAUSTVEC when the compiler supports them: the original scalar loop is kept in
+ the '#else' branch.
+
+ Backends without vector operators (like wasm/wast with 128 bits vectors, or LLVM) use the 'explicit'
+ mode where all operations are 'faustvec<n>_<op>_<type>' helpers, with an explicit
+ 'faustvec<n>_set_<type>' broadcast of scalars, and a few math functions (abs, sqrt, min, max...) are
+ also vectorized. A vector size (in bytes) can restrict the rewritten types to the target ones. In the
+ 'remainder' mode, loops with a loop invariant but not constant size are split in a vector loop
+ followed by a scalar loop on the remaining frames. No '#ifdef FAUSTVEC' fallback is generated in
+ those modes.
+*/
+
+struct SIMDVectorizer : public BasicCloneVisitor {
+    int  fLanes;
+    bool fExplicit;
+    bool fRemainder;
+    int  fVectorSize;
+
+    // Variables declared with a constant value (like 'vsize')
+    std::map<std::string, int> fConstants;
+
+    // Vector types of the rewritten local variables
+    std::map<Typed::VarType, VectorTyped*> fVectorTypes;
+
+    // State of the currently rewritten loop : index, arrays written in the loop (with the constant
+    // offset to the index they are written at) and vector locals
+    std::string                           fIndex;
+    std::map<std::string, int>            fStored;
+    std::map<std::string, Typed::VarType> fLocals;
+
+    SIMDVectorizer(int lanes, bool explicit_ops = false, bool remainder = false,
+                   int vector_size = 0)
+        : fLanes(lanes), fExplicit(explicit_ops), fRemainder(remainder), fVectorSize(vector_size)
+    {
+    }
+
+    virtual StatementInst* visit(DeclareVarInst* inst);
+    virtual StatementInst* visit(StoreVarInst* inst);
+    virtual StatementInst* visit(ForLoopInst* inst);
+
+    BlockInst* getCode(BlockInst* src) { return static_cast<BlockInst*>(src->clone(this)); }
+
+    std::string  getHelper(const std::string& model, Typed::VarType type);
+    std::string  getVectorName(const std::string& name) { return name + "_vec"; }
+    VectorTyped* getVectorType(Typed::VarType type);
+    bool         isVectorType(Typed::VarType type);
+
+    bool isIndex(ValueInst* inst);
+    bool getConstant(ValueInst* inst, int& res);
+    bool dependsOnLoop(ValueInst* inst);
+    bool isAffineIndex(ValueInst* index, bool& known, int& offset);
+    bool isVectorAccess(IndexedAddress* address);
+
+    // The 'vectorize' functions return nullptr when the code cannot be rewritten
+    ValueInst*     genHelperCall(const std::string& model, Typed::VarType type, Typed::VarType res,
+                                 const Values& args);
+    ValueInst*     genVector(ValueInst* inst, bool vec, Typed::VarType type);
+    ValueInst*     genArrayLoad(LoadVarInst* inst, Typed::VarType type);
+    ValueInst*     genMathCall(FunCallInst* inst, bool& vec);
+    ValueInst*     vectorize(ValueInst* inst, bool& vec);
+    StatementInst* vectorize(StatementInst* inst);
+    StatementInst* vectorizeLoop(ForLoopInst* inst);
+};
+
+/*
+ Versioning of the rewritten code on the audio buffers alignment (used by the LLVM backend): the
+ block is duplicated under a 'faustvec<n>_aligned_<type>(inputs[0], ..., outputs[0], ...)' test,
+ and in the aligned version, the vectors of the audio buffers accessed at the loop index (so at a
+ multiple of the lanes number from the buffer start) use the 'loada' and 'storea' helpers, like
+ 'faustvec<n>_loada_faustfloat_to_<type>' or 'faustvec<n>_storea_<type>'.
+*/
+
+struct SIMDAlignedVersion : public BasicCloneVisitor {
+    int                   fLanes;
+    int                   fRenamed;
+    std::set<std::string> fBuffers;  // Local audio buffers pointers (like 'input0' or 'output0')
+
+    // Table : unaligned helper, aligned helper
+    std::map<std::string, std::string> fAligned;
+
+    SIMDAlignedVersion(int lanes, const std::set<std::string>& buffers);
+
+    virtual ValueInst* visit(FunCallInst* inst);
+
+    // Returns 'src' unchanged when it has no buffer access to align
+    BlockInst* getCode(BlockInst* src, const Values& buffers);
+};
+
+// Name of the 'faustvec<lanes>_<model>' helper, with '$0' replaced by the 'type' name
+std::string getSIMDHelper(int lanes, const std::string& model, Typed::VarType type);
+
+// Vector types and helpers used by the rewritten loops, for the C and C++ backends
+void generateSIMDPrelude(std::ostream* out, int lanes);
+
+#endif
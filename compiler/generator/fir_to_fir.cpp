@@ -267,3 +267,607 @@ StatementInst* ControlExpander::visit(BlockInst* inst)
 
     return cloned;
 }
+
+/*
+ Optimizations of the scalar DSP loop code
+*/
+
+bool isPureFunction(const string& name)
+{
+    static set<string> int_functions  = {"abs", "min_i", "max_i"};
+    static set<string> real_functions = {
+        "fabs",  "acos", "asin",  "atan",  "atan2", "ceil",      "cos",   "exp",   "exp10",
+        "floor", "fmod", "log",   "log10", "min_",  "max_",      "pow",   "remainder", "rint",
+        "round", "sin",  "sqrt",  "tan",   "acosh", "asinh",     "atanh", "cosh",  "sinh",
+        "tanh",  "isnan", "isinf", "copysign"};
+
+    if (int_functions.count(name) || real_functions.count(name)) {
+        return true;
+    }
+    // Float and quad versions
+    char suffix = name.back();
+    if ((suffix == 'f' || suffix == 'l') && real_functions.count(name.substr(0, name.size() - 1))) {
+        return true;
+    }
+    // 'faustpower' functions generated in the DSP code (see powprim.hh)
+    return name.find("faustpower") != string::npos;
+}
+
+bool isCompoundValue(ValueInst* inst)
+{
+    return dynamic_cast<MinusInst*>(inst) || dynamic_cast<BinopInst*>(inst) ||
+           dynamic_cast<::CastInst*>(inst) || dynamic_cast<BitcastInst*>(inst) ||
+           dynamic_cast<FunCallInst*>(inst) || dynamic_cast<Select2Inst*>(inst);
+}
+
+// Arrays accessed with pointers (like the inputs/outputs buffers) may alias
+static bool isPointerAccess(IndexedAddress* indexed)
+{
+    Address* base = indexed->fAddress;
+    return !(base->isStruct() || base->isStaticStruct() || (base->getAccess() & Address::kGlobal));
+}
+
+string getMemoryName(Address* address)
+{
+    IndexedAddress* indexed = dynamic_cast<IndexedAddress*>(address);
+    return (indexed && isPointerAccess(indexed)) ? "*" : address->getName();
+}
+
+template <typename NUM>
+static string getNumKey(const string& prefix, NUM num)
+{
+    stringstream key;
+    key << prefix << std::hexfloat << num;
+    return key.str();
+}
+
+string PureValueKey::getKey(Address* address)
+{
+    if (address->isVolatile()) {
+        fPure = false;
+        return "";
+    }
+
+    string name = address->getName();
+    if (!gGlobal->hasVarType(name)) {
+        fPure = false;
+        return "";
+    }
+    fReads.insert(name);
+    if (address->isStack() || address->isLoop()) {
+        fStackReads.insert(name);
+    }
+
+    IndexedAddress* indexed = dynamic_cast<IndexedAddress*>(address);
+    if (indexed) {
+        fCost++;
+        if (isPointerAccess(indexed)) {
+            fReads.insert("*");
+        }
+        string key = getKey(indexed->fAddress);
+        for (const auto& it : indexed->fIndices) {
+            key += "[" + getKey(it) + "]";
+        }
+        return key;
+    } else {
+        return name;
+    }
+}
+
+string PureValueKey::getKey(ValueInst* inst)
+{
+    if (!fPure) {
+        return "";
+    } else if (LoadVarInst* load = dynamic_cast<LoadVarInst*>(inst)) {
+        return getKey(load->fAddress);
+    } else if (FloatNumInst* num = dynamic_cast<FloatNumInst*>(inst)) {
+        return getNumKey("f", num->fNum);
+    } else if (DoubleNumInst* num = dynamic_cast<DoubleNumInst*>(inst)) {
+        return getNumKey("d", num->fNum);
+    } else if (QuadNumInst* num = dynamic_cast<QuadNumInst*>(inst)) {
+        return getNumKey("q", num->fNum);
+    } else if (FixedPointNumInst* num = dynamic_cast<FixedPointNumInst*>(inst)) {
+        return getNumKey("x", num->fNum);
+    } else if (Int32NumInst* num = dynamic_cast<Int32NumInst*>(inst)) {
+        return "i" + std::to_string(num->fNum);
+    } else if (Int64NumInst* num = dynamic_cast<Int64NumInst*>(inst)) {
+        return "l" + std::to_string(num->fNum);
+    } else if (BoolNumInst* num = dynamic_cast<BoolNumInst*>(inst)) {
+        return "b" + std::to_string(num->fNum);
+    } else if (MinusInst* minus = dynamic_cast<MinusInst*>(inst)) {
+        fCost++;
+        return "-(" + getKey(minus->fInst) + ")";
+    } else if (BinopInst* binop = dynamic_cast<BinopInst*>(inst)) {
+        fCost++;
+        string key1 = getKey(binop->fInst1);
+        string key2 = getKey(binop->fInst2);
+        return "(" + key1 + " " + std::to_string(binop->fOpcode) + " " + key2 + ")";
+    } else if (::CastInst* cast = dynamic_cast<::CastInst*>(inst)) {
+        fCost++;
+        return "cast" + std::to_string(cast->fType->getType()) + "(" + getKey(cast->fInst) + ")";
+    } else if (BitcastInst* cast = dynamic_cast<BitcastInst*>(inst)) {
+        fCost++;
+        return "bitcast" + std::to_string(cast->fType->getType()) + "(" + getKey(cast->fInst) +
+               ")";
+    } else if (FunCallInst* call = dynamic_cast<FunCallInst*>(inst)) {
+        if (call->fMethod || !isPureFunction(call->fName) || !gGlobal->hasVarType(call->fName)) {
+            fPure = false;
+            return "";
+        }
+        fCost += 2;
+        string key = call->fName + "(";
+        for (const auto& it : call->fArgs) {
+            key += getKey(it) + ",";
+        }
+        return key + ")";
+    } else if (Select2Inst* select = dynamic_cast<Select2Inst*>(inst)) {
+        fCost++;
+        string key_cond = getKey(select->fCond);
+        string key_then = getKey(select->fThen);
+        string key_else = getKey(select->fElse);
+        return "select2(" + key_cond + "," + key_then + "," + key_else + ")";
+    } else {
+        // TeeVarInst, LoadVarAddressInst, arrays...
+        fPure = false;
+        return "";
+    }
+}
+
+// Values are computed in variables of these types only
+static bool isSharedType(Typed::VarType type)
+{
+    return (type == Typed::kInt32) || (type == Typed::kFloat) || (type == Typed::kDouble);
+}
+
+static string getSharedName(Typed::VarType type, const string& prefix)
+{
+    return ((type == Typed::kInt32) ? "i" : "f") + gGlobal->getFreshID(prefix);
+}
+
+// An integer division may trap when computed even if the loop is not executed
+struct IntDivisionChecker : public DispatchVisitor {
+    bool fFound = false;
+
+    using DispatchVisitor::visit;
+
+    virtual void visit(BinopInst* inst)
+    {
+        if ((inst->fOpcode == kDiv || inst->fOpcode == kRem) &&
+            !isRealType(TypingVisitor::getType(inst))) {
+            Int32NumInst* num32 = dynamic_cast<Int32NumInst*>(inst->fInst2);
+            Int64NumInst* num64 = dynamic_cast<Int64NumInst*>(inst->fInst2);
+            fFound = fFound || !((num32 && num32->fNum != 0) || (num64 && num64->fNum != 0));
+        }
+        DispatchVisitor::visit(inst);
+    }
+};
+
+ValueInst* LoopInvariantMover::move(ValueInst* inst)
+{
+    // Constant values are left to the backends
+    PureValueKey key(inst);
+    if (!key.isPure() || key.fReads.empty()) {
+        return nullptr;
+    }
+    for (const auto& it : key.fReads) {
+        if (fWritten.find(it) != fWritten.end()) {
+            return nullptr;
+        }
+    }
+    for (const auto& it : key.fStackReads) {
+        if (fDefined.find(it) == fDefined.end()) {
+            return nullptr;
+        }
+    }
+
+    auto var = fMovedVars.find(key.fKey);
+    if (var == fMovedVars.end()) {
+        Typed::VarType type = TypingVisitor::getType(inst);
+        if (!isSharedType(type)) {
+            return nullptr;
+        }
+        IntDivisionChecker checker;
+        inst->accept(&checker);
+        if (checker.fFound) {
+            return nullptr;
+        }
+        string            name = getSharedName(type, "Slow");
+        BasicCloneVisitor cloner;
+        fMoved->pushBackInst(IB::genDecStackVar(name, type, inst->clone(&cloner)));
+        var = fMovedVars.insert(make_pair(key.fKey, name)).first;
+    }
+    return IB::genLoadStackVar(var->second);
+}
+
+ValueInst* LoopInvariantMover::visit(Select2Inst* inst)
+{
+    ValueInst* res = move(inst);
+    if (res) {
+        return res;
+    }
+    // Branches are kept in place
+    BasicCloneVisitor cloner;
+    ValueInst*        cloned_then = inst->fThen->clone(&cloner);
+    ValueInst*        cloned_else = inst->fElse->clone(&cloner);
+    ValueInst*        cloned_cond = inst->fCond->clone(this);
+    return new Select2Inst(cloned_cond, cloned_then, cloned_else);
+}
+
+StatementInst* LoopInvariantMover::visit(ControlInst* inst)
+{
+    BasicCloneVisitor cloner;
+    ValueInst*        cloned_cond = inst->fCond->clone(this);
+    return new ControlInst(cloned_cond, inst->fStatement->clone(&cloner));
+}
+
+StatementInst* LoopInvariantMover::visit(IfInst* inst)
+{
+    BasicCloneVisitor cloner;
+    ValueInst*        cloned_cond = inst->fCond->clone(this);
+    return new IfInst(cloned_cond, static_cast<BlockInst*>(inst->fThen->clone(&cloner)),
+                      static_cast<BlockInst*>(inst->fElse->clone(&cloner)));
+}
+
+StatementInst* LoopInvariantMover::visit(SwitchInst* inst)
+{
+    BasicCloneVisitor cloner;
+    SwitchInst*       cloned = new SwitchInst(inst->fCond->clone(this));
+    for (const auto& it : inst->fCode) {
+        cloned->addCase(it.first, static_cast<BlockInst*>((it.second)->clone(&cloner)));
+    }
+    return cloned;
+}
+
+// Collect the values of a piece of code
+struct CompoundValuesCollector : public DispatchVisitor {
+    set<ValueInst*> fValues;
+
+    using DispatchVisitor::visit;
+
+    virtual void visit(MinusInst* inst)
+    {
+        fValues.insert(inst);
+        DispatchVisitor::visit(inst);
+    }
+    virtual void visit(BinopInst* inst)
+    {
+        fValues.insert(inst);
+        DispatchVisitor::visit(inst);
+    }
+    virtual void visit(::CastInst* inst)
+    {
+        fValues.insert(inst);
+        DispatchVisitor::visit(inst);
+    }
+    virtual void visit(BitcastInst* inst)
+    {
+        fValues.insert(inst);
+        DispatchVisitor::visit(inst);
+    }
+    virtual void visit(FunCallInst* inst)
+    {
+        fValues.insert(inst);
+        DispatchVisitor::visit(inst);
+    }
+    virtual void visit(Select2Inst* inst)
+    {
+        fValues.insert(inst);
+        DispatchVisitor::visit(inst);
+    }
+};
+
+void CommonSubexpressionEliminator::kill(const set<string>& names)
+{
+    for (auto it = fAvailable.begin(); it != fAvailable.end();) {
+        bool killed = false;
+        for (const auto& name : names) {
+            if (it->second.fReads.find(name) != it->second.fReads.end()) {
+                killed = true;
+                break;
+            }
+        }
+        it = (killed) ? fAvailable.erase(it) : std::next(it);
+    }
+}
+
+void CommonSubexpressionEliminator::ignoreValues(ValueInst* inst)
+{
+    CompoundValuesCollector collector;
+    inst->accept(&collector);
+    for (const auto& it : collector.fValues) {
+        fValueId[it] = -1;
+    }
+}
+
+void CommonSubexpressionEliminator::ignoreValues(StatementInst* inst)
+{
+    CompoundValuesCollector collector;
+    inst->accept(&collector);
+    for (const auto& it : collector.fValues) {
+        fValueId[it] = -1;
+    }
+}
+
+void CommonSubexpressionEliminator::numberAddress(Address* address)
+{
+    IndexedAddress* indexed = dynamic_cast<IndexedAddress*>(address);
+    if (indexed) {
+        numberAddress(indexed->fAddress);
+        for (const auto& it : indexed->fIndices) {
+            numberValue(it);
+        }
+    }
+}
+
+void CommonSubexpressionEliminator::numberValue(ValueInst* inst)
+{
+    if (isCompoundValue(inst)) {
+        PureValueKey key(inst);
+        if (key.isPure() && isSharedType(TypingVisitor::getType(inst))) {
+            int  id;
+            auto available = fAvailable.find(key.fKey);
+            bool found     = available != fAvailable.end();
+            if (found) {
+                id = available->second.fId;
+                fCount[id]++;
+            } else {
+                id         = int(fCount.size());
+                fCount[id] = 1;
+                fCost[id]  = key.fCost;
+                fAvailable[key.fKey] = {id, key.fReads};
+            }
+            // The same value may be used at several places of the FIR tree
+            auto value_id = fValueId.find(inst);
+            if (value_id == fValueId.end()) {
+                fValueId[inst] = id;
+            } else if (value_id->second != id) {
+                value_id->second = -1;
+            }
+            if (found) {
+                return;
+            }
+        }
+    }
+
+    if (LoadVarInst* load = dynamic_cast<LoadVarInst*>(inst)) {
+        numberAddress(load->fAddress);
+    } else if (MinusInst* minus = dynamic_cast<MinusInst*>(inst)) {
+        numberValue(minus->fInst);
+    } else if (BinopInst* binop = dynamic_cast<BinopInst*>(inst)) {
+        numberValue(binop->fInst1);
+        numberValue(binop->fInst2);
+    } else if (::CastInst* cast = dynamic_cast<::CastInst*>(inst)) {
+        numberValue(cast->fInst);
+    } else if (BitcastInst* cast = dynamic_cast<BitcastInst*>(inst)) {
+        numberValue(cast->fInst);
+    } else if (FunCallInst* call = dynamic_cast<FunCallInst*>(inst)) {
+        for (const auto& it : call->fArgs) {
+            numberValue(it);
+        }
+    } else if (Select2Inst* select = dynamic_cast<Select2Inst*>(inst)) {
+        // Only the condition is always computed
+        numberValue(select->fCond);
+        ignoreValues(select->fThen);
+        ignoreValues(select->fElse);
+    } else {
+        ignoreValues(inst);
+    }
+}
+
+void CommonSubexpressionEliminator::numberStatement(StatementInst* inst)
+{
+    WrittenVarsCollector writer;
+    inst->accept(&writer);
+
+    DeclareVarInst* declare = dynamic_cast<DeclareVarInst*>(inst);
+    StoreVarInst*   store   = dynamic_cast<StoreVarInst*>(inst);
+    DropInst*       drop    = dynamic_cast<DropInst*>(inst);
+
+    // Statements only writing their own variable
+    bool simple = false;
+    if (declare) {
+        simple = (writer.fWritten.size() == 1);
+    } else if (store) {
+        simple = (writer.fWritten.size() == 1) && !store->fAddress->isVolatile();
+    } else if (drop) {
+        simple = (writer.fWritten.size() == 0) && drop->fResult;
+    }
+
+    if (simple) {
+        fNumbered.insert(inst);
+        if (declare) {
+            if (declare->fValue) {
+                numberValue(declare->fValue);
+            }
+        } else if (store) {
+            numberAddress(store->fAddress);
+            numberValue(store->fValue);
+        } else {
+            numberValue(drop->fResult);
+        }
+    } else {
+        ignoreValues(inst);
+    }
+
+    kill(writer.fWritten);
+}
+
+ValueInst* CommonSubexpressionEliminator::share(ValueInst* inst)
+{
+    auto value_id = fValueId.find(inst);
+    if (value_id == fValueId.end() || value_id->second < 0) {
+        return nullptr;
+    }
+
+    // Computing the value once costs a store and a load for each use (which are not always free
+    // in the interpreters), so cheap values used a few times are still recomputed
+    int id = value_id->second;
+    if ((fCount[id] - 1) * (fCost[id] - 1) <= 2) {
+        return nullptr;
+    }
+
+    auto var = fVars.find(id);
+    if (var == fVars.end()) {
+        // First computation of the value: keep it in a variable declared before the statement
+        Typed::VarType type = TypingVisitor::getType(inst);
+        string         name = getSharedName(type, "Temp");
+        fValueId.erase(inst);
+        ValueInst* cloned = inst->clone(this);
+        fValueId[inst]    = id;
+        fBlockStack.top()->pushBackInst(IB::genDecStackVar(name, type, cloned));
+        var = fVars.insert(make_pair(id, name)).first;
+    }
+    return IB::genLoadStackVar(var->second);
+}
+
+BlockInst* CommonSubexpressionEliminator::getCode(BlockInst* src)
+{
+    for (const auto& it : src->fCode) {
+        numberStatement(it);
+    }
+
+    BlockInst* cloned = new BlockInst();
+    fBlockStack.push(cloned);
+    for (const auto& it : src->fCode) {
+        if (fNumbered.find(it) != fNumbered.end()) {
+            cloned->pushBackInst(it->clone(this));
+        } else {
+            BasicCloneVisitor cloner;
+            cloned->pushBackInst(it->clone(&cloner));
+        }
+    }
+    fBlockStack.pop();
+    return cloned;
+}
+
+// Location written by a store, if it can be tracked
+static string getStoreLocation(Address* address)
+{
+    if (address->isVolatile()) {
+        return "";
+    }
+    NamedAddress* named = dynamic_cast<NamedAddress*>(address);
+    if (named) {
+        return (named->isStack() || named->isStruct() || named->isStaticStruct()) ? named->getName()
+                                                                                 : "";
+    }
+    IndexedAddress* indexed = dynamic_cast<IndexedAddress*>(address);
+    if (indexed && !isPointerAccess(indexed) && indexed->fIndices.size() == 1) {
+        Int32NumInst* index = dynamic_cast<Int32NumInst*>(indexed->getIndex());
+        if (index && dynamic_cast<NamedAddress*>(indexed->fAddress)) {
+            return indexed->getName() + "[" + std::to_string(index->fNum) + "]";
+        }
+    }
+    return "";
+}
+
+static bool isPureStore(StatementInst* inst, ValueInst* value)
+{
+    WrittenVarsCollector writer;
+    inst->accept(&writer);
+    return (!value || PureValueKey(value).isPure()) && (writer.fNames.size() == 1);
+}
+
+// Remove the stack variables declared in the block which are never read
+static bool removeUnusedVariables(BlockInst* block)
+{
+    ReadVarsCollector reader;
+    block->accept(&reader);
+
+    set<string> declared;
+    set<string> kept;
+    for (const auto& it : block->fCode) {
+        DeclareVarInst* declare = dynamic_cast<DeclareVarInst*>(it);
+        StoreVarInst*   store   = dynamic_cast<StoreVarInst*>(it);
+        if (declare && declare->fAddress->isStack() && !declare->fAddress->isVolatile()) {
+            declared.insert(declare->getName());
+            if (!isPureStore(declare, declare->fValue)) {
+                kept.insert(declare->getName());
+            }
+        } else if (store && dynamic_cast<NamedAddress*>(store->fAddress)) {
+            if (!isPureStore(store, store->fValue)) {
+                kept.insert(store->fAddress->getName());
+            }
+        } else {
+            // Variables written in nested blocks or arrays are kept
+            WrittenVarsCollector writer;
+            it->accept(&writer);
+            kept.insert(writer.fNames.begin(), writer.fNames.end());
+        }
+    }
+
+    bool removed = false;
+    for (auto it = block->fCode.begin(); it != block->fCode.end();) {
+        DeclareVarInst* declare = dynamic_cast<DeclareVarInst*>(*it);
+        StoreVarInst*   store   = dynamic_cast<StoreVarInst*>(*it);
+        string          name    = "";
+        if (declare) {
+            name = declare->getName();
+        } else if (store && dynamic_cast<NamedAddress*>(store->fAddress)) {
+            name = store->fAddress->getName();
+        }
+        if (name != "" && declared.count(name) && !kept.count(name) && !reader.fRead.count(name)) {
+            it      = block->fCode.erase(it);
+            removed = true;
+        } else {
+            it++;
+        }
+    }
+    return removed;
+}
+
+// Remove the stores overwritten later in the block before being read
+static bool removeOverwrittenStores(BlockInst* block)
+{
+    set<string> overwritten;
+    bool        removed = false;
+
+    // Variables read (or possibly read, like with ShiftArrayVarInst) by a statement
+    auto read = [&overwritten](StatementInst* inst, bool store) {
+        ReadVarsCollector reader;
+        inst->accept(&reader);
+        if (!store) {
+            WrittenVarsCollector writer;
+            inst->accept(&writer);
+            reader.fRead.insert(writer.fNames.begin(), writer.fNames.end());
+        }
+        for (const auto& name : reader.fRead) {
+            for (auto it = overwritten.begin(); it != overwritten.end();) {
+                bool same = (*it == name) || (it->compare(0, name.size() + 1, name + "[") == 0);
+                it        = (same) ? overwritten.erase(it) : std::next(it);
+            }
+        }
+    };
+
+    for (auto it = block->fCode.rbegin(); it != block->fCode.rend();) {
+        StoreVarInst*   store   = dynamic_cast<StoreVarInst*>(*it);
+        DeclareVarInst* declare = dynamic_cast<DeclareVarInst*>(*it);
+        string          location = (store) ? getStoreLocation(store->fAddress) : "";
+        bool            tracked  = (location != "") && isPureStore(store, store->fValue);
+        if (tracked) {
+            if (overwritten.count(location)) {
+                it      = std::list<StatementInst*>::reverse_iterator(
+                    block->fCode.erase(std::next(it).base()));
+                removed = true;
+                continue;
+            }
+            overwritten.insert(location);
+        } else if (declare) {
+            overwritten.erase(declare->getName());
+        }
+        read(*it, tracked);
+        it++;
+    }
+    return removed;
+}
+
+BlockInst* DeadStoreRemover::getCode(BlockInst* src)
+{
+    BlockInst* block = new BlockInst();
+    for (const auto& it : src->fCode) {
+        block->pushBackInst(it);
+    }
+    while (removeUnusedVariables(block) | removeOverwrittenStores(block)) {
+    }
+    return block;
+}
@@ -830,4 +830,239 @@ struct NoControlArrayToPointer : public BasicCloneVisitor {
     }
 };
 
+// ==============================================================================
+// Optimizations of the scalar DSP loop code (see CodeContainer::optimizeDSPLoop)
+// ==============================================================================
+
+// Check if 'name' is a math function without side effect
+bool isPureFunction(const std::string& name);
+
+// Check if 'inst' is a value computed by an operation (as opposed to a number or a load)
+bool isCompoundValue(ValueInst* inst);
+
+// Variable written by a store at 'address' ('*' for memory accessed with pointers)
+std::string getMemoryName(Address* address);
+
+/*
+ Key of a value without side effect: two values with the same key compute the same result, as long
+ as none of the variables they read has been written in between. The key is empty for values with
+ side effects, or which are not handled (like TeeVarInst or LoadVarAddressInst).
+ Memory accessed with pointers (like the inputs/outputs buffers, which may alias with -inpl) is
+ read as the '*' variable.
+ */
+struct PureValueKey {
+    std::string           fKey;
+    std::set<std::string> fReads;       // All read variables
+    std::set<std::string> fStackReads;  // Read stack and loop variables
+    int                   fCost;        // Operations count, a function call counting as 2
+
+    PureValueKey(ValueInst* inst) : fCost(0), fPure(true)
+    {
+        fKey = getKey(inst);
+        if (!fPure) {
+            fKey = "";
+        }
+    }
+
+    bool isPure() const { return fKey != ""; }
+
+   private:
+    bool fPure;
+
+    std::string getKey(ValueInst* inst);
+    std::string getKey(Address* address);
+};
+
+// Collect the variables written in a piece of code
+struct WrittenVarsCollector : public DispatchVisitor {
+    std::set<std::string> fWritten;  // As returned by getMemoryName
+    std::set<std::string> fNames;    // Names of the written variables
+    bool fUnsafe;  // If memory can be written in other ways (with variable addresses or methods)
+
+    WrittenVarsCollector() : fUnsafe(false) {}
+
+    using DispatchVisitor::visit;
+
+    virtual void visit(DeclareVarInst* inst)
+    {
+        fWritten.insert(inst->getName());
+        fNames.insert(inst->getName());
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(StoreVarInst* inst)
+    {
+        fWritten.insert(getMemoryName(inst->fAddress));
+        fNames.insert(inst->fAddress->getName());
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(TeeVarInst* inst)
+    {
+        fWritten.insert(getMemoryName(inst->fAddress));
+        fNames.insert(inst->fAddress->getName());
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(ShiftArrayVarInst* inst)
+    {
+        fWritten.insert(inst->fAddress->getName());
+        fNames.insert(inst->fAddress->getName());
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(LoadVarAddressInst* inst)
+    {
+        fUnsafe = true;
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(FunCallInst* inst)
+    {
+        fUnsafe = fUnsafe || inst->fMethod;
+        DispatchVisitor::visit(inst);
+    }
+};
+
+// Collect the variables read in a piece of code
+struct ReadVarsCollector : public DispatchVisitor {
+    std::set<std::string> fRead;
+
+    using DispatchVisitor::visit;
+
+    virtual void visit(LoadVarInst* inst)
+    {
+        fRead.insert(inst->getName());
+        DispatchVisitor::visit(inst);
+    }
+
+    virtual void visit(TeeVarInst* inst)
+    {
+        fRead.insert(inst->getName());
+        DispatchVisitor::visit(inst);
+    }
+};
+
+/*
+ Loop invariant code motion: values of the DSP loop code which only read variables not written in
+ the loop are computed once before the loop, in 'Slow' variables collected in 'fMoved'.
+ Conditionally computed values (in Select2Inst branches, ControlInst, IfInst...) are kept in place.
+ */
+struct LoopInvariantMover : public BasicCloneVisitor {
+    const std::set<std::string>&       fWritten;  // Variables written in the loop
+    const std::set<std::string>&       fDefined;  // Stack variables defined before the loop
+    std::map<std::string, std::string> fMovedVars;
+    BlockInst*                         fMoved;
+
+    LoopInvariantMover(const std::set<std::string>& written, const std::set<std::string>& defined)
+        : fWritten(written), fDefined(defined), fMoved(new BlockInst())
+    {
+    }
+
+    ValueInst* move(ValueInst* inst);
+
+    virtual ValueInst* visit(MinusInst* inst)
+    {
+        ValueInst* res = move(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(BinopInst* inst)
+    {
+        ValueInst* res = move(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(::CastInst* inst)
+    {
+        ValueInst* res = move(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(BitcastInst* inst)
+    {
+        ValueInst* res = move(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(FunCallInst* inst)
+    {
+        ValueInst* res = move(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(Select2Inst* inst);
+
+    virtual StatementInst* visit(ControlInst* inst);
+    virtual StatementInst* visit(IfInst* inst);
+    virtual StatementInst* visit(SwitchInst* inst);
+};
+
+/*
+ Common subexpression elimination in the straight-line DSP loop code: values computed several
+ times, with none of the variables they read written in between, are computed once in a 'Temp'
+ variable when it saves enough operations. As in LoopInvariantMover, conditionally computed values
+ are not considered.
+ */
+struct CommonSubexpressionEliminator : public BasicCloneVisitor {
+    struct Available {
+        int                   fId;
+        std::set<std::string> fReads;
+    };
+
+    std::map<std::string, Available> fAvailable;  // Available values by key
+    std::map<ValueInst*, int>        fValueId;    // Unconditionally computed values (-1 if not)
+    std::map<int, int>               fCount;      // Number of computations of a given value
+    std::map<int, int>               fCost;       // Cost of a given value (see PureValueKey)
+    std::map<int, std::string>       fVars;       // Variables keeping the shared values
+    std::set<StatementInst*>         fNumbered;   // Statements where values can be shared
+
+    void kill(const std::set<std::string>& names);
+    void numberValue(ValueInst* inst);
+    void numberAddress(Address* address);
+    void numberStatement(StatementInst* inst);
+    void ignoreValues(ValueInst* inst);
+    void ignoreValues(StatementInst* inst);
+
+    ValueInst* share(ValueInst* inst);
+
+    virtual ValueInst* visit(MinusInst* inst)
+    {
+        ValueInst* res = share(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(BinopInst* inst)
+    {
+        ValueInst* res = share(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(::CastInst* inst)
+    {
+        ValueInst* res = share(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(BitcastInst* inst)
+    {
+        ValueInst* res = share(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(FunCallInst* inst)
+    {
+        ValueInst* res = share(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+    virtual ValueInst* visit(Select2Inst* inst)
+    {
+        ValueInst* res = share(inst);
+        return (res) ? res : BasicCloneVisitor::visit(inst);
+    }
+
+    virtual BlockInst* getCode(BlockInst* src);
+};
+
+/*
+ Dead store elimination in the straight-line DSP loop code:
+ - stack variables which are never read are removed,
+ - stores overwritten in the block before being read are removed.
+ Only stores of values without side effect are removed.
+ */
+struct DeadStoreRemover {
+    BlockInst* getCode(BlockInst* src);
+};
+
 #endif
@@ -37,17 +37,22 @@ using namespace std;
 //   3: long double precision float
 //   4: fixed-point float
 
-static const char* mathsuffix[5];       // suffix for math functions
-static const char* numsuffix[5];        // suffix for numeric constants
-static const char* floatname[5];        // float types
-static const char* floatptrname[5];     // float ptr types
-static const char* floatptrptrname[5];  // float ptr ptr types
-static const char* castname[5];         // float castings
-static double      floatmin[5];         // minimum float values before denormals
-static int64_t     floatmax[5];         // maximum float values
+// The names depend of the backend, so they are kept in the compilation context
 
 void initFaustFloat()
 {
+    if (!gGlobal->gFloatNames) {
+        gGlobal->gFloatNames = new FloatNames();
+    }
+    const char** mathsuffix      = gGlobal->gFloatNames->fMathSuffix;
+    const char** numsuffix       = gGlobal->gFloatNames->fNumSuffix;
+    const char** floatname       = gGlobal->gFloatNames->fFloatName;
+    const char** floatptrname    = gGlobal->gFloatNames->fFloatPtrName;
+    const char** floatptrptrname = gGlobal->gFloatNames->fFloatPtrPtrName;
+    const char** castname        = gGlobal->gFloatNames->fCastName;
+    double*      floatmin        = gGlobal->gFloatNames->fFloatMin;
+    int64_t*     floatmax        = gGlobal->gFloatNames->fFloatMax;
+
     // Using in FIR code generation to code math functions type (float/double/quad), same for Rust
     // and C/C++ backends
     mathsuffix[0] = "";
@@ -281,53 +286,53 @@ void initFaustFloat()
 ///< suffix for math functions
 const char* isuffix()
 {
-    return mathsuffix[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fMathSuffix[gGlobal->gFloatSize];
 }
 
 ///< suffix for numeric constants
 const char* inumix()
 {
-    return numsuffix[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fNumSuffix[gGlobal->gFloatSize];
 }
 
 const char* ifloat()
 {
-    return floatname[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fFloatName[gGlobal->gFloatSize];
 }
 
 const char* ifloatptr()
 {
-    return floatptrname[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fFloatPtrName[gGlobal->gFloatSize];
 }
 
 const char* ifloatptrptr()
 {
-    return floatptrptrname[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fFloatPtrPtrName[gGlobal->gFloatSize];
 }
 
 const char* icast()
 {
-    return castname[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fCastName[gGlobal->gFloatSize];
 }
 
 double inummin()
 {
-    return floatmin[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fFloatMin[gGlobal->gFloatSize];
 }
 
 int64_t inummax()
 {
-    return floatmax[gGlobal->gFloatSize];
+    return gGlobal->gFloatNames->fFloatMax[gGlobal->gFloatSize];
 }
 
 const char* xfloat()
 {
-    return floatname[0];
+    return gGlobal->gFloatNames->fFloatName[0];
 }
 
 const char* xcast()
 {
-    return castname[0];
+    return gGlobal->gFloatNames->fCastName[0];
 }
 
 int ifloatsize()
@@ -33,6 +33,18 @@
 #define FLOATMACROPTRPTR "FAUSTFLOAT**"
 #define FLOATCASTER "(" FLOATMACRO ")"
 
+// Float size coding dependent names, computed by 'initFaustFloat' for the current backend
+struct FloatNames {
+    const char* fMathSuffix[5];       // suffix for math functions
+    const char* fNumSuffix[5];        // suffix for numeric constants
+    const char* fFloatName[5];        // float types
+    const char* fFloatPtrName[5];     // float ptr types
+    const char* fFloatPtrPtrName[5];  // float ptr ptr types
+    const char* fCastName[5];         // float castings
+    double      fFloatMin[5];         // minimum float values before denormals
+    int64_t     fFloatMax[5];         // maximum float values
+};
+
 const char* isuffix();
 const char* inumix();
 double      inummin();
@@ -30,7 +30,7 @@
 using namespace std;
 
 // Used when inlining functions
-stack<BlockInst*> BasicCloneVisitor::fBlockStack;
+thread_local stack<BlockInst*> BasicCloneVisitor::fBlockStack;
 
 vector<string> NamedTyped::AttributeMap = {" ", " RESTRICT "};
 
@@ -1688,7 +1688,7 @@ struct WhileLoopInst : public StatementInst {
 class BasicCloneVisitor : public CloneVisitor {
    protected:
     // Used when inlining functions
-    static std::stack<BlockInst*> fBlockStack;
+    static thread_local std::stack<BlockInst*> fBlockStack;
 
    public:
     BasicCloneVisitor() {}
@@ -3355,7 +3355,7 @@ struct ZoneArray : public virtual Garbageable {
     std::map<std::string, int> fMap;
 
     // Shared between iZone and fZone
-    static int gInternalMemorySize;
+    static thread_local int gInternalMemorySize;
 
     static Typed::VarType getConstType(const std::string& name)
     {
@@ -0,0 +1,474 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _FBC_BINARY_H
+#define _FBC_BINARY_H
+
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "exception.hh"
+#include "interpreter_bytecode.hh"
+
+/*
+ Binary FBC container, an alternative to the textual format that can be loaded without parsing.
+
+ The container is a single position independent memory block (so a file can directly be mapped),
+ made of a header followed by 8 bytes aligned sections :
+
+    - strings      : NUL terminated strings, referenced by their offset in the section
+    - meta         : FBCBinaryMeta records
+    - ui           : FBCBinaryUI records
+    - blocks       : FBCBinaryBlock records, each one being a range in the instructions section
+    - instructions : FBCBinaryInstruction records
+    - int_table    : values of kBlockStoreInt instructions
+    - real_table   : values of kBlockStoreReal instructions
+
+ Blocks are numbered in preorder, so that the sub-blocks of an instruction always have a greater
+ index than the block containing it. Real values are always kept as double (so that the float
+ version is exact), and numbers are in the host byte order, checked with the 'fEndian' field.
+
+ The complete structure is checked by 'FBCBinaryReader::validate' before any allocation is done.
+*/
+
+#define FBC_BINARY_MAGIC "FBCB"
+#define FBC_BINARY_VERSION 1
+#define FBC_BINARY_ENDIAN 0x01020304
+
+struct FBCBinarySection {
+    uint32_t fOffset;  // in bytes, from the beginning of the container
+    uint32_t fCount;   // number of records (of bytes for the strings section)
+};
+
+struct FBCBinaryHeader {
+    char     fMagic[4];
+    uint32_t fEndian;
+    uint32_t fVersion;
+    uint32_t fFileVersion;  // INTERP_FILE_VERSION of the encoded factory
+    uint32_t fRealSize;     // sizeof(REAL) of the encoded factory
+    uint32_t fSize;         // total size of the container
+
+    // Factory (strings are offsets in the strings section)
+    int32_t fName;
+    int32_t fSHAKey;
+    int32_t fCompileOptions;
+    int32_t fOptLevel;
+    int32_t fNumInputs;
+    int32_t fNumOutputs;
+    int32_t fIntHeapSize;
+    int32_t fRealHeapSize;
+    int32_t fIntClassSize;
+    int32_t fRealClassSize;
+    int32_t fSROffset;
+    int32_t fCountOffset;
+    int32_t fIOTAOffset;
+
+    // static_init, constants, reset_ui, clear, control and dsp block indexes
+    int32_t fCodeBlocks[6];
+    int32_t fPad;
+
+    FBCBinarySection fStrings;
+    FBCBinarySection fMeta;
+    FBCBinarySection fUI;
+    FBCBinarySection fBlocks;
+    FBCBinarySection fInstructions;
+    FBCBinarySection fIntTable;
+    FBCBinarySection fRealTable;
+};
+
+struct FBCBinaryMeta {
+    int32_t fKey;
+    int32_t fValue;
+};
+
+struct FBCBinaryUI {
+    int32_t fOpcode;
+    int32_t fOffset;
+    int32_t fLabel;
+    int32_t fKey;
+    int32_t fValue;
+    int32_t fPad;
+    double  fInit;
+    double  fMin;
+    double  fMax;
+    double  fStep;
+};
+
+struct FBCBinaryBlock {
+    int32_t fFirst;
+    int32_t fSize;
+};
+
+struct FBCBinaryInstruction {
+    int32_t fOpcode;
+    int32_t fIntValue;
+    int32_t fOffset1;
+    int32_t fOffset2;
+    int32_t fBranch1;  // block index or -1
+    int32_t fBranch2;  // block index or -1
+    int32_t fName;
+    int32_t fTable;      // kBlockStoreReal/kBlockStoreInt : first value in the table
+    int32_t fTableSize;  // kBlockStoreReal/kBlockStoreInt : number of values
+    int32_t fPad;
+    double  fRealValue;
+};
+
+static_assert(sizeof(FBCBinaryHeader) == 160, "FBCBinaryHeader layout");
+static_assert(sizeof(FBCBinaryUI) == 56, "FBCBinaryUI layout");
+static_assert(sizeof(FBCBinaryInstruction) == 48, "FBCBinaryInstruction layout");
+
+// Returns true if the memory block starts like a binary container
+static inline bool isFBCBinary(const char* data, size_t size)
+{
+    return size >= sizeof(FBCBinaryHeader) && memcmp(data, FBC_BINARY_MAGIC, 4) == 0;
+}
+
+template <class REAL>
+struct FBCBinaryWriter {
+    std::string                       fStrings;
+    std::map<std::string, int>        fStringMap;
+    std::vector<FBCBinaryMeta>        fMeta;
+    std::vector<FBCBinaryUI>          fUI;
+    std::vector<FBCBinaryBlock>       fBlocks;
+    std::vector<FBCBinaryInstruction> fInstructions;
+    std::vector<int32_t>              fIntTable;
+    std::vector<double>               fRealTable;
+
+    FBCBinaryWriter() { fStrings.push_back('\0'); }
+
+    int addString(const std::string& str)
+    {
+        if (str == "") return 0;
+        if (fStringMap.find(str) == fStringMap.end()) {
+            fStringMap[str] = int(fStrings.size());
+            fStrings.append(str.c_str(), str.size() + 1);
+        }
+        return fStringMap[str];
+    }
+
+    // Blocks are numbered in preorder : the block is reserved before its sub-blocks are added
+    int addBlock(FBCBlockInstruction<REAL>* block)
+    {
+        int index = int(fBlocks.size());
+        fBlocks.push_back(FBCBinaryBlock());
+
+        std::vector<FBCBinaryInstruction> instructions;
+        for (const auto& it : block->fInstructions) {
+            FBCBinaryInstruction inst;
+            memset(&inst, 0, sizeof(FBCBinaryInstruction));
+            inst.fOpcode    = it->fOpcode;
+            inst.fIntValue  = it->fIntValue;
+            inst.fOffset1   = it->fOffset1;
+            inst.fOffset2   = it->fOffset2;
+            inst.fRealValue = it->fRealValue;
+            inst.fName      = addString(it->fName);
+            inst.fBranch1   = (it->getBranch1()) ? addBlock(it->getBranch1()) : -1;
+            inst.fBranch2   = (it->getBranch2()) ? addBlock(it->getBranch2()) : -1;
+            if (it->fOpcode == FBCInstruction::kBlockStoreReal) {
+                FIRBlockStoreRealInstruction<REAL>* store =
+                    static_cast<FIRBlockStoreRealInstruction<REAL>*>(it);
+                inst.fTable     = int(fRealTable.size());
+                inst.fTableSize = int(store->fNumTable.size());
+                fRealTable.insert(fRealTable.end(), store->fNumTable.begin(),
+                                  store->fNumTable.end());
+            } else if (it->fOpcode == FBCInstruction::kBlockStoreInt) {
+                FIRBlockStoreIntInstruction<REAL>* store =
+                    static_cast<FIRBlockStoreIntInstruction<REAL>*>(it);
+                inst.fTable     = int(fIntTable.size());
+                inst.fTableSize = int(store->fNumTable.size());
+                fIntTable.insert(fIntTable.end(), store->fNumTable.begin(),
+                                 store->fNumTable.end());
+            }
+            instructions.push_back(inst);
+        }
+
+        // Sub-blocks instructions have already been added, so the block ones are now contiguous
+        fBlocks[index].fFirst = int(fInstructions.size());
+        fBlocks[index].fSize  = int(instructions.size());
+        fInstructions.insert(fInstructions.end(), instructions.begin(), instructions.end());
+        return index;
+    }
+
+    void addMeta(FIRMetaBlockInstruction* meta)
+    {
+        for (const auto& it : meta->fInstructions) {
+            fMeta.push_back({addString(it->fKey), addString(it->fValue)});
+        }
+    }
+
+    void addUI(FIRUserInterfaceBlockInstruction<REAL>* ui)
+    {
+        for (const auto& it : ui->fInstructions) {
+            FBCBinaryUI item;
+            memset(&item, 0, sizeof(FBCBinaryUI));
+            item.fOpcode = it->fOpcode;
+            item.fOffset = it->fOffset;
+            item.fLabel  = addString(it->fLabel);
+            item.fKey    = addString(it->fKey);
+            item.fValue  = addString(it->fValue);
+            item.fInit   = it->fInit;
+            item.fMin    = it->fMin;
+            item.fMax    = it->fMax;
+            item.fStep   = it->fStep;
+            fUI.push_back(item);
+        }
+    }
+
+    template <class T>
+    static void addSection(std::string& out, FBCBinarySection& section, const T* data,
+                           size_t count, size_t record_size)
+    {
+        out.resize((out.size() + 7) & ~size_t(7), '\0');
+        section.fOffset = uint32_t(out.size());
+        section.fCount  = uint32_t(count);
+        if (count > 0) out.append(reinterpret_cast<const char*>(data), count * record_size);
+    }
+
+    std::string write(FBCBinaryHeader& header)
+    {
+        std::string out(sizeof(FBCBinaryHeader), '\0');
+        addSection(out, header.fStrings, fStrings.data(), fStrings.size(), 1);
+        addSection(out, header.fMeta, fMeta.data(), fMeta.size(), sizeof(FBCBinaryMeta));
+        addSection(out, header.fUI, fUI.data(), fUI.size(), sizeof(FBCBinaryUI));
+        addSection(out, header.fBlocks, fBlocks.data(), fBlocks.size(), sizeof(FBCBinaryBlock));
+        addSection(out, header.fInstructions, fInstructions.data(), fInstructions.size(),
+                   sizeof(FBCBinaryInstruction));
+        addSection(out, header.fIntTable, fIntTable.data(), fIntTable.size(), sizeof(int32_t));
+        addSection(out, header.fRealTable, fRealTable.data(), fRealTable.size(), sizeof(double));
+
+        memcpy(header.fMagic, FBC_BINARY_MAGIC, 4);
+        header.fEndian   = FBC_BINARY_ENDIAN;
+        header.fVersion  = FBC_BINARY_VERSION;
+        header.fRealSize = sizeof(REAL);
+        header.fSize     = uint32_t(out.size());
+        memcpy(&out[0], &header, sizeof(FBCBinaryHeader));
+        return out;
+    }
+};
+
+template <class REAL>
+struct FBCBinaryReader {
+    const char*     fData;
+    size_t          fSize;
+    FBCBinaryHeader fHeader;
+
+    FBCBinaryReader(const char* data, size_t size) : fData(data), fSize(size)
+    {
+        if (!isFBCBinary(data, size)) {
+            throw faustexception("ERROR : unrecognized binary file format\n");
+        }
+        memcpy(&fHeader, data, sizeof(FBCBinaryHeader));
+    }
+
+    // Records are copied, the container memory may not be aligned
+    template <class T>
+    T get(const FBCBinarySection& section, int index) const
+    {
+        T res;
+        memcpy(&res, fData + section.fOffset + size_t(index) * sizeof(T), sizeof(T));
+        return res;
+    }
+
+    const char* getString(int offset) const { return fData + fHeader.fStrings.fOffset + offset; }
+
+    static void check(bool cond, const std::string& msg)
+    {
+        if (!cond) {
+            throw faustexception("ERROR : invalid binary file, " + msg + "\n");
+        }
+    }
+
+    void checkSection(const FBCBinarySection& section, size_t record_size,
+                      const std::string& name) const
+    {
+        check(section.fOffset <= fSize &&
+                  uint64_t(section.fCount) * record_size <= fSize - section.fOffset,
+              "'" + name + "' section out of bounds");
+    }
+
+    void checkString(int offset) const
+    {
+        check(offset >= 0 && uint32_t(offset) < fHeader.fStrings.fCount, "bad string offset");
+    }
+
+    void checkBlock(int block, int parent, std::vector<bool>& used) const
+    {
+        check(block > parent && uint32_t(block) < fHeader.fBlocks.fCount, "bad block index");
+        check(!used[block], "shared block");
+        used[block] = true;
+    }
+
+    // Check the complete container structure, so that the factory can be built without any test
+    void validate() const
+    {
+        std::stringstream version;
+        check(fHeader.fEndian == FBC_BINARY_ENDIAN, "wrong byte order");
+        check(fHeader.fVersion == FBC_BINARY_VERSION, "unsupported container version");
+        if (fHeader.fFileVersion != INTERP_FILE_VERSION) {
+            version << "ERROR : interpreter file format version '" << fHeader.fFileVersion
+                    << "' different from compiled one '" << INTERP_FILE_VERSION << "'"
+                    << std::endl;
+            throw faustexception(version.str());
+        }
+        check(fHeader.fRealSize == sizeof(REAL), "wrong real type");
+        check(fHeader.fSize == fSize, "wrong size");
+
+        checkSection(fHeader.fStrings, 1, "strings");
+        checkSection(fHeader.fMeta, sizeof(FBCBinaryMeta), "meta");
+        checkSection(fHeader.fUI, sizeof(FBCBinaryUI), "ui");
+        checkSection(fHeader.fBlocks, sizeof(FBCBinaryBlock), "blocks");
+        checkSection(fHeader.fInstructions, sizeof(FBCBinaryInstruction), "instructions");
+        checkSection(fHeader.fIntTable, sizeof(int32_t), "int_table");
+        checkSection(fHeader.fRealTable, sizeof(double), "real_table");
+
+        // All strings are terminated
+        check(fHeader.fStrings.fCount > 0 && getString(fHeader.fStrings.fCount - 1)[0] == '\0',
+              "unterminated string");
+        checkString(fHeader.fName);
+        checkString(fHeader.fSHAKey);
+        checkString(fHeader.fCompileOptions);
+
+        for (int i = 0; i < int(fHeader.fMeta.fCount); i++) {
+            FBCBinaryMeta meta = get<FBCBinaryMeta>(fHeader.fMeta, i);
+            checkString(meta.fKey);
+            checkString(meta.fValue);
+        }
+
+        for (int i = 0; i < int(fHeader.fUI.fCount); i++) {
+            FBCBinaryUI item = get<FBCBinaryUI>(fHeader.fUI, i);
+            check(item.fOpcode >= FBCInstruction::kOpenVerticalBox &&
+                      item.fOpcode <= FBCInstruction::kDeclare,
+                  "bad UI opcode");
+            checkString(item.fLabel);
+            checkString(item.fKey);
+            checkString(item.fValue);
+        }
+
+        // Each block is used once, either as a code block or as the branch of an instruction
+        std::vector<bool> used(fHeader.fBlocks.fCount, false);
+        for (int i = 0; i < 6; i++) {
+            checkBlock(fHeader.fCodeBlocks[i], -1, used);
+        }
+
+        for (int b = 0; b < int(fHeader.fBlocks.fCount); b++) {
+            FBCBinaryBlock block = get<FBCBinaryBlock>(fHeader.fBlocks, b);
+            check(block.fFirst >= 0 && block.fSize >= 0 &&
+                      uint64_t(block.fFirst) + uint64_t(block.fSize) <=
+                          fHeader.fInstructions.fCount,
+                  "block out of bounds");
+            for (int i = block.fFirst; i < block.fFirst + block.fSize; i++) {
+                FBCBinaryInstruction inst = get<FBCBinaryInstruction>(fHeader.fInstructions, i);
+                check((inst.fOpcode >= 0 && inst.fOpcode < FBCInstruction::kOpenVerticalBox) ||
+                          inst.fOpcode == FBCInstruction::kNop,
+                      "bad opcode");
+                checkString(inst.fName);
+                if (FBCInstruction::isChoice(FBCInstruction::Opcode(inst.fOpcode)) ||
+                    inst.fOpcode == FBCInstruction::kLoop) {
+                    checkBlock(inst.fBranch1, b, used);
+                    checkBlock(inst.fBranch2, b, used);
+                } else {
+                    check(inst.fBranch1 == -1 && inst.fBranch2 == -1, "unexpected branch");
+                }
+                if (inst.fOpcode == FBCInstruction::kBlockStoreReal ||
+                    inst.fOpcode == FBCInstruction::kBlockStoreInt) {
+                    uint32_t size = (inst.fOpcode == FBCInstruction::kBlockStoreReal)
+                                        ? fHeader.fRealTable.fCount
+                                        : fHeader.fIntTable.fCount;
+                    check(inst.fTable >= 0 && inst.fTableSize >= 0 &&
+                              uint64_t(inst.fTable) + uint64_t(inst.fTableSize) <= size,
+                          "table out of bounds");
+                }
+            }
+        }
+    }
+
+    FIRMetaBlockInstruction* readMetaBlock() const
+    {
+        FIRMetaBlockInstruction* meta_block = new FIRMetaBlockInstruction();
+        for (int i = 0; i < int(fHeader.fMeta.fCount); i++) {
+            FBCBinaryMeta meta = get<FBCBinaryMeta>(fHeader.fMeta, i);
+            meta_block->push(new FIRMetaInstruction(getString(meta.fKey), getString(meta.fValue)));
+        }
+        return meta_block;
+    }
+
+    FIRUserInterfaceBlockInstruction<REAL>* readUIBlock() const
+    {
+        FIRUserInterfaceBlockInstruction<REAL>* ui_block =
+            new FIRUserInterfaceBlockInstruction<REAL>();
+        for (int i = 0; i < int(fHeader.fUI.fCount); i++) {
+            FBCBinaryUI item = get<FBCBinaryUI>(fHeader.fUI, i);
+            ui_block->push(new FIRUserInterfaceInstruction<REAL>(
+                FBCInstruction::Opcode(item.fOpcode), item.fOffset, getString(item.fLabel),
+                getString(item.fKey), getString(item.fValue), REAL(item.fInit), REAL(item.fMin),
+                REAL(item.fMax), REAL(item.fStep)));
+        }
+        return ui_block;
+    }
+
+    FBCBlockInstruction<REAL>* readCodeBlock(int index) const
+    {
+        FBCBinaryBlock             block      = get<FBCBinaryBlock>(fHeader.fBlocks, index);
+        FBCBlockInstruction<REAL>* code_block = new FBCBlockInstruction<REAL>();
+
+        for (int i = block.fFirst; i < block.fFirst + block.fSize; i++) {
+            FBCBinaryInstruction   inst   = get<FBCBinaryInstruction>(fHeader.fInstructions, i);
+            FBCInstruction::Opcode opcode = FBCInstruction::Opcode(inst.fOpcode);
+            if (opcode == FBCInstruction::kBlockStoreReal) {
+                std::vector<REAL> values(inst.fTableSize);
+                for (int j = 0; j < inst.fTableSize; j++) {
+                    values[j] = REAL(get<double>(fHeader.fRealTable, inst.fTable + j));
+                }
+                code_block->push(new FIRBlockStoreRealInstruction<REAL>(opcode, inst.fOffset1,
+                                                                        inst.fOffset2, values));
+            } else if (opcode == FBCInstruction::kBlockStoreInt) {
+                std::vector<int> values(inst.fTableSize);
+                if (inst.fTableSize > 0) {
+                    memcpy(values.data(),
+                           fData + fHeader.fIntTable.fOffset + inst.fTable * sizeof(int32_t),
+                           inst.fTableSize * sizeof(int32_t));
+                }
+                code_block->push(new FIRBlockStoreIntInstruction<REAL>(opcode, inst.fOffset1,
+                                                                       inst.fOffset2, values));
+            } else {
+                FBCBlockInstruction<REAL>* branch1 =
+                    (inst.fBranch1 >= 0) ? readCodeBlock(inst.fBranch1) : nullptr;
+                FBCBlockInstruction<REAL>* branch2 =
+                    (inst.fBranch2 >= 0) ? readCodeBlock(inst.fBranch2) : nullptr;
+                // Special case for loops
+                if (opcode == FBCInstruction::kCondBranch) {
+                    branch1 = code_block;
+                }
+                code_block->push(new FBCBasicInstruction<REAL>(
+                    opcode, getString(inst.fName), inst.fIntValue, REAL(inst.fRealValue),
+                    inst.fOffset1, inst.fOffset2, branch1, branch2));
+            }
+        }
+
+        return code_block;
+    }
+};
+
+#endif
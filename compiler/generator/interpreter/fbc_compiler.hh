@@ -22,6 +22,12 @@
 #ifndef _FBC_COMPILER_H
 #define _FBC_COMPILER_H
 
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "fbc_interpreter.hh"
 
 #ifdef INTERP_MIR_BUILD
@@ -32,18 +38,70 @@
 #include "fbc_template_compiler.hh"
 #endif
 
-// FBC compiler
+// The template compiler works on the register code: the instance heaps then have its registers
+// and constants, and blocks that are not compiled are executed by the register interpreter
+#ifdef INTERP_TEMPLATE_BUILD
 template <class REAL>
-class FBCCompiler : public FBCInterpreter<REAL, 0> {
-   public:
-    typedef typename std::map<FBCBlockInstruction<REAL>*, FBCExecuteFun<REAL>*> CompiledBlocksType;
-    typedef typename std::map<FBCBlockInstruction<REAL>*, FBCExecuteFun<REAL>*>::iterator
-        CompiledBlocksTypeIT;
+using FBCCompilerBase = FBCRegisterInterpreter<REAL, 0>;
+#else
+template <class REAL>
+using FBCCompilerBase = FBCInterpreter<REAL, 0>;
+#endif
 
-    FBCCompiler(interpreter_dsp_factory_aux<REAL, 0>* factory, CompiledBlocksType* map)
-        : FBCInterpreter<REAL, 0>(factory)
+// A compiled block, shared by all DSP instances of a factory
+template <class REAL>
+struct FBCCompiledBlock {
+    // The compiled code is set when the block compilation is done (possibly by a worker thread)
+    std::atomic<FBCExecuteFun<REAL>*> fCode;
+    // The compilation is running in a worker thread
+    bool fPending;
+    // The compilation is done (the code stays null when the block cannot be compiled)
+    bool fDone;
+
+    FBCCompiledBlock() : fCode(nullptr), fPending(false), fDone(false) {}
+    ~FBCCompiledBlock() { delete fCode.load(); }
+};
+
+// Compiled blocks, shared by all DSP instances of a factory
+template <class REAL>
+struct FBCCompiledBlocks {
+    std::mutex                                                   fMutex;
+    std::map<FBCBlockInstruction<REAL>*, FBCCompiledBlock<REAL>> fBlocks;
+
+    // Tiered mode compilations, owned by the factory so that deleting an instance does not wait
+    std::vector<std::thread> fWorkers;
+    // Error of a failed tiered mode compilation, reported by the next 'init'
+    std::string fError;
+    // Tiered mode compilations do not use the instance sound table (see 'hasSoundfile')
+    soundTable fSoundTable;
+
+    ~FBCCompiledBlocks()
+    {
+        for (auto& it : fWorkers) {
+            it.join();
+        }
+    }
+};
+
+/*
+ FBC compiler : the 'DSP' compute block is compiled in 'init'.
+
+ In tiered mode (when FAUST_INTERP_TIERED is set), 'init' does not wait for the compilation :
+ the block is compiled by a worker thread of the factory, and is interpreted until the compiled
+ code is available. The compiled code is then used at the beginning of the next 'compute' call.
+ A failed compilation is reported (as a faustexception) by the next 'init', and done again.
+ DSPs using soundfiles are always compiled in 'init', since the compiled code uses the instance
+ sound table.
+*/
+template <class REAL>
+class FBCCompiler : public FBCCompilerBase<REAL> {
+   public:
+    FBCCompiler(interpreter_dsp_factory_aux<REAL, 0>* factory, FBCCompiledBlocks<REAL>* blocks)
+        : FBCCompilerBase<REAL>(factory),
+          fCompiledBlocks(blocks),
+          fBlock(nullptr),
+          fCompiledBlock(nullptr)
     {
-        fCompiledBlocks = map;
     }
 
     virtual ~FBCCompiler() {}
@@ -51,30 +109,39 @@ class FBCCompiler : public FBCInterpreter<REAL, 0> {
     void executeBlock(FBCBlockInstruction<REAL>* block)
     {
         // The 'DSP' compute block only is compiled..
-        if (fCompiledBlocks->find(block) != fCompiledBlocks->end()) {
-            ((*fCompiledBlocks)[block])
-                ->execute(this->fIntHeap, this->fRealHeap, this->fInputs, this->fOutputs);
+        FBCExecuteFun<REAL>* compiled =
+            (block == fBlock) ? fCompiledBlock->fCode.load(std::memory_order_acquire) : nullptr;
+        if (compiled) {
+            compiled->execute(this->fIntHeap, this->fRealHeap, this->fInputs, this->fOutputs);
         } else {
-            FBCInterpreter<REAL, 0>::executeBlock(block);
+            FBCCompilerBase<REAL>::executeBlock(block);
         }
     }
 
    private:
-    CompiledBlocksType* fCompiledBlocks;
+    FBCCompiledBlocks<REAL>* fCompiledBlocks;
 
-    void compileBlock(FBCBlockInstruction<REAL>* block)
+    // The compiled block and its shared compiled code
+    FBCBlockInstruction<REAL>* fBlock;
+    FBCCompiledBlock<REAL>*    fCompiledBlock;
+
+    // Does not use the instance, since the tiered mode worker thread may outlive it
+    static FBCExecuteFun<REAL>* compile(interpreter_dsp_factory_aux<REAL, 0>* factory,
+                                        FBCBlockInstruction<REAL>* block, soundTable& sound_table)
     {
-        if (fCompiledBlocks->find(block) == fCompiledBlocks->end()) {
 #ifdef INTERP_COMP_BUILD
 #ifdef INTERP_MIR_BUILD
-            // Run with interp/MIR compiler
-            (*fCompiledBlocks)[block] = new FBCMIRCompiler<REAL>(block, this->fSoundTable);
+        // Run with interp/MIR compiler
+        return new FBCMIRCompiler<REAL>(block, sound_table);
 #elif INTERP_LLVM_BUILD
-            // Run with interp/LLVM compiler
-            (*fCompiledBlocks)[block] = new FBCLLVMCompiler<REAL>(block, this->fSoundTable);
+        // Run with interp/LLVM compiler
+        return new FBCLLVMCompiler<REAL>(block, sound_table);
 #elif INTERP_TEMPLATE_BUILD
-            // Run with template compiler
-            (*fCompiledBlocks)[block] = new FBCTemplateCompiler<REAL>(block, this->fSoundTable);
+        // Run with template compiler, when the block is lowered in register code
+        FBCRegisterCode<REAL>* code = factory->fRegisterCode;
+        if (FBCTemplateCompiler<REAL>::isSupported() && code->getCode(block)) {
+            return new FBCTemplateCompiler<REAL>(code, block, sound_table);
+        }
 #endif
 #else
 #ifdef WIN32
@@ -83,8 +150,63 @@ class FBCCompiler : public FBCInterpreter<REAL, 0> {
 #warning pure Interpreter mode
 #endif
 #endif
-        } else {
+        return nullptr;
+    }
+
+    bool hasSoundfile()
+    {
+        for (const auto& it : this->fFactory->fUserInterfaceBlock->fInstructions) {
+            if (it->fOpcode == FBCInstruction::kAddSoundfile) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void compileBlock(FBCBlockInstruction<REAL>* block)
+    {
+        std::lock_guard<std::mutex> lock(fCompiledBlocks->fMutex);
+
+        // Failure of a previous tiered mode compilation
+        if (fCompiledBlocks->fError != "") {
+            std::string error       = fCompiledBlocks->fError;
+            fCompiledBlocks->fError = "";
+            throw faustexception(error);
+        }
+
+        // Compiled once, or again after a failed compilation
+        FBCCompiledBlock<REAL>* compiled = &fCompiledBlocks->fBlocks[block];
+        fBlock         = block;
+        fCompiledBlock = compiled;
+        if (compiled->fDone || compiled->fPending) {
             // std::cout << "FBCCompiler: reuse compiled block" << std::endl;
+            return;
+        }
+
+        interpreter_dsp_factory_aux<REAL, 0>* factory = this->fFactory;
+        if (getenv("FAUST_INTERP_TIERED") && !hasSoundfile()) {
+            compiled->fPending = true;
+            FBCCompiledBlocks<REAL>* blocks = fCompiledBlocks;
+            blocks->fWorkers.push_back(std::thread([factory, blocks, block, compiled]() {
+                FBCExecuteFun<REAL>* code = nullptr;
+                std::string          error;
+                try {
+                    code = compile(factory, block, blocks->fSoundTable);
+                } catch (faustexception& e) {
+                    // The block stays interpreted
+                    error = e.Message();
+                }
+                std::lock_guard<std::mutex> lock(blocks->fMutex);
+                compiled->fCode.store(code, std::memory_order_release);
+                compiled->fPending = false;
+                compiled->fDone    = (error == "");
+                blocks->fError     = error;
+            }));
+        } else {
+            // An exception leaves the block to be compiled again
+            compiled->fCode.store(compile(factory, block, this->fSoundTable),
+                                  std::memory_order_release);
+            compiled->fDone = true;
         }
     }
 };
@@ -43,6 +43,9 @@ class FBCExecutor {
                                            UIInterface*                            glue){};
     virtual void executeBlock(FBCBlockInstruction<REAL>* block){};
 
+    // Setup the class segment (the static tables) for the given sample rate
+    virtual void classInit(int sample_rate) {}
+
     // Possibly compile (when using LLVM or MIR)
     virtual void compileBlock(FBCBlockInstruction<REAL>* block) {}
 
@@ -0,0 +1,246 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _FBC_HEAP_LAYOUT_H
+#define _FBC_HEAP_LAYOUT_H
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "interpreter_bytecode.hh"
+#include "struct_manager.hh"
+
+/*
+ Locality driven layout of the int and real heaps.
+
+ InterpreterInstVisitor allocates the fields in declaration order, so the scalars and arrays used
+ together by the DSP loop end up scattered in the heaps. The DSP block is traversed to record the
+ order in which the fields are first accessed, then the fields of the instance segment are
+ renumbered :
+ - first the scalars and small arrays (up to a cache line) of the DSP block, in access order,
+ - then its larger arrays (delay lines, tables), in access order,
+ - then the fields only used by the control block,
+ - then all the other fields, in declaration order.
+
+ Arrays are moved as a whole and the class segment stays in place. The layout is applied on the
+ blocks produced by the visitor (before any optimization, so that kPairMove/kBlockPairMove are
+ built on the new layout), on the UI block and on the field table, when the factory is produced :
+ it is then kept in the factory and its serialized forms.
+*/
+
+template <class REAL>
+struct FBCHeapLayout {
+    typedef FBCInstruction I;
+
+    static const int kCacheLine = 64;
+
+    enum Tier { kHot, kLarge, kControl, kCold };
+
+    struct Field {
+        int fOffset;
+        int fSize;
+        int fTier;
+        int fRank;
+        int fNewOffset;
+    };
+
+    // Per heap (int then real) : the fields and the field of each cell
+    struct Heap {
+        std::vector<Field> fFields;
+        std::vector<int>   fCells;
+        int                fClassSize;
+        int                fCellSize;
+    };
+
+    Heap fHeaps[2];
+    int  fRank;
+
+    Heap& getHeap(bool real) { return fHeaps[real]; }
+
+    void initHeap(Heap& heap, int heap_size, int class_size, int cell_size)
+    {
+        heap.fCells.assign(heap_size, -1);
+        heap.fClassSize = class_size;
+        heap.fCellSize  = cell_size;
+    }
+
+    void addField(Heap& heap, int offset, int size)
+    {
+        int field = int(heap.fFields.size());
+        heap.fFields.push_back({offset, size, kCold, offset, offset});
+        for (int i = offset; i < offset + size; i++) {
+            heap.fCells[i] = field;
+        }
+    }
+
+    FBCHeapLayout(std::map<std::string, MemoryDesc>& field_table, int int_heap_size,
+                  int real_heap_size, int int_class_size, int real_class_size)
+        : fRank(0)
+    {
+        initHeap(fHeaps[0], int_heap_size, int_class_size, sizeof(int));
+        initHeap(fHeaps[1], real_heap_size, real_class_size, sizeof(REAL));
+
+        // Same heap selection as InterpreterInstVisitor
+        for (const auto& it : field_table) {
+            if (it.second.fOffset < 0) {
+                continue;
+            }
+            addField(getHeap(it.second.fType != Typed::kInt32), it.second.fOffset,
+                     std::max(it.second.fSize, 1));
+        }
+
+        // Cells without a field in the table (like a redeclared 'fSampleRate') are kept as scalars
+        for (int real = 0; real < 2; real++) {
+            Heap& heap = fHeaps[real];
+            for (int i = 0; i < int(heap.fCells.size()); i++) {
+                if (heap.fCells[i] == -1) {
+                    addField(heap, i, 1);
+                }
+            }
+        }
+    }
+
+    // Heap accessed by a visitor generated instruction, returns false if none
+    static bool getAccess(I::Opcode op, bool& real)
+    {
+        switch (op) {
+            case I::kLoadReal:
+            case I::kStoreReal:
+            case I::kLoadIndexedReal:
+            case I::kStoreIndexedReal:
+            case I::kBlockStoreReal:
+            case I::kBlockShiftReal:
+                real = true;
+                return true;
+            case I::kLoadInt:
+            case I::kStoreInt:
+            case I::kLoadIndexedInt:
+            case I::kStoreIndexedInt:
+            case I::kBlockStoreInt:
+            case I::kBlockShiftInt:
+                real = false;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Record the first access of each field in 'block', with the given tier for scalars
+    void analyse(FBCBlockInstruction<REAL>* block, int tier)
+    {
+        if (!block) {
+            return;
+        }
+        for (const auto& it : block->fInstructions) {
+            bool real;
+            if (getAccess(it->fOpcode, real)) {
+                Heap&  heap  = getHeap(real);
+                Field& field = heap.fFields[heap.fCells[it->fOffset1]];
+                if (field.fTier == kCold && field.fOffset >= heap.fClassSize) {
+                    field.fTier =
+                        (tier == kHot && field.fSize * heap.fCellSize > kCacheLine) ? kLarge : tier;
+                    field.fRank = fRank++;
+                }
+            }
+            // kCondBranch branches back to its own block
+            if (it->fOpcode != I::kCondBranch) {
+                analyse(it->fBranch1, tier);
+                analyse(it->fBranch2, tier);
+            }
+        }
+    }
+
+    // Compute the new offsets of the instance segment fields
+    void layout()
+    {
+        for (int real = 0; real < 2; real++) {
+            Heap&            heap = fHeaps[real];
+            std::vector<int> order;
+            for (int i = 0; i < int(heap.fFields.size()); i++) {
+                if (heap.fFields[i].fOffset >= heap.fClassSize) {
+                    order.push_back(i);
+                }
+            }
+            std::stable_sort(order.begin(), order.end(), [&heap](int a, int b) {
+                const Field& fa = heap.fFields[a];
+                const Field& fb = heap.fFields[b];
+                return (fa.fTier != fb.fTier) ? (fa.fTier < fb.fTier) : (fa.fRank < fb.fRank);
+            });
+            int offset = heap.fClassSize;
+            for (const auto& it : order) {
+                heap.fFields[it].fNewOffset = offset;
+                offset += heap.fFields[it].fSize;
+            }
+        }
+    }
+
+    int getOffset(bool real, int offset)
+    {
+        Heap&        heap  = getHeap(real);
+        const Field& field = heap.fFields[heap.fCells[offset]];
+        return field.fNewOffset + (offset - field.fOffset);
+    }
+
+    void relocate(FBCBlockInstruction<REAL>* block)
+    {
+        if (!block) {
+            return;
+        }
+        for (const auto& it : block->fInstructions) {
+            bool real;
+            if (getAccess(it->fOpcode, real)) {
+                it->fOffset1 = getOffset(real, it->fOffset1);
+                // fOffset2 is the array size, except for kBlockShift
+                if (it->fOpcode == I::kBlockShiftReal || it->fOpcode == I::kBlockShiftInt) {
+                    it->fOffset2 = getOffset(real, it->fOffset2);
+                }
+            }
+            if (it->fOpcode != I::kCondBranch) {
+                relocate(it->fBranch1);
+                relocate(it->fBranch2);
+            }
+        }
+    }
+
+    void relocate(FIRUserInterfaceBlockInstruction<REAL>* block)
+    {
+        // Zones are in the real heap
+        for (const auto& it : block->fInstructions) {
+            if (it->fOffset >= 0) {
+                it->fOffset = getOffset(true, it->fOffset);
+            }
+        }
+    }
+
+    void relocate(std::map<std::string, MemoryDesc>& field_table)
+    {
+        for (auto& it : field_table) {
+            if (it.second.fOffset < 0) {
+                continue;
+            }
+            it.second.fOffset = getOffset(it.second.fType != Typed::kInt32, it.second.fOffset);
+        }
+    }
+};
+
+#endif
@@ -23,6 +23,7 @@
 #define _FBC_INTERPRETER_H
 
 #include <string.h>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <functional>
@@ -34,6 +35,7 @@
 #include "dsp_aux.hh"
 #include "exception.hh"
 #include "fbc_executor.hh"
+#include "fbc_profile.hh"
 #include "interpreter_bytecode.hh"
 
 // #define INTERP_MIR_BUILD 1
@@ -44,6 +46,8 @@
  Interpreter using 'computed goto' technique:
  https://eli.thegreenplace.net/2012/07/12/computed-goto-for-efficient-dispatch-tables
 
+ Blocks are executed from their flat version (see FBCFlatBlock in interpreter_bytecode.hh).
+
  Trace mode: only check 'non-optimized' interpreter operations, since the code is not optimized in
  this case.
 
@@ -53,6 +57,8 @@
  4 : collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW, DIV_BY_ZERO, fails at first
  FP_INFINITE or FP_NAN 5 : collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW, DIV_BY_ZERO,
  continue after FP_INFINITE or FP_NAN
+ 7 : like 6, and dump the memory layout of the first cycles in DumpMem-fooXXX.txt files
+ 8 : profile mode, see fbc_profile.hh
 */
 
 #define INTEGER_OVERFLOW -1
@@ -70,9 +76,13 @@ template <class REAL, int TRACE>
 struct interpreter_dsp_factory_aux;
 
 // FBC interpreter
-template <class REAL, int TRACE>
+template <class REAL, int TRACE_MODE>
 class FBCInterpreter : public FBCExecutor<REAL> {
    protected:
+    // The profile mode does not check the operations
+    static constexpr bool PROFILE = (TRACE_MODE == TRACE_PROFILE);
+    static constexpr int  TRACE   = (PROFILE) ? 0 : TRACE_MODE;
+
     typedef std::function<void(double)> ReflectFunction;
     typedef std::function<double()>     ModifyFunction;
 
@@ -118,16 +128,27 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     controlMap fPathInputTable;   // [path, ZoneParam]
     controlMap fPathOutputTable;  // [path, ZoneParam]
 
-    interpreter_dsp_factory_aux<REAL, TRACE>* fFactory;
+    interpreter_dsp_factory_aux<REAL, TRACE_MODE>* fFactory;
 
     int*  fIntHeap;
     REAL* fRealHeap;
 
+    // Class segment (the static tables at the beginning of the heaps) : the one of the factory when
+    // it is shared, then the cells before fIntClassSize/fRealClassSize are not allocated in the
+    // instance heaps
+    int*  fClassIntHeap;
+    REAL* fClassRealHeap;
+    int   fIntClassSize;
+    int   fRealClassSize;
+
     REAL** fInputs;
     REAL** fOutputs;
 
     std::map<int, int64_t> fRealStats;
 
+    // Dispatch counters in profile mode
+    FBCProfile<REAL> fProfile;
+
     /*
      Keeps the latest TRACE_STACK_SIZE executed instructions, to be displayed when an error occurs.
      */
@@ -162,18 +183,17 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             }
         }
 
-        void traceInstruction(InstructionIT it)
+        void traceInstruction(const FBCFlatBlock<REAL>* block, FlatInstructionIT it)
         {
-            (*it)->write(&fMessage, false, false,
-                         false);  // Last param = false means no recursion in branches
+            block->write(it, &fMessage);
             push(fMessage.str());
             fMessage.str("");
         }
 
-        void traceInstruction(InstructionIT it, int int_value, REAL real_value)
+        void traceInstruction(const FBCFlatBlock<REAL>* block, FlatInstructionIT it, int int_value,
+                              REAL real_value)
         {
-            (*it)->write(&fMessage, false, false,
-                         false);  // Last param = false means no recursion in branches
+            block->write(it, &fMessage);
             push(fMessage.str());
             push("Stack [Int: " + std::to_string(int_value) +
                  "] [REAL: " + std::to_string(real_value) + "]\n");
@@ -183,13 +203,21 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
     InterpreterTrace fTraceContext;
 
-    inline void traceInstruction(InstructionIT it) { fTraceContext.traceInstruction(it); }
+    // The flat block being executed
+    const FBCFlatBlock<REAL>* fFlatBlock;
 
-    inline void traceInstruction(InstructionIT it, int int_value, REAL real_value)
+    inline void traceInstruction(FlatInstructionIT it)
     {
-        fTraceContext.traceInstruction(it, int_value, real_value);
+        fTraceContext.traceInstruction(fFlatBlock, it);
     }
 
+    inline void traceInstruction(FlatInstructionIT it, int int_value, REAL real_value)
+    {
+        fTraceContext.traceInstruction(fFlatBlock, it, int_value, real_value);
+    }
+
+    inline const std::string& getName(FlatInstructionIT it) { return fFlatBlock->getName(it); }
+
     void printStats()
     {
         if (TRACE > 0 && TRACE < 6) {
@@ -213,7 +241,19 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
     }
 
-    inline void warningOverflow(InstructionIT it, const std::string& op)
+    void printProfile()
+    {
+        std::vector<std::pair<std::string, FBCFlatBlock<REAL>*>> blocks = {
+            {"static_init_block", getFlatBlock(fFactory->fStaticInitBlock)},
+            {"init_block", getFlatBlock(fFactory->fInitBlock)},
+            {"resetui_block", getFlatBlock(fFactory->fResetUIBlock)},
+            {"clear_block", getFlatBlock(fFactory->fClearBlock)},
+            {"control_block", getFlatBlock(fFactory->fComputeBlock)},
+            {"dsp_block", getFlatBlock(fFactory->fComputeDSPBlock)}};
+        fProfile.print(std::cout, blocks, fFactory->fProfileNames);
+    }
+
+    inline void warningOverflow(FlatInstructionIT it, const std::string& op)
     {
         if (TRACE >= 6) {
             return;
@@ -232,7 +272,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
     }
 
-    inline int warningBitshift(InstructionIT it, int val)
+    inline int warningBitshift(FlatInstructionIT it, int val)
     {
         if (val < 0) {
             if (TRACE >= 3) {
@@ -250,7 +290,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return val;
     }
 
-    inline REAL checkCastIntOverflow(InstructionIT it, REAL val)
+    inline REAL checkCastIntOverflow(FlatInstructionIT it, REAL val)
     {
         if (val > std::numeric_limits<int>::max() || val < std::numeric_limits<int>::min()) {
             if (TRACE >= 3) {
@@ -274,7 +314,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return val;
     }
 
-    inline void checkDivZero(InstructionIT it, REAL val)
+    inline void checkDivZero(FlatInstructionIT it, REAL val)
     {
         if (TRACE >= 6) {
             return;
@@ -293,7 +333,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
     }
 
-    inline void checkDivZero(InstructionIT it, int val)
+    inline void checkDivZero(FlatInstructionIT it, int val)
     {
         if (TRACE >= 6) {
             return;
@@ -311,7 +351,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
     }
 
-    inline REAL checkRealAux(InstructionIT it, REAL val)
+    inline REAL checkRealAux(FlatInstructionIT it, REAL val)
     {
         if (TRACE >= 6) {
             return val;
@@ -355,7 +395,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return val;
     }
 
-    inline int assertAudioBuffer(InstructionIT it, int index)
+    inline int assertAudioBuffer(FlatInstructionIT it, int index)
     {
         if (TRACE >= 6) {
             return index;
@@ -374,9 +414,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return index;
     }
 
-    inline int assertStoreIntHeap(InstructionIT it, int index, int size = -1)
+    inline int assertStoreIntHeap(FlatInstructionIT it, int index, int size = -1)
     {
-        int index_in_array = index - (*it)->fOffset1;
+        int index_in_array = index - it->fOffset1;
         if (TRACE >= 4 && ((index < 0) || (index >= fFactory->fIntHeapSize) ||
                            (size > 0 && ((index_in_array < 0) || (index_in_array >= size))))) {
             std::cout << "-------- Interpreter crash trace start --------" << std::endl;
@@ -384,11 +424,11 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 std::cout << "assertStoreIntHeap array: fIntHeapSize = ";
                 std::cout << fFactory->fIntHeapSize << " index = " << index_in_array;
                 std::cout << " size = " << size;
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             } else {
                 std::cout << "assertStoreIntHeap scalar: fIntHeapSize = ";
                 std::cout << fFactory->fIntHeapSize << " index = " << index;
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             }
             fTraceContext.write(&std::cout);
             std::cout << "-------- Interpreter crash trace end --------\n\n";
@@ -397,9 +437,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return index;
     }
 
-    inline int assertStoreRealHeap(InstructionIT it, int index, int size = -1)
+    inline int assertStoreRealHeap(FlatInstructionIT it, int index, int size = -1)
     {
-        int index_in_array = index - (*it)->fOffset1;
+        int index_in_array = index - it->fOffset1;
         if (TRACE >= 4 && ((index < 0) || (index >= fFactory->fRealHeapSize) ||
                            (size > 0 && ((index_in_array < 0) || (index_in_array >= size))))) {
             std::cout << "-------- Interpreter crash trace start --------" << std::endl;
@@ -407,11 +447,11 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 std::cout << "assertStoreRealHeap array: fRealHeapSize = ";
                 std::cout << fFactory->fRealHeapSize << " index = " << index_in_array;
                 std::cout << " size = " << size;
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             } else {
                 std::cout << "assertStoreRealHeap scalar: fRealHeapSize = ";
                 std::cout << fFactory->fRealHeapSize << " index = " << index;
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             }
             fTraceContext.write(&std::cout);
             std::cout << "-------- Interpreter crash trace end --------\n\n";
@@ -420,9 +460,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return index;
     }
 
-    inline int assertLoadIntHeap(InstructionIT it, int index, int size = -1)
+    inline int assertLoadIntHeap(FlatInstructionIT it, int index, int size = -1)
     {
-        int index_in_array = index - (*it)->fOffset1;
+        int index_in_array = index - it->fOffset1;
         if ((TRACE >= 4) && ((index < 0) || (index >= fFactory->fIntHeapSize) ||
                              (size > 0 && ((index_in_array < 0) || (index_in_array >= size))) ||
                              (fIntHeap[index] == DUMMY_INT))) {
@@ -434,11 +474,11 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 if (index >= 0) {
                     std::cout << " value = " << fIntHeap[index];
                 }
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             } else {
                 std::cout << "assertLoadIntHeap scalar: fIntHeapSize = ";
                 std::cout << fFactory->fIntHeapSize << " index = " << index;
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             }
             fTraceContext.write(&std::cout);
             std::cout << "-------- Interpreter crash trace end --------\n\n";
@@ -447,9 +487,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return index;
     }
 
-    inline int assertLoadRealHeap(InstructionIT it, int index, int size = -1)
+    inline int assertLoadRealHeap(FlatInstructionIT it, int index, int size = -1)
     {
-        int index_in_array = index - (*it)->fOffset1;
+        int index_in_array = index - it->fOffset1;
         if ((TRACE >= 4) && ((index < 0) || (index >= fFactory->fRealHeapSize) ||
                              (size > 0 && ((index_in_array < 0) || (index_in_array >= size))) ||
                              (fRealHeap[index] == REAL(DUMMY_REAL)))) {
@@ -461,11 +501,11 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 if (index >= 0) {
                     std::cout << " value = " << fRealHeap[index];
                 }
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             } else {
                 std::cout << "assertLoadRealHeap scalar: fRealHeapSize = ";
                 std::cout << fFactory->fRealHeapSize << " index = " << index;
-                std::cout << " name = " << (*it)->fName << std::endl;
+                std::cout << " name = " << getName(it) << std::endl;
             }
             fTraceContext.write(&std::cout);
             std::cout << "-------- Interpreter crash trace end --------\n\n";
@@ -474,7 +514,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         return index;
     }
 
-    inline REAL checkReal(InstructionIT it, REAL val)
+    inline REAL checkReal(FlatInstructionIT it, REAL val)
     {
         return (TRACE > 0) ? checkRealAux(it, val) : val;
     }
@@ -526,6 +566,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
     }
 
+    /*
+     Called for a kLoop that is not marked as recursive (its fIntValue is the vector size), with
+     empty stacks. Returns true if the whole loop (variable declaration and body) has been executed.
+    */
+    virtual bool executeLoop(FlatInstructionIT loop) { return false; }
+
     void executeBuildUserInterface(FIRUserInterfaceBlockInstruction<REAL>* block, UIInterface* glue)
     {
         // UI may have to be adapted if REAL and FAUSTFLOAT size do not match
@@ -533,7 +579,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         ZoneParam* cur_param  = nullptr;
 
         for (const auto& it : block->fInstructions) {
-            // it->write(&std::cout);
+            // fFlatBlock->write(it, &std::cout);
 
             switch (it->fOpcode) {
                 case FBCInstruction::kOpenVerticalBox:
@@ -690,11 +736,11 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
         REAL          real_stack[512];
         int           int_stack[512];
-        InstructionIT address_stack[64];
+        FlatInstructionIT address_stack[64];
 
         memset(real_stack, 0, sizeof(REAL) * 512);
         memset(int_stack, 0, sizeof(int) * 512);
-        memset(address_stack, 0, sizeof(InstructionIT) * 64);
+        memset(address_stack, 0, sizeof(FlatInstructionIT) * 64);
 
         if (TRACE > 0) {
             // Check block coherency
@@ -714,24 +760,24 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         dispatchFirstScal()                                                                 \
     }
 
-#define dispatchBranch1Scal()                        \
-    {                                                \
-        it = (*it)->fBranch1->fInstructions.begin(); \
-        dispatchFirstScal();                         \
+#define dispatchBranch1Scal() \
+    {                         \
+        it += it->fBranch1;   \
+        dispatchFirstScal();  \
     }
-#define dispatchBranch2Scal()                        \
-    {                                                \
-        it = (*it)->fBranch2->fInstructions.begin(); \
-        dispatchFirstScal();                         \
+#define dispatchBranch2Scal() \
+    {                         \
+        it += it->fBranch2;   \
+        dispatchFirstScal();  \
     }
 
-#define pushBranch1Scal()                                  \
-    {                                                      \
-        pushAddr_((*it)->fBranch1->fInstructions.begin()); \
+#define pushBranch1Scal()             \
+    {                                 \
+        pushAddr_(it + it->fBranch1); \
     }
-#define pushBranch2Scal()                                  \
-    {                                                      \
-        pushAddr_((*it)->fBranch2->fInstructions.begin()); \
+#define pushBranch2Scal()             \
+    {                                 \
+        pushAddr_(it + it->fBranch2); \
     }
 
 #define dispatchReturnScal() \
@@ -745,26 +791,33 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     }
 #define emptyReturnScal() (addr_stack_index == 0)
 
-        InstructionIT it = block->fInstructions.begin();
+        fFlatBlock           = getFlatBlock(block);
+        FlatInstructionIT it = fFlatBlock->begin();
+        if (PROFILE) {
+            fProfile.enterBlock(fFlatBlock);
+        }
 
     loop:
-        // (*it)->write(&std::cout);
-        switch ((*it)->fOpcode) {
+        if (PROFILE) {
+            fProfile.dispatch(int(it - fFlatBlock->begin()));
+        }
+        // fFlatBlock->write(it, &std::cout);
+        switch (it->fOpcode) {
             // Number operations
             case FBCInstruction::kRealValue: {
-                pushReal(it, (*it)->fRealValue);
+                pushReal(it, it->fRealValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kInt32Value: {
-                pushInt((*it)->fIntValue);
+                pushInt(it->fIntValue);
                 dispatchNextScal();
             }
 
             // Memory operations
             case FBCInstruction::kLoadSoundFieldInt: {
-                faustassert(this->fSoundTable.find((*it)->fName) != this->fSoundTable.end());
-                Soundfile* sf = this->fSoundTable[(*it)->fName];
+                faustassert(this->fSoundTable.find(getName(it)) != this->fSoundTable.end());
+                Soundfile* sf = this->fSoundTable[getName(it)];
                 faustassert(sf);
                 int  field_index = popInt();
                 int  part        = popInt();
@@ -791,8 +844,8 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             }
 
             case FBCInstruction::kLoadSoundFieldReal: {
-                faustassert(this->fSoundTable.find((*it)->fName) != this->fSoundTable.end());
-                Soundfile* sf = this->fSoundTable[(*it)->fName];
+                faustassert(this->fSoundTable.find(getName(it)) != this->fSoundTable.end());
+                Soundfile* sf = this->fSoundTable[getName(it)];
                 faustassert(sf);
                 // field_index (unused)
                 popInt();
@@ -805,36 +858,36 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
             case FBCInstruction::kLoadReal: {
                 if (TRACE > 0) {
-                    pushReal(it, fRealHeap[assertLoadRealHeap(it, (*it)->fOffset1)]);
+                    pushReal(it, fRealHeap[assertLoadRealHeap(it, it->fOffset1)]);
                 } else {
-                    pushReal(it, fRealHeap[(*it)->fOffset1]);
+                    pushReal(it, fRealHeap[it->fOffset1]);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLoadInt: {
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[assertLoadIntHeap(it, (*it)->fOffset1)]);
+                    pushInt(fIntHeap[assertLoadIntHeap(it, it->fOffset1)]);
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1]);
+                    pushInt(fIntHeap[it->fOffset1]);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kStoreReal: {
                 if (TRACE > 0) {
-                    fRealHeap[assertStoreRealHeap(it, (*it)->fOffset1)] = popReal(it);
+                    fRealHeap[assertStoreRealHeap(it, it->fOffset1)] = popReal(it);
                 } else {
-                    fRealHeap[(*it)->fOffset1] = popReal(it);
+                    fRealHeap[it->fOffset1] = popReal(it);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kStoreInt: {
                 if (TRACE > 0) {
-                    fIntHeap[assertStoreIntHeap(it, (*it)->fOffset1)] = popInt();
+                    fIntHeap[assertStoreIntHeap(it, it->fOffset1)] = popInt();
                 } else {
-                    fIntHeap[(*it)->fOffset1] = popInt();
+                    fIntHeap[it->fOffset1] = popInt();
                 }
                 dispatchNextScal();
             }
@@ -842,18 +895,18 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             // Directly store a value
             case FBCInstruction::kStoreRealValue: {
                 if (TRACE > 0) {
-                    fRealHeap[assertStoreRealHeap(it, (*it)->fOffset1)] = (*it)->fRealValue;
+                    fRealHeap[assertStoreRealHeap(it, it->fOffset1)] = it->fRealValue;
                 } else {
-                    fRealHeap[(*it)->fOffset1] = (*it)->fRealValue;
+                    fRealHeap[it->fOffset1] = it->fRealValue;
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kStoreIntValue: {
                 if (TRACE > 0) {
-                    fIntHeap[assertStoreIntHeap(it, (*it)->fOffset1)] = (*it)->fIntValue;
+                    fIntHeap[assertStoreIntHeap(it, it->fOffset1)] = it->fIntValue;
                 } else {
-                    fIntHeap[(*it)->fOffset1] = (*it)->fIntValue;
+                    fIntHeap[it->fOffset1] = it->fIntValue;
                 }
                 dispatchNextScal();
             }
@@ -861,10 +914,10 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kLoadIndexedReal: {
                 int offset = popInt();
                 if (TRACE > 0) {
-                    pushReal(it, fRealHeap[assertLoadRealHeap(it, (*it)->fOffset1 + offset,
-                                                              (*it)->fOffset2)]);
+                    pushReal(it, fRealHeap[assertLoadRealHeap(it, it->fOffset1 + offset,
+                                                              it->fOffset2)]);
                 } else {
-                    pushReal(it, fRealHeap[(*it)->fOffset1 + offset]);
+                    pushReal(it, fRealHeap[it->fOffset1 + offset]);
                 }
                 dispatchNextScal();
             }
@@ -873,20 +926,32 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 int offset = popInt();
                 if (TRACE > 0) {
                     pushInt(
-                        fIntHeap[assertLoadIntHeap(it, (*it)->fOffset1 + offset, (*it)->fOffset2)]);
+                        fIntHeap[assertLoadIntHeap(it, it->fOffset1 + offset, it->fOffset2)]);
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1 + offset]);
+                    pushInt(fIntHeap[it->fOffset1 + offset]);
                 }
                 dispatchNextScal();
             }
 
+            case FBCInstruction::kLoadIndexedClassReal: {
+                int offset = popInt();
+                pushReal(it, fClassRealHeap[it->fOffset1 + offset]);
+                dispatchNextScal();
+            }
+
+            case FBCInstruction::kLoadIndexedClassInt: {
+                int offset = popInt();
+                pushInt(fClassIntHeap[it->fOffset1 + offset]);
+                dispatchNextScal();
+            }
+
             case FBCInstruction::kStoreIndexedReal: {
                 int offset = popInt();
                 if (TRACE > 0) {
-                    fRealHeap[assertStoreRealHeap(it, (*it)->fOffset1 + offset, (*it)->fOffset2)] =
+                    fRealHeap[assertStoreRealHeap(it, it->fOffset1 + offset, it->fOffset2)] =
                         popReal(it);
                 } else {
-                    fRealHeap[(*it)->fOffset1 + offset] = popReal(it);
+                    fRealHeap[it->fOffset1 + offset] = popReal(it);
                 }
                 dispatchNextScal();
             }
@@ -894,79 +959,75 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kStoreIndexedInt: {
                 int offset = popInt();
                 if (TRACE > 0) {
-                    fIntHeap[assertStoreIntHeap(it, (*it)->fOffset1 + offset, (*it)->fOffset2)] =
+                    fIntHeap[assertStoreIntHeap(it, it->fOffset1 + offset, it->fOffset2)] =
                         popInt();
                 } else {
-                    fIntHeap[(*it)->fOffset1 + offset] = popInt();
+                    fIntHeap[it->fOffset1 + offset] = popInt();
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kBlockStoreReal: {
-                FIRBlockStoreRealInstruction<REAL>* inst =
-                    static_cast<FIRBlockStoreRealInstruction<REAL>*>(*it);
-                assertInterp(inst);
-                for (int i = 0; i < inst->fOffset2; i++) {
-                    fRealHeap[inst->fOffset1 + i] = inst->fNumTable[i];
+                const REAL* table = &fFlatBlock->fRealTable[it->fIntValue];
+                for (int i = 0; i < it->fOffset2; i++) {
+                    fRealHeap[it->fOffset1 + i] = table[i];
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kBlockStoreInt: {
-                FIRBlockStoreIntInstruction<REAL>* inst =
-                    static_cast<FIRBlockStoreIntInstruction<REAL>*>(*it);
-                assertInterp(inst);
-                for (int i = 0; i < inst->fOffset2; i++) {
-                    fIntHeap[inst->fOffset1 + i] = inst->fNumTable[i];
+                const int* table = &fFlatBlock->fIntTable[it->fIntValue];
+                for (int i = 0; i < it->fOffset2; i++) {
+                    fIntHeap[it->fOffset1 + i] = table[i];
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMoveReal: {
-                fRealHeap[(*it)->fOffset1] = fRealHeap[(*it)->fOffset2];
+                fRealHeap[it->fOffset1] = fRealHeap[it->fOffset2];
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMoveInt: {
-                fIntHeap[(*it)->fOffset1] = fIntHeap[(*it)->fOffset2];
+                fIntHeap[it->fOffset1] = fIntHeap[it->fOffset2];
                 dispatchNextScal();
             }
 
             case FBCInstruction::kPairMoveReal: {
-                fRealHeap[(*it)->fOffset1] = fRealHeap[(*it)->fOffset1 - 1];
-                fRealHeap[(*it)->fOffset2] = fRealHeap[(*it)->fOffset2 - 1];
+                fRealHeap[it->fOffset1] = fRealHeap[it->fOffset1 - 1];
+                fRealHeap[it->fOffset2] = fRealHeap[it->fOffset2 - 1];
                 dispatchNextScal();
             }
 
             case FBCInstruction::kPairMoveInt: {
-                fIntHeap[(*it)->fOffset1] = fIntHeap[(*it)->fOffset1 - 1];
-                fIntHeap[(*it)->fOffset2] = fIntHeap[(*it)->fOffset2 - 1];
+                fIntHeap[it->fOffset1] = fIntHeap[it->fOffset1 - 1];
+                fIntHeap[it->fOffset2] = fIntHeap[it->fOffset2 - 1];
                 dispatchNextScal();
             }
 
             case FBCInstruction::kBlockPairMoveReal: {
-                for (int i = (*it)->fOffset1; i < (*it)->fOffset2; i += 2) {
+                for (int i = it->fOffset1; i < it->fOffset2; i += 2) {
                     fRealHeap[i + 1] = fRealHeap[i];
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kBlockPairMoveInt: {
-                for (int i = (*it)->fOffset1; i < (*it)->fOffset2; i += 2) {
+                for (int i = it->fOffset1; i < it->fOffset2; i += 2) {
                     fIntHeap[i + 1] = fIntHeap[i];
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kBlockShiftReal: {
-                for (int i = (*it)->fOffset1; i > (*it)->fOffset2; i -= 1) {
+                for (int i = it->fOffset1; i > it->fOffset2; i -= 1) {
                     fRealHeap[i] = fRealHeap[i - 1];
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kBlockShiftInt: {
-                for (int i = (*it)->fOffset1; i > (*it)->fOffset2; i -= 1) {
+                for (int i = it->fOffset1; i > it->fOffset2; i -= 1) {
                     fIntHeap[i] = fIntHeap[i - 1];
                 }
                 dispatchNextScal();
@@ -975,18 +1036,18 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             // Input/output access
             case FBCInstruction::kLoadInput: {
                 if (TRACE > 0) {
-                    pushReal(it, fInputs[(*it)->fOffset1][assertAudioBuffer(it, popInt())]);
+                    pushReal(it, fInputs[it->fOffset1][assertAudioBuffer(it, popInt())]);
                 } else {
-                    pushReal(it, fInputs[(*it)->fOffset1][popInt()]);
+                    pushReal(it, fInputs[it->fOffset1][popInt()]);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kStoreOutput: {
                 if (TRACE > 0) {
-                    fOutputs[(*it)->fOffset1][assertAudioBuffer(it, popInt())] = popReal(it);
+                    fOutputs[it->fOffset1][assertAudioBuffer(it, popInt())] = popReal(it);
                 } else {
-                    fOutputs[(*it)->fOffset1][popInt()] = popReal(it);
+                    fOutputs[it->fOffset1][popInt()] = popReal(it);
                 }
                 dispatchNextScal();
             }
@@ -998,7 +1059,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             }
 
             case FBCInstruction::kCastRealHeap: {
-                pushReal(it, REAL(fIntHeap[(*it)->fOffset1]));
+                pushReal(it, REAL(fIntHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
@@ -1013,9 +1074,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
             case FBCInstruction::kCastIntHeap: {
                 if (TRACE >= 3) {
-                    pushInt(int(checkCastIntOverflow(it, fRealHeap[(*it)->fOffset1])));
+                    pushInt(int(checkCastIntOverflow(it, fRealHeap[it->fOffset1])));
                 } else {
-                    pushInt(int(fRealHeap[(*it)->fOffset1]));
+                    pushInt(int(fRealHeap[it->fOffset1]));
                 }
                 dispatchNextScal();
             }
@@ -1298,162 +1359,162 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 //-----------------------------------------------------
 
             case FBCInstruction::kAddRealHeap: {
-                pushReal(it, fRealHeap[(*it)->fOffset1] + fRealHeap[(*it)->fOffset2]);
+                pushReal(it, fRealHeap[it->fOffset1] + fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAddIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] + fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] + fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubRealHeap: {
-                pushReal(it, fRealHeap[(*it)->fOffset1] - fRealHeap[(*it)->fOffset2]);
+                pushReal(it, fRealHeap[it->fOffset1] - fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] - fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] - fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultRealHeap: {
-                pushReal(it, fRealHeap[(*it)->fOffset1] * fRealHeap[(*it)->fOffset2]);
+                pushReal(it, fRealHeap[it->fOffset1] * fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] * fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] * fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivRealHeap: {
-                pushReal(it, fRealHeap[(*it)->fOffset1] / fRealHeap[(*it)->fOffset2]);
+                pushReal(it, fRealHeap[it->fOffset1] / fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] / fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] / fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemRealHeap: {
                 pushReal(it,
-                         std::remainder(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+                         std::remainder(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] % fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] % fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             // Shift operation
             case FBCInstruction::kLshIntHeap: {
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1]
-                            << warningBitshift(it, fIntHeap[(*it)->fOffset2]));
+                    pushInt(fIntHeap[it->fOffset1]
+                            << warningBitshift(it, fIntHeap[it->fOffset2]));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] << fIntHeap[(*it)->fOffset2]);
+                    pushInt(fIntHeap[it->fOffset1] << fIntHeap[it->fOffset2]);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kARshIntHeap: {
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] >>
-                            warningBitshift(it, fIntHeap[(*it)->fOffset2]));
+                    pushInt(fIntHeap[it->fOffset1] >>
+                            warningBitshift(it, fIntHeap[it->fOffset2]));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> fIntHeap[(*it)->fOffset2]);
+                    pushInt(fIntHeap[it->fOffset1] >> fIntHeap[it->fOffset2]);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLRshIntHeap: {
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] >>
-                            warningBitshift(it, fIntHeap[(*it)->fOffset2]));
+                    pushInt(fIntHeap[it->fOffset1] >>
+                            warningBitshift(it, fIntHeap[it->fOffset2]));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> fIntHeap[(*it)->fOffset2]);
+                    pushInt(fIntHeap[it->fOffset1] >> fIntHeap[it->fOffset2]);
                 }
                 dispatchNextScal();
             }
 
             // Comparaison Int
             case FBCInstruction::kGTIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] > fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] > fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] < fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] < fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGEIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] >= fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] >= fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLEIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] <= fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] <= fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] == fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] == fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNEIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] != fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] != fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             // Comparaison Real
             case FBCInstruction::kGTRealHeap: {
-                pushInt(fRealHeap[(*it)->fOffset1] > fRealHeap[(*it)->fOffset2]);
+                pushInt(fRealHeap[it->fOffset1] > fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTRealHeap: {
-                pushInt(fRealHeap[(*it)->fOffset1] < fRealHeap[(*it)->fOffset2]);
+                pushInt(fRealHeap[it->fOffset1] < fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGERealHeap: {
-                pushInt(fRealHeap[(*it)->fOffset1] >= fRealHeap[(*it)->fOffset2]);
+                pushInt(fRealHeap[it->fOffset1] >= fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLERealHeap: {
-                pushInt(fRealHeap[(*it)->fOffset1] <= fRealHeap[(*it)->fOffset2]);
+                pushInt(fRealHeap[it->fOffset1] <= fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQRealHeap: {
-                pushInt(fRealHeap[(*it)->fOffset1] == fRealHeap[(*it)->fOffset2]);
+                pushInt(fRealHeap[it->fOffset1] == fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNERealHeap: {
-                pushInt(fRealHeap[(*it)->fOffset1] != fRealHeap[(*it)->fOffset2]);
+                pushInt(fRealHeap[it->fOffset1] != fRealHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             // Logical operations
             case FBCInstruction::kANDIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] & fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] & fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kORIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] | fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] | fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kXORIntHeap: {
-                pushInt(fIntHeap[(*it)->fOffset1] ^ fIntHeap[(*it)->fOffset2]);
+                pushInt(fIntHeap[it->fOffset1] ^ fIntHeap[it->fOffset2]);
                 dispatchNextScal();
             }
 
@@ -1463,61 +1524,61 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
             case FBCInstruction::kAddRealStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, fRealHeap[(*it)->fOffset1] + v1);
+                pushReal(it, fRealHeap[it->fOffset1] + v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAddIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] + v1);
+                pushInt(fIntHeap[it->fOffset1] + v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubRealStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, fRealHeap[(*it)->fOffset1] - v1);
+                pushReal(it, fRealHeap[it->fOffset1] - v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] - v1);
+                pushInt(fIntHeap[it->fOffset1] - v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultRealStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, fRealHeap[(*it)->fOffset1] * v1);
+                pushReal(it, fRealHeap[it->fOffset1] * v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] * v1);
+                pushInt(fIntHeap[it->fOffset1] * v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivRealStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, fRealHeap[(*it)->fOffset1] / v1);
+                pushReal(it, fRealHeap[it->fOffset1] / v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] / v1);
+                pushInt(fIntHeap[it->fOffset1] / v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemRealStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::remainder(fRealHeap[(*it)->fOffset1], v1));
+                pushReal(it, std::remainder(fRealHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] % v1);
+                pushInt(fIntHeap[it->fOffset1] % v1);
                 dispatchNextScal();
             }
 
@@ -1525,9 +1586,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kLshIntStack: {
                 int v1 = popInt();
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] << warningBitshift(it, v1));
+                    pushInt(fIntHeap[it->fOffset1] << warningBitshift(it, v1));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] << v1);
+                    pushInt(fIntHeap[it->fOffset1] << v1);
                 }
                 dispatchNextScal();
             }
@@ -1535,9 +1596,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kARshIntStack: {
                 int v1 = popInt();
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, v1));
+                    pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, v1));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> v1);
+                    pushInt(fIntHeap[it->fOffset1] >> v1);
                 }
                 dispatchNextScal();
             }
@@ -1545,9 +1606,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kLRshIntStack: {
                 int v1 = popInt();
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, v1));
+                    pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, v1));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> v1);
+                    pushInt(fIntHeap[it->fOffset1] >> v1);
                 }
                 dispatchNextScal();
             }
@@ -1555,93 +1616,93 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             // Comparaison Int
             case FBCInstruction::kGTIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] > v1);
+                pushInt(fIntHeap[it->fOffset1] > v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] < v1);
+                pushInt(fIntHeap[it->fOffset1] < v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGEIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] >= v1);
+                pushInt(fIntHeap[it->fOffset1] >= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLEIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] <= v1);
+                pushInt(fIntHeap[it->fOffset1] <= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] == v1);
+                pushInt(fIntHeap[it->fOffset1] == v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNEIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] != v1);
+                pushInt(fIntHeap[it->fOffset1] != v1);
                 dispatchNextScal();
             }
 
             // Comparaison Real
             case FBCInstruction::kGTRealStack: {
                 REAL v1 = popReal(it);
-                pushInt(fRealHeap[(*it)->fOffset1] > v1);
+                pushInt(fRealHeap[it->fOffset1] > v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTRealStack: {
                 REAL v1 = popReal(it);
-                pushInt(fRealHeap[(*it)->fOffset1] < v1);
+                pushInt(fRealHeap[it->fOffset1] < v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGERealStack: {
                 REAL v1 = popReal(it);
-                pushInt(fRealHeap[(*it)->fOffset1] >= v1);
+                pushInt(fRealHeap[it->fOffset1] >= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLERealStack: {
                 REAL v1 = popReal(it);
-                pushInt(fRealHeap[(*it)->fOffset1] <= v1);
+                pushInt(fRealHeap[it->fOffset1] <= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQRealStack: {
                 REAL v1 = popReal(it);
-                pushInt(fRealHeap[(*it)->fOffset1] == v1);
+                pushInt(fRealHeap[it->fOffset1] == v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNERealStack: {
                 REAL v1 = popReal(it);
-                pushInt(fRealHeap[(*it)->fOffset1] != v1);
+                pushInt(fRealHeap[it->fOffset1] != v1);
                 dispatchNextScal();
             }
 
             // Logical operations
             case FBCInstruction::kANDIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] & v1);
+                pushInt(fIntHeap[it->fOffset1] & v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kORIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] | v1);
+                pushInt(fIntHeap[it->fOffset1] | v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kXORIntStack: {
                 int v1 = popInt();
-                pushInt(fIntHeap[(*it)->fOffset1] ^ v1);
+                pushInt(fIntHeap[it->fOffset1] ^ v1);
                 dispatchNextScal();
             }
 
@@ -1651,61 +1712,61 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
             case FBCInstruction::kAddRealStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, (*it)->fRealValue + v1);
+                pushReal(it, it->fRealValue + v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAddIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue + v1);
+                pushInt(it->fIntValue + v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubRealStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, (*it)->fRealValue - v1);
+                pushReal(it, it->fRealValue - v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue - v1);
+                pushInt(it->fIntValue - v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultRealStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, (*it)->fRealValue * v1);
+                pushReal(it, it->fRealValue * v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue * v1);
+                pushInt(it->fIntValue * v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivRealStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, (*it)->fRealValue / v1);
+                pushReal(it, it->fRealValue / v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue / v1);
+                pushInt(it->fIntValue / v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemRealStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::remainder((*it)->fRealValue, v1));
+                pushReal(it, std::remainder(it->fRealValue, v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue % v1);
+                pushInt(it->fIntValue % v1);
                 dispatchNextScal();
             }
 
@@ -1713,9 +1774,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kLshIntStackValue: {
                 int v1 = popInt();
                 if (TRACE > 0) {
-                    pushInt((*it)->fIntValue << warningBitshift(it, v1));
+                    pushInt(it->fIntValue << warningBitshift(it, v1));
                 } else {
-                    pushInt((*it)->fIntValue << v1);
+                    pushInt(it->fIntValue << v1);
                 }
                 dispatchNextScal();
             }
@@ -1723,9 +1784,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kARshIntStackValue: {
                 int v1 = popInt();
                 if (TRACE > 0) {
-                    pushInt((*it)->fIntValue >> warningBitshift(it, v1));
+                    pushInt(it->fIntValue >> warningBitshift(it, v1));
                 } else {
-                    pushInt((*it)->fIntValue >> v1);
+                    pushInt(it->fIntValue >> v1);
                 }
                 dispatchNextScal();
             }
@@ -1733,9 +1794,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kLRshIntStackValue: {
                 int v1 = popInt();
                 if (TRACE > 0) {
-                    pushInt((*it)->fIntValue >> warningBitshift(it, v1));
+                    pushInt(it->fIntValue >> warningBitshift(it, v1));
                 } else {
-                    pushInt((*it)->fIntValue >> v1);
+                    pushInt(it->fIntValue >> v1);
                 }
                 dispatchNextScal();
             }
@@ -1743,93 +1804,93 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             // Comparaison Int
             case FBCInstruction::kGTIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue > v1);
+                pushInt(it->fIntValue > v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue < v1);
+                pushInt(it->fIntValue < v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGEIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue >= v1);
+                pushInt(it->fIntValue >= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLEIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue <= v1);
+                pushInt(it->fIntValue <= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue == v1);
+                pushInt(it->fIntValue == v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNEIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue != v1);
+                pushInt(it->fIntValue != v1);
                 dispatchNextScal();
             }
 
             // Comparaison Real
             case FBCInstruction::kGTRealStackValue: {
                 REAL v1 = popReal(it);
-                pushInt((*it)->fRealValue > v1);
+                pushInt(it->fRealValue > v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTRealStackValue: {
                 REAL v1 = popReal(it);
-                pushInt((*it)->fRealValue < v1);
+                pushInt(it->fRealValue < v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGERealStackValue: {
                 REAL v1 = popReal(it);
-                pushInt((*it)->fRealValue >= v1);
+                pushInt(it->fRealValue >= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLERealStackValue: {
                 REAL v1 = popReal(it);
-                pushInt((*it)->fRealValue <= v1);
+                pushInt(it->fRealValue <= v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQRealStackValue: {
                 REAL v1 = popReal(it);
-                pushInt((*it)->fRealValue == v1);
+                pushInt(it->fRealValue == v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNERealStackValue: {
                 REAL v1 = popReal(it);
-                pushInt((*it)->fRealValue != v1);
+                pushInt(it->fRealValue != v1);
                 dispatchNextScal();
             }
 
             // Logical operations
             case FBCInstruction::kANDIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue & v1);
+                pushInt(it->fIntValue & v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kORIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue | v1);
+                pushInt(it->fIntValue | v1);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kXORIntStackValue: {
                 int v1 = popInt();
-                pushInt((*it)->fIntValue ^ v1);
+                pushInt(it->fIntValue ^ v1);
                 dispatchNextScal();
             }
 
@@ -1838,158 +1899,158 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 //------------------------------------------------------
 
             case FBCInstruction::kAddRealValue: {
-                pushReal(it, (*it)->fRealValue + fRealHeap[(*it)->fOffset1]);
+                pushReal(it, it->fRealValue + fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAddIntValue: {
-                pushInt((*it)->fIntValue + fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue + fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubRealValue: {
-                pushReal(it, (*it)->fRealValue - fRealHeap[(*it)->fOffset1]);
+                pushReal(it, it->fRealValue - fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubIntValue: {
-                pushInt((*it)->fIntValue - fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue - fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultRealValue: {
-                pushReal(it, (*it)->fRealValue * fRealHeap[(*it)->fOffset1]);
+                pushReal(it, it->fRealValue * fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMultIntValue: {
-                pushInt((*it)->fIntValue * fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue * fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivRealValue: {
-                pushReal(it, (*it)->fRealValue / fRealHeap[(*it)->fOffset1]);
+                pushReal(it, it->fRealValue / fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivIntValue: {
-                pushInt((*it)->fIntValue / fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue / fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemRealValue: {
-                pushReal(it, std::remainder((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::remainder(it->fRealValue, fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemIntValue: {
-                pushInt((*it)->fIntValue % fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue % fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             // Shift operation
             case FBCInstruction::kLshIntValue: {
                 if (TRACE > 0) {
-                    pushInt((*it)->fIntValue << warningBitshift(it, fIntHeap[(*it)->fOffset1]));
+                    pushInt(it->fIntValue << warningBitshift(it, fIntHeap[it->fOffset1]));
                 } else {
-                    pushInt((*it)->fIntValue << fIntHeap[(*it)->fOffset1]);
+                    pushInt(it->fIntValue << fIntHeap[it->fOffset1]);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kARshIntValue: {
                 if (TRACE > 0) {
-                    pushInt((*it)->fIntValue >> warningBitshift(it, fIntHeap[(*it)->fOffset1]));
+                    pushInt(it->fIntValue >> warningBitshift(it, fIntHeap[it->fOffset1]));
                 } else {
-                    pushInt((*it)->fIntValue >> fIntHeap[(*it)->fOffset1]);
+                    pushInt(it->fIntValue >> fIntHeap[it->fOffset1]);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLRshIntValue: {
                 if (TRACE > 0) {
-                    pushInt((*it)->fIntValue >> warningBitshift(it, fIntHeap[(*it)->fOffset1]));
+                    pushInt(it->fIntValue >> warningBitshift(it, fIntHeap[it->fOffset1]));
                 } else {
-                    pushInt((*it)->fIntValue >> fIntHeap[(*it)->fOffset1]);
+                    pushInt(it->fIntValue >> fIntHeap[it->fOffset1]);
                 }
                 dispatchNextScal();
             }
 
             // Comparaison Int
             case FBCInstruction::kGTIntValue: {
-                pushInt((*it)->fIntValue > fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue > fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTIntValue: {
-                pushInt((*it)->fIntValue < fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue < fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGEIntValue: {
-                pushInt((*it)->fIntValue >= fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue >= fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLEIntValue: {
-                pushInt((*it)->fIntValue <= fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue <= fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQIntValue: {
-                pushInt((*it)->fIntValue == fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue == fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNEIntValue: {
-                pushInt((*it)->fIntValue != fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue != fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             // Comparaison Real
             case FBCInstruction::kGTRealValue: {
-                pushInt((*it)->fRealValue > fRealHeap[(*it)->fOffset1]);
+                pushInt(it->fRealValue > fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTRealValue: {
-                pushInt((*it)->fRealValue < fRealHeap[(*it)->fOffset1]);
+                pushInt(it->fRealValue < fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGERealValue: {
-                pushInt((*it)->fRealValue >= fRealHeap[(*it)->fOffset1]);
+                pushInt(it->fRealValue >= fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLERealValue: {
-                pushInt((*it)->fRealValue <= fRealHeap[(*it)->fOffset1]);
+                pushInt(it->fRealValue <= fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kEQRealValue: {
-                pushInt((*it)->fRealValue == fRealHeap[(*it)->fOffset1]);
+                pushInt(it->fRealValue == fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kNERealValue: {
-                pushInt((*it)->fRealValue != fRealHeap[(*it)->fOffset1]);
+                pushInt(it->fRealValue != fRealHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             // Logical operations
             case FBCInstruction::kANDIntValue: {
-                pushInt((*it)->fIntValue & fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue & fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kORIntValue: {
-                pushInt((*it)->fIntValue | fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue | fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kXORIntValue: {
-                pushInt((*it)->fIntValue ^ fIntHeap[(*it)->fOffset1]);
+                pushInt(it->fIntValue ^ fIntHeap[it->fOffset1]);
                 dispatchNextScal();
             }
 
@@ -1999,102 +2060,102 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 //----------------------------------------------------
 
             case FBCInstruction::kSubRealValueInvert: {
-                pushReal(it, fRealHeap[(*it)->fOffset1] - (*it)->fRealValue);
+                pushReal(it, fRealHeap[it->fOffset1] - it->fRealValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSubIntValueInvert: {
-                pushInt(fIntHeap[(*it)->fOffset1] - (*it)->fIntValue);
+                pushInt(fIntHeap[it->fOffset1] - it->fIntValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivRealValueInvert: {
-                pushReal(it, fRealHeap[(*it)->fOffset1] / (*it)->fRealValue);
+                pushReal(it, fRealHeap[it->fOffset1] / it->fRealValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kDivIntValueInvert: {
-                pushInt(fIntHeap[(*it)->fOffset1] / (*it)->fIntValue);
+                pushInt(fIntHeap[it->fOffset1] / it->fIntValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemRealValueInvert: {
-                pushReal(it, std::remainder(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+                pushReal(it, std::remainder(fRealHeap[it->fOffset1], it->fRealValue));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRemIntValueInvert: {
-                pushInt(fIntHeap[(*it)->fOffset1] % (*it)->fIntValue);
+                pushInt(fIntHeap[it->fOffset1] % it->fIntValue);
                 dispatchNextScal();
             }
 
             // Shift operation
             case FBCInstruction::kLshIntValueInvert: {
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] << warningBitshift(it, (*it)->fIntValue));
+                    pushInt(fIntHeap[it->fOffset1] << warningBitshift(it, it->fIntValue));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] << (*it)->fIntValue);
+                    pushInt(fIntHeap[it->fOffset1] << it->fIntValue);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kARshIntValueInvert: {
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, (*it)->fIntValue));
+                    pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, it->fIntValue));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> (*it)->fIntValue);
+                    pushInt(fIntHeap[it->fOffset1] >> it->fIntValue);
                 }
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLRshIntValueInvert: {
                 if (TRACE > 0) {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, (*it)->fIntValue));
+                    pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, it->fIntValue));
                 } else {
-                    pushInt(fIntHeap[(*it)->fOffset1] >> (*it)->fIntValue);
+                    pushInt(fIntHeap[it->fOffset1] >> it->fIntValue);
                 }
                 dispatchNextScal();
             }
 
             // Comparaison Int
             case FBCInstruction::kGTIntValueInvert: {
-                pushInt(fIntHeap[(*it)->fOffset1] > (*it)->fIntValue);
+                pushInt(fIntHeap[it->fOffset1] > it->fIntValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTIntValueInvert: {
-                pushInt(fIntHeap[(*it)->fOffset1] < (*it)->fIntValue);
+                pushInt(fIntHeap[it->fOffset1] < it->fIntValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGEIntValueInvert: {
-                pushInt(fIntHeap[(*it)->fOffset1] >= (*it)->fIntValue);
+                pushInt(fIntHeap[it->fOffset1] >= it->fIntValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLEIntValueInvert: {
-                pushInt(fIntHeap[(*it)->fOffset1] <= (*it)->fIntValue);
+                pushInt(fIntHeap[it->fOffset1] <= it->fIntValue);
                 dispatchNextScal();
             }
 
             // Comparaison Real
             case FBCInstruction::kGTRealValueInvert: {
-                pushInt(fRealHeap[(*it)->fOffset1] > (*it)->fRealValue);
+                pushInt(fRealHeap[it->fOffset1] > it->fRealValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLTRealValueInvert: {
-                pushInt(fRealHeap[(*it)->fOffset1] < (*it)->fRealValue);
+                pushInt(fRealHeap[it->fOffset1] < it->fRealValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kGERealValueInvert: {
-                pushInt(fRealHeap[(*it)->fOffset1] >= (*it)->fRealValue);
+                pushInt(fRealHeap[it->fOffset1] >= it->fRealValue);
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLERealValueInvert: {
-                pushInt(fRealHeap[(*it)->fOffset1] <= (*it)->fRealValue);
+                pushInt(fRealHeap[it->fOffset1] <= it->fRealValue);
                 dispatchNextScal();
             }
 
@@ -2251,112 +2312,112 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 //------------------------------------
 
             case FBCInstruction::kAbsHeap: {
-                pushInt(std::abs(fIntHeap[(*it)->fOffset1]));
+                pushInt(std::abs(fIntHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAbsfHeap: {
-                pushReal(it, std::fabs(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::fabs(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAcosfHeap: {
-                pushReal(it, std::acos(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::acos(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAcoshfHeap: {
-                pushReal(it, std::acosh(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::acosh(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAsinfHeap: {
-                pushReal(it, std::asin(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::asin(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAsinhfHeap: {
-                pushReal(it, std::asinh(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::asinh(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAtanfHeap: {
-                pushReal(it, std::atan(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::atan(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kAtanhfHeap: {
-                pushReal(it, std::atanh(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::atanh(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kCeilfHeap: {
-                pushReal(it, std::ceil(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::ceil(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kCosfHeap: {
-                pushReal(it, std::cos(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::cos(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kCoshfHeap: {
-                pushReal(it, std::cosh(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::cosh(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kExpfHeap: {
-                pushReal(it, std::exp(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::exp(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kFloorfHeap: {
-                pushReal(it, std::floor(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::floor(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLogfHeap: {
-                pushReal(it, std::log(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::log(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kLog10fHeap: {
-                pushReal(it, std::log10(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::log10(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRintfHeap: {
-                pushReal(it, std::rint(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::rint(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kRoundfHeap: {
-                pushReal(it, std::round(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::round(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSinfHeap: {
-                pushReal(it, std::sin(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::sin(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSinhfHeap: {
-                pushReal(it, std::sinh(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::sinh(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kSqrtfHeap: {
-                pushReal(it, std::sqrt(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::sqrt(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kTanfHeap: {
-                pushReal(it, std::tan(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::tan(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kTanhfHeap: {
-                pushReal(it, std::tanh(fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::tanh(fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
@@ -2425,37 +2486,37 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 //-------------------------------------
 
             case FBCInstruction::kAtan2fHeap: {
-                pushReal(it, std::atan2(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+                pushReal(it, std::atan2(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kFmodfHeap: {
-                pushReal(it, std::fmod(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+                pushReal(it, std::fmod(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kPowfHeap: {
-                pushReal(it, std::pow(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+                pushReal(it, std::pow(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxHeap: {
-                pushInt(std::max(fIntHeap[(*it)->fOffset1], fIntHeap[(*it)->fOffset2]));
+                pushInt(std::max(fIntHeap[it->fOffset1], fIntHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxfHeap: {
-                pushReal(it, std::max(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+                pushReal(it, std::max(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinHeap: {
-                pushInt(std::min(fIntHeap[(*it)->fOffset1], fIntHeap[(*it)->fOffset2]));
+                pushInt(std::min(fIntHeap[it->fOffset1], fIntHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinfHeap: {
-                pushReal(it, std::min(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+                pushReal(it, std::min(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
                 dispatchNextScal();
             }
 
@@ -2465,43 +2526,43 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
             case FBCInstruction::kAtan2fStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::atan2(fRealHeap[(*it)->fOffset1], v1));
+                pushReal(it, std::atan2(fRealHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kFmodfStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::fmod(fRealHeap[(*it)->fOffset1], v1));
+                pushReal(it, std::fmod(fRealHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kPowfStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::pow(fRealHeap[(*it)->fOffset1], v1));
+                pushReal(it, std::pow(fRealHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxStack: {
                 int v1 = popInt();
-                pushInt(std::max(fIntHeap[(*it)->fOffset1], v1));
+                pushInt(std::max(fIntHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxfStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::max(fRealHeap[(*it)->fOffset1], v1));
+                pushReal(it, std::max(fRealHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinStack: {
                 int v1 = popInt();
-                pushInt(std::min(fIntHeap[(*it)->fOffset1], v1));
+                pushInt(std::min(fIntHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinfStack: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::min(fRealHeap[(*it)->fOffset1], v1));
+                pushReal(it, std::min(fRealHeap[it->fOffset1], v1));
                 dispatchNextScal();
             }
 
@@ -2511,43 +2572,43 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
             case FBCInstruction::kAtan2fStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::atan2((*it)->fRealValue, v1));
+                pushReal(it, std::atan2(it->fRealValue, v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kFmodfStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::fmod((*it)->fRealValue, v1));
+                pushReal(it, std::fmod(it->fRealValue, v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kPowfStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::pow((*it)->fRealValue, v1));
+                pushReal(it, std::pow(it->fRealValue, v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxStackValue: {
                 int v1 = popInt();
-                pushInt(std::max((*it)->fIntValue, v1));
+                pushInt(std::max(it->fIntValue, v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxfStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::max((*it)->fRealValue, v1));
+                pushReal(it, std::max(it->fRealValue, v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinStackValue: {
                 int v1 = popInt();
-                pushInt(std::min((*it)->fIntValue, v1));
+                pushInt(std::min(it->fIntValue, v1));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinfStackValue: {
                 REAL v1 = popReal(it);
-                pushReal(it, std::min((*it)->fRealValue, v1));
+                pushReal(it, std::min(it->fRealValue, v1));
                 dispatchNextScal();
             }
 
@@ -2556,37 +2617,37 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 //-------------------------------------
 
             case FBCInstruction::kAtan2fValue: {
-                pushReal(it, std::atan2((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::atan2(it->fRealValue, fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kFmodfValue: {
-                pushReal(it, std::fmod((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::fmod(it->fRealValue, fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kPowfValue: {
-                pushReal(it, std::pow((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::pow(it->fRealValue, fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxValue: {
-                pushInt(std::max((*it)->fIntValue, fIntHeap[(*it)->fOffset1]));
+                pushInt(std::max(it->fIntValue, fIntHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMaxfValue: {
-                pushReal(it, std::max((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::max(it->fRealValue, fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinValue: {
-                pushInt(std::min((*it)->fIntValue, fIntHeap[(*it)->fOffset1]));
+                pushInt(std::min(it->fIntValue, fIntHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kMinfValue: {
-                pushReal(it, std::min((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+                pushReal(it, std::min(it->fRealValue, fRealHeap[it->fOffset1]));
                 dispatchNextScal();
             }
 
@@ -2595,17 +2656,17 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 //-------------------------------------------------------------------
 
             case FBCInstruction::kAtan2fValueInvert: {
-                pushReal(it, std::atan2(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+                pushReal(it, std::atan2(fRealHeap[it->fOffset1], it->fRealValue));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kFmodfValueInvert: {
-                pushReal(it, std::fmod(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+                pushReal(it, std::fmod(fRealHeap[it->fOffset1], it->fRealValue));
                 dispatchNextScal();
             }
 
             case FBCInstruction::kPowfValueInvert: {
-                pushReal(it, std::pow(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+                pushReal(it, std::pow(fRealHeap[it->fOffset1], it->fRealValue));
                 dispatchNextScal();
             }
 
@@ -2628,12 +2689,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
                 if (popInt()) {
                     // Execute new block
-                    assertInterp((*it)->fBranch1);
+                    assertInterp(it->fBranch1);
                     dispatchBranch1Scal();
                     // No value (If)
                 } else {
                     // Execute new block
-                    assertInterp((*it)->fBranch2);
+                    assertInterp(it->fBranch2);
                     dispatchBranch2Scal();
                     // No value (If)
                 }
@@ -2645,12 +2706,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
                 if (popInt()) {
                     // Execute new block
-                    assertInterp((*it)->fBranch1);
+                    assertInterp(it->fBranch1);
                     dispatchBranch1Scal();
                     // Real value
                 } else {
                     // Execute new block
-                    assertInterp((*it)->fBranch2);
+                    assertInterp(it->fBranch2);
                     dispatchBranch2Scal();
                     // Real value
                 }
@@ -2662,12 +2723,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
                 if (popInt()) {
                     // Execute new block
-                    assertInterp((*it)->fBranch1);
+                    assertInterp(it->fBranch1);
                     dispatchBranch1Scal();
                     // Int value
                 } else {
                     // Execute new block
-                    assertInterp((*it)->fBranch2);
+                    assertInterp(it->fBranch2);
                     dispatchBranch2Scal();
                     // Int value
                 }
@@ -2676,7 +2737,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             case FBCInstruction::kCondBranch: {
                 // If condition is true, just branch back on the block beginning
                 if (popInt()) {
-                    assertInterp((*it)->fBranch1);
+                    assertInterp(it->fBranch1);
                     dispatchBranch1Scal();
                 } else {
                     // Just continue after 'loop block' (do the final 'return')
@@ -2685,24 +2746,37 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             }
 
             case FBCInstruction::kLoop: {
+                // Loops of the vector mode may be executed by a derived executor
+                if (TRACE == 0 && it->fIntValue > 1 && executeLoop(it)) {
+                    dispatchNextScal();
+                }
+
                 // Keep next instruction
                 saveReturnScal();
 
                 // Push branch2 (loop content)
-                assertInterp((*it)->fBranch2);
+                assertInterp(it->fBranch2);
                 pushBranch2Scal();
 
                 // And start branch1 loop variable declaration block
-                assertInterp((*it)->fBranch1);
+                assertInterp(it->fBranch1);
                 dispatchBranch1Scal();
             }
 
+                // Superinstructions
+#define superLabel(op) case FBCInstruction::op
+#include "fbc_superinstructions_exec.hh"
+#undef superLabel
+
             default:
                 faustassert(false);
                 break;
         }
 
     end:
+        if (PROFILE) {
+            fProfile.leaveBlock();
+        }
         // Check stack coherency
         assertInterp(real_stack_index == 0 && int_stack_index == 0);
     }
@@ -2821,7 +2895,19 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             &&do_kLoop, &&do_kReturn,
 
             // Select/if
-            &&do_kIf, &&do_kSelectReal, &&do_kSelectInt, &&do_kCondBranch
+            &&do_kIf, &&do_kSelectReal, &&do_kSelectInt, &&do_kCondBranch,
+
+            // User Interface and kNop (not executed)
+            &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop,
+            &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop, &&do_kNop,
+
+            // Loads from the class segment
+            &&do_kLoadIndexedClassReal, &&do_kLoadIndexedClassInt,
+
+        // Superinstructions
+#define FBC_SUPER_LABEL(name, ...) &&do_##name,
+            FBC_SUPERINSTRUCTIONS(FBC_SUPER_LABEL)
+#undef FBC_SUPER_LABEL
 
         };
 
@@ -2831,15 +2917,18 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
         REAL          real_stack[512];
         int           int_stack[512];
-        InstructionIT address_stack[64];
+        FlatInstructionIT address_stack[64];
 
         memset(real_stack, 0, sizeof(REAL) * 512);
         memset(int_stack, 0, sizeof(int) * 512);
-        memset(address_stack, 0, sizeof(InstructionIT) * 64);
+        memset(address_stack, 0, sizeof(FlatInstructionIT) * 64);
 
-#define dispatchFirstScal()                   \
-    {                                         \
-        goto* fDispatchTable[(*it)->fOpcode]; \
+#define dispatchFirstScal()                                   \
+    {                                                         \
+        if (PROFILE) {                                        \
+            fProfile.dispatch(int(it - fFlatBlock->begin())); \
+        }                                                     \
+        goto* fDispatchTable[it->fOpcode];                    \
     }
 #define dispatchNextScal()                                                                  \
     {                                                                                       \
@@ -2850,24 +2939,24 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         dispatchFirstScal();                                                                \
     }
 
-#define dispatchBranch1Scal()                        \
-    {                                                \
-        it = (*it)->fBranch1->fInstructions.begin(); \
-        dispatchFirstScal();                         \
+#define dispatchBranch1Scal() \
+    {                         \
+        it += it->fBranch1;   \
+        dispatchFirstScal();  \
     }
-#define dispatchBranch2Scal()                        \
-    {                                                \
-        it = (*it)->fBranch2->fInstructions.begin(); \
-        dispatchFirstScal();                         \
+#define dispatchBranch2Scal() \
+    {                         \
+        it += it->fBranch2;   \
+        dispatchFirstScal();  \
     }
 
-#define pushBranch1Scal()                                  \
-    {                                                      \
-        pushAddr_((*it)->fBranch1->fInstructions.begin()); \
+#define pushBranch1Scal()             \
+    {                                 \
+        pushAddr_(it + it->fBranch1); \
     }
-#define pushBranch2Scal()                                  \
-    {                                                      \
-        pushAddr_((*it)->fBranch2->fInstructions.begin()); \
+#define pushBranch2Scal()             \
+    {                                 \
+        pushAddr_(it + it->fBranch2); \
     }
 
 #define dispatchReturnScal() \
@@ -2886,24 +2975,28 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             block->check();
         }
 
-        InstructionIT it = block->fInstructions.begin();
+        fFlatBlock           = getFlatBlock(block);
+        FlatInstructionIT it = fFlatBlock->begin();
+        if (PROFILE) {
+            fProfile.enterBlock(fFlatBlock);
+        }
         dispatchFirstScal();
 
     // Number operations
     do_kRealValue: {
-        pushReal(it, (*it)->fRealValue);
+        pushReal(it, it->fRealValue);
         dispatchNextScal();
     }
 
     do_kInt32Value: {
-        pushInt((*it)->fIntValue);
+        pushInt(it->fIntValue);
         dispatchNextScal();
     }
 
     // Memory operations
     do_kLoadSoundFieldInt: {
-        faustassert(this->fSoundTable.find((*it)->fName) != this->fSoundTable.end());
-        Soundfile* sf = this->fSoundTable[(*it)->fName];
+        faustassert(this->fSoundTable.find(getName(it)) != this->fSoundTable.end());
+        Soundfile* sf = this->fSoundTable[getName(it)];
         faustassert(sf);
         int  field_index = popInt();
         int  part        = popInt();
@@ -2930,8 +3023,8 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     }
 
     do_kLoadSoundFieldReal: {
-        faustassert(this->fSoundTable.find((*it)->fName) != this->fSoundTable.end());
-        Soundfile* sf = this->fSoundTable[(*it)->fName];
+        faustassert(this->fSoundTable.find(getName(it)) != this->fSoundTable.end());
+        Soundfile* sf = this->fSoundTable[getName(it)];
         faustassert(sf);
         // field_index (unused)
         popInt();
@@ -2944,36 +3037,36 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
     do_kLoadReal: {
         if (TRACE > 0) {
-            pushReal(it, fRealHeap[assertLoadRealHeap(it, (*it)->fOffset1)]);
+            pushReal(it, fRealHeap[assertLoadRealHeap(it, it->fOffset1)]);
         } else {
-            pushReal(it, fRealHeap[(*it)->fOffset1]);
+            pushReal(it, fRealHeap[it->fOffset1]);
         }
         dispatchNextScal();
     }
 
     do_kLoadInt: {
         if (TRACE > 0) {
-            pushInt(fIntHeap[assertLoadIntHeap(it, (*it)->fOffset1)]);
+            pushInt(fIntHeap[assertLoadIntHeap(it, it->fOffset1)]);
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1]);
+            pushInt(fIntHeap[it->fOffset1]);
         }
         dispatchNextScal();
     }
 
     do_kStoreReal: {
         if (TRACE > 0) {
-            fRealHeap[assertStoreRealHeap(it, (*it)->fOffset1)] = popReal(it);
+            fRealHeap[assertStoreRealHeap(it, it->fOffset1)] = popReal(it);
         } else {
-            fRealHeap[(*it)->fOffset1] = popReal(it);
+            fRealHeap[it->fOffset1] = popReal(it);
         }
         dispatchNextScal();
     }
 
     do_kStoreInt: {
         if (TRACE > 0) {
-            fIntHeap[assertStoreIntHeap(it, (*it)->fOffset1)] = popInt();
+            fIntHeap[assertStoreIntHeap(it, it->fOffset1)] = popInt();
         } else {
-            fIntHeap[(*it)->fOffset1] = popInt();
+            fIntHeap[it->fOffset1] = popInt();
         }
         dispatchNextScal();
     }
@@ -2981,18 +3074,18 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     // Directly store a value
     do_kStoreRealValue: {
         if (TRACE > 0) {
-            fRealHeap[assertStoreRealHeap(it, (*it)->fOffset1)] = (*it)->fRealValue;
+            fRealHeap[assertStoreRealHeap(it, it->fOffset1)] = it->fRealValue;
         } else {
-            fRealHeap[(*it)->fOffset1] = (*it)->fRealValue;
+            fRealHeap[it->fOffset1] = it->fRealValue;
         }
         dispatchNextScal();
     }
 
     do_kStoreIntValue: {
         if (TRACE > 0) {
-            fIntHeap[assertStoreIntHeap(it, (*it)->fOffset1)] = (*it)->fIntValue;
+            fIntHeap[assertStoreIntHeap(it, it->fOffset1)] = it->fIntValue;
         } else {
-            fIntHeap[(*it)->fOffset1] = (*it)->fIntValue;
+            fIntHeap[it->fOffset1] = it->fIntValue;
         }
         dispatchNextScal();
     }
@@ -3001,9 +3094,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         int offset = popInt();
         if (TRACE > 0) {
             pushReal(it,
-                     fRealHeap[assertLoadRealHeap(it, (*it)->fOffset1 + offset, (*it)->fOffset2)]);
+                     fRealHeap[assertLoadRealHeap(it, it->fOffset1 + offset, it->fOffset2)]);
         } else {
-            pushReal(it, fRealHeap[(*it)->fOffset1 + offset]);
+            pushReal(it, fRealHeap[it->fOffset1 + offset]);
         }
         dispatchNextScal();
     }
@@ -3011,20 +3104,32 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kLoadIndexedInt: {
         int offset = popInt();
         if (TRACE > 0) {
-            pushInt(fIntHeap[assertLoadIntHeap(it, (*it)->fOffset1 + offset, (*it)->fOffset2)]);
+            pushInt(fIntHeap[assertLoadIntHeap(it, it->fOffset1 + offset, it->fOffset2)]);
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1 + offset]);
+            pushInt(fIntHeap[it->fOffset1 + offset]);
         }
         dispatchNextScal();
     }
 
+    do_kLoadIndexedClassReal: {
+        int offset = popInt();
+        pushReal(it, fClassRealHeap[it->fOffset1 + offset]);
+        dispatchNextScal();
+    }
+
+    do_kLoadIndexedClassInt: {
+        int offset = popInt();
+        pushInt(fClassIntHeap[it->fOffset1 + offset]);
+        dispatchNextScal();
+    }
+
     do_kStoreIndexedReal: {
         int offset = popInt();
         if (TRACE > 0) {
-            fRealHeap[assertStoreRealHeap(it, (*it)->fOffset1 + offset, (*it)->fOffset2)] =
+            fRealHeap[assertStoreRealHeap(it, it->fOffset1 + offset, it->fOffset2)] =
                 popReal(it);
         } else {
-            fRealHeap[(*it)->fOffset1 + offset] = popReal(it);
+            fRealHeap[it->fOffset1 + offset] = popReal(it);
         }
         dispatchNextScal();
     }
@@ -3032,78 +3137,74 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kStoreIndexedInt: {
         int offset = popInt();
         if (TRACE > 0) {
-            fIntHeap[assertStoreIntHeap(it, (*it)->fOffset1 + offset, (*it)->fOffset2)] = popInt();
+            fIntHeap[assertStoreIntHeap(it, it->fOffset1 + offset, it->fOffset2)] = popInt();
         } else {
-            fIntHeap[(*it)->fOffset1 + offset] = popInt();
+            fIntHeap[it->fOffset1 + offset] = popInt();
         }
         dispatchNextScal();
     }
 
     do_kBlockStoreReal: {
-        FIRBlockStoreRealInstruction<REAL>* inst =
-            static_cast<FIRBlockStoreRealInstruction<REAL>*>(*it);
-        assertInterp(inst);
-        for (int i = 0; i < inst->fOffset2; i++) {
-            fRealHeap[inst->fOffset1 + i] = inst->fNumTable[i];
+        const REAL* table = &fFlatBlock->fRealTable[it->fIntValue];
+        for (int i = 0; i < it->fOffset2; i++) {
+            fRealHeap[it->fOffset1 + i] = table[i];
         }
         dispatchNextScal();
     }
 
     do_kBlockStoreInt: {
-        FIRBlockStoreIntInstruction<REAL>* inst =
-            static_cast<FIRBlockStoreIntInstruction<REAL>*>(*it);
-        assertInterp(inst);
-        for (int i = 0; i < inst->fOffset2; i++) {
-            fIntHeap[inst->fOffset1 + i] = inst->fNumTable[i];
+        const int* table = &fFlatBlock->fIntTable[it->fIntValue];
+        for (int i = 0; i < it->fOffset2; i++) {
+            fIntHeap[it->fOffset1 + i] = table[i];
         }
         dispatchNextScal();
     }
 
     do_kMoveReal: {
-        fRealHeap[(*it)->fOffset1] = fRealHeap[(*it)->fOffset2];
+        fRealHeap[it->fOffset1] = fRealHeap[it->fOffset2];
         dispatchNextScal();
     }
 
     do_kMoveInt: {
-        fIntHeap[(*it)->fOffset1] = fIntHeap[(*it)->fOffset2];
+        fIntHeap[it->fOffset1] = fIntHeap[it->fOffset2];
         dispatchNextScal();
     }
 
     do_kPairMoveReal: {
-        fRealHeap[(*it)->fOffset1] = fRealHeap[(*it)->fOffset1 - 1];
-        fRealHeap[(*it)->fOffset2] = fRealHeap[(*it)->fOffset2 - 1];
+        fRealHeap[it->fOffset1] = fRealHeap[it->fOffset1 - 1];
+        fRealHeap[it->fOffset2] = fRealHeap[it->fOffset2 - 1];
         dispatchNextScal();
     }
 
     do_kPairMoveInt: {
-        fIntHeap[(*it)->fOffset1] = fIntHeap[(*it)->fOffset1 - 1];
-        fIntHeap[(*it)->fOffset2] = fIntHeap[(*it)->fOffset2 - 1];
+        fIntHeap[it->fOffset1] = fIntHeap[it->fOffset1 - 1];
+        fIntHeap[it->fOffset2] = fIntHeap[it->fOffset2 - 1];
         dispatchNextScal();
     }
 
     do_kBlockPairMoveReal: {
-        for (int i = (*it)->fOffset1; i < (*it)->fOffset2; i += 2) {
+        for (int i = it->fOffset1; i < it->fOffset2; i += 2) {
             fRealHeap[i + 1] = fRealHeap[i];
         }
         dispatchNextScal();
     }
 
     do_kBlockPairMoveInt: {
-        for (int i = (*it)->fOffset1; i < (*it)->fOffset2; i += 2) {
+        for (int i = it->fOffset1; i < it->fOffset2; i += 2) {
             fIntHeap[i + 1] = fIntHeap[i];
         }
         dispatchNextScal();
     }
 
     do_kBlockShiftReal: {
-        for (int i = (*it)->fOffset1; i > (*it)->fOffset2; i -= 1) {
+        for (int i = it->fOffset1; i > it->fOffset2; i -= 1) {
             fRealHeap[i] = fRealHeap[i - 1];
         }
         dispatchNextScal();
     }
 
     do_kBlockShiftInt: {
-        for (int i = (*it)->fOffset1; i > (*it)->fOffset2; i -= 1) {
+        for (int i = it->fOffset1; i > it->fOffset2; i -= 1) {
             fIntHeap[i] = fIntHeap[i - 1];
         }
         dispatchNextScal();
@@ -3112,18 +3213,18 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     // Input/output access
     do_kLoadInput: {
         if (TRACE > 0) {
-            pushReal(it, fInputs[(*it)->fOffset1][assertAudioBuffer(it, popInt())]);
+            pushReal(it, fInputs[it->fOffset1][assertAudioBuffer(it, popInt())]);
         } else {
-            pushReal(it, fInputs[(*it)->fOffset1][popInt()]);
+            pushReal(it, fInputs[it->fOffset1][popInt()]);
         }
         dispatchNextScal();
     }
 
     do_kStoreOutput: {
         if (TRACE > 0) {
-            fOutputs[(*it)->fOffset1][assertAudioBuffer(it, popInt())] = popReal(it);
+            fOutputs[it->fOffset1][assertAudioBuffer(it, popInt())] = popReal(it);
         } else {
-            fOutputs[(*it)->fOffset1][popInt()] = popReal(it);
+            fOutputs[it->fOffset1][popInt()] = popReal(it);
         }
         dispatchNextScal();
     }
@@ -3135,7 +3236,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     }
 
     do_kCastRealHeap: {
-        pushReal(it, REAL(fIntHeap[(*it)->fOffset1]));
+        pushReal(it, REAL(fIntHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
@@ -3150,9 +3251,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
     do_kCastIntHeap: {
         if (TRACE >= 3) {
-            pushInt(int(checkCastIntOverflow(it, fRealHeap[(*it)->fOffset1])));
+            pushInt(int(checkCastIntOverflow(it, fRealHeap[it->fOffset1])));
         } else {
-            pushInt(int(fRealHeap[(*it)->fOffset1]));
+            pushInt(int(fRealHeap[it->fOffset1]));
         }
         dispatchNextScal();
     }
@@ -3430,158 +3531,158 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         //-----------------------------------------------------
 
     do_kAddRealHeap: {
-        pushReal(it, fRealHeap[(*it)->fOffset1] + fRealHeap[(*it)->fOffset2]);
+        pushReal(it, fRealHeap[it->fOffset1] + fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kAddIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] + fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] + fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kSubRealHeap: {
-        pushReal(it, fRealHeap[(*it)->fOffset1] - fRealHeap[(*it)->fOffset2]);
+        pushReal(it, fRealHeap[it->fOffset1] - fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kSubIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] - fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] - fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kMultRealHeap: {
-        pushReal(it, fRealHeap[(*it)->fOffset1] * fRealHeap[(*it)->fOffset2]);
+        pushReal(it, fRealHeap[it->fOffset1] * fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kMultIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] * fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] * fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kDivRealHeap: {
-        pushReal(it, fRealHeap[(*it)->fOffset1] / fRealHeap[(*it)->fOffset2]);
+        pushReal(it, fRealHeap[it->fOffset1] / fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kDivIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] / fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] / fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kRemRealHeap: {
-        pushReal(it, std::remainder(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+        pushReal(it, std::remainder(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
     do_kRemIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] % fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] % fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     // Shift operation
     do_kLshIntHeap: {
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] << warningBitshift(it, fIntHeap[(*it)->fOffset2]));
+            pushInt(fIntHeap[it->fOffset1] << warningBitshift(it, fIntHeap[it->fOffset2]));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] << fIntHeap[(*it)->fOffset2]);
+            pushInt(fIntHeap[it->fOffset1] << fIntHeap[it->fOffset2]);
         }
         dispatchNextScal();
     }
 
     do_kARshIntHeap: {
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, fIntHeap[(*it)->fOffset2]));
+            pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, fIntHeap[it->fOffset2]));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] >> fIntHeap[(*it)->fOffset2]);
+            pushInt(fIntHeap[it->fOffset1] >> fIntHeap[it->fOffset2]);
         }
         dispatchNextScal();
     }
 
     do_kLRshIntHeap: {
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, fIntHeap[(*it)->fOffset2]));
+            pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, fIntHeap[it->fOffset2]));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] >> fIntHeap[(*it)->fOffset2]);
+            pushInt(fIntHeap[it->fOffset1] >> fIntHeap[it->fOffset2]);
         }
         dispatchNextScal();
     }
 
     // Comparaison Int
     do_kGTIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] > fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] > fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kLTIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] < fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] < fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kGEIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] >= fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] >= fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kLEIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] <= fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] <= fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kEQIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] == fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] == fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kNEIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] != fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] != fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     // Comparaison Real
     do_kGTRealHeap: {
-        pushInt(fRealHeap[(*it)->fOffset1] > fRealHeap[(*it)->fOffset2]);
+        pushInt(fRealHeap[it->fOffset1] > fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kLTRealHeap: {
-        pushInt(fRealHeap[(*it)->fOffset1] < fRealHeap[(*it)->fOffset2]);
+        pushInt(fRealHeap[it->fOffset1] < fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kGERealHeap: {
-        pushInt(fRealHeap[(*it)->fOffset1] >= fRealHeap[(*it)->fOffset2]);
+        pushInt(fRealHeap[it->fOffset1] >= fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kLERealHeap: {
-        pushInt(fRealHeap[(*it)->fOffset1] <= fRealHeap[(*it)->fOffset2]);
+        pushInt(fRealHeap[it->fOffset1] <= fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kEQRealHeap: {
-        pushInt(fRealHeap[(*it)->fOffset1] == fRealHeap[(*it)->fOffset2]);
+        pushInt(fRealHeap[it->fOffset1] == fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kNERealHeap: {
-        pushInt(fRealHeap[(*it)->fOffset1] != fRealHeap[(*it)->fOffset2]);
+        pushInt(fRealHeap[it->fOffset1] != fRealHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     // Logical operations
     do_kANDIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] & fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] & fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kORIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] | fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] | fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
     do_kXORIntHeap: {
-        pushInt(fIntHeap[(*it)->fOffset1] ^ fIntHeap[(*it)->fOffset2]);
+        pushInt(fIntHeap[it->fOffset1] ^ fIntHeap[it->fOffset2]);
         dispatchNextScal();
     }
 
@@ -3591,61 +3692,61 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
     do_kAddRealStack: {
         REAL v1 = popReal(it);
-        pushReal(it, fRealHeap[(*it)->fOffset1] + v1);
+        pushReal(it, fRealHeap[it->fOffset1] + v1);
         dispatchNextScal();
     }
 
     do_kAddIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] + v1);
+        pushInt(fIntHeap[it->fOffset1] + v1);
         dispatchNextScal();
     }
 
     do_kSubRealStack: {
         REAL v1 = popReal(it);
-        pushReal(it, fRealHeap[(*it)->fOffset1] - v1);
+        pushReal(it, fRealHeap[it->fOffset1] - v1);
         dispatchNextScal();
     }
 
     do_kSubIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] - v1);
+        pushInt(fIntHeap[it->fOffset1] - v1);
         dispatchNextScal();
     }
 
     do_kMultRealStack: {
         REAL v1 = popReal(it);
-        pushReal(it, fRealHeap[(*it)->fOffset1] * v1);
+        pushReal(it, fRealHeap[it->fOffset1] * v1);
         dispatchNextScal();
     }
 
     do_kMultIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] * v1);
+        pushInt(fIntHeap[it->fOffset1] * v1);
         dispatchNextScal();
     }
 
     do_kDivRealStack: {
         REAL v1 = popReal(it);
-        pushReal(it, fRealHeap[(*it)->fOffset1] / v1);
+        pushReal(it, fRealHeap[it->fOffset1] / v1);
         dispatchNextScal();
     }
 
     do_kDivIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] / v1);
+        pushInt(fIntHeap[it->fOffset1] / v1);
         dispatchNextScal();
     }
 
     do_kRemRealStack: {
         REAL v1 = popReal(it);
-        pushReal(it, std::remainder(fRealHeap[(*it)->fOffset1], v1));
+        pushReal(it, std::remainder(fRealHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
     do_kRemIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] % v1);
+        pushInt(fIntHeap[it->fOffset1] % v1);
         dispatchNextScal();
     }
 
@@ -3653,9 +3754,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kLshIntStack: {
         int v1 = popInt();
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] << warningBitshift(it, v1));
+            pushInt(fIntHeap[it->fOffset1] << warningBitshift(it, v1));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] << v1);
+            pushInt(fIntHeap[it->fOffset1] << v1);
         }
         dispatchNextScal();
     }
@@ -3663,9 +3764,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kARshIntStack: {
         int v1 = popInt();
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, v1));
+            pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, v1));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] >> v1);
+            pushInt(fIntHeap[it->fOffset1] >> v1);
         }
         dispatchNextScal();
     }
@@ -3674,9 +3775,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         // TODO
         int v1 = popInt();
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, v1));
+            pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, v1));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] >> v1);
+            pushInt(fIntHeap[it->fOffset1] >> v1);
         }
         dispatchNextScal();
     }
@@ -3684,93 +3785,93 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     // Comparaison Int
     do_kGTIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] > v1);
+        pushInt(fIntHeap[it->fOffset1] > v1);
         dispatchNextScal();
     }
 
     do_kLTIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] < v1);
+        pushInt(fIntHeap[it->fOffset1] < v1);
         dispatchNextScal();
     }
 
     do_kGEIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] >= v1);
+        pushInt(fIntHeap[it->fOffset1] >= v1);
         dispatchNextScal();
     }
 
     do_kLEIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] <= v1);
+        pushInt(fIntHeap[it->fOffset1] <= v1);
         dispatchNextScal();
     }
 
     do_kEQIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] == v1);
+        pushInt(fIntHeap[it->fOffset1] == v1);
         dispatchNextScal();
     }
 
     do_kNEIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] != v1);
+        pushInt(fIntHeap[it->fOffset1] != v1);
         dispatchNextScal();
     }
 
     // Comparaison Real
     do_kGTRealStack: {
         REAL v1 = popReal(it);
-        pushInt(fRealHeap[(*it)->fOffset1] > v1);
+        pushInt(fRealHeap[it->fOffset1] > v1);
         dispatchNextScal();
     }
 
     do_kLTRealStack: {
         REAL v1 = popReal(it);
-        pushInt(fRealHeap[(*it)->fOffset1] < v1);
+        pushInt(fRealHeap[it->fOffset1] < v1);
         dispatchNextScal();
     }
 
     do_kGERealStack: {
         REAL v1 = popReal(it);
-        pushInt(fRealHeap[(*it)->fOffset1] >= v1);
+        pushInt(fRealHeap[it->fOffset1] >= v1);
         dispatchNextScal();
     }
 
     do_kLERealStack: {
         REAL v1 = popReal(it);
-        pushInt(fRealHeap[(*it)->fOffset1] <= v1);
+        pushInt(fRealHeap[it->fOffset1] <= v1);
         dispatchNextScal();
     }
 
     do_kEQRealStack: {
         REAL v1 = popReal(it);
-        pushInt(fRealHeap[(*it)->fOffset1] == v1);
+        pushInt(fRealHeap[it->fOffset1] == v1);
         dispatchNextScal();
     }
 
     do_kNERealStack: {
         REAL v1 = popReal(it);
-        pushInt(fRealHeap[(*it)->fOffset1] != v1);
+        pushInt(fRealHeap[it->fOffset1] != v1);
         dispatchNextScal();
     }
 
     // Logical operations
     do_kANDIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] & v1);
+        pushInt(fIntHeap[it->fOffset1] & v1);
         dispatchNextScal();
     }
 
     do_kORIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] | v1);
+        pushInt(fIntHeap[it->fOffset1] | v1);
         dispatchNextScal();
     }
 
     do_kXORIntStack: {
         int v1 = popInt();
-        pushInt(fIntHeap[(*it)->fOffset1] ^ v1);
+        pushInt(fIntHeap[it->fOffset1] ^ v1);
         dispatchNextScal();
     }
 
@@ -3780,61 +3881,61 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
     do_kAddRealStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, (*it)->fRealValue + v1);
+        pushReal(it, it->fRealValue + v1);
         dispatchNextScal();
     }
 
     do_kAddIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue + v1);
+        pushInt(it->fIntValue + v1);
         dispatchNextScal();
     }
 
     do_kSubRealStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, (*it)->fRealValue - v1);
+        pushReal(it, it->fRealValue - v1);
         dispatchNextScal();
     }
 
     do_kSubIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue - v1);
+        pushInt(it->fIntValue - v1);
         dispatchNextScal();
     }
 
     do_kMultRealStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, (*it)->fRealValue * v1);
+        pushReal(it, it->fRealValue * v1);
         dispatchNextScal();
     }
 
     do_kMultIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue * v1);
+        pushInt(it->fIntValue * v1);
         dispatchNextScal();
     }
 
     do_kDivRealStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, (*it)->fRealValue / v1);
+        pushReal(it, it->fRealValue / v1);
         dispatchNextScal();
     }
 
     do_kDivIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue / v1);
+        pushInt(it->fIntValue / v1);
         dispatchNextScal();
     }
 
     do_kRemRealStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, std::remainder((*it)->fRealValue, v1));
+        pushReal(it, std::remainder(it->fRealValue, v1));
         dispatchNextScal();
     }
 
     do_kRemIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue % v1);
+        pushInt(it->fIntValue % v1);
         dispatchNextScal();
     }
 
@@ -3842,9 +3943,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kLshIntStackValue: {
         int v1 = popInt();
         if (TRACE > 0) {
-            pushInt((*it)->fIntValue << warningBitshift(it, v1));
+            pushInt(it->fIntValue << warningBitshift(it, v1));
         } else {
-            pushInt((*it)->fIntValue << v1);
+            pushInt(it->fIntValue << v1);
         }
         dispatchNextScal();
     }
@@ -3852,9 +3953,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kARshIntStackValue: {
         int v1 = popInt();
         if (TRACE > 0) {
-            pushInt((*it)->fIntValue >> warningBitshift(it, v1));
+            pushInt(it->fIntValue >> warningBitshift(it, v1));
         } else {
-            pushInt((*it)->fIntValue >> v1);
+            pushInt(it->fIntValue >> v1);
         }
         dispatchNextScal();
     }
@@ -3862,9 +3963,9 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kLRshIntStackValue: {
         int v1 = popInt();
         if (TRACE > 0) {
-            pushInt((*it)->fIntValue >> warningBitshift(it, v1));
+            pushInt(it->fIntValue >> warningBitshift(it, v1));
         } else {
-            pushInt((*it)->fIntValue >> v1);
+            pushInt(it->fIntValue >> v1);
         }
         dispatchNextScal();
     }
@@ -3872,93 +3973,93 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     // Comparaison Int
     do_kGTIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue > v1);
+        pushInt(it->fIntValue > v1);
         dispatchNextScal();
     }
 
     do_kLTIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue < v1);
+        pushInt(it->fIntValue < v1);
         dispatchNextScal();
     }
 
     do_kGEIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue >= v1);
+        pushInt(it->fIntValue >= v1);
         dispatchNextScal();
     }
 
     do_kLEIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue <= v1);
+        pushInt(it->fIntValue <= v1);
         dispatchNextScal();
     }
 
     do_kEQIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue == v1);
+        pushInt(it->fIntValue == v1);
         dispatchNextScal();
     }
 
     do_kNEIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue != v1);
+        pushInt(it->fIntValue != v1);
         dispatchNextScal();
     }
 
     // Comparaison Real
     do_kGTRealStackValue: {
         REAL v1 = popReal(it);
-        pushInt((*it)->fRealValue > v1);
+        pushInt(it->fRealValue > v1);
         dispatchNextScal();
     }
 
     do_kLTRealStackValue: {
         REAL v1 = popReal(it);
-        pushInt((*it)->fRealValue < v1);
+        pushInt(it->fRealValue < v1);
         dispatchNextScal();
     }
 
     do_kGERealStackValue: {
         REAL v1 = popReal(it);
-        pushInt((*it)->fRealValue >= v1);
+        pushInt(it->fRealValue >= v1);
         dispatchNextScal();
     }
 
     do_kLERealStackValue: {
         REAL v1 = popReal(it);
-        pushInt((*it)->fRealValue <= v1);
+        pushInt(it->fRealValue <= v1);
         dispatchNextScal();
     }
 
     do_kEQRealStackValue: {
         REAL v1 = popReal(it);
-        pushInt((*it)->fRealValue == v1);
+        pushInt(it->fRealValue == v1);
         dispatchNextScal();
     }
 
     do_kNERealStackValue: {
         REAL v1 = popReal(it);
-        pushInt((*it)->fRealValue != v1);
+        pushInt(it->fRealValue != v1);
         dispatchNextScal();
     }
 
     // Logical operations
     do_kANDIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue & v1);
+        pushInt(it->fIntValue & v1);
         dispatchNextScal();
     }
 
     do_kORIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue | v1);
+        pushInt(it->fIntValue | v1);
         dispatchNextScal();
     }
 
     do_kXORIntStackValue: {
         int v1 = popInt();
-        pushInt((*it)->fIntValue ^ v1);
+        pushInt(it->fIntValue ^ v1);
         dispatchNextScal();
     }
 
@@ -3967,158 +4068,158 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         //------------------------------------------------------
 
     do_kAddRealValue: {
-        pushReal(it, (*it)->fRealValue + fRealHeap[(*it)->fOffset1]);
+        pushReal(it, it->fRealValue + fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kAddIntValue: {
-        pushInt((*it)->fIntValue + fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue + fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kSubRealValue: {
-        pushReal(it, (*it)->fRealValue - fRealHeap[(*it)->fOffset1]);
+        pushReal(it, it->fRealValue - fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kSubIntValue: {
-        pushInt((*it)->fIntValue - fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue - fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kMultRealValue: {
-        pushReal(it, (*it)->fRealValue * fRealHeap[(*it)->fOffset1]);
+        pushReal(it, it->fRealValue * fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kMultIntValue: {
-        pushInt((*it)->fIntValue * fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue * fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kDivRealValue: {
-        pushReal(it, (*it)->fRealValue / fRealHeap[(*it)->fOffset1]);
+        pushReal(it, it->fRealValue / fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kDivIntValue: {
-        pushInt((*it)->fIntValue / fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue / fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kRemRealValue: {
-        pushReal(it, std::remainder((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::remainder(it->fRealValue, fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kRemIntValue: {
-        pushInt((*it)->fIntValue % fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue % fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     // Shift operation
     do_kLshIntValue: {
         if (TRACE > 0) {
-            pushInt((*it)->fIntValue << warningBitshift(it, fIntHeap[(*it)->fOffset1]));
+            pushInt(it->fIntValue << warningBitshift(it, fIntHeap[it->fOffset1]));
         } else {
-            pushInt((*it)->fIntValue << fIntHeap[(*it)->fOffset1]);
+            pushInt(it->fIntValue << fIntHeap[it->fOffset1]);
         }
         dispatchNextScal();
     }
 
     do_kARshIntValue: {
         if (TRACE > 0) {
-            pushInt((*it)->fIntValue >> warningBitshift(it, fIntHeap[(*it)->fOffset1]));
+            pushInt(it->fIntValue >> warningBitshift(it, fIntHeap[it->fOffset1]));
         } else {
-            pushInt((*it)->fIntValue >> fIntHeap[(*it)->fOffset1]);
+            pushInt(it->fIntValue >> fIntHeap[it->fOffset1]);
         }
         dispatchNextScal();
     }
 
     do_kLRshIntValue: {
         if (TRACE > 0) {
-            pushInt((*it)->fIntValue >> warningBitshift(it, fIntHeap[(*it)->fOffset1]));
+            pushInt(it->fIntValue >> warningBitshift(it, fIntHeap[it->fOffset1]));
         } else {
-            pushInt((*it)->fIntValue >> fIntHeap[(*it)->fOffset1]);
+            pushInt(it->fIntValue >> fIntHeap[it->fOffset1]);
         }
         dispatchNextScal();
     }
 
     // Comparaison Int
     do_kGTIntValue: {
-        pushInt((*it)->fIntValue > fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue > fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kLTIntValue: {
-        pushInt((*it)->fIntValue < fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue < fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kGEIntValue: {
-        pushInt((*it)->fIntValue >= fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue >= fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kLEIntValue: {
-        pushInt((*it)->fIntValue <= fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue <= fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kEQIntValue: {
-        pushInt((*it)->fIntValue == fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue == fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kNEIntValue: {
-        pushInt((*it)->fIntValue != fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue != fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     // Comparaison Real
     do_kGTRealValue: {
-        pushInt((*it)->fRealValue > fRealHeap[(*it)->fOffset1]);
+        pushInt(it->fRealValue > fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kLTRealValue: {
-        pushInt((*it)->fRealValue < fRealHeap[(*it)->fOffset1]);
+        pushInt(it->fRealValue < fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kGERealValue: {
-        pushInt((*it)->fRealValue >= fRealHeap[(*it)->fOffset1]);
+        pushInt(it->fRealValue >= fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kLERealValue: {
-        pushInt((*it)->fRealValue <= fRealHeap[(*it)->fOffset1]);
+        pushInt(it->fRealValue <= fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kEQRealValue: {
-        pushInt((*it)->fRealValue == fRealHeap[(*it)->fOffset1]);
+        pushInt(it->fRealValue == fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kNERealValue: {
-        pushInt((*it)->fRealValue != fRealHeap[(*it)->fOffset1]);
+        pushInt(it->fRealValue != fRealHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     // Logical operations
     do_kANDIntValue: {
-        pushInt((*it)->fIntValue & fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue & fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kORIntValue: {
-        pushInt((*it)->fIntValue | fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue | fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
     do_kXORIntValue: {
-        pushInt((*it)->fIntValue ^ fIntHeap[(*it)->fOffset1]);
+        pushInt(it->fIntValue ^ fIntHeap[it->fOffset1]);
         dispatchNextScal();
     }
 
@@ -4128,102 +4229,102 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         //----------------------------------------------------
 
     do_kSubRealValueInvert: {
-        pushReal(it, fRealHeap[(*it)->fOffset1] - (*it)->fRealValue);
+        pushReal(it, fRealHeap[it->fOffset1] - it->fRealValue);
         dispatchNextScal();
     }
 
     do_kSubIntValueInvert: {
-        pushInt(fIntHeap[(*it)->fOffset1] - (*it)->fIntValue);
+        pushInt(fIntHeap[it->fOffset1] - it->fIntValue);
         dispatchNextScal();
     }
 
     do_kDivRealValueInvert: {
-        pushReal(it, fRealHeap[(*it)->fOffset1] / (*it)->fRealValue);
+        pushReal(it, fRealHeap[it->fOffset1] / it->fRealValue);
         dispatchNextScal();
     }
 
     do_kDivIntValueInvert: {
-        pushInt(fIntHeap[(*it)->fOffset1] / (*it)->fIntValue);
+        pushInt(fIntHeap[it->fOffset1] / it->fIntValue);
         dispatchNextScal();
     }
 
     do_kRemRealValueInvert: {
-        pushReal(it, std::remainder(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+        pushReal(it, std::remainder(fRealHeap[it->fOffset1], it->fRealValue));
         dispatchNextScal();
     }
 
     do_kRemIntValueInvert: {
-        pushInt(fIntHeap[(*it)->fOffset1] % (*it)->fIntValue);
+        pushInt(fIntHeap[it->fOffset1] % it->fIntValue);
         dispatchNextScal();
     }
 
     // Shift operation
     do_kLshIntValueInvert: {
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] << warningBitshift(it, (*it)->fIntValue));
+            pushInt(fIntHeap[it->fOffset1] << warningBitshift(it, it->fIntValue));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] << (*it)->fIntValue);
+            pushInt(fIntHeap[it->fOffset1] << it->fIntValue);
         }
         dispatchNextScal();
     }
 
     do_kARshIntValueInvert: {
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, (*it)->fIntValue));
+            pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, it->fIntValue));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] >> (*it)->fIntValue);
+            pushInt(fIntHeap[it->fOffset1] >> it->fIntValue);
         }
         dispatchNextScal();
     }
 
     do_kLRshIntValueInvert: {
         if (TRACE > 0) {
-            pushInt(fIntHeap[(*it)->fOffset1] >> warningBitshift(it, (*it)->fIntValue));
+            pushInt(fIntHeap[it->fOffset1] >> warningBitshift(it, it->fIntValue));
         } else {
-            pushInt(fIntHeap[(*it)->fOffset1] >> (*it)->fIntValue);
+            pushInt(fIntHeap[it->fOffset1] >> it->fIntValue);
         }
         dispatchNextScal();
     }
 
     // Comparaison Int
     do_kGTIntValueInvert: {
-        pushInt(fIntHeap[(*it)->fOffset1] > (*it)->fIntValue);
+        pushInt(fIntHeap[it->fOffset1] > it->fIntValue);
         dispatchNextScal();
     }
 
     do_kLTIntValueInvert: {
-        pushInt(fIntHeap[(*it)->fOffset1] < (*it)->fIntValue);
+        pushInt(fIntHeap[it->fOffset1] < it->fIntValue);
         dispatchNextScal();
     }
 
     do_kGEIntValueInvert: {
-        pushInt(fIntHeap[(*it)->fOffset1] >= (*it)->fIntValue);
+        pushInt(fIntHeap[it->fOffset1] >= it->fIntValue);
         dispatchNextScal();
     }
 
     do_kLEIntValueInvert: {
-        pushInt(fIntHeap[(*it)->fOffset1] <= (*it)->fIntValue);
+        pushInt(fIntHeap[it->fOffset1] <= it->fIntValue);
         dispatchNextScal();
     }
 
     // Comparaison Real
     do_kGTRealValueInvert: {
-        pushInt(fRealHeap[(*it)->fOffset1] > (*it)->fRealValue);
+        pushInt(fRealHeap[it->fOffset1] > it->fRealValue);
         dispatchNextScal();
     }
 
     do_kLTRealValueInvert: {
-        pushInt(fRealHeap[(*it)->fOffset1] < (*it)->fRealValue);
+        pushInt(fRealHeap[it->fOffset1] < it->fRealValue);
         dispatchNextScal();
     }
 
     do_kGERealValueInvert: {
-        pushInt(fRealHeap[(*it)->fOffset1] >= (*it)->fRealValue);
+        pushInt(fRealHeap[it->fOffset1] >= it->fRealValue);
         dispatchNextScal();
     }
 
     do_kLERealValueInvert: {
-        pushInt(fRealHeap[(*it)->fOffset1] <= (*it)->fRealValue);
+        pushInt(fRealHeap[it->fOffset1] <= it->fRealValue);
         dispatchNextScal();
     }
 
@@ -4380,112 +4481,112 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         ///-----------------------------------
 
     do_kAbsHeap: {
-        pushInt(std::abs(fIntHeap[(*it)->fOffset1]));
+        pushInt(std::abs(fIntHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kAbsfHeap: {
-        pushReal(it, std::fabs(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::fabs(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kAcosfHeap: {
-        pushReal(it, std::acos(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::acos(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kAcoshfHeap: {
-        pushReal(it, std::acosh(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::acosh(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kAsinfHeap: {
-        pushReal(it, std::asin(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::asin(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kAsinhfHeap: {
-        pushReal(it, std::asinh(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::asinh(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kAtanfHeap: {
-        pushReal(it, std::atan(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::atan(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kAtanhfHeap: {
-        pushReal(it, std::atanh(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::atanh(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kCeilfHeap: {
-        pushReal(it, std::ceil(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::ceil(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kCosfHeap: {
-        pushReal(it, std::cos(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::cos(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kCoshfHeap: {
-        pushReal(it, std::cosh(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::cosh(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kExpfHeap: {
-        pushReal(it, std::exp(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::exp(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kFloorfHeap: {
-        pushReal(it, std::floor(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::floor(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kLogfHeap: {
-        pushReal(it, std::log(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::log(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kLog10fHeap: {
-        pushReal(it, std::log10(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::log10(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kRintfHeap: {
-        pushReal(it, std::rint(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::rint(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kRoundfHeap: {
-        pushReal(it, std::round(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::round(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kSinfHeap: {
-        pushReal(it, std::sin(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::sin(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kSinhfHeap: {
-        pushReal(it, std::sinh(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::sinh(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kSqrtfHeap: {
-        pushReal(it, std::sqrt(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::sqrt(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kTanfHeap: {
-        pushReal(it, std::tan(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::tan(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kTanhfHeap: {
-        pushReal(it, std::tanh(fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::tanh(fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
@@ -4554,37 +4655,37 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         //-------------------------------------
 
     do_kAtan2fHeap: {
-        pushReal(it, std::atan2(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+        pushReal(it, std::atan2(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
     do_kFmodfHeap: {
-        pushReal(it, std::fmod(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+        pushReal(it, std::fmod(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
     do_kPowfHeap: {
-        pushReal(it, std::pow(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+        pushReal(it, std::pow(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
     do_kMaxHeap: {
-        pushInt(std::max(fIntHeap[(*it)->fOffset1], fIntHeap[(*it)->fOffset2]));
+        pushInt(std::max(fIntHeap[it->fOffset1], fIntHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
     do_kMaxfHeap: {
-        pushReal(it, std::max(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+        pushReal(it, std::max(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
     do_kMinHeap: {
-        pushInt(std::min(fIntHeap[(*it)->fOffset1], fIntHeap[(*it)->fOffset2]));
+        pushInt(std::min(fIntHeap[it->fOffset1], fIntHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
     do_kMinfHeap: {
-        pushReal(it, std::min(fRealHeap[(*it)->fOffset1], fRealHeap[(*it)->fOffset2]));
+        pushReal(it, std::min(fRealHeap[it->fOffset1], fRealHeap[it->fOffset2]));
         dispatchNextScal();
     }
 
@@ -4594,43 +4695,43 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
     do_kAtan2fStack: {
         REAL v1 = popReal(it);
-        pushReal(it, std::atan2(fRealHeap[(*it)->fOffset1], v1));
+        pushReal(it, std::atan2(fRealHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
     do_kFmodfStack: {
         REAL v1 = popReal(it);
-        pushReal(it, std::fmod(fRealHeap[(*it)->fOffset1], v1));
+        pushReal(it, std::fmod(fRealHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
     do_kPowfStack: {
         REAL v1 = popReal(it);
-        pushReal(it, std::pow(fRealHeap[(*it)->fOffset1], v1));
+        pushReal(it, std::pow(fRealHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
     do_kMaxStack: {
         int v1 = popInt();
-        pushInt(std::max(fIntHeap[(*it)->fOffset1], v1));
+        pushInt(std::max(fIntHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
     do_kMaxfStack: {
         REAL v1 = popReal(it);
-        pushReal(it, std::max(fRealHeap[(*it)->fOffset1], v1));
+        pushReal(it, std::max(fRealHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
     do_kMinStack: {
         int v1 = popInt();
-        pushInt(std::min(fIntHeap[(*it)->fOffset1], v1));
+        pushInt(std::min(fIntHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
     do_kMinfStack: {
         REAL v1 = popReal(it);
-        pushReal(it, std::min(fRealHeap[(*it)->fOffset1], v1));
+        pushReal(it, std::min(fRealHeap[it->fOffset1], v1));
         dispatchNextScal();
     }
 
@@ -4640,43 +4741,43 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
     do_kAtan2fStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, std::atan2((*it)->fRealValue, v1));
+        pushReal(it, std::atan2(it->fRealValue, v1));
         dispatchNextScal();
     }
 
     do_kFmodfStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, std::fmod((*it)->fRealValue, v1));
+        pushReal(it, std::fmod(it->fRealValue, v1));
         dispatchNextScal();
     }
 
     do_kPowfStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, std::pow((*it)->fRealValue, v1));
+        pushReal(it, std::pow(it->fRealValue, v1));
         dispatchNextScal();
     }
 
     do_kMaxStackValue: {
         int v1 = popInt();
-        pushInt(std::max((*it)->fIntValue, v1));
+        pushInt(std::max(it->fIntValue, v1));
         dispatchNextScal();
     }
 
     do_kMaxfStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, std::max((*it)->fRealValue, v1));
+        pushReal(it, std::max(it->fRealValue, v1));
         dispatchNextScal();
     }
 
     do_kMinStackValue: {
         int v1 = popInt();
-        pushInt(std::min((*it)->fIntValue, v1));
+        pushInt(std::min(it->fIntValue, v1));
         dispatchNextScal();
     }
 
     do_kMinfStackValue: {
         REAL v1 = popReal(it);
-        pushReal(it, std::min((*it)->fRealValue, v1));
+        pushReal(it, std::min(it->fRealValue, v1));
         dispatchNextScal();
     }
 
@@ -4685,37 +4786,37 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         //-------------------------------------
 
     do_kAtan2fValue: {
-        pushReal(it, std::atan2((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::atan2(it->fRealValue, fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kFmodfValue: {
-        pushReal(it, std::fmod((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::fmod(it->fRealValue, fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kPowfValue: {
-        pushReal(it, std::pow((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::pow(it->fRealValue, fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kMaxValue: {
-        pushInt(std::max((*it)->fIntValue, fIntHeap[(*it)->fOffset1]));
+        pushInt(std::max(it->fIntValue, fIntHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kMaxfValue: {
-        pushReal(it, std::max((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::max(it->fRealValue, fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kMinValue: {
-        pushInt(std::min((*it)->fIntValue, fIntHeap[(*it)->fOffset1]));
+        pushInt(std::min(it->fIntValue, fIntHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
     do_kMinfValue: {
-        pushReal(it, std::min((*it)->fRealValue, fRealHeap[(*it)->fOffset1]));
+        pushReal(it, std::min(it->fRealValue, fRealHeap[it->fOffset1]));
         dispatchNextScal();
     }
 
@@ -4724,17 +4825,17 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         //-------------------------------------------------------------------
 
     do_kAtan2fValueInvert: {
-        pushReal(it, std::atan2(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+        pushReal(it, std::atan2(fRealHeap[it->fOffset1], it->fRealValue));
         dispatchNextScal();
     }
 
     do_kFmodfValueInvert: {
-        pushReal(it, std::fmod(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+        pushReal(it, std::fmod(fRealHeap[it->fOffset1], it->fRealValue));
         dispatchNextScal();
     }
 
     do_kPowfValueInvert: {
-        pushReal(it, std::pow(fRealHeap[(*it)->fOffset1], (*it)->fRealValue));
+        pushReal(it, std::pow(fRealHeap[it->fOffset1], it->fRealValue));
         dispatchNextScal();
     }
 
@@ -4757,12 +4858,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
         if (popInt()) {
             // Execute new block
-            assertInterp((*it)->fBranch1);
+            assertInterp(it->fBranch1);
             dispatchBranch1Scal();
             // No value (If)
         } else {
             // Execute new block
-            assertInterp((*it)->fBranch2);
+            assertInterp(it->fBranch2);
             dispatchBranch2Scal();
             // No value (If)
         }
@@ -4774,12 +4875,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
         if (popInt()) {
             // Execute new block
-            assertInterp((*it)->fBranch1);
+            assertInterp(it->fBranch1);
             dispatchBranch1Scal();
             // Real value
         } else {
             // Execute new block
-            assertInterp((*it)->fBranch2);
+            assertInterp(it->fBranch2);
             dispatchBranch2Scal();
             // Real value
         }
@@ -4791,12 +4892,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
 
         if (popInt()) {
             // Execute new block
-            assertInterp((*it)->fBranch1);
+            assertInterp(it->fBranch1);
             dispatchBranch1Scal();
             // Int value
         } else {
             // Execute new block
-            assertInterp((*it)->fBranch2);
+            assertInterp(it->fBranch2);
             dispatchBranch2Scal();
             // Int value
         }
@@ -4805,7 +4906,7 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     do_kCondBranch: {
         // If condition is true, just branch back on the block beginning
         if (popInt()) {
-            assertInterp((*it)->fBranch1);
+            assertInterp(it->fBranch1);
             dispatchBranch1Scal();
         } else {
             // Just continue after 'loop block' (do the final 'return')
@@ -4814,24 +4915,51 @@ class FBCInterpreter : public FBCExecutor<REAL> {
     }
 
     do_kLoop: {
+        // Loops of the vector mode may be executed by a derived executor
+        if (TRACE == 0 && it->fIntValue > 1 && executeLoop(it)) {
+            dispatchNextScal();
+        }
+
         // Keep next instruction
         saveReturnScal();
 
         // Push branch2 (loop content)
-        assertInterp((*it)->fBranch2);
+        assertInterp(it->fBranch2);
         pushBranch2Scal();
 
         // And start branch1 loop variable declaration block
-        assertInterp((*it)->fBranch1);
+        assertInterp(it->fBranch1);
         dispatchBranch1Scal();
     }
 
+    do_kNop: {
+        faustassert(false);
+    }
+
+        // Superinstructions
+#define superLabel(op) do_##op
+#include "fbc_superinstructions_exec.hh"
+#undef superLabel
+
     end:
+        if (PROFILE) {
+            fProfile.leaveBlock();
+        }
         // Check stack coherency
         assertInterp(real_stack_index == 0 && int_stack_index == 0);
     }
 #endif
 
+    // Cells of the whole heaps, possibly in the shared class segment
+    int getIntCell(int offset)
+    {
+        return (offset < fIntClassSize) ? fClassIntHeap[offset] : fIntHeap[offset];
+    }
+    REAL getRealCell(int offset)
+    {
+        return (offset < fRealClassSize) ? fClassRealHeap[offset] : fRealHeap[offset];
+    }
+
     inline bool startWith(const std::string& str, const std::string& prefix)
     {
         return (str.substr(0, prefix.size()) == prefix);
@@ -4856,8 +4984,16 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         }
     }
 
+    FBCFlatBlock<REAL>* getFlatBlock(FBCBlockInstruction<REAL>* block)
+    {
+        return fFactory->getFlatBlock(block);
+    }
+
    public:
-    FBCInterpreter(interpreter_dsp_factory_aux<REAL, TRACE>* factory)
+    // Executors that keep their own values after the DSP fields give larger heap sizes, and the ones
+    // only accessing the heaps from the flat blocks can share the class segment of the factory
+    FBCInterpreter(interpreter_dsp_factory_aux<REAL, TRACE_MODE>* factory, int int_heap_size = 0,
+                   int real_heap_size = 0, bool share_class = false)
     {
         /*
         std::cout << "FBCInterpreter :"
@@ -4867,18 +5003,27 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 << " count_offset " << count_offset << std::endl;
         */
 
-        fFactory = factory;
+        fFactory   = factory;
+        fFlatBlock = nullptr;
+
+        int_heap_size  = std::max(int_heap_size, fFactory->fIntHeapSize);
+        real_heap_size = std::max(real_heap_size, fFactory->fRealHeapSize);
+
+        bool shared    = share_class && fFactory->fClassShared && !fFactory->getMemoryManager();
+        fIntClassSize  = (shared) ? fFactory->fIntClassSize : 0;
+        fRealClassSize = (shared) ? fFactory->fRealClassSize : 0;
+        int_heap_size -= fIntClassSize;
+        real_heap_size -= fRealClassSize;
 
         if (fFactory->getMemoryManager()) {
-            fRealHeap =
-                static_cast<REAL*>(fFactory->allocate(sizeof(REAL) * fFactory->fRealHeapSize));
-            fIntHeap = static_cast<int*>(fFactory->allocate(sizeof(REAL) * fFactory->fIntHeapSize));
+            fRealHeap = static_cast<REAL*>(fFactory->allocate(sizeof(REAL) * real_heap_size));
+            fIntHeap  = static_cast<int*>(fFactory->allocate(sizeof(REAL) * int_heap_size));
             fInputs = static_cast<REAL**>(fFactory->allocate(sizeof(REAL*) * fFactory->fNumInputs));
             fOutputs =
                 static_cast<REAL**>(fFactory->allocate(sizeof(REAL*) * fFactory->fNumOutputs));
         } else {
-            fRealHeap = new REAL[fFactory->fRealHeapSize];
-            fIntHeap  = new int[fFactory->fIntHeapSize];
+            fRealHeap = new REAL[real_heap_size];
+            fIntHeap  = new int[int_heap_size];
             fInputs   = new REAL*[fFactory->fNumInputs];
             fOutputs  = new REAL*[fFactory->fNumOutputs];
         }
@@ -4888,13 +5033,26 @@ class FBCInterpreter : public FBCExecutor<REAL> {
         // std::cout << "fIntHeapSize = " << fFactory->fIntHeapSize << std::endl;
 
         // Initialise HEAP with special values to detect incorrect Load access
-        for (int i = 0; i < fFactory->fRealHeapSize; i++) {
+        for (int i = 0; i < real_heap_size; i++) {
             fRealHeap[i] = REAL(DUMMY_REAL);
         }
-        for (int i = 0; i < fFactory->fIntHeapSize; i++) {
+        for (int i = 0; i < int_heap_size; i++) {
             fIntHeap[i] = DUMMY_INT;
         }
 
+        // The instance segment keeps the offsets of the whole heaps
+        fIntHeap -= fIntClassSize;
+        fRealHeap -= fRealClassSize;
+        if (shared) {
+            // Until classInit, the segment of the last initialized sample rate is used
+            FBCInterpreter<REAL, TRACE_MODE>* class_executor = fFactory->getClassExecutor();
+            fClassIntHeap  = (class_executor) ? class_executor->fIntHeap : nullptr;
+            fClassRealHeap = (class_executor) ? class_executor->fRealHeap : nullptr;
+        } else {
+            fClassIntHeap  = fIntHeap;
+            fClassRealHeap = fRealHeap;
+        }
+
         fRealStats[INTEGER_OVERFLOW]  = 0;
         fRealStats[DIV_BY_ZERO_REAL]  = 0;
         fRealStats[DIV_BY_ZERO_INT]   = 0;
@@ -4919,14 +5077,17 @@ class FBCInterpreter : public FBCExecutor<REAL> {
             fFactory->destroy(fInputs);
             fFactory->destroy(fOutputs);
         } else {
-            delete[] fRealHeap;
-            delete[] fIntHeap;
+            delete[] (fRealHeap + fRealClassSize);
+            delete[] (fIntHeap + fIntClassSize);
             delete[] fInputs;
             delete[] fOutputs;
         }
         if (TRACE > 0) {
             printStats();
         }
+        if (PROFILE) {
+            printProfile();
+        }
     }
 
     void dumpMemory(std::vector<FBCBlockInstruction<REAL>*> blocks, const std::string& name,
@@ -4950,12 +5111,12 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 int j = 0;
                 for (j = 0; j < memory_map_real[i].first; j++) {
                     out << i + j << " " << memory_map_real[i].second << "[" << j << "] "
-                        << fRealHeap[i + j] << std::endl;
+                        << getRealCell(i + j) << std::endl;
                 }
                 i += j;
             } else {
                 // Scalar
-                out << i << " " << memory_map_real[i].second << " " << fRealHeap[i] << std::endl;
+                out << i << " " << memory_map_real[i].second << " " << getRealCell(i) << std::endl;
                 i++;
             }
         }
@@ -4974,17 +5135,36 @@ class FBCInterpreter : public FBCExecutor<REAL> {
                 int j = 0;
                 for (j = 0; j < memory_map_int[i].first; j++) {
                     out << i + j << " " << memory_map_int[i].second << "[" << j << "] "
-                        << fIntHeap[i + j] << std::endl;
+                        << getIntCell(i + j) << std::endl;
                 }
                 i += j;
             } else {
                 // Scalar
-                out << i << " " << memory_map_int[i].second << " " << fIntHeap[i] << std::endl;
+                out << i << " " << memory_map_int[i].second << " " << getIntCell(i) << std::endl;
                 i++;
             }
         }
     }
 
+    // The class segment is computed once per sample rate by the factory, and copied when not shared
+    virtual void classInit(int sample_rate)
+    {
+        if (fIntClassSize > 0 || fRealClassSize > 0) {
+            FBCInterpreter<REAL, TRACE_MODE>* class_executor =
+                fFactory->initClassSegment(sample_rate);
+            fClassIntHeap  = class_executor->fIntHeap;
+            fClassRealHeap = class_executor->fRealHeap;
+        } else {
+            fFactory->initClassSegment(sample_rate, fIntHeap, fRealHeap);
+        }
+    }
+
+    void copyClassSegment(int* int_heap, REAL* real_heap)
+    {
+        std::copy(fIntHeap, fIntHeap + fFactory->fIntClassSize, int_heap);
+        std::copy(fRealHeap, fRealHeap + fFactory->fRealClassSize, real_heap);
+    }
+
     void setIntValue(int offset, int value) { fIntHeap[offset] = value; }
     int  getIntValue(int offset) { return fIntHeap[offset]; }
 
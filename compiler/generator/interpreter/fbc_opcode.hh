@@ -25,6 +25,8 @@
 #include <map>
 #include <string>
 
+#include "fbc_superinstructions.hh"
+
 // Interpreter
 
 struct FBCInstruction {
@@ -365,6 +367,16 @@ struct FBCInstruction {
         kDeclare,
 
         kNop,
+
+        // Loads from the class segment (see interpreter_dsp_factory_aux::fClassShared), only used
+        // in the interpreter flat blocks
+        kLoadIndexedClassReal,
+        kLoadIndexedClassInt,
+
+        // Superinstructions, only used in the interpreter flat blocks
+#define FBC_SUPER_OPCODE(name, ...) name,
+        FBC_SUPERINSTRUCTIONS(FBC_SUPER_OPCODE)
+#undef FBC_SUPER_OPCODE
     };
 
     virtual ~FBCInstruction() {}
@@ -508,8 +520,17 @@ static std::string gFBCInstructionTable[] = {
     "kAddChecButton", "kAddHorizontalSlider", "kAddVerticalSlider", "kAddNumEntry", "kAddSoundfile",
     "kAddHorizontalBargraph", "kAddVerticalBargraph", "kDeclare",
 
-    "kNop"};
+    "kNop",
+
+    // Loads from the class segment
+    "kLoadIndexedClassReal", "kLoadIndexedClassInt",
+
+// Superinstructions
+#define FBC_SUPER_NAME(name, ...) #name,
+    FBC_SUPERINSTRUCTIONS(FBC_SUPER_NAME)
+#undef FBC_SUPER_NAME
+};
 
-#define INTERP_FILE_VERSION 8
+#define INTERP_FILE_VERSION 9
 
 #endif
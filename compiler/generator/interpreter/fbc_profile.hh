@@ -0,0 +1,461 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _FBC_PROFILE_H
+#define _FBC_PROFILE_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fbc_heap_layout.hh"
+#include "interpreter_bytecode.hh"
+
+/*
+ Profile mode (FAUST_INTERP_TRACE=8) : no check is done, the blocks are optimized but executed
+ without superinstructions, and each dispatch is timed. The ticks between two dispatches are given
+ to the first instruction, so they include the probe overhead. When the executor is deleted, the
+ counters are reported per block, per opcode and per statement (the instructions up to a store in a
+ field or an output), with the UI controls the statement depends on.
+*/
+
+#define TRACE_PROFILE 8
+
+template <class REAL>
+class FBCRegisterCompiler;
+
+/*
+ Names of the heap fields and of the UI controls, collected on the blocks produced by the visitor
+ (the optimized instructions do not keep them).
+*/
+template <class REAL>
+struct FBCProfileNames {
+    typedef FBCInstruction        I;
+    typedef std::set<std::string> Labels;
+
+    struct Field {
+        int         fSize;
+        std::string fName;
+    };
+
+    // Per heap (int then real) : fields indexed by their first cell
+    std::map<int, Field> fFields[2];
+    // Zone offset of the input controls, and their path
+    std::map<int, std::string> fControls;
+
+    void analyse(FBCBlockInstruction<REAL>* block)
+    {
+        if (!block) {
+            return;
+        }
+        for (const auto& it : block->fInstructions) {
+            bool real;
+            if (FBCHeapLayout<REAL>::getAccess(it->fOpcode, real) && it->fName != "") {
+                int offset = it->fOffset1;
+                int size   = 1;
+                if (it->fOpcode == I::kBlockShiftReal || it->fOpcode == I::kBlockShiftInt) {
+                    offset = it->fOffset2;
+                    size   = it->fOffset1 - it->fOffset2 + 1;
+                } else if (it->fOpcode != I::kLoadReal && it->fOpcode != I::kLoadInt &&
+                           it->fOpcode != I::kStoreReal && it->fOpcode != I::kStoreInt) {
+                    size = it->fOffset2;
+                }
+                Field& field = fFields[real][offset];
+                field.fSize  = std::max(field.fSize, size);
+                field.fName  = it->fName;
+            }
+            if (it->fOpcode != I::kCondBranch) {
+                analyse(it->fBranch1);
+                analyse(it->fBranch2);
+            }
+        }
+    }
+
+    void analyse(FIRUserInterfaceBlockInstruction<REAL>* block)
+    {
+        for (const auto& it : block->getPathMap()) {
+            fControls[it.second] = it.first;
+        }
+    }
+
+    // Name of the field containing the cell, or its offset when unknown
+    std::string getName(bool real, int offset) const
+    {
+        auto it = fFields[real].upper_bound(offset);
+        if (it != fFields[real].begin()) {
+            --it;
+            if (offset < it->first + std::max(it->second.fSize, 1)) {
+                return it->second.fName;
+            }
+        }
+        return std::string((real) ? "real" : "int") + "[" + std::to_string(offset) + "]";
+    }
+
+    // UI control read at this cell
+    const std::string* getControl(bool real, int offset) const
+    {
+        if (real) {
+            auto it = fControls.find(offset);
+            if (it != fControls.end()) {
+                return &it->second;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/*
+ Per executor counters, one per instruction of the executed flat blocks.
+*/
+template <class REAL>
+struct FBCProfile {
+    typedef FBCInstruction                         I;
+    typedef typename FBCProfileNames<REAL>::Labels Labels;
+
+    struct Counter {
+        uint64_t fDispatches = 0;
+        uint64_t fTicks      = 0;
+    };
+
+    std::map<const FBCFlatBlock<REAL>*, std::vector<Counter>> fCounters;
+
+    Counter* fBlockCounters = nullptr;
+    Counter* fLast          = nullptr;
+    uint64_t fLastTicks     = 0;
+
+    // Same clock as dsp-bench.h
+    static inline uint64_t getTicks()
+    {
+#if defined(__x86_64__)
+        union {
+            uint32_t i32[2];
+            uint64_t i64;
+        } count;
+        __asm__ __volatile__("rdtsc" : "=a"(count.i32[0]), "=d"(count.i32[1]));
+        return count.i64;
+#else
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count());
+#endif
+    }
+
+    void enterBlock(const FBCFlatBlock<REAL>* block)
+    {
+        std::vector<Counter>& counters = fCounters[block];
+        if (counters.empty()) {
+            counters.resize(block->fInstructions.size());
+        }
+        fBlockCounters = counters.data();
+        fLast          = nullptr;
+        fLastTicks     = getTicks();
+    }
+
+    inline void dispatch(int index)
+    {
+        uint64_t ticks = getTicks();
+        if (fLast) {
+            fLast->fTicks += ticks - fLastTicks;
+        }
+        fLast = &fBlockCounters[index];
+        fLast->fDispatches++;
+        fLastTicks = ticks;
+    }
+
+    void leaveBlock()
+    {
+        if (fLast) {
+            fLast->fTicks += getTicks() - fLastTicks;
+            fLast = nullptr;
+        }
+    }
+
+    /*
+     Statements
+    */
+    struct Statement {
+        std::string fName;
+        Labels      fLabels;
+        Counter     fCounter;
+    };
+
+    struct Cell {
+        bool fReal;
+        int  fOffset;
+    };
+
+    // Cells read by the instruction
+    static void getReads(FlatInstructionIT inst, std::vector<Cell>& cells)
+    {
+        I::Opcode base;
+        int       left, right;
+        switch (inst->fOpcode) {
+            case I::kLoadReal:
+            case I::kLoadIndexedReal:
+            case I::kLoadIndexedClassReal:
+            case I::kCastIntHeap:
+                cells.push_back({true, inst->fOffset1});
+                break;
+            case I::kLoadInt:
+            case I::kLoadIndexedInt:
+            case I::kLoadIndexedClassInt:
+            case I::kCastRealHeap:
+                cells.push_back({false, inst->fOffset1});
+                break;
+            case I::kMoveReal:
+                cells.push_back({true, inst->fOffset2});
+                break;
+            case I::kMoveInt:
+                cells.push_back({false, inst->fOffset2});
+                break;
+            default:
+                if (FBCRegisterCompiler<REAL>::decodeMath(inst->fOpcode, base, left, right) &&
+                    (left == 1 || right == 1)) {
+                    bool real = FBCRegisterCompiler<REAL>::isRealOperand(base);
+                    cells.push_back({real, inst->fOffset1});
+                    if (left == 1 && right == 1) {
+                        cells.push_back({real, inst->fOffset2});
+                    }
+                }
+                break;
+        }
+    }
+
+    // Name of the statement ended by the instruction, or false if it does not end a statement
+    static bool getStatement(FlatInstructionIT inst, const FBCProfileNames<REAL>& names,
+                             std::string& name)
+    {
+        switch (inst->fOpcode) {
+            case I::kStoreReal:
+            case I::kStoreRealValue:
+            case I::kStoreIndexedReal:
+            case I::kMoveReal:
+            case I::kPairMoveReal:
+            case I::kBlockStoreReal:
+            case I::kBlockPairMoveReal:
+                name = names.getName(true, inst->fOffset1);
+                return true;
+            case I::kStoreInt:
+            case I::kStoreIntValue:
+            case I::kStoreIndexedInt:
+            case I::kMoveInt:
+            case I::kPairMoveInt:
+            case I::kBlockStoreInt:
+            case I::kBlockPairMoveInt:
+                name = names.getName(false, inst->fOffset1);
+                return true;
+            case I::kBlockShiftReal:
+                name = names.getName(true, inst->fOffset2);
+                return true;
+            case I::kBlockShiftInt:
+                name = names.getName(false, inst->fOffset2);
+                return true;
+            case I::kStoreOutput:
+                name = "output" + std::to_string(inst->fOffset1);
+                return true;
+            case I::kCondBranch:
+                name = "(loop)";
+                return true;
+            case I::kReturn:
+                name = "(return)";
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Statements of the block in program order (the ones with the same name are merged), the UI
+    // controls of the stored fields being propagated in 'fields'
+    void getStatements(const FBCFlatBlock<REAL>* block, const FBCProfileNames<REAL>& names,
+                       std::map<std::string, Labels>& fields, std::vector<Statement>& statements)
+    {
+        const std::vector<Counter>& counters = fCounters[block];
+        std::map<std::string, int>  indexes;
+
+        // Recursive fields need several passes to get the controls of their previous values
+        for (int pass = 0; pass < 4; pass++) {
+            bool              changed = false;
+            std::vector<Cell> cells;
+            Counter           counter;
+            for (int i = 0; i < int(block->fInstructions.size()); i++) {
+                FlatInstructionIT inst = block->begin() + i;
+                getReads(inst, cells);
+                if (i < int(counters.size())) {
+                    counter.fDispatches += counters[i].fDispatches;
+                    counter.fTicks += counters[i].fTicks;
+                }
+                std::string name;
+                if (!getStatement(inst, names, name)) {
+                    continue;
+                }
+                Labels labels;
+                for (const auto& cell : cells) {
+                    const std::string* control = names.getControl(cell.fReal, cell.fOffset);
+                    if (control) {
+                        labels.insert(*control);
+                    } else {
+                        const Labels& deps = fields[names.getName(cell.fReal, cell.fOffset)];
+                        labels.insert(deps.begin(), deps.end());
+                    }
+                }
+                Labels& stored = fields[name];
+                size_t  size   = stored.size();
+                stored.insert(labels.begin(), labels.end());
+                changed |= (stored.size() != size);
+                if (pass == 0) {
+                    if (indexes.find(name) == indexes.end()) {
+                        indexes[name] = int(statements.size());
+                        statements.push_back({name, Labels(), Counter()});
+                    }
+                    Statement& statement = statements[indexes[name]];
+                    statement.fCounter.fDispatches += counter.fDispatches;
+                    statement.fCounter.fTicks += counter.fTicks;
+                }
+                cells.clear();
+                counter = Counter();
+            }
+            if (!changed) {
+                break;
+            }
+        }
+        for (auto& it : statements) {
+            it.fLabels = fields[it.fName];
+        }
+    }
+
+    /*
+     Report
+    */
+    static std::string getPercent(uint64_t ticks, uint64_t total)
+    {
+        std::stringstream res;
+        res << std::fixed << std::setprecision(1) << ((total > 0) ? (100. * ticks / total) : 0.)
+            << "%";
+        return res.str();
+    }
+
+    static void printCounter(std::ostream& out, const std::string& name, const Counter& counter,
+                             uint64_t total)
+    {
+        out << "    " << std::left << std::setw(28) << name << std::right << " dispatches "
+            << std::setw(12) << counter.fDispatches << " ticks " << std::setw(14) << counter.fTicks
+            << " " << std::setw(6) << getPercent(counter.fTicks, total);
+    }
+
+    static void printLabels(std::ostream& out, const Labels& labels)
+    {
+        if (labels.size() > 0) {
+            out << " [";
+            std::string sep = "";
+            for (const auto& it : labels) {
+                out << sep << it;
+                sep = " ";
+            }
+            out << "]";
+        }
+    }
+
+    // Blocks are given in execution order, with their name
+    void print(std::ostream& out,
+               const std::vector<std::pair<std::string, FBCFlatBlock<REAL>*>>& blocks,
+               const FBCProfileNames<REAL>& names)
+    {
+        std::map<std::string, Labels>                            fields;
+        std::vector<std::pair<std::string, Statement>>           hot;
+        uint64_t                                                 total = 0;
+        std::vector<std::pair<std::string, FBCFlatBlock<REAL>*>> executed;
+
+        for (const auto& block : blocks) {
+            auto it = fCounters.find(block.second);
+            if (it != fCounters.end()) {
+                for (const auto& counter : it->second) {
+                    total += counter.fTicks;
+                }
+                executed.push_back(block);
+            }
+        }
+        if (executed.empty()) {
+            return;
+        }
+
+        out << "-------------------------------" << std::endl;
+        out << "Interpreter profile (ticks include the probe overhead)" << std::endl;
+        for (const auto& block : executed) {
+            const std::vector<Counter>& counters = fCounters[block.second];
+
+            // Block and opcodes
+            Counter                block_counter;
+            std::map<int, Counter> opcodes;
+            for (int i = 0; i < int(counters.size()); i++) {
+                Counter& opcode = opcodes[block.second->fInstructions[i].fOpcode];
+                opcode.fDispatches += counters[i].fDispatches;
+                opcode.fTicks += counters[i].fTicks;
+                block_counter.fDispatches += counters[i].fDispatches;
+                block_counter.fTicks += counters[i].fTicks;
+            }
+            out << block.first << " : dispatches " << block_counter.fDispatches << " ticks "
+                << block_counter.fTicks << " " << getPercent(block_counter.fTicks, total)
+                << std::endl;
+            out << "  opcodes" << std::endl;
+            for (const auto& it : opcodes) {
+                if (it.second.fDispatches > 0) {
+                    printCounter(out, gFBCInstructionTable[it.first], it.second, total);
+                    out << std::endl;
+                }
+            }
+
+            // Statements
+            std::vector<Statement> statements;
+            getStatements(block.second, names, fields, statements);
+            out << "  statements" << std::endl;
+            for (const auto& it : statements) {
+                if (it.fCounter.fDispatches > 0) {
+                    printCounter(out, it.fName, it.fCounter, total);
+                    printLabels(out, it.fLabels);
+                    out << std::endl;
+                    hot.push_back(std::make_pair(block.first, it));
+                }
+            }
+        }
+
+        // Hottest statements of all blocks
+        std::stable_sort(hot.begin(), hot.end(), [](const auto& a, const auto& b) {
+            return a.second.fCounter.fTicks > b.second.fCounter.fTicks;
+        });
+        out << "hot statements" << std::endl;
+        for (int i = 0; i < std::min(int(hot.size()), 10); i++) {
+            out << "    " << std::setw(6) << getPercent(hot[i].second.fCounter.fTicks, total) << " "
+                << hot[i].first << " " << hot[i].second.fName;
+            printLabels(out, hot[i].second.fLabels);
+            out << std::endl;
+        }
+        out << "-------------------------------" << std::endl;
+    }
+};
+
+#endif
@@ -0,0 +1,1368 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef _FBC_REGISTER_INTERPRETER_H
+#define _FBC_REGISTER_INTERPRETER_H
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fbc_interpreter.hh"
+
+/*
+ Register based FBC executor (used when FAUST_INTERP_REGISTER is set).
+
+ The stack FBC blocks are lowered once per factory into a three-address code, where every operand
+ is directly a cell of the int or real heap :
+
+    - the DSP fields (loads are not executed anymore, the field is used as an operand)
+    - constants (kRealValue/kInt32Value and the 'Value' variants)
+    - registers, that keep the intermediate results
+
+ Registers and constants are allocated after the DSP fields, in the heaps of each instance.
+ A register is assigned to each position of the (int or real) stack : since the lifetime of stack
+ values is strictly nested, this is a linear scan allocation where the interval of a value ends as
+ soon as it is popped, and it only uses as many registers as the maximum stack depth.
+
+ A load of a field is only done when the field is written before its value is used (it is then
+ copied in the register of its stack position), and the result of an operation that is directly
+ stored in a field is computed in the field itself.
+
+ Blocks using instructions that are not lowered (BlockStore, soundfiles) are executed by the
+ stack interpreter.
+*/
+
+struct FBCRegisterInstruction {
+    enum Opcode {
+        // Memory
+        kMoveReal, kMoveInt, kLoadIndexedReal, kLoadIndexedInt, kStoreIndexedReal, kStoreIndexedInt,
+        kPairMoveReal, kPairMoveInt, kBlockPairMoveReal, kBlockPairMoveInt, kBlockShiftReal,
+        kBlockShiftInt, kLoadInput, kStoreOutput,
+
+        // Cast/Bitcast
+        kCastReal, kCastInt, kBitcastInt, kBitcastReal,
+
+        // Standard math, in the FBCInstruction order
+        kAddReal, kAddInt, kSubReal, kSubInt, kMultReal, kMultInt, kDivReal, kDivInt, kRemReal,
+        kRemInt, kLshInt, kARshInt, kLRshInt, kGTInt, kLTInt, kGEInt, kLEInt, kEQInt, kNEInt,
+        kGTReal, kLTReal, kGEReal, kLEReal, kEQReal, kNEReal, kANDInt, kORInt, kXORInt,
+
+        // Extended unary math, in the FBCInstruction order
+        kAbs, kAbsf, kAcosf, kAcoshf, kAsinf, kAsinhf, kAtanf, kAtanhf, kCeilf, kCosf, kCoshf,
+        kExpf, kFloorf, kLogf, kLog10f, kRintf, kRoundf, kSinf, kSinhf, kSqrtf, kTanf, kTanhf,
+        kIsnanf, kIsinff,
+
+        // Extended binary math, in the FBCInstruction order
+        kAtan2f, kFmodf, kPowf, kMax, kMaxf, kMin, kMinf, kCopysignf,
+
+        // Control : relative jump offset in 'fSrc2', condition in 'fSrc1'
+        kJump, kJumpIfZero, kJumpIfNotZero, kReturn
+    };
+
+    int fOpcode;
+    int fDst;
+    int fSrc1;
+    int fSrc2;
+};
+
+static std::string gFBCRegisterInstructionTable[] = {
+
+    // Memory
+    "kMoveReal", "kMoveInt", "kLoadIndexedReal", "kLoadIndexedInt", "kStoreIndexedReal",
+    "kStoreIndexedInt", "kPairMoveReal", "kPairMoveInt", "kBlockPairMoveReal", "kBlockPairMoveInt",
+    "kBlockShiftReal", "kBlockShiftInt", "kLoadInput", "kStoreOutput",
+
+    // Cast/Bitcast
+    "kCastReal", "kCastInt", "kBitcastInt", "kBitcastReal",
+
+    // Standard math
+    "kAddReal", "kAddInt", "kSubReal", "kSubInt", "kMultReal", "kMultInt", "kDivReal", "kDivInt",
+    "kRemReal", "kRemInt", "kLshInt", "kARshInt", "kLRshInt", "kGTInt", "kLTInt", "kGEInt",
+    "kLEInt", "kEQInt", "kNEInt", "kGTReal", "kLTReal", "kGEReal", "kLEReal", "kEQReal", "kNEReal",
+    "kANDInt", "kORInt", "kXORInt",
+
+    // Extended unary math
+    "kAbs", "kAbsf", "kAcosf", "kAcoshf", "kAsinf", "kAsinhf", "kAtanf", "kAtanhf", "kCeilf",
+    "kCosf", "kCoshf", "kExpf", "kFloorf", "kLogf", "kLog10f", "kRintf", "kRoundf", "kSinf",
+    "kSinhf", "kSqrtf", "kTanf", "kTanhf", "kIsnanf", "kIsinff",
+
+    // Extended binary math
+    "kAtan2f", "kFmodf", "kPowf", "kMax", "kMaxf", "kMin", "kMinf", "kCopysignf",
+
+    // Control
+    "kJump", "kJumpIfZero", "kJumpIfNotZero", "kReturn"};
+
+template <class REAL>
+struct FBCRegisterCode;
+
+/*
+ Lower FBC blocks in a FBCRegisterCode.
+*/
+template <class REAL>
+class FBCRegisterCompiler {
+   public:
+    static bool isRealOperand(FBCInstruction::Opcode op)
+    {
+        if (FBCInstruction::isMath(op)) {
+            return (op == FBCInstruction::kAddReal) || (op == FBCInstruction::kSubReal) ||
+                   (op == FBCInstruction::kMultReal) || (op == FBCInstruction::kDivReal) ||
+                   (op == FBCInstruction::kRemReal) ||
+                   ((op >= FBCInstruction::kGTReal) && (op <= FBCInstruction::kNEReal));
+        } else if ((op >= FBCInstruction::kAbs) && (op <= FBCInstruction::kIsinff)) {
+            return op != FBCInstruction::kAbs;
+        } else {
+            return (op != FBCInstruction::kMax) && (op != FBCInstruction::kMin);
+        }
+    }
+
+    static FBCInstruction::Opcode getValueInvertMath(FBCInstruction::Opcode op)
+    {
+        switch (op) {
+            case FBCInstruction::kSubRealValueInvert:
+                return FBCInstruction::kSubReal;
+            case FBCInstruction::kSubIntValueInvert:
+                return FBCInstruction::kSubInt;
+            case FBCInstruction::kDivRealValueInvert:
+                return FBCInstruction::kDivReal;
+            case FBCInstruction::kDivIntValueInvert:
+                return FBCInstruction::kDivInt;
+            case FBCInstruction::kRemRealValueInvert:
+                return FBCInstruction::kRemReal;
+            case FBCInstruction::kRemIntValueInvert:
+                return FBCInstruction::kRemInt;
+            case FBCInstruction::kLshIntValueInvert:
+                return FBCInstruction::kLshInt;
+            case FBCInstruction::kARshIntValueInvert:
+                return FBCInstruction::kARshInt;
+            case FBCInstruction::kLRshIntValueInvert:
+                return FBCInstruction::kLRshInt;
+            case FBCInstruction::kGTIntValueInvert:
+                return FBCInstruction::kGTInt;
+            case FBCInstruction::kLTIntValueInvert:
+                return FBCInstruction::kLTInt;
+            case FBCInstruction::kGEIntValueInvert:
+                return FBCInstruction::kGEInt;
+            case FBCInstruction::kLEIntValueInvert:
+                return FBCInstruction::kLEInt;
+            case FBCInstruction::kGTRealValueInvert:
+                return FBCInstruction::kGTReal;
+            case FBCInstruction::kLTRealValueInvert:
+                return FBCInstruction::kLTReal;
+            case FBCInstruction::kGERealValueInvert:
+                return FBCInstruction::kGEReal;
+            default:
+                return FBCInstruction::kLEReal;
+        }
+    }
+
+    /*
+     Decode the heap and value variants of a math operation : 'base' is the stack operation,
+     'left' and 'right' give the origin of its operands (0 : stack, 1 : heap field, 2 : value).
+     A single heap operand is in fOffset1, the right one is in fOffset2 when both are heap fields.
+     Returns false for other instructions.
+    */
+    static bool decodeMath(FBCInstruction::Opcode op, FBCInstruction::Opcode& base, int& left,
+                           int& right)
+    {
+        typedef FBCInstruction I;
+
+        left  = 0;
+        right = 0;
+        if ((op >= I::kAddReal && op <= I::kXORInt) || (op >= I::kAbs && op <= I::kIsinff) ||
+            (op >= I::kAtan2f && op <= I::kCopysignf)) {
+            base = op;
+        } else if (op >= I::kAddRealHeap && op <= I::kXORIntHeap) {
+            base  = I::Opcode(op - (I::kAddRealHeap - I::kAddReal));
+            left  = 1;
+            right = 1;
+        } else if (op >= I::kAddRealStack && op <= I::kXORIntStack) {
+            base = I::Opcode(op - (I::kAddRealStack - I::kAddReal));
+            left = 1;
+        } else if (op >= I::kAddRealStackValue && op <= I::kXORIntStackValue) {
+            base = I::Opcode(op - (I::kAddRealStackValue - I::kAddReal));
+            left = 2;
+        } else if (op >= I::kAddRealValue && op <= I::kXORIntValue) {
+            base  = I::Opcode(op - (I::kAddRealValue - I::kAddReal));
+            left  = 2;
+            right = 1;
+        } else if (op >= I::kSubRealValueInvert && op <= I::kLERealValueInvert) {
+            base  = getValueInvertMath(op);
+            left  = 1;
+            right = 2;
+        } else if (op >= I::kAbsHeap && op <= I::kTanhfHeap) {
+            base = I::Opcode(op - (I::kAbsHeap - I::kAbs));
+            left = 1;
+        } else if (op >= I::kAtan2fHeap && op <= I::kMinfHeap) {
+            base  = I::Opcode(op - (I::kAtan2fHeap - I::kAtan2f));
+            left  = 1;
+            right = 1;
+        } else if (op >= I::kAtan2fStack && op <= I::kMinfStack) {
+            base = I::Opcode(op - (I::kAtan2fStack - I::kAtan2f));
+            left = 1;
+        } else if (op >= I::kAtan2fStackValue && op <= I::kMinfStackValue) {
+            base = I::Opcode(op - (I::kAtan2fStackValue - I::kAtan2f));
+            left = 2;
+        } else if (op >= I::kAtan2fValue && op <= I::kMinfValue) {
+            base  = I::Opcode(op - (I::kAtan2fValue - I::kAtan2f));
+            left  = 2;
+            right = 1;
+        } else if (op >= I::kAtan2fValueInvert && op <= I::kPowfValueInvert) {
+            base  = I::Opcode(op - (I::kAtan2fValueInvert - I::kAtan2f));
+            left  = 1;
+            right = 2;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // Constant operands are patched with the constant table address when all blocks are lowered
+    struct Fixup {
+        int fIndex;
+        int FBCRegisterInstruction::*fField;
+        bool                          fReal;
+    };
+
+   private:
+    typedef std::vector<FBCRegisterInstruction> Code;
+
+    enum OperandKind { kCell, kConstant, kRegister, kImmediate };
+
+    struct Operand {
+        OperandKind fKind;
+        int         fValue;  // Heap index, index in the constant table, or immediate value
+    };
+
+    FBCRegisterCode<REAL>* fRes;
+
+    Code                                      fCode;
+    std::vector<Fixup>                        fFixups;
+    std::vector<Operand>                      fIntStack;
+    std::vector<Operand>                      fRealStack;
+    std::map<FBCBlockInstruction<REAL>*, int> fBlockStarts;
+    std::map<int, int>                        fIntConstants;
+    std::map<uint64_t, int>                   fRealConstants;
+
+    // Index of the last instruction if its result is the register on top of the stack, or -1
+    int  fLastResult;
+    bool fLastResultReal;
+    bool fFailed;
+
+    static Operand immediate(int value) { return {kImmediate, value}; }
+
+    std::vector<Operand>& getStack(bool real) { return (real) ? fRealStack : fIntStack; }
+
+    int getRegister(bool real, int pos)
+    {
+        if (real) {
+            fRes->fRealRegisters = std::max(fRes->fRealRegisters, pos + 1);
+            return fRes->fRealHeapSize + pos;
+        } else {
+            fRes->fIntRegisters = std::max(fRes->fIntRegisters, pos + 1);
+            return fRes->fIntHeapSize + pos;
+        }
+    }
+
+    Operand getConstant(int value)
+    {
+        if (fIntConstants.find(value) == fIntConstants.end()) {
+            fIntConstants[value] = int(fRes->fIntConstants.size());
+            fRes->fIntConstants.push_back(value);
+        }
+        return {kConstant, fIntConstants[value]};
+    }
+
+    Operand getConstant(REAL value)
+    {
+        uint64_t key = 0;
+        memcpy(&key, &value, sizeof(REAL));
+        if (fRealConstants.find(key) == fRealConstants.end()) {
+            fRealConstants[key] = int(fRes->fRealConstants.size());
+            fRes->fRealConstants.push_back(value);
+        }
+        return {kConstant, fRealConstants[key]};
+    }
+
+    Operand pop(bool real)
+    {
+        std::vector<Operand>& stack = getStack(real);
+        if (stack.empty()) {
+            fFailed = true;
+            return immediate(0);
+        }
+        Operand res = stack.back();
+        stack.pop_back();
+        return res;
+    }
+
+    int emit(int opcode, int dst, const Operand& src1, bool real1, const Operand& src2, bool real2)
+    {
+        int index = int(fCode.size());
+        fCode.push_back({opcode, dst, src1.fValue, src2.fValue});
+        if (src1.fKind == kConstant) {
+            fFixups.push_back({index, &FBCRegisterInstruction::fSrc1, real1});
+        }
+        if (src2.fKind == kConstant) {
+            fFixups.push_back({index, &FBCRegisterInstruction::fSrc2, real2});
+        }
+        fLastResult = -1;
+        return index;
+    }
+
+    // Emit an operation whose result is pushed on the stack
+    void emitResult(int opcode, bool real, const Operand& src1, bool real1, const Operand& src2,
+                    bool real2)
+    {
+        std::vector<Operand>& stack = getStack(real);
+        int                   dst   = getRegister(real, int(stack.size()));
+        fLastResult                 = emit(opcode, dst, src1, real1, src2, real2);
+        fLastResultReal             = real;
+        stack.push_back({kRegister, dst});
+    }
+
+    // Jump targets cannot be used to retarget the previous result
+    void bindLabel() { fLastResult = -1; }
+
+    void bindJump(int index)
+    {
+        fCode[index].fSrc2 = int(fCode.size()) - index;
+        bindLabel();
+    }
+
+    // Copy the value at position 'pos' of the stack in its register
+    void materialize(bool real, int pos)
+    {
+        Operand& op = getStack(real)[pos];
+        if (op.fKind != kRegister) {
+            int dst = getRegister(real, pos);
+            emit((real) ? FBCRegisterInstruction::kMoveReal : FBCRegisterInstruction::kMoveInt, dst,
+                 op, real, immediate(0), false);
+            op = {kRegister, dst};
+        }
+    }
+
+    // Load the fields in [begin, end) that are still on the stack, before they are written
+    void materialize(bool real, int begin, int end)
+    {
+        std::vector<Operand>& stack = getStack(real);
+        for (int pos = 0; pos < int(stack.size()); pos++) {
+            if (stack[pos].fKind == kCell && stack[pos].fValue >= begin &&
+                stack[pos].fValue < end) {
+                materialize(real, pos);
+            }
+        }
+    }
+
+    // Load all fields still on the stacks, before a control flow change
+    void materializeAll()
+    {
+        materialize(false, INT32_MIN, INT32_MAX);
+        materialize(true, INT32_MIN, INT32_MAX);
+    }
+
+    void compileStore(bool real, int offset)
+    {
+        Operand value = pop(real);
+        materialize(real, offset, offset + 1);
+        if (value.fKind == kRegister && fLastResult == int(fCode.size()) - 1 &&
+            fLastResultReal == real && fCode.back().fDst == value.fValue) {
+            // The value is directly computed in the field
+            fCode.back().fDst = offset;
+            fLastResult       = -1;
+        } else {
+            emit((real) ? FBCRegisterInstruction::kMoveReal : FBCRegisterInstruction::kMoveInt,
+                 offset, value, real, immediate(0), false);
+        }
+    }
+
+    void compileLoadIndexed(bool real, int offset)
+    {
+        Operand index = pop(false);
+        if (index.fKind == kConstant) {
+            getStack(real).push_back({kCell, offset + fRes->fIntConstants[index.fValue]});
+        } else {
+            emitResult((real) ? FBCRegisterInstruction::kLoadIndexedReal
+                              : FBCRegisterInstruction::kLoadIndexedInt,
+                       real, immediate(offset), false, index, false);
+        }
+    }
+
+    void compileStoreIndexed(bool real, int offset, int size)
+    {
+        Operand index = pop(false);
+        if (index.fKind == kConstant) {
+            compileStore(real, offset + fRes->fIntConstants[index.fValue]);
+        } else {
+            Operand value = pop(real);
+            if (size > 0) {
+                materialize(real, offset, offset + size);
+            } else {
+                materialize(real, INT32_MIN, INT32_MAX);
+            }
+            emit((real) ? FBCRegisterInstruction::kStoreIndexedReal
+                        : FBCRegisterInstruction::kStoreIndexedInt,
+                 offset, value, real, index, false);
+        }
+    }
+
+    // Math operations on the stack : the left operand is on top
+    void compileOperation(FBCInstruction::Opcode op)
+    {
+        bool real_op  = isRealOperand(op);
+        bool real_res = FBCInstruction::isRealType(op);
+        if (FBCInstruction::isMath(op)) {
+            Operand v1 = pop(real_op);
+            Operand v2 = pop(real_op);
+            emitResult(FBCRegisterInstruction::kAddReal + (op - FBCInstruction::kAddReal), real_res,
+                       v1, real_op, v2, real_op);
+        } else if ((op >= FBCInstruction::kAbs) && (op <= FBCInstruction::kIsinff)) {
+            Operand v1 = pop(real_op);
+            emitResult(FBCRegisterInstruction::kAbs + (op - FBCInstruction::kAbs), real_res, v1,
+                       real_op, immediate(0), false);
+        } else {
+            Operand v1 = pop(real_op);
+            Operand v2 = pop(real_op);
+            emitResult(FBCRegisterInstruction::kAtan2f + (op - FBCInstruction::kAtan2f), real_res,
+                       v1, real_op, v2, real_op);
+        }
+    }
+
+    // The heap and value variants of the math operations are lowered as the pushes of their
+    // operands followed by the stack operation, returns false for other instructions
+    bool compileMath(FBCBasicInstruction<REAL>* inst)
+    {
+        FBCInstruction::Opcode base;
+        int                    left;
+        int                    right;
+        if (!decodeMath(inst->fOpcode, base, left, right)) {
+            return false;
+        }
+
+        // The right operand is pushed first
+        bool                  real  = isRealOperand(base);
+        std::vector<Operand>& stack = getStack(real);
+        if (right == 1) {
+            stack.push_back({kCell, (left == 1) ? inst->fOffset2 : inst->fOffset1});
+        } else if (right == 2) {
+            stack.push_back((real) ? getConstant(inst->fRealValue) : getConstant(inst->fIntValue));
+        }
+        if (left == 1) {
+            stack.push_back({kCell, inst->fOffset1});
+        } else if (left == 2) {
+            stack.push_back((real) ? getConstant(inst->fRealValue) : getConstant(inst->fIntValue));
+        }
+        compileOperation(base);
+        return true;
+    }
+
+    void compileChoice(FBCBasicInstruction<REAL>* inst)
+    {
+        Operand cond = pop(false);
+        materializeAll();
+
+        bool                  select = inst->fOpcode != FBCInstruction::kIf;
+        bool                  real   = inst->fOpcode == FBCInstruction::kSelectReal;
+        std::vector<Operand>& stack  = getStack(real);
+        int                   pos    = int(stack.size());
+        int                   to_else =
+            emit(FBCRegisterInstruction::kJumpIfZero, 0, cond, false, immediate(0), false);
+
+        compileBranch(inst->fBranch1, select, real, pos);
+        if (select || (inst->fBranch2 && inst->fBranch2->fInstructions.size() > 1)) {
+            int to_end =
+                emit(FBCRegisterInstruction::kJump, 0, immediate(0), false, immediate(0), false);
+            bindJump(to_else);
+            compileBranch(inst->fBranch2, select, real, pos);
+            bindJump(to_end);
+        } else {
+            bindJump(to_else);
+        }
+
+        if (select) {
+            stack.push_back({kRegister, getRegister(real, pos)});
+        }
+    }
+
+    // Compile a branch of a choice, the value of a select is moved in the register at 'pos'
+    void compileBranch(FBCBlockInstruction<REAL>* block, bool select, bool real, int pos)
+    {
+        size_t int_size  = fIntStack.size();
+        size_t real_size = fRealStack.size();
+        if (block) {
+            compileBlock(block, false);
+        }
+        if (select) {
+            std::vector<Operand>& stack = getStack(real);
+            if (int(stack.size()) != pos + 1) {
+                fFailed = true;
+                return;
+            }
+            materialize(real, pos);
+            stack.pop_back();
+        }
+        fFailed = fFailed || (fIntStack.size() != int_size) || (fRealStack.size() != real_size);
+    }
+
+    void compileLoop(FBCBasicInstruction<REAL>* inst)
+    {
+        materializeAll();
+        size_t int_size  = fIntStack.size();
+        size_t real_size = fRealStack.size();
+        if (!inst->fBranch1 || !inst->fBranch2) {
+            fFailed = true;
+            return;
+        }
+        // Loop variable declaration, then the loop body that ends with a kCondBranch
+        compileBlock(inst->fBranch1, false);
+        compileBlock(inst->fBranch2, false);
+        fFailed = fFailed || (fIntStack.size() != int_size) || (fRealStack.size() != real_size);
+    }
+
+    void compileCondBranch(FBCBasicInstruction<REAL>* inst)
+    {
+        Operand cond = pop(false);
+        materializeAll();
+        auto start = fBlockStarts.find(inst->fBranch1);
+        if (start == fBlockStarts.end()) {
+            fFailed = true;
+            return;
+        }
+        int index = int(fCode.size());
+        emit(FBCRegisterInstruction::kJumpIfNotZero, 0, cond, false,
+             immediate(start->second - index), false);
+    }
+
+    void compileInstruction(FBCBasicInstruction<REAL>* inst)
+    {
+        typedef FBCInstruction I;
+
+        switch (inst->fOpcode) {
+            case I::kRealValue:
+                fRealStack.push_back(getConstant(inst->fRealValue));
+                break;
+            case I::kInt32Value:
+                fIntStack.push_back(getConstant(inst->fIntValue));
+                break;
+
+            case I::kLoadReal:
+                fRealStack.push_back({kCell, inst->fOffset1});
+                break;
+            case I::kLoadInt:
+                fIntStack.push_back({kCell, inst->fOffset1});
+                break;
+            case I::kStoreReal:
+                compileStore(true, inst->fOffset1);
+                break;
+            case I::kStoreInt:
+                compileStore(false, inst->fOffset1);
+                break;
+            case I::kStoreRealValue:
+                fRealStack.push_back(getConstant(inst->fRealValue));
+                compileStore(true, inst->fOffset1);
+                break;
+            case I::kStoreIntValue:
+                fIntStack.push_back(getConstant(inst->fIntValue));
+                compileStore(false, inst->fOffset1);
+                break;
+            case I::kLoadIndexedReal:
+                compileLoadIndexed(true, inst->fOffset1);
+                break;
+            case I::kLoadIndexedInt:
+                compileLoadIndexed(false, inst->fOffset1);
+                break;
+            case I::kStoreIndexedReal:
+                compileStoreIndexed(true, inst->fOffset1, inst->fOffset2);
+                break;
+            case I::kStoreIndexedInt:
+                compileStoreIndexed(false, inst->fOffset1, inst->fOffset2);
+                break;
+            case I::kMoveReal:
+                fRealStack.push_back({kCell, inst->fOffset2});
+                compileStore(true, inst->fOffset1);
+                break;
+            case I::kMoveInt:
+                fIntStack.push_back({kCell, inst->fOffset2});
+                compileStore(false, inst->fOffset1);
+                break;
+            case I::kPairMoveReal:
+            case I::kPairMoveInt: {
+                bool real = inst->fOpcode == I::kPairMoveReal;
+                materialize(real, inst->fOffset1, inst->fOffset1 + 1);
+                materialize(real, inst->fOffset2, inst->fOffset2 + 1);
+                emit((real) ? FBCRegisterInstruction::kPairMoveReal
+                            : FBCRegisterInstruction::kPairMoveInt,
+                     0, immediate(inst->fOffset1), false, immediate(inst->fOffset2), false);
+                break;
+            }
+            case I::kBlockPairMoveReal:
+            case I::kBlockPairMoveInt: {
+                bool real = inst->fOpcode == I::kBlockPairMoveReal;
+                materialize(real, inst->fOffset1, inst->fOffset2 + 1);
+                emit((real) ? FBCRegisterInstruction::kBlockPairMoveReal
+                            : FBCRegisterInstruction::kBlockPairMoveInt,
+                     0, immediate(inst->fOffset1), false, immediate(inst->fOffset2), false);
+                break;
+            }
+            case I::kBlockShiftReal:
+            case I::kBlockShiftInt: {
+                bool real = inst->fOpcode == I::kBlockShiftReal;
+                materialize(real, inst->fOffset2, inst->fOffset1 + 1);
+                emit((real) ? FBCRegisterInstruction::kBlockShiftReal
+                            : FBCRegisterInstruction::kBlockShiftInt,
+                     0, immediate(inst->fOffset1), false, immediate(inst->fOffset2), false);
+                break;
+            }
+            case I::kLoadInput: {
+                Operand index = pop(false);
+                emitResult(FBCRegisterInstruction::kLoadInput, true, immediate(inst->fOffset1),
+                           false, index, false);
+                break;
+            }
+            case I::kStoreOutput: {
+                Operand index = pop(false);
+                Operand value = pop(true);
+                emit(FBCRegisterInstruction::kStoreOutput, inst->fOffset1, value, true, index,
+                     false);
+                break;
+            }
+
+            case I::kCastRealHeap:
+                fIntStack.push_back({kCell, inst->fOffset1});
+                // Fall through
+            case I::kCastReal: {
+                Operand value = pop(false);
+                emitResult(FBCRegisterInstruction::kCastReal, true, value, false, immediate(0),
+                           false);
+                break;
+            }
+            case I::kCastIntHeap:
+                fRealStack.push_back({kCell, inst->fOffset1});
+                // Fall through
+            case I::kCastInt: {
+                Operand value = pop(true);
+                emitResult(FBCRegisterInstruction::kCastInt, false, value, true, immediate(0),
+                           false);
+                break;
+            }
+            case I::kBitcastInt: {
+                Operand value = pop(true);
+                emitResult(FBCRegisterInstruction::kBitcastInt, false, value, true, immediate(0),
+                           false);
+                break;
+            }
+            case I::kBitcastReal: {
+                Operand value = pop(false);
+                emitResult(FBCRegisterInstruction::kBitcastReal, true, value, false,
+                           immediate(0), false);
+                break;
+            }
+
+            case I::kLoop:
+                compileLoop(inst);
+                break;
+            case I::kIf:
+            case I::kSelectReal:
+            case I::kSelectInt:
+                compileChoice(inst);
+                break;
+            case I::kCondBranch:
+                compileCondBranch(inst);
+                break;
+            case I::kNop:
+                break;
+
+            default:
+                // BlockStore, soundfiles and UI instructions are not lowered
+                fFailed = !compileMath(inst);
+                break;
+        }
+    }
+
+    // A sub-block ends with its kReturn, 'top' is true for the block given to the executor
+    void compileBlock(FBCBlockInstruction<REAL>* block, bool top)
+    {
+        fBlockStarts[block] = int(fCode.size());
+        bindLabel();
+        for (const auto& inst : block->fInstructions) {
+            if (fFailed || inst->fOpcode == FBCInstruction::kReturn) break;
+            compileInstruction(inst);
+        }
+        if (top) {
+            emit(FBCRegisterInstruction::kReturn, 0, immediate(0), false, immediate(0), false);
+        }
+    }
+
+   public:
+    FBCRegisterCompiler(FBCRegisterCode<REAL>* res) : fRes(res) {}
+
+    void compile(FBCBlockInstruction<REAL>* block)
+    {
+        fCode.clear();
+        fFixups.clear();
+        fIntStack.clear();
+        fRealStack.clear();
+        fBlockStarts.clear();
+        fLastResult = -1;
+        fFailed     = false;
+        compileBlock(block, true);
+        if (!fFailed) {
+            fRes->fBlocks[block] = fCode;
+            for (const auto& fixup : fFixups) {
+                fRes->fFixups.push_back(std::make_pair(&fRes->fBlocks[block], fixup));
+            }
+        }
+    }
+};
+
+/*
+ Lowered code of the blocks of a factory, shared by all its instances.
+*/
+template <class REAL>
+struct FBCRegisterCode {
+    typedef std::vector<FBCRegisterInstruction> Code;
+
+    std::map<FBCBlockInstruction<REAL>*, Code> fBlocks;
+
+    // Sizes of the DSP fields, registers and constants follow them in the heaps
+    int fIntHeapSize;
+    int fRealHeapSize;
+    int fIntRegisters;
+    int fRealRegisters;
+
+    std::vector<int>  fIntConstants;
+    std::vector<REAL> fRealConstants;
+
+    std::vector<std::pair<Code*, typename FBCRegisterCompiler<REAL>::Fixup>> fFixups;
+
+    FBCRegisterCode(int int_heap_size, int real_heap_size,
+                    const std::vector<FBCBlockInstruction<REAL>*>& blocks)
+        : fIntHeapSize(int_heap_size),
+          fRealHeapSize(real_heap_size),
+          fIntRegisters(0),
+          fRealRegisters(0)
+    {
+        FBCRegisterCompiler<REAL> compiler(this);
+        for (const auto& block : blocks) {
+            compiler.compile(block);
+        }
+        // Constants are allocated after the registers
+        for (const auto& it : fFixups) {
+            (*it.first)[it.second.fIndex].*(it.second.fField) +=
+                (it.second.fReal) ? fRealHeapSize + fRealRegisters : fIntHeapSize + fIntRegisters;
+        }
+        fFixups.clear();
+    }
+
+    int getIntHeapSize() { return fIntHeapSize + fIntRegisters + int(fIntConstants.size()); }
+    int getRealHeapSize() { return fRealHeapSize + fRealRegisters + int(fRealConstants.size()); }
+
+    // Copy the constants in the heaps of an instance
+    void initHeaps(int* int_heap, REAL* real_heap)
+    {
+        std::copy(fIntConstants.begin(), fIntConstants.end(),
+                  int_heap + fIntHeapSize + fIntRegisters);
+        std::copy(fRealConstants.begin(), fRealConstants.end(),
+                  real_heap + fRealHeapSize + fRealRegisters);
+    }
+
+    // Returns the lowered code of a block, or nullptr if it has to be executed by the interpreter
+    const FBCRegisterInstruction* getCode(FBCBlockInstruction<REAL>* block)
+    {
+        auto it = fBlocks.find(block);
+        return (it != fBlocks.end()) ? it->second.data() : nullptr;
+    }
+
+    void write(std::ostream* out)
+    {
+        for (const auto& it : fBlocks) {
+            *out << "block size " << it.second.size() << std::endl;
+            for (const auto& inst : it.second) {
+                *out << "opcode " << inst.fOpcode << " "
+                     << gFBCRegisterInstructionTable[inst.fOpcode] << " dst " << inst.fDst
+                     << " src1 " << inst.fSrc1 << " src2 " << inst.fSrc2 << std::endl;
+            }
+        }
+    }
+};
+
+#if defined(_WIN32)
+#define regLabel(op) case FBCRegisterInstruction::op
+#define regDispatch() continue
+#else
+#define regLabel(op) do_##op
+#define regDispatch() goto* dispatch_table[it->fOpcode]
+#endif
+
+#define regNext()      \
+    {                  \
+        it++;          \
+        regDispatch(); \
+    }
+
+#define regJump(offset) \
+    {                   \
+        it += (offset); \
+        regDispatch();  \
+    }
+
+// Register based FBC executor, blocks that are not lowered are executed by the stack interpreter
+template <class REAL, int TRACE>
+class FBCRegisterInterpreter : public FBCInterpreter<REAL, TRACE> {
+   protected:
+    FBCRegisterCode<REAL>* fCode;
+
+    // The lowered code is built once and shared by all instances of the factory
+    static FBCRegisterCode<REAL>* getRegisterCode(interpreter_dsp_factory_aux<REAL, TRACE>* factory)
+    {
+        std::lock_guard<std::mutex> lock(factory->fCodeMutex);
+        if (!factory->fRegisterCode) {
+            std::vector<FBCBlockInstruction<REAL>*> blocks = {
+                factory->fStaticInitBlock, factory->fInitBlock,    factory->fResetUIBlock,
+                factory->fClearBlock,      factory->fComputeBlock, factory->fComputeDSPBlock};
+            factory->fRegisterCode =
+                new FBCRegisterCode<REAL>(factory->fIntHeapSize, factory->fRealHeapSize, blocks);
+        }
+        return factory->fRegisterCode;
+    }
+
+    void executeCode(const FBCRegisterInstruction* it)
+    {
+        int*   ih      = this->fIntHeap;
+        REAL*  rh      = this->fRealHeap;
+        REAL** inputs  = this->fInputs;
+        REAL** outputs = this->fOutputs;
+
+#if defined(_WIN32)
+        while (true) {
+            switch (it->fOpcode) {
+#else
+        static void* dispatch_table[] = {
+
+            // Memory
+            &&do_kMoveReal, &&do_kMoveInt, &&do_kLoadIndexedReal, &&do_kLoadIndexedInt,
+            &&do_kStoreIndexedReal, &&do_kStoreIndexedInt, &&do_kPairMoveReal, &&do_kPairMoveInt,
+            &&do_kBlockPairMoveReal, &&do_kBlockPairMoveInt, &&do_kBlockShiftReal,
+            &&do_kBlockShiftInt, &&do_kLoadInput, &&do_kStoreOutput,
+
+            // Cast/Bitcast
+            &&do_kCastReal, &&do_kCastInt, &&do_kBitcastInt, &&do_kBitcastReal,
+
+            // Standard math
+            &&do_kAddReal, &&do_kAddInt, &&do_kSubReal, &&do_kSubInt, &&do_kMultReal, &&do_kMultInt,
+            &&do_kDivReal, &&do_kDivInt, &&do_kRemReal, &&do_kRemInt, &&do_kLshInt, &&do_kARshInt,
+            &&do_kLRshInt, &&do_kGTInt, &&do_kLTInt, &&do_kGEInt, &&do_kLEInt, &&do_kEQInt,
+            &&do_kNEInt, &&do_kGTReal, &&do_kLTReal, &&do_kGEReal, &&do_kLEReal, &&do_kEQReal,
+            &&do_kNEReal, &&do_kANDInt, &&do_kORInt, &&do_kXORInt,
+
+            // Extended unary math
+            &&do_kAbs, &&do_kAbsf, &&do_kAcosf, &&do_kAcoshf, &&do_kAsinf, &&do_kAsinhf,
+            &&do_kAtanf, &&do_kAtanhf, &&do_kCeilf, &&do_kCosf, &&do_kCoshf, &&do_kExpf,
+            &&do_kFloorf, &&do_kLogf, &&do_kLog10f, &&do_kRintf, &&do_kRoundf, &&do_kSinf,
+            &&do_kSinhf, &&do_kSqrtf, &&do_kTanf, &&do_kTanhf, &&do_kIsnanf, &&do_kIsinff,
+
+            // Extended binary math
+            &&do_kAtan2f, &&do_kFmodf, &&do_kPowf, &&do_kMax, &&do_kMaxf, &&do_kMin, &&do_kMinf,
+            &&do_kCopysignf,
+
+            // Control
+            &&do_kJump, &&do_kJumpIfZero, &&do_kJumpIfNotZero, &&do_kReturn};
+
+        regDispatch();
+#endif
+
+    // Memory
+    regLabel(kMoveReal) : {
+        rh[it->fDst] = rh[it->fSrc1];
+        regNext();
+    }
+
+    regLabel(kMoveInt) : {
+        ih[it->fDst] = ih[it->fSrc1];
+        regNext();
+    }
+
+    regLabel(kLoadIndexedReal) : {
+        rh[it->fDst] = rh[it->fSrc1 + ih[it->fSrc2]];
+        regNext();
+    }
+
+    regLabel(kLoadIndexedInt) : {
+        ih[it->fDst] = ih[it->fSrc1 + ih[it->fSrc2]];
+        regNext();
+    }
+
+    regLabel(kStoreIndexedReal) : {
+        rh[it->fDst + ih[it->fSrc2]] = rh[it->fSrc1];
+        regNext();
+    }
+
+    regLabel(kStoreIndexedInt) : {
+        ih[it->fDst + ih[it->fSrc2]] = ih[it->fSrc1];
+        regNext();
+    }
+
+    regLabel(kPairMoveReal) : {
+        rh[it->fSrc1] = rh[it->fSrc1 - 1];
+        rh[it->fSrc2] = rh[it->fSrc2 - 1];
+        regNext();
+    }
+
+    regLabel(kPairMoveInt) : {
+        ih[it->fSrc1] = ih[it->fSrc1 - 1];
+        ih[it->fSrc2] = ih[it->fSrc2 - 1];
+        regNext();
+    }
+
+    regLabel(kBlockPairMoveReal) : {
+        for (int i = it->fSrc1; i < it->fSrc2; i += 2) {
+            rh[i + 1] = rh[i];
+        }
+        regNext();
+    }
+
+    regLabel(kBlockPairMoveInt) : {
+        for (int i = it->fSrc1; i < it->fSrc2; i += 2) {
+            ih[i + 1] = ih[i];
+        }
+        regNext();
+    }
+
+    regLabel(kBlockShiftReal) : {
+        for (int i = it->fSrc1; i > it->fSrc2; i -= 1) {
+            rh[i] = rh[i - 1];
+        }
+        regNext();
+    }
+
+    regLabel(kBlockShiftInt) : {
+        for (int i = it->fSrc1; i > it->fSrc2; i -= 1) {
+            ih[i] = ih[i - 1];
+        }
+        regNext();
+    }
+
+    regLabel(kLoadInput) : {
+        rh[it->fDst] = inputs[it->fSrc1][ih[it->fSrc2]];
+        regNext();
+    }
+
+    regLabel(kStoreOutput) : {
+        outputs[it->fDst][ih[it->fSrc2]] = rh[it->fSrc1];
+        regNext();
+    }
+
+    // Cast/Bitcast
+    regLabel(kCastReal) : {
+        rh[it->fDst] = REAL(ih[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kCastInt) : {
+        ih[it->fDst] = int(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kBitcastInt) : {
+        REAL v = rh[it->fSrc1];
+        int  r = 0;
+        memcpy(&r, &v, sizeof(int));
+        ih[it->fDst] = r;
+        regNext();
+    }
+
+    regLabel(kBitcastReal) : {
+        int  v = ih[it->fSrc1];
+        REAL r = 0;
+        memcpy(&r, &v, sizeof(int));
+        rh[it->fDst] = r;
+        regNext();
+    }
+
+    // Standard math
+    regLabel(kAddReal) : {
+        rh[it->fDst] = rh[it->fSrc1] + rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kAddInt) : {
+        ih[it->fDst] = ih[it->fSrc1] + ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kSubReal) : {
+        rh[it->fDst] = rh[it->fSrc1] - rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kSubInt) : {
+        ih[it->fDst] = ih[it->fSrc1] - ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kMultReal) : {
+        rh[it->fDst] = rh[it->fSrc1] * rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kMultInt) : {
+        ih[it->fDst] = ih[it->fSrc1] * ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kDivReal) : {
+        rh[it->fDst] = rh[it->fSrc1] / rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kDivInt) : {
+        ih[it->fDst] = ih[it->fSrc1] / ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kRemReal) : {
+        rh[it->fDst] = std::remainder(rh[it->fSrc1], rh[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kRemInt) : {
+        ih[it->fDst] = ih[it->fSrc1] % ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kLshInt) : {
+        ih[it->fDst] = ih[it->fSrc1] << ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kARshInt) : {
+        ih[it->fDst] = ih[it->fSrc1] >> ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kLRshInt) : {
+        ih[it->fDst] = ih[it->fSrc1] >> ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kGTInt) : {
+        ih[it->fDst] = ih[it->fSrc1] > ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kLTInt) : {
+        ih[it->fDst] = ih[it->fSrc1] < ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kGEInt) : {
+        ih[it->fDst] = ih[it->fSrc1] >= ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kLEInt) : {
+        ih[it->fDst] = ih[it->fSrc1] <= ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kEQInt) : {
+        ih[it->fDst] = ih[it->fSrc1] == ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kNEInt) : {
+        ih[it->fDst] = ih[it->fSrc1] != ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kGTReal) : {
+        ih[it->fDst] = rh[it->fSrc1] > rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kLTReal) : {
+        ih[it->fDst] = rh[it->fSrc1] < rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kGEReal) : {
+        ih[it->fDst] = rh[it->fSrc1] >= rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kLEReal) : {
+        ih[it->fDst] = rh[it->fSrc1] <= rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kEQReal) : {
+        ih[it->fDst] = rh[it->fSrc1] == rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kNEReal) : {
+        ih[it->fDst] = rh[it->fSrc1] != rh[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kANDInt) : {
+        ih[it->fDst] = ih[it->fSrc1] & ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kORInt) : {
+        ih[it->fDst] = ih[it->fSrc1] | ih[it->fSrc2];
+        regNext();
+    }
+
+    regLabel(kXORInt) : {
+        ih[it->fDst] = ih[it->fSrc1] ^ ih[it->fSrc2];
+        regNext();
+    }
+
+    // Extended unary math
+    regLabel(kAbs) : {
+        ih[it->fDst] = std::abs(ih[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kAbsf) : {
+        rh[it->fDst] = std::fabs(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kAcosf) : {
+        rh[it->fDst] = std::acos(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kAcoshf) : {
+        rh[it->fDst] = std::acosh(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kAsinf) : {
+        rh[it->fDst] = std::asin(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kAsinhf) : {
+        rh[it->fDst] = std::asinh(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kAtanf) : {
+        rh[it->fDst] = std::atan(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kAtanhf) : {
+        rh[it->fDst] = std::atanh(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kCeilf) : {
+        rh[it->fDst] = std::ceil(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kCosf) : {
+        rh[it->fDst] = std::cos(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kCoshf) : {
+        rh[it->fDst] = std::cosh(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kExpf) : {
+        rh[it->fDst] = std::exp(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kFloorf) : {
+        rh[it->fDst] = std::floor(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kLogf) : {
+        rh[it->fDst] = std::log(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kLog10f) : {
+        rh[it->fDst] = std::log10(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kRintf) : {
+        rh[it->fDst] = std::rint(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kRoundf) : {
+        rh[it->fDst] = std::round(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kSinf) : {
+        rh[it->fDst] = std::sin(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kSinhf) : {
+        rh[it->fDst] = std::sinh(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kSqrtf) : {
+        rh[it->fDst] = std::sqrt(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kTanf) : {
+        rh[it->fDst] = std::tan(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kTanhf) : {
+        rh[it->fDst] = std::tanh(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kIsnanf) : {
+        ih[it->fDst] = std::isnan(rh[it->fSrc1]);
+        regNext();
+    }
+
+    regLabel(kIsinff) : {
+        ih[it->fDst] = std::isinf(rh[it->fSrc1]);
+        regNext();
+    }
+
+    // Extended binary math
+    regLabel(kAtan2f) : {
+        rh[it->fDst] = std::atan2(rh[it->fSrc1], rh[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kFmodf) : {
+        rh[it->fDst] = std::fmod(rh[it->fSrc1], rh[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kPowf) : {
+        rh[it->fDst] = std::pow(rh[it->fSrc1], rh[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kMax) : {
+        ih[it->fDst] = std::max(ih[it->fSrc1], ih[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kMaxf) : {
+        rh[it->fDst] = std::max(rh[it->fSrc1], rh[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kMin) : {
+        ih[it->fDst] = std::min(ih[it->fSrc1], ih[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kMinf) : {
+        rh[it->fDst] = std::min(rh[it->fSrc1], rh[it->fSrc2]);
+        regNext();
+    }
+
+    regLabel(kCopysignf) : {
+        rh[it->fDst] = std::copysign(rh[it->fSrc1], rh[it->fSrc2]);
+        regNext();
+    }
+    // Control
+    regLabel(kJump) : {
+        regJump(it->fSrc2);
+    }
+
+    regLabel(kJumpIfZero) : {
+        if (ih[it->fSrc1]) {
+            regNext();
+        } else {
+            regJump(it->fSrc2);
+        }
+    }
+
+    regLabel(kJumpIfNotZero) : {
+        if (ih[it->fSrc1]) {
+            regJump(it->fSrc2);
+        } else {
+            regNext();
+        }
+    }
+
+    regLabel(kReturn) : {
+        return;
+    }
+
+#if defined(_WIN32)
+                default:
+                    faustassert(false);
+                    return;
+            }
+        }
+#endif
+    }
+
+   public:
+    FBCRegisterInterpreter(interpreter_dsp_factory_aux<REAL, TRACE>* factory)
+        : FBCInterpreter<REAL, TRACE>(factory, getRegisterCode(factory)->getIntHeapSize(),
+                                      getRegisterCode(factory)->getRealHeapSize())
+    {
+        fCode = factory->fRegisterCode;
+        fCode->initHeaps(this->fIntHeap, this->fRealHeap);
+    }
+
+    virtual ~FBCRegisterInterpreter() {}
+
+    virtual void executeBlock(FBCBlockInstruction<REAL>* block)
+    {
+        const FBCRegisterInstruction* code = fCode->getCode(block);
+        if (code) {
+            executeCode(code);
+        } else {
+            FBCInterpreter<REAL, TRACE>::executeBlock(block);
+        }
+    }
+};
+
+#undef regLabel
+#undef regDispatch
+#undef regNext
+#undef regJump
+
+#endif
@@ -0,0 +1,1101 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+// Generated by fbc_stencils.py, do not edit
+
+#ifndef _FBC_STENCILS_H
+#define _FBC_STENCILS_H
+
+/*
+ Stencils of the FBC template compiler: the machine code of each register code
+ instruction (see FBCRegisterInstruction), followed by the function entry and the
+ moves of constants. The holes of a stencil are patched with its operands.
+*/
+
+#define FBC_STENCILS(S) \
+    S(kMoveReal) \
+    S(kMoveInt) \
+    S(kLoadIndexedReal) \
+    S(kLoadIndexedInt) \
+    S(kStoreIndexedReal) \
+    S(kStoreIndexedInt) \
+    S(kPairMoveReal) \
+    S(kPairMoveInt) \
+    S(kBlockPairMoveReal) \
+    S(kBlockPairMoveInt) \
+    S(kBlockShiftReal) \
+    S(kBlockShiftInt) \
+    S(kLoadInput) \
+    S(kStoreOutput) \
+    S(kCastReal) \
+    S(kCastInt) \
+    S(kBitcastInt) \
+    S(kBitcastReal) \
+    S(kAddReal) \
+    S(kAddInt) \
+    S(kSubReal) \
+    S(kSubInt) \
+    S(kMultReal) \
+    S(kMultInt) \
+    S(kDivReal) \
+    S(kDivInt) \
+    S(kRemReal) \
+    S(kRemInt) \
+    S(kLshInt) \
+    S(kARshInt) \
+    S(kLRshInt) \
+    S(kGTInt) \
+    S(kLTInt) \
+    S(kGEInt) \
+    S(kLEInt) \
+    S(kEQInt) \
+    S(kNEInt) \
+    S(kGTReal) \
+    S(kLTReal) \
+    S(kGEReal) \
+    S(kLEReal) \
+    S(kEQReal) \
+    S(kNEReal) \
+    S(kANDInt) \
+    S(kORInt) \
+    S(kXORInt) \
+    S(kAbs) \
+    S(kAbsf) \
+    S(kAcosf) \
+    S(kAcoshf) \
+    S(kAsinf) \
+    S(kAsinhf) \
+    S(kAtanf) \
+    S(kAtanhf) \
+    S(kCeilf) \
+    S(kCosf) \
+    S(kCoshf) \
+    S(kExpf) \
+    S(kFloorf) \
+    S(kLogf) \
+    S(kLog10f) \
+    S(kRintf) \
+    S(kRoundf) \
+    S(kSinf) \
+    S(kSinhf) \
+    S(kSqrtf) \
+    S(kTanf) \
+    S(kTanhf) \
+    S(kIsnanf) \
+    S(kIsinff) \
+    S(kAtan2f) \
+    S(kFmodf) \
+    S(kPowf) \
+    S(kMax) \
+    S(kMaxf) \
+    S(kMin) \
+    S(kMinf) \
+    S(kCopysignf) \
+    S(kJump) \
+    S(kJumpIfZero) \
+    S(kJumpIfNotZero) \
+    S(kReturn) \
+    S(kEnter) \
+    S(kMoveIntValue) \
+    S(kMoveRealValue) \
+
+enum FBCStencilPatchKind {
+    kPatchAbs32,
+    kPatchAbs64,
+    kPatchRel32,
+    kPatchMovw0,
+    kPatchMovw16,
+    kPatchMovw32,
+    kPatchMovw48,
+    kPatchBranch26,
+};
+
+enum FBCStencilHole {
+    kHoleIntDst,
+    kHoleIntSrc1,
+    kHoleIntSrc2,
+    kHoleRealDst,
+    kHoleRealSrc1,
+    kHoleRealSrc2,
+    kHoleChannelDst,
+    kHoleChannelSrc1,
+    kHoleValue,
+    kHoleFunction,
+    kHoleTarget,
+};
+
+struct FBCStencilPatch {
+    int fOffset;  // In the stencil code
+    int fKind;
+    int fHole;
+    int fAddend;
+};
+
+struct FBCStencil {
+    int fCode;  // Start in the code table
+    int fSize;
+    int fPatches;  // Start in the patches table
+    int fPatchCount;
+};
+
+#if defined(__linux__) && defined(__x86_64__)
+
+#define FBC_STENCILS_TARGET "x86_64"
+
+static const unsigned char gFBCStencilCodeFloat[] = {
+    0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x63, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x84, 0x00, 0x00, 0x00,
+    0x00, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0x63, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x8b, 0x8c, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x63, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0xf3, 0x41, 0x0f, 0x11, 0x84, 0x84, 0x00, 0x00, 0x00, 0x00, 0x48, 0x63, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x89, 0x8c, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41,
+    0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00,
+    0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11,
+    0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8d,
+    0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8d, 0x94, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39,
+    0xd1, 0x73, 0x0b, 0x8b, 0x01, 0x89, 0x41, 0x04, 0x48, 0x83, 0xc1, 0x08, 0xeb, 0xf0, 0x48, 0x8d,
+    0x8b, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8d, 0x93, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39, 0xd1, 0x73,
+    0x0b, 0x8b, 0x01, 0x89, 0x41, 0x04, 0x48, 0x83, 0xc1, 0x08, 0xeb, 0xf0, 0x49, 0x8d, 0x8c, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0x49, 0x8d, 0x94, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39, 0xd1, 0x76,
+    0x0b, 0x8b, 0x41, 0xfc, 0x89, 0x01, 0x48, 0x83, 0xe9, 0x04, 0xeb, 0xf0, 0x48, 0x8d, 0x8b, 0x00,
+    0x00, 0x00, 0x00, 0x48, 0x8d, 0x93, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39, 0xd1, 0x76, 0x0b, 0x8b,
+    0x41, 0xfc, 0x89, 0x01, 0x48, 0x83, 0xe9, 0x04, 0xeb, 0xf0, 0x49, 0x8b, 0x85, 0x00, 0x00, 0x00,
+    0x00, 0x48, 0x63, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x0f, 0x10, 0x04, 0x88, 0xf3, 0x41, 0x0f,
+    0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8b, 0x86, 0x00, 0x00, 0x00, 0x00, 0x48, 0x63,
+    0x8b, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3,
+    0x0f, 0x11, 0x04, 0x88, 0x0f, 0x57, 0xc0, 0xf3, 0x0f, 0x2a, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf3,
+    0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x2c, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x41, 0x8b, 0x84, 0x24, 0x00, 0x00, 0x00,
+    0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x41, 0x89, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3,
+    0x41, 0x0f, 0x58, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x03, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89,
+    0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3,
+    0x41, 0x0f, 0x5c, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x2b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89,
+    0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3,
+    0x41, 0x0f, 0x59, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xaf, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0xf3, 0x41, 0x0f, 0x5e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x99, 0xf7, 0xbb, 0x00, 0x00, 0x00,
+    0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00,
+    0x00, 0xf3, 0x41, 0x0f, 0x10, 0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00,
+    0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x99, 0xf7, 0xbb, 0x00, 0x00, 0x00, 0x00, 0x89, 0x93,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0xd3, 0xe0, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0xd3, 0xf8, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x9f, 0xc1, 0x89, 0x8b, 0x00,
+    0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x0f, 0x9c, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x9d, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00,
+    0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f,
+    0x9e, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9,
+    0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x94, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b,
+    0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x95, 0xc1,
+    0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0x31, 0xc9, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x97, 0xc1, 0x89, 0x8b,
+    0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9,
+    0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x97, 0xc1, 0x89, 0x8b, 0x00, 0x00,
+    0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x41, 0x0f,
+    0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x93, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00,
+    0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x41, 0x0f, 0x2e, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x93, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41,
+    0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x94, 0xc1, 0x0f, 0x9b, 0xc2, 0x20, 0xd1, 0x89, 0x8b, 0x00, 0x00, 0x00,
+    0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x41, 0x0f, 0x2e,
+    0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x95, 0xc1, 0x0f, 0x9a, 0xc2, 0x08, 0xd1, 0x89, 0x8b,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x23, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x33, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x89, 0xc1, 0xf7, 0xd9, 0x0f, 0x49, 0xc1, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x41, 0x8b, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0x25, 0xff, 0xff, 0xff, 0x7f, 0x41, 0x89, 0x84, 0x24, 0x00, 0x00,
+    0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0xf3, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00,
+    0x00, 0x00, 0xf3, 0x41, 0x0f, 0x51, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x11,
+    0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0x31, 0xc9, 0x0f, 0x2e, 0xc0, 0x0f, 0x9a, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x41, 0x8b,
+    0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x25, 0xff, 0xff, 0xff, 0x7f, 0x31, 0xc9, 0x3d, 0x00, 0x00,
+    0x80, 0x7f, 0x0f, 0x94, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc8, 0x0f, 0x4c, 0xc1, 0x89, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10,
+    0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x28, 0xd0, 0xf3, 0x0f, 0xc2, 0xd1, 0x01, 0x0f, 0x54,
+    0xca, 0x0f, 0x55, 0xd0, 0x0f, 0x56, 0xd1, 0xf3, 0x41, 0x0f, 0x11, 0x94, 0x24, 0x00, 0x00, 0x00,
+    0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc1, 0x0f,
+    0x4c, 0xc1, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00,
+    0x00, 0x00, 0xf3, 0x41, 0x0f, 0x10, 0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x28, 0xd1, 0xf3,
+    0x0f, 0xc2, 0xd0, 0x01, 0x0f, 0x54, 0xca, 0x0f, 0x55, 0xd0, 0x0f, 0x56, 0xd1, 0xf3, 0x41, 0x0f,
+    0x11, 0x94, 0x24, 0x00, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00, 0x00, 0x83, 0xbb, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x83, 0xbb, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, 0x5b, 0x5d, 0xc3, 0x55,
+    0x48, 0x89, 0xe5, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x48, 0x89, 0xfb, 0x49, 0x89, 0xf4,
+    0x49, 0x89, 0xd5, 0x49, 0x89, 0xce, 0xc7, 0x83, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x41, 0xc7, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const FBCStencilPatch gFBCStencilPatchesFloat[] = {
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {13, kPatchAbs32, kHoleRealSrc1, 0},
+    {23, kPatchAbs32, kHoleRealDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {10, kPatchAbs32, kHoleIntSrc1, 0},
+    {16, kPatchAbs32, kHoleIntDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {13, kPatchAbs32, kHoleRealSrc1, 0},
+    {23, kPatchAbs32, kHoleRealDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {9, kPatchAbs32, kHoleIntSrc1, 0},
+    {16, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, -4}, {16, kPatchAbs32, kHoleRealSrc1, 0},
+    {26, kPatchAbs32, kHoleRealSrc2, -4}, {36, kPatchAbs32, kHoleRealSrc2, 0}, {2, kPatchAbs32, kHoleIntSrc1, -4},
+    {8, kPatchAbs32, kHoleIntSrc1, 0}, {14, kPatchAbs32, kHoleIntSrc2, -4}, {20, kPatchAbs32, kHoleIntSrc2, 0},
+    {4, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs32, kHoleRealSrc2, 0}, {3, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {4, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs32, kHoleRealSrc2, 0},
+    {3, kPatchAbs32, kHoleIntSrc1, 0}, {10, kPatchAbs32, kHoleIntSrc2, 0}, {3, kPatchAbs32, kHoleChannelSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {25, kPatchAbs32, kHoleRealDst, 0}, {3, kPatchAbs32, kHoleChannelDst, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {20, kPatchAbs32, kHoleRealSrc1, 0}, {7, kPatchAbs32, kHoleIntSrc1, 0},
+    {17, kPatchAbs32, kHoleRealDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs32, kHoleIntDst, 0},
+    {4, kPatchAbs32, kHoleRealSrc1, 0}, {10, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleRealDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0},
+    {14, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0},
+    {14, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchAbs32, kHoleIntSrc2, 0},
+    {15, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchAbs32, kHoleIntSrc2, 0},
+    {15, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {22, kPatchAbs64, kHoleFunction, 0}, {38, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {9, kPatchAbs32, kHoleIntSrc2, 0}, {15, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc2, 0},
+    {8, kPatchAbs32, kHoleIntSrc1, 0}, {16, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc2, 0},
+    {8, kPatchAbs32, kHoleIntSrc1, 0}, {16, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {17, kPatchAbs32, kHoleRealSrc2, 0}, {26, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc2, 0},
+    {17, kPatchAbs32, kHoleRealSrc1, 0}, {26, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {17, kPatchAbs32, kHoleRealSrc2, 0}, {26, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc2, 0},
+    {17, kPatchAbs32, kHoleRealSrc1, 0}, {26, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {17, kPatchAbs32, kHoleRealSrc2, 0}, {31, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {17, kPatchAbs32, kHoleRealSrc2, 0}, {31, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntSrc2, 0}, {14, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntSrc2, 0}, {14, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntSrc2, 0}, {14, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {15, kPatchAbs32, kHoleIntDst, 0}, {4, kPatchAbs32, kHoleRealSrc1, 0}, {17, kPatchAbs32, kHoleRealDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs64, kHoleFunction, 0}, {28, kPatchAbs32, kHoleRealDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {20, kPatchAbs32, kHoleIntDst, 0}, {4, kPatchAbs32, kHoleRealSrc1, 0}, {25, kPatchAbs32, kHoleIntDst, 0},
+    {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0}, {43, kPatchAbs32, kHoleRealDst, 0},
+    {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0}, {43, kPatchAbs32, kHoleRealDst, 0},
+    {1, kPatchRel32, kHoleTarget, -4}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchRel32, kHoleTarget, -4},
+    {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchRel32, kHoleTarget, -4}, {2, kPatchAbs32, kHoleIntDst, 0},
+    {6, kPatchAbs32, kHoleValue, 0}, {4, kPatchAbs32, kHoleRealDst, 0}, {8, kPatchAbs32, kHoleValue, 0},
+};
+
+static const FBCStencil gFBCStencilsFloat[] = {
+    {0, 20, 0, 2}, {20, 12, 2, 2}, {32, 27, 4, 3}, {59, 20, 7, 3},
+    {79, 27, 10, 3}, {106, 20, 13, 3}, {126, 40, 16, 4}, {166, 24, 20, 4},
+    {190, 32, 24, 2}, {222, 30, 26, 2}, {252, 32, 28, 2}, {284, 30, 30, 2},
+    {314, 29, 32, 3}, {343, 29, 35, 3}, {372, 21, 38, 2}, {393, 16, 40, 2},
+    {409, 14, 42, 2}, {423, 14, 44, 2}, {437, 30, 46, 3}, {467, 18, 49, 3},
+    {485, 30, 52, 3}, {515, 18, 55, 3}, {533, 30, 58, 3}, {563, 19, 61, 3},
+    {582, 30, 64, 3}, {612, 19, 67, 3}, {631, 42, 70, 4}, {673, 19, 74, 3},
+    {692, 20, 77, 3}, {712, 20, 80, 3}, {712, 20, 80, 3}, {732, 23, 83, 3},
+    {755, 23, 86, 3}, {778, 23, 89, 3}, {801, 23, 92, 3}, {824, 23, 95, 3},
+    {847, 23, 98, 3}, {870, 30, 101, 3}, {900, 30, 104, 3}, {930, 30, 107, 3},
+    {960, 30, 110, 3}, {990, 35, 113, 3}, {1025, 35, 116, 3}, {1060, 18, 119, 3},
+    {1078, 18, 122, 3}, {1096, 18, 125, 3}, {1114, 19, 128, 2}, {1133, 21, 130, 2},
+    {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3},
+    {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3},
+    {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3},
+    {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3}, {1154, 32, 132, 3},
+    {1154, 32, 132, 3}, {1186, 20, 135, 2}, {1154, 32, 132, 3}, {1154, 32, 132, 3},
+    {1206, 24, 137, 2}, {1230, 29, 139, 2}, {631, 42, 70, 4}, {631, 42, 70, 4},
+    {631, 42, 70, 4}, {1259, 23, 141, 3}, {1282, 47, 144, 3}, {1329, 23, 147, 3},
+    {1352, 47, 150, 3}, {631, 42, 70, 4}, {1399, 5, 153, 1}, {1404, 13, 154, 2},
+    {1417, 13, 156, 2}, {1430, 9, 158, 0}, {1439, 23, 158, 0}, {1462, 10, 158, 2},
+    {1472, 12, 160, 2},
+};
+
+static const unsigned char gFBCStencilCodeDouble[] = {
+    0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x11, 0x84, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x63, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0xc4, 0x00, 0x00, 0x00,
+    0x00, 0xf2, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0x63, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x8b, 0x8c, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x63, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0xf2, 0x41, 0x0f, 0x11, 0x84, 0xc4, 0x00, 0x00, 0x00, 0x00, 0x48, 0x63, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x89, 0x8c, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41,
+    0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00,
+    0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x11,
+    0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8d,
+    0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8d, 0x94, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39,
+    0xd1, 0x73, 0x0d, 0x48, 0x8b, 0x01, 0x48, 0x89, 0x41, 0x08, 0x48, 0x83, 0xc1, 0x10, 0xeb, 0xee,
+    0x48, 0x8d, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8d, 0x93, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39,
+    0xd1, 0x73, 0x0b, 0x8b, 0x01, 0x89, 0x41, 0x04, 0x48, 0x83, 0xc1, 0x08, 0xeb, 0xf0, 0x49, 0x8d,
+    0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8d, 0x94, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39,
+    0xd1, 0x76, 0x0d, 0x48, 0x8b, 0x41, 0xf8, 0x48, 0x89, 0x01, 0x48, 0x83, 0xe9, 0x08, 0xeb, 0xee,
+    0x48, 0x8d, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8d, 0x93, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39,
+    0xd1, 0x76, 0x0b, 0x8b, 0x41, 0xfc, 0x89, 0x01, 0x48, 0x83, 0xe9, 0x04, 0xeb, 0xf0, 0x49, 0x8b,
+    0x85, 0x00, 0x00, 0x00, 0x00, 0x48, 0x63, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x0f, 0x10, 0x04,
+    0xc8, 0xf2, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8b, 0x86, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x63, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0xf2, 0x0f, 0x11, 0x04, 0xc8, 0x0f, 0x57, 0xc0, 0xf2, 0x0f, 0x2a, 0x83, 0x00,
+    0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+    0x2c, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x41, 0x8b, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x49, 0x89, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x58, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+    0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x03, 0x83, 0x00,
+    0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x5c, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+    0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x2b, 0x83, 0x00,
+    0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x59, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+    0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xaf, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x5e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41,
+    0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x99, 0xf7,
+    0xbb, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0xf2, 0x41, 0x0f, 0x11, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x99, 0xf7, 0xbb, 0x00, 0x00,
+    0x00, 0x00, 0x89, 0x93, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0xd3, 0xe0, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x00, 0x00,
+    0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0xd3, 0xf8, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x9f,
+    0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b,
+    0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x9c, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x9d, 0xc1, 0x89,
+    0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x9e, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x94, 0xc1, 0x89, 0x8b, 0x00,
+    0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x3b, 0x83, 0x00, 0x00, 0x00,
+    0x00, 0x0f, 0x95, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x66, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0x0f, 0x97, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00,
+    0x00, 0x00, 0x00, 0x31, 0xc9, 0x66, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f,
+    0x97, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00,
+    0x00, 0x00, 0x31, 0xc9, 0x66, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x93,
+    0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00,
+    0x00, 0x31, 0xc9, 0x66, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x93, 0xc1,
+    0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0x31, 0xc9, 0x66, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x94, 0xc1, 0x0f,
+    0x9b, 0xc2, 0x20, 0xd1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x66, 0x41, 0x0f, 0x2e, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0x0f, 0x95, 0xc1, 0x0f, 0x9a, 0xc2, 0x08, 0xd1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0x23, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00,
+    0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83, 0x00, 0x00,
+    0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x33, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x89, 0xc1, 0xf7, 0xd9, 0x0f, 0x49,
+    0xc1, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8b, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x0f, 0xba, 0xf0, 0x3f, 0x49, 0x89, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10,
+    0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xd0, 0xf2, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x51,
+    0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x11, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00,
+    0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc9, 0x66, 0x0f, 0x2e, 0xc0,
+    0x0f, 0x9a, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8b, 0x84, 0x24, 0x00, 0x00, 0x00,
+    0x00, 0x48, 0x0f, 0xba, 0xf0, 0x3f, 0x48, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x7f,
+    0x31, 0xc9, 0x48, 0x39, 0xd0, 0x0f, 0x94, 0xc1, 0x89, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x83,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc8, 0x0f, 0x4c, 0xc1, 0x89,
+    0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84, 0x24, 0x00, 0x00, 0x00, 0x00, 0xf2,
+    0x41, 0x0f, 0x10, 0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x28, 0xd0, 0xf2, 0x0f, 0xc2, 0xd1,
+    0x01, 0x0f, 0x54, 0xca, 0x0f, 0x55, 0xd0, 0x0f, 0x56, 0xd1, 0xf2, 0x41, 0x0f, 0x11, 0x94, 0x24,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x00, 0x00, 0x00, 0x00,
+    0x39, 0xc1, 0x0f, 0x4c, 0xc1, 0x89, 0x83, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x8c, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0f,
+    0x28, 0xd1, 0xf2, 0x0f, 0xc2, 0xd0, 0x01, 0x0f, 0x54, 0xca, 0x0f, 0x55, 0xd0, 0x0f, 0x56, 0xd1,
+    0xf2, 0x41, 0x0f, 0x11, 0x94, 0x24, 0x00, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00, 0x00, 0x83,
+    0xbb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x83, 0xbb, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, 0x5b,
+    0x5d, 0xc3, 0x55, 0x48, 0x89, 0xe5, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x48, 0x89, 0xfb,
+    0x49, 0x89, 0xf4, 0x49, 0x89, 0xd5, 0x49, 0x89, 0xce, 0xc7, 0x83, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x89, 0x84,
+    0x24, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const FBCStencilPatch gFBCStencilPatchesDouble[] = {
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {13, kPatchAbs32, kHoleRealSrc1, 0},
+    {23, kPatchAbs32, kHoleRealDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {10, kPatchAbs32, kHoleIntSrc1, 0},
+    {16, kPatchAbs32, kHoleIntDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {13, kPatchAbs32, kHoleRealSrc1, 0},
+    {23, kPatchAbs32, kHoleRealDst, 0}, {3, kPatchAbs32, kHoleIntSrc2, 0}, {9, kPatchAbs32, kHoleIntSrc1, 0},
+    {16, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, -8}, {16, kPatchAbs32, kHoleRealSrc1, 0},
+    {26, kPatchAbs32, kHoleRealSrc2, -8}, {36, kPatchAbs32, kHoleRealSrc2, 0}, {2, kPatchAbs32, kHoleIntSrc1, -4},
+    {8, kPatchAbs32, kHoleIntSrc1, 0}, {14, kPatchAbs32, kHoleIntSrc2, -4}, {20, kPatchAbs32, kHoleIntSrc2, 0},
+    {4, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs32, kHoleRealSrc2, 0}, {3, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {4, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs32, kHoleRealSrc2, 0},
+    {3, kPatchAbs32, kHoleIntSrc1, 0}, {10, kPatchAbs32, kHoleIntSrc2, 0}, {3, kPatchAbs32, kHoleChannelSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {25, kPatchAbs32, kHoleRealDst, 0}, {3, kPatchAbs32, kHoleChannelDst, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {20, kPatchAbs32, kHoleRealSrc1, 0}, {7, kPatchAbs32, kHoleIntSrc1, 0},
+    {17, kPatchAbs32, kHoleRealDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs32, kHoleIntDst, 0},
+    {4, kPatchAbs32, kHoleRealSrc1, 0}, {10, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleRealDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0},
+    {14, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0},
+    {14, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchAbs32, kHoleIntSrc2, 0},
+    {15, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {26, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchAbs32, kHoleIntSrc2, 0},
+    {15, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0},
+    {22, kPatchAbs64, kHoleFunction, 0}, {38, kPatchAbs32, kHoleRealDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {9, kPatchAbs32, kHoleIntSrc2, 0}, {15, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc2, 0},
+    {8, kPatchAbs32, kHoleIntSrc1, 0}, {16, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc2, 0},
+    {8, kPatchAbs32, kHoleIntSrc1, 0}, {16, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {10, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {18, kPatchAbs32, kHoleRealSrc2, 0}, {27, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc2, 0},
+    {18, kPatchAbs32, kHoleRealSrc1, 0}, {27, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {18, kPatchAbs32, kHoleRealSrc2, 0}, {27, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc2, 0},
+    {18, kPatchAbs32, kHoleRealSrc1, 0}, {27, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {18, kPatchAbs32, kHoleRealSrc2, 0}, {32, kPatchAbs32, kHoleIntDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {18, kPatchAbs32, kHoleRealSrc2, 0}, {32, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntSrc2, 0}, {14, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntSrc2, 0}, {14, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {8, kPatchAbs32, kHoleIntSrc2, 0}, {14, kPatchAbs32, kHoleIntDst, 0}, {2, kPatchAbs32, kHoleIntSrc1, 0},
+    {15, kPatchAbs32, kHoleIntDst, 0}, {4, kPatchAbs32, kHoleRealSrc1, 0}, {17, kPatchAbs32, kHoleRealDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {12, kPatchAbs64, kHoleFunction, 0}, {28, kPatchAbs32, kHoleRealDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealDst, 0}, {6, kPatchAbs32, kHoleRealSrc1, 0},
+    {21, kPatchAbs32, kHoleIntDst, 0}, {4, kPatchAbs32, kHoleRealSrc1, 0}, {33, kPatchAbs32, kHoleIntDst, 0},
+    {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0}, {43, kPatchAbs32, kHoleRealDst, 0},
+    {2, kPatchAbs32, kHoleIntSrc1, 0}, {8, kPatchAbs32, kHoleIntSrc2, 0}, {19, kPatchAbs32, kHoleIntDst, 0},
+    {6, kPatchAbs32, kHoleRealSrc1, 0}, {16, kPatchAbs32, kHoleRealSrc2, 0}, {43, kPatchAbs32, kHoleRealDst, 0},
+    {1, kPatchRel32, kHoleTarget, -4}, {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchRel32, kHoleTarget, -4},
+    {2, kPatchAbs32, kHoleIntSrc1, 0}, {9, kPatchRel32, kHoleTarget, -4}, {2, kPatchAbs32, kHoleIntDst, 0},
+    {6, kPatchAbs32, kHoleValue, 0}, {2, kPatchAbs64, kHoleValue, 0}, {14, kPatchAbs32, kHoleRealDst, 0},
+};
+
+static const FBCStencil gFBCStencilsDouble[] = {
+    {0, 20, 0, 2}, {20, 12, 2, 2}, {32, 27, 4, 3}, {59, 20, 7, 3},
+    {79, 27, 10, 3}, {106, 20, 13, 3}, {126, 40, 16, 4}, {166, 24, 20, 4},
+    {190, 34, 24, 2}, {224, 30, 26, 2}, {254, 34, 28, 2}, {288, 30, 30, 2},
+    {318, 29, 32, 3}, {347, 29, 35, 3}, {376, 21, 38, 2}, {397, 16, 40, 2},
+    {413, 14, 42, 2}, {427, 14, 44, 2}, {441, 30, 46, 3}, {471, 18, 49, 3},
+    {489, 30, 52, 3}, {519, 18, 55, 3}, {537, 30, 58, 3}, {567, 19, 61, 3},
+    {586, 30, 64, 3}, {616, 19, 67, 3}, {635, 42, 70, 4}, {677, 19, 74, 3},
+    {696, 20, 77, 3}, {716, 20, 80, 3}, {716, 20, 80, 3}, {736, 23, 83, 3},
+    {759, 23, 86, 3}, {782, 23, 89, 3}, {805, 23, 92, 3}, {828, 23, 95, 3},
+    {851, 23, 98, 3}, {874, 31, 101, 3}, {905, 31, 104, 3}, {936, 31, 107, 3},
+    {967, 31, 110, 3}, {998, 36, 113, 3}, {1034, 36, 116, 3}, {1070, 18, 119, 3},
+    {1088, 18, 122, 3}, {1106, 18, 125, 3}, {1124, 19, 128, 2}, {1143, 21, 130, 2},
+    {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3},
+    {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3},
+    {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3},
+    {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3}, {1164, 32, 132, 3},
+    {1164, 32, 132, 3}, {1196, 20, 135, 2}, {1164, 32, 132, 3}, {1164, 32, 132, 3},
+    {1216, 25, 137, 2}, {1241, 37, 139, 2}, {635, 42, 70, 4}, {635, 42, 70, 4},
+    {635, 42, 70, 4}, {1278, 23, 141, 3}, {1301, 47, 144, 3}, {1348, 23, 147, 3},
+    {1371, 47, 150, 3}, {635, 42, 70, 4}, {1418, 5, 153, 1}, {1423, 13, 154, 2},
+    {1436, 13, 156, 2}, {1449, 9, 158, 0}, {1458, 23, 158, 0}, {1481, 10, 158, 2},
+    {1491, 18, 160, 2},
+};
+
+#elif defined(__linux__) && defined(__aarch64__)
+
+#define FBC_STENCILS_TARGET "aarch64"
+
+static const unsigned char gFBCStencilCodeFloat[] = {
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x89, 0x02, 0x09, 0x8b, 0x20, 0x79, 0x6a, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b,
+    0x2b, 0x79, 0x6a, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x89, 0x02, 0x09, 0x8b, 0x20, 0x79, 0x2a, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b, 0x2b, 0x79, 0x2a, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x89, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x8a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa2, 0x00, 0x00, 0x54,
+    0x2b, 0x01, 0x40, 0xb9, 0x2b, 0x05, 0x00, 0xb9, 0x29, 0x21, 0x00, 0x91, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x6a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa2, 0x00, 0x00, 0x54,
+    0x2b, 0x01, 0x40, 0xb9, 0x2b, 0x05, 0x00, 0xb9, 0x29, 0x21, 0x00, 0x91, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x89, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x8a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa9, 0x00, 0x00, 0x54,
+    0x2b, 0xc1, 0x5f, 0xb8, 0x2b, 0x01, 0x00, 0xb9, 0x29, 0x11, 0x00, 0xd1, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x6a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa9, 0x00, 0x00, 0x54,
+    0x2b, 0xc1, 0x5f, 0xb8, 0x2b, 0x01, 0x00, 0xb9, 0x29, 0x11, 0x00, 0xd1, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0xab, 0x6a, 0x69, 0xf8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8, 0x60, 0x79, 0x6a, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0xcb, 0x6a, 0x69, 0xf8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x60, 0x79, 0x2a, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x40, 0x01, 0x22, 0x1e,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x0a, 0x00, 0x38, 0x1e, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x8a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x8a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc,
+    0x00, 0x28, 0x21, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x0b, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc,
+    0x00, 0x38, 0x21, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x4b, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc,
+    0x00, 0x08, 0x21, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x7d, 0x0b, 0x1b, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc,
+    0x00, 0x18, 0x21, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x0d, 0xcb, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc,
+    0x10, 0x00, 0x80, 0xd2, 0x10, 0x00, 0xa0, 0xf2, 0x10, 0x00, 0xc0, 0xf2, 0x10, 0x00, 0xe0, 0xf2,
+    0x00, 0x02, 0x3f, 0xd6, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4c, 0x0d, 0xcb, 0x1a, 0x8a, 0xa9, 0x0b, 0x1b,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x21, 0xcb, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x29, 0xcb, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0xea, 0xd7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x5f, 0x01, 0x0b, 0x6b, 0xea, 0xa7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b,
+    0xea, 0xb7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0xea, 0xc7, 0x9f, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0xea, 0x17, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x5f, 0x01, 0x0b, 0x6b, 0xea, 0x07, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc, 0x00, 0x20, 0x21, 0x1e,
+    0xea, 0xd7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc, 0x00, 0x20, 0x21, 0x1e, 0xea, 0x57, 0x9f, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x81, 0x6a, 0x69, 0xbc, 0x00, 0x20, 0x21, 0x1e, 0xea, 0xb7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc,
+    0x00, 0x20, 0x21, 0x1e, 0xea, 0x87, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc, 0x00, 0x20, 0x21, 0x1e,
+    0xea, 0x17, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc, 0x00, 0x20, 0x21, 0x1e, 0xea, 0x07, 0x9f, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x0a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x2a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x4a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x5f, 0x01, 0x00, 0x71, 0x4a, 0xa5, 0x8a, 0x5a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc,
+    0x00, 0xc0, 0x20, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x10, 0x00, 0x80, 0xd2,
+    0x10, 0x00, 0xa0, 0xf2, 0x10, 0x00, 0xc0, 0xf2, 0x10, 0x00, 0xe0, 0xf2, 0x00, 0x02, 0x3f, 0xd6,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x00, 0xc0, 0x21, 0x1e, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xbc, 0x00, 0x20, 0x20, 0x1e, 0xea, 0x77, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x8a, 0x6a, 0x69, 0xb8, 0x4a, 0x79, 0x00, 0x12, 0x0b, 0xf0, 0xaf, 0x52, 0x5f, 0x01, 0x0b, 0x6b,
+    0xea, 0x17, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0x6a, 0xb1, 0x8a, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x81, 0x6a, 0x69, 0xbc, 0x00, 0x20, 0x21, 0x1e, 0x20, 0x4c, 0x20, 0x1e, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x7f, 0x01, 0x0a, 0x6b, 0x6a, 0xb1, 0x8a, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xbc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xbc, 0x20, 0x20, 0x20, 0x1e,
+    0x20, 0x4c, 0x20, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xbc,
+    0x00, 0x00, 0x00, 0x14, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x4a, 0x00, 0x00, 0x35, 0x00, 0x00, 0x00, 0x14, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x4a, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x14, 0xf5, 0x5b, 0x42, 0xa9,
+    0xf3, 0x53, 0x41, 0xa9, 0xfd, 0x7b, 0xc3, 0xa8, 0xc0, 0x03, 0x5f, 0xd6, 0xfd, 0x7b, 0xbd, 0xa9,
+    0xfd, 0x03, 0x00, 0x91, 0xf3, 0x53, 0x01, 0xa9, 0xf5, 0x5b, 0x02, 0xa9, 0xf3, 0x03, 0x00, 0xaa,
+    0xf4, 0x03, 0x01, 0xaa, 0xf5, 0x03, 0x02, 0xaa, 0xf6, 0x03, 0x03, 0xaa, 0x0a, 0x00, 0x80, 0x52,
+    0x0a, 0x00, 0xa0, 0x72, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x0a, 0x00, 0x80, 0x52, 0x0a, 0x00, 0xa0, 0x72, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x8a, 0x6a, 0x29, 0xb8,
+};
+
+static const FBCStencilPatch gFBCStencilPatchesFloat[] = {
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealDst, 0},
+    {16, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntDst, 0}, {16, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleRealSrc1, 0}, {16, kPatchMovw16, kHoleRealSrc1, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleIntSrc1, 0}, {16, kPatchMovw16, kHoleIntSrc1, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleRealSrc1, 0}, {16, kPatchMovw16, kHoleRealSrc1, 0},
+    {24, kPatchMovw0, kHoleRealDst, 0}, {28, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleIntSrc1, 0}, {16, kPatchMovw16, kHoleIntSrc1, 0},
+    {24, kPatchMovw0, kHoleIntDst, 0}, {28, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, -4},
+    {4, kPatchMovw16, kHoleRealSrc1, -4}, {12, kPatchMovw0, kHoleRealSrc1, 0}, {16, kPatchMovw16, kHoleRealSrc1, 0},
+    {24, kPatchMovw0, kHoleRealSrc2, -4}, {28, kPatchMovw16, kHoleRealSrc2, -4}, {36, kPatchMovw0, kHoleRealSrc2, 0},
+    {40, kPatchMovw16, kHoleRealSrc2, 0}, {0, kPatchMovw0, kHoleIntSrc1, -4}, {4, kPatchMovw16, kHoleIntSrc1, -4},
+    {12, kPatchMovw0, kHoleIntSrc1, 0}, {16, kPatchMovw16, kHoleIntSrc1, 0}, {24, kPatchMovw0, kHoleIntSrc2, -4},
+    {28, kPatchMovw16, kHoleIntSrc2, -4}, {36, kPatchMovw0, kHoleIntSrc2, 0}, {40, kPatchMovw16, kHoleIntSrc2, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {0, kPatchMovw0, kHoleChannelSrc1, 0}, {4, kPatchMovw16, kHoleChannelSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleRealDst, 0},
+    {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleChannelDst, 0}, {4, kPatchMovw16, kHoleChannelDst, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {24, kPatchMovw0, kHoleRealSrc1, 0},
+    {28, kPatchMovw16, kHoleRealSrc1, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {16, kPatchMovw0, kHoleRealDst, 0}, {20, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {16, kPatchMovw0, kHoleIntDst, 0}, {20, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleIntDst, 0},
+    {16, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleRealDst, 0}, {16, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {24, kPatchMovw0, kHoleFunction, 0}, {28, kPatchMovw16, kHoleFunction, 0}, {32, kPatchMovw32, kHoleFunction, 0},
+    {36, kPatchMovw48, kHoleFunction, 0}, {44, kPatchMovw0, kHoleRealDst, 0}, {48, kPatchMovw16, kHoleRealDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {20, kPatchMovw0, kHoleIntDst, 0},
+    {24, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {16, kPatchMovw0, kHoleRealDst, 0}, {20, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleFunction, 0}, {16, kPatchMovw16, kHoleFunction, 0},
+    {20, kPatchMovw32, kHoleFunction, 0}, {24, kPatchMovw48, kHoleFunction, 0}, {32, kPatchMovw0, kHoleRealDst, 0},
+    {36, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {16, kPatchMovw0, kHoleRealDst, 0}, {20, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {20, kPatchMovw0, kHoleIntDst, 0}, {24, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {28, kPatchMovw0, kHoleIntDst, 0},
+    {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0},
+    {36, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleRealDst, 0},
+    {36, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0},
+    {36, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleRealDst, 0},
+    {36, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchBranch26, kHoleTarget, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {16, kPatchBranch26, kHoleTarget, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {16, kPatchBranch26, kHoleTarget, 0}, {0, kPatchMovw0, kHoleValue, 0},
+    {4, kPatchMovw16, kHoleValue, 0}, {8, kPatchMovw0, kHoleIntDst, 0}, {12, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleValue, 0}, {4, kPatchMovw16, kHoleValue, 0}, {8, kPatchMovw0, kHoleRealDst, 0},
+    {12, kPatchMovw16, kHoleRealDst, 0},
+};
+
+static const FBCStencil gFBCStencilsFloat[] = {
+    {0, 24, 0, 4}, {24, 24, 4, 4}, {48, 40, 8, 6}, {88, 40, 14, 6},
+    {128, 40, 20, 6}, {168, 40, 26, 6}, {208, 48, 32, 8}, {256, 48, 40, 8},
+    {304, 48, 48, 4}, {352, 48, 52, 4}, {400, 48, 56, 4}, {448, 48, 60, 4},
+    {496, 40, 64, 6}, {536, 40, 70, 6}, {576, 28, 76, 4}, {604, 28, 80, 4},
+    {632, 24, 84, 4}, {656, 24, 88, 4}, {680, 40, 92, 6}, {720, 40, 98, 6},
+    {760, 40, 104, 6}, {800, 40, 110, 6}, {840, 40, 116, 6}, {880, 40, 122, 6},
+    {920, 40, 128, 6}, {960, 40, 134, 6}, {1000, 56, 140, 10}, {1056, 44, 150, 6},
+    {1100, 40, 156, 6}, {1140, 40, 162, 6}, {1140, 40, 162, 6}, {1180, 44, 168, 6},
+    {1224, 44, 174, 6}, {1268, 44, 180, 6}, {1312, 44, 186, 6}, {1356, 44, 192, 6},
+    {1400, 44, 198, 6}, {1444, 44, 204, 6}, {1488, 44, 210, 6}, {1532, 44, 216, 6},
+    {1576, 44, 222, 6}, {1620, 44, 228, 6}, {1664, 44, 234, 6}, {1708, 40, 240, 6},
+    {1748, 40, 246, 6}, {1788, 40, 252, 6}, {1828, 32, 258, 4}, {1860, 28, 262, 4},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1932, 28, 274, 4}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1960, 32, 278, 4}, {1992, 40, 282, 4}, {1000, 56, 140, 10}, {1000, 56, 140, 10},
+    {1000, 56, 140, 10}, {2032, 44, 286, 6}, {2076, 44, 292, 6}, {2120, 44, 298, 6},
+    {2164, 44, 304, 6}, {1000, 56, 140, 10}, {2208, 4, 310, 1}, {2212, 20, 311, 3},
+    {2232, 20, 314, 3}, {2252, 16, 317, 0}, {2268, 32, 317, 0}, {2300, 20, 317, 4},
+    {2320, 20, 321, 4},
+};
+
+static const unsigned char gFBCStencilCodeDouble[] = {
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x89, 0x02, 0x09, 0x8b, 0x20, 0x79, 0x6a, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b,
+    0x2b, 0x79, 0x6a, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x89, 0x02, 0x09, 0x8b, 0x20, 0x79, 0x2a, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0xa9, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b, 0x2b, 0x79, 0x2a, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x89, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x8a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa2, 0x00, 0x00, 0x54,
+    0x2b, 0x01, 0x40, 0xf9, 0x2b, 0x05, 0x00, 0xf9, 0x29, 0x41, 0x00, 0x91, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x6a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa2, 0x00, 0x00, 0x54,
+    0x2b, 0x01, 0x40, 0xb9, 0x2b, 0x05, 0x00, 0xb9, 0x29, 0x21, 0x00, 0x91, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x89, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x8a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa9, 0x00, 0x00, 0x54,
+    0x2b, 0x81, 0x5f, 0xf8, 0x2b, 0x01, 0x00, 0xf9, 0x29, 0x21, 0x00, 0xd1, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x69, 0x02, 0x09, 0x8b, 0x0a, 0x00, 0x80, 0xd2,
+    0x0a, 0x00, 0xa0, 0xf2, 0x6a, 0x02, 0x0a, 0x8b, 0x3f, 0x01, 0x0a, 0xeb, 0xa9, 0x00, 0x00, 0x54,
+    0x2b, 0xc1, 0x5f, 0xb8, 0x2b, 0x01, 0x00, 0xb9, 0x29, 0x11, 0x00, 0xd1, 0xfb, 0xff, 0xff, 0x17,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0xab, 0x6a, 0x69, 0xf8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8, 0x60, 0x79, 0x6a, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0xcb, 0x6a, 0x69, 0xf8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0xa9, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x60, 0x79, 0x2a, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x40, 0x01, 0x62, 0x1e,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x0a, 0x00, 0x78, 0x1e, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x8a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x8a, 0x6a, 0x29, 0xf8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc,
+    0x00, 0x28, 0x61, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x0b, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc,
+    0x00, 0x38, 0x61, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x4b, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc,
+    0x00, 0x08, 0x61, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x7d, 0x0b, 0x1b, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc,
+    0x00, 0x18, 0x61, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x0d, 0xcb, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc,
+    0x10, 0x00, 0x80, 0xd2, 0x10, 0x00, 0xa0, 0xf2, 0x10, 0x00, 0xc0, 0xf2, 0x10, 0x00, 0xe0, 0xf2,
+    0x00, 0x02, 0x3f, 0xd6, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4c, 0x0d, 0xcb, 0x1a, 0x8a, 0xa9, 0x0b, 0x1b,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x21, 0xcb, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x29, 0xcb, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0xea, 0xd7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x5f, 0x01, 0x0b, 0x6b, 0xea, 0xa7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b,
+    0xea, 0xb7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0xea, 0xc7, 0x9f, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0xea, 0x17, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x5f, 0x01, 0x0b, 0x6b, 0xea, 0x07, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc, 0x00, 0x20, 0x61, 0x1e,
+    0xea, 0xd7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc, 0x00, 0x20, 0x61, 0x1e, 0xea, 0x57, 0x9f, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x81, 0x6a, 0x69, 0xfc, 0x00, 0x20, 0x61, 0x1e, 0xea, 0xb7, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc,
+    0x00, 0x20, 0x61, 0x1e, 0xea, 0x87, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc, 0x00, 0x20, 0x61, 0x1e,
+    0xea, 0x17, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc, 0x00, 0x20, 0x61, 0x1e, 0xea, 0x07, 0x9f, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x0a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x2a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6b, 0x6a, 0x69, 0xb8, 0x4a, 0x01, 0x0b, 0x4a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x5f, 0x01, 0x00, 0x71, 0x4a, 0xa5, 0x8a, 0x5a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc,
+    0x00, 0xc0, 0x60, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x10, 0x00, 0x80, 0xd2,
+    0x10, 0x00, 0xa0, 0xf2, 0x10, 0x00, 0xc0, 0xf2, 0x10, 0x00, 0xe0, 0xf2, 0x00, 0x02, 0x3f, 0xd6,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x00, 0xc0, 0x61, 0x1e, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x80, 0x6a, 0x69, 0xfc, 0x00, 0x20, 0x60, 0x1e, 0xea, 0x77, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x8a, 0x6a, 0x69, 0xf8, 0x4a, 0xf9, 0x40, 0x92, 0x0b, 0xfe, 0xef, 0xd2, 0x5f, 0x01, 0x0b, 0xeb,
+    0xea, 0x17, 0x9f, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8, 0x5f, 0x01, 0x0b, 0x6b, 0x6a, 0xb1, 0x8a, 0x1a,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x81, 0x6a, 0x69, 0xfc, 0x00, 0x20, 0x61, 0x1e, 0x20, 0x4c, 0x60, 0x1e, 0x09, 0x00, 0x80, 0xd2,
+    0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6b, 0x6a, 0x69, 0xb8,
+    0x7f, 0x01, 0x0a, 0x6b, 0x6a, 0xb1, 0x8a, 0x1a, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x29, 0xb8, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x69, 0xfc,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x81, 0x6a, 0x69, 0xfc, 0x20, 0x20, 0x60, 0x1e,
+    0x20, 0x4c, 0x60, 0x1e, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x80, 0x6a, 0x29, 0xfc,
+    0x00, 0x00, 0x00, 0x14, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x69, 0xb8,
+    0x4a, 0x00, 0x00, 0x35, 0x00, 0x00, 0x00, 0x14, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2,
+    0x6a, 0x6a, 0x69, 0xb8, 0x4a, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x14, 0xf5, 0x5b, 0x42, 0xa9,
+    0xf3, 0x53, 0x41, 0xa9, 0xfd, 0x7b, 0xc3, 0xa8, 0xc0, 0x03, 0x5f, 0xd6, 0xfd, 0x7b, 0xbd, 0xa9,
+    0xfd, 0x03, 0x00, 0x91, 0xf3, 0x53, 0x01, 0xa9, 0xf5, 0x5b, 0x02, 0xa9, 0xf3, 0x03, 0x00, 0xaa,
+    0xf4, 0x03, 0x01, 0xaa, 0xf5, 0x03, 0x02, 0xaa, 0xf6, 0x03, 0x03, 0xaa, 0x0a, 0x00, 0x80, 0x52,
+    0x0a, 0x00, 0xa0, 0x72, 0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x6a, 0x6a, 0x29, 0xb8,
+    0x0a, 0x00, 0x80, 0xd2, 0x0a, 0x00, 0xa0, 0xf2, 0x0a, 0x00, 0xc0, 0xf2, 0x0a, 0x00, 0xe0, 0xf2,
+    0x09, 0x00, 0x80, 0xd2, 0x09, 0x00, 0xa0, 0xf2, 0x8a, 0x6a, 0x29, 0xf8,
+};
+
+static const FBCStencilPatch gFBCStencilPatchesDouble[] = {
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealDst, 0},
+    {16, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntDst, 0}, {16, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleRealSrc1, 0}, {16, kPatchMovw16, kHoleRealSrc1, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleIntSrc1, 0}, {16, kPatchMovw16, kHoleIntSrc1, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleRealSrc1, 0}, {16, kPatchMovw16, kHoleRealSrc1, 0},
+    {24, kPatchMovw0, kHoleRealDst, 0}, {28, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc2, 0},
+    {4, kPatchMovw16, kHoleIntSrc2, 0}, {12, kPatchMovw0, kHoleIntSrc1, 0}, {16, kPatchMovw16, kHoleIntSrc1, 0},
+    {24, kPatchMovw0, kHoleIntDst, 0}, {28, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, -8},
+    {4, kPatchMovw16, kHoleRealSrc1, -8}, {12, kPatchMovw0, kHoleRealSrc1, 0}, {16, kPatchMovw16, kHoleRealSrc1, 0},
+    {24, kPatchMovw0, kHoleRealSrc2, -8}, {28, kPatchMovw16, kHoleRealSrc2, -8}, {36, kPatchMovw0, kHoleRealSrc2, 0},
+    {40, kPatchMovw16, kHoleRealSrc2, 0}, {0, kPatchMovw0, kHoleIntSrc1, -4}, {4, kPatchMovw16, kHoleIntSrc1, -4},
+    {12, kPatchMovw0, kHoleIntSrc1, 0}, {16, kPatchMovw16, kHoleIntSrc1, 0}, {24, kPatchMovw0, kHoleIntSrc2, -4},
+    {28, kPatchMovw16, kHoleIntSrc2, -4}, {36, kPatchMovw0, kHoleIntSrc2, 0}, {40, kPatchMovw16, kHoleIntSrc2, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {0, kPatchMovw0, kHoleChannelSrc1, 0}, {4, kPatchMovw16, kHoleChannelSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleRealDst, 0},
+    {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleChannelDst, 0}, {4, kPatchMovw16, kHoleChannelDst, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {24, kPatchMovw0, kHoleRealSrc1, 0},
+    {28, kPatchMovw16, kHoleRealSrc1, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {16, kPatchMovw0, kHoleRealDst, 0}, {20, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {16, kPatchMovw0, kHoleIntDst, 0}, {20, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleIntDst, 0},
+    {16, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleRealDst, 0}, {16, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {28, kPatchMovw0, kHoleRealDst, 0}, {32, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0},
+    {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0},
+    {24, kPatchMovw0, kHoleFunction, 0}, {28, kPatchMovw16, kHoleFunction, 0}, {32, kPatchMovw32, kHoleFunction, 0},
+    {36, kPatchMovw48, kHoleFunction, 0}, {44, kPatchMovw0, kHoleRealDst, 0}, {48, kPatchMovw16, kHoleRealDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleRealSrc2, 0},
+    {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0}, {36, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {12, kPatchMovw0, kHoleIntSrc2, 0},
+    {16, kPatchMovw16, kHoleIntSrc2, 0}, {28, kPatchMovw0, kHoleIntDst, 0}, {32, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0}, {20, kPatchMovw0, kHoleIntDst, 0},
+    {24, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {16, kPatchMovw0, kHoleRealDst, 0}, {20, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {12, kPatchMovw0, kHoleFunction, 0}, {16, kPatchMovw16, kHoleFunction, 0},
+    {20, kPatchMovw32, kHoleFunction, 0}, {24, kPatchMovw48, kHoleFunction, 0}, {32, kPatchMovw0, kHoleRealDst, 0},
+    {36, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {16, kPatchMovw0, kHoleRealDst, 0}, {20, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0},
+    {4, kPatchMovw16, kHoleRealSrc1, 0}, {20, kPatchMovw0, kHoleIntDst, 0}, {24, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0}, {28, kPatchMovw0, kHoleIntDst, 0},
+    {32, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0},
+    {36, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleRealDst, 0},
+    {36, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0}, {4, kPatchMovw16, kHoleIntSrc1, 0},
+    {12, kPatchMovw0, kHoleIntSrc2, 0}, {16, kPatchMovw16, kHoleIntSrc2, 0}, {32, kPatchMovw0, kHoleIntDst, 0},
+    {36, kPatchMovw16, kHoleIntDst, 0}, {0, kPatchMovw0, kHoleRealSrc1, 0}, {4, kPatchMovw16, kHoleRealSrc1, 0},
+    {12, kPatchMovw0, kHoleRealSrc2, 0}, {16, kPatchMovw16, kHoleRealSrc2, 0}, {32, kPatchMovw0, kHoleRealDst, 0},
+    {36, kPatchMovw16, kHoleRealDst, 0}, {0, kPatchBranch26, kHoleTarget, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {16, kPatchBranch26, kHoleTarget, 0}, {0, kPatchMovw0, kHoleIntSrc1, 0},
+    {4, kPatchMovw16, kHoleIntSrc1, 0}, {16, kPatchBranch26, kHoleTarget, 0}, {0, kPatchMovw0, kHoleValue, 0},
+    {4, kPatchMovw16, kHoleValue, 0}, {8, kPatchMovw0, kHoleIntDst, 0}, {12, kPatchMovw16, kHoleIntDst, 0},
+    {0, kPatchMovw0, kHoleValue, 0}, {4, kPatchMovw16, kHoleValue, 0}, {8, kPatchMovw32, kHoleValue, 0},
+    {12, kPatchMovw48, kHoleValue, 0}, {16, kPatchMovw0, kHoleRealDst, 0}, {20, kPatchMovw16, kHoleRealDst, 0},
+};
+
+static const FBCStencil gFBCStencilsDouble[] = {
+    {0, 24, 0, 4}, {24, 24, 4, 4}, {48, 40, 8, 6}, {88, 40, 14, 6},
+    {128, 40, 20, 6}, {168, 40, 26, 6}, {208, 48, 32, 8}, {256, 48, 40, 8},
+    {304, 48, 48, 4}, {352, 48, 52, 4}, {400, 48, 56, 4}, {448, 48, 60, 4},
+    {496, 40, 64, 6}, {536, 40, 70, 6}, {576, 28, 76, 4}, {604, 28, 80, 4},
+    {632, 24, 84, 4}, {656, 24, 88, 4}, {680, 40, 92, 6}, {720, 40, 98, 6},
+    {760, 40, 104, 6}, {800, 40, 110, 6}, {840, 40, 116, 6}, {880, 40, 122, 6},
+    {920, 40, 128, 6}, {960, 40, 134, 6}, {1000, 56, 140, 10}, {1056, 44, 150, 6},
+    {1100, 40, 156, 6}, {1140, 40, 162, 6}, {1140, 40, 162, 6}, {1180, 44, 168, 6},
+    {1224, 44, 174, 6}, {1268, 44, 180, 6}, {1312, 44, 186, 6}, {1356, 44, 192, 6},
+    {1400, 44, 198, 6}, {1444, 44, 204, 6}, {1488, 44, 210, 6}, {1532, 44, 216, 6},
+    {1576, 44, 222, 6}, {1620, 44, 228, 6}, {1664, 44, 234, 6}, {1708, 40, 240, 6},
+    {1748, 40, 246, 6}, {1788, 40, 252, 6}, {1828, 32, 258, 4}, {1860, 28, 262, 4},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1888, 44, 266, 8}, {1932, 28, 274, 4}, {1888, 44, 266, 8}, {1888, 44, 266, 8},
+    {1960, 32, 278, 4}, {1992, 40, 282, 4}, {1000, 56, 140, 10}, {1000, 56, 140, 10},
+    {1000, 56, 140, 10}, {2032, 44, 286, 6}, {2076, 44, 292, 6}, {2120, 44, 298, 6},
+    {2164, 44, 304, 6}, {1000, 56, 140, 10}, {2208, 4, 310, 1}, {2212, 20, 311, 3},
+    {2232, 20, 314, 3}, {2252, 16, 317, 0}, {2268, 32, 317, 0}, {2300, 20, 317, 4},
+    {2320, 28, 321, 6},
+};
+
+#endif
+
+#endif
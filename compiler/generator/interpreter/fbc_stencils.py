@@ -0,0 +1,562 @@
+#!/usr/bin/env python3
+"""
+Generate the stencils of the FBC template compiler (see fbc_template_compiler.hh).
+
+A stencil is the precompiled machine code of one instruction of the register code (see
+fbc_register_interpreter.hh), with holes for its operands: heap offsets, constants, called
+functions and jump targets. The template compiler copies the stencils of a block one after the
+other in executable memory, then patches the holes (copy-and-patch compilation).
+
+The stencils are written here in assembly for x86-64 and AArch64, in a float and a double
+version, and assembled with llvm-mc. The holes are references to undefined symbols, their
+relocations give the patch to apply:
+
+    _I_DST, _I_SRC1, _I_SRC2 : int heap operand, patched with its offset in bytes
+    _R_DST, _R_SRC1, _R_SRC2 : real heap operand, patched with its offset in bytes
+    _P_DST, _P_SRC1          : audio channel, patched with its offset in the inputs/outputs arrays
+    _K                       : constant (int or real) bits
+    _F                       : address of a called function
+    _T                       : jump target
+
+The result is written in fbc_stencils.hh, next to this script:
+
+    python3 compiler/generator/interpreter/fbc_stencils.py
+
+The generated code keeps the heaps, inputs and outputs pointers in callee-saved registers:
+
+    x86-64  : rbx (int heap), r12 (real heap), r13 (inputs), r14 (outputs)
+    AArch64 : x19 (int heap), x20 (real heap), x21 (inputs), x22 (outputs)
+
+so that math functions can directly be called by the stencils.
+"""
+
+import argparse
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+# Register code opcodes, in the FBCRegisterInstruction order, then the stencils that are not
+# register opcodes : the function entry, and the moves of constants
+OPCODES = [
+    # Memory
+    "kMoveReal", "kMoveInt", "kLoadIndexedReal", "kLoadIndexedInt", "kStoreIndexedReal",
+    "kStoreIndexedInt", "kPairMoveReal", "kPairMoveInt", "kBlockPairMoveReal",
+    "kBlockPairMoveInt", "kBlockShiftReal", "kBlockShiftInt", "kLoadInput", "kStoreOutput",
+    # Cast/Bitcast
+    "kCastReal", "kCastInt", "kBitcastInt", "kBitcastReal",
+    # Standard math
+    "kAddReal", "kAddInt", "kSubReal", "kSubInt", "kMultReal", "kMultInt", "kDivReal",
+    "kDivInt", "kRemReal", "kRemInt", "kLshInt", "kARshInt", "kLRshInt", "kGTInt", "kLTInt",
+    "kGEInt", "kLEInt", "kEQInt", "kNEInt", "kGTReal", "kLTReal", "kGEReal", "kLEReal",
+    "kEQReal", "kNEReal", "kANDInt", "kORInt", "kXORInt",
+    # Extended unary math
+    "kAbs", "kAbsf", "kAcosf", "kAcoshf", "kAsinf", "kAsinhf", "kAtanf", "kAtanhf", "kCeilf",
+    "kCosf", "kCoshf", "kExpf", "kFloorf", "kLogf", "kLog10f", "kRintf", "kRoundf", "kSinf",
+    "kSinhf", "kSqrtf", "kTanf", "kTanhf", "kIsnanf", "kIsinff",
+    # Extended binary math
+    "kAtan2f", "kFmodf", "kPowf", "kMax", "kMaxf", "kMin", "kMinf", "kCopysignf",
+    # Control
+    "kJump", "kJumpIfZero", "kJumpIfNotZero", "kReturn",
+]
+EXTRA = ["kEnter", "kMoveIntValue", "kMoveRealValue"]
+
+# Real operations done by a call, see FBCTemplateCompiler::getFunction
+UNARY_CALLS = ["kAcosf", "kAcoshf", "kAsinf", "kAsinhf", "kAtanf", "kAtanhf", "kCeilf", "kCosf",
+               "kCoshf", "kExpf", "kFloorf", "kLogf", "kLog10f", "kRintf", "kRoundf", "kSinf",
+               "kSinhf", "kTanf", "kTanhf"]
+BINARY_CALLS = ["kRemReal", "kAtan2f", "kFmodf", "kPowf", "kCopysignf"]
+
+HOLES = ["_I_DST", "_I_SRC1", "_I_SRC2", "_R_DST", "_R_SRC1", "_R_SRC2", "_P_DST", "_P_SRC1",
+         "_K", "_F", "_T"]
+HOLE_ENUMS = ["kHoleIntDst", "kHoleIntSrc1", "kHoleIntSrc2", "kHoleRealDst", "kHoleRealSrc1",
+              "kHoleRealSrc2", "kHoleChannelDst", "kHoleChannelSrc1", "kHoleValue",
+              "kHoleFunction", "kHoleTarget"]
+
+PATCH_ENUMS = ["kPatchAbs32", "kPatchAbs64", "kPatchRel32", "kPatchMovw0", "kPatchMovw16",
+               "kPatchMovw32", "kPatchMovw48", "kPatchBranch26"]
+
+# ELF relocation types
+RELOCS = {
+    "x86_64": {1: "kPatchAbs64", 2: "kPatchRel32", 4: "kPatchRel32", 10: "kPatchAbs32",
+               11: "kPatchAbs32"},
+    "aarch64": {264: "kPatchMovw0", 266: "kPatchMovw16", 268: "kPatchMovw32",
+                269: "kPatchMovw48", 282: "kPatchBranch26", 283: "kPatchBranch26"},
+}
+
+# ------------------------------------------------------------------------------------------
+# x86-64 stencils (AT&T syntax)
+# ------------------------------------------------------------------------------------------
+
+
+def x86_stencils(real):
+    S = 8 if real == "double" else 4
+    sx = "sd" if real == "double" else "ss"  # scalar suffix
+    mr = "movq" if real == "double" else "movl"  # bit copy of a real
+    ra = "%rax" if real == "double" else "%eax"
+    st = {}
+
+    def ldr(reg, hole):
+        return "mov{} {}(%r12), {}".format(sx, hole, reg)
+
+    def strr(reg, hole):
+        return "mov{} {}, {}(%r12)".format(sx, reg, hole)
+
+    st["kEnter"] = ["pushq %rbp", "movq %rsp, %rbp", "pushq %rbx", "pushq %r12", "pushq %r13",
+                    "pushq %r14", "movq %rdi, %rbx", "movq %rsi, %r12", "movq %rdx, %r13",
+                    "movq %rcx, %r14"]
+    st["kReturn"] = ["popq %r14", "popq %r13", "popq %r12", "popq %rbx", "popq %rbp", "retq"]
+
+    # Memory
+    st["kMoveReal"] = [ldr("%xmm0", "_R_SRC1"), strr("%xmm0", "_R_DST")]
+    st["kMoveInt"] = ["movl _I_SRC1(%rbx), %eax", "movl %eax, _I_DST(%rbx)"]
+    if real == "double":
+        st["kMoveRealValue"] = ["movabsq $_K, %rax", "movq %rax, _R_DST(%r12)"]
+    else:
+        st["kMoveRealValue"] = ["movl $_K, _R_DST(%r12)"]
+    st["kMoveIntValue"] = ["movl $_K, _I_DST(%rbx)"]
+    st["kLoadIndexedReal"] = ["movslq _I_SRC2(%rbx), %rax",
+                              "mov{} _R_SRC1(%r12,%rax,{}), %xmm0".format(sx, S),
+                              strr("%xmm0", "_R_DST")]
+    st["kLoadIndexedInt"] = ["movslq _I_SRC2(%rbx), %rax", "movl _I_SRC1(%rbx,%rax,4), %ecx",
+                             "movl %ecx, _I_DST(%rbx)"]
+    st["kStoreIndexedReal"] = ["movslq _I_SRC2(%rbx), %rax", ldr("%xmm0", "_R_SRC1"),
+                               "mov{} %xmm0, _R_DST(%r12,%rax,{})".format(sx, S)]
+    st["kStoreIndexedInt"] = ["movslq _I_SRC2(%rbx), %rax", "movl _I_SRC1(%rbx), %ecx",
+                              "movl %ecx, _I_DST(%rbx,%rax,4)"]
+    st["kPairMoveReal"] = [ldr("%xmm0", "_R_SRC1-{}".format(S)), strr("%xmm0", "_R_SRC1"),
+                           ldr("%xmm0", "_R_SRC2-{}".format(S)), strr("%xmm0", "_R_SRC2")]
+    st["kPairMoveInt"] = ["movl _I_SRC1-4(%rbx), %eax", "movl %eax, _I_SRC1(%rbx)",
+                          "movl _I_SRC2-4(%rbx), %eax", "movl %eax, _I_SRC2(%rbx)"]
+    for name, base, size, mov, reg in (("Real", "%r12", S, mr, ra), ("Int", "%rbx", 4, "movl",
+                                                                      "%eax")):
+        h = name[0]
+        # for (i = src1; i < src2; i += 2) heap[i + 1] = heap[i]
+        st["kBlockPairMove" + name] = [
+            "leaq _{}_SRC1({}), %rcx".format(h, base), "leaq _{}_SRC2({}), %rdx".format(h, base),
+            "1: cmpq %rdx, %rcx", "jae 2f", "{} (%rcx), {}".format(mov, reg),
+            "{} {}, {}(%rcx)".format(mov, reg, size), "addq ${}, %rcx".format(2 * size),
+            "jmp 1b", "2:"]
+        # for (i = src1; i > src2; i -= 1) heap[i] = heap[i - 1]
+        st["kBlockShift" + name] = [
+            "leaq _{}_SRC1({}), %rcx".format(h, base), "leaq _{}_SRC2({}), %rdx".format(h, base),
+            "1: cmpq %rdx, %rcx", "jbe 2f", "{} -{}(%rcx), {}".format(mov, size, reg),
+            "{} {}, (%rcx)".format(mov, reg), "subq ${}, %rcx".format(size), "jmp 1b", "2:"]
+    st["kLoadInput"] = ["movq _P_SRC1(%r13), %rax", "movslq _I_SRC2(%rbx), %rcx",
+                        "mov{} (%rax,%rcx,{}), %xmm0".format(sx, S), strr("%xmm0", "_R_DST")]
+    st["kStoreOutput"] = ["movq _P_DST(%r14), %rax", "movslq _I_SRC2(%rbx), %rcx",
+                          ldr("%xmm0", "_R_SRC1"),
+                          "mov{} %xmm0, (%rax,%rcx,{})".format(sx, S)]
+
+    # Cast/Bitcast
+    st["kCastReal"] = ["xorps %xmm0, %xmm0", "cvtsi2{}l _I_SRC1(%rbx), %xmm0".format(sx),
+                       strr("%xmm0", "_R_DST")]
+    st["kCastInt"] = ["cvtt{}2si _R_SRC1(%r12), %eax".format(sx), "movl %eax, _I_DST(%rbx)"]
+    st["kBitcastInt"] = ["movl _R_SRC1(%r12), %eax", "movl %eax, _I_DST(%rbx)"]
+    st["kBitcastReal"] = ["movl _I_SRC1(%rbx), %eax", "{} {}, _R_DST(%r12)".format(mr, ra)]
+
+    # Standard math
+    for op in ("add", "sub", "mul", "div"):
+        name = {"add": "Add", "sub": "Sub", "mul": "Mult", "div": "Div"}[op]
+        st["k{}Real".format(name)] = [ldr("%xmm0", "_R_SRC1"),
+                                      "{}{} _R_SRC2(%r12), %xmm0".format(op, sx),
+                                      strr("%xmm0", "_R_DST")]
+    for name, op in (("Add", "addl"), ("Sub", "subl"), ("Mult", "imull"), ("AND", "andl"),
+                     ("OR", "orl"), ("XOR", "xorl")):
+        st["k{}Int".format(name)] = ["movl _I_SRC1(%rbx), %eax",
+                                     "{} _I_SRC2(%rbx), %eax".format(op), "movl %eax, _I_DST(%rbx)"]
+    for name, reg in (("Div", "%eax"), ("Rem", "%edx")):
+        st["k{}Int".format(name)] = ["movl _I_SRC1(%rbx), %eax", "cltd", "idivl _I_SRC2(%rbx)",
+                                     "movl {}, _I_DST(%rbx)".format(reg)]
+    # 'LRsh' is an arithmetic shift in the interpreters
+    for name, op in (("Lsh", "shll"), ("ARsh", "sarl"), ("LRsh", "sarl")):
+        st["k{}Int".format(name)] = ["movl _I_SRC2(%rbx), %ecx", "movl _I_SRC1(%rbx), %eax",
+                                     "{} %cl, %eax".format(op), "movl %eax, _I_DST(%rbx)"]
+    for name, cc in (("GT", "g"), ("LT", "l"), ("GE", "ge"), ("LE", "le"), ("EQ", "e"),
+                     ("NE", "ne")):
+        st["k{}Int".format(name)] = ["movl _I_SRC1(%rbx), %eax", "xorl %ecx, %ecx",
+                                     "cmpl _I_SRC2(%rbx), %eax", "set{} %cl".format(cc),
+                                     "movl %ecx, _I_DST(%rbx)"]
+    # Comparisons are false for unordered operands, except 'NE'
+    for name, first, second, code in (
+            ("GT", "_R_SRC1", "_R_SRC2", ["seta %cl"]),
+            ("LT", "_R_SRC2", "_R_SRC1", ["seta %cl"]),
+            ("GE", "_R_SRC1", "_R_SRC2", ["setae %cl"]),
+            ("LE", "_R_SRC2", "_R_SRC1", ["setae %cl"]),
+            ("EQ", "_R_SRC1", "_R_SRC2", ["sete %cl", "setnp %dl", "andb %dl, %cl"]),
+            ("NE", "_R_SRC1", "_R_SRC2", ["setne %cl", "setp %dl", "orb %dl, %cl"])):
+        st["k{}Real".format(name)] = ([ldr("%xmm0", first), "xorl %ecx, %ecx",
+                                       "ucomi{} {}(%r12), %xmm0".format(sx, second)] + code +
+                                      ["movl %ecx, _I_DST(%rbx)"])
+
+    # Extended math
+    st["kAbs"] = ["movl _I_SRC1(%rbx), %eax", "movl %eax, %ecx", "negl %ecx",
+                  "cmovnsl %ecx, %eax", "movl %eax, _I_DST(%rbx)"]
+    if real == "double":
+        st["kAbsf"] = ["movq _R_SRC1(%r12), %rax", "btrq $63, %rax", "movq %rax, _R_DST(%r12)"]
+        st["kIsinff"] = ["movq _R_SRC1(%r12), %rax", "btrq $63, %rax",
+                         "movabsq $0x7ff0000000000000, %rdx", "xorl %ecx, %ecx",
+                         "cmpq %rdx, %rax", "sete %cl", "movl %ecx, _I_DST(%rbx)"]
+    else:
+        st["kAbsf"] = ["movl _R_SRC1(%r12), %eax", "andl $0x7fffffff, %eax",
+                       "movl %eax, _R_DST(%r12)"]
+        st["kIsinff"] = ["movl _R_SRC1(%r12), %eax", "andl $0x7fffffff, %eax", "xorl %ecx, %ecx",
+                         "cmpl $0x7f800000, %eax", "sete %cl", "movl %ecx, _I_DST(%rbx)"]
+    st["kSqrtf"] = ["sqrt{} _R_SRC1(%r12), %xmm0".format(sx), strr("%xmm0", "_R_DST")]
+    st["kIsnanf"] = [ldr("%xmm0", "_R_SRC1"), "xorl %ecx, %ecx",
+                     "ucomi{} %xmm0, %xmm0".format(sx), "setp %cl", "movl %ecx, _I_DST(%rbx)"]
+    for name in UNARY_CALLS:
+        st[name] = [ldr("%xmm0", "_R_SRC1"), "movabsq $_F, %rax", "callq *%rax",
+                    strr("%xmm0", "_R_DST")]
+    for name in BINARY_CALLS:
+        st[name] = [ldr("%xmm0", "_R_SRC1"), ldr("%xmm1", "_R_SRC2"), "movabsq $_F, %rax",
+                    "callq *%rax", strr("%xmm0", "_R_DST")]
+    # std::max(a, b) is (a < b) ? b : a, and std::min(a, b) is (b < a) ? b : a
+    st["kMax"] = ["movl _I_SRC1(%rbx), %eax", "movl _I_SRC2(%rbx), %ecx", "cmpl %ecx, %eax",
+                  "cmovll %ecx, %eax", "movl %eax, _I_DST(%rbx)"]
+    st["kMin"] = ["movl _I_SRC1(%rbx), %eax", "movl _I_SRC2(%rbx), %ecx", "cmpl %eax, %ecx",
+                  "cmovll %ecx, %eax", "movl %eax, _I_DST(%rbx)"]
+    for name, mask in (("kMaxf", ["movaps %xmm0, %xmm2", "cmplt{} %xmm1, %xmm2".format(sx)]),
+                       ("kMinf", ["movaps %xmm1, %xmm2", "cmplt{} %xmm0, %xmm2".format(sx)])):
+        st[name] = ([ldr("%xmm0", "_R_SRC1"), ldr("%xmm1", "_R_SRC2")] + mask +
+                    ["andps %xmm2, %xmm1", "andnps %xmm0, %xmm2", "orps %xmm1, %xmm2",
+                     strr("%xmm2", "_R_DST")])
+
+    # Control
+    st["kJump"] = ["jmp _T"]
+    st["kJumpIfZero"] = ["cmpl $0, _I_SRC1(%rbx)", "je _T"]
+    st["kJumpIfNotZero"] = ["cmpl $0, _I_SRC1(%rbx)", "jne _T"]
+    return st
+
+
+# ------------------------------------------------------------------------------------------
+# AArch64 stencils: offsets do not always fit in the load/store immediates, they are built in
+# a register with a movz/movk pair
+# ------------------------------------------------------------------------------------------
+
+
+def a64_stencils(real):
+    S = 8 if real == "double" else 4
+    L = 3 if real == "double" else 2
+    r = "d" if real == "double" else "s"
+    rx = "x" if real == "double" else "w"  # register for the bits of a real
+    st = {}
+
+    def offset(reg, hole):
+        return ["movz {}, #:abs_g0_nc:{}".format(reg, hole),
+                "movk {}, #:abs_g1_nc:{}".format(reg, hole)]
+
+    def ldi(reg, hole):
+        return offset("x9", hole) + ["ldr {}, [x19, x9]".format(reg)]
+
+    def sti(reg, hole):
+        return offset("x9", hole) + ["str {}, [x19, x9]".format(reg)]
+
+    def ldr(reg, hole):
+        return offset("x9", hole) + ["ldr {}, [x20, x9]".format(reg)]
+
+    def strr(reg, hole):
+        return offset("x9", hole) + ["str {}, [x20, x9]".format(reg)]
+
+    def call():
+        return ["movz x16, #:abs_g0_nc:_F", "movk x16, #:abs_g1_nc:_F",
+                "movk x16, #:abs_g2_nc:_F", "movk x16, #:abs_g3:_F", "blr x16"]
+
+    st["kEnter"] = ["stp x29, x30, [sp, #-48]!", "mov x29, sp", "stp x19, x20, [sp, #16]",
+                    "stp x21, x22, [sp, #32]", "mov x19, x0", "mov x20, x1", "mov x21, x2",
+                    "mov x22, x3"]
+    st["kReturn"] = ["ldp x21, x22, [sp, #32]", "ldp x19, x20, [sp, #16]",
+                     "ldp x29, x30, [sp], #48", "ret"]
+
+    # Memory
+    st["kMoveReal"] = ldr(r + "0", "_R_SRC1") + strr(r + "0", "_R_DST")
+    st["kMoveInt"] = ldi("w10", "_I_SRC1") + sti("w10", "_I_DST")
+    if real == "double":
+        st["kMoveRealValue"] = (["movz x10, #:abs_g0_nc:_K", "movk x10, #:abs_g1_nc:_K",
+                                 "movk x10, #:abs_g2_nc:_K", "movk x10, #:abs_g3:_K"] +
+                                strr("x10", "_R_DST"))
+    else:
+        st["kMoveRealValue"] = ["movz w10, #:abs_g0_nc:_K",
+                                "movk w10, #:abs_g1_nc:_K"] + strr("w10", "_R_DST")
+    st["kMoveIntValue"] = ["movz w10, #:abs_g0_nc:_K", "movk w10, #:abs_g1_nc:_K"] + sti(
+        "w10", "_I_DST")
+    st["kLoadIndexedReal"] = (offset("x9", "_I_SRC2") + ["ldrsw x10, [x19, x9]"] +
+                              offset("x9", "_R_SRC1") +
+                              ["add x9, x20, x9", "ldr {}0, [x9, x10, lsl #{}]".format(r, L)] +
+                              strr(r + "0", "_R_DST"))
+    st["kLoadIndexedInt"] = (offset("x9", "_I_SRC2") + ["ldrsw x10, [x19, x9]"] +
+                             offset("x9", "_I_SRC1") +
+                             ["add x9, x19, x9", "ldr w11, [x9, x10, lsl #2]"] +
+                             sti("w11", "_I_DST"))
+    st["kStoreIndexedReal"] = (offset("x9", "_I_SRC2") + ["ldrsw x10, [x19, x9]"] +
+                               ldr(r + "0", "_R_SRC1") + offset("x9", "_R_DST") +
+                               ["add x9, x20, x9", "str {}0, [x9, x10, lsl #{}]".format(r, L)])
+    st["kStoreIndexedInt"] = (offset("x9", "_I_SRC2") + ["ldrsw x10, [x19, x9]"] +
+                              ldi("w11", "_I_SRC1") + offset("x9", "_I_DST") +
+                              ["add x9, x19, x9", "str w11, [x9, x10, lsl #2]"])
+    st["kPairMoveReal"] = (ldr(r + "0", "_R_SRC1-{}".format(S)) + strr(r + "0", "_R_SRC1") +
+                           ldr(r + "0", "_R_SRC2-{}".format(S)) + strr(r + "0", "_R_SRC2"))
+    st["kPairMoveInt"] = (ldi("w10", "_I_SRC1-4") + sti("w10", "_I_SRC1") +
+                          ldi("w10", "_I_SRC2-4") + sti("w10", "_I_SRC2"))
+    for name, base, size, reg in (("Real", "x20", S, rx + "11"), ("Int", "x19", 4, "w11")):
+        h = name[0]
+        bounds = (offset("x9", "_{}_SRC1".format(h)) + ["add x9, {}, x9".format(base)] +
+                  offset("x10", "_{}_SRC2".format(h)) + ["add x10, {}, x10".format(base)])
+        # for (i = src1; i < src2; i += 2) heap[i + 1] = heap[i]
+        st["kBlockPairMove" + name] = bounds + [
+            "1: cmp x9, x10", "b.hs 2f", "ldr {}, [x9]".format(reg),
+            "str {}, [x9, #{}]".format(reg, size), "add x9, x9, #{}".format(2 * size), "b 1b",
+            "2:"]
+        # for (i = src1; i > src2; i -= 1) heap[i] = heap[i - 1]
+        st["kBlockShift" + name] = bounds + [
+            "1: cmp x9, x10", "b.ls 2f", "ldur {}, [x9, #-{}]".format(reg, size),
+            "str {}, [x9]".format(reg), "sub x9, x9, #{}".format(size), "b 1b", "2:"]
+    st["kLoadInput"] = (offset("x9", "_P_SRC1") + ["ldr x11, [x21, x9]"] +
+                        offset("x9", "_I_SRC2") + ["ldrsw x10, [x19, x9]",
+                                                   "ldr {}0, [x11, x10, lsl #{}]".format(r, L)] +
+                        strr(r + "0", "_R_DST"))
+    st["kStoreOutput"] = (offset("x9", "_P_DST") + ["ldr x11, [x22, x9]"] +
+                          offset("x9", "_I_SRC2") + ["ldrsw x10, [x19, x9]"] +
+                          ldr(r + "0", "_R_SRC1") +
+                          ["str {}0, [x11, x10, lsl #{}]".format(r, L)])
+
+    # Cast/Bitcast
+    st["kCastReal"] = ldi("w10", "_I_SRC1") + ["scvtf {}0, w10".format(r)] + strr(r + "0",
+                                                                                "_R_DST")
+    st["kCastInt"] = ldr(r + "0", "_R_SRC1") + ["fcvtzs w10, {}0".format(r)] + sti("w10",
+                                                                                 "_I_DST")
+    st["kBitcastInt"] = ldr("w10", "_R_SRC1") + sti("w10", "_I_DST")
+    st["kBitcastReal"] = ldi("w10", "_I_SRC1") + strr(rx + "10", "_R_DST")
+
+    # Standard math
+    def real_binop(code):
+        return ldr(r + "0", "_R_SRC1") + ldr(r + "1", "_R_SRC2") + code + strr(r + "0", "_R_DST")
+
+    def int_binop(code):
+        return ldi("w10", "_I_SRC1") + ldi("w11", "_I_SRC2") + code + sti("w10", "_I_DST")
+
+    for name, op in (("Add", "fadd"), ("Sub", "fsub"), ("Mult", "fmul"), ("Div", "fdiv")):
+        st["k{}Real".format(name)] = real_binop(["{0} {1}0, {1}0, {1}1".format(op, r)])
+    # 'LRsh' is an arithmetic shift in the interpreters
+    for name, op in (("Add", "add"), ("Sub", "sub"), ("Mult", "mul"), ("Div", "sdiv"),
+                     ("Lsh", "lsl"), ("ARsh", "asr"), ("LRsh", "asr"), ("AND", "and"),
+                     ("OR", "orr"), ("XOR", "eor")):
+        st["k{}Int".format(name)] = int_binop(["{} w10, w10, w11".format(op)])
+    st["kRemInt"] = int_binop(["sdiv w12, w10, w11", "msub w10, w12, w11, w10"])
+    for name, cc in (("GT", "gt"), ("LT", "lt"), ("GE", "ge"), ("LE", "le"), ("EQ", "eq"),
+                     ("NE", "ne")):
+        st["k{}Int".format(name)] = int_binop(["cmp w10, w11", "cset w10, {}".format(cc)])
+    # Comparisons are false for unordered operands, except 'NE'
+    for name, cc in (("GT", "gt"), ("LT", "mi"), ("GE", "ge"), ("LE", "ls"), ("EQ", "eq"),
+                     ("NE", "ne")):
+        st["k{}Real".format(name)] = (ldr(r + "0", "_R_SRC1") + ldr(r + "1", "_R_SRC2") +
+                                      ["fcmp {0}0, {0}1".format(r), "cset w10, {}".format(cc)] +
+                                      sti("w10", "_I_DST"))
+
+    # Extended math
+    st["kAbs"] = ldi("w10", "_I_SRC1") + ["cmp w10, #0", "cneg w10, w10, lt"] + sti("w10",
+                                                                                  "_I_DST")
+    st["kAbsf"] = ldr(r + "0", "_R_SRC1") + ["fabs {0}0, {0}0".format(r)] + strr(r + "0",
+                                                                                 "_R_DST")
+    st["kSqrtf"] = ldr(r + "0", "_R_SRC1") + ["fsqrt {0}0, {0}0".format(r)] + strr(r + "0",
+                                                                                   "_R_DST")
+    st["kIsnanf"] = (ldr(r + "0", "_R_SRC1") + ["fcmp {0}0, {0}0".format(r), "cset w10, vs"] +
+                     sti("w10", "_I_DST"))
+    if real == "double":
+        inf = ["and x10, x10, #0x7fffffffffffffff", "mov x11, #0x7ff0000000000000",
+               "cmp x10, x11"]
+    else:
+        inf = ["and w10, w10, #0x7fffffff", "mov w11, #0x7f800000", "cmp w10, w11"]
+    st["kIsinff"] = ldr(rx + "10", "_R_SRC1") + inf + ["cset w10, eq"] + sti("w10", "_I_DST")
+    for name in UNARY_CALLS:
+        st[name] = ldr(r + "0", "_R_SRC1") + call() + strr(r + "0", "_R_DST")
+    for name in BINARY_CALLS:
+        st[name] = ldr(r + "0", "_R_SRC1") + ldr(r + "1", "_R_SRC2") + call() + strr(r + "0",
+                                                                                    "_R_DST")
+    # std::max(a, b) is (a < b) ? b : a, and std::min(a, b) is (b < a) ? b : a
+    st["kMax"] = int_binop(["cmp w10, w11", "csel w10, w11, w10, lt"])
+    st["kMin"] = int_binop(["cmp w11, w10", "csel w10, w11, w10, lt"])
+    st["kMaxf"] = real_binop(["fcmp {0}0, {0}1".format(r), "fcsel {0}0, {0}1, {0}0, mi".format(r)])
+    st["kMinf"] = real_binop(["fcmp {0}1, {0}0".format(r), "fcsel {0}0, {0}1, {0}0, mi".format(r)])
+
+    # Control
+    st["kJump"] = ["b _T"]
+    st["kJumpIfZero"] = ldi("w10", "_I_SRC1") + ["cbnz w10, 1f", "b _T", "1:"]
+    st["kJumpIfNotZero"] = ldi("w10", "_I_SRC1") + ["cbz w10, 1f", "b _T", "1:"]
+    return st
+
+
+TARGETS = [
+    # (name, llvm-mc triple, C++ condition, stencils)
+    ("x86_64", "x86_64-linux-gnu", "defined(__linux__) && defined(__x86_64__)", x86_stencils),
+    ("aarch64", "aarch64-linux-gnu", "defined(__linux__) && defined(__aarch64__)", a64_stencils),
+]
+
+# ------------------------------------------------------------------------------------------
+# Assembly and ELF relocations
+# ------------------------------------------------------------------------------------------
+
+
+def read_elf(data):
+    """Returns the sections of a relocatable ELF64 file as {name: (type, link, info, bytes)}"""
+    shoff, = struct.unpack_from("<Q", data, 0x28)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x3A)
+    headers = [struct.unpack_from("<IIQQQQIIQQ", data, shoff + i * shentsize)
+               for i in range(shnum)]
+    strtab = headers[shstrndx]
+    names = data[strtab[4]:strtab[4] + strtab[5]]
+
+    sections = []
+    for (name, kind, _, _, offset, size, link, info, _, _) in headers:
+        end = names.index(b"\0", name)
+        sections.append((names[name:end].decode(), kind, link, info, data[offset:offset + size]))
+    return sections
+
+
+def assemble(target, triple, stencils):
+    """Returns {stencil: (bytes, [(offset, patch, hole, addend)])}"""
+    lines = []
+    for name in OPCODES + EXTRA:
+        lines.append('.section .text.{},"ax",@progbits'.format(name))
+        lines += ["    " + line for line in stencils[name]]
+    with tempfile.TemporaryDirectory() as tmp:
+        source = os.path.join(tmp, "stencils.s")
+        obj = os.path.join(tmp, "stencils.o")
+        with open(source, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        subprocess.check_call(["llvm-mc", "-triple=" + triple, "-filetype=obj", source, "-o",
+                               obj])
+        with open(obj, "rb") as f:
+            sections = read_elf(f.read())
+
+    symtab = [s for s in sections if s[1] == 2][0]  # SHT_SYMTAB
+    strtab = sections[symtab[2]][4]
+    symbols = []
+    for i in range(len(symtab[4]) // 24):
+        name, = struct.unpack_from("<I", symtab[4], i * 24)
+        symbols.append(strtab[name:strtab.index(b"\0", name)].decode())
+
+    res = {}
+    for index, (name, kind, _, _, code) in enumerate(sections):
+        if not name.startswith(".text."):
+            continue
+        patches = []
+        for (rname, rkind, _, info, relocs) in sections:
+            if rkind != 4 or info != index:  # SHT_RELA of this section
+                continue
+            for i in range(len(relocs) // 24):
+                offset, rinfo, addend = struct.unpack_from("<QQq", relocs, i * 24)
+                hole = symbols[rinfo >> 32]
+                rtype = rinfo & 0xffffffff
+                if hole not in HOLES or rtype not in RELOCS[target]:
+                    sys.exit("stencil {}: unexpected relocation {} on {}".format(name, rtype,
+                                                                                 hole))
+                patches.append((offset, RELOCS[target][rtype], HOLE_ENUMS[HOLES.index(hole)],
+                                addend))
+        res[name[len(".text."):]] = (code, sorted(patches))
+    return res
+
+
+# ------------------------------------------------------------------------------------------
+# Header generation
+# ------------------------------------------------------------------------------------------
+
+LICENSE = """/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+"""
+
+
+def write_table(out, ctype, name, values, per_line):
+    out.append("static const {} {}[] = {{".format(ctype, name))
+    for i in range(0, len(values), per_line):
+        out.append("    " + " ".join(v + "," for v in values[i:i + per_line]))
+    out.append("};")
+    out.append("")
+
+
+def write_stencils(out, suffix, stencils):
+    # Identical stencils (the calls of math functions) share their code and patches
+    code, patches, table, shared = bytearray(), [], [], {}
+    for name in OPCODES + EXTRA:
+        key = (bytes(stencils[name][0]), tuple(stencils[name][1]))
+        if key not in shared:
+            shared[key] = (len(code), len(stencils[name][0]), len(patches),
+                           len(stencils[name][1]))
+            code += stencils[name][0]
+            patches += stencils[name][1]
+        table.append("{{{}, {}, {}, {}}}".format(*shared[key]))
+
+    write_table(out, "unsigned char", "gFBCStencilCode" + suffix,
+                ["0x{:02x}".format(b) for b in code], 16)
+    write_table(out, "FBCStencilPatch", "gFBCStencilPatches" + suffix,
+                ["{{{}, {}, {}, {}}}".format(*p) for p in patches], 3)
+    write_table(out, "FBCStencil", "gFBCStencils" + suffix, table, 4)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("-o", "--output", default=os.path.join(os.path.dirname(
+        os.path.abspath(__file__)), "fbc_stencils.hh"))
+    args = parser.parse_args()
+
+    out = [LICENSE, "// Generated by fbc_stencils.py, do not edit", "",
+           "#ifndef _FBC_STENCILS_H", "#define _FBC_STENCILS_H", "",
+           "/*",
+           " Stencils of the FBC template compiler: the machine code of each register code",
+           " instruction (see FBCRegisterInstruction), followed by the function entry and the",
+           " moves of constants. The holes of a stencil are patched with its operands.",
+           "*/", "",
+           "#define FBC_STENCILS(S) \\"]
+    out += ["    S({}) \\".format(name) for name in OPCODES + EXTRA]
+    out += ["", "enum FBCStencilPatchKind {"]
+    out += ["    {},".format(kind) for kind in PATCH_ENUMS]
+    out += ["};", "", "enum FBCStencilHole {"]
+    out += ["    {},".format(hole) for hole in HOLE_ENUMS]
+    out += ["};", "",
+            "struct FBCStencilPatch {",
+            "    int fOffset;  // In the stencil code",
+            "    int fKind;",
+            "    int fHole;",
+            "    int fAddend;",
+            "};", "",
+            "struct FBCStencil {",
+            "    int fCode;  // Start in the code table",
+            "    int fSize;",
+            "    int fPatches;  // Start in the patches table",
+            "    int fPatchCount;",
+            "};", ""]
+
+    for i, (target, triple, condition, generator) in enumerate(TARGETS):
+        out.append("{} {}".format("#if" if i == 0 else "#elif", condition))
+        out.append("")
+        out.append('#define FBC_STENCILS_TARGET "{}"'.format(target))
+        out.append("")
+        for real in ("float", "double"):
+            write_stencils(out, real.capitalize(), assemble(target, triple, generator(real)))
+    out += ["#endif", "", "#endif", ""]
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
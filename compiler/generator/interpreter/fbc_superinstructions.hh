@@ -0,0 +1,73 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+// Generated by fbc_superinstructions.py, do not edit
+
+#ifndef _FBC_SUPERINSTRUCTIONS_H
+#define _FBC_SUPERINSTRUCTIONS_H
+
+/*
+ Superinstructions of the FBC interpreter: each of them replaces a sequence of (up to 4)
+ instructions in the flat blocks, when not in trace mode. The int operands of the fused
+ instructions are moved in the fOffset1, fOffset2, fBranch1, fBranch2 and fIntValue fields
+ (in this order), and their only real operand in fRealValue.
+
+ Profile: 425 loop bodies and branches from 85 DSP blocks
+ Dispatches per sample for the profile: 31002 -> 16895
+
+ S(name, size, opcode1, operands1, ..., opcode4, operands4)
+*/
+
+#define FBC_SUPERINSTRUCTIONS(S) \
+    S(kSuperMultRealHeapMultRealHeapAddReal, 3, kMultRealHeap, 3, kMultRealHeap, 3, kAddReal, 0, kNop, 0) \
+    S(kSuperMultRealHeapAddRealMultRealStack, 3, kMultRealHeap, 3, kAddReal, 0, kMultRealStack, 1, kNop, 0) \
+    S(kSuperSubRealStoreReal, 2, kSubReal, 0, kStoreReal, 1, kNop, 0, kNop, 0) \
+    S(kSuperPairMoveRealPairMoveReal, 2, kPairMoveReal, 3, kPairMoveReal, 3, kNop, 0, kNop, 0) \
+    S(kSuperMultRealStackSubRealStackStoreReal, 3, kMultRealStack, 1, kSubRealStack, 1, kStoreReal, 1, kNop, 0) \
+    S(kSuperAddRealStackAddRealStackAddRealStackAddRealStack, 4, kAddRealStack, 1, kAddRealStack, 1, kAddRealStack, 1, kAddRealStack, 1) \
+    S(kSuperMultRealStackMultRealStackValueStoreReal, 3, kMultRealStack, 1, kMultRealStackValue, 8, kStoreReal, 1, kNop, 0) \
+    S(kSuperRealValueLoadIntLoadInputMultReal, 4, kRealValue, 8, kLoadInt, 1, kLoadInput, 1, kMultReal, 0) \
+    S(kSuperSubIntHeapANDIntStackValueLoadIndexedReal, 3, kSubIntHeap, 3, kANDIntStackValue, 4, kLoadIndexedReal, 1, kNop, 0) \
+    S(kSuperMultRealHeapAddRealStackMultRealStack, 3, kMultRealHeap, 3, kAddRealStack, 1, kMultRealStack, 1, kNop, 0) \
+    S(kSuperAddRealStoreRealRealValueLog10fHeap, 4, kAddReal, 0, kStoreReal, 1, kRealValue, 8, kLog10fHeap, 1) \
+    S(kSuperLoadIntStoreOutput, 2, kLoadInt, 1, kStoreOutput, 1, kNop, 0, kNop, 0) \
+    S(kSuperPairMoveRealMoveReal, 2, kPairMoveReal, 3, kMoveReal, 3, kNop, 0, kNop, 0) \
+    S(kSuperAddRealStackANDIntValueStoreIndexedReal, 3, kAddRealStack, 1, kANDIntValue, 5, kStoreIndexedReal, 1, kNop, 0) \
+    S(kSuperMultRealHeapAddRealMultRealHeapAddReal, 4, kMultRealHeap, 3, kAddReal, 0, kMultRealHeap, 3, kAddReal, 0) \
+    S(kSuperAddRealStackStoreReal, 2, kAddRealStack, 1, kStoreReal, 1, kNop, 0, kNop, 0) \
+    S(kSuperAddRealStackMultRealStack, 2, kAddRealStack, 1, kMultRealStack, 1, kNop, 0, kNop, 0) \
+    S(kSuperSubRealHeapMultRealStackMultRealHeapSubReal, 4, kSubRealHeap, 3, kMultRealStack, 1, kMultRealHeap, 3, kSubReal, 0) \
+    S(kSuperMoveRealMoveReal, 2, kMoveReal, 3, kMoveReal, 3, kNop, 0, kNop, 0) \
+    S(kSuperStoreRealMultRealHeap, 2, kStoreReal, 1, kMultRealHeap, 3, kNop, 0, kNop, 0) \
+    S(kSuperStoreRealMoveReal, 2, kStoreReal, 1, kMoveReal, 3, kNop, 0, kNop, 0) \
+    S(kSuperAddIntValueStoreIntLTIntHeap, 3, kAddIntValue, 5, kStoreInt, 1, kLTIntHeap, 3, kNop, 0) \
+    S(kSuperAddRealHeapMultRealHeapSubReal, 3, kAddRealHeap, 3, kMultRealHeap, 3, kSubReal, 0, kNop, 0) \
+    S(kSuperLoadRealSubRealHeapMultRealStackDivReal, 4, kLoadReal, 1, kSubRealHeap, 3, kMultRealStack, 1, kDivReal, 0) \
+    S(kSuperLoadIntLoadInput, 2, kLoadInt, 1, kLoadInput, 1, kNop, 0, kNop, 0) \
+    S(kSuperMultRealHeapLoadReal, 2, kMultRealHeap, 3, kLoadReal, 1, kNop, 0, kNop, 0) \
+    S(kSuperAbsfMultReal, 2, kAbsf, 0, kMultReal, 0, kNop, 0, kNop, 0) \
+    S(kSuperStoreRealLoadReal, 2, kStoreReal, 1, kLoadReal, 1, kNop, 0, kNop, 0) \
+    S(kSuperMultRealValueAddReal, 2, kMultRealValue, 9, kAddReal, 0, kNop, 0, kNop, 0) \
+    S(kSuperStoreRealMultRealValue, 2, kStoreReal, 1, kMultRealValue, 9, kNop, 0, kNop, 0) \
+    S(kSuperANDIntValueStoreIndexedReal, 2, kANDIntValue, 5, kStoreIndexedReal, 1, kNop, 0, kNop, 0) \
+    S(kSuperLoadRealSubRealHeapDivReal, 3, kLoadReal, 1, kSubRealHeap, 3, kDivReal, 0, kNop, 0)
+
+#endif
@@ -0,0 +1,407 @@
+#!/usr/bin/env python3
+"""
+Synthesize the FBC interpreter superinstructions.
+
+The most frequent opcode sequences are mined from the optimized 'DSP' blocks of a corpus
+of DSP programs, then fused opcodes are generated with their handlers:
+
+    - fbc_superinstructions.hh: the FBC_SUPERINSTRUCTIONS list, used to extend the opcode
+      enum and by FBCFlatBlock to rewrite the matching sequences
+    - fbc_superinstructions_exec.hh: the handlers, included in FBCInterpreter::executeBlock
+
+The profile is written with the -profile option of interp-tracer (see tools/benchmark), for
+instance on the impulse tests:
+
+    cd tests/impulse-tests/dsp
+    for f in *.dsp; do interp-tracer -profile /tmp/profile.txt -I . -double $f > /dev/null; done
+    python3 ../../../compiler/generator/interpreter/fbc_superinstructions.py /tmp/profile.txt
+
+Instructions executed at each sample (in the DSP loop body and its branches) have a weight of 1,
+the others are ignored. A superinstruction is then selected by saved dispatches per sample
+(weight * (length - 1)), the sequences it covers are fused the way FBCFlatBlock does it (left
+to right, first matching superinstruction in the list order), and the remaining sequences are
+counted again. Ties are broken on the opcode names, so the result only depends on the profile.
+"""
+
+import argparse
+import os
+import re
+import sys
+from collections import Counter
+
+MAX_LENGTH = 4
+MAX_SUPERINSTRUCTIONS = 32
+
+# Operands of an instruction, same values as in interpreter_bytecode.hh
+OFFSET1, OFFSET2, INT, REAL = 1, 2, 4, 8
+
+# Fields of a superinstruction used for the int operands of its instructions, in order
+INT_SLOTS = ["fOffset1", "fOffset2", "fBranch1", "fBranch2", "fIntValue"]
+
+# ------------------------------------------------------------------------------------------
+# Templates of the fusable instructions, they follow the 'TRACE == 0' FBCInterpreter handlers
+#
+#   pops : types of the popped values ('I' or 'R'), {v1} being the top of the stack
+#   res  : type of the pushed value, or None for a statement
+#   code : expression (or statement) using {v1}, {v2}, {o1}, {o2}, {i} and {r}
+# ------------------------------------------------------------------------------------------
+
+TEMPLATES = {}
+
+
+def template(name, pops, res, code):
+    operands = 0
+    for key, mask in (("{o1}", OFFSET1), ("{o2}", OFFSET2), ("{i}", INT), ("{r}", REAL)):
+        if key in code:
+            operands |= mask
+    TEMPLATES[name] = (pops, res, code, operands)
+
+
+def heap(kind, index):
+    return ("fRealHeap[{}]" if kind == "R" else "fIntHeap[{}]").format(index)
+
+
+# Numbers and memory
+template("kRealValue", [], "R", "{r}")
+template("kInt32Value", [], "I", "{i}")
+for kind, name in (("R", "Real"), ("I", "Int")):
+    template("kLoad" + name, [], kind, heap(kind, "{o1}"))
+    template("kStore" + name, [kind], None, heap(kind, "{o1}") + " = {v1};")
+    template("kStore" + name + "Value", [], None,
+             heap(kind, "{o1}") + " = " + ("{r}" if kind == "R" else "{i}") + ";")
+    template("kLoadIndexed" + name, ["I"], kind, heap(kind, "{o1} + {v1}"))
+    template("kStoreIndexed" + name, ["I", kind], None, heap(kind, "{o1} + {v1}") + " = {v2};")
+    template("kMove" + name, [], None, heap(kind, "{o1}") + " = " + heap(kind, "{o2}") + ";")
+    template("kPairMove" + name, [], None,
+             heap(kind, "{o1}") + " = " + heap(kind, "{o1} - 1") + "; " +
+             heap(kind, "{o2}") + " = " + heap(kind, "{o2} - 1") + ";")
+template("kLoadInput", ["I"], "R", "fInputs[{o1}][{v1}]")
+template("kStoreOutput", ["I", "R"], None, "fOutputs[{o1}][{v1}] = {v2};")
+
+# Cast
+template("kCastReal", ["I"], "R", "REAL({v1})")
+template("kCastRealHeap", [], "R", "REAL(fIntHeap[{o1}])")
+template("kCastInt", ["R"], "I", "int({v1})")
+template("kCastIntHeap", [], "I", "int(fRealHeap[{o1}])")
+
+
+# Binary operations in their 'stack', 'heap', 'value' and 'invert' versions
+def binary(name, kind, res, fmt, forms):
+    value = "{r}" if kind == "R" else "{i}"
+    operands = {
+        "": ("{v1}", "{v2}", [kind, kind]),
+        "Heap": (heap(kind, "{o1}"), heap(kind, "{o2}"), []),
+        "Stack": (heap(kind, "{o1}"), "{v1}", [kind]),
+        "StackValue": (value, "{v1}", [kind]),
+        "Value": (value, heap(kind, "{o1}"), []),
+        "ValueInvert": (heap(kind, "{o1}"), value, []),
+    }
+    for form in forms:
+        a, b, pops = operands[form]
+        template(name + form, pops, res, fmt.format(a, b))
+
+
+ALL_FORMS = ["", "Heap", "Stack", "StackValue", "Value"]
+INVERT_FORMS = ALL_FORMS + ["ValueInvert"]
+
+for kind, name in (("R", "Real"), ("I", "Int")):
+    binary("kAdd" + name, kind, kind, "{} + {}", ALL_FORMS)
+    binary("kSub" + name, kind, kind, "{} - {}", INVERT_FORMS)
+    binary("kMult" + name, kind, kind, "{} * {}", ALL_FORMS)
+    binary("kDiv" + name, kind, kind, "{} / {}", INVERT_FORMS)
+    for op, fmt in (("GT", "{} > {}"), ("LT", "{} < {}"), ("GE", "{} >= {}"), ("LE", "{} <= {}")):
+        binary("k" + op + name, kind, "I", fmt, INVERT_FORMS)
+    binary("kEQ" + name, kind, "I", "{} == {}", ALL_FORMS)
+    binary("kNE" + name, kind, "I", "{} != {}", ALL_FORMS)
+binary("kRemReal", "R", "R", "std::remainder({}, {})", INVERT_FORMS)
+binary("kRemInt", "I", "I", "{} % {}", INVERT_FORMS)
+binary("kLshInt", "I", "I", "{} << {}", INVERT_FORMS)
+binary("kARshInt", "I", "I", "{} >> {}", INVERT_FORMS)
+binary("kLRshInt", "I", "I", "{} >> {}", INVERT_FORMS)
+binary("kANDInt", "I", "I", "{} & {}", ALL_FORMS)
+binary("kORInt", "I", "I", "{} | {}", ALL_FORMS)
+binary("kXORInt", "I", "I", "{} ^ {}", ALL_FORMS)
+
+for name, fun, forms in (("kAtan2f", "std::atan2", INVERT_FORMS), ("kFmodf", "std::fmod", INVERT_FORMS),
+                         ("kPowf", "std::pow", INVERT_FORMS), ("kMaxf", "std::max", ALL_FORMS),
+                         ("kMinf", "std::min", ALL_FORMS)):
+    binary(name, "R", "R", fun + "({}, {})", forms)
+binary("kMax", "I", "I", "std::max({}, {})", ALL_FORMS)
+binary("kMin", "I", "I", "std::min({}, {})", ALL_FORMS)
+
+# Extended unary math, with their 'heap' version
+template("kAbs", ["I"], "I", "std::abs({v1})")
+template("kAbsHeap", [], "I", "std::abs(fIntHeap[{o1}])")
+for name, fun in (("kAbsf", "std::fabs"), ("kAcosf", "std::acos"), ("kAcoshf", "std::acosh"),
+                  ("kAsinf", "std::asin"), ("kAsinhf", "std::asinh"), ("kAtanf", "std::atan"),
+                  ("kAtanhf", "std::atanh"), ("kCeilf", "std::ceil"), ("kCosf", "std::cos"),
+                  ("kCoshf", "std::cosh"), ("kExpf", "std::exp"), ("kFloorf", "std::floor"),
+                  ("kLogf", "std::log"), ("kLog10f", "std::log10"), ("kRintf", "std::rint"),
+                  ("kRoundf", "std::round"), ("kSinf", "std::sin"), ("kSinhf", "std::sinh"),
+                  ("kSqrtf", "std::sqrt"), ("kTanf", "std::tan"), ("kTanhf", "std::tanh")):
+    template(name, ["R"], "R", fun + "({v1})")
+    template(name + "Heap", [], "R", fun + "(fRealHeap[{o1}])")
+
+# ------------------------------------------------------------------------------------------
+# Profile
+# ------------------------------------------------------------------------------------------
+
+BRANCHING = {"kLoop", "kIf", "kSelectReal", "kSelectInt"}
+
+
+class Instruction:
+    def __init__(self, name, weight):
+        self.name = name
+        self.weight = weight
+
+
+def read_block(lines, pos, weight, sequences, in_loop):
+    """Read a block written by FBCBlockInstruction::write, returns the next line position."""
+    size = int(lines[pos].split()[1])
+    pos += 1
+    sequence = []
+    for _ in range(size):
+        tokens = lines[pos].split()
+        name = tokens[2]
+        pos += 1
+        if name in ("kBlockStoreReal", "kBlockStoreInt"):
+            pos += 1  # values line
+        sequence.append(Instruction(name, weight))
+        if name in BRANCHING:
+            # Loop : variable declaration then body, If/Select : up to two branches
+            branch = 0
+            while pos < len(lines) and lines[pos].startswith("block_size") and branch < 2:
+                body = (name == "kLoop" and branch == 1) or (name != "kLoop" and in_loop)
+                pos = read_block(lines, pos, 1 if body else 0, sequences, body)
+                branch += 1
+    sequences.append(sequence)
+    return pos
+
+
+def read_profile(files):
+    """Returns the instruction sequences and the number of different DSP blocks."""
+    blocks = {}
+    for file in files:
+        with open(file) as f:
+            lines = f.read().splitlines()
+        pos = 0
+        while pos < len(lines):
+            if lines[pos].startswith("dsp_block"):
+                start = pos + 1
+                sequences = []
+                pos = read_block(lines, start, 0, sequences, False)
+                # A same DSP may be compiled several times by the host
+                blocks.setdefault("\n".join(lines[start:pos]), sequences)
+            else:
+                pos += 1
+    return [seq for key in sorted(blocks) for seq in blocks[key]], len(blocks)
+
+
+# ------------------------------------------------------------------------------------------
+# Selection
+# ------------------------------------------------------------------------------------------
+
+
+def is_fusable(names):
+    if any(name not in TEMPLATES for name in names):
+        return False
+    ints = 0
+    reals = 0
+    for name in names:
+        operands = TEMPLATES[name][3]
+        ints += bin(operands & (OFFSET1 | OFFSET2 | INT)).count("1")
+        reals += 1 if operands & REAL else 0
+    return ints <= len(INT_SLOTS) and reals <= 1
+
+
+def fuse(sequence, selected):
+    """Split a sequence in fused and not fused instructions, the same way as FBCFlatBlock."""
+    res = []
+    pos = 0
+    while pos < len(sequence):
+        for pattern in selected:
+            names = tuple(inst.name for inst in sequence[pos:pos + len(pattern)])
+            if names == pattern:
+                res.append((pattern, sequence[pos].weight))
+                pos += len(pattern)
+                break
+        else:
+            res.append((sequence[pos].name, sequence[pos].weight))
+            pos += 1
+    return res
+
+
+def count_dispatches(sequences, selected):
+    return sum(weight for seq in sequences for (_, weight) in fuse(seq, selected))
+
+
+def select(sequences, count):
+    selected = []
+    while len(selected) < count:
+        gains = Counter()
+        for seq in sequences:
+            fused = fuse(seq, selected)
+            for start in range(len(fused)):
+                for length in range(2, MAX_LENGTH + 1):
+                    window = fused[start:start + length]
+                    if len(window) < length or any(isinstance(n, tuple) for (n, _) in window):
+                        break
+                    names = tuple(n for (n, _) in window)
+                    if window[0][1] > 0 and is_fusable(names):
+                        gains[names] += window[0][1] * (length - 1)
+        if not gains:
+            break
+        best = sorted(gains.items(), key=lambda item: (-item[1], item[0]))[0]
+        selected.append(best[0])
+    return selected
+
+
+# ------------------------------------------------------------------------------------------
+# Code generation
+# ------------------------------------------------------------------------------------------
+
+HEADER = """/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+// Generated by fbc_superinstructions.py, do not edit
+"""
+
+
+def get_name(pattern):
+    return "kSuper" + "".join(name[1:] for name in pattern)
+
+
+def get_handler(pattern):
+    lines = []
+    stacks = {"I": [], "R": []}
+    temps = {"I": 0, "R": 0}
+    slot = 0
+
+    def new_temp(kind):
+        temp = ("r" if kind == "R" else "i") + str(temps[kind])
+        temps[kind] += 1
+        return temp
+
+    for name in pattern:
+        pops, res, code, operands = TEMPLATES[name]
+        args = {}
+        for key, mask in (("o1", OFFSET1), ("o2", OFFSET2), ("i", INT)):
+            if operands & mask:
+                args[key] = "it->" + INT_SLOTS[slot]
+                slot += 1
+        args["r"] = "it->fRealValue"
+        for index, kind in enumerate(pops):
+            key = "v" + str(index + 1)
+            if stacks[kind]:
+                args[key] = stacks[kind].pop()
+            else:
+                # Values below the ones of the superinstruction are popped in order
+                temp = new_temp(kind)
+                pop = "popReal(it)" if kind == "R" else "popInt()"
+                lines.append("{} {} = {};".format("REAL" if kind == "R" else "int", temp, pop))
+                args[key] = temp
+        code = code.format(**args)
+        if res:
+            temp = new_temp(res)
+            lines.append("{} {} = {};".format("REAL" if res == "R" else "int", temp, code))
+            stacks[res].append(temp)
+        else:
+            lines.extend(re.split(r"(?<=;) ", code))
+    for temp in stacks["I"]:
+        lines.append("pushInt({});".format(temp))
+    for temp in stacks["R"]:
+        lines.append("pushReal(it, {});".format(temp))
+    return lines
+
+
+def write_list(out, selected, sequences, dsps):
+    before = count_dispatches(sequences, [])
+    after = count_dispatches(sequences, selected)
+    out.write(HEADER)
+    out.write("""
+#ifndef _FBC_SUPERINSTRUCTIONS_H
+#define _FBC_SUPERINSTRUCTIONS_H
+
+/*
+ Superinstructions of the FBC interpreter: each of them replaces a sequence of (up to 4)
+ instructions in the flat blocks, when not in trace mode. The int operands of the fused
+ instructions are moved in the fOffset1, fOffset2, fBranch1, fBranch2 and fIntValue fields
+ (in this order), and their only real operand in fRealValue.
+
+ Profile: {blocks} loop bodies and branches from {dsps} DSP blocks
+ Dispatches per sample for the profile: {before} -> {after}
+
+ S(name, size, opcode1, operands1, ..., opcode4, operands4)
+*/
+
+#define FBC_SUPERINSTRUCTIONS(S) \\
+""".format(blocks=sum(1 for seq in sequences if seq and seq[0].weight), dsps=dsps,
+           before=before, after=after))
+    entries = []
+    for pattern in selected:
+        args = [get_name(pattern), str(len(pattern))]
+        for index in range(MAX_LENGTH):
+            if index < len(pattern):
+                args += [pattern[index], str(TEMPLATES[pattern[index]][3])]
+            else:
+                args += ["kNop", "0"]
+        entries.append("    S(" + ", ".join(args) + ")")
+    out.write(" \\\n".join(entries))
+    out.write("\n\n#endif\n")
+
+
+def write_handlers(out, selected):
+    out.write(HEADER)
+    out.write("""
+/*
+ Handlers of the superinstructions, included in the FBCInterpreter::executeBlock dispatch loops
+ with 'superLabel' and 'dispatchNextScal' defined.
+*/
+""")
+    for pattern in selected:
+        out.write("\n    // " + " ".join(pattern) + "\n")
+        out.write("    superLabel({}) : {{\n".format(get_name(pattern)))
+        for line in get_handler(pattern):
+            out.write("        " + line + "\n")
+        out.write("        dispatchNextScal();\n    }\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Synthesize the FBC interpreter superinstructions")
+    parser.add_argument("profiles", nargs="+", help="files written with interp-tracer -profile")
+    parser.add_argument("-n", type=int, default=MAX_SUPERINSTRUCTIONS, help="number of superinstructions")
+    parser.add_argument("-o", default=os.path.dirname(os.path.abspath(__file__)), help="output folder")
+    args = parser.parse_args()
+
+    sequences, dsps = read_profile(args.profiles)
+    selected = select(sequences, args.n)
+
+    with open(os.path.join(args.o, "fbc_superinstructions.hh"), "w") as out:
+        write_list(out, selected, sequences, dsps)
+    with open(os.path.join(args.o, "fbc_superinstructions_exec.hh"), "w") as out:
+        write_handlers(out, selected)
+
+    for pattern in selected:
+        print(get_name(pattern), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,320 @@
+/************************************************************************
+ ************************************************************************
+    FAUST compiler
+    Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+    ---------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+// Generated by fbc_superinstructions.py, do not edit
+
+/*
+ Handlers of the superinstructions, included in the FBCInterpreter::executeBlock dispatch loops
+ with 'superLabel' and 'dispatchNextScal' defined.
+*/
+
+    // kMultRealHeap kMultRealHeap kAddReal
+    superLabel(kSuperMultRealHeapMultRealHeapAddReal) : {
+        REAL r0 = fRealHeap[it->fOffset1] * fRealHeap[it->fOffset2];
+        REAL r1 = fRealHeap[it->fBranch1] * fRealHeap[it->fBranch2];
+        REAL r2 = r1 + r0;
+        pushReal(it, r2);
+        dispatchNextScal();
+    }
+
+    // kMultRealHeap kAddReal kMultRealStack
+    superLabel(kSuperMultRealHeapAddRealMultRealStack) : {
+        REAL r0 = fRealHeap[it->fOffset1] * fRealHeap[it->fOffset2];
+        REAL r1 = popReal(it);
+        REAL r2 = r0 + r1;
+        REAL r3 = fRealHeap[it->fBranch1] * r2;
+        pushReal(it, r3);
+        dispatchNextScal();
+    }
+
+    // kSubReal kStoreReal
+    superLabel(kSuperSubRealStoreReal) : {
+        REAL r0 = popReal(it);
+        REAL r1 = popReal(it);
+        REAL r2 = r0 - r1;
+        fRealHeap[it->fOffset1] = r2;
+        dispatchNextScal();
+    }
+
+    // kPairMoveReal kPairMoveReal
+    superLabel(kSuperPairMoveRealPairMoveReal) : {
+        fRealHeap[it->fOffset1] = fRealHeap[it->fOffset1 - 1];
+        fRealHeap[it->fOffset2] = fRealHeap[it->fOffset2 - 1];
+        fRealHeap[it->fBranch1] = fRealHeap[it->fBranch1 - 1];
+        fRealHeap[it->fBranch2] = fRealHeap[it->fBranch2 - 1];
+        dispatchNextScal();
+    }
+
+    // kMultRealStack kSubRealStack kStoreReal
+    superLabel(kSuperMultRealStackSubRealStackStoreReal) : {
+        REAL r0 = popReal(it);
+        REAL r1 = fRealHeap[it->fOffset1] * r0;
+        REAL r2 = fRealHeap[it->fOffset2] - r1;
+        fRealHeap[it->fBranch1] = r2;
+        dispatchNextScal();
+    }
+
+    // kAddRealStack kAddRealStack kAddRealStack kAddRealStack
+    superLabel(kSuperAddRealStackAddRealStackAddRealStackAddRealStack) : {
+        REAL r0 = popReal(it);
+        REAL r1 = fRealHeap[it->fOffset1] + r0;
+        REAL r2 = fRealHeap[it->fOffset2] + r1;
+        REAL r3 = fRealHeap[it->fBranch1] + r2;
+        REAL r4 = fRealHeap[it->fBranch2] + r3;
+        pushReal(it, r4);
+        dispatchNextScal();
+    }
+
+    // kMultRealStack kMultRealStackValue kStoreReal
+    superLabel(kSuperMultRealStackMultRealStackValueStoreReal) : {
+        REAL r0 = popReal(it);
+        REAL r1 = fRealHeap[it->fOffset1] * r0;
+        REAL r2 = it->fRealValue * r1;
+        fRealHeap[it->fOffset2] = r2;
+        dispatchNextScal();
+    }
+
+    // kRealValue kLoadInt kLoadInput kMultReal
+    superLabel(kSuperRealValueLoadIntLoadInputMultReal) : {
+        REAL r0 = it->fRealValue;
+        int i0 = fIntHeap[it->fOffset1];
+        REAL r1 = fInputs[it->fOffset2][i0];
+        REAL r2 = r1 * r0;
+        pushReal(it, r2);
+        dispatchNextScal();
+    }
+
+    // kSubIntHeap kANDIntStackValue kLoadIndexedReal
+    superLabel(kSuperSubIntHeapANDIntStackValueLoadIndexedReal) : {
+        int i0 = fIntHeap[it->fOffset1] - fIntHeap[it->fOffset2];
+        int i1 = it->fBranch1 & i0;
+        REAL r0 = fRealHeap[it->fBranch2 + i1];
+        pushReal(it, r0);
+        dispatchNextScal();
+    }
+
+    // kMultRealHeap kAddRealStack kMultRealStack
+    superLabel(kSuperMultRealHeapAddRealStackMultRealStack) : {
+        REAL r0 = fRealHeap[it->fOffset1] * fRealHeap[it->fOffset2];
+        REAL r1 = fRealHeap[it->fBranch1] + r0;
+        REAL r2 = fRealHeap[it->fBranch2] * r1;
+        pushReal(it, r2);
+        dispatchNextScal();
+    }
+
+    // kAddReal kStoreReal kRealValue kLog10fHeap
+    superLabel(kSuperAddRealStoreRealRealValueLog10fHeap) : {
+        REAL r0 = popReal(it);
+        REAL r1 = popReal(it);
+        REAL r2 = r0 + r1;
+        fRealHeap[it->fOffset1] = r2;
+        REAL r3 = it->fRealValue;
+        REAL r4 = std::log10(fRealHeap[it->fOffset2]);
+        pushReal(it, r3);
+        pushReal(it, r4);
+        dispatchNextScal();
+    }
+
+    // kLoadInt kStoreOutput
+    superLabel(kSuperLoadIntStoreOutput) : {
+        int i0 = fIntHeap[it->fOffset1];
+        REAL r0 = popReal(it);
+        fOutputs[it->fOffset2][i0] = r0;
+        dispatchNextScal();
+    }
+
+    // kPairMoveReal kMoveReal
+    superLabel(kSuperPairMoveRealMoveReal) : {
+        fRealHeap[it->fOffset1] = fRealHeap[it->fOffset1 - 1];
+        fRealHeap[it->fOffset2] = fRealHeap[it->fOffset2 - 1];
+        fRealHeap[it->fBranch1] = fRealHeap[it->fBranch2];
+        dispatchNextScal();
+    }
+
+    // kAddRealStack kANDIntValue kStoreIndexedReal
+    superLabel(kSuperAddRealStackANDIntValueStoreIndexedReal) : {
+        REAL r0 = popReal(it);
+        REAL r1 = fRealHeap[it->fOffset1] + r0;
+        int i0 = it->fBranch1 & fIntHeap[it->fOffset2];
+        fRealHeap[it->fBranch2 + i0] = r1;
+        dispatchNextScal();
+    }
+
+    // kMultRealHeap kAddReal kMultRealHeap kAddReal
+    superLabel(kSuperMultRealHeapAddRealMultRealHeapAddReal) : {
+        REAL r0 = fRealHeap[it->fOffset1] * fRealHeap[it->fOffset2];
+        REAL r1 = popReal(it);
+        REAL r2 = r0 + r1;
+        REAL r3 = fRealHeap[it->fBranch1] * fRealHeap[it->fBranch2];
+        REAL r4 = r3 + r2;
+        pushReal(it, r4);
+        dispatchNextScal();
+    }
+
+    // kAddRealStack kStoreReal
+    superLabel(kSuperAddRealStackStoreReal) : {
+        REAL r0 = popReal(it);
+        REAL r1 = fRealHeap[it->fOffset1] + r0;
+        fRealHeap[it->fOffset2] = r1;
+        dispatchNextScal();
+    }
+
+    // kAddRealStack kMultRealStack
+    superLabel(kSuperAddRealStackMultRealStack) : {
+        REAL r0 = popReal(it);
+        REAL r1 = fRealHeap[it->fOffset1] + r0;
+        REAL r2 = fRealHeap[it->fOffset2] * r1;
+        pushReal(it, r2);
+        dispatchNextScal();
+    }
+
+    // kSubRealHeap kMultRealStack kMultRealHeap kSubReal
+    superLabel(kSuperSubRealHeapMultRealStackMultRealHeapSubReal) : {
+        REAL r0 = fRealHeap[it->fOffset1] - fRealHeap[it->fOffset2];
+        REAL r1 = fRealHeap[it->fBranch1] * r0;
+        REAL r2 = fRealHeap[it->fBranch2] * fRealHeap[it->fIntValue];
+        REAL r3 = r2 - r1;
+        pushReal(it, r3);
+        dispatchNextScal();
+    }
+
+    // kMoveReal kMoveReal
+    superLabel(kSuperMoveRealMoveReal) : {
+        fRealHeap[it->fOffset1] = fRealHeap[it->fOffset2];
+        fRealHeap[it->fBranch1] = fRealHeap[it->fBranch2];
+        dispatchNextScal();
+    }
+
+    // kStoreReal kMultRealHeap
+    superLabel(kSuperStoreRealMultRealHeap) : {
+        REAL r0 = popReal(it);
+        fRealHeap[it->fOffset1] = r0;
+        REAL r1 = fRealHeap[it->fOffset2] * fRealHeap[it->fBranch1];
+        pushReal(it, r1);
+        dispatchNextScal();
+    }
+
+    // kStoreReal kMoveReal
+    superLabel(kSuperStoreRealMoveReal) : {
+        REAL r0 = popReal(it);
+        fRealHeap[it->fOffset1] = r0;
+        fRealHeap[it->fOffset2] = fRealHeap[it->fBranch1];
+        dispatchNextScal();
+    }
+
+    // kAddIntValue kStoreInt kLTIntHeap
+    superLabel(kSuperAddIntValueStoreIntLTIntHeap) : {
+        int i0 = it->fOffset2 + fIntHeap[it->fOffset1];
+        fIntHeap[it->fBranch1] = i0;
+        int i1 = fIntHeap[it->fBranch2] < fIntHeap[it->fIntValue];
+        pushInt(i1);
+        dispatchNextScal();
+    }
+
+    // kAddRealHeap kMultRealHeap kSubReal
+    superLabel(kSuperAddRealHeapMultRealHeapSubReal) : {
+        REAL r0 = fRealHeap[it->fOffset1] + fRealHeap[it->fOffset2];
+        REAL r1 = fRealHeap[it->fBranch1] * fRealHeap[it->fBranch2];
+        REAL r2 = r1 - r0;
+        pushReal(it, r2);
+        dispatchNextScal();
+    }
+
+    // kLoadReal kSubRealHeap kMultRealStack kDivReal
+    superLabel(kSuperLoadRealSubRealHeapMultRealStackDivReal) : {
+        REAL r0 = fRealHeap[it->fOffset1];
+        REAL r1 = fRealHeap[it->fOffset2] - fRealHeap[it->fBranch1];
+        REAL r2 = fRealHeap[it->fBranch2] * r1;
+        REAL r3 = r2 / r0;
+        pushReal(it, r3);
+        dispatchNextScal();
+    }
+
+    // kLoadInt kLoadInput
+    superLabel(kSuperLoadIntLoadInput) : {
+        int i0 = fIntHeap[it->fOffset1];
+        REAL r0 = fInputs[it->fOffset2][i0];
+        pushReal(it, r0);
+        dispatchNextScal();
+    }
+
+    // kMultRealHeap kLoadReal
+    superLabel(kSuperMultRealHeapLoadReal) : {
+        REAL r0 = fRealHeap[it->fOffset1] * fRealHeap[it->fOffset2];
+        REAL r1 = fRealHeap[it->fBranch1];
+        pushReal(it, r0);
+        pushReal(it, r1);
+        dispatchNextScal();
+    }
+
+    // kAbsf kMultReal
+    superLabel(kSuperAbsfMultReal) : {
+        REAL r0 = popReal(it);
+        REAL r1 = std::fabs(r0);
+        REAL r2 = popReal(it);
+        REAL r3 = r1 * r2;
+        pushReal(it, r3);
+        dispatchNextScal();
+    }
+
+    // kStoreReal kLoadReal
+    superLabel(kSuperStoreRealLoadReal) : {
+        REAL r0 = popReal(it);
+        fRealHeap[it->fOffset1] = r0;
+        REAL r1 = fRealHeap[it->fOffset2];
+        pushReal(it, r1);
+        dispatchNextScal();
+    }
+
+    // kMultRealValue kAddReal
+    superLabel(kSuperMultRealValueAddReal) : {
+        REAL r0 = it->fRealValue * fRealHeap[it->fOffset1];
+        REAL r1 = popReal(it);
+        REAL r2 = r0 + r1;
+        pushReal(it, r2);
+        dispatchNextScal();
+    }
+
+    // kStoreReal kMultRealValue
+    superLabel(kSuperStoreRealMultRealValue) : {
+        REAL r0 = popReal(it);
+        fRealHeap[it->fOffset1] = r0;
+        REAL r1 = it->fRealValue * fRealHeap[it->fOffset2];
+        pushReal(it, r1);
+        dispatchNextScal();
+    }
+
+    // kANDIntValue kStoreIndexedReal
+    superLabel(kSuperANDIntValueStoreIndexedReal) : {
+        int i0 = it->fOffset2 & fIntHeap[it->fOffset1];
+        REAL r0 = popReal(it);
+        fRealHeap[it->fBranch1 + i0] = r0;
+        dispatchNextScal();
+    }
+
+    // kLoadReal kSubRealHeap kDivReal
+    superLabel(kSuperLoadRealSubRealHeapDivReal) : {
+        REAL r0 = fRealHeap[it->fOffset1];
+        REAL r1 = fRealHeap[it->fOffset2] - fRealHeap[it->fBranch1];
+        REAL r2 = r1 / r0;
+        pushReal(it, r2);
+        dispatchNextScal();
+    }
@@ -22,397 +22,337 @@
 #ifndef _FBC_TEMPLATE_COMPILER_H
 #define _FBC_TEMPLATE_COMPILER_H
 
-#include <stdio.h>
-#include <map>
-#include <string>
+#include <stdint.h>
+#include <string.h>
+#include <cmath>
+#include <vector>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "exception.hh"
 #include "fbc_executor.hh"
-#include "interpreter_bytecode.hh"
+#include "fbc_register_interpreter.hh"
+#include "fbc_stencils.hh"
 
 /*
- * FBC template compiler, where REAL will be either 'float' or 'double'
- * depending of the compiler option: -single or -double
- */
+ FBC template compiler, where REAL will be either 'float' or 'double' depending of the compiler
+ option: -single or -double
+
+ This is a copy-and-patch compiler: the block is lowered in register code (see FBCRegisterCode,
+ shared with the register interpreter), then the precompiled machine code of each instruction
+ (its stencil, see fbc_stencils.py) is copied in executable memory, and its holes are patched
+ with the heap offsets of its operands, its constant, the called math function or its jump
+ target. Every operand being a heap cell, the compiled code directly runs on the heaps of the
+ instance, where the registers and constants of the register code follow the DSP fields.
+
+ Stencils are available for x86-64 and AArch64 Linux, blocks that are not lowered in register
+ code (BlockStore, soundfiles) stay interpreted.
+*/
 template <class REAL>
 class FBCTemplateCompiler : public FBCExecuteFun<REAL> {
-   protected:
-    // Compile the FBC code used in 'compute'
-    void CompileBlock(FBCBlockInstruction<REAL>* block)
+   private:
+    typedef void (*compiledFun)(int* int_heap, REAL* real_heap, REAL** inputs, REAL** outputs);
+
+#define FBC_STENCIL_ID(name) name,
+    enum StencilID { FBC_STENCILS(FBC_STENCIL_ID) };
+#undef FBC_STENCIL_ID
+
+    static_assert(int(kEnter) == int(FBCRegisterInstruction::kReturn) + 1,
+                  "stencils must follow the FBCRegisterInstruction order");
+
+    compiledFun fCompiledFun;
+    void*       fCode;
+    size_t      fCodeSize;
+
+    // Math functions called by the stencils
+    static REAL fbc_acos(REAL x) { return std::acos(x); }
+    static REAL fbc_acosh(REAL x) { return std::acosh(x); }
+    static REAL fbc_asin(REAL x) { return std::asin(x); }
+    static REAL fbc_asinh(REAL x) { return std::asinh(x); }
+    static REAL fbc_atan(REAL x) { return std::atan(x); }
+    static REAL fbc_atanh(REAL x) { return std::atanh(x); }
+    static REAL fbc_ceil(REAL x) { return std::ceil(x); }
+    static REAL fbc_cos(REAL x) { return std::cos(x); }
+    static REAL fbc_cosh(REAL x) { return std::cosh(x); }
+    static REAL fbc_exp(REAL x) { return std::exp(x); }
+    static REAL fbc_floor(REAL x) { return std::floor(x); }
+    static REAL fbc_log(REAL x) { return std::log(x); }
+    static REAL fbc_log10(REAL x) { return std::log10(x); }
+    static REAL fbc_rint(REAL x) { return std::rint(x); }
+    static REAL fbc_round(REAL x) { return std::round(x); }
+    static REAL fbc_sin(REAL x) { return std::sin(x); }
+    static REAL fbc_sinh(REAL x) { return std::sinh(x); }
+    static REAL fbc_tan(REAL x) { return std::tan(x); }
+    static REAL fbc_tanh(REAL x) { return std::tanh(x); }
+
+    static REAL fbc_remainder(REAL x, REAL y) { return std::remainder(x, y); }
+    static REAL fbc_atan2(REAL x, REAL y) { return std::atan2(x, y); }
+    static REAL fbc_fmod(REAL x, REAL y) { return std::fmod(x, y); }
+    static REAL fbc_pow(REAL x, REAL y) { return std::pow(x, y); }
+    static REAL fbc_copysign(REAL x, REAL y) { return std::copysign(x, y); }
+
+    static void* getFunction(int opcode)
+    {
+        typedef FBCRegisterInstruction I;
+
+        switch (opcode) {
+            case I::kAcosf:
+                return (void*)fbc_acos;
+            case I::kAcoshf:
+                return (void*)fbc_acosh;
+            case I::kAsinf:
+                return (void*)fbc_asin;
+            case I::kAsinhf:
+                return (void*)fbc_asinh;
+            case I::kAtanf:
+                return (void*)fbc_atan;
+            case I::kAtanhf:
+                return (void*)fbc_atanh;
+            case I::kCeilf:
+                return (void*)fbc_ceil;
+            case I::kCosf:
+                return (void*)fbc_cos;
+            case I::kCoshf:
+                return (void*)fbc_cosh;
+            case I::kExpf:
+                return (void*)fbc_exp;
+            case I::kFloorf:
+                return (void*)fbc_floor;
+            case I::kLogf:
+                return (void*)fbc_log;
+            case I::kLog10f:
+                return (void*)fbc_log10;
+            case I::kRintf:
+                return (void*)fbc_rint;
+            case I::kRoundf:
+                return (void*)fbc_round;
+            case I::kSinf:
+                return (void*)fbc_sin;
+            case I::kSinhf:
+                return (void*)fbc_sinh;
+            case I::kTanf:
+                return (void*)fbc_tan;
+            case I::kTanhf:
+                return (void*)fbc_tanh;
+            case I::kRemReal:
+                return (void*)fbc_remainder;
+            case I::kAtan2f:
+                return (void*)fbc_atan2;
+            case I::kFmodf:
+                return (void*)fbc_fmod;
+            case I::kPowf:
+                return (void*)fbc_pow;
+            case I::kCopysignf:
+                return (void*)fbc_copysign;
+            default:
+                return nullptr;
+        }
+    }
+
+#ifdef FBC_STENCILS_TARGET
+    static const FBCStencil* getStencil(int id)
+    {
+        return (sizeof(REAL) == sizeof(double)) ? &gFBCStencilsDouble[id] : &gFBCStencilsFloat[id];
+    }
+
+    static const unsigned char* getStencilCode(const FBCStencil* stencil)
+    {
+        return ((sizeof(REAL) == sizeof(double)) ? gFBCStencilCodeDouble : gFBCStencilCodeFloat) +
+               stencil->fCode;
+    }
+
+    static const FBCStencilPatch* getStencilPatches(const FBCStencil* stencil)
+    {
+        return ((sizeof(REAL) == sizeof(double)) ? gFBCStencilPatchesDouble
+                                                 : gFBCStencilPatchesFloat) +
+               stencil->fPatches;
+    }
+
+    // Stencil of an instruction: the moves of constants have their own stencils
+    static int getStencilID(FBCRegisterCode<REAL>* code, const FBCRegisterInstruction& inst)
     {
-        InstructionIT it  = block->fInstructions.begin();
-        bool          end = false;
-
-        while ((it != block->fInstructions.end()) && !end) {
-            //(*it)->write(&std::cout);
-
-            switch ((*it)->fOpcode) {
-                // Numbers
-                case FBCInstruction::kRealValue:
-                    it++;
-                    break;
-
-                case FBCInstruction::kInt32Value:
-                    it++;
-                    break;
-
-                // Memory load/store
-                case FBCInstruction::kLoadReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLoadInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kStoreReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kStoreInt:
-                    it++;
-                    break;
-
-                // Indexed memory load/store: constant values are added at generation time by
-                // CreateBinOp...
-                case FBCInstruction::kLoadIndexedReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLoadIndexedInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLoadSoundFieldInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLoadSoundFieldReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kStoreIndexedReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kStoreIndexedInt:
-                    it++;
-                    break;
-
-                // Memory shift
-                case FBCInstruction::kBlockShiftReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kBlockShiftInt:
-                    it++;
-                    break;
-
-                // Input/output
-                case FBCInstruction::kLoadInput:
-                    it++;
-                    break;
-
-                case FBCInstruction::kStoreOutput:
-                    it++;
-                    break;
-
-                // Cast
-                case FBCInstruction::kCastReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kCastInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kBitcastInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kBitcastReal:
-                    it++;
-                    break;
-
-                // Binary math
-                case FBCInstruction::kAddReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAddInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kSubReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kSubInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kMultReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kMultInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kDivReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kDivInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kRemReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kRemInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLshInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kARshInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kGTInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLTInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kGEInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLEInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kEQInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kNEInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kGTReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLTReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kGEReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLEReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kEQReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kNEReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kANDInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kORInt:
-                    it++;
-                    break;
+        if (inst.fOpcode == FBCRegisterInstruction::kMoveInt &&
+            inst.fSrc1 >= code->fIntHeapSize + code->fIntRegisters) {
+            return kMoveIntValue;
+        } else if (inst.fOpcode == FBCRegisterInstruction::kMoveReal &&
+                   inst.fSrc1 >= code->fRealHeapSize + code->fRealRegisters) {
+            return kMoveRealValue;
+        } else {
+            return inst.fOpcode;
+        }
+    }
 
-                case FBCInstruction::kXORInt:
-                    it++;
-                    break;
+    // Value of a hole, 'starts' gives the address of the code of each instruction
+    static uint64_t getHoleValue(FBCRegisterCode<REAL>* code, const FBCRegisterInstruction& inst,
+                                 int hole, size_t index, const std::vector<uintptr_t>& starts)
+    {
+        switch (hole) {
+            case kHoleIntDst:
+                return uint64_t(inst.fDst) * sizeof(int);
+            case kHoleIntSrc1:
+                return uint64_t(inst.fSrc1) * sizeof(int);
+            case kHoleIntSrc2:
+                return uint64_t(inst.fSrc2) * sizeof(int);
+            case kHoleRealDst:
+                return uint64_t(inst.fDst) * sizeof(REAL);
+            case kHoleRealSrc1:
+                return uint64_t(inst.fSrc1) * sizeof(REAL);
+            case kHoleRealSrc2:
+                return uint64_t(inst.fSrc2) * sizeof(REAL);
+            case kHoleChannelDst:
+                return uint64_t(inst.fDst) * sizeof(REAL*);
+            case kHoleChannelSrc1:
+                return uint64_t(inst.fSrc1) * sizeof(REAL*);
+            case kHoleValue:
+                if (inst.fOpcode == FBCRegisterInstruction::kMoveInt) {
+                    return uint32_t(
+                        code->fIntConstants[inst.fSrc1 - code->fIntHeapSize - code->fIntRegisters]);
+                } else {
+                    REAL     value = code->fRealConstants[inst.fSrc1 - code->fRealHeapSize -
+                                                      code->fRealRegisters];
+                    uint64_t bits  = 0;
+                    memcpy(&bits, &value, sizeof(REAL));
+                    return bits;
+                }
+            case kHoleFunction:
+                return uint64_t(uintptr_t(getFunction(inst.fOpcode)));
+            case kHoleTarget:
+                // Relative jump in the register code
+                return uint64_t(starts[index + inst.fSrc2]);
+            default:
+                faustassert(false);
+                return 0;
+        }
+    }
 
-                // Extended unary math
-                case FBCInstruction::kAbs:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAbsf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAcosf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAcoshf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAsinf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAsinhf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAtanf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kAtanhf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kCeilf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kCosf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kCoshf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kExpf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kFloorf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLogf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLog10f:
-                    it++;
-                    break;
-
-                case FBCInstruction::kRintf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kRoundf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kSinf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kSinhf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kSqrtf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kTanf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kTanhf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kIsnanf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kIsinff:
-                    it++;
-                    break;
-
-                case FBCInstruction::kCopysignf:
-                    it++;
-                    break;
-
-                // Extended binary math
-                case FBCInstruction::kAtan2f:
-                    it++;
-                    break;
-
-                case FBCInstruction::kFmodf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kPowf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kMax:
-                    it++;
-                    break;
-
-                case FBCInstruction::kMaxf:
-                    it++;
-                    break;
-
-                case FBCInstruction::kMin:
-                    it++;
-                    break;
-
-                case FBCInstruction::kMinf:
-                    it++;
-                    break;
-
-                // Control
-                case FBCInstruction::kReturn:
-                    end = true;
-                    break;
-
-                case FBCInstruction::kIf:
-                    break;
-
-                case FBCInstruction::kSelectInt:
-                    it++;
-                    break;
-
-                case FBCInstruction::kSelectReal:
-                    it++;
-                    break;
-
-                case FBCInstruction::kCondBranch:
-                    it++;
-                    break;
-
-                case FBCInstruction::kLoop:
-                    it++;
-                    break;
-
-                default:
-                    (*it)->write(&std::cout);
-                    faustassert(false);
-                    break;
+    static void patch(unsigned char* at, int kind, uint64_t value)
+    {
+        uint32_t insn = 0;
+        switch (kind) {
+            case kPatchAbs32: {
+                uint32_t v = uint32_t(value);
+                memcpy(at, &v, sizeof(v));
+                break;
+            }
+            case kPatchAbs64:
+                memcpy(at, &value, sizeof(value));
+                break;
+            case kPatchRel32: {
+                int32_t v = int32_t(int64_t(value) - int64_t(uintptr_t(at)));
+                memcpy(at, &v, sizeof(v));
+                break;
+            }
+            case kPatchMovw0:
+            case kPatchMovw16:
+            case kPatchMovw32:
+            case kPatchMovw48: {
+                int shift = (kind - kPatchMovw0) * 16;
+                memcpy(&insn, at, sizeof(insn));
+                insn |= uint32_t((value >> shift) & 0xffff) << 5;
+                memcpy(at, &insn, sizeof(insn));
+                break;
             }
+            case kPatchBranch26: {
+                int64_t delta = int64_t(value) - int64_t(uintptr_t(at));
+                memcpy(&insn, at, sizeof(insn));
+                insn |= uint32_t((delta >> 2) & 0x3ffffff);
+                memcpy(at, &insn, sizeof(insn));
+                break;
+            }
+            default:
+                faustassert(false);
+                break;
         }
     }
 
+    // Copy a stencil at 'at' and patch its holes
+    static void emit(unsigned char* at, int id, FBCRegisterCode<REAL>* code,
+                     const FBCRegisterInstruction& inst, size_t index,
+                     const std::vector<uintptr_t>& starts)
+    {
+        const FBCStencil*      stencil = getStencil(id);
+        const FBCStencilPatch* patches = getStencilPatches(stencil);
+        memcpy(at, getStencilCode(stencil), stencil->fSize);
+        for (int i = 0; i < stencil->fPatchCount; i++) {
+            uint64_t value = getHoleValue(code, inst, patches[i].fHole, index, starts);
+            patch(at + patches[i].fOffset, patches[i].fKind, value + int64_t(patches[i].fAddend));
+        }
+    }
+
+    void compileBlock(FBCRegisterCode<REAL>* code, const std::vector<FBCRegisterInstruction>& insts)
+    {
+        // Code layout: the function entry, then the stencil of each instruction
+        std::vector<uintptr_t> starts(insts.size() + 1);
+        size_t                 size = getStencil(kEnter)->fSize;
+        for (size_t i = 0; i < insts.size(); i++) {
+            starts[i] = size;
+            size += getStencil(getStencilID(code, insts[i]))->fSize;
+        }
+        starts[insts.size()] = size;
+
+        fCodeSize = size;
+        fCode = mmap(nullptr, fCodeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (fCode == MAP_FAILED) {
+            fCode = nullptr;
+            throw faustexception("ERROR : cannot allocate the template compiler code\n");
+        }
+        unsigned char* base = static_cast<unsigned char*>(fCode);
+        for (auto& start : starts) {
+            start += uintptr_t(base);
+        }
+
+        FBCRegisterInstruction none = {0, 0, 0, 0};
+        emit(base, kEnter, code, none, 0, starts);
+        for (size_t i = 0; i < insts.size(); i++) {
+            emit(reinterpret_cast<unsigned char*>(starts[i]), getStencilID(code, insts[i]), code,
+                 insts[i], i, starts);
+        }
+
+        if (mprotect(fCode, fCodeSize, PROT_READ | PROT_EXEC) != 0) {
+            munmap(fCode, fCodeSize);
+            fCode = nullptr;
+            throw faustexception("ERROR : cannot make the template compiler code executable\n");
+        }
+        __builtin___clear_cache(reinterpret_cast<char*>(base),
+                                reinterpret_cast<char*>(base + fCodeSize));
+        fCompiledFun = reinterpret_cast<compiledFun>(fCode);
+    }
+#endif
+
    public:
-    FBCTemplateCompiler(FBCBlockInstruction<REAL>* fbc_block, soundTable& sound_table)
-        : FBCExecuteFun<REAL>(fbc_block, sound_table)
+    // Whether stencils are available for the target
+    static bool isSupported()
+    {
+#ifdef FBC_STENCILS_TARGET
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    FBCTemplateCompiler(FBCRegisterCode<REAL>* code, FBCBlockInstruction<REAL>* fbc_block,
+                        soundTable& sound_table)
+        : FBCExecuteFun<REAL>(fbc_block, sound_table),
+          fCompiledFun(nullptr),
+          fCode(nullptr),
+          fCodeSize(0)
     {
+#ifdef FBC_STENCILS_TARGET
         // Compile the 'compute' function once.
-        CompileBlock(fbc_block);
+        compileBlock(code, code->fBlocks[fbc_block]);
+#endif
     }
 
-    virtual ~FBCTemplateCompiler() {}
+    virtual ~FBCTemplateCompiler()
+    {
+#ifdef FBC_STENCILS_TARGET
+        if (fCode) {
+            munmap(fCode, fCodeSize);
+        }
+#endif
+    }
 
     /*
      * The function to be executed each cycle.
@@ -422,7 +362,10 @@ class FBCTemplateCompiler : public FBCExecuteFun<REAL> {
      * @param inputs - the audio inputs
      * @param outputs - the audio outputs
      */
-    void execute(int* int_heap, REAL* real_heap, REAL** inputs, REAL** outputs) {}
+    void execute(int* int_heap, REAL* real_heap, REAL** inputs, REAL** outputs)
+    {
+        fCompiledFun(int_heap, real_heap, inputs, outputs);
+    }
 };
 
 #endif
@@ -22,2552 +22,1421 @@
 #ifndef _FBC_VEC_INTERPRETER_H
 #define _FBC_VEC_INTERPRETER_H
 
+#include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <cmath>
-#include <iostream>
 #include <map>
-#include <sstream>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "fbc_register_interpreter.hh"
+
+/*
+ Vector FBC executor : the loops generated by the vector mode (-vec) that are not recursive are
+ executed 'lane parallel', each instruction of the loop body being done for VEC iterations at once.
+
+ The bodies of these loops are lowered once per factory into a three-address code where a register
+ keeps the VEC values ('lanes') of a stack position. Each operation is a fixed count loop over the
+ lanes, that the C++ compiler vectorizes for the target (SSE/AVX/NEON...). Values that do not
+ depend on the iteration (constants, DSP fields that are not written in the body, array values at
+ an invariant index) are broadcast once per loop execution, and the loop variable is kept symbolic
+ so that array and audio buffer accesses at 'loop variable + invariant' are contiguous ranges.
+
+ A loop is lowered only if executing it by chunks of VEC iterations gives the scalar result :
+
+    - a DSP field written in the body is always written before being read (it is then a register,
+      and gets the value of the last iteration when the loop ends)
+    - an array written in the body is only accessed at the same 'loop variable + invariant' index
+    - inputs and outputs are accessed at the same index when the loop reads inputs and writes outputs
+    - Select branches are computed for all lanes, so they cannot store, divide integers or access
+      arrays at a varying index
+    - there is no If, inner loop or soundfile access
+
+ Other loops are executed by the stack interpreter. The number of lanes is chosen at runtime
+ (FAUST_INTERP_VEC, 0 to disable the vector executor, or the vector size of the factory).
+*/
+
+struct FBCVecInstruction {
+    enum Opcode {
+        // Loop prologue
+        kBroadcastReal, kBroadcastInt, kBroadcastIndexedReal, kBroadcastIndexedInt,
+        kBroadcastIndexedClassReal, kBroadcastIndexedClassInt,
+
+        // Memory
+        kAffineInt, kMoveReal, kMoveInt, kLoadRangeReal, kLoadRangeInt, kStoreRangeReal,
+        kStoreRangeInt, kLoadIndexedReal, kLoadIndexedInt, kLoadIndexedClassReal,
+        kLoadIndexedClassInt, kLoadInputRange, kLoadInput, kStoreOutputRange,
+
+        // Cast/Bitcast
+        kCastReal, kCastInt, kBitcastInt, kBitcastReal,
+
+        // Standard math, in the FBCInstruction order
+        kAddReal, kAddInt, kSubReal, kSubInt, kMultReal, kMultInt, kDivReal, kDivInt, kRemReal,
+        kRemInt, kLshInt, kARshInt, kLRshInt, kGTInt, kLTInt, kGEInt, kLEInt, kEQInt, kNEInt,
+        kGTReal, kLTReal, kGEReal, kLEReal, kEQReal, kNEReal, kANDInt, kORInt, kXORInt,
+
+        // Extended unary math, in the FBCInstruction order
+        kAbs, kAbsf, kAcosf, kAcoshf, kAsinf, kAsinhf, kAtanf, kAtanhf, kCeilf, kCosf, kCoshf,
+        kExpf, kFloorf, kLogf, kLog10f, kRintf, kRoundf, kSinf, kSinhf, kSqrtf, kTanf, kTanhf,
+        kIsnanf, kIsinff,
+
+        // Extended binary math, in the FBCInstruction order
+        kAtan2f, kFmodf, kPowf, kMax, kMaxf, kMin, kMinf, kCopysignf,
+
+        // Select
+        kSelectReal, kSelectInt
+    };
+
+    /*
+     Registers are numbered from 0, constants have negative numbers. 'lv' is the loop variable of
+     the lane, and an invariant index is 'heap[cell] + value' (cell is -1 if there is none) :
+
+        kBroadcastReal/Int          fDst = heap[fSrc1]
+        kBroadcastIndexedReal/Int   fDst = heap[fSrc3 + heap[fSrc1] + fSrc2]
+        kAffineInt                  fDst = (lv if fSrc3) + heap[fSrc1] + fSrc2
+        kLoadRangeReal/Int          fDst = heap[fSrc3 + lv + heap[fSrc1] + fSrc2]
+        kStoreRangeReal/Int         heap[fSrc3 + lv + heap[fSrc1] + fSrc2] = fDst
+        kLoadIndexedReal/Int        fDst = heap[fSrc3 + fSrc1]
+        ...Class versions           same access in the class segment
+        kLoadInputRange             fDst = inputs[fSrc3][lv + heap[fSrc1] + fSrc2]
+        kLoadInput                  fDst = inputs[fSrc3][fSrc1]
+        kStoreOutputRange           outputs[fSrc3][lv + heap[fSrc1] + fSrc2] = fDst
+        kSelectReal/Int             fDst = (fSrc1) ? fSrc2 : fSrc3
+        other operations            fDst = op(fSrc1, fSrc2)
+    */
+    int fOpcode;
+    int fDst;
+    int fSrc1;
+    int fSrc2;
+    int fSrc3;
+};
 
-#include "exception.hh"
-#include "faust/gui/CGlue.h"
-#include "fbc_executor.hh"
-#include "interpreter_bytecode.hh"
-
-// #define interp_assert(exp) faustassert(exp)
-#define interp_assert(exp)
-
-template <class REAL, int TRACE>
-struct interpreter_dsp_factory_aux;
-
-// FBC interpreter
-template <class REAL, int VEC>
-class FBCVecInterpreter : public FBCExecutor<REAL> {
-   protected:
-    interpreter_dsp_factory_aux<T, 0>* fFactory;
-
-    int*  fIntHeap;
-    REAL* fRealHeap;
-
-    REAL** fInputs;
-    REAL** fOutputs;
-
-#define POP_INT() (int_stack[--int_stack_index])
-
-#define pushAddr(addr) (address_stack[addr_stack_index++] = addr)
-#define popAddr() (address_stack[--addr_stack_index])
-
-    virtual void ExecuteBuildUserInterface(FIRUserInterfaceBlockInstruction<T>* block,
-                                           UIInterface*                         glue)
-    {
-        for (const auto& it : block->fInstructions) {
-            // it->write(&std::cout);
-
-            switch (it->fOpcode) {
-                case FBCInstruction::kOpenVerticalBox:
-                    glue->openVerticalBox(it->fLabel.c_str());
-                    break;
-
-                case FBCInstruction::kOpenHorizontalBox:
-                    glue->openHorizontalBox(it->fLabel.c_str());
-                    break;
-
-                case FBCInstruction::kOpenTabBox:
-                    glue->openTabBox(it->fLabel.c_str());
-                    break;
-
-                case FBCInstruction::kCloseBox:
-                    glue->closeBox();
-                    break;
-
-                case FBCInstruction::kAddButton:
-                    glue->addButton(it->fLabel.c_str(), &fRealHeap[it->fOffset]);
-                    break;
-
-                case FBCInstruction::kAddCheckButton:
-                    glue->addCheckButton(it->fLabel.c_str(), &fRealHeap[it->fOffset]);
-                    break;
-
-                case FBCInstruction::kAddHorizontalSlider:
-                    glue->addHorizontalSlider(it->fLabel.c_str(), &fRealHeap[it->fOffset],
-                                              it->fInit, it->fMin, it->fMax, it->fStep);
-                    break;
-
-                case FBCInstruction::kAddVerticalSlider:
-                    glue->addVerticalSlider(it->fLabel.c_str(), &fRealHeap[it->fOffset], it->fInit,
-                                            it->fMin, it->fMax, it->fStep);
-                    break;
-
-                case FBCInstruction::kAddNumEntry:
-                    glue->addNumEntry(it->fLabel.c_str(), &fRealHeap[it->fOffset], it->fInit,
-                                      it->fMin, it->fMax, it->fStep);
-                    break;
-
-                case FBCInstruction::kAddSoundfile:
-                    // fKey use for label, fValue used for URL, fLabel for SF field name
-                    glue->addSoundfile(it->fKey.c_str(), it->fValue.c_str(),
-                                       &this->fSoundTable[it->fLabel]);
-                    break;
-
-                case FBCInstruction::kAddHorizontalBargraph:
-                    glue->addHorizontalBargraph(it->fLabel.c_str(), &fRealHeap[it->fOffset],
-                                                it->fMin, it->fMax);
-                    break;
-
-                case FBCInstruction::kAddVerticalBargraph:
-                    glue->addVerticalBargraph(it->fLabel.c_str(), &fRealHeap[it->fOffset], it->fMin,
-                                              it->fMax);
-                    break;
-
-                case FBCInstruction::kDeclare:
-                    // Special case for "0" zone
-                    if (it->fOffset == -1) {
-                        glue->declare(static_cast<T*>(nullptr), it->fKey.c_str(),
-                                      it->fValue.c_str());
-                    } else {
-                        glue->declare(&fRealHeap[it->fOffset], it->fKey.c_str(),
-                                      it->fValue.c_str());
-                    }
-                    break;
-
-                default:
-                    break;
-            }
-        }
-    }
-
-    // virtual void ExecuteVecLoop(FBCBasicInstruction<T>* block)
-    virtual void ExecuteBlock(FBCBlockInstruction<REAL>* block)
-    {
-        static void* fDispatchTable[] = {
-
-            // Numbers
-            &&do_kRealValue, &&do_kInt32Value,
-
-            // Memory
-            &&do_kLoadReal, &&do_kLoadInt, &&do_kLoadSoundFieldInt, &&do_kLoadSoundFieldReal,
-            &&do_kStoreReal, &&do_kStoreInt, &&do_kStoreRealValue, &&do_kStoreIntValue,
-            &&do_kLoadIndexedReal, &&do_kLoadIndexedInt, &&do_kStoreIndexedReal,
-            &&do_kStoreIndexedInt, &&do_kBlockStoreReal, &&do_kBlockStoreInt, &&do_kMoveReal,
-            &&do_kMoveInt, &&do_kPairMoveReal, &&do_kPairMoveInt, &&do_kBlockPairMoveReal,
-            &&do_kBlockPairMoveInt, &&do_kBlockShiftReal, &&do_kBlockShiftInt, &&do_kLoadInput,
-            &&do_kStoreOutput,
-
-            // Cast/bitcast
-            &&do_kCastReal, &&do_kCastInt, &&do_kCastRealHeap, &&do_kCastIntHeap, &&do_kBitcastInt,
-            &&do_kBitcastReal,
-
-            // Standard math (stack OP stack)
-            &&do_kAddReal, &&do_kAddInt, &&do_kSubReal, &&do_kSubInt, &&do_kMultReal, &&do_kMultInt,
-            &&do_kDivReal, &&do_kDivInt, &&do_kRemReal, &&do_kRemInt, &&do_kLshInt, &&do_kARshInt,
-            &&do_kGTInt, &&do_kLTInt, &&do_kGEInt, &&do_kLEInt, &&do_kEQInt, &&do_kNEInt,
-            &&do_kGTReal, &&do_kLTReal, &&do_kGEReal, &&do_kLEReal, &&do_kEQReal, &&do_kNEReal,
-            &&do_kANDInt, &&do_kORInt, &&do_kXORInt,
-
-            // Standard math (heap OP heap)
-            &&do_kAddRealHeap, &&do_kAddIntHeap, &&do_kSubRealHeap, &&do_kSubIntHeap,
-            &&do_kMultRealHeap, &&do_kMultIntHeap, &&do_kDivRealHeap, &&do_kDivIntHeap,
-            &&do_kRemRealHeap, &&do_kRemIntHeap, &&do_kLshIntHeap, &&do_kARshIntHeap,
-            &&do_kGTIntHeap, &&do_kLTIntHeap, &&do_kGEIntHeap, &&do_kLEIntHeap, &&do_kEQIntHeap,
-            &&do_kNEIntHeap, &&do_kGTRealHeap, &&do_kLTRealHeap, &&do_kGERealHeap, &&do_kLERealHeap,
-            &&do_kEQRealHeap, &&do_kNERealHeap, &&do_kANDIntHeap, &&do_kORIntHeap, &&do_kXORIntHeap,
-
-            // Standard math (heap OP stack)
-            &&do_kAddRealStack, &&do_kAddIntStack, &&do_kSubRealStack, &&do_kSubIntStack,
-            &&do_kMultRealStack, &&do_kMultIntStack, &&do_kDivRealStack, &&do_kDivIntStack,
-            &&do_kRemRealStack, &&do_kRemIntStack, &&do_kLshIntStack, &&do_kARshIntStack,
-            &&do_kGTIntStack, &&do_kLTIntStack, &&do_kGEIntStack, &&do_kLEIntStack,
-            &&do_kEQIntStack, &&do_kNEIntStack, &&do_kGTRealStack, &&do_kLTRealStack,
-            &&do_kGERealStack, &&do_kLERealStack, &&do_kEQRealStack, &&do_kNERealStack,
-            &&do_kANDIntStack, &&do_kORIntStack, &&do_kXORIntStack,
-
-            // Standard math (value OP stack)
-            &&do_kAddRealStackValue, &&do_kAddIntStackValue, &&do_kSubRealStackValue,
-            &&do_kSubIntStackValue, &&do_kMultRealStackValue, &&do_kMultIntStackValue,
-            &&do_kDivRealStackValue, &&do_kDivIntStackValue, &&do_kRemRealStackValue,
-            &&do_kRemIntStackValue, &&do_kLshIntStackValue, &&do_kARshIntStackValue,
-            &&do_kGTIntStackValue, &&do_kLTIntStackValue, &&do_kGEIntStackValue,
-            &&do_kLEIntStackValue, &&do_kEQIntStackValue, &&do_kNEIntStackValue,
-            &&do_kGTRealStackValue, &&do_kLTRealStackValue, &&do_kGERealStackValue,
-            &&do_kLERealStackValue, &&do_kEQRealStackValue, &&do_kNERealStackValue,
-            &&do_kANDIntStackValue, &&do_kORIntStackValue, &&do_kXORIntStackValue,
-
-            // Standard math (value OP heap)
-            &&do_kAddRealValue, &&do_kAddIntValue, &&do_kSubRealValue, &&do_kSubIntValue,
-            &&do_kMultRealValue, &&do_kMultIntValue, &&do_kDivRealValue, &&do_kDivIntValue,
-            &&do_kRemRealValue, &&do_kRemIntValue, &&do_kLshIntValue, &&do_kARshIntValue,
-            &&do_kGTIntValue, &&do_kLTIntValue, &&do_kGEIntValue, &&do_kLEIntValue,
-            &&do_kEQIntValue, &&do_kNEIntValue, &&do_kGTRealValue, &&do_kLTRealValue,
-            &&do_kGERealValue, &&do_kLERealValue, &&do_kEQRealValue, &&do_kNERealValue,
-            &&do_kANDIntValue, &&do_kORIntValue, &&do_kXORIntValue,
-
-            // Standard math (value OP heap) : non commutative operations
-            &&do_kSubRealValueInvert, &&do_kSubIntValueInvert, &&do_kDivRealValueInvert,
-            &&do_kDivIntValueInvert, &&do_kRemRealValueInvert, &&do_kRemIntValueInvert,
-            &&do_kLshIntValueInvert, &&do_kARshIntValueInvert, &&do_kGTIntValueInvert,
-            &&do_kLTIntValueInvert, &&do_kGEIntValueInvert, &&do_kLEIntValueInvert,
-            &&do_kGTRealValueInvert, &&do_kLTRealValueInvert, &&do_kGERealValueInvert,
-            &&do_kLERealValueInvert,
-
-            // Extended unary math
-            &&do_kAbs, &&do_kAbsf, &&do_kAcosf, &&do_kAsinf, &&do_kAtanf, &&do_kCeilf, &&do_kCosf,
-            &&do_kCoshf, &&do_kExpf, &&do_kFloorf, &&do_kLogf, &&do_kLog10f, &&do_kRintf,
-            &&do_kRoundf, &&do_kSinf, &&do_kSinhf, &&do_kSqrtf, &&do_kTanf, &&do_kTanhf,
-
-            // Extended unary math (heap OP heap)
-            &&do_kAbsHeap, &&do_kAbsfHeap, &&do_kAcosfHeap, &&do_kAsinfHeap, &&do_kAtanfHeap,
-            &&do_kCeilfHeap, &&do_kCosfHeap, &&do_kCoshfHeap, &&do_kExpfHeap, &&do_kFloorfHeap,
-            &&do_kLogfHeap, &&do_kLog10fHeap, &&do_kRintfHeap, &&do_kRoundfHeap, &&do_kSinfHeap,
-            &&do_kSinhfHeap, &&do_kSqrtfHeap, &&do_kTanfHeap, &&do_kTanhfHeap,
-
-            // Extended binary math
-            &&do_kAtan2f, &&do_kFmodf, &&do_kPowf, &&do_kMax, &&do_kMaxf, &&do_kMin, &&do_kMinf,
-
-            // Extended binary math (heap version)
-            &&do_kAtan2fHeap, &&do_kFmodfHeap, &&do_kPowfHeap, &&do_kMaxHeap, &&do_kMaxfHeap,
-            &&do_kMinHeap, &&do_kMinfHeap,
-
-            // Extended binary math (stack version)
-            &&do_kAtan2fStack, &&do_kFmodfStack, &&do_kPowfStack, &&do_kMaxStack, &&do_kMaxfStack,
-            &&do_kMinStack, &&do_kMinfStack,
-
-            // Extended binary math (Stack/Value version)
-            &&do_kAtan2fStackValue, &&do_kFmodfStackValue, &&do_kPowfStackValue,
-            &&do_kMaxStackValue, &&do_kMaxfStackValue, &&do_kMinStackValue, &&do_kMinfStackValue,
-
-            // Extended binary math (Value version)
-            &&do_kAtan2fValue, &&do_kFmodfValue, &&do_kPowfValue, &&do_kMaxValue, &&do_kMaxfValue,
-            &&do_kMinValue, &&do_kMinfValue,
-
-            // Extended binary math (Value version) : non commutative operations
-            &&do_kAtan2fValueInvert, &&do_kFmodfValueInvert, &&do_kPowfValueInvert,
-
-            // Control
-            &&do_kLoop, &&do_kReturn,
-
-            // Select/if
-            &&do_kIf, &&do_kSelectReal, &&do_kSelectInt, &&do_kCondBranch
-
-        };
-
-        int real_stack_index  = 0;
-        int int_stack_index   = 0;
-        int sound_stack_index = 0;
-        int addr_stack_index  = 0;
-
-        REAL          real_stack[512];
-        int           int_stack[512];
-        InstructionIT address_stack[64];
-
-#define dispatchFirstVec()                    \
-    {                                         \
-        goto* fDispatchTable[(*it)->fOpcode]; \
-    }
-#define dispatchNextVec()                     \
-    {                                         \
-        it++;                                 \
-        goto* fDispatchTable[(*it)->fOpcode]; \
-    }
-
-#define dispatchBranch1Vec()                         \
-    {                                                \
-        it = (*it)->fBranch1->fInstructions.begin(); \
-        dispatchFirstVec();                          \
-    }
-#define dispatchBranch2Vec()                         \
-    {                                                \
-        it = (*it)->fBranch2->fInstructions.begin(); \
-        dispatchFirstVec();                          \
-    }
-
-#define pushBranch1Vec()                                  \
-    {                                                     \
-        pushAddr((*it)->fBranch1->fInstructions.begin()); \
-    }
-#define pushBranch2Vec()                                  \
-    {                                                     \
-        pushAddr((*it)->fBranch2->fInstructions.begin()); \
-    }
-
-#define dispatchReturnVec() \
-    {                       \
-        it = popAddr();     \
-        dispatchFirstVec(); \
-    }
-#define saveReturnVec()   \
-    {                     \
-        pushAddr(it + 1); \
-    }
-#define emptyReturnVec() (addr_stack_index == 0)
-
-        // #pragma clang loop vectorize(enable) interleave(enable)
-
-#define VEC_LOOP(code)                  \
-    {                                   \
-        for (int j = 0; j < VEC; j++) { \
-            code;                       \
-        }                               \
-    }
-
-#define STACK_UP_INT() int_stack_index += VEC
-#define STACK_DOWN_INT() int_stack_index -= VEC
-
-#define STACK_UP_REAL() real_stack_index += VEC
-#define STACK_DOWN_REAL() real_stack_index -= VEC
-
-#define PUSH_VEC_INT(val) int_stack[int_stack_index + j] = (val)
-#define PUSH_VEC_REAL(val) real_stack[real_stack_index + j] = (val)
-
-#define POP_VEC_INT() int_stack[int_stack_index - (j + 1)]
-#define POP_VEC_REAL() real_stack[real_stack_index - (j + 1)]
-
-#define WRITE_HEAP_VEC_REAL(off, val) fRealHeap[(off) + j] = (val)
-#define WRITE_HEAP_VEC_INT(off, val) fIntHeap[(off) + j] = (val)
-
-#define READ_HEAP_VEC_REAL(off) fRealHeap[(off) + j]
-#define READ_HEAP_VEC_INT(off) fIntHeap[(off) + j]
-
-        // Check block coherency
-        // block->check();
-
-        // std::cout << "ExecuteBlock : " << block->fInstructions.size() << "\n";
-        // block->write(&std::cout);
-
-        int  v1_int[VEC];
-        int  v2_int[VEC];
-        REAL v1_real[VEC];
-        REAL v2_real[VEC];
-
-        try {
-            InstructionIT it = block->fInstructions.begin();
-            dispatchFirstVec();
-
-        /*
-        // Execute VecLoop
-        InstructionIT it;
-
-        // Push branch2 (loop content)
-        interp_assert((*it)->fBranch2);
-        pushBranch2Vec();
-
-        // And start branch1 loop variable declaration block
-        interp_assert((*it)->fBranch1);
-        dispatchBranch1Vec();
-        */
-
-        // Number operations
-        do_kRealValue: {
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kInt32Value: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Memory operations
-        do_kLoadReal: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kLoadInt: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLoadSoundFieldInt: {
-            // TODO
-        }
-
-        do_kLoadSoundFieldReal: {
-            // TODO
-        }
-
-        do_kStoreReal: {
-            VEC_LOOP(WRITE_HEAP_VEC_REAL((*it)->fOffset1, POP_VEC_REAL()));
-            STACK_DOWN_REAL();
-            dispatchNextVec();
-        }
-
-        do_kStoreInt: {
-            VEC_LOOP(WRITE_HEAP_VEC_INT((*it)->fOffset1, POP_VEC_INT()));
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-        // Directly store a value
-        do_kStoreRealValue: {
-            VEC_LOOP(WRITE_HEAP_VEC_REAL((*it)->fOffset1, (*it)->fRealValue));
-            dispatchNextVec();
-        }
-
-        do_kStoreIntValue: {
-            VEC_LOOP(WRITE_HEAP_VEC_INT((*it)->fOffset1, (*it)->fIntValue));
-            dispatchNextVec();
-        }
-
-        do_kLoadIndexedReal: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1 + POP_VEC_INT())));
-            STACK_UP_REAL();
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-        do_kLoadIndexedInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1 + v1_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kStoreIndexedReal: {
-            VEC_LOOP(WRITE_HEAP_VEC_REAL((*it)->fOffset1 + POP_VEC_INT(), POP_VEC_REAL()));
-            STACK_DOWN_REAL();
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-        do_kStoreIndexedInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(WRITE_HEAP_VEC_INT((*it)->fOffset1 + v1_int[j], POP_VEC_INT()));
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-        do_kBlockStoreReal: {
-            FIRBlockStoreRealInstruction<T>* inst =
-                static_cast<FIRBlockStoreRealInstruction<T>*>(*it);
-            interp_assert(inst);
-            for (int i = 0; i < inst->fOffset2; i++) {
-                fRealHeap[inst->fOffset1 + i] = inst->fNumTable[i];
-            }
-            dispatchNextVec();
-        }
-
-        do_kBlockStoreInt: {
-            FIRBlockStoreIntInstruction<T>* inst =
-                static_cast<FIRBlockStoreIntInstruction<T>*>(*it);
-            interp_assert(inst);
-            for (int i = 0; i < inst->fOffset2; i++) {
-                fIntHeap[inst->fOffset1 + i] = inst->fNumTable[i];
-            }
-            dispatchNextVec();
-        }
-
-        do_kMoveReal: {
-            fRealHeap[(*it)->fOffset1] = fRealHeap[(*it)->fOffset2];
-            dispatchNextVec();
-        }
-
-        do_kMoveInt: {
-            fIntHeap[(*it)->fOffset1] = fIntHeap[(*it)->fOffset2];
-            dispatchNextVec();
-        }
-
-        do_kPairMoveReal: {
-            fRealHeap[(*it)->fOffset1] = fRealHeap[(*it)->fOffset1 - 1];
-            fRealHeap[(*it)->fOffset2] = fRealHeap[(*it)->fOffset2 - 1];
-            dispatchNextVec();
-        }
-
-        do_kPairMoveInt: {
-            fIntHeap[(*it)->fOffset1] = fIntHeap[(*it)->fOffset1 - 1];
-            fIntHeap[(*it)->fOffset2] = fIntHeap[(*it)->fOffset2 - 1];
-            dispatchNextVec();
-        }
-
-        do_kBlockPairMoveReal: {
-            for (int i = (*it)->fOffset1; i < (*it)->fOffset2; i += 2) {
-                fRealHeap[i + 1] = fRealHeap[i];
-            }
-            dispatchNextVec();
-        }
-
-        do_kBlockPairMoveInt: {
-            for (int i = (*it)->fOffset1; i < (*it)->fOffset2; i += 2) {
-                fIntHeap[i + 1] = fIntHeap[i];
-            }
-            dispatchNextVec();
-        }
-
-        do_kBlockShiftReal: {
-            for (int i = (*it)->fOffset1; i > (*it)->fOffset2; i -= 1) {
-                fRealHeap[i] = fRealHeap[i - 1];
-            }
-            dispatchNextVec();
-        }
-
-        do_kBlockShiftInt: {
-            for (int i = (*it)->fOffset1; i > (*it)->fOffset2; i -= 1) {
-                fIntHeap[i] = fIntHeap[i - 1];
-            }
-            dispatchNextVec();
-        }
-
-        // Input/output access
-        do_kLoadInput: {
-            VEC_LOOP(PUSH_VEC_REAL(fInputs[(*it)->fOffset1][POP_VEC_INT()]));
-            STACK_UP_REAL();
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-        do_kStoreOutput: {
-            VEC_LOOP(fOutputs[(*it)->fOffset1][POP_VEC_INT()] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-        // Cast operations
-        do_kCastReal: {
-            VEC_LOOP(PUSH_VEC_REAL(T(POP_VEC_INT())));
-            STACK_UP_REAL();
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-        do_kCastRealHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(T(READ_HEAP_VEC_INT((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kCastInt: {
-            VEC_LOOP(PUSH_VEC_INT(T(POP_VEC_REAL())));
-            STACK_DOWN_REAL();
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kCastIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(T(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Bitcast operations
-        do_kBitcastInt: {
-            VEC_LOOP(T v1 = POP_VEC_REAL(); PUSH_VEC_INT(*reinterpret_cast<int*>(&v1)));
-            STACK_DOWN_REAL();
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kBitcastReal: {
-            VEC_LOOP(int v1 = POP_VEC_INT(); PUSH_VEC_REAL(*reinterpret_cast<T*>(&v1)));
-            STACK_UP_REAL();
-            STACK_DOWN_INT();
-            dispatchNextVec();
-        }
-
-            //-------------------------------------------------------
-            // Standard math operations : 'stack' OP 'stack' version
-            //-------------------------------------------------------
-
-        do_kAddReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(v1_real[j] + v2_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAddInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] + v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kSubReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(v1_real[j] - v2_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kSubInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] - v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kMultReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(v1_real[j] * v2_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kMultInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] * v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kDivReal: {
-            VEC_LOOP(v1_int[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(v1_int[j] / v2_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kDivInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] / v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kRemReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::remainder(v1_real[j], v2_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kRemInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] % v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Shift operation
-        do_kLshInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] << v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kARshInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] >> v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Int
-        do_kGTInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] > v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] < v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGEInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] >= v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLEInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] <= v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] == v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNEInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] != v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Real
-        do_kGTReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(v1_real[j] > v2_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(v1_real[j] < v2_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGEReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(v1_real[j] >= v2_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLEReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(v1_real[j] <= v2_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(v1_real[j] == v2_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNEReal: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(v1_real[j] != v2_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Logical operations
-        do_kANDInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] & v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kORInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] | v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kXORInt: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(v1_int[j] ^ v2_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-            //-----------------------------------------------------
-            // Standard math operations : 'heap' OP 'heap' version
-            //-----------------------------------------------------
-
-        do_kAddRealHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) +
-                                   READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAddIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) +
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kSubRealHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) -
-                                   READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kSubIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) -
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kMultRealHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) *
-                                   READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kMultIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) *
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kDivRealHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) /
-                                   READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kDivIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) /
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kRemRealHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::remainder(READ_HEAP_VEC_REAL((*it)->fOffset1),
-                                                  READ_HEAP_VEC_REAL((*it)->fOffset2))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kRemIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) %
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Shift operation
-        do_kLshIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1)
-                                  << READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kARshIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) >>
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Int
-        do_kGTIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) >
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) <
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGEIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) >=
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLEIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) <=
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) ==
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNEIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) !=
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Real
-        do_kGTRealHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) >
-                                  READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTRealHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) <
-                                  READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGERealHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) >=
-                                  READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLERealHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) <=
-                                  READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQRealHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) ==
-                                  READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNERealHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) !=
-                                  READ_HEAP_VEC_REAL((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Logical operations
-        do_kANDIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) &
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kORIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) |
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kXORIntHeap: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) ^
-                                  READ_HEAP_VEC_INT((*it)->fOffset2)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-            //------------------------------------------------------
-            // Standard math operations : 'stack' OP 'heap' version
-            //------------------------------------------------------
-
-        do_kAddRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) + v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAddIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) + v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kSubRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) - v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kSubIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) - v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kMultRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) * v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kMultIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) * v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kDivRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) / v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kDivIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) / v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kRemRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::remainder(READ_HEAP_VEC_REAL((*it)->fOffset1), v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kRemIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) % v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Shift operation
-        do_kLshIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) << v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kARshIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) >> v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Int
-        do_kGTIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) > v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) < v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGEIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) >= v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLEIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) <= v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) == v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNEIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) != v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Real
-        do_kGTRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) > v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) < v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGERealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) >= v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLERealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) <= v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQRealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) == v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNERealStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) != v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Logical operations
-        do_kANDIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) & v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kORIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) | v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kXORIntStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) ^ v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-            //-------------------------------------------------------
-            // Standard math operations : 'stack' OP 'value' version
-            //-------------------------------------------------------
-
-        do_kAddRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue + v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAddIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue + v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kSubRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue - v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kSubIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue - v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kMultRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue * v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kMultIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue * v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kDivRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue / v1_real[j]));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kDivIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue / v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kRemRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::remainder((*it)->fRealValue, v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kRemIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue % v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Shift operation
-        do_kLshIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue << v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kARshIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue >> v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Int
-        do_kGTIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue > v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue < v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGEIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue >= v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLEIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue <= v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue == v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNEIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue != v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Real
-        do_kGTRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue > v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue < v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGERealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue >= v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLERealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue <= v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQRealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue == v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNERealStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue != v1_real[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Logical operations
-        do_kANDIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue & v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kORIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue | v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kXORIntStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue ^ v1_int[j]));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-            //------------------------------------------------------
-            // Standard math operations : 'value' OP 'heap' version
-            //------------------------------------------------------
-
-        do_kAddRealValue: {
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue + READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAddIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue + READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kSubRealValue: {
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue - READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kSubIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue - READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kMultRealValue: {
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue * READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kMultIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue * READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kDivRealValue: {
-            VEC_LOOP(PUSH_VEC_REAL((*it)->fRealValue / READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kDivIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue / READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kRemRealValue: {
-            VEC_LOOP(PUSH_VEC_REAL(
-                std::remainder((*it)->fRealValue, READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kRemIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue % READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Shift operation
-        do_kLshIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue << READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kARshIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue >> READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Int
-        do_kGTIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue > READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue < READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGEIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue >= READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLEIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue <= READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue == READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNEIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue != READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Real
-        do_kGTRealValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue > READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTRealValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue < READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGERealValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue >= READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLERealValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue <= READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kEQRealValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue == READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kNERealValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fRealValue != READ_HEAP_VEC_REAL((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Logical operations
-        do_kANDIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue & READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kORIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue | READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kXORIntValue: {
-            VEC_LOOP(PUSH_VEC_INT((*it)->fIntValue ^ READ_HEAP_VEC_INT((*it)->fOffset1)));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-            //----------------------------------------------------
-            // Standard math operations : Value inverted version
-            // (non commutative operations)
-            //----------------------------------------------------
-
-        do_kSubRealValueInvert: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) - (*it)->fRealValue));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kSubIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) - (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kDivRealValueInvert: {
-            VEC_LOOP(PUSH_VEC_REAL(READ_HEAP_VEC_REAL((*it)->fOffset1) / (*it)->fRealValue));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kDivIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) / (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kRemRealValueInvert: {
-            VEC_LOOP(PUSH_VEC_REAL(
-                std::remainder(READ_HEAP_VEC_REAL((*it)->fOffset1), (*it)->fRealValue)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kRemIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) % (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Shift operation
-        do_kLshIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) << (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kARshIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) >> (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Int
-        do_kGTIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) > (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) < (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGEIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) >= (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLEIntValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_INT((*it)->fOffset1) <= (*it)->fIntValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        // Comparaison Real
-        do_kGTRealValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) > (*it)->fRealValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLTRealValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) < (*it)->fRealValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kGERealValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) >= (*it)->fRealValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kLERealValueInvert: {
-            VEC_LOOP(PUSH_VEC_INT(READ_HEAP_VEC_REAL((*it)->fOffset1) <= (*it)->fRealValue));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-            //---------------------
-            // Extended unary math
-            //---------------------
-
-        do_kAbs: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(std::abs(v1_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
-
-        do_kAbsf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::fabs(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAcosf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::acos(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAsinf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::asin(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kAtanf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::atan(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kCeilf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::ceil(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kCosf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::cos(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kCoshf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::cosh(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kExpf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::exp(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
-
-        do_kFloorf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::floor(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+static std::string gFBCVecInstructionTable[] = {
 
-        do_kLogf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::log(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Loop prologue
+    "kBroadcastReal", "kBroadcastInt", "kBroadcastIndexedReal", "kBroadcastIndexedInt",
+    "kBroadcastIndexedClassReal", "kBroadcastIndexedClassInt",
 
-        do_kLog10f: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::log10(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Memory
+    "kAffineInt", "kMoveReal", "kMoveInt", "kLoadRangeReal", "kLoadRangeInt", "kStoreRangeReal",
+    "kStoreRangeInt", "kLoadIndexedReal", "kLoadIndexedInt", "kLoadIndexedClassReal",
+    "kLoadIndexedClassInt", "kLoadInputRange", "kLoadInput", "kStoreOutputRange",
 
-        do_kRintf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::rint(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Cast/Bitcast
+    "kCastReal", "kCastInt", "kBitcastInt", "kBitcastReal",
 
-        do_kRoundf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::round(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Standard math
+    "kAddReal", "kAddInt", "kSubReal", "kSubInt", "kMultReal", "kMultInt", "kDivReal", "kDivInt",
+    "kRemReal", "kRemInt", "kLshInt", "kARshInt", "kLRshInt", "kGTInt", "kLTInt", "kGEInt",
+    "kLEInt", "kEQInt", "kNEInt", "kGTReal", "kLTReal", "kGEReal", "kLEReal", "kEQReal", "kNEReal",
+    "kANDInt", "kORInt", "kXORInt",
 
-        do_kSinf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::sin(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Extended unary math
+    "kAbs", "kAbsf", "kAcosf", "kAcoshf", "kAsinf", "kAsinhf", "kAtanf", "kAtanhf", "kCeilf",
+    "kCosf", "kCoshf", "kExpf", "kFloorf", "kLogf", "kLog10f", "kRintf", "kRoundf", "kSinf",
+    "kSinhf", "kSqrtf", "kTanf", "kTanhf", "kIsnanf", "kIsinff",
 
-        do_kSinhf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::sinh(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Extended binary math
+    "kAtan2f", "kFmodf", "kPowf", "kMax", "kMaxf", "kMin", "kMinf", "kCopysignf",
 
-        do_kSqrtf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::sqrt(v1_real[j])));
-            dispatchNextVec();
-        }
+    // Select
+    "kSelectReal", "kSelectInt"};
 
-        do_kTanf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::tan(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+// A lowered loop
+struct FBCVecLoop {
+    typedef std::vector<FBCVecInstruction> Code;
 
-        do_kTanhf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::tanh(v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    int fCounter;    // Int heap cell of the loop variable
+    int fStart;      // Initial value of the loop variable
+    int fBoundCell;  // The loop runs while 'loop variable < heap[fBoundCell] + fBound'
+    int fBound;
 
-            //------------------------------------
-            // Extended unary math (heap version)
-            ///-----------------------------------
+    Code fPrologue;  // Executed once per loop execution
+    Code fBody;      // Executed for each chunk of VEC iterations
 
-        do_kAbsHeap: {
-            VEC_LOOP(PUSH_VEC_INT(std::abs(READ_HEAP_VEC_INT((*it)->fOffset1))));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+    // DSP fields written in the body (heap cell, register), set from the last iteration
+    std::vector<std::pair<int, int>> fIntFields;
+    std::vector<std::pair<int, int>> fRealFields;
+};
 
-        do_kAbsfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::fabs(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+template <class REAL>
+struct FBCVecCode;
 
-        do_kAcosfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::acos(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+/*
+ Lower the vector loops of a flat block in a FBCVecCode.
+*/
+template <class REAL>
+class FBCVecCompiler {
+   public:
+    // A flat instruction where superinstructions are decoded, and branches are absolute
+    struct Instruction {
+        FBCInstruction::Opcode fOpcode;
+        int                    fIntValue;
+        REAL                   fRealValue;
+        int                    fOffset1;
+        int                    fOffset2;
+        FlatInstructionIT      fBranch1;
+        FlatInstructionIT      fBranch2;
+    };
+
+    static const FBCSuperInstruction* getSuperInstruction(FBCInstruction::Opcode op)
+    {
+        for (const auto& super : gFBCSuperInstructionTable) {
+            if (super.fOpcode == op) return &super;
         }
+        return nullptr;
+    }
 
-        do_kAsinfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::asin(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    // Decode the flat block starting at 'it', up to its kReturn (excluded)
+    static std::vector<Instruction> decodeBlock(FlatInstructionIT it)
+    {
+        std::vector<Instruction> res;
+        for (; it->fOpcode != FBCInstruction::kReturn; it++) {
+            const FBCSuperInstruction* super = getSuperInstruction(it->fOpcode);
+            if (super) {
+                // Same slots order as FBCFlatBlock::fuseInstructions
+                int slots[] = {it->fOffset1, it->fOffset2, it->fBranch1, it->fBranch2, it->fIntValue};
+                int slot    = 0;
+                for (int i = 0; i < super->fSize; i++) {
+                    Instruction inst = {super->fInstructions[i], 0, 0, 0, 0, nullptr, nullptr};
+                    if (super->fOperands[i] & kFuseOffset1) inst.fOffset1 = slots[slot++];
+                    if (super->fOperands[i] & kFuseOffset2) inst.fOffset2 = slots[slot++];
+                    if (super->fOperands[i] & kFuseInt) inst.fIntValue = slots[slot++];
+                    if (super->fOperands[i] & kFuseReal) inst.fRealValue = it->fRealValue;
+                    res.push_back(inst);
+                }
+            } else {
+                res.push_back({it->fOpcode, it->fIntValue, it->fRealValue, it->fOffset1,
+                               it->fOffset2, (it->fBranch1) ? it + it->fBranch1 : nullptr,
+                               (it->fBranch2) ? it + it->fBranch2 : nullptr});
+            }
         }
+        return res;
+    }
 
-        do_kAtanfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::atan(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+   private:
+    /*
+     kAffine (int) : 'loop variable (if fLoopVar) + heap[fCell] (if fCell >= 0) + fValue', where
+     the cell is not written in the body
+     kConstant (real) : fRealValue
+     kUniform (real) : heap[fCell], where the cell is not written in the body
+     kRegister : fReg, a temporary (fTemp) or the register of a DSP field
+     kCondition (int) : the loop test 'loop variable < heap[fCell] + fValue', after the increment
+    */
+    enum OperandKind { kAffine, kConstant, kUniform, kRegister, kCondition };
+
+    struct Operand {
+        OperandKind fKind;
+        bool        fLoopVar;
+        int         fCell;
+        int         fValue;
+        REAL        fRealValue;
+        int         fReg;
+        bool        fTemp;
+    };
+
+    // An array access, at 'loop variable + heap[fCell] + fValue' for ranges
+    struct Access {
+        bool fReal;
+        bool fStore;
+        bool fRange;
+        int  fOffset;
+        int  fSize;
+        int  fCell;
+        int  fValue;
+    };
+
+    FBCVecCode<REAL>* fCode;
+    FBCVecLoop*       fLoop;
+    FlatInstructionIT fBodyStart;
+
+    std::vector<Operand> fIntStack;
+    std::vector<Operand> fRealStack;
+
+    std::set<int> fIntWritten;  // DSP fields written in the body
+    std::set<int> fRealWritten;
+    std::set<int> fIntRead;  // DSP fields read in the body
+    std::set<int> fRealRead;
+
+    std::map<int, int> fIntFields;  // Written DSP fields and their register
+    std::map<int, int> fRealFields;
+    std::map<int, int> fIntUniforms;  // Broadcast DSP fields and their register
+    std::map<int, int> fRealUniforms;
+
+    std::vector<int> fIntFree;
+    std::vector<int> fRealFree;
+    int              fIntRegisters;
+    int              fRealRegisters;
+
+    std::vector<Access> fAccesses;
+
+    bool fLoadsInput;
+    bool fStoresOutput;
+    bool fSameIO;
+    bool fHasIO;
+    int  fIOCell;
+    int  fIOValue;
+
+    int  fLastResult;  // Index of the last instruction pushing a result, or -1
+    bool fLastReal;
+    int  fBranchDepth;
+    bool fIncremented;
+    bool fDone;
+    bool fFailed;
+
+    static Operand affine(bool loop_var, int cell, int value)
+    {
+        return {kAffine, loop_var, cell, value, 0, 0, false};
+    }
+    static Operand constant(REAL value) { return {kConstant, false, -1, 0, value, 0, false}; }
+    static Operand uniform(int cell) { return {kUniform, false, cell, 0, 0, 0, false}; }
+    static Operand reg(int reg, bool temp) { return {kRegister, false, -1, 0, 0, reg, temp}; }
 
-        do_kCeilfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::ceil(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    std::vector<Operand>& getStack(bool real) { return (real) ? fRealStack : fIntStack; }
 
-        do_kCosfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::cos(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    Operand pop(bool real)
+    {
+        std::vector<Operand>& stack = getStack(real);
+        if (stack.empty()) {
+            fFailed = true;
+            return affine(false, -1, 0);
+        }
+        Operand res = stack.back();
+        stack.pop_back();
+        return res;
+    }
 
-        do_kCoshfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::cosh(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    void emit(int opcode, int dst, int src1 = 0, int src2 = 0, int src3 = 0)
+    {
+        fLoop->fBody.push_back({opcode, dst, src1, src2, src3});
+        fLastResult = -1;
+    }
 
-        do_kExpfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::exp(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // The destination is allocated before the sources are released, so it is never one of them
+    void emitResult(int opcode, bool real, int src1 = 0, int src2 = 0, int src3 = 0)
+    {
+        int dst = newRegister(real);
+        emit(opcode, dst, src1, src2, src3);
+        fLastResult = int(fLoop->fBody.size()) - 1;
+        fLastReal   = real;
+        getStack(real).push_back(reg(dst, true));
+    }
 
-        do_kFloorfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::floor(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    // Registers of the prologue are always new, since the body code that precedes their use may
+    // reuse a free register
+    int newRegister(bool real, bool fresh = false)
+    {
+        std::vector<int>& free = (real) ? fRealFree : fIntFree;
+        if (!fresh && !free.empty()) {
+            int res = free.back();
+            free.pop_back();
+            return res;
         }
+        return (real) ? fRealRegisters++ : fIntRegisters++;
+    }
 
-        do_kLogfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::log(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    void release(bool real, const Operand& op)
+    {
+        if (op.fKind == kRegister && op.fTemp) {
+            ((real) ? fRealFree : fIntFree).push_back(op.fReg);
         }
+    }
 
-        do_kLog10fHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::log10(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    int getIntConstant(int value)
+    {
+        std::vector<int>& table = fCode->fIntConstants;
+        auto              it    = std::find(table.begin(), table.end(), value);
+        if (it == table.end()) {
+            table.push_back(value);
+            it = table.end() - 1;
         }
+        return -int(it - table.begin()) - 1;
+    }
 
-        do_kRintfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::rint(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    int getRealConstant(REAL value)
+    {
+        // Compared as bits, so that NaN constants are kept
+        std::vector<REAL>& table = fCode->fRealConstants;
+        for (size_t i = 0; i < table.size(); i++) {
+            if (memcmp(&table[i], &value, sizeof(REAL)) == 0) return -int(i) - 1;
         }
+        table.push_back(value);
+        return -int(table.size());
+    }
 
-        do_kRoundfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::round(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    int getUniform(bool real, int cell)
+    {
+        std::map<int, int>& uniforms = (real) ? fRealUniforms : fIntUniforms;
+        auto                it       = uniforms.find(cell);
+        if (it != uniforms.end()) return it->second;
+        int res = newRegister(real, true);
+        fLoop->fPrologue.push_back(
+            {(real) ? FBCVecInstruction::kBroadcastReal : FBCVecInstruction::kBroadcastInt, res,
+             cell, 0, 0});
+        uniforms[cell] = res;
+        return res;
+    }
 
-        do_kSinfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::sin(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    int getField(bool real, int cell)
+    {
+        std::map<int, int>& fields = (real) ? fRealFields : fIntFields;
+        auto                it     = fields.find(cell);
+        if (it != fields.end()) return it->second;
+        int res      = newRegister(real);
+        fields[cell] = res;
+        ((real) ? fLoop->fRealFields : fLoop->fIntFields).push_back(std::make_pair(cell, res));
+        return res;
+    }
 
-        do_kSinhfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::sinh(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    // Register of an operand, affine values are computed in a temporary register
+    int use(bool real, Operand& op)
+    {
+        switch (op.fKind) {
+            case kRegister:
+                return op.fReg;
+            case kConstant:
+                return getRealConstant(op.fRealValue);
+            case kUniform:
+                return getUniform(true, op.fCell);
+            case kAffine:
+                if (!op.fLoopVar && op.fCell < 0) {
+                    return getIntConstant(op.fValue);
+                } else if (!op.fLoopVar && op.fValue == 0) {
+                    return getUniform(false, op.fCell);
+                } else {
+                    int dst = newRegister(false);
+                    emit(FBCVecInstruction::kAffineInt, dst, op.fCell, op.fValue, op.fLoopVar);
+                    op = reg(dst, true);
+                    return dst;
+                }
+            default:
+                fFailed = true;
+                return 0;
         }
+    }
 
-        do_kSqrtfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::sqrt(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    Operand loadField(bool real, int cell)
+    {
+        if (!real && cell == fLoop->fCounter) {
+            return affine(true, -1, (fIncremented) ? 1 : 0);
         }
-
-        do_kTanfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::tan(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+        ((real) ? fRealRead : fIntRead).insert(cell);
+        std::map<int, int>& fields = (real) ? fRealFields : fIntFields;
+        auto                it     = fields.find(cell);
+        if (it != fields.end()) {
+            return reg(it->second, false);
         }
-
-        do_kTanhfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::tanh(READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+        if (((real) ? fRealWritten : fIntWritten).count(cell)) {
+            // Read before being written : value of the previous iteration
+            fFailed = true;
         }
+        return (real) ? uniform(cell) : affine(false, cell, 0);
+    }
 
-            //----------------------
-            // Extended binary math
-            //----------------------
-
-        do_kAtan2f: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::atan2(v1_real[j], v2_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    // Copy in temporaries the stack values that are the register of a field before it is written
+    void materializeField(bool real, int reg_field)
+    {
+        for (auto& op : getStack(real)) {
+            if (op.fKind == kRegister && !op.fTemp && op.fReg == reg_field) {
+                int dst = newRegister(real);
+                emit((real) ? FBCVecInstruction::kMoveReal : FBCVecInstruction::kMoveInt, dst,
+                     reg_field);
+                op = reg(dst, true);
+            }
         }
+    }
 
-        do_kFmodf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::fmod(v1_real[j], v2_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    void storeField(bool real, int cell)
+    {
+        Operand value = pop(real);
+        if (fBranchDepth > 0 || fIncremented) {
+            fFailed = true;
+            return;
+        }
+        if (!real && cell == fLoop->fCounter) {
+            // Only the loop increment is accepted
+            fIncremented = true;
+            fFailed      = fFailed || !(value.fKind == kAffine && value.fLoopVar &&
+                                   value.fCell < 0 && value.fValue == 1);
+            return;
+        }
+        int reg_field = getField(real, cell);
+        materializeField(real, reg_field);
+        if (value.fKind == kRegister && value.fTemp && fLastResult >= 0 && fLastReal == real &&
+            fLoop->fBody[fLastResult].fDst == value.fReg &&
+            fLoop->fBody[fLastResult].fSrc1 != reg_field &&
+            fLoop->fBody[fLastResult].fSrc2 != reg_field &&
+            fLoop->fBody[fLastResult].fSrc3 != reg_field) {
+            // The last result is directly computed in the field register
+            fLoop->fBody[fLastResult].fDst = reg_field;
+            release(real, value);
+        } else {
+            int src = use(real, value);
+            if (src != reg_field) {
+                emit((real) ? FBCVecInstruction::kMoveReal : FBCVecInstruction::kMoveInt,
+                     reg_field, src);
+            }
+            release(real, value);
         }
+    }
 
-        do_kPowf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::pow(v1_real[j], v2_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    void addAccess(bool real, bool store, bool range, int offset, int size, int cell = -1,
+                   int value = 0)
+    {
+        fAccesses.push_back({real, store, range, offset, size, cell, value});
+    }
 
-        do_kMax: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(std::max(v1_int[j], v2_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
+    void loadIndexed(bool real, int offset, int size)
+    {
+        Operand index = pop(false);
+        if (index.fKind == kAffine && !index.fLoopVar) {
+            // Invariant index : loaded once per loop execution
+            addAccess(real, false, false, offset, size);
+            int dst = newRegister(real, true);
+            fLoop->fPrologue.push_back({(real) ? FBCVecInstruction::kBroadcastIndexedReal
+                                               : FBCVecInstruction::kBroadcastIndexedInt,
+                                        dst, index.fCell, index.fValue, offset});
+            getStack(real).push_back(reg(dst, false));
+        } else if (fBranchDepth > 0) {
+            // Would be done for lanes where the index may be out of the array
+            fFailed = true;
+        } else if (index.fKind == kAffine) {
+            addAccess(real, false, true, offset, size, index.fCell, index.fValue);
+            emitResult((real) ? FBCVecInstruction::kLoadRangeReal : FBCVecInstruction::kLoadRangeInt,
+                       real, index.fCell, index.fValue, offset);
+        } else {
+            addAccess(real, false, false, offset, size);
+            int src = use(false, index);
+            emitResult(
+                (real) ? FBCVecInstruction::kLoadIndexedReal : FBCVecInstruction::kLoadIndexedInt,
+                real, src, 0, offset);
+            release(false, index);
         }
+    }
 
-        do_kMaxf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::max(v1_real[j], v2_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    // The class segment is read-only and in other heaps, so its accesses are not checked
+    void loadIndexedClass(bool real, int offset)
+    {
+        Operand index = pop(false);
+        if (index.fKind == kAffine && !index.fLoopVar) {
+            int dst = newRegister(real, true);
+            fLoop->fPrologue.push_back({(real) ? FBCVecInstruction::kBroadcastIndexedClassReal
+                                               : FBCVecInstruction::kBroadcastIndexedClassInt,
+                                        dst, index.fCell, index.fValue, offset});
+            getStack(real).push_back(reg(dst, false));
+        } else if (fBranchDepth > 0) {
+            fFailed = true;
+        } else {
+            int src = use(false, index);
+            emitResult((real) ? FBCVecInstruction::kLoadIndexedClassReal
+                              : FBCVecInstruction::kLoadIndexedClassInt,
+                       real, src, 0, offset);
+            release(false, index);
         }
+    }
 
-        do_kMin: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(v2_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(std::min(v1_int[j], v2_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+    void storeIndexed(bool real, int offset, int size)
+    {
+        Operand index = pop(false);
+        Operand value = pop(real);
+        if (fBranchDepth > 0 || fIncremented || index.fKind != kAffine || !index.fLoopVar) {
+            fFailed = true;
+            return;
+        }
+        addAccess(real, true, true, offset, size, index.fCell, index.fValue);
+        int src = use(real, value);
+        emit((real) ? FBCVecInstruction::kStoreRangeReal : FBCVecInstruction::kStoreRangeInt, src,
+             index.fCell, index.fValue, offset);
+        release(real, value);
+    }
 
-        do_kMinf: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(v2_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::min(v1_real[j], v2_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    void addIO(const Operand& index)
+    {
+        if (index.fKind != kAffine || !index.fLoopVar) {
+            fSameIO = false;
+        } else if (!fHasIO) {
+            fHasIO   = true;
+            fIOCell  = index.fCell;
+            fIOValue = index.fValue;
+        } else if (fIOCell != index.fCell || fIOValue != index.fValue) {
+            fSameIO = false;
         }
+    }
 
-            //-------------------------------------
-            // Extended binary math (heap version)
-            //-------------------------------------
-
-        do_kAtan2fHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::atan2(READ_HEAP_VEC_REAL((*it)->fOffset1),
-                                              READ_HEAP_VEC_REAL((*it)->fOffset2))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    void loadInput(int channel)
+    {
+        Operand index = pop(false);
+        if (fBranchDepth > 0) {
+            fFailed = true;
+            return;
+        }
+        fLoadsInput = true;
+        addIO(index);
+        if (index.fKind == kAffine && index.fLoopVar) {
+            emitResult(FBCVecInstruction::kLoadInputRange, true, index.fCell, index.fValue,
+                       channel);
+        } else {
+            int src = use(false, index);
+            emitResult(FBCVecInstruction::kLoadInput, true, src, 0, channel);
+            release(false, index);
         }
+    }
 
-        do_kFmodfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::fmod(READ_HEAP_VEC_REAL((*it)->fOffset1),
-                                             READ_HEAP_VEC_REAL((*it)->fOffset2))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    void storeOutput(int channel)
+    {
+        Operand index = pop(false);
+        Operand value = pop(true);
+        if (fBranchDepth > 0 || fIncremented || index.fKind != kAffine || !index.fLoopVar) {
+            fFailed = true;
+            return;
+        }
+        fStoresOutput = true;
+        addIO(index);
+        int src = use(true, value);
+        emit(FBCVecInstruction::kStoreOutputRange, src, index.fCell, index.fValue, channel);
+        release(true, value);
+    }
 
-        do_kPowfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::pow(READ_HEAP_VEC_REAL((*it)->fOffset1),
-                                            READ_HEAP_VEC_REAL((*it)->fOffset2))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    void compileUnary(int opcode, bool real_op, bool real_res)
+    {
+        Operand v1 = pop(real_op);
+        int     r1 = use(real_op, v1);
+        emitResult(opcode, real_res, r1);
+        release(real_op, v1);
+    }
 
-        do_kMaxHeap: {
-            VEC_LOOP(PUSH_VEC_INT(
-                std::max(READ_HEAP_VEC_INT((*it)->fOffset1), READ_HEAP_VEC_INT((*it)->fOffset2))));
-            STACK_UP_INT();
-            dispatchNextVec();
+    // Integer additions and subtractions of affine values are kept symbolic
+    bool foldAffine(FBCInstruction::Opcode op, const Operand& v1, const Operand& v2)
+    {
+        if (v1.fKind != kAffine || v2.fKind != kAffine) {
+            return false;
+        } else if (op == FBCInstruction::kAddInt && !(v1.fLoopVar && v2.fLoopVar) &&
+                   !(v1.fCell >= 0 && v2.fCell >= 0)) {
+            fIntStack.push_back(affine(v1.fLoopVar || v2.fLoopVar,
+                                       (v1.fCell >= 0) ? v1.fCell : v2.fCell,
+                                       v1.fValue + v2.fValue));
+            return true;
+        } else if (op == FBCInstruction::kSubInt && !v2.fLoopVar && v2.fCell < 0) {
+            fIntStack.push_back(affine(v1.fLoopVar, v1.fCell, v1.fValue - v2.fValue));
+            return true;
+        } else {
+            return false;
         }
+    }
 
-        do_kMaxfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::max(READ_HEAP_VEC_REAL((*it)->fOffset1),
-                                            READ_HEAP_VEC_REAL((*it)->fOffset2))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Math operations on the stack : the left operand is on top
+    void compileOperation(FBCInstruction::Opcode op)
+    {
+        bool real_op  = FBCRegisterCompiler<REAL>::isRealOperand(op);
+        bool real_res = FBCInstruction::isRealType(op);
+        if ((op >= FBCInstruction::kAbs) && (op <= FBCInstruction::kIsinff)) {
+            compileUnary(FBCVecInstruction::kAbs + (op - FBCInstruction::kAbs), real_op, real_res);
+            return;
+        }
+
+        Operand v1 = pop(real_op);
+        Operand v2 = pop(real_op);
+        if (!real_op && foldAffine(op, v1, v2)) {
+            return;
+        }
+        if (op == FBCInstruction::kLTInt && fIncremented && fBranchDepth == 0 &&
+            v1.fKind == kAffine && v1.fLoopVar && v1.fCell < 0 && v1.fValue == 1 &&
+            v2.fKind == kAffine && !v2.fLoopVar) {
+            // The loop test
+            fIntStack.push_back({kCondition, false, v2.fCell, v2.fValue, 0, 0, false});
+            return;
+        }
+        if (fBranchDepth > 0 && (op == FBCInstruction::kDivInt || op == FBCInstruction::kRemInt)) {
+            // Lanes of the branch not taken may divide by zero
+            fFailed = true;
+            return;
+        }
+
+        int opcode = (FBCInstruction::isMath(op))
+                         ? FBCVecInstruction::kAddReal + (op - FBCInstruction::kAddReal)
+                         : FBCVecInstruction::kAtan2f + (op - FBCInstruction::kAtan2f);
+        int r1 = use(real_op, v1);
+        int r2 = use(real_op, v2);
+        emitResult(opcode, real_res, r1, r2);
+        release(real_op, v1);
+        release(real_op, v2);
+    }
 
-        do_kMinHeap: {
-            VEC_LOOP(PUSH_VEC_INT(
-                std::min(READ_HEAP_VEC_INT((*it)->fOffset1), READ_HEAP_VEC_INT((*it)->fOffset2))));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+    bool compileMath(const Instruction& inst)
+    {
+        FBCInstruction::Opcode base;
+        int                    left;
+        int                    right;
+        if (!FBCRegisterCompiler<REAL>::decodeMath(inst.fOpcode, base, left, right)) {
+            return false;
+        }
+
+        // The right operand is pushed first
+        bool                  real  = FBCRegisterCompiler<REAL>::isRealOperand(base);
+        std::vector<Operand>& stack = getStack(real);
+        if (right == 1) {
+            Operand op = loadField(real, (left == 1) ? inst.fOffset2 : inst.fOffset1);
+            stack.push_back(op);
+        } else if (right == 2) {
+            stack.push_back((real) ? constant(inst.fRealValue) : affine(false, -1, inst.fIntValue));
+        }
+        if (left == 1) {
+            Operand op = loadField(real, inst.fOffset1);
+            stack.push_back(op);
+        } else if (left == 2) {
+            stack.push_back((real) ? constant(inst.fRealValue) : affine(false, -1, inst.fIntValue));
+        }
+        compileOperation(base);
+        return true;
+    }
 
-        do_kMinfHeap: {
-            VEC_LOOP(PUSH_VEC_REAL(std::min(READ_HEAP_VEC_REAL((*it)->fOffset1),
-                                            READ_HEAP_VEC_REAL((*it)->fOffset2))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Compile a Select branch, that pushes a single value
+    Operand compileBranch(FlatInstructionIT block, bool real)
+    {
+        size_t int_size  = fIntStack.size();
+        size_t real_size = fRealStack.size();
+        compileInstructions(decodeBlock(block));
+        if (fIntStack.size() != int_size + ((real) ? 0 : 1) ||
+            fRealStack.size() != real_size + ((real) ? 1 : 0)) {
+            fFailed = true;
+            return affine(false, -1, 0);
+        }
+        return pop(real);
+    }
 
-            //--------------------------------------
-            // Extended binary math (stack version)
-            //--------------------------------------
+    void compileSelect(const Instruction& inst)
+    {
+        bool    real = inst.fOpcode == FBCInstruction::kSelectReal;
+        Operand cond = pop(false);
+        if (!inst.fBranch1 || !inst.fBranch2 || fFailed) {
+            fFailed = true;
+            return;
+        }
+        fBranchDepth++;
+        Operand v1 = compileBranch(inst.fBranch1, real);
+        Operand v2 = (fFailed) ? v1 : compileBranch(inst.fBranch2, real);
+        fBranchDepth--;
+        if (fFailed) return;
+
+        int rc = use(false, cond);
+        int r1 = use(real, v1);
+        int r2 = use(real, v2);
+        emitResult((real) ? FBCVecInstruction::kSelectReal : FBCVecInstruction::kSelectInt, real,
+                   rc, r1, r2);
+        release(false, cond);
+        release(real, v1);
+        release(real, v2);
+    }
 
-        do_kAtan2fStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::atan2(READ_HEAP_VEC_REAL((*it)->fOffset1), v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    void compileInstruction(const Instruction& inst)
+    {
+        typedef FBCInstruction I;
+
+        switch (inst.fOpcode) {
+            case I::kNop:
+                break;
+
+            case I::kRealValue:
+                fRealStack.push_back(constant(inst.fRealValue));
+                break;
+            case I::kInt32Value:
+                fIntStack.push_back(affine(false, -1, inst.fIntValue));
+                break;
+
+            case I::kLoadReal:
+            case I::kLoadInt: {
+                bool    real = inst.fOpcode == I::kLoadReal;
+                Operand op   = loadField(real, inst.fOffset1);
+                getStack(real).push_back(op);
+                break;
+            }
+            case I::kStoreReal:
+                storeField(true, inst.fOffset1);
+                break;
+            case I::kStoreInt:
+                storeField(false, inst.fOffset1);
+                break;
+            case I::kStoreRealValue:
+                fRealStack.push_back(constant(inst.fRealValue));
+                storeField(true, inst.fOffset1);
+                break;
+            case I::kStoreIntValue:
+                fIntStack.push_back(affine(false, -1, inst.fIntValue));
+                storeField(false, inst.fOffset1);
+                break;
+            case I::kMoveReal:
+            case I::kMoveInt: {
+                bool    real = inst.fOpcode == I::kMoveReal;
+                Operand op   = loadField(real, inst.fOffset2);
+                getStack(real).push_back(op);
+                storeField(real, inst.fOffset1);
+                break;
+            }
 
-        do_kFmodfStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::fmod(READ_HEAP_VEC_REAL((*it)->fOffset1), v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+            case I::kLoadIndexedReal:
+            case I::kLoadIndexedInt:
+                loadIndexed(inst.fOpcode == I::kLoadIndexedReal, inst.fOffset1, inst.fOffset2);
+                break;
+            case I::kLoadIndexedClassReal:
+            case I::kLoadIndexedClassInt:
+                loadIndexedClass(inst.fOpcode == I::kLoadIndexedClassReal, inst.fOffset1);
+                break;
+            case I::kStoreIndexedReal:
+            case I::kStoreIndexedInt:
+                storeIndexed(inst.fOpcode == I::kStoreIndexedReal, inst.fOffset1, inst.fOffset2);
+                break;
+
+            case I::kLoadInput:
+                loadInput(inst.fOffset1);
+                break;
+            case I::kStoreOutput:
+                storeOutput(inst.fOffset1);
+                break;
+
+            case I::kCastRealHeap:
+                fIntStack.push_back(loadField(false, inst.fOffset1));
+                compileUnary(FBCVecInstruction::kCastReal, false, true);
+                break;
+            case I::kCastReal:
+                compileUnary(FBCVecInstruction::kCastReal, false, true);
+                break;
+            case I::kCastIntHeap:
+                fRealStack.push_back(loadField(true, inst.fOffset1));
+                compileUnary(FBCVecInstruction::kCastInt, true, false);
+                break;
+            case I::kCastInt:
+                compileUnary(FBCVecInstruction::kCastInt, true, false);
+                break;
+            case I::kBitcastInt:
+                compileUnary(FBCVecInstruction::kBitcastInt, true, false);
+                break;
+            case I::kBitcastReal:
+                compileUnary(FBCVecInstruction::kBitcastReal, false, true);
+                break;
+
+            case I::kSelectReal:
+            case I::kSelectInt:
+                compileSelect(inst);
+                break;
+
+            case I::kCondBranch: {
+                Operand cond = pop(false);
+                if (fBranchDepth > 0 || cond.fKind != kCondition || inst.fBranch1 != fBodyStart) {
+                    fFailed = true;
+                } else {
+                    fDone             = true;
+                    fLoop->fBoundCell = cond.fCell;
+                    fLoop->fBound     = cond.fValue;
+                }
+                break;
+            }
 
-        do_kPowfStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::pow(READ_HEAP_VEC_REAL((*it)->fOffset1), v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+            default:
+                // kIf, kLoop, soundfiles, block stores and shifts are not lowered
+                if (!compileMath(inst)) {
+                    fFailed = true;
+                }
+                break;
         }
+    }
 
-        do_kMaxStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(std::max(READ_HEAP_VEC_INT((*it)->fOffset1), v1_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
+    void compileInstructions(const std::vector<Instruction>& code)
+    {
+        for (const auto& inst : code) {
+            if (fFailed) return;
+            if (fDone) {
+                fFailed = true;
+                return;
+            }
+            compileInstruction(inst);
         }
+    }
 
-        do_kMaxfStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::max(READ_HEAP_VEC_REAL((*it)->fOffset1), v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    static bool inside(int cell, const Access& access)
+    {
+        return cell >= access.fOffset && cell < access.fOffset + access.fSize;
+    }
 
-        do_kMinStack: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(std::min(READ_HEAP_VEC_INT((*it)->fOffset1), v1_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+    static bool overlap(const Access& a, const Access& b)
+    {
+        return a.fOffset < b.fOffset + b.fSize && b.fOffset < a.fOffset + a.fSize;
+    }
 
-        do_kMinfStack: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::min(READ_HEAP_VEC_REAL((*it)->fOffset1), v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    // Check that the chunked execution gives the scalar result
+    bool checkAccesses()
+    {
+        for (const auto& a : fAccesses) {
+            if (a.fSize <= 0) return false;
+            for (int cell : (a.fReal) ? fRealWritten : fIntWritten) {
+                if (inside(cell, a)) return false;
+            }
+            if (!a.fStore) continue;
+            for (int cell : (a.fReal) ? fRealRead : fIntRead) {
+                if (inside(cell, a)) return false;
+            }
+            for (const auto& b : fAccesses) {
+                if (b.fReal == a.fReal && overlap(a, b) &&
+                    (!b.fRange || b.fOffset != a.fOffset || b.fCell != a.fCell ||
+                     b.fValue != a.fValue)) {
+                    return false;
+                }
+            }
         }
+        return !(fLoadsInput && fStoresOutput && !fSameIO);
+    }
 
-            //--------------------------------------------
-            // Extended binary math (stack/value version)
-            //--------------------------------------------
-
-        do_kAtan2fStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::atan2((*it)->fRealValue, v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    bool lower(FlatInstructionIT loop)
+    {
+        if (!loop->fBranch1 || !loop->fBranch2) return false;
+
+        // Loop variable declaration
+        std::vector<Instruction> init = decodeBlock(loop + loop->fBranch1);
+        if (init.size() == 2 && init[0].fOpcode == FBCInstruction::kInt32Value &&
+            init[1].fOpcode == FBCInstruction::kStoreInt) {
+            fLoop->fStart   = init[0].fIntValue;
+            fLoop->fCounter = init[1].fOffset1;
+        } else if (init.size() == 1 && init[0].fOpcode == FBCInstruction::kStoreIntValue) {
+            fLoop->fStart   = init[0].fIntValue;
+            fLoop->fCounter = init[0].fOffset1;
+        } else {
+            return false;
         }
 
-        do_kFmodfStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::fmod((*it)->fRealValue, v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+        fBodyStart                    = loop + loop->fBranch2;
+        std::vector<Instruction> body = decodeBlock(fBodyStart);
+        for (const auto& inst : body) {
+            switch (inst.fOpcode) {
+                case FBCInstruction::kStoreReal:
+                case FBCInstruction::kStoreRealValue:
+                case FBCInstruction::kMoveReal:
+                    fRealWritten.insert(inst.fOffset1);
+                    break;
+                case FBCInstruction::kStoreInt:
+                case FBCInstruction::kStoreIntValue:
+                case FBCInstruction::kMoveInt:
+                    fIntWritten.insert(inst.fOffset1);
+                    break;
+                default:
+                    break;
+            }
         }
 
-        do_kPowfStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::pow((*it)->fRealValue, v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+        compileInstructions(body);
+        return !fFailed && fDone && fIntStack.empty() && fRealStack.empty() && checkAccesses();
+    }
 
-        do_kMaxStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(std::max((*it)->fIntValue, v1_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+   public:
+    FBCVecCompiler(FBCVecCode<REAL>* code) : fCode(code) {}
 
-        do_kMaxfStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::max((*it)->fRealValue, v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    // Lower a kLoop of the flat block, the loop is ignored if it cannot be lowered
+    void compile(FlatInstructionIT loop)
+    {
+        FBCVecLoop res;
+        res.fBoundCell = -1;
+        res.fBound     = 0;
+        fLoop          = &res;
+        fIntStack.clear();
+        fRealStack.clear();
+        fIntWritten.clear();
+        fRealWritten.clear();
+        fIntRead.clear();
+        fRealRead.clear();
+        fIntFields.clear();
+        fRealFields.clear();
+        fIntUniforms.clear();
+        fRealUniforms.clear();
+        fIntFree.clear();
+        fRealFree.clear();
+        fIntRegisters  = 0;
+        fRealRegisters = 0;
+        fAccesses.clear();
+        fLoadsInput   = false;
+        fStoresOutput = false;
+        fSameIO       = true;
+        fHasIO        = false;
+        fIOCell       = -1;
+        fIOValue      = 0;
+        fLastResult   = -1;
+        fLastReal     = false;
+        fBranchDepth  = 0;
+        fIncremented  = false;
+        fDone         = false;
+        fFailed       = false;
+
+        if (lower(loop)) {
+            fCode->fIntRegisters      = std::max(fCode->fIntRegisters, fIntRegisters);
+            fCode->fRealRegisters     = std::max(fCode->fRealRegisters, fRealRegisters);
+            fCode->fLoopIndexes[loop] = int(fCode->fLoops.size());
+            fCode->fLoops.push_back(res);
+            if (fCode->fVecSize == 0) {
+                fCode->fVecSize = loop->fIntValue;
+            }
         }
+        fLoop = nullptr;
+    }
+};
 
-        do_kMinStackValue: {
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            VEC_LOOP(PUSH_VEC_INT(std::min((*it)->fIntValue, v1_int[j])));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+/*
+ Lowered loops of the DSP block of a factory, shared by all its instances.
+*/
+template <class REAL>
+struct FBCVecCode {
+    std::vector<FBCVecLoop>                    fLoops;
+    std::unordered_map<FlatInstructionIT, int> fLoopIndexes;
 
-        do_kMinfStackValue: {
-            VEC_LOOP(v1_real[j] = POP_VEC_REAL());
-            STACK_DOWN_REAL();
-            VEC_LOOP(PUSH_VEC_REAL(std::min((*it)->fRealValue, v1_real[j])));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Registers used by the loops, constants are broadcast in negative registers
+    int               fIntRegisters;
+    int               fRealRegisters;
+    std::vector<int>  fIntConstants;
+    std::vector<REAL> fRealConstants;
 
-            //-------------------------------------
-            // Extended binary math (Value version)
-            //-------------------------------------
+    int fVecSize;  // Vector size the loops have been generated with
 
-        do_kAtan2fValue: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::atan2((*it)->fRealValue, READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    FBCVecCode(FBCFlatBlock<REAL>* flat) : fIntRegisters(0), fRealRegisters(0), fVecSize(0)
+    {
+        FBCVecCompiler<REAL> compiler(this);
+        for (const auto& inst : flat->fInstructions) {
+            // Recursive loops are marked with 1
+            if (inst.fOpcode == FBCInstruction::kLoop && inst.fIntValue > 1) {
+                compiler.compile(&inst);
+            }
         }
+    }
 
-        do_kFmodfValue: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::fmod((*it)->fRealValue, READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Returns the lowered loop, or nullptr if it has to be executed by the interpreter
+    const FBCVecLoop* getLoop(FlatInstructionIT loop) const
+    {
+        auto it = fLoopIndexes.find(loop);
+        return (it != fLoopIndexes.end()) ? &fLoops[it->second] : nullptr;
+    }
 
-        do_kPowfValue: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::pow((*it)->fRealValue, READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
+    void write(std::ostream* out)
+    {
+        auto write_code = [out](const FBCVecLoop::Code& code) {
+            for (const auto& inst : code) {
+                *out << "opcode " << inst.fOpcode << " " << gFBCVecInstructionTable[inst.fOpcode]
+                     << " dst " << inst.fDst << " src1 " << inst.fSrc1 << " src2 " << inst.fSrc2
+                     << " src3 " << inst.fSrc3 << std::endl;
+            }
+        };
+        for (const auto& loop : fLoops) {
+            *out << "loop counter " << loop.fCounter << " start " << loop.fStart << " bound_cell "
+                 << loop.fBoundCell << " bound " << loop.fBound << std::endl;
+            *out << "prologue size " << loop.fPrologue.size() << std::endl;
+            write_code(loop.fPrologue);
+            *out << "body size " << loop.fBody.size() << std::endl;
+            write_code(loop.fBody);
         }
+    }
+};
 
-        do_kMaxValue: {
-            VEC_LOOP(PUSH_VEC_INT(std::max((*it)->fIntValue, READ_HEAP_VEC_INT((*it)->fOffset1))));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+#define vecLanes(exp)               \
+    for (int j = 0; j < n; j++) {   \
+        exp;                        \
+    }
 
-        do_kMaxfValue: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::max((*it)->fRealValue, READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+#define vecUnary(op, dst, src, exp)                            \
+    case FBCVecInstruction::op: {                              \
+        dst* __restrict d  = dst##Reg(it->fDst);               \
+        const src* __restrict a = src##Reg(it->fSrc1);         \
+        vecLanes(d[j] = (exp));                                \
+        break;                                                 \
+    }
 
-        do_kMinValue: {
-            VEC_LOOP(PUSH_VEC_INT(std::min((*it)->fIntValue, READ_HEAP_VEC_INT((*it)->fOffset1))));
-            STACK_UP_INT();
-            dispatchNextVec();
-        }
+#define vecBinary(op, dst, src, exp)                           \
+    case FBCVecInstruction::op: {                              \
+        dst* __restrict d  = dst##Reg(it->fDst);               \
+        const src* __restrict a = src##Reg(it->fSrc1);         \
+        const src* __restrict b = src##Reg(it->fSrc2);         \
+        vecLanes(d[j] = (exp));                                \
+        break;                                                 \
+    }
 
-        do_kMinfValue: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::min((*it)->fRealValue, READ_HEAP_VEC_REAL((*it)->fOffset1))));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+// Vector FBC executor, loops that are not lowered and other blocks are executed by the stack interpreter
+template <class REAL, int VEC>
+class FBCVecInterpreter : public FBCInterpreter<REAL, 0> {
+   protected:
+    typedef REAL real;
 
-            //-------------------------------------------------------------------
-            // Extended binary math (Value version) : non commutative operations
-            //-------------------------------------------------------------------
+    FBCVecCode<REAL>* fCode;
 
-        do_kAtan2fValueInvert: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::atan2(READ_HEAP_VEC_REAL((*it)->fOffset1), (*it)->fRealValue)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Lanes of the registers, constants are before fIntLanes/fRealLanes
+    std::vector<int>  fIntLanesBuffer;
+    std::vector<REAL> fRealLanesBuffer;
+    int*              fIntLanes;
+    REAL*             fRealLanes;
 
-        do_kFmodfValueInvert: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::fmod(READ_HEAP_VEC_REAL((*it)->fOffset1), (*it)->fRealValue)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    inline int*  intReg(int reg) { return fIntLanes + reg * VEC; }
+    inline REAL* realReg(int reg) { return fRealLanes + reg * VEC; }
 
-        do_kPowfValueInvert: {
-            VEC_LOOP(
-                PUSH_VEC_REAL(std::pow(READ_HEAP_VEC_REAL((*it)->fOffset1), (*it)->fRealValue)));
-            STACK_UP_REAL();
-            dispatchNextVec();
-        }
+    // Invariant part of the index of a range access
+    static inline int getIndex(const FBCVecInstruction* it, const int* ih)
+    {
+        return it->fSrc2 + ((it->fSrc1 >= 0) ? ih[it->fSrc1] : 0);
+    }
 
-            //---------
-            // Control
-            //---------
+    // Execute the code for 'n' lanes, starting at 'counter' for the loop variable
+    template <bool FULL>
+    void executeCode(const FBCVecLoop::Code& code, int counter, int count)
+    {
+        const int n       = (FULL) ? VEC : count;
+        int*      ih      = this->fIntHeap;
+        REAL*     rh      = this->fRealHeap;
+        int*      cih     = this->fClassIntHeap;
+        REAL*     crh     = this->fClassRealHeap;
+        REAL**    inputs  = this->fInputs;
+        REAL**    outputs = this->fOutputs;
 
-        do_kReturn: {
-            // Empty addr stack = end of computation
-            if (emptyReturnVec()) {
-                goto end;
-            } else {
-                dispatchReturnVec();
-            }
-        }
+        for (const auto& inst : code) {
+            const FBCVecInstruction* it = &inst;
 
-        do_kIf: {
-            // Keep next instruction
-            saveReturnVec();
+            switch (it->fOpcode) {
+                // Loop prologue
+                case FBCVecInstruction::kBroadcastReal: {
+                    REAL* __restrict d = realReg(it->fDst);
+                    REAL v             = rh[it->fSrc1];
+                    vecLanes(d[j] = v);
+                    break;
+                }
+                case FBCVecInstruction::kBroadcastInt: {
+                    int* __restrict d = intReg(it->fDst);
+                    int v             = ih[it->fSrc1];
+                    vecLanes(d[j] = v);
+                    break;
+                }
+                case FBCVecInstruction::kBroadcastIndexedReal: {
+                    REAL* __restrict d = realReg(it->fDst);
+                    REAL v             = rh[it->fSrc3 + getIndex(it, ih)];
+                    vecLanes(d[j] = v);
+                    break;
+                }
+                case FBCVecInstruction::kBroadcastIndexedInt: {
+                    int* __restrict d = intReg(it->fDst);
+                    int v             = ih[it->fSrc3 + getIndex(it, ih)];
+                    vecLanes(d[j] = v);
+                    break;
+                }
+                case FBCVecInstruction::kBroadcastIndexedClassReal: {
+                    REAL* __restrict d = realReg(it->fDst);
+                    REAL v             = crh[it->fSrc3 + getIndex(it, ih)];
+                    vecLanes(d[j] = v);
+                    break;
+                }
+                case FBCVecInstruction::kBroadcastIndexedClassInt: {
+                    int* __restrict d = intReg(it->fDst);
+                    int v             = cih[it->fSrc3 + getIndex(it, ih)];
+                    vecLanes(d[j] = v);
+                    break;
+                }
+
+                // Memory
+                case FBCVecInstruction::kAffineInt: {
+                    int* __restrict d = intReg(it->fDst);
+                    if (it->fSrc3) {
+                        int v = counter + getIndex(it, ih);
+                        vecLanes(d[j] = v + j);
+                    } else {
+                        int v = getIndex(it, ih);
+                        vecLanes(d[j] = v);
+                    }
+                    break;
+                }
+                case FBCVecInstruction::kMoveReal: {
+                    REAL* __restrict d       = realReg(it->fDst);
+                    const REAL* __restrict a = realReg(it->fSrc1);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+                case FBCVecInstruction::kMoveInt: {
+                    int* __restrict d       = intReg(it->fDst);
+                    const int* __restrict a = intReg(it->fSrc1);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadRangeReal: {
+                    REAL* __restrict d       = realReg(it->fDst);
+                    const REAL* __restrict a = rh + it->fSrc3 + counter + getIndex(it, ih);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadRangeInt: {
+                    int* __restrict d       = intReg(it->fDst);
+                    const int* __restrict a = ih + it->fSrc3 + counter + getIndex(it, ih);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+                case FBCVecInstruction::kStoreRangeReal: {
+                    REAL* __restrict d       = rh + it->fSrc3 + counter + getIndex(it, ih);
+                    const REAL* __restrict a = realReg(it->fDst);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+                case FBCVecInstruction::kStoreRangeInt: {
+                    int* __restrict d       = ih + it->fSrc3 + counter + getIndex(it, ih);
+                    const int* __restrict a = intReg(it->fDst);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadIndexedReal: {
+                    REAL* __restrict d      = realReg(it->fDst);
+                    const int* __restrict a = intReg(it->fSrc1);
+                    const REAL* b           = rh + it->fSrc3;
+                    vecLanes(d[j] = b[a[j]]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadIndexedInt: {
+                    int* __restrict d       = intReg(it->fDst);
+                    const int* __restrict a = intReg(it->fSrc1);
+                    const int* b            = ih + it->fSrc3;
+                    vecLanes(d[j] = b[a[j]]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadIndexedClassReal: {
+                    REAL* __restrict d      = realReg(it->fDst);
+                    const int* __restrict a = intReg(it->fSrc1);
+                    const REAL* b           = crh + it->fSrc3;
+                    vecLanes(d[j] = b[a[j]]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadIndexedClassInt: {
+                    int* __restrict d       = intReg(it->fDst);
+                    const int* __restrict a = intReg(it->fSrc1);
+                    const int* b            = cih + it->fSrc3;
+                    vecLanes(d[j] = b[a[j]]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadInputRange: {
+                    REAL* __restrict d       = realReg(it->fDst);
+                    const REAL* __restrict a = inputs[it->fSrc3] + counter + getIndex(it, ih);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+                case FBCVecInstruction::kLoadInput: {
+                    REAL* __restrict d      = realReg(it->fDst);
+                    const int* __restrict a = intReg(it->fSrc1);
+                    const REAL* b           = inputs[it->fSrc3];
+                    vecLanes(d[j] = b[a[j]]);
+                    break;
+                }
+                case FBCVecInstruction::kStoreOutputRange: {
+                    REAL* __restrict d       = outputs[it->fSrc3] + counter + getIndex(it, ih);
+                    const REAL* __restrict a = realReg(it->fDst);
+                    vecLanes(d[j] = a[j]);
+                    break;
+                }
+
+                // Cast/Bitcast
+                vecUnary(kCastReal, real, int, REAL(a[j]));
+                vecUnary(kCastInt, int, real, int(a[j]));
+                case FBCVecInstruction::kBitcastInt: {
+                    int* __restrict d        = intReg(it->fDst);
+                    const REAL* __restrict a = realReg(it->fSrc1);
+                    vecLanes(int r = 0; memcpy(&r, &a[j], sizeof(int)); d[j] = r);
+                    break;
+                }
+                case FBCVecInstruction::kBitcastReal: {
+                    REAL* __restrict d      = realReg(it->fDst);
+                    const int* __restrict a = intReg(it->fSrc1);
+                    vecLanes(REAL r = 0; memcpy(&r, &a[j], sizeof(int)); d[j] = r);
+                    break;
+                }
+
+                // Standard math
+                vecBinary(kAddReal, real, real, a[j] + b[j]);
+                vecBinary(kAddInt, int, int, a[j] + b[j]);
+                vecBinary(kSubReal, real, real, a[j] - b[j]);
+                vecBinary(kSubInt, int, int, a[j] - b[j]);
+                vecBinary(kMultReal, real, real, a[j] * b[j]);
+                vecBinary(kMultInt, int, int, a[j] * b[j]);
+                vecBinary(kDivReal, real, real, a[j] / b[j]);
+                vecBinary(kDivInt, int, int, a[j] / b[j]);
+                vecBinary(kRemReal, real, real, std::remainder(a[j], b[j]));
+                vecBinary(kRemInt, int, int, a[j] % b[j]);
+                vecBinary(kLshInt, int, int, a[j] << b[j]);
+                vecBinary(kARshInt, int, int, a[j] >> b[j]);
+                vecBinary(kLRshInt, int, int, a[j] >> b[j]);
+                vecBinary(kGTInt, int, int, a[j] > b[j]);
+                vecBinary(kLTInt, int, int, a[j] < b[j]);
+                vecBinary(kGEInt, int, int, a[j] >= b[j]);
+                vecBinary(kLEInt, int, int, a[j] <= b[j]);
+                vecBinary(kEQInt, int, int, a[j] == b[j]);
+                vecBinary(kNEInt, int, int, a[j] != b[j]);
+                vecBinary(kGTReal, int, real, a[j] > b[j]);
+                vecBinary(kLTReal, int, real, a[j] < b[j]);
+                vecBinary(kGEReal, int, real, a[j] >= b[j]);
+                vecBinary(kLEReal, int, real, a[j] <= b[j]);
+                vecBinary(kEQReal, int, real, a[j] == b[j]);
+                vecBinary(kNEReal, int, real, a[j] != b[j]);
+                vecBinary(kANDInt, int, int, a[j] & b[j]);
+                vecBinary(kORInt, int, int, a[j] | b[j]);
+                vecBinary(kXORInt, int, int, a[j] ^ b[j]);
+
+                // Extended unary math
+                vecUnary(kAbs, int, int, std::abs(a[j]));
+                vecUnary(kAbsf, real, real, std::fabs(a[j]));
+                vecUnary(kAcosf, real, real, std::acos(a[j]));
+                vecUnary(kAcoshf, real, real, std::acosh(a[j]));
+                vecUnary(kAsinf, real, real, std::asin(a[j]));
+                vecUnary(kAsinhf, real, real, std::asinh(a[j]));
+                vecUnary(kAtanf, real, real, std::atan(a[j]));
+                vecUnary(kAtanhf, real, real, std::atanh(a[j]));
+                vecUnary(kCeilf, real, real, std::ceil(a[j]));
+                vecUnary(kCosf, real, real, std::cos(a[j]));
+                vecUnary(kCoshf, real, real, std::cosh(a[j]));
+                vecUnary(kExpf, real, real, std::exp(a[j]));
+                vecUnary(kFloorf, real, real, std::floor(a[j]));
+                vecUnary(kLogf, real, real, std::log(a[j]));
+                vecUnary(kLog10f, real, real, std::log10(a[j]));
+                vecUnary(kRintf, real, real, std::rint(a[j]));
+                vecUnary(kRoundf, real, real, std::round(a[j]));
+                vecUnary(kSinf, real, real, std::sin(a[j]));
+                vecUnary(kSinhf, real, real, std::sinh(a[j]));
+                vecUnary(kSqrtf, real, real, std::sqrt(a[j]));
+                vecUnary(kTanf, real, real, std::tan(a[j]));
+                vecUnary(kTanhf, real, real, std::tanh(a[j]));
+                vecUnary(kIsnanf, int, real, std::isnan(a[j]));
+                vecUnary(kIsinff, int, real, std::isinf(a[j]));
+
+                // Extended binary math
+                vecBinary(kAtan2f, real, real, std::atan2(a[j], b[j]));
+                vecBinary(kFmodf, real, real, std::fmod(a[j], b[j]));
+                vecBinary(kPowf, real, real, std::pow(a[j], b[j]));
+                vecBinary(kMax, int, int, std::max(a[j], b[j]));
+                vecBinary(kMaxf, real, real, std::max(a[j], b[j]));
+                vecBinary(kMin, int, int, std::min(a[j], b[j]));
+                vecBinary(kMinf, real, real, std::min(a[j], b[j]));
+                vecBinary(kCopysignf, real, real, std::copysign(a[j], b[j]));
+
+                // Select
+                case FBCVecInstruction::kSelectReal: {
+                    REAL* __restrict d       = realReg(it->fDst);
+                    const int* __restrict c  = intReg(it->fSrc1);
+                    const REAL* __restrict a = realReg(it->fSrc2);
+                    const REAL* __restrict b = realReg(it->fSrc3);
+                    vecLanes(d[j] = (c[j]) ? a[j] : b[j]);
+                    break;
+                }
+                case FBCVecInstruction::kSelectInt: {
+                    int* __restrict d       = intReg(it->fDst);
+                    const int* __restrict c = intReg(it->fSrc1);
+                    const int* __restrict a = intReg(it->fSrc2);
+                    const int* __restrict b = intReg(it->fSrc3);
+                    vecLanes(d[j] = (c[j]) ? a[j] : b[j]);
+                    break;
+                }
 
-            if (POP_INT()) {
-                // Execute new block
-                interp_assert((*it)->fBranch1);
-                dispatchBranch1Vec();
-                // No value (If)
-            } else {
-                // Execute new block
-                interp_assert((*it)->fBranch2);
-                dispatchBranch2Vec();
-                // No value (If)
+                default:
+                    faustassert(false);
+                    break;
             }
         }
+    }
 
-        do_kSelectReal: {
-            // Keep next instruction
-            saveReturnVec();
-
-            // Compute condition vector
-
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            // Execute new block
-            VEC_LOOP(
-                if (v1_int[j]) { dispatchBranch1Vec(); } else { dispatchBranch2Vec(); });
-        }
-
-        do_kSelectInt: {
-            // Keep next instruction
-            saveReturnVec();
+    virtual bool executeLoop(FlatInstructionIT it)
+    {
+        const FBCVecLoop* loop = fCode->getLoop(it);
+        if (!loop) return false;
 
-            // Compute condition vector
+        int* ih    = this->fIntHeap;
+        int  bound = loop->fBound + ((loop->fBoundCell >= 0) ? ih[loop->fBoundCell] : 0);
+        // The body is executed at least once, as done by the kCondBranch at its end
+        int end = std::max(bound, loop->fStart + 1);
 
-            VEC_LOOP(v1_int[j] = POP_VEC_INT());
-            STACK_DOWN_INT();
-            // Execute new block
-            VEC_LOOP(
-                if (v1_int[j]) { dispatchBranch1Vec(); } else { dispatchBranch2Vec(); });
+        executeCode<true>(loop->fPrologue, 0, VEC);
+        int counter = loop->fStart;
+        for (; counter + VEC <= end; counter += VEC) {
+            executeCode<true>(loop->fBody, counter, VEC);
         }
-
-        do_kCondBranch: {
-            // If condition is true, just branch back on the block beginning
-            if (POP_INT()) {
-                interp_assert((*it)->fBranch1);
-                dispatchBranch1Vec();
-            } else {
-                // Just continue after 'loop block' (do the final 'return')
-                dispatchNextVec();
-            }
+        int last = VEC - 1;
+        if (counter < end) {
+            executeCode<false>(loop->fBody, counter, end - counter);
+            last = end - counter - 1;
         }
 
-        do_kLoop: {
-            // (*it)->fIntValue = vec_size
-
-            // this->ExecuteVecLoop((*it));
-
-            /*
-            if ((*it)->fIntValue == 1) {
-                this->ExecuteVecLoop<1, TRACE>((*it));
-            } else if ((*it)->fIntValue == 4) {
-                this->ExecuteVecLoop<4, TRACE>((*it));
-            } else if ((*it)->fIntValue == 8) {
-                this->ExecuteVecLoop<8, TRACE>((*it));
-            } else if ((*it)->fIntValue == 16) {
-                this->ExecuteVecLoop<16, TRACE>((*it));
-            } else if ((*it)->fIntValue == 32) {
-                this->ExecuteVecLoop<32, TRACE>((*it));
-            } else if ((*it)->fIntValue == 64) {
-                this->ExecuteVecLoop<64, TRACE>((*it));
-            } else {
-                this->ExecuteVecLoop<128, TRACE>((*it));
-            }
-            */
-
-            // Keep next instruction
-            saveReturnVec();
-
-            // Push branch2 (loop content)
-            interp_assert((*it)->fBranch2);
-            pushBranch2Vec();
-
-            // And start branch1 loop variable declaration block
-            interp_assert((*it)->fBranch1);
-            dispatchBranch1Vec();
+        // Written DSP fields and the loop variable get the values of the last iteration
+        for (const auto& field : loop->fIntFields) {
+            ih[field.first] = intReg(field.second)[last];
         }
-
-        end:
-            // printf("END real_stack_index = %d, int_stack_index = %d\n", real_stack_index,
-            // int_stack_index);
-
-            // Check stack coherency
-            interp_assert(real_stack_index == 0 && int_stack_index == 0 && sound_stack_index == 0);
-
-        } catch (faustexception& e) {
-            std::cout << e.Message();
+        for (const auto& field : loop->fRealFields) {
+            this->fRealHeap[field.first] = realReg(field.second)[last];
         }
+        ih[loop->fCounter] = end;
+        return true;
     }
 
    public:
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 0>* factory)
-    {
-        /*
-        std::cout << "FBCVecInterpreter :"
-                << " int_heap_size " << int_heap_size
-                << " real_heap_size " << real_heap_size
-                << " sr_offset " << sr_offset
-                << " count_offset " << count_offset << std::endl;
-        */
-
-        fFactory = factory;
-
-        if (fFactory->getMemoryManager()) {
-            fRealHeap = static_cast<T*>(fFactory->allocate(sizeof(T) * fFactory->fRealHeapSize));
-            fIntHeap  = static_cast<int*>(fFactory->allocate(sizeof(T) * fFactory->fIntHeapSize));
-            fInputs   = static_cast<T**>(fFactory->allocate(sizeof(T*) * fFactory->fNumInputs));
-            fOutputs  = static_cast<T**>(fFactory->allocate(sizeof(T*) * fFactory->fNumOutputs));
-        } else {
-            fRealHeap = new T[fFactory->fRealHeapSize];
-            fIntHeap  = new int[fFactory->fIntHeapSize];
-            fInputs   = new T*[fFactory->fNumInputs];
-            fOutputs  = new T*[fFactory->fNumOutputs];
-        }
-
-        // std::cout << "==== FBCVecInterpreter ==== " << std::endl;
-        // std::cout << "fRealHeapSize = " << fFactory->fRealHeapSize << std::endl;
-        // std::cout << "fIntHeapSize = " << fFactory->fIntHeapSize << std::endl;
-
-        // Initialise HEAP with 0
-        memset(fRealHeap, 0, fFactory->fRealHeapSize * sizeof(REAL));
-        memset(fIntHeap, 0, fFactory->fIntHeapSize * sizeof(int));
-    }
-
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 1>* factory)
-        : FBCVecInterpreter((interpreter_dsp_factory_aux<REAL, 0>*)factory)
-    {
-    }
-
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 2>* factory)
-        : FBCVecInterpreter((interpreter_dsp_factory_aux<REAL, 0>*)factory)
-    {
-    }
-
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 3>* factory)
-        : FBCVecInterpreter((interpreter_dsp_factory_aux<REAL, 0>*)factory)
+    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 0>* factory, FBCVecCode<REAL>* code)
+        : FBCInterpreter<REAL, 0>(factory, 0, 0, true), fCode(code)
     {
-    }
+        int int_constants  = int(code->fIntConstants.size());
+        int real_constants = int(code->fRealConstants.size());
+        fIntLanesBuffer.resize((int_constants + code->fIntRegisters) * VEC);
+        fRealLanesBuffer.resize((real_constants + code->fRealRegisters) * VEC);
+        fIntLanes  = fIntLanesBuffer.data() + int_constants * VEC;
+        fRealLanes = fRealLanesBuffer.data() + real_constants * VEC;
 
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 4>* factory)
-        : FBCVecInterpreter((interpreter_dsp_factory_aux<REAL, 0>*)factory)
-    {
+        // Constant k is register -k-1
+        for (int k = 0; k < int_constants; k++) {
+            std::fill_n(intReg(-k - 1), VEC, code->fIntConstants[k]);
+        }
+        for (int k = 0; k < real_constants; k++) {
+            std::fill_n(realReg(-k - 1), VEC, code->fRealConstants[k]);
+        }
     }
 
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 5>* factory)
-        : FBCVecInterpreter((interpreter_dsp_factory_aux<REAL, 0>*)factory)
-    {
-    }
+    virtual ~FBCVecInterpreter() {}
+};
 
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 6>* factory)
-        : FBCVecInterpreter((interpreter_dsp_factory_aux<REAL, 0>*)factory)
-    {
-    }
+#undef vecLanes
+#undef vecUnary
+#undef vecBinary
 
-    FBCVecInterpreter(interpreter_dsp_factory_aux<REAL, 7>* factory)
-        : FBCVecInterpreter((interpreter_dsp_factory_aux<REAL, 0>*)factory)
+/*
+ Create a vector executor for a factory, or return nullptr when there is no lowered loop or when
+ disabled (FAUST_INTERP_VEC=0). Only used in the non trace mode.
+*/
+template <class REAL, int TRACE>
+struct FBCVecInterpreterBuilder {
+    static FBCExecutor<REAL>* create(interpreter_dsp_factory_aux<REAL, TRACE>* factory)
     {
+        return nullptr;
     }
+};
 
-    virtual ~FBCVecInterpreter()
+template <class REAL>
+struct FBCVecInterpreterBuilder<REAL, 0> {
+    static FBCExecutor<REAL>* create(interpreter_dsp_factory_aux<REAL, 0>* factory)
     {
-        if (fFactory->getMemoryManager()) {
-            fFactory->destroy(fRealHeap);
-            fFactory->destroy(fIntHeap);
-            fFactory->destroy(fInputs);
-            fFactory->destroy(fOutputs);
+        // The lowered code is built once and shared by all instances of the factory
+        FBCVecCode<REAL>* code;
+        {
+            std::lock_guard<std::mutex> lock(factory->fCodeMutex);
+            if (!factory->fVecCode) {
+                factory->fVecCode =
+                    new FBCVecCode<REAL>(factory->getFlatBlock(factory->fComputeDSPBlock));
+            }
+            code = factory->fVecCode;
+        }
+        if (code->fLoops.empty()) return nullptr;
+
+        const char* lanes_env = getenv("FAUST_INTERP_VEC");
+        int         lanes     = (lanes_env) ? atoi(lanes_env) : code->fVecSize;
+        if (lanes >= 32) {
+            return new FBCVecInterpreter<REAL, 32>(factory, code);
+        } else if (lanes >= 16) {
+            return new FBCVecInterpreter<REAL, 16>(factory, code);
+        } else if (lanes >= 8) {
+            return new FBCVecInterpreter<REAL, 8>(factory, code);
+        } else if (lanes >= 4) {
+            return new FBCVecInterpreter<REAL, 4>(factory, code);
         } else {
-            delete[] fRealHeap;
-            delete[] fIntHeap;
-            delete[] fInputs;
-            delete[] fOutputs;
+            return nullptr;
         }
     }
-
-    void setIntValue(int offset, int value) { fIntHeap[offset] = value; }
-    int  getIntValue(int offset) { return fIntHeap[offset]; }
-
-    virtual void setInput(int offset, REAL* buffer) { fInputs[offset] = buffer; }
-    virtual void setOutput(int offset, REAL* buffer) { fOutputs[offset] = buffer; }
 };
 
 #endif
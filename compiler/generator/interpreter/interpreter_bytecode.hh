@@ -24,6 +24,7 @@
 
 #include <math.h>
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,9 @@ static inline std::string unquote1(const std::string& str)
 template <class REAL>
 struct FBCBlockInstruction;
 
+template <class REAL>
+struct FBCFlatBlock;
+
 template <class REAL>
 struct FBCBasicInstruction : public FBCInstruction {
     std::string fName;
@@ -599,11 +603,26 @@ template <class REAL>
 struct FBCBlockInstruction : public FBCInstruction {
     std::vector<FBCBasicInstruction<REAL>*> fInstructions;
 
+    // Flat version executed by the interpreter, built once the block is not modified anymore
+    FBCFlatBlock<REAL>* fFlatBlock = nullptr;
+
     virtual ~FBCBlockInstruction()
     {
         for (const auto& it : fInstructions) {
             delete it;
         }
+        delete fFlatBlock;
+    }
+
+    // 'fuse' and the class segment sizes are only used by the first call, superinstructions are not
+    // traced
+    FBCFlatBlock<REAL>* getFlatBlock(bool fuse = false, int int_class_size = 0,
+                                     int real_class_size = 0)
+    {
+        if (!fFlatBlock) {
+            fFlatBlock = new FBCFlatBlock<REAL>(this, fuse, int_class_size, real_class_size);
+        }
+        return fFlatBlock;
     }
 
     // Check block coherency
@@ -675,4 +694,222 @@ struct FBCBlockInstruction : public FBCInstruction {
     bool isRealInst() { return isRealType(fInstructions.back()->fOpcode); }
 };
 
+/*
+ Flat bytecode: the instructions of a block and of all its sub-blocks (If, Select and Loop
+ branches) packed in a single contiguous array of fixed-width records. The block comes first,
+ followed by its sub-blocks, each of them ending with its kReturn. Names are moved in a side
+ table, the values of kBlockStoreReal/kBlockStoreInt in two value tables, and branches are
+ stored as offsets relative to the branching instruction, so the array is position independent.
+
+ When 'fuse' is set, sequences of instructions of a same block are replaced by the
+ superinstructions listed in fbc_superinstructions.hh (tried in the list order).
+
+ When the class segment sizes are given, the indexed loads of the arrays of this segment (the
+ first cells of the heaps) become kLoadIndexedClassReal/Int, and are never fused.
+*/
+
+// Operands of the fused instructions, same values as in fbc_superinstructions.py
+enum { kFuseOffset1 = 1, kFuseOffset2 = 2, kFuseInt = 4, kFuseReal = 8 };
+
+struct FBCSuperInstruction {
+    FBCInstruction::Opcode fOpcode;
+    int                    fSize;
+    FBCInstruction::Opcode fInstructions[4];
+    int                    fOperands[4];
+};
+
+#define FBC_SUPER_ENTRY(name, size, op1, fuse1, op2, fuse2, op3, fuse3, op4, fuse4) \
+    {FBCInstruction::name,                                                        \
+     size,                                                                        \
+     {FBCInstruction::op1, FBCInstruction::op2, FBCInstruction::op3, FBCInstruction::op4}, \
+     {fuse1, fuse2, fuse3, fuse4}},
+
+static FBCSuperInstruction gFBCSuperInstructionTable[] = {
+    FBC_SUPERINSTRUCTIONS(FBC_SUPER_ENTRY)};
+
+#undef FBC_SUPER_ENTRY
+
+template <class REAL>
+struct FBCFlatInstruction {
+    REAL                   fRealValue;
+    FBCInstruction::Opcode fOpcode;
+    int                    fIntValue;  // index in the value tables for kBlockStoreReal/Int
+    int                    fOffset1;
+    int                    fOffset2;
+    int                    fBranch1;  // relative to this instruction, 0 if no branch
+    int                    fBranch2;  // relative to this instruction, 0 if no branch
+    int                    fName;     // index in the names table, -1 if no name
+};
+
+#define FlatInstructionIT const FBCFlatInstruction<REAL>*
+
+template <class REAL>
+struct FBCFlatBlock {
+    typedef std::map<FBCBlockInstruction<REAL>*, int> BlockStarts;
+    typedef std::map<std::string, int>                NameIndexes;
+
+    std::vector<FBCFlatInstruction<REAL>> fInstructions;
+    std::vector<std::string>              fNames;
+    std::vector<REAL>                     fRealTable;
+    std::vector<int>                      fIntTable;
+
+    FBCFlatBlock(FBCBlockInstruction<REAL>* block, bool fuse = false, int int_class_size = 0,
+                 int real_class_size = 0)
+        : fFuse(fuse), fIntClassSize(int_class_size), fRealClassSize(real_class_size)
+    {
+        BlockStarts starts;
+        NameIndexes names;
+        flatten(block, starts, names);
+        fInstructions.shrink_to_fit();
+    }
+
+    FlatInstructionIT begin() const { return fInstructions.data(); }
+
+    const std::string& getName(FlatInstructionIT inst) const
+    {
+        static std::string empty;
+        return (inst->fName >= 0) ? fNames[inst->fName] : empty;
+    }
+
+    // Same format as FBCBasicInstruction::write
+    void write(FlatInstructionIT inst, std::ostream* out) const
+    {
+        *out << "opcode " << inst->fOpcode << " " << gFBCInstructionTable[inst->fOpcode] << " int "
+             << inst->fIntValue << " real " << inst->fRealValue << " offset1 " << inst->fOffset1
+             << " offset2 " << inst->fOffset2;
+        if (inst->fName >= 0) {
+            *out << " name " << fNames[inst->fName];
+        }
+        *out << std::endl;
+    }
+
+   private:
+    bool fFuse;
+    int  fIntClassSize;
+    int  fRealClassSize;
+
+    // Returns the opcode of the instruction in the flat block
+    FBCInstruction::Opcode getOpcode(FBCBasicInstruction<REAL>* inst) const
+    {
+        if (inst->fOpcode == FBCInstruction::kLoadIndexedReal && inst->fOffset1 < fRealClassSize) {
+            return FBCInstruction::kLoadIndexedClassReal;
+        } else if (inst->fOpcode == FBCInstruction::kLoadIndexedInt &&
+                   inst->fOffset1 < fIntClassSize) {
+            return FBCInstruction::kLoadIndexedClassInt;
+        } else {
+            return inst->fOpcode;
+        }
+    }
+
+    // Returns the superinstruction starting at 'index' in the block, or nullptr
+    FBCSuperInstruction* getSuperInstruction(FBCBlockInstruction<REAL>* block, size_t index) const
+    {
+        for (auto& super : gFBCSuperInstructionTable) {
+            if (index + super.fSize > block->fInstructions.size()) continue;
+            int i = 0;
+            while (i < super.fSize &&
+                   getOpcode(block->fInstructions[index + i]) == super.fInstructions[i]) {
+                i++;
+            }
+            if (i == super.fSize) return &super;
+        }
+        return nullptr;
+    }
+
+    // The int operands are moved in the fOffset1, fOffset2, fBranch1, fBranch2 and fIntValue fields
+    static FBCFlatInstruction<REAL> fuseInstructions(FBCBlockInstruction<REAL>* block, size_t index,
+                                                     FBCSuperInstruction* super)
+    {
+        FBCFlatInstruction<REAL> inst;
+        int*                     slots[] = {&inst.fOffset1, &inst.fOffset2, &inst.fBranch1,
+                                            &inst.fBranch2, &inst.fIntValue};
+        int                      slot    = 0;
+        inst.fOpcode                     = super->fOpcode;
+        inst.fRealValue                  = 0;
+        inst.fIntValue                   = 0;
+        inst.fOffset1                    = 0;
+        inst.fOffset2                    = 0;
+        inst.fBranch1                    = 0;
+        inst.fBranch2                    = 0;
+        inst.fName                       = -1;
+        for (int i = 0; i < super->fSize; i++) {
+            FBCBasicInstruction<REAL>* it = block->fInstructions[index + i];
+            if (super->fOperands[i] & kFuseOffset1) *slots[slot++] = it->fOffset1;
+            if (super->fOperands[i] & kFuseOffset2) *slots[slot++] = it->fOffset2;
+            if (super->fOperands[i] & kFuseInt) *slots[slot++] = it->fIntValue;
+            if (super->fOperands[i] & kFuseReal) inst.fRealValue = it->fRealValue;
+        }
+        return inst;
+    }
+
+    // Append the block and then its not yet flattened sub-blocks, returns the block start
+    int flatten(FBCBlockInstruction<REAL>* block, BlockStarts& starts, NameIndexes& names)
+    {
+        int start     = int(fInstructions.size());
+        starts[block] = start;
+
+        std::vector<std::pair<int, FBCBasicInstruction<REAL>*>> branches;
+        for (size_t index = 0; index < block->fInstructions.size(); index++) {
+            FBCSuperInstruction* super = (fFuse) ? getSuperInstruction(block, index) : nullptr;
+            if (super) {
+                fInstructions.push_back(fuseInstructions(block, index, super));
+                index += super->fSize - 1;
+                continue;
+            }
+            FBCBasicInstruction<REAL>* it = block->fInstructions[index];
+            FBCFlatInstruction<REAL>   inst;
+            inst.fOpcode    = getOpcode(it);
+            inst.fIntValue  = it->fIntValue;
+            inst.fRealValue = it->fRealValue;
+            inst.fOffset1   = it->fOffset1;
+            inst.fOffset2   = it->fOffset2;
+            inst.fBranch1   = 0;
+            inst.fBranch2   = 0;
+            inst.fName      = -1;
+            if (it->fName != "") {
+                auto name = names.emplace(it->fName, int(fNames.size()));
+                if (name.second) {
+                    fNames.push_back(it->fName);
+                }
+                inst.fName = name.first->second;
+            }
+            if (it->fOpcode == FBCInstruction::kBlockStoreReal) {
+                FIRBlockStoreRealInstruction<REAL>* store =
+                    static_cast<FIRBlockStoreRealInstruction<REAL>*>(it);
+                inst.fIntValue = int(fRealTable.size());
+                fRealTable.insert(fRealTable.end(), store->fNumTable.begin(),
+                                  store->fNumTable.end());
+            } else if (it->fOpcode == FBCInstruction::kBlockStoreInt) {
+                FIRBlockStoreIntInstruction<REAL>* store =
+                    static_cast<FIRBlockStoreIntInstruction<REAL>*>(it);
+                inst.fIntValue = int(fIntTable.size());
+                fIntTable.insert(fIntTable.end(), store->fNumTable.begin(),
+                                 store->fNumTable.end());
+            }
+            if (it->fBranch1 || it->fBranch2) {
+                branches.push_back(std::make_pair(int(fInstructions.size()), it));
+            }
+            fInstructions.push_back(inst);
+        }
+
+        // Sub-blocks are appended after the block (kCondBranch branches back to its own block)
+        for (const auto& it : branches) {
+            int branch1 = getStart(it.second->fBranch1, starts, names);
+            int branch2 = getStart(it.second->fBranch2, starts, names);
+            fInstructions[it.first].fBranch1 = (branch1 >= 0) ? branch1 - it.first : 0;
+            fInstructions[it.first].fBranch2 = (branch2 >= 0) ? branch2 - it.first : 0;
+        }
+        return start;
+    }
+
+    int getStart(FBCBlockInstruction<REAL>* block, BlockStarts& starts, NameIndexes& names)
+    {
+        if (!block) {
+            return -1;
+        }
+        auto it = starts.find(block);
+        return (it != starts.end()) ? it->second : flatten(block, starts, names);
+    }
+};
+
 #endif
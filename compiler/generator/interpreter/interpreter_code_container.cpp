@@ -23,6 +23,7 @@
 
 #include "Text.hh"
 #include "exception.hh"
+#include "fbc_heap_layout.hh"
 #include "floats.hh"
 #include "global.hh"
 #include "interpreter_code_container.hh"
@@ -65,7 +66,7 @@ destroy time (after global memory allocation is implemented)
 */
 
 template <class REAL>
-map<string, FBCInstruction::Opcode> InterpreterInstVisitor<REAL>::gMathLibTable;
+thread_local map<string, FBCInstruction::Opcode> InterpreterInstVisitor<REAL>::gMathLibTable;
 
 template <class REAL>
 static FBCBlockInstruction<REAL>* getCurrentBlock()
@@ -163,7 +164,10 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
     // Sub containers are merged
     mergeSubContainers();
 
+    // Global declarations (the static tables) first, to be allocated in the class segment
     generateGlobalDeclarations(gGlobal->gInterpreterVisitor);
+    int int_class_size  = getInterpreterVisitor<REAL>()->fIntHeapOffset;
+    int real_class_size = getInterpreterVisitor<REAL>()->fRealHeapOffset;
     generateDeclarations(gGlobal->gInterpreterVisitor);
 
     // Rename 'sig' in 'dsp', remove 'dsp' allocation, inline subcontainers 'instanceInit' and
@@ -205,6 +209,24 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
     // Keep "compute_dsp_block"
     FBCBlockInstruction<REAL>* compute_dsp_block = generateCompute();
 
+    // Locality driven layout of the heaps, deactivated with FAUST_INTERP_LAYOUT=0
+    const char* layout = getenv("FAUST_INTERP_LAYOUT");
+    if (!layout || std::atoi(layout) != 0) {
+        InterpreterInstVisitor<REAL>* visitor = getInterpreterVisitor<REAL>();
+        FBCHeapLayout<REAL>           heap_layout(visitor->fFieldTable, visitor->fIntHeapOffset,
+                                                  visitor->fRealHeapOffset, int_class_size,
+                                                  real_class_size);
+        heap_layout.analyse(compute_dsp_block, FBCHeapLayout<REAL>::kHot);
+        heap_layout.analyse(compute_control_block, FBCHeapLayout<REAL>::kControl);
+        heap_layout.layout();
+        for (const auto& block : {init_static_block, init_block, resetui_block, clear_block,
+                                  compute_control_block, compute_dsp_block}) {
+            heap_layout.relocate(block);
+        }
+        heap_layout.relocate(visitor->fUserInterfaceBlock);
+        heap_layout.relocate(visitor->fFieldTable);
+    }
+
     // Generate metadata block and name
     string                   name;
     FIRMetaBlockInstruction* metadata_block = produceMetadata(name);
@@ -223,7 +245,7 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_dsp_factory_aux<REAL, 1>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
@@ -235,7 +257,7 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_dsp_factory_aux<REAL, 2>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
@@ -247,7 +269,7 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_dsp_factory_aux<REAL, 3>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
@@ -259,7 +281,7 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_dsp_factory_aux<REAL, 4>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
@@ -271,7 +293,7 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_dsp_factory_aux<REAL, 5>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
@@ -283,7 +305,31 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_dsp_factory_aux<REAL, 6>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
+                getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
+                getInterpreterVisitor<REAL>()->getFieldOffset("count"),
+                getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
+                metadata_block, getInterpreterVisitor<REAL>()->fUserInterfaceBlock,
+                init_static_block, init_block, resetui_block, clear_block, compute_control_block,
+                compute_dsp_block);
+
+        case 7:
+            return new interpreter_dsp_factory_aux<REAL, 7>(
+                name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
+                getInterpreterVisitor<REAL>()->fIntHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
+                getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
+                getInterpreterVisitor<REAL>()->getFieldOffset("count"),
+                getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
+                metadata_block, getInterpreterVisitor<REAL>()->fUserInterfaceBlock,
+                init_static_block, init_block, resetui_block, clear_block, compute_control_block,
+                compute_dsp_block);
+
+        case TRACE_PROFILE:
+            return new interpreter_dsp_factory_aux<REAL, TRACE_PROFILE>(
+                name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
+                getInterpreterVisitor<REAL>()->fIntHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
@@ -296,7 +342,7 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_dsp_factory_aux<REAL, 0>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
@@ -309,7 +355,7 @@ dsp_factory_base* InterpreterCodeContainer<REAL>::produceFactory()
             return new interpreter_comp_dsp_factory_aux<REAL, 0>(
                 name, compile_options.str(), "", INTERP_FILE_VERSION, fNumInputs, fNumOutputs,
                 getInterpreterVisitor<REAL>()->fIntHeapOffset,
-                getInterpreterVisitor<REAL>()->fRealHeapOffset,
+                getInterpreterVisitor<REAL>()->fRealHeapOffset, int_class_size, real_class_size,
                 getInterpreterVisitor<REAL>()->getFieldOffset("fSampleRate"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("count"),
                 getInterpreterVisitor<REAL>()->getFieldOffset("IOTA"), INTER_MAX_OPT_LEVEL,
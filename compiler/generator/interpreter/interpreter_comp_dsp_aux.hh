@@ -30,22 +30,24 @@
 template <class REAL, int TRACE>
 struct interpreter_comp_dsp_factory_aux : public interpreter_dsp_factory_aux<REAL, TRACE> {
     // Shared between all DSP instances
-    typename FBCCompiler<REAL>::CompiledBlocksType* fCompiledBlocks;
+    FBCCompiledBlocks<REAL>* fCompiledBlocks;
 
     interpreter_comp_dsp_factory_aux(
         const std::string& name, const std::string& compile_options, const std::string& sha_key,
         int version_num, int inputs, int outputs, int int_heap_size, int real_heap_size,
-        int sr_offset, int count_offset, int iota_offset, int opt_level,
+        int int_class_size, int real_class_size, int sr_offset, int count_offset, int iota_offset,
+        int opt_level,
         FIRMetaBlockInstruction* meta, FIRUserInterfaceBlockInstruction<REAL>* firinterface,
         FBCBlockInstruction<REAL>* static_init, FBCBlockInstruction<REAL>* init,
         FBCBlockInstruction<REAL>* resetui, FBCBlockInstruction<REAL>* clear,
         FBCBlockInstruction<REAL>* compute_control, FBCBlockInstruction<REAL>* compute_dsp)
         : interpreter_dsp_factory_aux<REAL, TRACE>(
               name, compile_options, sha_key, version_num, inputs, outputs, int_heap_size,
-              real_heap_size, sr_offset, count_offset, iota_offset, opt_level, meta, firinterface,
-              static_init, init, resetui, clear, compute_control, compute_dsp)
+              real_heap_size, int_class_size, real_class_size, sr_offset, count_offset,
+              iota_offset, opt_level, meta, firinterface, static_init, init, resetui, clear,
+              compute_control, compute_dsp)
     {
-        fCompiledBlocks = new std::map<FBCBlockInstruction<REAL>*, FBCExecuteFun<REAL>*>();
+        fCompiledBlocks = new FBCCompiledBlocks<REAL>();
     }
 
     virtual FBCExecutor<REAL>* createFBCExecutor()
@@ -53,13 +55,7 @@ struct interpreter_comp_dsp_factory_aux : public interpreter_dsp_factory_aux<REA
         return new FBCCompiler<REAL>(this, fCompiledBlocks);
     }
 
-    virtual ~interpreter_comp_dsp_factory_aux()
-    {
-        for (auto& it : *fCompiledBlocks) {
-            delete it.second;
-        }
-        delete fCompiledBlocks;
-    }
+    virtual ~interpreter_comp_dsp_factory_aux() { delete fCompiledBlocks; }
 };
 
 // Interpreter instance using a LLVM or MIR compiler for the 'compute' method
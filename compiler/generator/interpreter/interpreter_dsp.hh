@@ -114,7 +114,8 @@ interpreter_dsp_factory_aux<REAL, TRACE>* interpreter_dsp_factory_aux<REAL, TRAC
 
     // Read int/real heap size and sr offset
     std::string heap_size;
-    int         int_heap_size, real_heap_size, sr_offset, count_offset, iota_offset;
+    int int_heap_size, real_heap_size, int_class_size, real_class_size, sr_offset, count_offset,
+        iota_offset;
     getline(*in, heap_size);
 
     std::stringstream heap_size_reader(heap_size);
@@ -127,6 +128,14 @@ interpreter_dsp_factory_aux<REAL, TRACE>* interpreter_dsp_factory_aux<REAL, TRAC
     checkToken(dummy, "real_heap_size");
     heap_size_reader >> real_heap_size;
 
+    heap_size_reader >> dummy;  // Read "int_class_size" token
+    checkToken(dummy, "int_class_size");
+    heap_size_reader >> int_class_size;
+
+    heap_size_reader >> dummy;  // Read "real_class_size" token
+    checkToken(dummy, "real_class_size");
+    heap_size_reader >> real_class_size;
+
     heap_size_reader >> dummy;  // Read "sr_offet" token
     checkToken(dummy, "sr_offset");
     heap_size_reader >> sr_offset;
@@ -173,26 +182,77 @@ interpreter_dsp_factory_aux<REAL, TRACE>* interpreter_dsp_factory_aux<REAL, TRAC
 #if defined(MACHINE) || defined(INTERP_COMP_BUILD)
     return new interpreter_comp_dsp_factory_aux<REAL, TRACE>(
         factory_name, compile_options, sha_key, file_num, inputs, outputs, int_heap_size,
-        real_heap_size, sr_offset, count_offset, iota_offset, opt_level, meta_block, ui_block,
-        static_init_block, init_block, resetui_block, clear_block, compute_control_block,
-        compute_dsp_block);
+        real_heap_size, int_class_size, real_class_size, sr_offset, count_offset, iota_offset,
+        opt_level, meta_block, ui_block, static_init_block, init_block, resetui_block, clear_block,
+        compute_control_block, compute_dsp_block);
 #else
     return new interpreter_dsp_factory_aux<REAL, TRACE>(
         factory_name, compile_options, sha_key, file_num, inputs, outputs, int_heap_size,
-        real_heap_size, sr_offset, count_offset, iota_offset, opt_level, meta_block, ui_block,
-        static_init_block, init_block, resetui_block, clear_block, compute_control_block,
-        compute_dsp_block);
+        real_heap_size, int_class_size, real_class_size, sr_offset, count_offset, iota_offset,
+        opt_level, meta_block, ui_block, static_init_block, init_block, resetui_block, clear_block,
+        compute_control_block, compute_dsp_block);
+#endif
+}
+
+// Binary container reader
+template <class REAL, int TRACE>
+interpreter_dsp_factory_aux<REAL, TRACE>* interpreter_dsp_factory_aux<REAL, TRACE>::readBinary(
+    const char* data, size_t size)
+{
+    FBCBinaryReader<REAL> reader(data, size);
+    reader.validate();
+
+    const FBCBinaryHeader& header = reader.fHeader;
+
+    FIRMetaBlockInstruction*                meta_block = reader.readMetaBlock();
+    FIRUserInterfaceBlockInstruction<REAL>* ui_block   = reader.readUIBlock();
+
+    FBCBlockInstruction<REAL>* static_init_block     = reader.readCodeBlock(header.fCodeBlocks[0]);
+    FBCBlockInstruction<REAL>* init_block            = reader.readCodeBlock(header.fCodeBlocks[1]);
+    FBCBlockInstruction<REAL>* resetui_block         = reader.readCodeBlock(header.fCodeBlocks[2]);
+    FBCBlockInstruction<REAL>* clear_block           = reader.readCodeBlock(header.fCodeBlocks[3]);
+    FBCBlockInstruction<REAL>* compute_control_block = reader.readCodeBlock(header.fCodeBlocks[4]);
+    FBCBlockInstruction<REAL>* compute_dsp_block     = reader.readCodeBlock(header.fCodeBlocks[5]);
+#if defined(MACHINE) || defined(INTERP_COMP_BUILD)
+    return new interpreter_comp_dsp_factory_aux<REAL, TRACE>(
+        reader.getString(header.fName), reader.getString(header.fCompileOptions),
+        reader.getString(header.fSHAKey), header.fFileVersion, header.fNumInputs,
+        header.fNumOutputs, header.fIntHeapSize, header.fRealHeapSize, header.fIntClassSize,
+        header.fRealClassSize, header.fSROffset, header.fCountOffset, header.fIOTAOffset,
+        header.fOptLevel, meta_block, ui_block, static_init_block, init_block, resetui_block,
+        clear_block, compute_control_block, compute_dsp_block);
+#else
+    return new interpreter_dsp_factory_aux<REAL, TRACE>(
+        reader.getString(header.fName), reader.getString(header.fCompileOptions),
+        reader.getString(header.fSHAKey), header.fFileVersion, header.fNumInputs,
+        header.fNumOutputs, header.fIntHeapSize, header.fRealHeapSize, header.fIntClassSize,
+        header.fRealClassSize, header.fSROffset, header.fCountOffset, header.fIOTAOffset,
+        header.fOptLevel, meta_block, ui_block, static_init_block, init_block, resetui_block,
+        clear_block, compute_control_block, compute_dsp_block);
 #endif
 }
 
 template <class REAL, int TRACE>
 void interpreter_dsp_factory_aux<REAL, TRACE>::optimize()
 {
+    // Instances can be created concurrently
+    std::lock_guard<std::mutex> lock(fCodeMutex);
     if (!fOptimized) {
         fOptimized = true;
         // Bytecode optimization
-        if (TRACE == 0) {
+        if (TRACE == 0 || TRACE == TRACE_PROFILE) {
 #ifndef MACHINE
+            // The names are only kept by the blocks produced by the visitor
+            if (TRACE == TRACE_PROFILE) {
+                fProfileNames.analyse(fUserInterfaceBlock);
+                fProfileNames.analyse(fStaticInitBlock);
+                fProfileNames.analyse(fInitBlock);
+                fProfileNames.analyse(fResetUIBlock);
+                fProfileNames.analyse(fClearBlock);
+                fProfileNames.analyse(fComputeBlock);
+                fProfileNames.analyse(fComputeDSPBlock);
+            }
+
             fStaticInitBlock =
                 FBCInstructionOptimizer<REAL>::optimizeBlock(fStaticInitBlock, 1, fOptLevel);
             fInitBlock = FBCInstructionOptimizer<REAL>::optimizeBlock(fInitBlock, 1, fOptLevel);
@@ -203,8 +263,23 @@ void interpreter_dsp_factory_aux<REAL, TRACE>::optimize()
                 FBCInstructionOptimizer<REAL>::optimizeBlock(fComputeBlock, 1, fOptLevel);
             fComputeDSPBlock =
                 FBCInstructionOptimizer<REAL>::optimizeBlock(fComputeDSPBlock, 1, fOptLevel);
+
+            // The class segment can be shared when the optimized blocks only read its arrays
+            fClassShared = (fIntClassSize > 0 || fRealClassSize > 0) &&
+                           isClassReadOnly(fInitBlock) && isClassReadOnly(fResetUIBlock) &&
+                           isClassReadOnly(fClearBlock) && isClassReadOnly(fComputeBlock) &&
+                           isClassReadOnly(fComputeDSPBlock);
+
 #endif
         }
+
+        // The blocks are final, so their flat versions can be shared by the executors
+        getFlatBlock(fStaticInitBlock);
+        getFlatBlock(fInitBlock);
+        getFlatBlock(fResetUIBlock);
+        getFlatBlock(fClearBlock);
+        getFlatBlock(fComputeBlock);
+        getFlatBlock(fComputeDSPBlock);
     }
 }
 
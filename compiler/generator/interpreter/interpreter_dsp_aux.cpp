@@ -131,6 +131,39 @@ static string read_real_type(istream* in)
     return type;
 }
 
+static dsp_factory_base* readInterpreterDSPFactoryBinary(const string& bitcode)
+{
+    FBCBinaryHeader header;
+    memcpy(&header, bitcode.data(), sizeof(FBCBinaryHeader));
+
+    if (header.fRealSize == sizeof(float)) {
+        return interpreter_dsp_factory_aux<float, 0>::readBinary(bitcode.data(), bitcode.size());
+    } else if (header.fRealSize == sizeof(double)) {
+        return interpreter_dsp_factory_aux<double, 0>::readBinary(bitcode.data(), bitcode.size());
+    } else {
+        throw faustexception("ERROR : unrecognized binary file format\n");
+    }
+}
+
+dsp_factory_base* readInterpreterDSPFactoryBase(const string& bitcode)
+{
+    // Binary container or textual format
+    if (isFBCBinary(bitcode.data(), bitcode.size())) {
+        return readInterpreterDSPFactoryBinary(bitcode);
+    }
+
+    stringstream reader(bitcode);
+    string       type = read_real_type(&reader);
+
+    if (type == "float") {
+        return interpreter_dsp_factory_aux<float, 0>::read(&reader);
+    } else if (type == "double") {
+        return interpreter_dsp_factory_aux<double, 0>::read(&reader);
+    } else {
+        throw faustexception("ERROR : unrecognized file format\n");
+    }
+}
+
 static interpreter_dsp_factory* readInterpreterDSPFactoryFromBitcodeAux(const string& bitcode,
                                                                         string&       error_msg)
 {
@@ -144,20 +177,8 @@ static interpreter_dsp_factory* readInterpreterDSPFactoryFromBitcodeAux(const st
             sfactory->addReference();
             return sfactory;
         } else {
-            interpreter_dsp_factory* factory = nullptr;
-            stringstream             reader(bitcode);
-            string                   type = read_real_type(&reader);
-
-            if (type == "float") {
-                factory = new interpreter_dsp_factory(
-                    interpreter_dsp_factory_aux<float, 0>::read(&reader));
-            } else if (type == "double") {
-                factory = new interpreter_dsp_factory(
-                    interpreter_dsp_factory_aux<double, 0>::read(&reader));
-            } else {
-                throw faustexception("ERROR : unrecognized file format\n");
-            }
-
+            interpreter_dsp_factory* factory =
+                new interpreter_dsp_factory(readInterpreterDSPFactoryBase(bitcode));
             gInterpreterFactoryTable.setFactory(factory);
             factory->setSHAKey(sha_key);
             factory->setDSPCode(bitcode);
@@ -192,9 +213,13 @@ LIBFAUST_API interpreter_dsp_factory* readInterpreterDSPFactoryFromBitcodeFile(
     size_t pos  = bitcode_path.find(".fbc");
 
     if (pos != string::npos) {
-        ifstream reader(bitcode_path.c_str());
+        // Binary mode, the file may be a binary container
+        ifstream reader(bitcode_path.c_str(), ios::binary);
         if (reader.is_open()) {
-            string bitcode(istreambuf_iterator<char>(reader), {});
+            reader.seekg(0, ios::end);
+            string bitcode(size_t(reader.tellg()), '\0');
+            reader.seekg(0, ios::beg);
+            reader.read(&bitcode[0], bitcode.size());
             return readInterpreterDSPFactoryFromBitcodeAux(bitcode, error_msg);
         } else {
             error_msg = "ERROR opening file '" + bitcode_path + "'\n";
@@ -219,6 +244,26 @@ LIBFAUST_API bool writeInterpreterDSPFactoryToBitcodeFile(interpreter_dsp_factor
     }
 }
 
+LIBFAUST_API string writeInterpreterDSPFactoryToBinary(interpreter_dsp_factory* factory)
+{
+    LOCK_API
+    return factory->getBinaryCode();
+}
+
+LIBFAUST_API bool writeInterpreterDSPFactoryToBinaryFile(interpreter_dsp_factory* factory,
+                                                         const string&            binary_path)
+{
+    LOCK_API
+    ofstream writer(binary_path.c_str(), ios::binary);
+    if (writer.is_open()) {
+        string code = factory->getBinaryCode();
+        writer.write(code.data(), code.size());
+        return true;
+    } else {
+        return false;
+    }
+}
+
 LIBFAUST_API void interpreter_dsp::metadata(Meta* meta)
 {
     fDSP->metadata(meta);
@@ -374,6 +419,12 @@ LIBFAUST_API bool writeCInterpreterDSPFactoryToBitcodeFile(interpreter_dsp_facto
     return (factory) ? writeInterpreterDSPFactoryToBitcodeFile(factory, bitcode_path) : false;
 }
 
+LIBFAUST_API bool writeCInterpreterDSPFactoryToBinaryFile(interpreter_dsp_factory* factory,
+                                                          const char*              binary_path)
+{
+    return (factory) ? writeInterpreterDSPFactoryToBinaryFile(factory, binary_path) : false;
+}
+
 LIBFAUST_API void deleteAllCInterpreterDSPFactories()
 {
     deleteAllInterpreterDSPFactories();
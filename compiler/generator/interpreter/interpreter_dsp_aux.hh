@@ -27,6 +27,8 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -34,7 +36,10 @@
 
 #include "dsp_aux.hh"
 #include "dsp_factory.hh"
+#include "fbc_binary.hh"
 #include "fbc_interpreter.hh"
+#include "fbc_register_interpreter.hh"
+#include "fbc_vec_interpreter.hh"
 #include "interpreter_bytecode.hh"
 
 static inline void checkToken(const std::string& token, const std::string& expected)
@@ -73,6 +78,8 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
 
     int fIntHeapSize;
     int fRealHeapSize;
+    int fIntClassSize;
+    int fRealClassSize;
     int fSROffset;
     int fCountOffset;
     int fIOTAOffset;
@@ -90,10 +97,36 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
     FBCBlockInstruction<REAL>*              fComputeBlock;
     FBCBlockInstruction<REAL>*              fComputeDSPBlock;
 
+    // Guards optimize and the code built once and shared by the executors of the instances
+    std::mutex fCodeMutex;
+
+    // Shared by the instances using the register based executor
+    FBCRegisterCode<REAL>* fRegisterCode;
+
+    // Shared by the instances using the vector executor
+    FBCVecCode<REAL>* fVecCode;
+
+    /*
+     Class segment : the static tables are allocated in the first fIntClassSize/fRealClassSize cells
+     of the heaps. They are computed once per sample rate, in the heaps of an executor kept in
+     fClassExecutors and never modified afterwards. When the other blocks only access them with
+     indexed loads (fClassShared), the executors reading the heaps from the flat blocks use the
+     segment of their sample rate read-only and do not allocate it, the other executors copy it in
+     their heaps.
+    */
+    bool                                        fClassShared;
+    std::map<int, FBCInterpreter<REAL, TRACE>*> fClassExecutors;  // Table : sample rate, executor
+    FBCInterpreter<REAL, TRACE>*                fClassExecutor;   // Last initialized segment
+    std::mutex                                  fClassMutex;
+
+    // Field and control names reported in profile mode
+    FBCProfileNames<REAL> fProfileNames;
+
     interpreter_dsp_factory_aux(
         const std::string& name, const std::string& compile_options, const std::string& sha_key,
         int version_num, int inputs, int outputs, int int_heap_size, int real_heap_size,
-        int sr_offset, int count_offset, int iota_offset, int opt_level,
+        int int_class_size, int real_class_size, int sr_offset, int count_offset, int iota_offset,
+        int opt_level,
         FIRMetaBlockInstruction* meta, FIRUserInterfaceBlockInstruction<REAL>* firinterface,
         FBCBlockInstruction<REAL>* static_init, FBCBlockInstruction<REAL>* init,
         FBCBlockInstruction<REAL>* resetui, FBCBlockInstruction<REAL>* clear,
@@ -104,6 +137,8 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
           fNumOutputs(outputs),
           fIntHeapSize(int_heap_size),
           fRealHeapSize(real_heap_size),
+          fIntClassSize(int_class_size),
+          fRealClassSize(real_class_size),
           fSROffset(sr_offset),
           fCountOffset(count_offset),
           fIOTAOffset(iota_offset),
@@ -116,23 +151,146 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
           fResetUIBlock(resetui),
           fClearBlock(clear),
           fComputeBlock(compute_control),
-          fComputeDSPBlock(compute_dsp)
+          fComputeDSPBlock(compute_dsp),
+          fRegisterCode(nullptr),
+          fVecCode(nullptr),
+          fClassShared(false),
+          fClassExecutor(nullptr)
     {
-        // Hack to display the LLVM or MIR used compiler
+        // Hack to display the LLVM, MIR or template used compiler
 #if INTERP_MIR_BUILD
         fCompileOptions = replace_first(compile_options, "interp", "interp-mir");
 #elif INTERP_LLVM_BUILD
         fCompileOptions = replace_first(compile_options, "interp", "interp-llvm");
+#elif INTERP_TEMPLATE_BUILD
+        fCompileOptions = replace_first(compile_options, "interp", "interp-template");
 #else
         fCompileOptions = compile_options;
 #endif
     }
 
-    virtual FBCExecutor<REAL>* createFBCExecutor() { return new FBCInterpreter<REAL, TRACE>(this); }
+    virtual FBCExecutor<REAL>* createFBCExecutor()
+    {
+        // Register based executor, not used in trace mode or with a custom memory manager
+        if (TRACE == 0 && !getMemoryManager() && getenv("FAUST_INTERP_REGISTER")) {
+            return new FBCRegisterInterpreter<REAL, TRACE>(this);
+        }
+        // Vector executor for the loops of the vector mode, with the same restrictions
+        FBCExecutor<REAL>* executor =
+            (!getMemoryManager()) ? FBCVecInterpreterBuilder<REAL, TRACE>::create(this) : nullptr;
+        return (executor) ? executor : new FBCInterpreter<REAL, TRACE>(this, 0, 0, true);
+    }
+
+    // Flat blocks are built once by optimize and shared by all instances of the factory (with
+    // superinstructions when not in trace or profile mode)
+    FBCFlatBlock<REAL>* getFlatBlock(FBCBlockInstruction<REAL>* block)
+    {
+        return (fClassShared) ? block->getFlatBlock(TRACE == 0, fIntClassSize, fRealClassSize)
+                              : block->getFlatBlock(TRACE == 0);
+    }
+
+    // Segment of the last initialized sample rate (or nullptr), given to the new instances
+    FBCInterpreter<REAL, TRACE>* getClassExecutor()
+    {
+        std::lock_guard<std::mutex> lock(fClassMutex);
+        return fClassExecutor;
+    }
+
+    /*
+     Execute the static init block in a new class segment, when not already done for 'sample_rate'.
+     The segment is copied in 'int_heap' and 'real_heap' when given.
+    */
+    FBCInterpreter<REAL, TRACE>* initClassSegment(int sample_rate, int* int_heap = nullptr,
+                                                  REAL* real_heap = nullptr)
+    {
+        std::lock_guard<std::mutex> lock(fClassMutex);
+        auto                        it = fClassExecutors.find(sample_rate);
+        if (it == fClassExecutors.end()) {
+            FBCInterpreter<REAL, TRACE>* class_executor = new FBCInterpreter<REAL, TRACE>(this);
+            FBCExecutor<REAL>*           executor       = class_executor;
+            executor->setIntValue(fSROffset, sample_rate);
+            executor->executeBlock(fStaticInitBlock);
+            it = fClassExecutors.insert(std::make_pair(sample_rate, class_executor)).first;
+        }
+        fClassExecutor = it->second;
+        if (int_heap) {
+            fClassExecutor->copyClassSegment(int_heap, real_heap);
+        }
+        return fClassExecutor;
+    }
+
+    // Returns true if the cells of the class segment are only accessed by indexed loads in 'block'
+    bool isClassReadOnly(FBCBlockInstruction<REAL>* block)
+    {
+        typedef FBCInstruction I;
+
+        if (!block) {
+            return true;
+        }
+        for (const auto& it : block->fInstructions) {
+            I::Opcode op    = it->fOpcode;
+            int       cells = 0;  // heap cells in fOffset1 and fOffset2
+            bool      real  = false;
+            I::Opcode base;
+            int       left, right;
+            switch (op) {
+                case I::kLoadReal:
+                case I::kStoreReal:
+                case I::kStoreRealValue:
+                case I::kStoreIndexedReal:
+                case I::kBlockStoreReal:
+                case I::kCastIntHeap:
+                    cells = 1;
+                    real  = true;
+                    break;
+                case I::kLoadInt:
+                case I::kStoreInt:
+                case I::kStoreIntValue:
+                case I::kStoreIndexedInt:
+                case I::kBlockStoreInt:
+                case I::kCastRealHeap:
+                    cells = 1;
+                    break;
+                case I::kMoveReal:
+                case I::kPairMoveReal:
+                case I::kBlockPairMoveReal:
+                case I::kBlockShiftReal:
+                    cells = 2;
+                    real  = true;
+                    break;
+                case I::kMoveInt:
+                case I::kPairMoveInt:
+                case I::kBlockPairMoveInt:
+                case I::kBlockShiftInt:
+                    cells = 2;
+                    break;
+                default:
+                    if (FBCRegisterCompiler<REAL>::decodeMath(op, base, left, right)) {
+                        cells = (left == 1) + (right == 1);
+                        real  = FBCRegisterCompiler<REAL>::isRealOperand(base);
+                    }
+                    break;
+            }
+            int class_size = (real) ? fRealClassSize : fIntClassSize;
+            if ((cells > 0 && it->fOffset1 < class_size) ||
+                (cells > 1 && it->fOffset2 < class_size)) {
+                return false;
+            }
+            // kCondBranch branches back to its own block
+            if (op != I::kCondBranch &&
+                (!isClassReadOnly(it->fBranch1) || !isClassReadOnly(it->fBranch2))) {
+                return false;
+            }
+        }
+        return true;
+    }
 
     virtual ~interpreter_dsp_factory_aux()
     {
         // No more DSP instances, so delete
+        for (const auto& it : fClassExecutors) {
+            delete it.second;
+        }
         delete fMetaBlock;
         delete fUserInterfaceBlock;
         delete fStaticInitBlock;
@@ -141,6 +299,8 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
         delete fClearBlock;
         delete fComputeBlock;
         delete fComputeDSPBlock;
+        delete fRegisterCode;
+        delete fVecCode;
     }
 
     void optimize();  // moved in interpreted_dsp.hh
@@ -158,8 +318,9 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
             *out << "o " << fOptLevel << std::endl;
             *out << "i " << fNumInputs << " o " << fNumOutputs << std::endl;
 
-            *out << "i " << fIntHeapSize << " r " << fRealHeapSize << " s " << fSROffset << " c "
-                 << fCountOffset << " i " << fIOTAOffset << std::endl;
+            *out << "i " << fIntHeapSize << " r " << fRealHeapSize << " i " << fIntClassSize << " r "
+                 << fRealClassSize << " s " << fSROffset << " c " << fCountOffset << " i "
+                 << fIOTAOffset << std::endl;
 
             *out << "m" << std::endl;
             fMetaBlock->write(out, small);
@@ -197,6 +358,7 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
             *out << "inputs " << fNumInputs << " outputs " << fNumOutputs << std::endl;
 
             *out << "int_heap_size " << fIntHeapSize << " real_heap_size " << fRealHeapSize
+                 << " int_class_size " << fIntClassSize << " real_class_size " << fRealClassSize
                  << " sr_offset " << fSROffset << " count_offset " << fCountOffset
                  << " iota_offset " << fIOTAOffset << std::endl;
 
@@ -228,9 +390,46 @@ struct interpreter_dsp_factory_aux : public dsp_factory_imp {
 
     std::string getCompileOptions() { return fCompileOptions; };
 
+    // Binary container (see fbc_binary.hh)
+    std::string getBinaryCode()
+    {
+        FBCBinaryWriter<REAL> writer;
+        FBCBinaryHeader       header;
+        memset(&header, 0, sizeof(FBCBinaryHeader));
+
+        header.fFileVersion    = INTERP_FILE_VERSION;
+        header.fName           = writer.addString(fName);
+        header.fSHAKey         = writer.addString(fSHAKey);
+        header.fCompileOptions = writer.addString(fCompileOptions);
+        header.fOptLevel       = fOptLevel;
+        header.fNumInputs      = fNumInputs;
+        header.fNumOutputs     = fNumOutputs;
+        header.fIntHeapSize    = fIntHeapSize;
+        header.fRealHeapSize   = fRealHeapSize;
+        header.fIntClassSize   = fIntClassSize;
+        header.fRealClassSize  = fRealClassSize;
+        header.fSROffset       = fSROffset;
+        header.fCountOffset    = fCountOffset;
+        header.fIOTAOffset     = fIOTAOffset;
+
+        writer.addMeta(fMetaBlock);
+        writer.addUI(fUserInterfaceBlock);
+        header.fCodeBlocks[0] = writer.addBlock(fStaticInitBlock);
+        header.fCodeBlocks[1] = writer.addBlock(fInitBlock);
+        header.fCodeBlocks[2] = writer.addBlock(fResetUIBlock);
+        header.fCodeBlocks[3] = writer.addBlock(fClearBlock);
+        header.fCodeBlocks[4] = writer.addBlock(fComputeBlock);
+        header.fCodeBlocks[5] = writer.addBlock(fComputeDSPBlock);
+
+        return writer.write(header);
+    }
+
     // Factory reader
     static interpreter_dsp_factory_aux<REAL, TRACE>* read(std::istream* in);
 
+    // Binary container reader
+    static interpreter_dsp_factory_aux<REAL, TRACE>* readBinary(const char* data, size_t size);
+
     static std::string parseStringToken(std::stringstream* inst)
     {
         std::string token;
@@ -591,8 +790,8 @@ class interpreter_dsp_aux : public interpreter_dsp_base {
         }
 
         try {
-            // Execute static init instructions
-            fFBCExecutor->executeBlock(fFactory->fStaticInitBlock);
+            // Setup the class segment, computed by the factory
+            fFBCExecutor->classInit(sample_rate);
         } catch (faustexception& e) {
             std::cerr << e.Message();
             exit(1);
@@ -657,8 +856,8 @@ class interpreter_dsp_aux : public interpreter_dsp_base {
             std::cout << "instanceInit " << sample_rate << std::endl;
         }
 
-        // classInit has to be called for each instance since the tables are actually not shared
-        // between instances
+        // The class segment is only computed once per sample rate by the factory, classInit then
+        // just gives it to the instance
         classInit(sample_rate);
 
         instanceConstants(sample_rate);
@@ -675,11 +874,11 @@ class interpreter_dsp_aux : public interpreter_dsp_base {
 
         fInitialized = true;
 
-        // Possibly compile (when using LLVM or MIR)
+        // Possibly compile (when using LLVM or MIR, in a worker thread in tiered mode)
         // fFBCExecutor->compileBlock(fFactory->fComputeBlock);
         fFBCExecutor->compileBlock(fFactory->fComputeDSPBlock);
 
-        // classInit is not called here since the tables are actually not shared between instances
+        // classInit is called by instanceInit
         instanceInit(sample_rate);
     }
 
@@ -693,32 +892,6 @@ class interpreter_dsp_aux : public interpreter_dsp_base {
         }
     }
 
-    void ExecuteVecBlock(FBCBlockInstruction<REAL>* block, int vec_size)
-    {
-        /*
-            Execute the VEC size specialized version of the interpreter
-            vec_size == 1 correspond to the scalar interpreter
-        */
-
-        /*
-        if (vec_size == 1) {
-            fFBCExecutor->executeBlock<REAL, 1, TRACE>(block);
-        } else if (vec_size == 4) {
-            fFBCExecutor->executeBlock<REAL, 4, TRACE>(block);
-        } else if (vec_size == 8) {
-            fFBCExecutor->executeBlock<REAL, 8, TRACE>(block);
-        } else if (vec_size == 16) {
-            fFBCExecutor->executeBlock<REAL, 16, TRACE>(block);
-        } else if (vec_size == 32) {
-            fFBCExecutor->executeBlock<REAL, 32, TRACE>(block);
-        } else if (vec_size == 64) {
-            fFBCExecutor->executeBlock<REAL, 64, TRACE>(block);
-        } else {
-            fFBCExecutor->executeBlock<REAL, 128, TRACE>(block);
-        }
-        */
-    }
-
     virtual void compute(int count, FAUSTFLOAT** inputs_aux, FAUSTFLOAT** outputs_aux)
     {
         if (count == 0) {
@@ -878,6 +1051,14 @@ class LIBFAUST_API interpreter_dsp : public dsp {
         : fFactory(factory), fDSP(dsp)
     {
     }
+    interpreter_dsp(interpreter_dsp_factory* factory, interpreter_dsp_aux<float, 8>* dsp)
+        : fFactory(factory), fDSP(dsp)
+    {
+    }
+    interpreter_dsp(interpreter_dsp_factory* factory, interpreter_dsp_aux<double, 8>* dsp)
+        : fFactory(factory), fDSP(dsp)
+    {
+    }
 
     virtual ~interpreter_dsp();
 
@@ -931,6 +1112,8 @@ class LIBFAUST_API interpreter_dsp_factory : public dsp_factory, public faust_sm
 
     std::string getCompileOptions() { return fFactory->getCompileOptions(); }
 
+    std::string getBinaryCode() { return fFactory->getBinaryCode(); }
+
     std::vector<std::string> getWarningMessages() { return fFactory->getWarningMessages(); }
 
     interpreter_dsp* createDSPInstance();
@@ -960,6 +1143,9 @@ LIBFAUST_API std::vector<std::string> getInterpreterDSPFactoryLibraryList(
 
 LIBFAUST_API std::vector<std::string> getAllInterpreterDSPFactories();
 
+// Deserialize the factory internal part, without registering it (may throw faustexception)
+dsp_factory_base* readInterpreterDSPFactoryBase(const std::string& bitcode);
+
 LIBFAUST_API interpreter_dsp_factory* readInterpreterDSPFactoryFromBitcode(
     const std::string& bitcode, std::string& error_msg);
 
@@ -971,6 +1157,11 @@ LIBFAUST_API interpreter_dsp_factory* readInterpreterDSPFactoryFromBitcodeFile(
 LIBFAUST_API bool writeInterpreterDSPFactoryToBitcodeFile(interpreter_dsp_factory* factory,
                                                           const std::string&       bitcode_path);
 
+LIBFAUST_API std::string writeInterpreterDSPFactoryToBinary(interpreter_dsp_factory* factory);
+
+LIBFAUST_API bool writeInterpreterDSPFactoryToBinaryFile(interpreter_dsp_factory* factory,
+                                                         const std::string&       binary_path);
+
 LIBFAUST_API void deleteAllInterpreterDSPFactories();
 
 #ifdef __cplusplus
@@ -998,6 +1189,9 @@ LIBFAUST_API interpreter_dsp_factory* readCInterpreterDSPFactoryFromBitcodeFile(
 LIBFAUST_API bool writeCInterpreterDSPFactoryToBitcodeFile(interpreter_dsp_factory* factory,
                                                            const char*              bitcode_path);
 
+LIBFAUST_API bool writeCInterpreterDSPFactoryToBinaryFile(interpreter_dsp_factory* factory,
+                                                          const char*              binary_path);
+
 LIBFAUST_API void deleteAllCInterpreterDSPFactories();
 
 #ifdef __cplusplus
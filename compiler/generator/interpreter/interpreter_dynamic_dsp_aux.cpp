@@ -25,7 +25,10 @@
 #include <libgen.h>
 #endif  // defined(_WIN32)
 
+#include <sstream>
+
 #include "Text.hh"
+#include "dsp_cache.hh"
 #include "interpreter_dynamic_dsp_aux.hh"
 #include "libfaust.h"
 #include "lock_api.hh"
@@ -53,19 +56,36 @@ LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromString(
     const string& name_app, const string& dsp_content, int argc, const char* argv[],
     string& error_msg)
 {
-    LOCK_API
     string expanded_dsp_content, sha_key;
 
     if ((expanded_dsp_content = sha1FromDSP(name_app, dsp_content, argc, argv, sha_key)) == "") {
         return nullptr;
     } else {
         dsp_factory_table<SDsp_factory>::factory_iterator it;
-        if (gInterpreterFactoryTable.getFactory(sha_key, it)) {
-            SDsp_factory sfactory = (*it).first;
-            sfactory->addReference();
-            return sfactory;
-        } else {
-            try {
+        {
+            LOCK_API
+            if (gInterpreterFactoryTable.getFactory(sha_key, it)) {
+                SDsp_factory sfactory = (*it).first;
+                sfactory->addReference();
+                return sfactory;
+            }
+        }
+        // The compilation runs in its own context, only the factory table access is locked
+        try {
+            // Possibly reuse the code compiled by a previous run, see FAUST_DSP_CACHE
+            dsp_factory_base* dsp_factory_aux = nullptr;
+            string            cache_key       = dsp_cache::makeKey(sha_key, "interp");
+            string            bitcode;
+            if (dsp_cache::read(cache_key, bitcode)) {
+                try {
+                    dsp_factory_aux = readInterpreterDSPFactoryBase(bitcode);
+                } catch (faustexception&) {
+                    // Unreadable entry: compile again and replace it
+                    dsp_factory_aux = nullptr;
+                }
+            }
+
+            if (!dsp_factory_aux) {
                 int         argc1 = 0;
                 const char* argv1[64];
                 argv1[argc1++] = "faust";
@@ -79,22 +99,37 @@ LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromString(
                 }
                 argv1[argc1] = nullptr;  // NULL terminated argv
 
-                dsp_factory_base* dsp_factory_aux =
-                    createFactory(name_app, dsp_content, argc1, argv1, error_msg, true);
-                if (dsp_factory_aux) {
-                    dsp_factory_aux->setName(name_app);
-                    interpreter_dsp_factory* factory = new interpreter_dsp_factory(dsp_factory_aux);
-                    gInterpreterFactoryTable.setFactory(factory);
-                    factory->setSHAKey(sha_key);
-                    factory->setDSPCode(expanded_dsp_content);
-                    return factory;
-                } else {
-                    return nullptr;
+                vector<string> library_files;
+                dsp_factory_aux = createFactory(name_app, dsp_content, argc1, argv1, error_msg,
+                                                true, &library_files);
+                if (dsp_factory_aux && dsp_cache::getDirectory() != "") {
+                    stringstream writer;
+                    dsp_factory_aux->write(&writer, true);
+                    dsp_cache::write(cache_key, writer.str(), library_files);
                 }
-            } catch (faustexception& e) {
-                error_msg = e.what();
+            }
+
+            if (dsp_factory_aux) {
+                LOCK_API
+                // The same DSP may have been compiled by another thread in the meantime
+                if (gInterpreterFactoryTable.getFactory(sha_key, it)) {
+                    delete dsp_factory_aux;
+                    SDsp_factory sfactory = (*it).first;
+                    sfactory->addReference();
+                    return sfactory;
+                }
+                dsp_factory_aux->setName(name_app);
+                interpreter_dsp_factory* factory = new interpreter_dsp_factory(dsp_factory_aux);
+                gInterpreterFactoryTable.setFactory(factory);
+                factory->setSHAKey(sha_key);
+                factory->setDSPCode(expanded_dsp_content);
+                return factory;
+            } else {
                 return nullptr;
             }
+        } catch (faustexception& e) {
+            error_msg = e.what();
+            return nullptr;
         }
     }
 }
@@ -102,7 +137,6 @@ LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromString(
 LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromSignals(
     const std::string& name_app, tvec signals, int argc, const char* argv[], std::string& error_msg)
 {
-    LOCK_API
     try {
         int         argc1 = 0;
         const char* argv1[64];
@@ -120,6 +154,7 @@ LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromSignals(
         dsp_factory_base* dsp_factory_aux =
             createFactory(name_app, signals, argc1, argv1, error_msg);
         if (dsp_factory_aux) {
+            LOCK_API
             dsp_factory_aux->setName(name_app);
             interpreter_dsp_factory* factory = new interpreter_dsp_factory(dsp_factory_aux);
             gInterpreterFactoryTable.setFactory(factory);
@@ -136,7 +171,6 @@ LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromSignals(
 LIBFAUST_API interpreter_dsp_factory* createInterpreterDSPFactoryFromBoxes(
     const std::string& name_app, Tree box, int argc, const char* argv[], std::string& error_msg)
 {
-    LOCK_API
     try {
         tvec signals = boxesToSignalsAux(box);
         return createInterpreterDSPFactoryFromSignals(name_app, signals, argc, argv, error_msg);
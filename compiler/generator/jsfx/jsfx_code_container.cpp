@@ -31,7 +31,7 @@
 
 using namespace std;
 
-map<string, bool> JSFXInstVisitor::gFunctionSymbolTable;
+thread_local map<string, bool> JSFXInstVisitor::gFunctionSymbolTable;
 
 dsp_factory_base* JSFXCodeContainer::produceFactory()
 {
@@ -180,7 +180,7 @@ class JSFXInstVisitor : public TextInstVisitor {
      Global functions names table as a static variable in the visitor
      so that each function prototype is generated as most once in the module.
      */
-    static std::map<std::string, bool> gFunctionSymbolTable;
+    static thread_local std::map<std::string, bool> gFunctionSymbolTable;
     // Polymorphic math functions
     std::map<std::string, std::string> gPolyMathLibTable;
 
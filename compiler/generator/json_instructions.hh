@@ -71,7 +71,7 @@ struct JSONInstVisitor : public DispatchVisitor, public JSONUIReal<REAL> {
         if (fOuputsPathSet.find(path) != fOuputsPathSet.end()) {
             std::stringstream error;
             error << "WARNING : bargraph path '" + path + "' is already used";
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
         fOuputsPathSet.insert(path);
         return path;
@@ -43,7 +43,7 @@ using namespace std;
  used to generate global functions and move global variables declaration at DSP structure level.
 */
 
-map<string, bool> JuliaInstVisitor::gFunctionSymbolTable;
+thread_local map<string, bool> JuliaInstVisitor::gFunctionSymbolTable;
 
 dsp_factory_base* JuliaCodeContainer::produceFactory()
 {
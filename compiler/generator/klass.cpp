@@ -47,9 +47,9 @@
 
 using namespace std;
 
-static int gTaskCount = 0;
+static thread_local int gTaskCount = 0;
 
-bool Klass::fNeedPowerDef = false;
+thread_local bool Klass::fNeedPowerDef = false;
 
 /**
  * Store the loop used to compute a signal
@@ -26,6 +26,7 @@
 #include "llvm_code_container.hh"
 #include "compatibility.hh"
 #include "exception.hh"
+#include "fir_simd.hh"
 #include "fir_to_fir.hh"
 #include "global.hh"
 #include "llvm_dynamic_dsp_aux.hh"
@@ -39,6 +40,10 @@ using namespace std;
 
  - several init and 'clone' methods are implemented in the 'llvm_dsp' wrapping code
  - starting with LLVM 15, the LLVMInstVisitor::fVarTypes keeps association of address and types
+ - in -vec mode, the vectorizable loops get 'llvm.loop' vectorization metadata, and can directly use
+ vector IR with the -simd <n> option (see SIMDVectorizer), with aligned audio buffers accesses when the
+ buffers are aligned at runtime (see SIMDAlignedVersion). Accesses to the audio buffers and to the
+ DSP memory are put in separated alias scopes
 
  TODO: in -mem mode, classInit and classDestroy will have to be called once at factory init and
  destroy time
@@ -322,6 +327,30 @@ LLVMVectorCodeContainer::~LLVMVectorCodeContainer()
 
 void LLVMVectorCodeContainer::generateCompute()
 {
+    // Possibly generates explicit SIMD code, then mapped on LLVM vector IR
+    if (gGlobal->gSIMDLanes > 0) {
+        SIMDVectorizer vectorizer(gGlobal->gSIMDLanes, true, true);
+        fDAGBlock = vectorizer.getCode(fDAGBlock);
+
+        // With 'vindex' multiple of the lanes number, a version with aligned accesses is used
+        // when all audio buffers are aligned on the vector size
+        if (gGlobal->gVecSize % gGlobal->gSIMDLanes == 0) {
+            Values      buffers;
+            set<string> names;
+            for (int index = 0; index < fNumInputs; index++) {
+                buffers.push_back(IB::genLoadArrayFunArgsVar("inputs", IB::genInt32NumInst(index)));
+                names.insert(subst("input$0", T(index)));
+            }
+            for (int index = 0; index < fNumOutputs; index++) {
+                buffers.push_back(
+                    IB::genLoadArrayFunArgsVar("outputs", IB::genInt32NumInst(index)));
+                names.insert(subst("output$0", T(index)));
+            }
+            SIMDAlignedVersion aligned(gGlobal->gSIMDLanes, names);
+            fDAGBlock = aligned.getCode(fDAGBlock, buffers);
+        }
+    }
+
     // Possibly generate separated functions
     generateComputeFunctions(fCodeProducer);
 
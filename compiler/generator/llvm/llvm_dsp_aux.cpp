@@ -252,9 +252,11 @@ bool llvm_dsp_factory_aux::initJIT(string& error_msg)
 
 bool llvm_dsp_factory_aux::initJITAux()
 {
-    // Run static constructors.
-    fJIT->runStaticConstructorsDestructors(false);
-    fJIT->DisableLazyCompilation(true);
+    // Run static constructors (done by the lazy JIT itself otherwise)
+    if (fJIT) {
+        fJIT->runStaticConstructorsDestructors(false);
+        fJIT->DisableLazyCompilation(true);
+    }
 
     // Possibly get -cn option
     string        JSON = llvm_dsp_factory_aux::findJSON(fModule);
@@ -471,6 +473,13 @@ void llvm_dsp::compute(int count, FAUSTFLOAT** input, FAUSTFLOAT** output)
 
 string llvm_dsp_factory_aux::writeDSPFactoryToMachineAux(const string& target)
 {
+    if (!fObjectCache) {
+        // The lazy JIT keeps no machine code, so the module is compiled again with MCJIT
+        string old_target = getTarget();
+        if (!crossCompile(old_target)) {
+            return "";
+        }
+    }
     if (target == "" || target == getTarget()) {
         return fObjectCache->getMachineCode();
     } else {
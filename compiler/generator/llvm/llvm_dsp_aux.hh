@@ -185,7 +185,7 @@ class llvm_dsp_factory_aux : public dsp_factory_imp {
     computeFun       fCompute;
     getJSONFun       fGetJSON;
 
-    uint64_t loadOptimize(const std::string& function);
+    virtual uint64_t loadOptimize(const std::string& function);
 
     void init(const std::string& dsp_name, const std::string& type_name);
 
@@ -24,21 +24,33 @@
 #endif
 
 #include <string.h>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "Text.hh"
 #include "compatibility.hh"
+#include "dsp_cache.hh"
 #include "global.hh"
 #include "libfaust.h"
 #include "llvm_dynamic_dsp_aux.hh"
 #include "lock_api.hh"
 #include "rn_base64.h"
+#include "timing.hh"
 
 #include <llvm/ExecutionEngine/MCJIT.h>
 #include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/Constants.h>
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/DiagnosticInfo.h>
 #include <llvm/IR/IRPrintingPasses.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LegacyPassNameParser.h>
@@ -188,6 +200,20 @@ bool llvm_dynamic_dsp_factory_aux::writeDSPFactoryToBitcodeFile(const string& bi
     return true;
 }
 
+// Cache: the use-list order is kept for the IR to be printed identically
+string llvm_dynamic_dsp_factory_aux::writeDSPFactoryToCache()
+{
+    string             res;
+    raw_string_ostream out(res);
+#if LLVM_VERSION_MAJOR >= 8
+    WriteBitcodeToFile(*fModule, out, true);
+#else
+    WriteBitcodeToFile(fModule, out, true);
+#endif
+    out.flush();
+    return writeDSPFactoryToMachine("") + " " + base64_encode(res);
+}
+
 // IR
 string llvm_dynamic_dsp_factory_aux::writeDSPFactoryToIR()
 {
@@ -260,45 +286,20 @@ static void AddOptimizationPasses(PassManagerBase& MPM, FUNCTION_PASS_MANAGER& F
 }
 #endif
 
-bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
-{
-    startTiming("initJIT");
-    faustassert(fModule);
-
-#ifdef LLVM_BUILD_UNIVERSAL
-    // For multiple target support
-    InitializeAllTargets();
-    InitializeAllTargetMCs();
-    InitializeAllAsmPrinters();
-    InitializeAllAsmParsers();
-#endif
-
-    // For host target support
-    InitializeNativeTarget();
-    InitializeNativeTargetAsmPrinter();
-    InitializeNativeTargetAsmParser();
-
-    // For ObjectCache to work...
-    LLVMLinkInMCJIT();
-
-    EngineBuilder builder((unique_ptr<Module>(fModule)));
-
-#if LLVM_VERSION_MAJOR >= 18
-    builder.setOptLevel(CodeGenOptLevel::Aggressive);
-#else
-    builder.setOptLevel(CodeGenOpt::Aggressive);
-#endif
-
-    builder.setEngineKind(EngineKind::JIT);
-
-    string buider_error;
-    builder.setErrorStr(&buider_error);
-
-    string triple, cpu;
-    splitTarget(fTarget, triple, cpu);
-    fModule->setTargetTriple(triple);
+/*
+ The 'llvm.loop' vectorization hints of the -vec mode are best effort: the optimization remarks
+ and failures they produce (like 'loop not vectorized') are not reported.
+*/
+struct FaustDiagnosticHandler : public DiagnosticHandler {
+    bool handleDiagnostics(const DiagnosticInfo& info) override
+    {
+        return (info.getKind() == DK_OptimizationFailure) ||
+               isa<DiagnosticInfoOptimizationBase>(info);
+    }
+};
 
-    builder.setMCPU((cpu == "") ? sys::getHostCPUName() : StringRef(cpu));
+static TargetOptions getTargetOptions()
+{
     TargetOptions targetOptions;
 
     if (!gGlobal->isOpt("FAUST_LLVM_NO_FM")) {
@@ -329,7 +330,147 @@ bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
 #endif
     }
 
-    builder.setTargetOptions(targetOptions);
+    return targetOptions;
+}
+
+// Optimize the IR of 'module' at 'opt_level', for the target machine 'tm'
+static void optimizeModule(Module* module, TargetMachine* tm, int opt_level)
+{
+#if LLVM_VERSION_MAJOR >= 17
+    // See: https://llvm.org/docs/NewPassManager.html
+
+    // Create the analysis managers.
+    LoopAnalysisManager     LAM;
+    FunctionAnalysisManager FAM;
+    CGSCCAnalysisManager    CGAM;
+    ModuleAnalysisManager   MAM;
+
+    // Create the new pass manager builder.
+    // Take a look at the PassBuilder constructor parameters for more
+    // customization, e.g. specifying a TargetMachine or various debugging
+    // options.
+    PassBuilder PB;
+
+    // Register all the basic analyses with the managers.
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    // Create the pass manager.
+    OptimizationLevel opt_table[] = {OptimizationLevel::O0, OptimizationLevel::O1,
+                                     OptimizationLevel::O2, OptimizationLevel::O3};
+    opt_level                     = std::min(opt_level, 3);
+    ModulePassManager MPM         = PB.buildPerModuleDefaultPipeline(opt_table[opt_level]);
+
+    if (global::isDebug("FAUST_LLVM1")) {
+        dumpLLVM(module);
+    }
+
+    // Optimize the IR
+    MPM.run(*module, MAM);
+    if (global::isDebug("FAUST_LLVM2")) {
+        dumpLLVM(module);
+    }
+#else
+    PASS_MANAGER          pm;
+    FUNCTION_PASS_MANAGER fpm(module);
+
+    // Code taken from opt.cpp
+    TargetLibraryInfoImpl TLII(Triple(module->getTargetTriple()));
+    pm.add(new TargetLibraryInfoWrapperPass(TLII));
+    module->setDataLayout(tm->createDataLayout());
+
+    // Add internal analysis passes from the target machine (mandatory for vectorization to
+    // work) Code taken from opt.cpp
+    pm.add(createTargetTransformInfoWrapperPass(tm->getTargetIRAnalysis()));
+
+    if (opt_level > 0) {
+        AddOptimizationPasses(pm, fpm, opt_level, 0);
+    }
+
+    if (global::isDebug("FAUST_LLVM1")) {
+        dumpLLVM(module);
+    }
+
+    fpm.doInitialization();
+    for (Module::iterator F = module->begin(), E = module->end(); F != E; ++F) {
+        fpm.run(*F);
+    }
+    fpm.doFinalization();
+    pm.add(createVerifierPass());
+
+    if (global::isDebug("FAUST_LLVM4")) {
+        // TODO
+        // tm->addPassesToEmitFile(pm, fouts(), TargetMachine::CGFT_AssemblyFile, true);
+    }
+
+    // Now that we have all of the passes ready, run them.
+    pm.run(*module);
+    if (global::isDebug("FAUST_LLVM2")) {
+        dumpLLVM(module);
+    }
+#endif
+}
+
+bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
+{
+    // The module is only kept for the writeXXX functions when its machine code is known
+    if (fObjectCache && fObjectCache->getMachineCode() != "") {
+        return llvm_dsp_factory_aux::initJIT(error_msg);
+    }
+
+    startTiming("initJIT");
+    faustassert(fModule);
+    fModule->getContext().setDiagnosticHandler(std::make_unique<FaustDiagnosticHandler>());
+
+    // Factories can be created concurrently, the targets are registered once
+    static std::once_flag gTargetsFlag;
+    std::call_once(gTargetsFlag, []() {
+#ifdef LLVM_BUILD_UNIVERSAL
+        // For multiple target support
+        InitializeAllTargets();
+        InitializeAllTargetMCs();
+        InitializeAllAsmPrinters();
+        InitializeAllAsmParsers();
+#endif
+
+        // For host target support
+        InitializeNativeTarget();
+        InitializeNativeTargetAsmPrinter();
+        InitializeNativeTargetAsmParser();
+    });
+
+#if LLVM_VERSION_MAJOR >= 13
+    // The lazy JIT is not used when machine code has to be produced (see crossCompile)
+    if (getenv("FAUST_LLVM_LAZY") && !fObjectCache && !fJIT && !fLazyJIT) {
+        return initLazyJIT(error_msg);
+    }
+#endif
+
+    // For ObjectCache to work...
+    LLVMLinkInMCJIT();
+
+    EngineBuilder builder((unique_ptr<Module>(fModule)));
+
+#if LLVM_VERSION_MAJOR >= 18
+    builder.setOptLevel(CodeGenOptLevel::Aggressive);
+#else
+    builder.setOptLevel(CodeGenOpt::Aggressive);
+#endif
+
+    builder.setEngineKind(EngineKind::JIT);
+
+    string buider_error;
+    builder.setErrorStr(&buider_error);
+
+    string triple, cpu;
+    splitTarget(fTarget, triple, cpu);
+    fModule->setTargetTriple(triple);
+
+    builder.setMCPU((cpu == "") ? sys::getHostCPUName() : StringRef(cpu));
+    builder.setTargetOptions(getTargetOptions());
     TargetMachine* tm = builder.selectTarget();
 
     fJIT = builder.create(tm);
@@ -343,86 +484,342 @@ bool llvm_dynamic_dsp_factory_aux::initJIT(string& error_msg)
 
     if ((optlevel == -1) || (fOptLevel > optlevel)) {
 #if LLVM_VERSION_MAJOR >= 17
-        // See: https://llvm.org/docs/NewPassManager.html
-
-        // Create the analysis managers.
-        LoopAnalysisManager     LAM;
-        FunctionAnalysisManager FAM;
-        CGSCCAnalysisManager    CGAM;
-        ModuleAnalysisManager   MAM;
-
-        // Create the new pass manager builder.
-        // Take a look at the PassBuilder constructor parameters for more
-        // customization, e.g. specifying a TargetMachine or various debugging
-        // options.
-        PassBuilder PB;
-
-        // Register all the basic analyses with the managers.
-        PB.registerModuleAnalyses(MAM);
-        PB.registerCGSCCAnalyses(CGAM);
-        PB.registerFunctionAnalyses(FAM);
-        PB.registerLoopAnalyses(LAM);
-        PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
-
-        // Create the pass manager.
-        OptimizationLevel opt_table[] = {OptimizationLevel::O0, OptimizationLevel::O1,
-                                         OptimizationLevel::O2, OptimizationLevel::O3};
-        fOptLevel                     = std::min(fOptLevel, 3);
-        ModulePassManager MPM         = PB.buildPerModuleDefaultPipeline(opt_table[fOptLevel]);
-
-        if (global::isDebug("FAUST_LLVM1")) {
-            dumpLLVM(fModule);
+        fOptLevel = std::min(fOptLevel, 3);
+#endif
+        optimizeModule(fModule, tm, fOptLevel);
+    }
+
+    fObjectCache = new FaustObjectCache();
+    fJIT->setObjectCache(fObjectCache);
+    return initJITAux();
+}
+
+#if LLVM_VERSION_MAJOR >= 13
+
+/*
+ Lazy compilation: the ORC JIT gets its own copy of the module (fModule being kept for the
+ writeXXX functions), in a context which is only accessed by the JIT from now on.
+*/
+
+// Per function optimization levels, see FAUST_LLVM_LAZY
+static int getFunOptLevel(const string& name, int hot_level)
+{
+    stringstream levels(getenv("FAUST_LLVM_LAZY"));
+    string       item;
+    int          level = (startWith(name, "compute")) ? hot_level : 0;
+    size_t       match = 0;
+    while (getline(levels, item, ',')) {
+        size_t pos = item.find(':');
+        if (pos == string::npos) {
+            continue;
+        }
+        string prefix = item.substr(0, pos);
+        if (prefix == "*" && match == 0) {
+            level = std::atoi(item.substr(pos + 1).c_str());
+        } else if (prefix != "*" && startWith(name, prefix) && prefix.size() > match) {
+            level = std::atoi(item.substr(pos + 1).c_str());
+            match = prefix.size();
         }
+    }
+    return level;
+}
 
-        // Optimize the IR
-        MPM.run(*fModule, MAM);
-        if (global::isDebug("FAUST_LLVM2")) {
-            dumpLLVM(fModule);
+// The requested functions are compiled with the functions they call, so that they can be inlined
+#if LLVM_VERSION_MAJOR >= 16
+static std::optional<orc::CompileOnDemandLayer::GlobalValueSet> partitionCallees(
+    orc::CompileOnDemandLayer::GlobalValueSet requested)
+#else
+static Optional<orc::CompileOnDemandLayer::GlobalValueSet> partitionCallees(
+    orc::CompileOnDemandLayer::GlobalValueSet requested)
+#endif
+{
+    vector<const Function*> todo;
+    for (const auto& it : requested) {
+        if (const Function* fun = dyn_cast<Function>(it)) {
+            todo.push_back(fun);
         }
+    }
+    while (!todo.empty()) {
+        const Function* fun = todo.back();
+        todo.pop_back();
+        for (const auto& block : *fun) {
+            for (const auto& inst : block) {
+                const CallBase* call   = dyn_cast<CallBase>(&inst);
+                const Function* callee = (call) ? call->getCalledFunction() : nullptr;
+                if (callee && !callee->isDeclaration() && requested.insert(callee).second) {
+                    todo.push_back(callee);
+                }
+            }
+        }
+    }
+    return requested;
+}
+
+// Optimization level of the factory, kept in the module given to the shared lazy JIT
+static const char* gOptLevelFlag = "faust.opt_level";
+
+/*
+ The lazy JITs (one per target) and their compile threads are shared by all factories, which add
+ their module to their own JITDylib. They are never deleted, the compile threads being only started
+ when needed.
+*/
+static orc::LLLazyJIT* getLazyJIT(const string& target, string& error_msg)
+{
+    static std::mutex                       gLazyJITMutex;
+    static std::map<string, orc::LLLazyJIT*> gLazyJITTable;
+
+    std::lock_guard<std::mutex> lock(gLazyJITMutex);
+    auto                        it = gLazyJITTable.find(target);
+    if (it != gLazyJITTable.end()) {
+        return it->second;
+    }
+
+    string triple, cpu;
+    splitTarget(target, triple, cpu);
+
+    orc::JITTargetMachineBuilder tm_builder((Triple(triple)));
+    tm_builder.setCPU((cpu == "") ? sys::getHostCPUName().str() : cpu);
+    tm_builder.setOptions(getTargetOptions());
+#if LLVM_VERSION_MAJOR >= 18
+    tm_builder.setCodeGenOptLevel(CodeGenOptLevel::Aggressive);
 #else
-        PASS_MANAGER          pm;
-        FUNCTION_PASS_MANAGER fpm(fModule);
+    tm_builder.setCodeGenOptLevel(CodeGenOpt::Aggressive);
+#endif
+
+    // Keeps one core for the calling thread
+    unsigned threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    auto     jit     = orc::LLLazyJITBuilder()
+                   .setJITTargetMachineBuilder(tm_builder)
+                   .setNumCompileThreads(threads)
+                   .create();
+    if (!jit) {
+        error_msg = "ERROR : cannot create LLVM lazy JIT : " + toString(jit.takeError()) + "\n";
+        return nullptr;
+    }
+    orc::LLLazyJIT* lazy_jit = jit->release();
+    lazy_jit->setPartitionFunction(partitionCallees);
+
+    // Each partition is optimized at the level of its hottest function, 'compute' using the level
+    // of its factory. Cold functions are also marked 'optnone', so that the code generator uses its
+    // fast path for them
+    lazy_jit->getIRTransformLayer().setTransform(
+        [tm_builder](orc::ThreadSafeModule module, const orc::MaterializationResponsibility& r)
+            -> Expected<orc::ThreadSafeModule> {
+            Error err = Error::success();
+            module.withModuleDo([&](Module& m) {
+                ConstantInt* flag = mdconst::extract_or_null<ConstantInt>(
+                    m.getModuleFlag(gOptLevelFlag));
+                int hot_level = (flag) ? int(flag->getSExtValue()) : 0;
+                int level     = 0;
+                for (auto& fun : m) {
+                    if (!fun.isDeclaration()) {
+                        level = std::max(level, getFunOptLevel(fun.getName().str(), hot_level));
+                    }
+                }
+                if (level == 0) {
+                    for (auto& fun : m) {
+                        if (!fun.isDeclaration() && !fun.hasFnAttribute(Attribute::AlwaysInline)) {
+                            fun.addFnAttr(Attribute::OptimizeNone);
+                            fun.addFnAttr(Attribute::NoInline);
+                        }
+                    }
+                    return;
+                }
+                // The transform may run on several compile threads at once
+                orc::JITTargetMachineBuilder builder = tm_builder;
+                auto                         tm      = builder.createTargetMachine();
+                if (!tm) {
+                    err = tm.takeError();
+                    return;
+                }
+                optimizeModule(&m, tm->get(), level);
+            });
+            if (err) {
+                return err;
+            }
+            return module;
+        });
 
-        // Code taken from opt.cpp
-        TargetLibraryInfoImpl TLII(Triple(fModule->getTargetTriple()));
-        pm.add(new TargetLibraryInfoWrapperPass(TLII));
-        fModule->setDataLayout(fJIT->getDataLayout());
+    gLazyJITTable[target] = lazy_jit;
+    return lazy_jit;
+}
 
-        // Add internal analysis passes from the target machine (mandatory for vectorization to
-        // work) Code taken from opt.cpp
-        pm.add(createTargetTransformInfoWrapperPass(tm->getTargetIRAnalysis()));
+/*
+ The JITDylibs of the deleted factories are cleared and reused by the new ones. They cannot be
+ removed from the shared lazy JIT, since its CompileOnDemandLayer keeps track of all the JITDylibs it
+ has seen (by address), so the number of JITDylibs is the maximum number of living factories.
+*/
+static std::mutex                                              gDylibPoolMutex;
+static std::map<orc::LLLazyJIT*, std::vector<orc::JITDylib*>> gDylibPool;
 
-        if (fOptLevel > 0) {
-            AddOptimizationPasses(pm, fpm, fOptLevel, 0);
+static orc::JITDylib* takeDylib(orc::LLLazyJIT* lazy_jit, string& error_msg)
+{
+    {
+        std::lock_guard<std::mutex>  lock(gDylibPoolMutex);
+        std::vector<orc::JITDylib*>& pool = gDylibPool[lazy_jit];
+        if (pool.size() > 0) {
+            orc::JITDylib* dylib = pool.back();
+            pool.pop_back();
+            return dylib;
         }
+    }
 
-        if (global::isDebug("FAUST_LLVM1")) {
-            dumpLLVM(fModule);
-        }
+    // JITDylib names have to be unique
+    static std::atomic<int> gDylibCounter(0);
+    auto dylib = lazy_jit->createJITDylib("faust_dsp" + to_string(gDylibCounter++));
+    if (!dylib) {
+        error_msg = "ERROR : cannot create LLVM JITDylib : " + toString(dylib.takeError()) + "\n";
+        return nullptr;
+    }
 
-        fpm.doInitialization();
-        for (Module::iterator F = fModule->begin(), E = fModule->end(); F != E; ++F) {
-            fpm.run(*F);
-        }
-        fpm.doFinalization();
-        pm.add(createVerifierPass());
+    // The platform symbols (used to run static constructors and destructors) are defined in the
+    // main JITDylib, and foreign and math functions are found in the process
+    dylib->addToLinkOrder(lazy_jit->getMainJITDylib());
+    dylib->addGenerator(cantFail(orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        lazy_jit->getDataLayout().getGlobalPrefix())));
+    return &dylib.get();
+}
 
-        if (global::isDebug("FAUST_LLVM4")) {
-            // TODO
-            // tm->addPassesToEmitFile(pm, fouts(), TargetMachine::CGFT_AssemblyFile, true);
-        }
+static void releaseDylib(orc::LLLazyJIT* lazy_jit, orc::JITDylib* dylib)
+{
+    // Frees the code and the symbols, the function bodies being in the 'impl' dylib of the
+    // CompileOnDemandLayer
+    orc::JITDylib* impl = lazy_jit->getJITDylibByName(dylib->getName() + ".impl");
+    if (impl) {
+        consumeError(impl->clear());
+    }
+    consumeError(dylib->clear());
 
-        // Now that we have all of the passes ready, run them.
-        pm.run(*fModule);
-        if (global::isDebug("FAUST_LLVM2")) {
-            dumpLLVM(fModule);
-        }
+    std::lock_guard<std::mutex> lock(gDylibPoolMutex);
+    gDylibPool[lazy_jit].push_back(dylib);
+}
+
+bool llvm_dynamic_dsp_factory_aux::initLazyJIT(string& error_msg)
+{
+    string triple, cpu;
+    splitTarget(fTarget, triple, cpu);
+    fModule->setTargetTriple(triple);
+
+    fLazyJIT = getLazyJIT(fTarget, error_msg);
+    if (!fLazyJIT) {
+        endTiming("initJIT");
+        return false;
+    }
+
+    fDylib = takeDylib(fLazyJIT, error_msg);
+    if (!fDylib) {
+        endTiming("initJIT");
+        fLazyJIT = nullptr;
+        return false;
+    }
+
+    // Copy of the module in its own context, through bitcode
+    string             bitcode;
+    raw_string_ostream out(bitcode);
+#if LLVM_VERSION_MAJOR >= 8
+    WriteBitcodeToFile(*fModule, out);
+#else
+    WriteBitcodeToFile(fModule, out);
 #endif
+    out.flush();
+    auto context = std::make_unique<LLVMContext>();
+    context->setDiagnosticHandler(std::make_unique<FaustDiagnosticHandler>());
+    Module* module = ParseBitcodeFile(MEMORY_BUFFER_CREATE(bitcode), *context, error_msg);
+    if (!module) {
+        endTiming("initJIT");
+        return false;
     }
+    module->setDataLayout(fLazyJIT->getDataLayout());
+    module->addModuleFlag(Module::Warning, gOptLevelFlag, fOptLevel);
 
-    fObjectCache = new FaustObjectCache();
-    fJIT->setObjectCache(fObjectCache);
-    return initJITAux();
+    if (Error err = fLazyJIT->addLazyIRModule(
+            *fDylib, orc::ThreadSafeModule(unique_ptr<Module>(module), std::move(context)))) {
+        endTiming("initJIT");
+        error_msg = "ERROR : cannot add module to LLVM lazy JIT : " + toString(std::move(err)) + "\n";
+        return false;
+    }
+
+    // Run static constructors
+    if (Error err = fLazyJIT->initialize(*fDylib)) {
+        endTiming("initJIT");
+        error_msg = "ERROR : cannot initialize LLVM lazy JIT : " + toString(std::move(err)) + "\n";
+        return false;
+    }
+
+    // Function pointers are stubs, compiling the functions at their first call
+    if (!initJITAux()) {
+        return false;
+    }
+    compileInBackground("compute" + fClassName);
+    return true;
+}
+
+// Starts the compilation of 'function' on the compile threads, its stub waiting for the result
+void llvm_dynamic_dsp_factory_aux::compileInBackground(const string& function)
+{
+    // The function bodies are in the 'impl' dylib of the CompileOnDemandLayer
+    orc::ExecutionSession& session = fLazyJIT->getExecutionSession();
+    orc::JITDylib*         impl    = session.getJITDylibByName(fDylib->getName() + ".impl");
+    if (!impl) {
+        return;
+    }
+    auto done           = std::make_shared<std::promise<void>>();
+    fBackgroundCompile = done->get_future().share();
+    session.lookup(
+        orc::LookupKind::Static, orc::makeJITDylibSearchOrder(impl),
+        orc::SymbolLookupSet(fLazyJIT->mangleAndIntern(function)), orc::SymbolState::Ready,
+        [done](Expected<orc::SymbolMap> res) {
+            // Errors will be reported by the stub at the first call
+            if (!res) {
+                consumeError(res.takeError());
+            }
+            done->set_value();
+        },
+        orc::NoDependenciesToRegister);
+}
+
+#endif
+
+uint64_t llvm_dynamic_dsp_factory_aux::loadOptimize(const string& function)
+{
+    // fJIT is also created when machine code is requested (see writeDSPFactoryToMachineAux)
+    if (fJIT || !fLazyJIT) {
+        return llvm_dsp_factory_aux::loadOptimize(function);
+    }
+#if LLVM_VERSION_MAJOR >= 13
+    auto fun = fLazyJIT->lookup(*fDylib, function);
+    if (!fun) {
+        consumeError(fun.takeError());
+        stringstream error;
+        error << "ERROR : loadOptimize failed for '" << function << "'\n";
+        throw faustexception(error.str());
+    }
+#if LLVM_VERSION_MAJOR >= 15
+    return fun->getValue();
+#else
+    return fun->getAddress();
+#endif
+#else
+    return 0;
+#endif
+}
+
+llvm_dynamic_dsp_factory_aux::~llvm_dynamic_dsp_factory_aux()
+{
+#if LLVM_VERSION_MAJOR >= 13
+    if (fLazyJIT) {
+        if (fBackgroundCompile.valid()) {
+            fBackgroundCompile.wait();
+        }
+        // Runs static destructors, then gives the cleared JITDylib to the next factory
+        consumeError(fLazyJIT->deinitialize(*fDylib));
+        releaseDylib(fLazyJIT, fDylib);
+        // Otherwise fModule is kept and deleted by fJIT
+        if (!fJIT) {
+            delete fModule;
+        }
+    }
+#endif
 }
 
 // Bitcode <==> string
@@ -653,24 +1050,81 @@ LIBFAUST_API llvm_dsp_factory* createDSPFactoryFromFile(const string& filename,
     }
 }
 
+/*
+ A cache entry keeps the machine code with the bitcode of the module it was compiled from (both in
+ base64, separated by a space), so that a factory restored from the cache behaves like a compiled
+ one for the writeXXX functions.
+*/
+static llvm_dynamic_dsp_factory_aux* readCacheCode(const string& sha_key, const string& code,
+                                                   const string& target, int opt_level,
+                                                   string& error_msg)
+{
+    size_t pos = code.find(' ');
+    if (pos == string::npos) {
+        return nullptr;
+    }
+    string       bitcode = base64_decode(code.substr(pos + 1));
+    LLVMContext* context = new LLVMContext();
+    Module*      module =
+        ParseBitcodeFile(MEMORY_BUFFER_CREATE(StringRef(bitcode)), *context, error_msg);
+    if (!module) {
+        delete context;
+        return nullptr;
+    }
+    // The bitcode only keeps the source file name, which is the initial module identifier
+    module->setModuleIdentifier(module->getSourceFileName());
+    return new llvm_dynamic_dsp_factory_aux(sha_key, module, context,
+                                            base64_decode(code.substr(0, pos)), target, opt_level);
+}
+
 LIBFAUST_API llvm_dsp_factory* createDSPFactoryFromString(const string& name_app,
                                                           const string& dsp_content, int argc,
                                                           const char* argv[], const string& target,
                                                           string& error_msg, int opt_level)
 {
-    LOCK_API
-    string expanded_dsp_content, sha_key;
+    // The profile (see -time-json and -time-trace) also records the JIT compilation
+    PhaseProfilerScope profiler_scope;
+    string             expanded_dsp_content, sha_key;
 
     if ((expanded_dsp_content = sha1FromDSP(name_app, dsp_content, argc, argv, sha_key)) == "") {
         return nullptr;
     } else {
         dsp_factory_table<SDsp_factory>::factory_iterator it;
-        if (llvm_dsp_factory_aux::gLLVMFactoryTable.getFactory(sha_key, it)) {
-            SDsp_factory sfactory = (*it).first;
-            sfactory->addReference();
-            return sfactory;
-        } else {
-            try {
+        {
+            LOCK_API
+            if (llvm_dsp_factory_aux::gLLVMFactoryTable.getFactory(sha_key, it)) {
+                SDsp_factory sfactory = (*it).first;
+                sfactory->addReference();
+                return sfactory;
+            }
+        }
+        // The compilation and the JIT run in their own contexts, only the factory table access is
+        // locked
+        try {
+            // Possibly reuse the machine code compiled by a previous run, see FAUST_DSP_CACHE
+            llvm_dynamic_dsp_factory_aux* factory_aux = nullptr;
+            string host = (target == "") ? getDSPMachineTarget() : target;
+            string cache_key =
+                dsp_cache::makeKey(sha_key, "llvm " + host + " " + to_string(opt_level));
+            string cache_code;
+            if (dsp_cache::read(cache_key, cache_code)) {
+                factory_aux = readCacheCode(sha_key, cache_code, target, opt_level, error_msg);
+                // Same settings as a compiled factory (see below)
+                if (factory_aux) {
+                    factory_aux->setTarget(target);
+                    factory_aux->setOptlevel(opt_level);
+                    factory_aux->setClassName(getParam(argc, argv, "-cn", "mydsp"));
+                    factory_aux->setName(name_app);
+                }
+                if (!factory_aux || !factory_aux->initJIT(error_msg)) {
+                    // Unusable entry: compile again and replace it
+                    delete factory_aux;
+                    factory_aux = nullptr;
+                    error_msg   = "";
+                }
+            }
+
+            if (!factory_aux) {
                 int         argc1 = 0;
                 const char* argv1[64];
                 argv1[argc1++] = "faust";
@@ -684,27 +1138,42 @@ LIBFAUST_API llvm_dsp_factory* createDSPFactoryFromString(const string& name_app
                 }
                 argv1[argc1] = nullptr;  // NULL terminated argv
 
-                llvm_dynamic_dsp_factory_aux* factory_aux =
-                    static_cast<llvm_dynamic_dsp_factory_aux*>(
-                        createFactory(name_app, dsp_content, argc1, argv1, error_msg, true));
+                vector<string> library_files;
+                factory_aux = static_cast<llvm_dynamic_dsp_factory_aux*>(createFactory(
+                    name_app, dsp_content, argc1, argv1, error_msg, true, &library_files));
                 if (factory_aux && factory_aux->initJIT(error_msg)) {
                     factory_aux->setTarget(target);
                     factory_aux->setOptlevel(opt_level);
                     factory_aux->setClassName(getParam(argc, argv, "-cn", "mydsp"));
                     factory_aux->setName(name_app);
-                    llvm_dsp_factory* factory = new llvm_dsp_factory(factory_aux);
-                    llvm_dsp_factory_aux::gLLVMFactoryTable.setFactory(factory);
-                    factory->setSHAKey(sha_key);
-                    factory->setDSPCode(expanded_dsp_content);
-                    return factory;
+                    // A lazy factory would have to compile its whole module again (with MCJIT) to
+                    // produce the machine code, which is what the lazy mode avoids
+                    if (dsp_cache::getDirectory() != "" && !factory_aux->isLazy()) {
+                        dsp_cache::write(cache_key, factory_aux->writeDSPFactoryToCache(),
+                                         library_files);
+                    }
                 } else {
                     delete factory_aux;
                     return nullptr;
                 }
-            } catch (faustexception& e) {
-                error_msg = e.what();
-                return nullptr;
             }
+
+            LOCK_API
+            // The same DSP may have been compiled by another thread in the meantime
+            if (llvm_dsp_factory_aux::gLLVMFactoryTable.getFactory(sha_key, it)) {
+                delete factory_aux;
+                SDsp_factory sfactory = (*it).first;
+                sfactory->addReference();
+                return sfactory;
+            }
+            llvm_dsp_factory* factory = new llvm_dsp_factory(factory_aux);
+            llvm_dsp_factory_aux::gLLVMFactoryTable.setFactory(factory);
+            factory->setSHAKey(sha_key);
+            factory->setDSPCode(expanded_dsp_content);
+            return factory;
+        } catch (faustexception& e) {
+            error_msg = e.what();
+            return nullptr;
         }
     }
 }
@@ -22,31 +22,81 @@
 #ifndef LLVM_DYNAMIC_DSP_AUX_H
 #define LLVM_DYNAMIC_DSP_AUX_H
 
+#include <future>
+
 #include "llvm_dsp_aux.hh"
 
+namespace llvm {
+namespace orc {
+class JITDylib;
+class LLLazyJIT;
+}  // namespace orc
+}  // namespace llvm
+
 /*
     Dynamic LLVM DSP compilation.
+
+    When FAUST_LLVM_LAZY is set, the module is compiled with the ORC lazy JIT instead of MCJIT:
+    each function is only compiled at its first call, by a pool of compile threads, and 'compute'
+    is compiled in the background as soon as the factory is created. FAUST_LLVM_LAZY can give the
+    optimization level of the functions with a 'name:level' list, like 'compute:3,classInit:1,*:0'
+    (names are matched as prefixes, '*' is for the other functions). By default 'compute' uses
+    the factory level, and the other (cold) functions are compiled with level 0.
+
+    The lazy JIT (one per target) and its compile threads are shared by all the factories of the
+    process, each factory adding its module to its own JITDylib. Since no machine code is produced,
+    lazy factories are not written in the FAUST_DSP_CACHE directory (but are read from it).
  */
 class llvm_dynamic_dsp_factory_aux : public llvm_dsp_factory_aux {
    private:
+    // Shared lazy JIT, the MCJIT one (fJIT) being used when the machine code has to be produced
+    llvm::orc::LLLazyJIT* fLazyJIT;
+    llvm::orc::JITDylib*  fDylib;
+
+    // Background compilation of 'compute', waited for before the code is removed
+    std::shared_future<void> fBackgroundCompile;
+
     bool writeDSPFactoryToObjectcodeFileAux(const std::string& object_code_path);
 
+    bool initLazyJIT(std::string& error_msg);
+
+    void compileInBackground(const std::string& function);
+
+    virtual uint64_t loadOptimize(const std::string& function);
+
    public:
     llvm_dynamic_dsp_factory_aux(const std::string& sha_key, llvm::Module* module,
                                  llvm::LLVMContext* context, const std::string& target,
                                  int opt_level = -1)
-        : llvm_dsp_factory_aux(sha_key, module, context, target, opt_level)
+        : llvm_dsp_factory_aux(sha_key, module, context, target, opt_level),
+          fLazyJIT(nullptr),
+          fDylib(nullptr)
     {
     }
 
     llvm_dynamic_dsp_factory_aux(const std::string& sha_key, const std::string& machine_code,
                                  const std::string& target)
-        : llvm_dsp_factory_aux(sha_key, machine_code, target)
+        : llvm_dsp_factory_aux(sha_key, machine_code, target), fLazyJIT(nullptr), fDylib(nullptr)
+    {
+    }
+
+    // Machine code restored from the cache (see FAUST_DSP_CACHE), with the module it comes from
+    llvm_dynamic_dsp_factory_aux(const std::string& sha_key, llvm::Module* module,
+                                 llvm::LLVMContext* context, const std::string& machine_code,
+                                 const std::string& target, int opt_level)
+        : llvm_dsp_factory_aux(sha_key, module, context, target, opt_level),
+          fLazyJIT(nullptr),
+          fDylib(nullptr)
     {
+        fObjectCache = new FaustObjectCache(machine_code);
     }
 
+    virtual ~llvm_dynamic_dsp_factory_aux();
+
     virtual bool initJIT(std::string& error_msg);
 
+    bool isLazy() { return fLazyJIT != nullptr; }
+
     void write(std::ostream* out, bool binary, bool small = false);
 
     // Bitcode
@@ -54,6 +104,9 @@ class llvm_dynamic_dsp_factory_aux : public llvm_dsp_factory_aux {
 
     bool writeDSPFactoryToBitcodeFile(const std::string& bit_code_path);
 
+    // Machine code and bitcode kept in the cache (see FAUST_DSP_CACHE)
+    std::string writeDSPFactoryToCache();
+
     // Textual IR
     virtual std::string writeDSPFactoryToIR();
 
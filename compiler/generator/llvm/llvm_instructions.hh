@@ -28,11 +28,13 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 
 #include "Text.hh"
 #include "binop.hh"
 #include "exception.hh"
+#include "fir_simd.hh"
 #include "fir_to_fir.hh"
 #include "global.hh"
 #include "instructions.hh"
@@ -42,6 +44,7 @@
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/raw_ostream.h>
@@ -90,6 +93,22 @@
 #define MakeCreateLoad1(type, var) fBuilder->CreateLoad(var)
 #endif
 
+#if LLVM_VERSION_MAJOR >= 11
+#define MakeVectorType(type, size) llvm::FixedVectorType::get(type, size)
+#else
+#define MakeVectorType(type, size) llvm::VectorType::get(type, size)
+#endif
+
+#if LLVM_VERSION_MAJOR >= 10
+#define MakeCreateAlignedLoad(type, ptr, align) \
+    fBuilder->CreateAlignedLoad(type, ptr, llvm::MaybeAlign(align))
+#define MakeCreateAlignedStore(val, ptr, align) \
+    fBuilder->CreateAlignedStore(val, ptr, llvm::MaybeAlign(align))
+#else
+#define MakeCreateAlignedLoad(type, ptr, align) fBuilder->CreateAlignedLoad(type, ptr, align)
+#define MakeCreateAlignedStore(val, ptr, align) fBuilder->CreateAlignedStore(val, ptr, align)
+#endif
+
 #define MakeConstGEP32(type, llvm_name) fBuilder->CreateConstGEP2_32(type, llvm_name, 0, 0);
 #define MakeIntPtrType() fModule->getDataLayout().getIntPtrType(fModule->getContext())
 
@@ -272,12 +291,7 @@ struct LLVMTypeHelper {
                              fTypeMap[Typed::getTypeFromPtr(array_typed->getType())],
                              array_typed->fSize);
         } else if (vector_typed) {
-#if LLVM_VERSION_MAJOR < 12
-            return llvm::VectorType::get(fTypeMap[vector_typed->fType->fType], vector_typed->fSize);
-#else
-            faustassert(false);
-            return nullptr;
-#endif
+            return MakeVectorType(fTypeMap[vector_typed->fType->fType], vector_typed->fSize);
         } else if (struct_typed) {
             LLVMVecTypes llvm_types;
             for (const auto& it : struct_typed->fFields) {
@@ -319,6 +333,36 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
     std::map<std::string, llvm::Intrinsic::ID> fBinaryIntrinsicTable;  // LLVM binary intrinsic
 #endif
 
+    // Description of the vector helpers generated by SIMDVectorizer
+    struct SIMDFunDesc {
+        enum Gen {
+            kLoad,
+            kStore,
+            kAlignedLoad,
+            kAlignedStore,
+            kAligned,
+            kSet,
+            kBinop,
+            kNeg,
+            kIntrinsic,
+            kMin,
+            kMax,
+            kIntToReal,
+            kRealToInt
+        };
+
+        Gen            fGen;
+        Typed::VarType fType;    // Type of the vector elements
+        int            fOpcode;  // Binop opcode or intrinsic ID
+    };
+
+    std::map<std::string, SIMDFunDesc> fSIMDFunTable;  // Table : helper name, SIMD description
+
+    // Alias scopes separating audio buffers and DSP memory accesses in -vec mode
+    llvm::MDNode*         fDSPScope;
+    llvm::MDNode*         fBufferScope;
+    std::set<std::string> fBufferVars;  // FAUSTFLOAT pointers (on audio buffers)
+
     void printVarTable()
     {
         for (const auto& it : fStackVars) {
@@ -409,7 +453,9 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
         : LLVMTypeHelper(module),
           fBuilder(builder),
           fStructVisitor(struct_visitor),
-          fCurValue(nullptr)
+          fCurValue(nullptr),
+          fDSPScope(nullptr),
+          fBufferScope(nullptr)
     {
         // Keep [name, [type, type_pointee]]
         for (const auto& it : dec_type->fType->fFields) {
@@ -469,6 +515,108 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
             "fabs", "acos", "asin", "atan", "atan2", "ceil", "cos", "exp", "exp10", "floor", "fmod",
             "log", "log10f", "pow", "rint", "round", "sin", "sqrt", "tan", "acosh", "asinh",
             "atanh", "cosh", "sinh", "tanh"};
+
+        // Vector helpers
+        if (gGlobal->gSIMDLanes > 0) {
+            initSIMDFunTable(gGlobal->gSIMDLanes);
+        }
+
+        // Audio buffers are never part of the DSP memory (struct, stack and global variables)
+        if (gGlobal->gVectorSwitch) {
+            llvm::MDBuilder builder(fModule->getContext());
+            llvm::MDNode*   domain    = builder.createAnonymousAliasScopeDomain("faust");
+            llvm::Metadata* dsp[]     = {builder.createAnonymousAliasScope(domain, "dsp")};
+            llvm::Metadata* buffers[] = {builder.createAnonymousAliasScope(domain, "buffers")};
+            fDSPScope                 = llvm::MDNode::get(fModule->getContext(), dsp);
+            fBufferScope              = llvm::MDNode::get(fModule->getContext(), buffers);
+        }
+    }
+
+    void addSIMDFun(int lanes, const std::string& model, Typed::VarType type,
+                    SIMDFunDesc::Gen gen, int opcode = 0)
+    {
+        fSIMDFunTable[getSIMDHelper(lanes, model, type)] = {gen, type, opcode};
+    }
+
+    void initSIMDFunTable(int lanes)
+    {
+        for (Typed::VarType type : {itfloat(), Typed::kInt32}) {
+            addSIMDFun(lanes, "load_$0", type, SIMDFunDesc::kLoad);
+            addSIMDFun(lanes, "store_$0", type, SIMDFunDesc::kStore);
+            addSIMDFun(lanes, "set_$0", type, SIMDFunDesc::kSet);
+            addSIMDFun(lanes, "add_$0", type, SIMDFunDesc::kBinop, kAdd);
+            addSIMDFun(lanes, "sub_$0", type, SIMDFunDesc::kBinop, kSub);
+            addSIMDFun(lanes, "mul_$0", type, SIMDFunDesc::kBinop, kMul);
+            addSIMDFun(lanes, "neg_$0", type, SIMDFunDesc::kNeg);
+        }
+
+        // FAUSTFLOAT has the internal real type
+        Typed::VarType real = itfloat();
+        addSIMDFun(lanes, "load_faustfloat_to_$0", real, SIMDFunDesc::kLoad);
+        addSIMDFun(lanes, "store_$0_to_faustfloat", real, SIMDFunDesc::kStore);
+        addSIMDFun(lanes, "loada_$0", real, SIMDFunDesc::kAlignedLoad);
+        addSIMDFun(lanes, "storea_$0", real, SIMDFunDesc::kAlignedStore);
+        addSIMDFun(lanes, "loada_faustfloat_to_$0", real, SIMDFunDesc::kAlignedLoad);
+        addSIMDFun(lanes, "storea_$0_to_faustfloat", real, SIMDFunDesc::kAlignedStore);
+        addSIMDFun(lanes, "aligned_$0", real, SIMDFunDesc::kAligned);
+        addSIMDFun(lanes, "div_$0", real, SIMDFunDesc::kBinop, kDiv);
+        addSIMDFun(lanes, "abs_$0", real, SIMDFunDesc::kIntrinsic, llvm::Intrinsic::fabs);
+        addSIMDFun(lanes, "sqrt_$0", real, SIMDFunDesc::kIntrinsic, llvm::Intrinsic::sqrt);
+        addSIMDFun(lanes, "floor_$0", real, SIMDFunDesc::kIntrinsic, llvm::Intrinsic::floor);
+        addSIMDFun(lanes, "ceil_$0", real, SIMDFunDesc::kIntrinsic, llvm::Intrinsic::ceil);
+        addSIMDFun(lanes, "nearest_$0", real, SIMDFunDesc::kIntrinsic, llvm::Intrinsic::rint);
+        addSIMDFun(lanes, "min_$0", real, SIMDFunDesc::kMin);
+        addSIMDFun(lanes, "max_$0", real, SIMDFunDesc::kMax);
+        addSIMDFun(lanes, "int_to_$0", real, SIMDFunDesc::kIntToReal);
+        addSIMDFun(lanes, "$0_to_int", real, SIMDFunDesc::kRealToInt);
+
+        Typed::VarType integer = Typed::kInt32;
+        addSIMDFun(lanes, "and_$0", integer, SIMDFunDesc::kBinop, kAND);
+        addSIMDFun(lanes, "or_$0", integer, SIMDFunDesc::kBinop, kOR);
+        addSIMDFun(lanes, "xor_$0", integer, SIMDFunDesc::kBinop, kXOR);
+        addSIMDFun(lanes, "shl_$0", integer, SIMDFunDesc::kBinop, kLsh);
+        addSIMDFun(lanes, "shr_$0", integer, SIMDFunDesc::kBinop, kARsh);
+    }
+
+    // The FAUSTFLOAT** arguments (that is 'inputs' and 'outputs') point to the audio buffers
+    void addBufferVar(const std::string& name, Typed::VarType type)
+    {
+        if (type == Typed::kFloatMacro_ptr_ptr) {
+            fBufferVars.insert(name);
+        }
+    }
+
+    // Stack pointers set from a buffer pointer (like 'input0 = &input0_ptr[vindex]') also point
+    // to the audio buffers
+    void addBufferVar(const std::string& name, ValueInst* value)
+    {
+        while (CastInst* cast = dynamic_cast<CastInst*>(value)) {
+            value = cast->fInst;
+        }
+        Address* address = nullptr;
+        if (LoadVarInst* load = dynamic_cast<LoadVarInst*>(value)) {
+            address = load->fAddress;
+        } else if (LoadVarAddressInst* load = dynamic_cast<LoadVarAddressInst*>(value)) {
+            address = load->fAddress;
+        }
+        if (address && fBufferVars.find(address->getName()) != fBufferVars.end()) {
+            fBufferVars.insert(name);
+        }
+    }
+
+    // Indexed accesses on audio buffer pointers are in the buffers scope, all other memory
+    // accesses (DSP struct, stack arrays, global tables) are in the DSP scope
+    void setAliasScope(LLVMValue value, Address* address)
+    {
+        if (!fDSPScope || !address ||
+            !(llvm::isa<llvm::LoadInst>(value) || llvm::isa<llvm::StoreInst>(value))) {
+            return;
+        }
+        bool buffer = dynamic_cast<IndexedAddress*>(address) &&
+                      (fBufferVars.find(address->getName()) != fBufferVars.end());
+        llvm::Instruction* inst = llvm::cast<llvm::Instruction>(value);
+        inst->setMetadata(llvm::LLVMContext::MD_alias_scope, (buffer) ? fBufferScope : fDSPScope);
+        inst->setMetadata(llvm::LLVMContext::MD_noalias, (buffer) ? fDSPScope : fBufferScope);
     }
 
     virtual ~LLVMInstVisitor() { delete fAllocaBuilder; }
@@ -530,6 +678,9 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
 
         // Keep [name, [type, type_pointee]]
         fVarTypes[name] = std::make_pair(type, getPtrTy(type, inst->fType->getType()));
+        if (inst->fValue && (access & Address::kStack || access & Address::kLoop)) {
+            addBufferVar(name, inst->fValue);
+        }
 
         // No result in fCurValue
         fCurValue = nullptr;
@@ -556,6 +707,7 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
                 fun_args_type.push_back(type);
                 // Keep [name, [type, type_pointee]]
                 fVarTypes[it->getName()] = std::make_pair(type, getPtrTy(type, it->getType()));
+                addBufferVar(it->getName(), it->getType());
             }
 
             // Creates function
@@ -730,6 +882,7 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
         } else {
             faustassert(false);
         }
+        setAliasScope(fCurValue, inst->fAddress);
     }
 
     //====================
@@ -742,7 +895,7 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
     // StoreVarInst
     //==============
 
-    void genStore(LLVMValue store_ptr, LLVMValue store, bool is_volatile)
+    LLVMValue genStore(LLVMValue store_ptr, LLVMValue store, bool is_volatile)
     {
         // HACK : special case if we store a 0 (null pointer) in an address
         // (used in vec mode and in "allocate" function in scheduler mode...)
@@ -752,16 +905,19 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
             store =
                 llvm::ConstantPointerNull::get(static_cast<LLVMPtrType>(type->getContainedType(0)));
         }
-        fBuilder->CreateStore(store, store_ptr, is_volatile);
+        return fBuilder->CreateStore(store, store_ptr, is_volatile);
     }
 
     virtual void visit(StoreVarInst* inst)
     {
         LLVMValue store_ptr = visit(inst->fAddress);
+        if (dynamic_cast<NamedAddress*>(inst->fAddress) && inst->fAddress->isStack()) {
+            addBufferVar(inst->fAddress->getName(), inst->fValue);
+        }
 
         // Result is in fCurValue;
         inst->fValue->accept(this);
-        genStore(store_ptr, fCurValue, inst->fAddress->isVolatile());
+        setAliasScope(genStore(store_ptr, fCurValue, inst->fAddress->isVolatile()), inst->fAddress);
 
         // No result in fCurValue
         fCurValue = nullptr;
@@ -952,8 +1108,112 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
         fCurValue = nullptr;
     }
 
+    // Vector helper, compiled as vector IR
+    bool visitSIMDCall(FunCallInst* inst)
+    {
+        if (fSIMDFunTable.find(inst->fName) == fSIMDFunTable.end()) {
+            return false;
+        }
+
+        const SIMDFunDesc& desc     = fSIMDFunTable[inst->fName];
+        int                lanes    = gGlobal->gSIMDLanes;
+        LLVMType           elem     = fTypeMap[desc.fType];
+        LLVMType           vec_type = MakeVectorType(elem, lanes);
+
+        std::vector<LLVMValue> args;
+        for (const auto& it : inst->fArgs) {
+            // Each argument is compiled and result is in fCurValue
+            it->accept(this);
+            args.push_back(fCurValue);
+        }
+
+        // Vectors are loaded/stored with the alignment of their elements, or of the vector type
+        // for the audio buffers in the aligned version of the code (see SIMDAlignedVersion)
+        LoadVarAddressInst* address = dynamic_cast<LoadVarAddressInst*>(inst->fArgs.front());
+        int                 align   = elem->getPrimitiveSizeInBits() / 8;
+        if (desc.fGen == SIMDFunDesc::kAlignedLoad || desc.fGen == SIMDFunDesc::kAlignedStore ||
+            desc.fGen == SIMDFunDesc::kAligned) {
+            align *= lanes;
+        }
+        switch (desc.fGen) {
+            case SIMDFunDesc::kLoad:
+            case SIMDFunDesc::kAlignedLoad:
+                fCurValue = MakeCreateAlignedLoad(
+                    vec_type, fBuilder->CreateBitCast(args[0], getTyPtr(vec_type)), align);
+                setAliasScope(fCurValue, (address) ? address->fAddress : nullptr);
+                break;
+
+            case SIMDFunDesc::kStore:
+            case SIMDFunDesc::kAlignedStore:
+                setAliasScope(MakeCreateAlignedStore(
+                                  args[1], fBuilder->CreateBitCast(args[0], getTyPtr(vec_type)),
+                                  align),
+                              (address) ? address->fAddress : nullptr);
+                fCurValue = nullptr;
+                break;
+
+            case SIMDFunDesc::kAligned: {
+                // All buffer pointers are tested at once, with an 'or' of their addresses
+                LLVMValue bits = genInt64(0);
+                for (const auto& it : args) {
+                    bits = fBuilder->CreateOr(bits, fBuilder->CreatePtrToInt(it, getInt64Ty()));
+                }
+                bits      = fBuilder->CreateAnd(bits, genInt64(align - 1));
+                fCurValue = fBuilder->CreateZExt(
+                    fBuilder->CreateICmpEQ(bits, genInt64(0)), getInt32Ty());
+                break;
+            }
+
+            case SIMDFunDesc::kSet:
+                fCurValue = fBuilder->CreateVectorSplat(lanes, args[0]);
+                break;
+
+            case SIMDFunDesc::kBinop: {
+                // Shift counts are scalars
+                LLVMValue arg2 = (args[1]->getType()->isVectorTy())
+                                     ? args[1]
+                                     : fBuilder->CreateVectorSplat(lanes, args[1]);
+                fCurValue      = (desc.fType == Typed::kInt32)
+                                     ? generateBinOpInt(desc.fOpcode, args[0], arg2)
+                                     : generateBinOpReal(desc.fOpcode, args[0], arg2);
+                break;
+            }
+
+            case SIMDFunDesc::kNeg:
+                fCurValue = (desc.fType == Typed::kInt32) ? fBuilder->CreateNeg(args[0])
+                                                          : fBuilder->CreateFNeg(args[0]);
+                break;
+
+            case SIMDFunDesc::kIntrinsic:
+                fCurValue = fBuilder->CreateUnaryIntrinsic(
+                    static_cast<llvm::Intrinsic::ID>(desc.fOpcode), args[0]);
+                break;
+
+            case SIMDFunDesc::kMin:
+                fCurValue = fBuilder->CreateMinNum(args[0], args[1]);
+                break;
+
+            case SIMDFunDesc::kMax:
+                fCurValue = fBuilder->CreateMaxNum(args[0], args[1]);
+                break;
+
+            case SIMDFunDesc::kIntToReal:
+                fCurValue = fBuilder->CreateSIToFP(args[0], vec_type);
+                break;
+
+            case SIMDFunDesc::kRealToInt:
+                fCurValue = fBuilder->CreateFPToSI(args[0], MakeVectorType(getInt32Ty(), lanes));
+                break;
+        }
+        return true;
+    }
+
     virtual void visit(FunCallInst* inst)
     {
+        if (visitSIMDCall(inst)) {
+            return;
+        }
+
         // Compile function arguments
         std::vector<LLVMValue> fun_args;
         for (const auto& it : inst->fArgs) {
@@ -1236,8 +1496,11 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
             // Add a new entry to the PHI node for the backedge
             phi_node->addIncoming(next_index, current_block);
 
-            // Back to start of loop
-            fBuilder->CreateBr(test_block);
+            // Back to start of loop, possibly with vectorization hints
+            llvm::BranchInst* back_edge = fBuilder->CreateBr(test_block);
+            if (llvm::MDNode* loop_id = genLoopMetadata(inst)) {
+                back_edge->setMetadata(llvm::LLVMContext::MD_loop, loop_id);
+            }
         }
 
         // Move insertion in exit_block
@@ -1247,6 +1510,40 @@ class LLVMInstVisitor : public InstVisitor, public LLVMTypeHelper {
         fCurValue = nullptr;
     }
 
+    /*
+     Non recursive 'for (int i = 0; i < size; i = i + 1)' loops of the -vec mode are marked to be
+     vectorized, with the -simd lanes number as width when given.
+    */
+    llvm::MDNode* genLoopMetadata(ForLoopInst* inst)
+    {
+        DeclareVarInst* init      = dynamic_cast<DeclareVarInst*>(inst->fInit);
+        StoreVarInst*   increment = dynamic_cast<StoreVarInst*>(inst->fIncrement);
+        BinopInst*      next      = (increment) ? dynamic_cast<BinopInst*>(increment->fValue) : nullptr;
+        Int32NumInst*   start     = (init) ? dynamic_cast<Int32NumInst*>(init->fValue) : nullptr;
+        Int32NumInst*   step      = (next) ? dynamic_cast<Int32NumInst*>(next->fInst2) : nullptr;
+        if (!gGlobal->gVectorSwitch || inst->fIsRecursive || !start || start->fNum != 0 || !step ||
+            step->fNum != 1 || next->fOpcode != kAdd) {
+            return nullptr;
+        }
+
+        llvm::LLVMContext&           context = fModule->getContext();
+        std::vector<llvm::Metadata*> hints   = {
+            nullptr,
+            llvm::MDNode::get(context, {llvm::MDString::get(context, "llvm.loop.vectorize.enable"),
+                                          llvm::ConstantAsMetadata::get(
+                                              llvm::cast<llvm::Constant>(genInt1(1)))})};
+        if (gGlobal->gSIMDLanes > 0) {
+            hints.push_back(llvm::MDNode::get(
+                context, {llvm::MDString::get(context, "llvm.loop.vectorize.width"),
+                          llvm::ConstantAsMetadata::get(
+                              llvm::cast<llvm::Constant>(genInt32(gGlobal->gSIMDLanes)))}));
+        }
+        // The loop ID first operand is a self reference
+        llvm::MDNode* loop_id = llvm::MDNode::getDistinct(context, hints);
+        loop_id->replaceOperandWith(0, loop_id);
+        return loop_id;
+    }
+
     virtual void visit(WhileLoopInst* inst)
     {
         LLVMFun function = fBuilder->GetInsertBlock()->getParent();
@@ -41,7 +41,7 @@ using namespace std;
 
 */
 
-map<string, bool> RustInstVisitor::gFunctionSymbolTable;
+thread_local map<string, bool> RustInstVisitor::gFunctionSymbolTable;
 
 dsp_factory_base* RustCodeContainer::produceFactory()
 {
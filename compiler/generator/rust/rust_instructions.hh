@@ -80,7 +80,7 @@ class RustInstVisitor : public TextInstVisitor {
      Global functions names table as a static variable in the visitor
      so that each function prototype is generated as most once in the module.
      */
-    static std::map<std::string, bool> gFunctionSymbolTable;
+    static thread_local std::map<std::string, bool> gFunctionSymbolTable;
     std::map<std::string, std::string> fMathLibTable;
     // Integer wrapping operators
     std::map<int, std::string> fWrappingOpTable;
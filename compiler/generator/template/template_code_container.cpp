@@ -28,7 +28,7 @@
 
 using namespace std;
 
-map<string, bool> TemplateInstVisitor::gFunctionSymbolTable;
+thread_local map<string, bool> TemplateInstVisitor::gFunctionSymbolTable;
 
 dsp_factory_base* TemplateCodeContainer::produceFactory()
 {
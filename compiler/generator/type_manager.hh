@@ -117,7 +117,7 @@ class CStringTypeManager : public StringTypeManager {
             std::stringstream error;
             error << "WARNING : -fx-size ('" << max_width << "' less than needed '" << msb << "')"
                   << std::endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
             res = std::min(31, max_width);
         } else {
             res = msb;
@@ -131,6 +131,13 @@ class CStringTypeManager : public StringTypeManager {
         return res;
     }
 
+    // Vector types are defined in the -simd prelude as 'faustvec<size>_<type>'
+    std::string generateVectorType(VectorTyped* vector_typed)
+    {
+        return "faustvec" + std::to_string(vector_typed->fSize) + "_" +
+               fTypeDirectTable[vector_typed->fType->fType];
+    }
+
     virtual std::string generateType(Typed* type, NamedTyped::Attribute attr = NamedTyped::kDefault)
     {
         BasicTyped*  basic_typed  = dynamic_cast<BasicTyped*>(type);
@@ -138,6 +145,7 @@ class CStringTypeManager : public StringTypeManager {
         FixedTyped*  fx_typed     = dynamic_cast<FixedTyped*>(type);
         ArrayTyped*  array_typed  = dynamic_cast<ArrayTyped*>(type);
         StructTyped* struct_typed = dynamic_cast<StructTyped*>(type);
+        VectorTyped* vector_typed = dynamic_cast<VectorTyped*>(type);
 
         // fx_typed is a subclass of basic_typed, so has to be tested first
         if (fx_typed) {
@@ -181,6 +189,8 @@ class CStringTypeManager : public StringTypeManager {
             }
             res += "} " + struct_typed->fName + ";";
             return res;
+        } else if (vector_typed) {
+            return generateVectorType(vector_typed);
         } else {
             faustassert(false);
             return "";
@@ -192,7 +202,8 @@ class CStringTypeManager : public StringTypeManager {
         BasicTyped* basic_typed = dynamic_cast<BasicTyped*>(type);
         NamedTyped* named_typed = dynamic_cast<NamedTyped*>(type);
         FixedTyped* fx_typed    = dynamic_cast<FixedTyped*>(type);
-        ArrayTyped* array_typed = dynamic_cast<ArrayTyped*>(type);
+        ArrayTyped*  array_typed  = dynamic_cast<ArrayTyped*>(type);
+        VectorTyped* vector_typed = dynamic_cast<VectorTyped*>(type);
 
         // fx_typed is a subclass of basic_typed, so has to be tested first
         if (fx_typed) {
@@ -228,6 +239,8 @@ class CStringTypeManager : public StringTypeManager {
                        ? generateType(array_typed->fType) + fPtrRef + " " + name
                        : generateType(array_typed->fType) + " " + name + "[" +
                              std::to_string(array_typed->fSize) + "]";
+        } else if (vector_typed) {
+            return generateVectorType(vector_typed) + " " + name;
         } else {
             faustassert(false);
             return "";
@@ -25,9 +25,11 @@
 #include <iomanip>
 
 #include "binop.hh"
+#include "fir_simd.hh"
 #include "struct_manager.hh"
 #include "text_instructions.hh"
 #include "typing_instructions.hh"
+#include "wasm_binary.hh"
 
 #define offStrNum ((gGlobal->gFloatSize == 1) ? 2 : ((gGlobal->gFloatSize == 2) ? 3 : 0))
 #define audioPtrSize gGlobal->audioSampleSize()
@@ -67,6 +69,12 @@ inline int genMemSize(int struct_size, int channels, int json_len)
         1);
 }
 
+// Vector types of the explicit SIMD code (-simd option)
+inline bool isV128Type(Typed::VarType type)
+{
+    return (type == Typed::kFloat_vec || type == Typed::kDouble_vec || type == Typed::kInt32_vec);
+}
+
 // To check if the DSP struct has soundfiles
 struct CheckSoundfilesVisitor : public DispatchVisitor {
     bool fHasSoundfiles = false;
@@ -116,8 +124,29 @@ struct WASInst {
         int            fArgs;
     };
 
+    // Description of the vector helpers generated by SIMDVectorizer
+    struct SIMDFunDesc {
+        enum Gen {
+            kLoad,   // Load at the address given by the first argument
+            kStore,  // Store of the second argument at the address given by the first one
+            kOp      // Operation on the arguments
+        };
+
+        SIMDFunDesc() {}
+
+        SIMDFunDesc(Gen gen, const std::string& name, BinaryConsts::SIMDOp op)
+            : fGen(gen), fName(name), fWasmOp(op)
+        {
+        }
+
+        Gen                  fGen;
+        std::string          fName;
+        BinaryConsts::SIMDOp fWasmOp;
+    };
+
     std::map<std::string, bool>        fFunctionSymbolTable;  // Already generated functions
     std::map<std::string, MathFunDesc> fMathLibTable;  // Table : field_name, math description
+    std::map<std::string, SIMDFunDesc> fSIMDLibTable;  // Table : helper name, SIMD description
     std::map<std::string, MemoryDesc>  fFieldTable;    // Table : field_name, { offset, size, type }
 
     // To generate tee_local the first time the variable access is compiled, then local.get will be
@@ -275,11 +304,91 @@ struct WASInst {
         fMathLibTable["copysign"] =
             MathFunDesc(MathFunDesc::Gen::kExtWAS, "copysign", Typed::kDouble, Typed::kDouble, 2);
 
+        // Vector helpers, with 128 bits vectors
+        if (gGlobal->gSIMDLanes > 0) {
+            initSIMDLibTable(gGlobal->gSIMDLanes);
+        }
+
         fStructOffset     = 0;
         fSubContainerType = -1;
         fFastMemory       = fast_memory;
     }
 
+    void addSIMDFun(int lanes, const std::string& model, Typed::VarType type,
+                    SIMDFunDesc::Gen gen, const std::string& name, BinaryConsts::SIMDOp op)
+    {
+        fSIMDLibTable[getSIMDHelper(lanes, model, type)] = SIMDFunDesc(gen, name, op);
+    }
+
+    // Audio buffers have the internal real type, so FAUSTFLOAT accesses are simple ones
+    void initSIMDLibTable(int lanes)
+    {
+        using namespace BinaryConsts;
+        SIMDFunDesc::Gen op = SIMDFunDesc::kOp;
+
+        if (gGlobal->gFloatSize == 1) {
+            Typed::VarType real = Typed::kFloat;
+            addSIMDFun(lanes, "load_$0", real, SIMDFunDesc::kLoad, "v128.load", V128Load);
+            addSIMDFun(lanes, "store_$0", real, SIMDFunDesc::kStore, "v128.store", V128Store);
+            addSIMDFun(lanes, "load_faustfloat_to_$0", real, SIMDFunDesc::kLoad, "v128.load",
+                       V128Load);
+            addSIMDFun(lanes, "store_$0_to_faustfloat", real, SIMDFunDesc::kStore, "v128.store",
+                       V128Store);
+            addSIMDFun(lanes, "set_$0", real, op, "f32x4.splat", F32x4Splat);
+            addSIMDFun(lanes, "add_$0", real, op, "f32x4.add", F32x4Add);
+            addSIMDFun(lanes, "sub_$0", real, op, "f32x4.sub", F32x4Sub);
+            addSIMDFun(lanes, "mul_$0", real, op, "f32x4.mul", F32x4Mul);
+            addSIMDFun(lanes, "div_$0", real, op, "f32x4.div", F32x4Div);
+            addSIMDFun(lanes, "neg_$0", real, op, "f32x4.neg", F32x4Neg);
+            addSIMDFun(lanes, "abs_$0", real, op, "f32x4.abs", F32x4Abs);
+            addSIMDFun(lanes, "sqrt_$0", real, op, "f32x4.sqrt", F32x4Sqrt);
+            addSIMDFun(lanes, "min_$0", real, op, "f32x4.min", F32x4Min);
+            addSIMDFun(lanes, "max_$0", real, op, "f32x4.max", F32x4Max);
+            addSIMDFun(lanes, "floor_$0", real, op, "f32x4.floor", F32x4Floor);
+            addSIMDFun(lanes, "ceil_$0", real, op, "f32x4.ceil", F32x4Ceil);
+            addSIMDFun(lanes, "nearest_$0", real, op, "f32x4.nearest", F32x4Nearest);
+            addSIMDFun(lanes, "int_to_$0", real, op, "f32x4.convert_i32x4_s", F32x4ConvertI32x4S);
+            addSIMDFun(lanes, "$0_to_int", real, op, "i32x4.trunc_sat_f32x4_s",
+                       I32x4TruncSatF32x4S);
+
+            // Integer vectors have the same number of lanes
+            Typed::VarType integer = Typed::kInt32;
+            addSIMDFun(lanes, "load_$0", integer, SIMDFunDesc::kLoad, "v128.load", V128Load);
+            addSIMDFun(lanes, "store_$0", integer, SIMDFunDesc::kStore, "v128.store", V128Store);
+            addSIMDFun(lanes, "set_$0", integer, op, "i32x4.splat", I32x4Splat);
+            addSIMDFun(lanes, "add_$0", integer, op, "i32x4.add", I32x4Add);
+            addSIMDFun(lanes, "sub_$0", integer, op, "i32x4.sub", I32x4Sub);
+            addSIMDFun(lanes, "mul_$0", integer, op, "i32x4.mul", I32x4Mul);
+            addSIMDFun(lanes, "neg_$0", integer, op, "i32x4.neg", I32x4Neg);
+            addSIMDFun(lanes, "and_$0", integer, op, "v128.and", V128And);
+            addSIMDFun(lanes, "or_$0", integer, op, "v128.or", V128Or);
+            addSIMDFun(lanes, "xor_$0", integer, op, "v128.xor", V128Xor);
+            addSIMDFun(lanes, "shl_$0", integer, op, "i32x4.shl", I32x4Shl);
+            addSIMDFun(lanes, "shr_$0", integer, op, "i32x4.shr_s", I32x4ShrS);
+        } else {
+            Typed::VarType real = Typed::kDouble;
+            addSIMDFun(lanes, "load_$0", real, SIMDFunDesc::kLoad, "v128.load", V128Load);
+            addSIMDFun(lanes, "store_$0", real, SIMDFunDesc::kStore, "v128.store", V128Store);
+            addSIMDFun(lanes, "load_faustfloat_to_$0", real, SIMDFunDesc::kLoad, "v128.load",
+                       V128Load);
+            addSIMDFun(lanes, "store_$0_to_faustfloat", real, SIMDFunDesc::kStore, "v128.store",
+                       V128Store);
+            addSIMDFun(lanes, "set_$0", real, op, "f64x2.splat", F64x2Splat);
+            addSIMDFun(lanes, "add_$0", real, op, "f64x2.add", F64x2Add);
+            addSIMDFun(lanes, "sub_$0", real, op, "f64x2.sub", F64x2Sub);
+            addSIMDFun(lanes, "mul_$0", real, op, "f64x2.mul", F64x2Mul);
+            addSIMDFun(lanes, "div_$0", real, op, "f64x2.div", F64x2Div);
+            addSIMDFun(lanes, "neg_$0", real, op, "f64x2.neg", F64x2Neg);
+            addSIMDFun(lanes, "abs_$0", real, op, "f64x2.abs", F64x2Abs);
+            addSIMDFun(lanes, "sqrt_$0", real, op, "f64x2.sqrt", F64x2Sqrt);
+            addSIMDFun(lanes, "min_$0", real, op, "f64x2.min", F64x2Min);
+            addSIMDFun(lanes, "max_$0", real, op, "f64x2.max", F64x2Max);
+            addSIMDFun(lanes, "floor_$0", real, op, "f64x2.floor", F64x2Floor);
+            addSIMDFun(lanes, "ceil_$0", real, op, "f64x2.ceil", F64x2Ceil);
+            addSIMDFun(lanes, "nearest_$0", real, op, "f64x2.nearest", F64x2Nearest);
+        }
+    }
+
     void setSubContainerType(int type) { fSubContainerType = type; }
     int  getSubContainerType() { return fSubContainerType; }
 
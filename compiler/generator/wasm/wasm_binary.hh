@@ -167,6 +167,8 @@ enum EncodedType {
     i64 = -0x2,  // 0x7e
     f32 = -0x3,  // 0x7d
     f64 = -0x4,  // 0x7c
+    // SIMD proposal
+    v128 = -0x5,  // 0x7b
     // elem_type
     AnyFunc = -0x10,  // 0x70
     // func_type form
@@ -270,7 +272,60 @@ enum ASTNodes {
     I32ReinterpretF32 = 0xbc,
     I64ReinterpretF64 = 0xbd,
     F32ReinterpretI32 = 0xbe,
-    F64ReinterpretI64 = 0xbf
+    F64ReinterpretI64 = 0xbf,
+
+    // SIMD proposal, followed by a SIMDOp
+    SIMDPrefix = 0xfd
+};
+
+enum SIMDOp {
+    V128Load  = 0x00,
+    V128Store = 0x0b,
+
+    I32x4Splat = 0x11,
+    F32x4Splat = 0x13,
+    F64x2Splat = 0x14,
+
+    V128And = 0x4e,
+    V128Or  = 0x50,
+    V128Xor = 0x51,
+
+    F32x4Ceil    = 0x67,
+    F32x4Floor   = 0x68,
+    F32x4Nearest = 0x6a,
+    F64x2Ceil    = 0x74,
+    F64x2Floor   = 0x75,
+    F64x2Nearest = 0x94,
+
+    I32x4Neg  = 0xa1,
+    I32x4Shl  = 0xab,
+    I32x4ShrS = 0xac,
+    I32x4Add  = 0xae,
+    I32x4Sub  = 0xb1,
+    I32x4Mul  = 0xb5,
+
+    F32x4Abs  = 0xe0,
+    F32x4Neg  = 0xe1,
+    F32x4Sqrt = 0xe3,
+    F32x4Add  = 0xe4,
+    F32x4Sub  = 0xe5,
+    F32x4Mul  = 0xe6,
+    F32x4Div  = 0xe7,
+    F32x4Min  = 0xe8,
+    F32x4Max  = 0xe9,
+
+    F64x2Abs  = 0xec,
+    F64x2Neg  = 0xed,
+    F64x2Sqrt = 0xef,
+    F64x2Add  = 0xf0,
+    F64x2Sub  = 0xf1,
+    F64x2Mul  = 0xf2,
+    F64x2Div  = 0xf3,
+    F64x2Min  = 0xf4,
+    F64x2Max  = 0xf5,
+
+    I32x4TruncSatF32x4S = 0xf8,
+    F32x4ConvertI32x4S  = 0xfa
 };
 
 enum MemoryAccess {
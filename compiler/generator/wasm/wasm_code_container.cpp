@@ -50,8 +50,10 @@ using namespace std;
  module code generation.
  - in Load/Store, check if address is constant, so that to be used as an 'offset'
  - move loop 'i' variable by bytes instead of frames to save index code generation of input/output
- accesses (gLoopVarInBytes)
+ accesses (gLoopVarInBytes), in scalar mode only
  - offset of inputs/outputs are constant, so can be directly generated
+ - in -vec mode, the vectorizable loops can use v128 instructions with -simd 4 (or -simd 2 with
+ -double), see SIMDVectorizer
 
  Code generation, the flags can be:
  - 'wasm-i' (internal memory for monophonic DSP)
@@ -443,6 +445,12 @@ WASMVectorCodeContainer::WASMVectorCodeContainer(const string& name, int numInpu
 
 void WASMVectorCodeContainer::generateCompute()
 {
+    // Possibly generates explicit SIMD code with 128 bits vectors
+    if (gGlobal->gSIMDLanes > 0) {
+        SIMDVectorizer vectorizer(gGlobal->gSIMDLanes, true, true, 16);
+        fDAGBlock = vectorizer.getCode(fDAGBlock);
+    }
+
     // Rename all loop variables name to avoid name clash
     LoopVariableRenamer loop_renamer;
     generateComputeAux(loop_renamer.getCode(fDAGBlock));
@@ -557,7 +557,7 @@ LIBFAUST_API vector<string> wasm_dsp_factory::getIncludePathnames()
 
 LIBFAUST_API vector<string> wasm_dsp_factory::getWarningMessages()
 {
-    return gWarningMessages;
+    return (fFactory) ? fFactory->getWarningMessages() : vector<string>();
 }
 
 LIBFAUST_API void wasm_dsp_factory::setMemoryManager(dsp_memory_manager* manager)
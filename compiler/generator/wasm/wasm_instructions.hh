@@ -278,6 +278,8 @@ inline S32LEB type2Binary(Typed::VarType type)
         return S32LEB(BinaryConsts::EncodedType::f32);
     } else if (type == Typed::kDouble) {
         return S32LEB(BinaryConsts::EncodedType::f64);
+    } else if (isV128Type(type)) {
+        return S32LEB(BinaryConsts::EncodedType::v128);
     } else {
         faustassert(false);
         return S32LEB(BinaryConsts::EncodedType::Empty);
@@ -304,12 +306,15 @@ struct LocalVariableCounter : public DispatchVisitor {
     int fIn32Type;
     int fF32Type;
     int fF64Type;
+    int fV128Type;
 
     int fFunArgIndex;
 
     std::map<std::string, LocalVarDesc> fLocalVarTable;
 
-    LocalVariableCounter() : fIn32Type(0), fF32Type(0), fF64Type(0), fFunArgIndex(0) {}
+    LocalVariableCounter() : fIn32Type(0), fF32Type(0), fF64Type(0), fV128Type(0), fFunArgIndex(0)
+    {
+    }
 
     virtual void visit(DeclareVarInst* inst)
     {
@@ -327,6 +332,8 @@ struct LocalVariableCounter : public DispatchVisitor {
                 fLocalVarTable[name] = LocalVarDesc(fF32Type++, type, access);
             } else if (type == Typed::kDouble) {
                 fLocalVarTable[name] = LocalVarDesc(fF64Type++, type, access);
+            } else if (isV128Type(type)) {
+                fLocalVarTable[name] = LocalVarDesc(fV128Type++, type, access);
             } else {
                 faustassert(false);
             }
@@ -361,13 +368,17 @@ struct LocalVariableCounter : public DispatchVisitor {
                     var.second.fIndex = var.second.fIndex + fFunArgIndex + fIn32Type;
                 } else if (var.second.fType == Typed::kDouble) {
                     var.second.fIndex = var.second.fIndex + fFunArgIndex + fIn32Type + fF32Type;
+                } else if (isV128Type(var.second.fType)) {
+                    var.second.fIndex =
+                        var.second.fIndex + fFunArgIndex + fIn32Type + fF32Type + fF64Type;
                 } else {
                     faustassert(false);
                 }
             }
         }
 
-        *out << U32LEB((fIn32Type ? 1 : 0) + (fF32Type ? 1 : 0) + (fF64Type ? 1 : 0));
+        *out << U32LEB((fIn32Type ? 1 : 0) + (fF32Type ? 1 : 0) + (fF64Type ? 1 : 0) +
+                       (fV128Type ? 1 : 0));
         if (fIn32Type) {
             *out << U32LEB(fIn32Type) << S32LEB(BinaryConsts::EncodedType::i32);
         }
@@ -377,6 +388,9 @@ struct LocalVariableCounter : public DispatchVisitor {
         if (fF64Type) {
             *out << U32LEB(fF64Type) << S32LEB(BinaryConsts::EncodedType::f64);
         }
+        if (fV128Type) {
+            *out << U32LEB(fV128Type) << S32LEB(BinaryConsts::EncodedType::v128);
+        }
     }
 
     void dump()
@@ -1339,9 +1353,32 @@ class WASMInstVisitor : public DispatchVisitor, public WASInst {
         }
     }
 
+    // Vector helpers : load/store first argument is the address of the accessed array
+    void generateSIMDCall(FunCallInst* inst)
+    {
+        SIMDFunDesc desc = fSIMDLibTable[inst->fName];
+        for (const auto& it : inst->fArgs) {
+            LoadVarAddressInst* address = dynamic_cast<LoadVarAddressInst*>(it);
+            if (address) {
+                address->fAddress->accept(this);
+            } else {
+                it->accept(this);
+            }
+        }
+        *fOut << int8_t(BinaryConsts::SIMDPrefix) << U32LEB(desc.fWasmOp);
+        if (desc.fGen != SIMDFunDesc::kOp) {
+            generateMemoryAccess();
+        }
+    }
+
     // Generate standard funcall (not 'method' like funcall...)
     virtual void visit(FunCallInst* inst)
     {
+        if (fSIMDLibTable.find(inst->fName) != fSIMDLibTable.end()) {
+            generateSIMDCall(inst);
+            return;
+        }
+
         // Compile args first
         for (const auto& it : inst->fArgs) {
             it->accept(this);
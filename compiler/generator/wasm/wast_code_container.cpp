@@ -47,8 +47,10 @@ computed when inlining subcontainers and waveform. The final memory size is fina
 module code generation.
  - in Load/Store, check if address is constant, so that to be used as an 'offset'
  - move loop 'i' variable by bytes instead of frames to save index code generation of input/output
-accesses (gLoopVarInBytes)
+accesses (gLoopVarInBytes), in scalar mode only
  - offset of inputs/outputs are constant, so can be directly generated
+ - in -vec mode, the vectorizable loops can use v128 instructions with -simd 4 (or -simd 2 with
+ -double), see SIMDVectorizer
 
  Code generation, the flags can be:
  - 'wast-i' (internal memory for monophonic DSP)
@@ -482,6 +484,12 @@ void WASTVectorCodeContainer::generateCompute(int n)
 {
     generateComputeAux1(n);
 
+    // Possibly generates explicit SIMD code with 128 bits vectors
+    if (gGlobal->gSIMDLanes > 0) {
+        SIMDVectorizer vectorizer(gGlobal->gSIMDLanes, true, true, 16);
+        fDAGBlock = vectorizer.getCode(fDAGBlock);
+    }
+
     // Rename all loop variables name to avoid name clash
     LoopVariableRenamer loop_renamer;
     generateComputeAux2(loop_renamer.getCode(fDAGBlock), n);
@@ -38,6 +38,8 @@ class WASTInstVisitor : public TextInstVisitor, public WASInst {
             return "f32";
         } else if (type == Typed::kDouble) {
             return "f64";
+        } else if (isV128Type(type)) {
+            return "v128";
         } else {
             faustassert(false);
             return "";
@@ -617,9 +619,31 @@ class WASTInstVisitor : public TextInstVisitor, public WASInst {
         }
     }
 
+    // Vector helpers : load/store first argument is the address of the accessed array
+    void generateSIMDCall(FunCallInst* inst)
+    {
+        SIMDFunDesc desc = fSIMDLibTable[inst->fName];
+        *fOut << "(" << desc.fName;
+        for (const auto& it : inst->fArgs) {
+            LoadVarAddressInst* address = dynamic_cast<LoadVarAddressInst*>(it);
+            *fOut << " ";
+            if (address) {
+                address->fAddress->accept(this);
+            } else {
+                it->accept(this);
+            }
+        }
+        *fOut << ")";
+    }
+
     // Generate standard funcall (not 'method' like funcall...)
     virtual void visit(FunCallInst* inst)
     {
+        if (fSIMDLibTable.find(inst->fName) != fSIMDLibTable.end()) {
+            generateSIMDCall(inst);
+            return;
+        }
+
         if (fMathLibTable.find(inst->fName) != fMathLibTable.end()) {
             MathFunDesc desc = fMathLibTable[inst->fName];
             if (desc.fMathMode == MathFunDesc::Gen::kWAS) {
@@ -54,6 +54,7 @@
 #include "tanprim.hh"
 #include "timing.hh"
 #include "tree.hh"
+#include "TMutex.h"
 
 #ifdef WIN32
 #pragma warning(disable : 4996)
@@ -122,17 +123,45 @@ using namespace std;
 #define AP_INT_MAX_W 1024
 #endif
 
-// Globals for flex/bison parser
-extern FILE*       FAUSTin;
-extern const char* FAUSTfilename;
+// The locale is a process wide state: the "C" locale is set by the first living
+// compilation context, and the previous one restored by the last one
+static TLockAble gLocaleLock;
+static int       gLocaleCount  = 0;
+static char*     gCurrentLocal = nullptr;
 
-// Garbageable globals
-list<Garbageable*> global::gObjectTable;
-bool               global::gHeapCleanup = false;
+static void setCLocale()
+{
+    TLock lock(&gLocaleLock);
+    if (gLocaleCount++ == 0) {
+        gCurrentLocal = setlocale(LC_ALL, NULL);
+        if (gCurrentLocal != NULL) {
+            gCurrentLocal = strdup(gCurrentLocal);
+        }
+        // Setup standard "C" local
+        // (workaround for a bug in bitcode generation :
+        // http://lists.cs.uiuc.edu/pipermail/llvmbugs/2012-May/023530.html)
+        setlocale(LC_ALL, "C");
+    }
+}
+
+static void restoreLocale()
+{
+    TLock lock(&gLocaleLock);
+    if (--gLocaleCount == 0) {
+        setlocale(LC_ALL, gCurrentLocal);
+        free(gCurrentLocal);
+        gCurrentLocal = nullptr;
+    }
+}
 
 global::global()
     : TABBER(1), gLoopDetector(1024, 400), gStackOverflowDetector(MAX_STACK_SIZE), gNextFreeColor(1)
 {
+    // The context is installed for the calling thread before any Garbageable allocation
+    gGlobal        = this;
+    gFloatNames    = nullptr;
+    gPhaseProfiler = nullptr;
+
     CTree::init();
     Symbol::init();
 
@@ -433,6 +462,7 @@ void global::reset()
     gDeepFirstSwitch   = false;
     gVecSize           = 32;
     gVectorLoopVariant = 0;
+    gSIMDLanes         = 0;
 
     gOpenMPSwitch    = false;
     gOpenMPLoop      = false;
@@ -495,6 +525,7 @@ void global::reset()
     gOneSampleControl     = false;
     gExtControl           = false;
     gInlineTable          = false;
+    gFIROptimize          = -1;
     gComputeMix           = false;
     gBool2Int             = false;
     gFastMathLib          = "";
@@ -522,6 +553,8 @@ void global::reset()
     gCountInferences = 0;
     gCountMaximal    = 0;
 
+    gRecTypeCurrentRank = INT_MAX;
+
     gDummyInput = 10000;
 
     gBoxSlotNumber = 0;
@@ -657,22 +690,13 @@ void global::init()
 
     PROPAGATEPROPERTY = symbol("PropagateProperty");
 
-    // FAUSTfilename is defined in errormsg.cpp but must be redefined at each compilation.
-    FAUSTfilename = "";
-    FAUSTin       = nullptr;
+    // FAUSTfilename and FAUSTin (flex/bison globals) are redefined by the SourceReader at each
+    // parse, under the parser lock, since they are shared by all compilation contexts.
 
     gLatexheaderfilename = "latexheader.tex";
     gDocTextsDefaultFile = "mathdoctexts-default.txt";
 
-    gCurrentLocal = setlocale(LC_ALL, NULL);
-    if (gCurrentLocal != NULL) {
-        gCurrentLocal = strdup(gCurrentLocal);
-    }
-
-    // Setup standard "C" local
-    // (workaround for a bug in bitcode generation :
-    // http://lists.cs.uiuc.edu/pipermail/llvmbugs/2012-May/023530.html)
-    setlocale(LC_ALL, "C");
+    setCLocale();
 
     // Source file injection
     gInjectFlag = false;  // inject an external source file into the architecture file
@@ -799,6 +823,9 @@ void global::printCompilationOptions(stringstream& dst, bool backend)
     if (gInlineTable) {
         dst << "-it ";
     }
+    if (gFIROptimize == 1) {
+        dst << "-fo ";
+    }
     if (gRangeUI) {
         dst << "-rui ";
     }
@@ -863,7 +890,9 @@ void global::printCompilationOptions(stringstream& dst, bool backend)
     if (gVectorSwitch) {
         dst << "-vec "
             << "-lv " << gVectorLoopVariant << " "
-            << "-vs " << gVecSize << " " << ((gFunTaskSwitch) ? "-fun " : "")
+            << "-vs " << gVecSize << " "
+            << ((gSIMDLanes > 0) ? "-simd " + std::to_string(gSIMDLanes) + " " : "")
+            << ((gFunTaskSwitch) ? "-fun " : "")
             << ((gGroupTaskSwitch) ? "-g " : "") << ((gDeepFirstSwitch) ? "-dfs " : "");
     }
 
@@ -988,11 +1017,14 @@ Typed::VarType global::getVarType(const string& name)
 
 global::~global()
 {
+    if (gPhaseProfiler) {
+        closePhaseProfiler(gPhaseProfiler);
+    }
     Garbageable::cleanup();
     BasicTyped::cleanup();
     DeclareVarInst::cleanup();
-    setlocale(LC_ALL, gCurrentLocal);
-    free(gCurrentLocal);
+    delete gFloatNames;
+    restoreLocale();
 
     // Cleanup
 #ifdef C_BUILD
@@ -1103,7 +1135,7 @@ bool global::isOpt(const string& opt_val)
  *****************************************************************/
 
 // Timing can be used outside of the scope of 'gGlobal'
-extern bool gTimingSwitch;
+extern thread_local bool gTimingSwitch;
 
 static bool isCmd(const char* cmd, const char* kw1)
 {
@@ -1115,6 +1147,16 @@ static bool isCmd(const char* cmd, const char* kw1, const char* kw2)
     return (strcmp(cmd, kw1) == 0) || (strcmp(cmd, kw2) == 0);
 }
 
+bool global::isAllWarning(int argc, const char* argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (isCmd(argv[i], "-wall", "--warning-all")) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool global::processCmdline(int argc, const char* argv[])
 {
     int          i   = 1;
@@ -1315,6 +1357,10 @@ bool global::processCmdline(int argc, const char* argv[])
             gVectorLoopVariant = std::atoi(argv[i + 1]);
             i += 2;
 
+        } else if (isCmd(argv[i], "-simd", "--simd-lanes") && (i + 1 < argc)) {
+            gSIMDLanes = std::atoi(argv[i + 1]);
+            i += 2;
+
         } else if (isCmd(argv[i], "-omp", "--openmp")) {
             gOpenMPSwitch = true;
             i += 1;
@@ -1355,6 +1401,16 @@ bool global::processCmdline(int argc, const char* argv[])
             gTimingSwitch = true;
             i += 1;
 
+        } else if (isCmd(argv[i], "-time-json", "--compilation-time-json") && (i + 1 < argc)) {
+            delete gPhaseProfiler;
+            gPhaseProfiler = new PhaseProfiler(argv[i + 1], false);
+            i += 2;
+
+        } else if (isCmd(argv[i], "-time-trace", "--compilation-time-trace") && (i + 1 < argc)) {
+            delete gPhaseProfiler;
+            gPhaseProfiler = new PhaseProfiler(argv[i + 1], true);
+            i += 2;
+
             // 'real' options
         } else if (isCmd(argv[i], "-single", "--single-precision-floats")) {
             if (float_size && gFloatSize != 1) {
@@ -1465,6 +1521,14 @@ bool global::processCmdline(int argc, const char* argv[])
             gInlineTable = true;
             i += 1;
 
+        } else if (isCmd(argv[i], "-fo", "--fir-optimize")) {
+            gFIROptimize = 1;
+            i += 1;
+
+        } else if (isCmd(argv[i], "-nfo", "--no-fir-optimize")) {
+            gFIROptimize = 0;
+            i += 1;
+
         } else if (isCmd(argv[i], "-cm", "--compute-mix")) {
             gComputeMix = true;
             i += 1;
@@ -1540,6 +1604,10 @@ bool global::processCmdline(int argc, const char* argv[])
             gLibraryList.push_back(argv[i + 1]);
             i += 2;
 
+        } else if (isCmd(argv[i], "-lib-snapshot", "--library-snapshot") && (i + 1 < argc)) {
+            gLibrarySnapshot = argv[i + 1];
+            i += 2;
+
         } else if (isCmd(argv[i], "-O", "--output-dir") && (i + 1 < argc)) {
             char  temp[PATH_MAX + 1];
             char* path = realpath(argv[i + 1], temp);
@@ -1672,6 +1740,34 @@ bool global::processCmdline(int argc, const char* argv[])
         throw faustexception(error.str());
     }
 
+    if (gSIMDLanes != 0) {
+        if (!gVectorSwitch || gOpenMPSwitch || gSchedulerSwitch) {
+            throw faustexception("ERROR : '-simd' option can only be used in '-vec' mode\n");
+        }
+        bool is_wasm = startWith(gOutputLang, "wasm") || startWith(gOutputLang, "wast");
+        if (gOutputLang != "c" && gOutputLang != "cpp" && gOutputLang != "llvm" && !is_wasm) {
+            throw faustexception(
+                "ERROR : '-simd' option can only be used with 'c', 'cpp', 'llvm', 'wasm' or "
+                "'wast' backends\n");
+        }
+        if (is_wasm && gSIMDLanes * ((gFloatSize == 2) ? 8 : 4) != 16) {
+            throw faustexception(
+                "ERROR : '-simd' option with 'wasm' or 'wast' backends needs 128 bits vectors "
+                "(-simd 4 with -single, -simd 2 with -double)\n");
+        }
+        if (gSIMDLanes < 2 || (gSIMDLanes & (gSIMDLanes - 1)) != 0 ||
+            gVecSize % gSIMDLanes != 0) {
+            stringstream error;
+            error << "ERROR : invalid number of SIMD lanes [-simd = " << gSIMDLanes
+                  << "] should be a power of 2 dividing the vector size" << endl;
+            throw faustexception(error.str());
+        }
+        if (gFloatSize > 2) {
+            throw faustexception(
+                "ERROR : '-simd' option can only be used with float or double\n");
+        }
+    }
+
     if (gFunTaskSwitch) {
         if (!(gOutputLang == "c" || gOutputLang == "cpp" || gOutputLang == "llvm" ||
               gOutputLang == "fir")) {
@@ -2068,6 +2164,14 @@ string global::printHelp()
          << endl;
     sstr << tab << "-L <file> --library <file>              link with the LLVM module <file>."
          << endl;
+    sstr << tab
+         << "-lib-snapshot <file> --library-snapshot <file> load the parsed libraries from the "
+            "snapshot <file> when unchanged, and update it."
+         << endl;
+    sstr << tab
+         << "-server [-socket <file>] --compile-server   run as a resident compile server, "
+            "reading requests on stdin or on the Unix socket <file> (must be the first option)."
+         << endl;
 #endif
 #ifndef EMCC
     sstr << endl << "Output options:" << line;
@@ -2158,6 +2262,15 @@ string global::printHelp()
     sstr << tab
          << "-it         --inline-table              inline rdtable/rwtable code in the main class."
          << endl;
+    sstr << tab
+         << "-fo         --fir-optimize              common subexpression elimination, loop invariant "
+            "code motion and dead store elimination in the DSP loop (scalar mode only, by default "
+            "in -lang interp and jsfx)."
+         << endl;
+    sstr << tab
+         << "-nfo        --no-fir-optimize           deactivate -fo in the backends using it by "
+            "default."
+         << endl;
     sstr << tab << "-cm         --compute-mix               mix in outputs buffers." << endl;
     sstr << tab
          << "-ct         --check-table               check rtable/rwtable index range and generate "
@@ -2258,6 +2371,11 @@ string global::printHelp()
             "loop (default), "
             "1:simple, variable vector size, 2:fixed, fixed vector size]."
          << endl;
+    sstr << tab
+         << "-simd <n>   --simd-lanes <n>            generate explicit SIMD code with <n> lanes for "
+            "the vectorizable loops in --vectorize mode ('c', 'cpp', 'llvm', 'wasm' and 'wast' "
+            "backends)."
+         << endl;
     sstr << tab
          << "-omp        --openmp                    generate OpenMP pragmas, activates "
             "--vectorize option."
@@ -2390,6 +2508,14 @@ string global::printHelp()
     sstr << tab
          << "-time       --compilation-time          display compilation phases timing information."
          << endl;
+    sstr << tab
+         << "-time-json <file> --compilation-time-json <file>  write compilation phases statistics "
+            "(time, memory, trees, hash-consing, properties) in JSON format in <file>."
+         << endl;
+    sstr << tab
+         << "-time-trace <file> --compilation-time-trace <file> write compilation phases in Chrome "
+            "trace format in <file>."
+         << endl;
     sstr << tab
          << "-flist      --file-list                 print file list (including libraries) used to "
             "eval process."
@@ -2533,82 +2659,71 @@ void global::clear()
     gSignalTrace.clear();
 }
 
-// Memory management
+// Memory management: objects are allocated in the arena of the compilation context of the
+// calling thread, and all released at once by 'cleanup' (see garbageable.cpp)
 void Garbageable::cleanup()
 {
-    list<Garbageable*>::iterator it;
-
-    // Here removing the deleted pointer from the list is pointless
-    // and takes time, thus we don't do it.
-    global::gHeapCleanup = true;
-    for (it = global::gObjectTable.begin(); it != global::gObjectTable.end(); it++) {
-#ifdef _WIN32
-        // Hack : "this" and actual pointer are not the same: destructor cannot be called...
-        Garbageable::operator delete(*it);
-#else
-        delete (*it);
-#endif
-    }
-
-    // Reset to default state
-    global::gObjectTable.clear();
-    global::gHeapCleanup = false;
+    gGlobal->gArena.cleanup();
 }
 
 void* Garbageable::operator new(size_t size)
 {
-    // HACK : add 16 bytes to avoid unsolved memory smashing bug...
-    Garbageable* res = (Garbageable*)malloc(size + 16);
-    global::gObjectTable.push_front(res);
-    return res;
+    return (gGlobal) ? gGlobal->gArena.allocate(size) : GarbageableArena::allocateNoContext(size);
 }
 
 void Garbageable::operator delete(void* ptr)
 {
     // We may have cases when a pointer will be deleted during
-    // a compilation, thus the pointer has to be removed from the list.
-    if (!global::gHeapCleanup) {
-        global::gObjectTable.remove(static_cast<Garbageable*>(ptr));
-    }
-    free(ptr);
+    // a compilation, thus the block is returned to its arena.
+    GarbageableArena::releaseAny(ptr);
 }
 
 void* Garbageable::operator new[](size_t size)
 {
-    // HACK : add 16 bytes to avoid unsolved memory smashing bug...
-    Garbageable* res = (Garbageable*)malloc(size + 16);
-    global::gObjectTable.push_front(res);
-    return res;
+    return (gGlobal) ? gGlobal->gArena.allocate(size) : GarbageableArena::allocateNoContext(size);
 }
 
 void Garbageable::operator delete[](void* ptr)
 {
-    // We may have cases when a pointer will be deleted during
-    // a compilation, thus the pointer has to be removed from the list.
-    if (!global::gHeapCleanup) {
-        global::gObjectTable.remove(static_cast<Garbageable*>(ptr));
-    }
-    free(ptr);
+    GarbageableArena::releaseAny(ptr);
 }
 
 // Threaded calls API
+
+// The spawned thread runs in the compilation context of the calling thread
+struct ThreadedCall {
+    threaded_fun fFun;
+    void*        fArg;
+    global*      fGlobal;
+};
+
+static void* threadedCall(void* arg)
+{
+    ThreadedCall* call = static_cast<ThreadedCall*>(arg);
+    gGlobal            = call->fGlobal;
+    return call->fFun(call->fArg);
+}
+
 void callFun(threaded_fun fun, void* arg)
 {
 #if defined(EMCC)
     // No thread support in JavaScript
     fun(arg);
 #elif defined(_WIN32)
-    DWORD  id;
-    HANDLE thread = CreateThread(NULL, MAX_STACK_SIZE, LPTHREAD_START_ROUTINE(fun), arg, 0, &id);
+    ThreadedCall call = {fun, arg, gGlobal};
+    DWORD        id;
+    HANDLE       thread =
+        CreateThread(NULL, MAX_STACK_SIZE, LPTHREAD_START_ROUTINE(threadedCall), &call, 0, &id);
     faustassert(thread != NULL);
     WaitForSingleObject(thread, INFINITE);
 #else
+    ThreadedCall   call = {fun, arg, gGlobal};
     pthread_t      thread;
     pthread_attr_t attr;
     faustassert(pthread_attr_init(&attr) == 0);
     faustassert(pthread_attr_setstacksize(&attr, MAX_STACK_SIZE) == 0);
     faustassert(pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE) == 0);
-    faustassert(pthread_create(&thread, &attr, fun, arg) == 0);
+    faustassert(pthread_create(&thread, &attr, threadedCall, &call) == 0);
     faustassert(pthread_join(thread, nullptr) == 0);
     faustassert(pthread_attr_destroy(&attr) == 0);
 #endif
@@ -76,6 +76,9 @@ struct dsp_factory_base;
 struct ControlArray;
 struct ZoneArray;
 
+struct FloatNames;
+class PhaseProfiler;
+
 struct comp_str {
     bool operator()(Tree s1, Tree s2) const { return (strcmp(tree2str(s1), tree2str(s2)) < 0); }
 };
@@ -83,10 +86,6 @@ struct comp_str {
 typedef std::map<Tree, std::set<Tree>, comp_str> MetaDataSet;
 typedef std::map<Tree, std::set<Tree>>           FunMDSet;  // foo -> {(file/foo/key,value)...}
 
-// Global outside of the global context
-extern std::vector<std::string> gWarningMessages;
-extern bool                     gAllWarning;
-
 // Global singleton like compiler state
 struct global {
     // Parsing
@@ -115,6 +114,7 @@ struct global {
     std::vector<std::string> gArchitectureDirList;  // dir list enrobage.cpp/fopensearch() searches
                                                     // for architecture files
     std::vector<std::string> gLibraryList;
+    std::string              gLibrarySnapshot;  // Parsed libraries snapshot file (-lib-snapshot)
     std::string              gOutputDir;
     std::string              gImportFilename;
     std::string              gOutputFile;
@@ -155,6 +155,7 @@ struct global {
     bool gDeepFirstSwitch;    // -dfs option
     int  gVecSize;            // -vs option
     int  gVectorLoopVariant;  // -lv [0|1] option
+    int  gSIMDLanes;          // -simd option
     bool gOpenMPSwitch;       // -omp option
     bool gOpenMPLoop;         // -pl option
     bool gSchedulerSwitch;    // -sch option
@@ -231,6 +232,8 @@ struct global {
     int  gExtControl;        // separated 'control' and 'compute' functions
     bool gInlineTable;  // -it option, only in -cpp backend, to inline rdtable/rwtable code in the
                         // main class.
+    int  gFIROptimize;  // -fo/-nfo options, FIR level optimizations of the DSP loop (CSE, loop
+                        // invariant code motion, dead stores), -1 for the backend default
     bool        gComputeMix;         // -cm option, mix in outputs buffers
     bool        gBool2Int;           // Cast bool binary operations (comparison operations) to int
     std::string gNamespace;          // Wrapping namespace used with the C++ backend
@@ -279,6 +282,10 @@ struct global {
     std::string gErrorMessage;
     Tabber      TABBER;
 
+    // Warnings, given to the factory at the end of the compilation
+    std::vector<std::string> gWarningMessages;
+    bool                     gAllWarning;
+
     // ------------
     // boxppShared
     // ------------
@@ -304,6 +311,11 @@ struct global {
     int gCountMaximal;
     int gAllocationCount;  // Internal signal types counter
 
+    // Recursive groups ordering used by typeAnnotation (indexed by tree serial)
+    std::vector<int>  gRecTypeRank;   // SCC rank of the recursive groups a signal depends on
+    std::vector<char> gRecTypeFinal;  // Signal whose type cannot change anymore in the current pass
+    int               gRecTypeCurrentRank;  // Rank of the SCC being typed
+
     // Used in propagation
     int gDummyInput;
 
@@ -615,9 +627,21 @@ struct global {
 
     int gTimeout;  // Time out to abort compiler (in seconds)
 
-    // Garbage collection
-    static std::list<Garbageable*> gObjectTable;
-    static bool                    gHeapCleanup;
+    PhaseProfiler* gPhaseProfiler;  // Compilation phases recorder (-time-json or -time-trace)
+
+    // Garbageable objects allocator, private to each compilation context
+    GarbageableArena gArena;
+
+    // Hash-consing tables, private to each compilation context (see tlib/tree.cpp and
+    // tlib/symbol.cpp)
+    TreeHashTable                       gTreeTable;
+    size_t                              gTreeSerialCounter;
+    unsigned int                        gTreeVisitTime;
+    Symbol*                             gSymbolTable[Symbol::kHashTableSize];
+    std::map<const char*, unsigned int> gSymbolPrefixCounters;
+
+    // Float size dependent names (see generator/floats.cpp)
+    FloatNames* gFloatNames;
 
     ZoneArray* gIntZone;   // array of 'int32' intermediate zone values
     ZoneArray* gRealZone;  // array of 'real' intermediate zone values
@@ -687,6 +711,9 @@ struct global {
     static bool isOpt(const std::string& debug_val);
 
     bool processCmdline(int argc, const char* argv[]);
+
+    // Whether warnings are printed, usable outside of the scope of 'gGlobal'
+    static bool isAllWarning(int argc, const char* argv[]);
     void initDocumentNames();
     void initDirectories(int argc, const char* argv[]);
     void printDeclareHeader(std::ostream& dst);
@@ -704,8 +731,9 @@ struct global {
     void printDirectories();
 };
 
-// Unique shared global pointer
-extern global* gGlobal;
+// Compilation context of the calling thread: several contexts can live in separated threads,
+// 'callFun' propagates the caller context in the spawned thread
+extern thread_local global* gGlobal;
 
 #define FAUST_LIB_PATH "FAUST_LIB_PATH"
 #define MAX_MACHINE_STACK_SIZE 65536 * 16
@@ -713,7 +741,7 @@ extern global* gGlobal;
 
 #define MAX_ERROR_SIZE 192
 
-// Threaded calls API
+// Threaded calls API: 'fun' is executed in the compilation context of the calling thread
 typedef void* (*threaded_fun)(void* arg);
 void callFun(threaded_fun fun, void* arg);
 
@@ -144,24 +144,27 @@ using namespace std;
  Global context
  *****************************************************************/
 
-// File handling
-static unique_ptr<ifstream> gEnrobage;
-static unique_ptr<ostream>  gHelpers;
-static unique_ptr<ostream>  gDst;
-static string               gOutpath;
-static bool                 gUseCout = false;
+// File handling (one per compilation thread)
+static thread_local unique_ptr<ifstream> gEnrobage;
+static thread_local unique_ptr<ostream>  gHelpers;
+static thread_local unique_ptr<ostream>  gDst;
+static thread_local string               gOutpath;
+static thread_local bool                 gUseCout = false;
 
 // Old CPP compiler
 #ifdef OCPP_BUILD
-static Compiler* gOldComp = nullptr;
+static thread_local Compiler* gOldComp = nullptr;
 #endif
 
 // FIR container
-static InstructionsCompiler* gNewComp   = nullptr;
-static CodeContainer*        gContainer = nullptr;
+static thread_local InstructionsCompiler* gNewComp   = nullptr;
+static thread_local CodeContainer*        gContainer = nullptr;
 
-// Shared compilation context
-global* gGlobal = nullptr;
+// Compilation context of the calling thread
+thread_local global* gGlobal = nullptr;
+
+// Timing can be used outside of the scope of 'gGlobal'
+extern thread_local bool gTimingSwitch;
 
 string reorganizeCompilationOptions(int argc, const char* argv[]);
 
@@ -403,6 +406,10 @@ static void compileInterp(Tree signals, int numInputs, int numOutputs)
     gGlobal->gNeedManualPow =
         false;  // Standard pow function will be used in pow(x,y) when y in an integer
     gGlobal->gUseDefaultSound = false;
+    // No downstream optimizer: CSE, loop invariant code motion and dead stores done on FIR
+    if (gGlobal->gFIROptimize == -1) {
+        gGlobal->gFIROptimize = 1;
+    }
 
     if (gGlobal->gVectorSwitch) {
         gGlobal->gRemoveVarAddress = true;
@@ -620,6 +627,10 @@ static void compileJSFX(Tree signals, int numInputs, int numOutputs, ostream* ou
     gGlobal->gFAUSTFLOAT2Internal  = true;
     // JSFX actually uses the in "inplace" model
     gGlobal->gInPlace = true;
+    // No downstream optimizer: CSE, loop invariant code motion and dead stores done on FIR
+    if (gGlobal->gFIROptimize == -1) {
+        gGlobal->gFIROptimize = 1;
+    }
     gContainer =
         JSFXCodeContainer::createContainer(gGlobal->gClassName, numInputs, numOutputs, out);
 
@@ -756,7 +767,7 @@ static void compileWAST(Tree signals, int numInputs, int numOutputs, ostream* ou
     // FIR is generated with internal real instead of FAUSTFLOAT (see IB::genBasicTyped)
     gGlobal->gFAUSTFLOAT2Internal = true;
     // the 'i' variable used in the scalar loop moves by bytes instead of frames
-    gGlobal->gLoopVarInBytes = true;
+    gGlobal->gLoopVarInBytes = !gGlobal->gVectorSwitch;
     gGlobal->gWaveformInDSP  = true;  // waveform are allocated in the DSP and not as global data
     gGlobal->gMachinePtrSize = 4;     // WASM is currently 32 bits
     gGlobal->gNeedManualPow =
@@ -773,7 +784,8 @@ static void compileWAST(Tree signals, int numInputs, int numOutputs, ostream* ou
     createHelperFile(outpath);
 
     if (gGlobal->gVectorSwitch) {
-        gNewComp = new DAGInstructionsCompiler(gContainer);
+        gGlobal->gRemoveVarAddress = true;
+        gNewComp                   = new DAGInstructionsCompiler(gContainer);
     } else {
         gNewComp = new InstructionsCompiler(gContainer);
     }
@@ -798,7 +810,7 @@ static void compileWASM(Tree signals, int numInputs, int numOutputs, ostream* ou
     // FIR is generated with internal real instead of FAUSTFLOAT (see IB::genBasicTyped)
     gGlobal->gFAUSTFLOAT2Internal = true;
     // the 'i' variable used in the scalar loop moves by bytes instead of frames
-    gGlobal->gLoopVarInBytes = true;
+    gGlobal->gLoopVarInBytes = !gGlobal->gVectorSwitch;
     gGlobal->gWaveformInDSP  = true;  // waveform are allocated in the DSP and not as global data
     gGlobal->gMachinePtrSize = 4;     // WASM is currently 32 bits
     gGlobal->gNeedManualPow =
@@ -1106,6 +1118,10 @@ static void generateCode(Tree signals, int numInputs, int numOutputs, bool gener
     }
 
     endTiming("generateCode");
+
+    if (gTimingSwitch) {
+        gGlobal->gTreeTable.printStats(cerr);
+    }
 }
 
 static void generateOutputFiles()
@@ -1451,7 +1467,8 @@ static void* createFactoryAux2(void* arg)
 // ============
 
 dsp_factory_base* createFactory(const string& name_app, const string& dsp_content, int argc,
-                                const char* argv[], string& error_msg, bool generate)
+                                const char* argv[], string& error_msg, bool generate,
+                                vector<string>* library_files)
 {
     gGlobal = nullptr;
     global::allocate();
@@ -1466,6 +1483,12 @@ dsp_factory_base* createFactory(const string& name_app, const string& dsp_conten
     callFun(createFactoryAux1, &context);
     dsp_factory_base* factory = gGlobal->gDSPFactory;
     error_msg                 = gGlobal->gErrorMessage;
+    if (factory) {
+        factory->setWarningMessages(gGlobal->gWarningMessages);
+    }
+    if (library_files) {
+        *library_files = gGlobal->gReader.listLibraryFiles();
+    }
 
     global::destroy();
     return factory;
@@ -1485,6 +1508,9 @@ dsp_factory_base* createFactory(const string& name_app, tvec signals, int argc,
     context.fGenerate   = true;
     callFun(createFactoryAux2, &context);
     error_msg = gGlobal->gErrorMessage;
+    if (gGlobal->gDSPFactory) {
+        gGlobal->gDSPFactory->setWarningMessages(gGlobal->gWarningMessages);
+    }
     return gGlobal->gDSPFactory;
 }
 
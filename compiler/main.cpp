@@ -29,6 +29,7 @@ unsigned faust_alarm(unsigned seconds)
 
 #include <iostream>
 #include "compatibility.hh"
+#include "compile_server.hh"
 #include "dsp_factory.hh"
 #include "global.hh"
 
@@ -42,13 +43,18 @@ unsigned faust_alarm(unsigned seconds)
 
 int main(int argc, const char* argv[])
 {
+    // Resident compile server
+    if (argc > 1 && (string(argv[1]) == "-server" || string(argv[1]) == "--compile-server")) {
+        return compileServerMain(argc, argv);
+    }
+
     string            error_msg;
     dsp_factory_base* factory = createFactory("FaustDSP", "", argc, argv, error_msg, true);
 
     // Possibly print warnings
     if (factory) {
         vector<string> warnings = factory->getWarningMessages();
-        if (gAllWarning && warnings.size() > 0) {
+        if (global::isAllWarning(argc, argv) && warnings.size() > 0) {
             set<string> warnings_set;
             for (const auto& it : warnings) {
                 warnings_set.insert(it);
@@ -147,7 +147,9 @@ LIBFAUST_API Tree simplifyToNormalForm(Tree sig)
     if (isList(sig)) {
         Tree t2 = sig->getProperty(gGlobal->NORMALFORM);
         if (!t2) {
+            startTiming("normalization");
             t2 = simplifyToNormalFormAux(sig);
+            endTiming("normalization");
             sig->setProperty(gGlobal->NORMALFORM, t2);
         }
         return t2;
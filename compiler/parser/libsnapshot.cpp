@@ -0,0 +1,505 @@
+/************************************************************************
+ ************************************************************************
+  FAUST compiler
+  Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+  ---------------------------------------------------------------------
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation; either version 2.1 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "boxes.hh"
+#include "faust/export.h"
+#include "global.hh"
+#include "libsnapshot.hh"
+
+using namespace std;
+
+/*
+ Snapshot layout (native byte order, checked with a byte order mark):
+
+    "FAUSTLIB" <format version> <byte order mark> <compiler version> <entry count>
+    entries : <key> <size> <content>
+
+ Entry content:
+
+    <sha1>
+    <string count> strings
+    <node count> nodes : <kind> <arity> <value> <branch indexes>  (branches always come first)
+    <root index>
+    <metadata count> (key index, value index)
+    <definition line count> (identifier index, value index)
+
+ Strings are prefixed by their size as a uint32_t.
+*/
+
+#define SNAPSHOT_MAGIC "FAUSTLIB"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_BYTE_ORDER 0x01020304
+
+enum SnapshotNodeKind { kSnapInt, kSnapInt64, kSnapDouble, kSnapSym, kSnapBuiltin };
+
+struct SnapshotWriter {
+    string fOut;
+
+    template <typename T>
+    void write(T v)
+    {
+        fOut.append(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+    void writeString(const string& s)
+    {
+        write<uint32_t>(uint32_t(s.size()));
+        fOut.append(s);
+    }
+};
+
+// Bounds checked reader, 'fOK' is false as soon as the content is found to be truncated
+struct SnapshotReader {
+    const char* fCur;
+    const char* fEnd;
+    bool        fOK;
+
+    SnapshotReader(const char* data, size_t size) : fCur(data), fEnd(data + size), fOK(true) {}
+
+    template <typename T>
+    T read()
+    {
+        T v = T();
+        if (size_t(fEnd - fCur) < sizeof(T)) {
+            fOK = false;
+        } else {
+            memcpy(&v, fCur, sizeof(T));
+            fCur += sizeof(T);
+        }
+        return v;
+    }
+    string readString()
+    {
+        uint32_t size = read<uint32_t>();
+        if (!fOK || size_t(fEnd - fCur) < size) {
+            fOK = false;
+            return "";
+        }
+        string s(fCur, size);
+        fCur += size;
+        return s;
+    }
+    // Check that 'index' is a valid index in a table of 'size' elements
+    bool check(uint32_t index, size_t size)
+    {
+        fOK = fOK && (index < size);
+        return fOK;
+    }
+};
+
+static string entryKey(const string& fname, const string& fullpath)
+{
+    return fname + "\n" + fullpath;
+}
+
+// The snapshot shared by the successive compilations of a compile server
+static LibrarySnapshot* gResidentSnapshot = nullptr;
+
+LibrarySnapshot::LibrarySnapshot(const string& path) : fPath(path), fData(nullptr), fSize(0)
+{
+    if (fPath != "") open();
+}
+
+LibrarySnapshot::~LibrarySnapshot()
+{
+    unmap();
+}
+
+void LibrarySnapshot::setResident(LibrarySnapshot* snapshot)
+{
+    gResidentSnapshot = snapshot;
+}
+
+LibrarySnapshot* LibrarySnapshot::getResident()
+{
+    return gResidentSnapshot;
+}
+
+void LibrarySnapshot::reset()
+{
+    // The builtin trees belong to the previous compilation context
+    fBuiltins.clear();
+    fBuiltinIndex.clear();
+}
+
+void LibrarySnapshot::unmap()
+{
+#ifndef _WIN32
+    if (fData && fBuffer.empty()) {
+        munmap((void*)fData, fSize);
+    }
+#endif
+    fData = nullptr;
+    fSize = 0;
+}
+
+void LibrarySnapshot::open()
+{
+#ifndef _WIN32
+    int fd = ::open(fPath.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* data = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            fData = static_cast<const char*>(data);
+            fSize = size_t(st.st_size);
+        }
+    }
+    close(fd);
+#else
+    ifstream file(fPath.c_str(), ifstream::binary);
+    if (!file.is_open()) return;
+    stringstream content;
+    content << file.rdbuf();
+    fBuffer = content.str();
+    fData   = fBuffer.data();
+    fSize   = fBuffer.size();
+#endif
+    index();
+}
+
+void LibrarySnapshot::index()
+{
+    fEntries.clear();
+    if (!fData) return;
+
+    // Index the entries, a snapshot written by another version of the compiler is ignored
+    SnapshotReader in(fData, fSize);
+    char           magic[8];
+    for (size_t i = 0; i < sizeof(magic); i++) {
+        magic[i] = in.read<char>();
+    }
+    if (!in.fOK || memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 ||
+        in.read<uint32_t>() != SNAPSHOT_VERSION || in.read<uint32_t>() != SNAPSHOT_BYTE_ORDER ||
+        in.readString() != FAUSTVERSION) {
+        return;
+    }
+    uint32_t count = in.read<uint32_t>();
+    for (uint32_t i = 0; i < count && in.fOK; i++) {
+        string   key  = in.readString();
+        uint64_t size = in.read<uint64_t>();
+        if (!in.fOK || uint64_t(in.fEnd - in.fCur) < size) {
+            fEntries.clear();
+            return;
+        }
+        fEntries[key] = make_pair(size_t(in.fCur - fData), size_t(size));
+        in.fCur += size;
+    }
+}
+
+// The primitive boxes built with a C function pointer, that have to be found again by index
+void LibrarySnapshot::initBuiltins()
+{
+    if (fBuiltins.size() > 0) return;
+    Tree builtins[] = {boxAdd(),         boxSub(),           boxMul(),          boxDiv(),
+                       boxRem(),         boxAND(),           boxOR(),           boxXOR(),
+                       boxLeftShift(),   boxLRightShift(),   boxARightShift(),  boxLT(),
+                       boxGT(),          boxGE(),            boxLE(),           boxEQ(),
+                       boxNE(),          boxDelay(),         boxDelay1(),       boxPrefix(),
+                       boxIntCast(),     boxFloatCast(),     boxReadOnlyTable(), boxWriteReadTable(),
+                       boxSelect2(),     boxSelect3(),       boxAssertBound(),  boxLowest(),
+                       boxHighest(),     boxAttach(),        boxEnable(),       boxControl()};
+    for (Tree b : builtins) {
+        // The function pointer is kept in the first branch
+        fBuiltinIndex[b->branch(0)] = (unsigned int)fBuiltins.size();
+        fBuiltins.push_back(b->branch(0));
+    }
+}
+
+/**
+ * Add the nodes of 't' not already in 'index' to 'order', branches first.
+ * Returns false if a node cannot be serialized (like an unknown pointer).
+ */
+static bool collectNodes(Tree t, map<Tree, uint32_t>& index, vector<Tree>& order,
+                         const map<Tree, unsigned int>& builtins)
+{
+    // Iterative post-order traversal, since definition lists can be very long
+    vector<pair<Tree, int> > stack;
+    if (index.find(t) == index.end()) stack.push_back(make_pair(t, 0));
+    while (!stack.empty()) {
+        Tree cur = stack.back().first;
+        int  i   = stack.back().second;
+        if (i < cur->arity()) {
+            stack.back().second++;
+            Tree b = cur->branch(i);
+            if (index.find(b) == index.end()) stack.push_back(make_pair(b, 0));
+        } else {
+            stack.pop_back();
+            if (index.find(cur) != index.end()) continue;  // Already reached by another path
+            if (cur->node().type() == kPointerNode && builtins.find(cur) == builtins.end()) {
+                return false;
+            }
+            index[cur] = uint32_t(order.size());
+            order.push_back(cur);
+        }
+    }
+    return true;
+}
+
+bool LibrarySnapshot::load(const string& fname, const string& fullpath, const string& sha1,
+                           Tree& ldef)
+{
+    auto it = fEntries.find(entryKey(fname, fullpath));
+    if (it == fEntries.end()) return false;
+
+    SnapshotReader in(fData + it->second.first, it->second.second);
+    if (in.readString() != sha1) return false;
+    initBuiltins();
+
+    vector<string> strings(in.read<uint32_t>());
+    for (size_t i = 0; i < strings.size() && in.fOK; i++) {
+        strings[i] = in.readString();
+    }
+
+    uint32_t     count = in.read<uint32_t>();
+    vector<Tree> nodes;
+    nodes.reserve(count);
+    for (uint32_t i = 0; i < count && in.fOK; i++) {
+        uint8_t  kind  = in.read<uint8_t>();
+        uint32_t arity = in.read<uint32_t>();
+        Node     n;
+        if (kind == kSnapInt) {
+            n = Node(int(in.read<int32_t>()));
+        } else if (kind == kSnapInt64) {
+            n = Node(int64_t(in.read<int64_t>()));
+        } else if (kind == kSnapDouble) {
+            n = Node(in.read<double>());
+        } else if (kind == kSnapSym) {
+            uint32_t s = in.read<uint32_t>();
+            if (!in.check(s, strings.size())) break;
+            n = Node(symbol(strings[s]));
+        } else if (kind == kSnapBuiltin) {
+            uint32_t b = in.read<uint32_t>();
+            if (!in.check(b, fBuiltins.size()) || arity != 0) break;
+            nodes.push_back(fBuiltins[b]);
+            continue;
+        } else {
+            in.fOK = false;
+            break;
+        }
+        tvec branches(arity);
+        for (uint32_t j = 0; j < arity && in.fOK; j++) {
+            uint32_t b = in.read<uint32_t>();
+            if (in.check(b, nodes.size())) branches[j] = nodes[b];
+        }
+        if (!in.fOK) break;
+        nodes.push_back(tree(n, branches));
+    }
+
+    uint32_t root = in.read<uint32_t>();
+    in.check(root, nodes.size());
+
+    vector<pair<Tree, Tree> > metadata(in.read<uint32_t>());
+    for (size_t i = 0; i < metadata.size() && in.fOK; i++) {
+        uint32_t k = in.read<uint32_t>();
+        uint32_t v = in.read<uint32_t>();
+        if (in.check(k, nodes.size()) && in.check(v, nodes.size())) {
+            metadata[i] = make_pair(nodes[k], nodes[v]);
+        }
+    }
+    vector<pair<Tree, Tree> > deflines(in.read<uint32_t>());
+    for (size_t i = 0; i < deflines.size() && in.fOK; i++) {
+        uint32_t d = in.read<uint32_t>();
+        uint32_t v = in.read<uint32_t>();
+        if (in.check(d, nodes.size()) && in.check(v, nodes.size())) {
+            deflines[i] = make_pair(nodes[d], nodes[v]);
+        }
+    }
+    if (!in.fOK) return false;
+
+    // Restore the side effects of the parser
+    for (const auto& m : metadata) {
+        gGlobal->gMetaDataSet[m.first].insert(m.second);
+    }
+    for (const auto& d : deflines) {
+        setProperty(d.first, gGlobal->DEFLINEPROP, d.second);
+    }
+    ldef = nodes[root];
+    return true;
+}
+
+void LibrarySnapshot::record(const string& fname, const string& fullpath, const string& sha1,
+                             Tree ldef, const vector<pair<Tree, Tree> >& metadata)
+{
+    initBuiltins();
+
+    map<Tree, uint32_t> index;
+    vector<Tree>        order;
+    if (!collectNodes(ldef, index, order, fBuiltinIndex)) return;
+    Tree root = ldef;
+
+    // Definition line properties set by the parser while reading this file
+    vector<pair<Tree, Tree> > deflines;
+    Tree                      file = tree(fname.c_str());
+    for (size_t i = 0, size = order.size(); i < size; i++) {
+        Tree v;
+        if (getProperty(order[i], gGlobal->DEFLINEPROP, v) && hd(v) == file) {
+            deflines.push_back(make_pair(order[i], v));
+        }
+    }
+    for (const auto& d : deflines) {
+        if (!collectNodes(d.second, index, order, fBuiltinIndex)) return;
+    }
+    for (const auto& m : metadata) {
+        if (!collectNodes(m.first, index, order, fBuiltinIndex) ||
+            !collectNodes(m.second, index, order, fBuiltinIndex)) {
+            return;
+        }
+    }
+
+    // Symbol names
+    map<Sym, uint32_t> strings;
+    vector<Sym>        symbols;
+    for (Tree t : order) {
+        if (t->node().type() == kSymNode && strings.find(t->node().getSym()) == strings.end()) {
+            strings[t->node().getSym()] = uint32_t(symbols.size());
+            symbols.push_back(t->node().getSym());
+        }
+    }
+
+    SnapshotWriter out;
+    out.writeString(sha1);
+    out.write<uint32_t>(uint32_t(symbols.size()));
+    for (Sym s : symbols) {
+        out.writeString(name(s));
+    }
+    out.write<uint32_t>(uint32_t(order.size()));
+    for (Tree t : order) {
+        const Node& n = t->node();
+        switch (n.type()) {
+            case kIntNode:
+                out.write<uint8_t>(kSnapInt);
+                out.write<uint32_t>(t->arity());
+                out.write<int32_t>(n.getInt());
+                break;
+            case kInt64Node:
+                out.write<uint8_t>(kSnapInt64);
+                out.write<uint32_t>(t->arity());
+                out.write<int64_t>(n.getInt64());
+                break;
+            case kDoubleNode:
+                out.write<uint8_t>(kSnapDouble);
+                out.write<uint32_t>(t->arity());
+                out.write<double>(n.getDouble());
+                break;
+            case kSymNode:
+                out.write<uint8_t>(kSnapSym);
+                out.write<uint32_t>(t->arity());
+                out.write<uint32_t>(strings[n.getSym()]);
+                break;
+            case kPointerNode:
+                out.write<uint8_t>(kSnapBuiltin);
+                out.write<uint32_t>(0);
+                out.write<uint32_t>(fBuiltinIndex[t]);
+                break;
+        }
+        for (int i = 0; i < t->arity(); i++) {
+            out.write<uint32_t>(index[t->branch(i)]);
+        }
+    }
+    out.write<uint32_t>(index[root]);
+    out.write<uint32_t>(uint32_t(metadata.size()));
+    for (const auto& m : metadata) {
+        out.write<uint32_t>(index[m.first]);
+        out.write<uint32_t>(index[m.second]);
+    }
+    out.write<uint32_t>(uint32_t(deflines.size()));
+    for (const auto& d : deflines) {
+        out.write<uint32_t>(index[d.first]);
+        out.write<uint32_t>(index[d.second]);
+    }
+
+    fNewEntries[entryKey(fname, fullpath)] = out.fOut;
+}
+
+void LibrarySnapshot::save()
+{
+    if (fNewEntries.empty()) return;
+
+    // Keep the previous entries that have not been replaced
+    size_t count = fNewEntries.size();
+    for (const auto& e : fEntries) {
+        if (fNewEntries.find(e.first) == fNewEntries.end()) count++;
+    }
+
+    SnapshotWriter out;
+    out.fOut.append(SNAPSHOT_MAGIC, 8);
+    out.write<uint32_t>(SNAPSHOT_VERSION);
+    out.write<uint32_t>(SNAPSHOT_BYTE_ORDER);
+    out.writeString(FAUSTVERSION);
+    out.write<uint32_t>(uint32_t(count));
+    for (const auto& e : fEntries) {
+        if (fNewEntries.find(e.first) == fNewEntries.end()) {
+            out.writeString(e.first);
+            out.write<uint64_t>(e.second.second);
+            out.fOut.append(fData + e.second.first, e.second.second);
+        }
+    }
+    for (const auto& e : fNewEntries) {
+        out.writeString(e.first);
+        out.write<uint64_t>(e.second.size());
+        out.fOut.append(e.second);
+    }
+    fNewEntries.clear();
+
+    // Keep the new content to be used by the next compilations of a compile server
+    unmap();
+    fBuffer = out.fOut;
+    fData   = fBuffer.data();
+    fSize   = fBuffer.size();
+    index();
+    if (fPath == "") return;
+
+    // Write in a temporary file then rename it, so that concurrent compilations never read a
+    // partial snapshot
+    stringstream tmp_path;
+    tmp_path << fPath << ".tmp." << getpid() << "." << hash<thread::id>()(this_thread::get_id());
+    {
+        ofstream tmp(tmp_path.str().c_str(), ofstream::binary);
+        if (!tmp.is_open()) return;
+        tmp.write(out.fOut.data(), out.fOut.size());
+        if (!tmp.good()) {
+            tmp.close();
+            remove(tmp_path.str().c_str());
+            return;
+        }
+    }
+    if (rename(tmp_path.str().c_str(), fPath.c_str()) != 0) {
+        remove(tmp_path.str().c_str());
+    }
+}
@@ -0,0 +1,93 @@
+/************************************************************************
+ ************************************************************************
+  FAUST compiler
+  Copyright (C) 2003-2018 GRAME, Centre National de Creation Musicale
+  ---------------------------------------------------------------------
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation; either version 2.1 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ ************************************************************************
+ ************************************************************************/
+
+#ifndef __LIBSNAPSHOT__
+#define __LIBSNAPSHOT__
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tree.hh"
+
+/**
+ * Binary snapshot of parsed library files (-lib-snapshot option).
+ *
+ * Each library file is recorded with the SHA1 of its content, its list of definitions as a flat
+ * table of tree nodes, the global metadata it declares and the definition line properties of its
+ * identifiers. A recorded file whose content is unchanged is then rebuilt from the memory-mapped
+ * snapshot without running the flex/bison parser. The snapshot is rewritten when new or modified
+ * files have been parsed, keeping the entries of the files not used by the current compilation.
+ *
+ * A compile server keeps a resident snapshot (possibly not backed by a file) shared by its
+ * successive compilations, so that library files are only parsed once for the server lifetime.
+ */
+class LibrarySnapshot
+{
+
+    private:
+
+        std::string fPath;
+        const char* fData;      // Snapshot content (memory-mapped when possible)
+        size_t fSize;
+        std::string fBuffer;    // Snapshot content when it cannot be memory-mapped
+
+        std::map<std::string, std::pair<size_t, size_t> > fEntries;  // Entry key -> offset and size in fData
+        std::map<std::string, std::string> fNewEntries;              // Entries to be written by 'save'
+
+        std::vector<Tree> fBuiltins;            // Trees holding the primitive function pointers
+        std::map<Tree, unsigned int> fBuiltinIndex;
+
+        void open();
+        void unmap();
+        void index();
+        void initBuiltins();
+
+    public:
+
+        // An empty path gives a snapshot only kept in memory
+        LibrarySnapshot(const std::string& path);
+        virtual ~LibrarySnapshot();
+
+        // The snapshot used instead of the -lib-snapshot option by all compilations (or nullptr)
+        static void setResident(LibrarySnapshot* snapshot);
+        static LibrarySnapshot* getResident();
+
+        // To be called when the snapshot is used in a new compilation context
+        void reset();
+
+        /**
+         * Rebuild the definitions of a library file if it has been recorded with the same content,
+         * also restoring the global metadata it declares.
+         */
+        bool load(const std::string& fname, const std::string& fullpath, const std::string& sha1, Tree& ldef);
+
+        // Record the definitions of a parsed library file, and the global metadata it has declared
+        void record(const std::string& fname, const std::string& fullpath, const std::string& sha1, Tree ldef,
+                    const std::vector<std::pair<Tree, Tree> >& metadata);
+
+        // Write the snapshot if new files have been recorded, and keep the new content in memory
+        void save();
+
+};
+
+#endif
@@ -41,12 +41,15 @@
 
 #include "compatibility.hh"
 #include "sourcereader.hh"
+#include "libsnapshot.hh"
+#include "libfaust.h"
 #include "sourcefetcher.hh"
 #include "enrobage.hh"
 #include "ppbox.hh"
 #include "exception.hh"
 #include "global.hh"
 #include "Text.hh"
+#include "TMutex.h"
 
 using namespace std;
 
@@ -65,6 +68,9 @@ extern FILE* FAUSTin;
 extern int FAUSTlineno;
 extern const char* FAUSTfilename;
 
+// The parser globals are shared by all compilation contexts, so parsing is serialized
+static TLockAble gParserLock;
+
 /**
  * Checks an argument list for containing only
  * standard identifiers, no patterns and
@@ -309,6 +315,15 @@ Tree SourceReader::parseString(const char* fname)
     return parseLocal(fname);
 }
 
+Tree SourceReader::parseContent(const char* fname, const string& fullpath, const string& content)
+{
+    FAUSTerr = 0;
+    FAUSTlineno = 1;
+    FAUSTfilename = fname;
+    FAUST_scan_string(content.c_str());
+    return parseLocal(fullpath.c_str());
+}
+
 Tree SourceReader::parseLocal(const char* fname)
 {
     int r = FAUSTparse();
@@ -331,6 +346,36 @@ Tree SourceReader::parseLocal(const char* fname)
     return gGlobal->gResult;
 }
 
+SourceReader::~SourceReader()
+{
+    saveSnapshot();
+    if (fOwnSnapshot) delete fSnapshot;
+}
+
+void SourceReader::init()
+{
+    fFileCache.clear();
+    fFilePathnames.clear();
+    saveSnapshot();
+    if (fOwnSnapshot) delete fSnapshot;
+    if ((fSnapshot = LibrarySnapshot::getResident())) {
+        fOwnSnapshot = false;
+        fSnapshot->reset();
+    } else {
+        fOwnSnapshot = true;
+        fSnapshot = (gGlobal->gLibrarySnapshot != "") ? new LibrarySnapshot(gGlobal->gLibrarySnapshot) : nullptr;
+    }
+}
+
+/**
+ * Write the libraries parsed during the compilation in the snapshot
+ */
+
+void SourceReader::saveSnapshot()
+{
+    if (fSnapshot) fSnapshot->save();
+}
+
 /**
  * Check if a file as been read and is in the "cache"
  *
@@ -353,15 +398,86 @@ bool SourceReader::cached(string fname)
 Tree SourceReader::getList(const char* fname)
 {
 	if (!cached(fname)) {
-        // Previous metadata need to be cleared before parsing a file
-        gGlobal->gFunMDSet.clear();
-        Tree ldef = (gGlobal->gInputString != "") ? parseString(fname) : parseFile(fname);
-        // Definitions with metadata have to be wrapped into a boxMetadata construction
-        fFileCache[fname] = addFunctionMetadata(ldef, gGlobal->gFunMDSet);
+        if (fSnapshot && gGlobal->gInputString == "" && gGlobal->gMasterDocument != fname
+            && !isURL(fname) && !isFILE(fname)) {
+            // Library files go through the snapshot
+            fFileCache[fname] = getSnapshotList(fname);
+        } else {
+            // Previous metadata need to be cleared before parsing a file
+            gGlobal->gFunMDSet.clear();
+            Tree ldef;
+            {
+                // The flex/bison parser is not reentrant
+                TLock lock(&gParserLock);
+                ldef = (gGlobal->gInputString != "") ? parseString(fname) : parseFile(fname);
+            }
+            // Definitions with metadata have to be wrapped into a boxMetadata construction
+            fFileCache[fname] = addFunctionMetadata(ldef, gGlobal->gFunMDSet);
+        }
 	}
     return fFileCache[fname];
 }
 
+/**
+ * Return the list of definitions of a library file, rebuilt from the snapshot
+ * when its content is unchanged, otherwise parsed and recorded in the snapshot.
+ *
+ * @param fname the name of the file to read
+ * @return the list of definitions it contains
+ */
+
+Tree SourceReader::getSnapshotList(const char* fname)
+{
+    string fullpath;
+    FILE* file = fopenSearch(fname, fullpath);
+    if (!file) {
+        stringstream error;
+        error << "ERROR : unable to open file " << fname << endl;
+        throw faustexception(error.str());
+    }
+    string content;
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.append(buffer, size);
+    }
+    fclose(file);
+    string sha1 = generateSHA1(content);
+
+    Tree ldef;
+    if (fSnapshot->load(fname, fullpath, sha1, ldef)) {
+        fFilePathnames.push_back(fullpath);
+        return ldef;
+    }
+
+    // Keep the state modified by the parser to find what the file declares
+    MetaDataSet metadata = gGlobal->gMetaDataSet;
+    size_t docs = gGlobal->gDocVector.size();
+    gGlobal->gFunMDSet.clear();
+    {
+        // The flex/bison parser is not reentrant
+        TLock lock(&gParserLock);
+        ldef = parseContent(fname, fullpath, content);
+    }
+    // Definitions with metadata have to be wrapped into a boxMetadata construction
+    ldef = addFunctionMetadata(ldef, gGlobal->gFunMDSet);
+
+    // Files with <mdoc> sections are not recorded
+    if (gGlobal->gDocVector.size() == docs) {
+        vector<pair<Tree, Tree> > declared;
+        for (const auto& m : gGlobal->gMetaDataSet) {
+            auto prev = metadata.find(m.first);
+            for (const auto& value : m.second) {
+                if (prev == metadata.end() || prev->second.find(value) == prev->second.end()) {
+                    declared.push_back(make_pair(m.first, value));
+                }
+            }
+        }
+        fSnapshot->record(fname, fullpath, sha1, ldef, declared);
+    }
+    return ldef;
+}
+
 /**
  * Return a vector of pathnames representing the list
  * of all the source files that have been required
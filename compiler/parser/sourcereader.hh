@@ -27,6 +27,8 @@
 #include <set>
 #include <vector>
 
+class LibrarySnapshot;
+
 Tree formatDefinitions(Tree rldef);
 Tree checkRulelist (Tree lrules);
 void declareMetadata(Tree key, Tree value);
@@ -43,21 +45,24 @@ class SourceReader
     
         std::map<std::string, Tree> fFileCache;
         std::vector<std::string> fFilePathnames;
+        LibrarySnapshot* fSnapshot = nullptr;  // Parsed libraries snapshot (-lib-snapshot option)
+        bool fOwnSnapshot = false;             // False for the resident snapshot of a compile server
     
         Tree parseLocal(const char* fname);
         Tree expandRec(Tree ldef, std::set<std::string>& visited, Tree lresult);
         bool cached(std::string fname);
         Tree parseFile(const char* fname);
         Tree parseString(const char* fname);
+        Tree parseContent(const char* fname, const std::string& fullpath, const std::string& content);
+        Tree getSnapshotList(const char* fname);
         void checkName();
         
     public:
     
-        void init()
-        {
-            fFileCache.clear();
-            fFilePathnames.clear();
-        }
+        ~SourceReader();
+    
+        void init();
+        void saveSnapshot();
         Tree getList(const char* fname);
         Tree expandList(Tree ldef);
         std::vector<std::string> listSrcFiles();
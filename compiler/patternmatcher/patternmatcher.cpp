@@ -612,7 +612,7 @@ Automaton* make_pattern_matcher(Tree R)
                                   << boxpp(reverse(lhs2)) << " => " << boxpp(rhs2) << ";"
                                   << " previous rule was: " << boxpp(reverse(lhs1)) << " => "
                                   << boxpp(rhs1) << ";" << endl;
-                            gWarningMessages.push_back(error.str());
+                            gGlobal->gWarningMessages.push_back(error.str());
                         } else {
                             stringstream error;
                             error << "ERROR : " << __FILE__ << ":" << __LINE__ << endl;
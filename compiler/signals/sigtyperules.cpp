@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <time.h>
+#include <limits.h>
 #include <algorithm>
 #include <fstream>
 #include <iostream>
@@ -171,10 +172,217 @@ static interval arithmetic(int opcode, const interval& x, const interval& y)
  */
 
 /**
- * Do one step of type inference on the recursive signal groups of a signal
- * The types of the recursive signals are updated to vtype and then vtype is updated to the next
- * step.
+ * Ordering of the recursive signal groups.
  *
+ * Group i depends on group j when the definition of i refers to the recursive signal of j. The
+ * strongly connected components of this dependency graph are typed one after the other, the
+ * components a group depends on being typed first: once a component has converged, the types of
+ * its recursive signals and of all the signals that only depend on already typed components are
+ * final and are not inferred again.
+ *
+ * Every signal reachable from a recursive definition is given the rank of the last component it
+ * depends on (kNoRecRank if it does not depend on any recursive signal) in gRecTypeRank.
+ */
+
+static const int kNoRecRank   = -1;       // Signal not depending on any recursive signal
+static const int kUnknownRank = INT_MAX;  // Signal not reachable from a recursive definition
+
+static int recTypeRank(Tree t)
+{
+    return (t->serial() < gGlobal->gRecTypeRank.size()) ? gGlobal->gRecTypeRank[t->serial()]
+                                                         : kUnknownRank;
+}
+
+static bool isRecSignal(Tree t)
+{
+    Tree var, body;
+    return isRec(t, var, body);
+}
+
+static bool isFinalType(Tree t)
+{
+    return (t->serial() < gGlobal->gRecTypeFinal.size()) && gGlobal->gRecTypeFinal[t->serial()];
+}
+
+static void setFinalType(Tree t)
+{
+    if (t->serial() < gGlobal->gRecTypeFinal.size()) {
+        gGlobal->gRecTypeFinal[t->serial()] = 1;
+    }
+}
+
+/**
+ * Iterative post-order traversal of the signals reachable from roots, not going through recursive
+ * signals. The visitor is called once per signal, after all its branches, and returns the rank
+ * stored for the signal.
+ */
+template <typename Visitor>
+static void rankPostOrder(const vector<Tree>& roots, vector<int>& rank, Visitor visit)
+{
+    vector<pair<Tree, int>> stack;
+    for (Tree root : roots) {
+        if (rank[root->serial()] != kUnknownRank) {
+            continue;
+        }
+        stack.push_back(make_pair(root, 0));
+        while (!stack.empty()) {
+            Tree t = stack.back().first;
+            int  b = stack.back().second;
+            if (!isRecSignal(t) && b < t->arity()) {
+                stack.back().second++;
+                Tree c = t->branch(b);
+                if (rank[c->serial()] == kUnknownRank) {
+                    stack.push_back(make_pair(c, 0));
+                }
+            } else {
+                stack.pop_back();
+                // A signal may have been pushed twice before being ranked
+                if (rank[t->serial()] == kUnknownRank) {
+                    rank[t->serial()] = visit(t);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Compute the strongly connected components of the recursive groups dependency graph (Tarjan),
+ * sorted so that a component only depends on the previous ones, and rank the signals of the
+ * recursive definitions accordingly.
+ *
+ * @param vrec array of all the recursive signal groups
+ * @param vdef definitions of all the recursive signal groups (vector of _lists_)
+ * @param deps filled with the groups each group depends on
+ * @param users filled with the groups depending on each group
+ * @return the components as lists of group indexes
+ */
+static vector<vector<int>> recGroupsComponents(const vector<Tree>& vrec, const vector<Tree>& vdef,
+                                               vector<vector<int>>& deps, vector<vector<int>>& users)
+{
+    const int n = vdef.size();
+
+    map<Tree, int> group;
+    for (int i = 0; i < n; i++) {
+        group[vrec[i]] = i;
+    }
+
+    // Mark the signals reaching a recursive signal (0 : does not, 1 : does)
+    vector<int> reach(gGlobal->gTreeSerialCounter + 1, kUnknownRank);
+    rankPostOrder(vdef, reach, [&reach](Tree t) {
+        if (isRecSignal(t)) {
+            return 1;
+        }
+        for (int b = 0; b < t->arity(); b++) {
+            if (reach[t->branch(b)->serial()] == 1) {
+                return 1;
+            }
+        }
+        return 0;
+    });
+
+    // Collect the recursive signals directly referred to by each definition
+    deps.assign(n, vector<int>());
+    users.assign(n, vector<int>());
+    vector<int>  mark(gGlobal->gTreeSerialCounter + 1, -1);
+    vector<Tree> stack;
+    for (int i = 0; i < n; i++) {
+        stack.push_back(vdef[i]);
+        mark[vdef[i]->serial()] = i;
+        while (!stack.empty()) {
+            Tree t = stack.back();
+            stack.pop_back();
+            if (isRecSignal(t)) {
+                deps[i].push_back(group[t]);
+                users[group[t]].push_back(i);
+                continue;
+            }
+            for (int b = 0; b < t->arity(); b++) {
+                Tree c = t->branch(b);
+                if (reach[c->serial()] == 1 && mark[c->serial()] != i) {
+                    mark[c->serial()] = i;
+                    stack.push_back(c);
+                }
+            }
+        }
+        sort(deps[i].begin(), deps[i].end());
+    }
+
+    // Tarjan algorithm, components are produced dependencies first
+    vector<vector<int>>     components;
+    vector<int>             index(n, -1), low(n, 0), scc(n, -1);
+    vector<int>             tstack;
+    vector<pair<int, int>>  call;
+    int                     counter = 0;
+    for (int r = 0; r < n; r++) {
+        if (index[r] >= 0) {
+            continue;
+        }
+        call.push_back(make_pair(r, 0));
+        while (!call.empty()) {
+            int v = call.back().first;
+            int k = call.back().second;
+            if (k == 0) {
+                index[v] = low[v] = counter++;
+                tstack.push_back(v);
+            }
+            if (k < int(deps[v].size())) {
+                call.back().second++;
+                int w = deps[v][k];
+                if (index[w] < 0) {
+                    call.push_back(make_pair(w, 0));
+                } else if (scc[w] < 0) {
+                    low[v] = min(low[v], index[w]);
+                }
+            } else {
+                call.pop_back();
+                if (!call.empty()) {
+                    int u  = call.back().first;
+                    low[u] = min(low[u], low[v]);
+                }
+                if (low[v] == index[v]) {
+                    vector<int> component;
+                    int         w;
+                    do {
+                        w = tstack.back();
+                        tstack.pop_back();
+                        scc[w] = components.size();
+                        component.push_back(w);
+                    } while (w != v);
+                    sort(component.begin(), component.end());
+                    components.push_back(component);
+                }
+            }
+        }
+    }
+
+    // Rank every signal of the definitions with the last component it depends on
+    vector<int>& rank = gGlobal->gRecTypeRank;
+    rank.assign(gGlobal->gTreeSerialCounter + 1, kUnknownRank);
+    rankPostOrder(vdef, rank, [&](Tree t) {
+        if (isRecSignal(t)) {
+            return scc[group[t]];
+        }
+        if (reach[t->serial()] != 1) {
+            return kNoRecRank;
+        }
+        int r = kNoRecRank;
+        for (int b = 0; b < t->arity(); b++) {
+            r = max(r, rank[t->branch(b)->serial()]);
+        }
+        return r;
+    });
+
+    gGlobal->gRecTypeFinal.assign(gGlobal->gTreeSerialCounter + 1, 0);
+    return components;
+}
+
+/**
+ * Do one step of type inference on a component of recursive signal groups.
+ * The types of the recursive signals of the component are updated to vtype and then vtype is
+ * updated to the next step for the groups to be (re)computed.
+ *
+ * @param component the recursive signal groups of the component
+ * @param work the groups of the component whose type has to be computed
  * @param vrec array of all the recursive signal groups
  * @param vdef definitions of all the recursive signal groups (vector of _lists_)
  * @param vdefSizes number of signals in each recursive signal groups
@@ -182,7 +390,8 @@ static interval arithmetic(int opcode, const interval& x, const interval& y)
  * @param inter if set to false, the interval of the new type is the union of the old one and the
  * computed one, otherwise it is the intersection
  */
-static void updateRecTypes(vector<Tree>& vrec, const vector<Tree>& vdef,
+static void updateRecTypes(const vector<int>& component, const vector<int>& work,
+                           vector<Tree>& vrec, const vector<Tree>& vdef,
                            const vector<int>& vdefSizes, vector<Type>& vtype, const bool inter)
 {
     Type         newType;
@@ -192,18 +401,16 @@ static void updateRecTypes(vector<Tree>& vrec, const vector<Tree>& vdef,
     interval     newI(NAN, NAN);
     interval     oldI(NAN, NAN);
 
-    const int n = vdef.size();
-
     CTree::startNewVisit();
 
     // init recursive types
-    for (int i = 0; i < n; i++) {
+    for (int i : component) {
         setSigType(vrec[i], vtype[i]);
         vrec[i]->setVisited();
     }
 
     // cerr << "compute recursive types" << endl;
-    for (int i = 0; i < n; i++) {
+    for (int i : work) {
         newType = T(vdef[i], gGlobal->NULLTYPEENV);
         newTuplet.clear();
         oldRecType = derefRecCert(getSigType(vrec[i]));
@@ -232,8 +439,7 @@ void typeAnnotation(Tree sig, bool causality)
     Tree sl             = symlist(sig);
     int  n              = len(sl);
 
-    int  size;
-    bool finished = false;
+    int size;
 
     vector<Tree> vrec;       ///< array of all the recursive signal groups
     vector<Tree> vdef;       ///< definitions of all the recursive signal groups (vector of _lists_)
@@ -245,6 +451,9 @@ void typeAnnotation(Tree sig, bool causality)
     vector<vector<int>> vAgeMin;  ///< age of the minimum of every subsignal of the recursive signal
     vector<vector<int>> vAgeMax;  ///< age of the maximum of every subsignal of the recursive signal
 
+    vector<vector<int>> vdeps;   ///< groups referred to by each group
+    vector<vector<int>> vusers;  ///< groups referring to each group
+
     // work variables used in widening loop
     vector<Type> newTuplet;
     TupletType   newRecType;
@@ -280,65 +489,126 @@ void typeAnnotation(Tree sig, bool causality)
     faustassert((int)vAgeMin.size() == n);
     faustassert((int)vAgeMax.size() == n);
 
+    vector<vector<int>> components = recGroupsComponents(vrec, vdef, vdeps, vusers);
+    vector<int>         rank(n);
+    for (size_t c = 0; c < components.size(); c++) {
+        for (int i : components[c]) {
+            rank[i] = c;
+        }
+    }
+
+    // The groups of component c referring to one of the changed groups
+    auto nextWork = [&](const vector<int>& changed, int c) {
+        vector<int> work;
+        for (int i : changed) {
+            for (int u : vusers[i]) {
+                if (rank[u] == c) {
+                    work.push_back(u);
+                }
+            }
+        }
+        sort(work.begin(), work.end());
+        work.erase(unique(work.begin(), work.end()), work.end());
+        return work;
+    };
+
+    // The recursive signals of a converged component keep their type for the rest of the pass
+    auto freeze = [&](const vector<int>& component, const vector<Type>& types) {
+        for (int i : component) {
+            setSigType(vrec[i], types[i]);
+            setFinalType(vrec[i]);
+        }
+    };
+
     // cerr << "compute upper bounds for recursive types" << endl;
-    for (int k = 0; k < gGlobal->gNarrowingLimit; k++) {
-        updateRecTypes(vrec, vdef, vdefSizes, vtypeUp, true);
+    for (size_t c = 0; c < components.size(); c++) {
+        gGlobal->gRecTypeCurrentRank = c;
+        vector<int> work             = components[c];
+        for (int k = 0; k < gGlobal->gNarrowingLimit && !work.empty(); k++) {
+            vector<Type> previous = vtypeUp;
+            updateRecTypes(components[c], work, vrec, vdef, vdefSizes, vtypeUp, true);
+            vector<int> changed;
+            for (int i : work) {
+                if (vtypeUp[i] != previous[i]) {
+                    changed.push_back(i);
+                }
+            }
+            work = nextWork(changed, c);
+        }
+        freeze(components[c], vtypeUp);
     }
 
     for (const auto& ty : vtypeUp) {
         vUp.push_back(derefRecCert(ty));
     }
 
+    // The types computed with the upper bounds are not final for the widening pass
+    fill(gGlobal->gRecTypeFinal.begin(), gGlobal->gRecTypeFinal.end(), 0);
+
     // cerr << "find an upperbound of the least fixpoint" << endl;
-    while (!finished) {
-        updateRecTypes(vrec, vdef, vdefSizes, vtype, false);
-
-        // check finished
-        finished = true;
-        for (int i = 0; i < n; i++) {
-            newTuplet.clear();
-            // cerr << i << "-" << *vrec[i] << ":" << *getSigType(vrec[i]) << " => " << *vtype[i] <<
-            // endl;
-            if (vtype[i] != getSigType(vrec[i])) {
-                finished   = false;
-                newRecType = derefRecCert(vtype[i]);
-                oldRecType = derefRecCert(getSigType(vrec[i]));
-                for (int j = 0; j < vdefSizes[i]; j++) {
-                    newTuplet.push_back(newRecType[j]);
-                    newI = newRecType[j]->getInterval();
-                    oldI = oldRecType[j]->getInterval();
-
-                    TRACE(cerr << gGlobal->TABBER << "inspecting " << newTuplet[j] << endl;)
-                    if (newI.lo() != oldI.lo()) {
-                        faustassert(newI.lo() < oldI.lo());
-                        vAgeMin[i][j]++;
-                        if (vAgeMin[i][j] > gGlobal->gWideningLimit) {
-                            TRACE(cerr << gGlobal->TABBER << "low widening of " << newTuplet[j]
-                                       << endl;)
-                            newI = {vUp[i][j]->getInterval().lo(), newI.hi()};
+    for (size_t c = 0; c < components.size(); c++) {
+        gGlobal->gRecTypeCurrentRank = c;
+        vector<int> work             = components[c];
+        while (!work.empty()) {
+            updateRecTypes(components[c], work, vrec, vdef, vdefSizes, vtype, false);
+
+            // check finished
+            vector<int> changed;
+            for (int i : work) {
+                newTuplet.clear();
+                // cerr << i << "-" << *vrec[i] << ":" << *getSigType(vrec[i]) << " => " <<
+                // *vtype[i] << endl;
+                if (vtype[i] != getSigType(vrec[i])) {
+                    changed.push_back(i);
+                    newRecType = derefRecCert(vtype[i]);
+                    oldRecType = derefRecCert(getSigType(vrec[i]));
+                    for (int j = 0; j < vdefSizes[i]; j++) {
+                        newTuplet.push_back(newRecType[j]);
+                        newI = newRecType[j]->getInterval();
+                        oldI = oldRecType[j]->getInterval();
+
+                        TRACE(cerr << gGlobal->TABBER << "inspecting " << newTuplet[j] << endl;)
+                        if (newI.lo() != oldI.lo()) {
+                            faustassert(newI.lo() < oldI.lo());
+                            vAgeMin[i][j]++;
+                            if (vAgeMin[i][j] > gGlobal->gWideningLimit) {
+                                TRACE(cerr << gGlobal->TABBER << "low widening of " << newTuplet[j]
+                                           << endl;)
+                                newI = {vUp[i][j]->getInterval().lo(), newI.hi()};
+                            }
                         }
-                    }
 
-                    if (newI.hi() != oldI.hi()) {
-                        faustassert(newI.hi() > oldI.hi());
-                        vAgeMax[i][j]++;
-                        if (vAgeMax[i][j] > gGlobal->gWideningLimit) {
-                            TRACE(cerr << gGlobal->TABBER << "up widening of " << newTuplet[j]
-                                       << endl;)
-                            newI = {newI.lo(), vUp[i][j]->getInterval().hi()};
+                        if (newI.hi() != oldI.hi()) {
+                            faustassert(newI.hi() > oldI.hi());
+                            vAgeMax[i][j]++;
+                            if (vAgeMax[i][j] > gGlobal->gWideningLimit) {
+                                TRACE(cerr << gGlobal->TABBER << "up widening of " << newTuplet[j]
+                                           << endl;)
+                                newI = {newI.lo(), vUp[i][j]->getInterval().hi()};
+                            }
                         }
-                    }
 
-                    newTuplet[j] = newTuplet[j]->promoteInterval(newI);
-                    TRACE(cerr << gGlobal->TABBER << "widening ended : " << newTuplet[j] << endl;)
+                        newTuplet[j] = newTuplet[j]->promoteInterval(newI);
+                        TRACE(cerr << gGlobal->TABBER << "widening ended : " << newTuplet[j]
+                                   << endl;)
+                    }
+                    vtype[i] = new TupletType(newTuplet);
                 }
-                vtype[i] = new TupletType(newTuplet);
             }
+            work = nextWork(changed, c);
         }
+        freeze(components[c], vtype);
     }
+
     // type full term
+    gGlobal->gRecTypeCurrentRank = components.size();
+    CTree::startNewVisit();
     T(sig, gGlobal->NULLTYPEENV);
     TRACE(cerr << "type success : " << endl << "BYE" << endl;)
+
+    gGlobal->gRecTypeRank.clear();
+    gGlobal->gRecTypeFinal.clear();
+    gGlobal->gRecTypeCurrentRank = INT_MAX;
 }
 
 /**
@@ -424,7 +694,7 @@ static Type T(Tree term, Tree ignoreenv)
 {
     TRACE(cerr << ++gGlobal->TABBER << "ENTER T() " << ppsig(term, MAX_ERROR_SIZE) << endl;)
 
-    if (term->isAlreadyVisited()) {
+    if (term->isAlreadyVisited() || isFinalType(term)) {
         Type ty = getSigType(term);
         TRACE(cerr << --gGlobal->TABBER << "EXIT 1 T() " << ppsig(term, MAX_ERROR_SIZE)
                    << " AS TYPE " << *ty << endl);
@@ -434,6 +704,10 @@ static Type T(Tree term, Tree ignoreenv)
         Type ty = inferSigType(term, ignoreenv);
         setSigType(term, ty);
         term->setVisited();
+        // Depends only on recursive groups whose type is already known for the current pass
+        if (recTypeRank(term) < gGlobal->gRecTypeCurrentRank) {
+            setFinalType(term);
+        }
         TRACE(cerr << --gGlobal->TABBER << "EXIT 2 T() " << ppsig(term, MAX_ERROR_SIZE)
                    << " AS TYPE " << *ty << endl);
         return ty;
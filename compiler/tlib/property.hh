@@ -22,39 +22,49 @@
 #ifndef __PROPERTY__
 #define __PROPERTY__
 
+#include <algorithm>
+#include <vector>
+
 #include "garbageable.hh"
 #include "tree.hh"
 
+/**
+ * A property associates values of type P to trees. The values are kept in a dense
+ * side table indexed by the serial number of the trees, so that an access is a single
+ * indexed load instead of a lookup in the property list of the tree.
+ */
 template <class P>
 class property : public virtual Garbageable {
-    Tree fKey;
+    std::vector<P>    fValues;
+    std::vector<bool> fDefined;
 
-    P* access(Tree t)
+    void reserve(size_t i)
     {
-        Tree d = t->getProperty(fKey);
-        return d ? (P*)(d->node().getPointer()) : 0;
+        if (i >= fValues.size()) {
+            size_t size = std::max(i + 1, fValues.size() * 2);
+            fValues.resize(size);
+            fDefined.resize(size, false);
+        }
     }
 
    public:
-    property() : fKey(tree(Node(unique("property_")))) {}
-
-    property(const char* keyname) : fKey(tree(Node(keyname))) {}
+    property() {}
 
     void set(Tree t, const P& data)
     {
-        P* p = access(t);
-        if (p) {
-            *p = data;
-        } else {
-            t->setProperty(fKey, tree(Node((new GarbageablePtr<P>(data))->getPointer())));
-        }
+        COUNT_PROPERTY_ACCESS();
+        size_t i = t->serial();
+        reserve(i);
+        fValues[i]  = data;
+        fDefined[i] = true;
     }
 
     bool get(Tree t, P& data)
     {
-        P* p = access(t);
-        if (p) {
-            data = *p;
+        COUNT_PROPERTY_ACCESS();
+        size_t i = t->serial();
+        if (i < fDefined.size() && fDefined[i]) {
+            data = fValues[i];
             return true;
         } else {
             return false;
@@ -63,87 +73,52 @@ class property : public virtual Garbageable {
 
     void clear(Tree t)
     {
-        P* p = access(t);
-        if (p) {
-            delete p;
+        size_t i = t->serial();
+        if (i < fDefined.size()) {
+            fValues[i]  = P();
+            fDefined[i] = false;
         }
-        t->clearProperty(fKey);
     }
 };
 
+// A nullptr value means no property
 template <>
 class property<Tree> : public virtual Garbageable {
-    Tree fKey;
+    std::vector<Tree> fValues;
 
    public:
-    property() : fKey(tree(Node(unique("property_")))) {}
+    property() {}
 
-    property(const char* keyname) : fKey(tree(Node(keyname))) {}
-
-    void set(Tree t, Tree data) { t->setProperty(fKey, data); }
-
-    bool get(Tree t, Tree& data)
+    void set(Tree t, Tree data)
     {
-        Tree d = t->getProperty(fKey);
-        if (d) {
-            data = d;
-            return true;
-        } else {
-            return false;
+        COUNT_PROPERTY_ACCESS();
+        size_t i = t->serial();
+        if (i >= fValues.size()) {
+            fValues.resize(std::max(i + 1, fValues.size() * 2), nullptr);
         }
+        fValues[i] = data;
     }
 
-    void clear(Tree t) { t->clearProperty(fKey); }
-};
-
-template <>
-class property<int> : public virtual Garbageable {
-    Tree fKey;
-
-   public:
-    property() : fKey(tree(Node(unique("property_")))) {}
-
-    property(const char* keyname) : fKey(tree(Node(keyname))) {}
-
-    void set(Tree t, int i) { t->setProperty(fKey, tree(Node(i))); }
-
-    bool get(Tree t, int& i)
+    bool get(Tree t, Tree& data)
     {
-        Tree d = t->getProperty(fKey);
+        COUNT_PROPERTY_ACCESS();
+        size_t i = t->serial();
+        Tree   d = (i < fValues.size()) ? fValues[i] : nullptr;
         if (d) {
-            i = d->node().getInt();
+            data = d;
             return true;
         } else {
             return false;
         }
     }
 
-    void clear(Tree t) { t->clearProperty(fKey); }
-};
-
-template <>
-class property<double> : public virtual Garbageable {
-    Tree fKey;
-
-   public:
-    property() : fKey(tree(Node(unique("property_")))) {}
-
-    property(const char* keyname) : fKey(tree(Node(keyname))) {}
-
-    void set(Tree t, double x) { t->setProperty(fKey, tree(Node(x))); }
-
-    bool get(Tree t, double& x)
+    void clear(Tree t)
     {
-        Tree d = t->getProperty(fKey);
-        if (d) {
-            x = d->node().getDouble();
-            return true;
-        } else {
-            return false;
+        size_t i = t->serial();
+        if (i < fValues.size()) {
+            fValues[i] = nullptr;
         }
     }
-
-    void clear(Tree t) { t->clearProperty(fKey); }
 };
 
 #endif
@@ -27,18 +27,11 @@
 
 #include "compatibility.hh"
 #include "exception.hh"
+#include "global.hh"
 #include "symbol.hh"
 
 using namespace std;
 
-/**
- * Hash table used to store the symbols.
- */
-
-Symbol* Symbol::gSymbolTable[kHashTableSize];
-
-map<const char*, unsigned int> Symbol::gPrefixCounters;
-
 /**
  * Search the hash table for the symbol of name \p str or returns a new one.
  * \param str the name of the symbol
@@ -64,14 +57,19 @@ Symbol* Symbol::get(const char* rawstr)
         char c = rawstr[i];
         str[i] = (c >= 0 && c < 32) ? 32 : c;
     }
-    unsigned int hsh  = calcHashKey(str.c_str());
-    int          bckt = hsh % kHashTableSize;
-    Symbol*      item = gSymbolTable[bckt];
+    unsigned int hsh = calcHashKey(str.c_str());
+    // Symbols created during static initialization do not belong to any compilation context
+    if (!gGlobal) {
+        return new Symbol(str, hsh, nullptr);
+    }
+    int      bckt  = hsh % kHashTableSize;
+    Symbol** table = gGlobal->gSymbolTable;
+    Symbol*  item  = table[bckt];
 
     while (item && !item->equiv(hsh, str.c_str())) {
         item = item->fNext;
     }
-    Symbol* r = item ? item : gSymbolTable[bckt] = new Symbol(str, hsh, gSymbolTable[bckt]);
+    Symbol* r = item ? item : table[bckt] = new Symbol(str, hsh, table[bckt]);
 
     return r;
 }
@@ -86,7 +84,7 @@ bool Symbol::isnew(const char* str)
 {
     unsigned int hsh  = calcHashKey(str);
     int          bckt = hsh % kHashTableSize;
-    Symbol*      item = gSymbolTable[bckt];
+    Symbol*      item = gGlobal->gSymbolTable[bckt];
 
     while (item && !item->equiv(hsh, str)) {
         item = item->fNext;
@@ -104,7 +102,7 @@ Symbol* Symbol::prefix(const char* str)
     char name[256];
 
     for (int n = 0; n < 10000; n++) {
-        snprintf(name, 256, "%s%d", str, gPrefixCounters[str]++);
+        snprintf(name, 256, "%s%d", str, gGlobal->gSymbolPrefixCounters[str]++);
         if (isnew(name)) {
             return get(name);
         }
@@ -171,6 +169,6 @@ ostream& Symbol::print(ostream& fout) const  ///< print a symbol on a stream
 
 void Symbol::init()
 {
-    gPrefixCounters.clear();
-    memset(gSymbolTable, 0, sizeof(Symbol*) * kHashTableSize);
+    gGlobal->gSymbolPrefixCounters.clear();
+    memset(gGlobal->gSymbolTable, 0, sizeof(Symbol*) * kHashTableSize);
 }
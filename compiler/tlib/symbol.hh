@@ -49,11 +49,12 @@
  * Symbols are unique objects with a name stored in a hash table.
  */
 class Symbol : public virtual Garbageable {
-   private:
+   public:
     static const int kHashTableSize =
         511;  ///< Size of the hash table (a prime number is recommended)
-    static Symbol* gSymbolTable[kHashTableSize];  ///< Hash table used to store the symbols
-    static std::map<const char*, unsigned int> gPrefixCounters;
+
+   private:
+    // The hash table and the prefix counters are kept in the compilation context (gGlobal)
 
     // Fields
     std::string fName;  ///< Name of the symbol
@@ -77,10 +77,12 @@ storage of trees.
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 
 #include "exception.hh"
+#include "global.hh"
 #include "tree.hh"
 
 using namespace std;
@@ -96,44 +98,30 @@ using namespace std;
         throw faustexception(error.str()); \
     }
 
-Tree         CTree::gHashTable[kHashTableSize];
-bool         CTree::gDetails       = false;
-unsigned int CTree::gVisitTime     = 0;
-size_t       CTree::gSerialCounter = 0;
+bool CTree::gDetails = false;
 
-// Constructor : add the tree to the hash table
+#ifdef PROPERTY_STATS
+thread_local size_t gPropertyAccesses = 0;
+#endif
+
+// Constructor : the tree is added to the hash table by CTree::make
 CTree::CTree(size_t hk, const Node& n, const tvec& br)
     : fNode(n),
       fType(0),
       fHashKey(hk),
-      fSerial(++gSerialCounter),
+      fSerial(++gGlobal->gTreeSerialCounter),
       fAperture(calcTreeAperture(n, br)),
       fVisitTime(0),
       fBranch(br)
 {
-    // link in the hash table
-    int j         = hk % kHashTableSize;
-    fNext         = gHashTable[j];
-    gHashTable[j] = this;
 }
 
 // Destructor : remove the tree from the hash table
 CTree::~CTree()
 {
-    int  i = fHashKey % kHashTableSize;
-    Tree t = gHashTable[i];
-
-    // printf("Delete of "); this->print(); printf("\n");
-    if (t == this) {
-        gHashTable[i] = fNext;
-    } else {
-        Tree p = nullptr;
-        while (t != this) {
-            p = t;
-            t = t->fNext;
-        }
-        faustassert(p);
-        p->fNext = fNext;
+    // The whole table is dropped with the compilation context
+    if (!gGlobal->gArena.isCleaningUp()) {
+        gGlobal->gTreeTable.remove(this);
     }
 }
 
@@ -149,8 +137,9 @@ size_t CTree::calcTreeHash(const Node& n, const tvec& br)
     tvec::const_iterator b  = br.begin();
     tvec::const_iterator z  = br.end();
 
+    // Combine the branch keys so that permutations or small integer nodes do not collide
     while (b != z) {
-        hk = (hk << 1) ^ (hk >> 20) ^ ((*b)->fHashKey);
+        hk ^= (*b)->fHashKey + 0x9e3779b97f4a7c15ULL + (hk << 6) + (hk >> 2);
         ++b;
     }
     return hk;
@@ -168,12 +157,12 @@ Tree CTree::make(const Node& n, int ar, Tree* tbl)
 Tree CTree::make(const Node& n, const tvec& br)
 {
     size_t hk = calcTreeHash(n, br);
-    Tree   t  = gHashTable[hk % kHashTableSize];
-
-    while (t && !t->equiv(n, br)) {
-        t = t->fNext;
+    Tree   t  = gGlobal->gTreeTable.find(hk, n, br);
+    if (!t) {
+        t = new CTree(hk, n, br);
+        gGlobal->gTreeTable.insert(t);
     }
-    return (t) ? t : new CTree(hk, n, br);
+    return t;
 }
 
 ostream& CTree::print(ostream& fout) const
@@ -199,28 +188,182 @@ ostream& CTree::print(ostream& fout) const
 
 void CTree::control()
 {
-    printf("\ngHashTable Content :\n\n");
-    for (int i = 0; i < kHashTableSize; i++) {
-        Tree t = gHashTable[i];
-        if (t) {
-            printf("%4d = ", i);
-            while (t) {
-                /*t->print();*/
-                printf(" => ");
-                t = t->fNext;
+    gGlobal->gTreeTable.printStats(cout);
+}
+
+void CTree::init()
+{
+    gGlobal->gTreeSerialCounter = 0;
+    gGlobal->gTreeVisitTime     = 0;
+    gGlobal->gTreeTable.clear();
+}
+
+void CTree::startNewVisit()
+{
+    ++gGlobal->gTreeVisitTime;
+}
+
+bool CTree::isAlreadyVisited()
+{
+    return fVisitTime == gGlobal->gTreeVisitTime;
+}
+
+void CTree::setVisited()
+{
+    fVisitTime = gGlobal->gTreeVisitTime;
+}
+
+/*****************************************************************************
+                            TreeHashTable
+*****************************************************************************/
+
+TreeHashTable::TreeHashTable(int shard_bits) : fShards(size_t(1) << shard_bits), fShardBits(shard_bits)
+{
+    fStats = Stats();
+    for (auto& shard : fShards) {
+        allocate(shard, kInitialSize);
+    }
+}
+
+TreeHashTable::~TreeHashTable()
+{
+    for (auto& shard : fShards) {
+        delete[] shard.fSlots;
+    }
+}
+
+// Tree hash keys are built from node pointers: mix their bits to get usable low bits
+size_t TreeHashTable::mix(size_t hk)
+{
+    uint64_t x = hk;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return size_t(x);
+}
+
+void TreeHashTable::allocate(Shard& shard, size_t size)
+{
+    shard.fSlots = new Slot[size]();
+    shard.fMask  = size - 1;
+    shard.fCount = 0;
+}
+
+void TreeHashTable::grow(Shard& shard)
+{
+    Slot*  old_slots = shard.fSlots;
+    size_t old_size  = shard.fMask + 1;
+    allocate(shard, old_size * 2);
+    for (size_t i = 0; i < old_size; i++) {
+        if (old_slots[i].fTree) {
+            size_t j = getIndex(shard, mix(old_slots[i].fHashKey));
+            while (shard.fSlots[j].fTree) {
+                j = (j + 1) & shard.fMask;
             }
-            printf("VOID\n");
+            shard.fSlots[j] = old_slots[i];
+            shard.fCount++;
         }
     }
-    printf("\nEnd gHashTable\n");
+    delete[] old_slots;
+    fStats.fGrowths++;
 }
 
-void CTree::init()
+Tree TreeHashTable::find(size_t hk, const Node& n, const tvec& br)
+{
+    size_t mixed = mix(hk);
+    Shard& shard = getShard(mixed);
+    size_t probe = 1;
+    for (size_t i = getIndex(shard, mixed);; i = (i + 1) & shard.fMask, probe++) {
+        Slot& slot = shard.fSlots[i];
+        if (!slot.fTree || (slot.fHashKey == hk && slot.fTree->equiv(n, br))) {
+            fStats.fProbes += probe;
+            fStats.fMaxProbe = std::max(fStats.fMaxProbe, probe);
+            if (slot.fTree) {
+                fStats.fHits++;
+            } else {
+                fStats.fMisses++;
+            }
+            return slot.fTree;
+        }
+    }
+}
+
+void TreeHashTable::insert(Tree t)
+{
+    size_t mixed = mix(t->fHashKey);
+    Shard& shard = getShard(mixed);
+    if ((shard.fCount + 1) * 100 > (shard.fMask + 1) * kMaxLoad) {
+        grow(shard);
+    }
+    size_t i = getIndex(shard, mixed);
+    while (shard.fSlots[i].fTree) {
+        i = (i + 1) & shard.fMask;
+    }
+    shard.fSlots[i].fHashKey = t->fHashKey;
+    shard.fSlots[i].fTree    = t;
+    shard.fCount++;
+}
+
+// Backward shift deletion: no tombstones are needed with linear probing
+void TreeHashTable::remove(Tree t)
+{
+    size_t mixed = mix(t->fHashKey);
+    Shard& shard = getShard(mixed);
+    size_t i     = getIndex(shard, mixed);
+    while (shard.fSlots[i].fTree != t) {
+        faustassert(shard.fSlots[i].fTree);
+        i = (i + 1) & shard.fMask;
+    }
+    for (size_t j = (i + 1) & shard.fMask; shard.fSlots[j].fTree; j = (j + 1) & shard.fMask) {
+        // Move the entry at 'j' in the hole at 'i' if its home slot is not in ]i, j]
+        size_t home = getIndex(shard, mix(shard.fSlots[j].fHashKey));
+        if (((j - home) & shard.fMask) >= ((j - i) & shard.fMask)) {
+            shard.fSlots[i] = shard.fSlots[j];
+            i               = j;
+        }
+    }
+    shard.fSlots[i] = Slot();
+    shard.fCount--;
+}
+
+void TreeHashTable::clear()
+{
+    for (auto& shard : fShards) {
+        delete[] shard.fSlots;
+        allocate(shard, kInitialSize);
+    }
+    fStats = Stats();
+}
+
+size_t TreeHashTable::size() const
+{
+    size_t size = 0;
+    for (const auto& shard : fShards) {
+        size += shard.fCount;
+    }
+    return size;
+}
+
+size_t TreeHashTable::capacity() const
+{
+    size_t capacity = 0;
+    for (const auto& shard : fShards) {
+        capacity += shard.fMask + 1;
+    }
+    return capacity;
+}
+
+void TreeHashTable::printStats(ostream& out) const
 {
-    gSerialCounter = 0;
-    gVisitTime     = 0;
-    gDetails       = false;
-    memset(gHashTable, 0, sizeof(Tree) * kHashTableSize);
+    size_t lookups = fStats.fHits + fStats.fMisses;
+    out << "hash-consing : " << size() << " trees in " << capacity() << " slots ("
+        << fShards.size() << " shard(s), " << fStats.fGrowths << " growth(s)), " << lookups
+        << " lookups, " << fStats.fHits << " hits ("
+        << ((lookups) ? (100. * fStats.fHits / lookups) : 0.) << "%), " << fStats.fMisses
+        << " misses, average probe " << ((lookups) ? (double(fStats.fProbes) / lookups) : 0.)
+        << ", max probe " << fStats.fMaxProbe << endl;
 }
 
 // if t has a node of type int, return it, or float, return casted to int, otherwise error
@@ -85,6 +85,15 @@ typedef CTree* Tree;
 typedef std::map<Tree, Tree> plist;
 typedef std::vector<Tree>    tvec;
 
+// Number of property accesses done by the calling thread, reported by the phase profiler when
+// compiled with PROPERTY_STATS (the counter would slow down the hottest path of the compiler)
+#ifdef PROPERTY_STATS
+extern thread_local size_t gPropertyAccesses;
+#define COUNT_PROPERTY_ACCESS() gPropertyAccesses++
+#else
+#define COUNT_PROPERTY_ACCESS()
+#endif
+
 /**
  * A CTree = (Node x [CTree]) is the association of a content Node and a list of subtrees
  * called branches. In order to maximize the sharing of trees, hashconsing techniques are used.
@@ -102,19 +111,16 @@ typedef std::vector<Tree>    tvec;
  **/
 
 class LIBFAUST_API CTree : public virtual Garbageable {
-   private:
-    static const int kHashTableSize = 400009;     ///< size of the hash table (prime number)
-    static size_t    gSerialCounter;              ///< the serial number counter
-    static Tree      gHashTable[kHashTableSize];  ///< hash table used for "hash consing"
+    friend class TreeHashTable;
 
    public:
+    // The hash table, the serial number counter and the visit time are kept in the
+    // compilation context (gGlobal), so that several contexts can be used in separated threads
+
     static bool gDetails;  ///< Ctree::print() print with more details when true
-    static unsigned int
-        gVisitTime;  ///< Should be incremented for each new visit to keep track of visited tree
 
    private:
     // fields
-    Tree         fNext;        ///< next tree in the same hashtable entry
     Node         fNode;        ///< the node content of the tree
     void*        fType;        ///< the type of a tree
     plist        fProperties;  ///< the properties list attached to the tree
@@ -161,7 +167,7 @@ class LIBFAUST_API CTree : public virtual Garbageable {
     // Print a tree and the hash table (for debugging purposes)
     std::ostream& print(
         std::ostream& fout) const;  ///< print recursively the content of a tree on a stream
-    static void control();          ///< print the hash table content (for debug purpose)
+    static void control();          ///< print the hash table statistics (for debug purpose)
 
     static void init();
 
@@ -170,12 +176,16 @@ class LIBFAUST_API CTree : public virtual Garbageable {
     void* getType() { return fType; }
 
     // Keep track of visited trees (WARNING : non reentrant)
-    static void startNewVisit() { ++gVisitTime; }
-    bool        isAlreadyVisited() { return fVisitTime == gVisitTime; }
-    void        setVisited() { fVisitTime = gVisitTime; }
+    static void startNewVisit();
+    bool        isAlreadyVisited();
+    void        setVisited();
 
     // Property list of a tree
-    void setProperty(Tree key, Tree value) { fProperties[key] = value; }
+    void setProperty(Tree key, Tree value)
+    {
+        COUNT_PROPERTY_ACCESS();
+        fProperties[key] = value;
+    }
     void clearProperty(Tree key) { fProperties.erase(key); }
     void clearProperties() { fProperties = plist(); }
 
@@ -183,6 +193,7 @@ class LIBFAUST_API CTree : public virtual Garbageable {
 
     Tree getProperty(Tree key)
     {
+        COUNT_PROPERTY_ACCESS();
         plist::iterator i = fProperties.find(key);
         if (i == fProperties.end()) {
             return 0;
@@ -192,6 +203,67 @@ class LIBFAUST_API CTree : public virtual Garbageable {
     }
 };
 
+/**
+ * The hash-consing table of CTrees: an open addressing table with linear probing,
+ * where the hash key is stored inline next to the tree pointer, so that most failed
+ * comparisons do not have to read the tree itself. The table grows when its load factor
+ * exceeds kMaxLoad. It can be split in several shards (selected by the hash key),
+ * each one growing separately, so that the shards can later be locked separately.
+ */
+class LIBFAUST_API TreeHashTable {
+   public:
+    struct Stats {
+        size_t fHits;      ///< lookups finding an existing tree
+        size_t fMisses;    ///< lookups creating a new tree
+        size_t fProbes;    ///< slots inspected by all lookups
+        size_t fMaxProbe;  ///< longest probe sequence
+        size_t fGrowths;   ///< number of times a shard has been resized
+    };
+
+    static const size_t kInitialSize = 1 << 12;  ///< initial number of slots of a shard
+    static const int    kMaxLoad     = 70;       ///< maximal load factor (in percent)
+
+   private:
+    struct Slot {
+        size_t fHashKey;
+        Tree   fTree;
+    };
+
+    struct Shard {
+        Slot*  fSlots;
+        size_t fMask;
+        size_t fCount;
+    };
+
+    std::vector<Shard> fShards;
+    int                fShardBits;
+    Stats              fStats;
+
+    static size_t mix(size_t hk);
+    Shard&        getShard(size_t mixed) { return fShards[mixed & (fShards.size() - 1)]; }
+    size_t        getIndex(const Shard& shard, size_t mixed) const
+    {
+        return (mixed >> fShardBits) & shard.fMask;
+    }
+    void grow(Shard& shard);
+    void allocate(Shard& shard, size_t size);
+
+   public:
+    TreeHashTable(int shard_bits = 0);
+    ~TreeHashTable();
+
+    Tree find(size_t hk, const Node& n, const tvec& br);  ///< return an equivalent tree or nullptr
+    void insert(Tree t);  ///< add a tree known not to be in the table
+    void remove(Tree t);  ///< remove a tree from the table
+    void clear();
+
+    size_t       size() const;
+    size_t       capacity() const;
+    const Stats& getStats() const { return fStats; }
+
+    void printStats(std::ostream& out) const;
+};
+
 //---------------------------------API---------------------------------------
 
 // To build trees
@@ -8,11 +8,13 @@
  * @brief A signal visitor that builds a graph of dependencies
  * when full is true, the graph contains all dependencies,
  * otherwise it contains only immediate dependencies.
+ * G is either digraph<Tree> or compactdigraph<Tree>::builder.
  */
+template <typename G>
 class SigDependenciesGraph : public SignalVisitor {
    protected:
-    digraph<Tree> fGraph;
-    bool          fFullGraph;
+    G    fGraph;
+    bool fFullGraph;
 
    public:
     SigDependenciesGraph(bool full) : SignalVisitor(), fFullGraph(full)
@@ -21,7 +23,7 @@ class SigDependenciesGraph : public SignalVisitor {
         fMessage = "SigDependenciesGraph";
     }
 
-    digraph<Tree> getGraph() { return fGraph; }
+    const G& getGraph() const { return fGraph; }
 
    protected:
     void visit(Tree t) override;
@@ -35,7 +37,8 @@ class SigDependenciesGraph : public SignalVisitor {
  *
  * @param full: boolean to indicate if we want the full graph
  */
-void SigDependenciesGraph::visit(Tree t)
+template <typename G>
+void SigDependenciesGraph<G>::visit(Tree t)
 {
     int  i;
     Tree w, x, y, tbl, ri;
@@ -128,11 +131,25 @@ void SigDependenciesGraph::visit(Tree t)
  */
 digraph<Tree> immediateGraph(Tree L)
 {
-    SigDependenciesGraph g(false);
+    SigDependenciesGraph<digraph<Tree>> g(false);
     g.mapself(L);
     return g.getGraph();
 }
 
+/**
+ * @brief Compute the immediate Graph of a list of signals as a frozen compact graph,
+ * without building the intermediate map based digraph
+ *
+ * @param L list of signals
+ * @return compactdigraph<Tree>
+ */
+compactdigraph<Tree> immediateCompactGraph(Tree L)
+{
+    SigDependenciesGraph<compactdigraph<Tree>::builder> g(false);
+    g.mapself(L);
+    return compactdigraph<Tree>(g.getGraph());
+}
+
 /**
  * @brief Compute the full Graph (all dependencies) of a list of signals
  *
@@ -141,7 +158,7 @@ digraph<Tree> immediateGraph(Tree L)
  */
 digraph<Tree> fullGraph(Tree L)
 {
-    SigDependenciesGraph g(true);
+    SigDependenciesGraph<digraph<Tree>> g(true);
     g.mapself(L);
     return g.getGraph();
 }
@@ -154,6 +171,5 @@ digraph<Tree> fullGraph(Tree L)
  */
 std::vector<Tree> compilationOrder(Tree L)
 {
-    digraph<Tree> G = immediateGraph(L);
-    return serialize(G);
+    return serialize(immediateCompactGraph(L));
 }
\ No newline at end of file
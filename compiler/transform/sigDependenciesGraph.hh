@@ -1,4 +1,5 @@
 #pragma once
+#include "CompactDigraph.hh"
 #include "DirectedGraph.hh"
 #include "DirectedGraphAlgorythm.hh"
 #include "signalVisitor.hh"
@@ -11,6 +12,14 @@
  */
 digraph<Tree> immediateGraph(Tree L);
 
+/**
+ * @brief Compute the immediate Graph of a list of signals as a compact graph
+ *
+ * @param L list of signals
+ * @return compactdigraph<Tree>
+ */
+compactdigraph<Tree> immediateCompactGraph(Tree L);
+
 /**
  * @brief Compute the full Graph of a list of signals
  *
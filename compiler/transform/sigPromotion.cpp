@@ -328,7 +328,7 @@ Tree SignalPromotion::transformation(Tree sig)
                     stringstream error;
                     error << "WARNING : potential division by zero (" << i1 << "/" << j1 << ")"
                           << endl;
-                    gWarningMessages.push_back(error.str());
+                    gGlobal->gWarningMessages.push_back(error.str());
                 }
                 // the result of a division is always a float
                 return sigBinOp(op, smartFloatCast(tx, self(x)), smartFloatCast(ty, self(y)));
@@ -348,7 +348,7 @@ Tree SignalPromotion::transformation(Tree sig)
                     stringstream error;
                     error << "WARNING : bit shift operation with negative argument (" << i1
                           << ") in " << ppsig(sig, MAX_ERROR_SIZE) << endl;
-                    gWarningMessages.push_back(error.str());
+                    gGlobal->gWarningMessages.push_back(error.str());
                 }
                 // these operations require integers
                 return sigBinOp(op, smartIntCast(tx, self(x)), smartIntCast(ty, self(y)));
@@ -544,12 +544,12 @@ Tree SignalTablePromotion::safeSigRDTbl(Tree sig, Tree tbl, Tree size_aux, Tree
         ri_i = interval(INT32_MIN, INT32_MAX);
     }
     if (ri_i.lo() < 0 || ri_i.hi() >= size) {
-        if (gAllWarning) {
+        if (gGlobal->gAllWarning) {
             stringstream error;
             error << "WARNING : RDTbl read index [" << ri_i.lo() << ":" << ri_i.hi()
                   << "] is outside of table size (" << size << ") in " << ppsig(sig, MAX_ERROR_SIZE)
                   << endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
         return sigRDTbl(self(tbl), sigMax(sigInt(0), sigMin(self(ri), sigInt(size - 1))));
     } else {
@@ -575,12 +575,12 @@ Tree SignalTablePromotion::safeSigWRTbl(Tree sig, Tree size_aux, Tree gen, Tree
         wi_i = interval(INT32_MIN, INT32_MAX);
     }
     if (wi_i.lo() < 0 || wi_i.hi() >= size) {
-        if (gAllWarning) {
+        if (gGlobal->gAllWarning) {
             stringstream error;
             error << "WARNING : WRTbl write index [" << wi_i.lo() << ":" << wi_i.hi()
                   << "] is outside of table size (" << size << ") in " << ppsig(sig, MAX_ERROR_SIZE)
                   << endl;
-            gWarningMessages.push_back(error.str());
+            gGlobal->gWarningMessages.push_back(error.str());
         }
         return sigWRTbl(self(size_aux), self(gen),
                         sigMax(sigInt(0), sigMin(self(wi), sigInt(size - 1))), self(ws));
@@ -615,11 +615,11 @@ Tree SignalIntCastPromotion::transformation(Tree sig)
     if (isSigIntCast(sig, x)) {
         interval x_i = getCertifiedSigType(x)->getInterval();
         if (x_i.lo() <= INT32_MIN || x_i.hi() >= INT32_MAX) {
-            if (gAllWarning) {
+            if (gGlobal->gAllWarning) {
                 stringstream error;
                 error << "WARNING : float to integer conversion [" << x_i.lo() << ":" << x_i.hi()
                       << "] is outside of integer range in " << ppsig(sig, MAX_ERROR_SIZE) << endl;
-                gWarningMessages.push_back(error.str());
+                gGlobal->gWarningMessages.push_back(error.str());
             }
             return sigIntCast(sigMin(sigReal(INT32_MAX), sigMax(x, sigReal(INT32_MIN))));
         }
@@ -55,7 +55,7 @@
 #endif
 
 // TODO place in global.hh
-static std::unordered_map<Tree, std::set<Tree>> gDependencies;
+static thread_local std::unordered_map<Tree, std::set<Tree>> gDependencies;
 
 /**
  * @brief Compute the set of dependencies of a signal
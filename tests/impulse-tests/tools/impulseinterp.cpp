@@ -96,6 +96,36 @@ int main(int argc, char* argv[])
             delete DSP;
         }
         
+        {
+            string error_msg;
+            // Test writeInterpreterDSPFactoryToBinaryFile/readInterpreterDSPFactoryFromBitcodeFile
+            stringstream str; str << "/var/tmp/interp-factory-binary" << factory << ".fbc";
+            writeInterpreterDSPFactoryToBinaryFile(factory, str.str());
+            deleteInterpreterDSPFactory(static_cast<interpreter_dsp_factory*>(factory));
+            factory = readInterpreterDSPFactoryFromBitcodeFile(str.str(), error_msg);
+            
+            if (!factory) {
+                cerr << "ERROR in readInterpreterDSPFactoryFromBitcodeFile (binary) " << error_msg;
+                exit(-1);
+            }
+            
+            dsp* DSP = factory->createDSPInstance();
+            if (!DSP) {
+                cerr << "ERROR : createDSPInstance " << endl;
+                exit(-1);
+            }
+            
+            // print general informations
+            printHeader(DSP, nbsamples);
+            
+            runDSP1(factory, argv[1], linenum, nbsamples/4);
+            runDSP1(factory, argv[1], linenum, nbsamples/4, false, false, true);
+            runPolyDSP1(factory, linenum, nbsamples/4, 4);
+            runPolyDSP1(factory, linenum, nbsamples/4, 1);
+        
+            delete DSP;
+        }
+        
         {
             string error_msg;
             // Test writeInterpreterDSPFactoryToBitcode/readInterpreterDSPFactoryFromBitcode
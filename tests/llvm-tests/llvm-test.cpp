@@ -26,6 +26,9 @@
 #include <fstream>
 #include <sstream>
 #include <thread>
+#include <vector>
+#include <cmath>
+#include <sys/stat.h>
 
 #include "faust/dsp/llvm-dsp.h"
 #include "faust/dsp/libfaust.h"
@@ -83,6 +86,40 @@ struct TestUI : public GenericUI {
     
 };
 
+// Outputs of 'count' samples computed by an instance of 'factory', its inputs being fed with a ramp
+static vector<FAUSTFLOAT> computeDSP(llvm_dsp_factory* factory, int count)
+{
+    dsp* DSP = factory->createDSPInstance();
+    if (!DSP) {
+        cerr << "Cannot create instance "<< endl;
+        exit(EXIT_FAILURE);
+    }
+    DSP->init(44100);
+    
+    int inputs = DSP->getNumInputs();
+    int outputs = DSP->getNumOutputs();
+    vector<vector<FAUSTFLOAT>> in_buffers(inputs, vector<FAUSTFLOAT>(count));
+    vector<vector<FAUSTFLOAT>> out_buffers(outputs, vector<FAUSTFLOAT>(count));
+    vector<FAUSTFLOAT*> in_ptrs, out_ptrs;
+    for (int chan = 0; chan < inputs; chan++) {
+        for (int frame = 0; frame < count; frame++) {
+            in_buffers[chan][frame] = FAUSTFLOAT(frame % 100) / FAUSTFLOAT(100) - FAUSTFLOAT(0.5);
+        }
+        in_ptrs.push_back(in_buffers[chan].data());
+    }
+    for (int chan = 0; chan < outputs; chan++) {
+        out_ptrs.push_back(out_buffers[chan].data());
+    }
+    DSP->compute(count, in_ptrs.data(), out_ptrs.data());
+    delete DSP;
+    
+    vector<FAUSTFLOAT> res;
+    for (int chan = 0; chan < outputs; chan++) {
+        res.insert(res.end(), out_buffers[chan].begin(), out_buffers[chan].end());
+    }
+    return res;
+}
+
 // The foreign function has to be exported with C linkage and should be made public
 FAUST_API extern "C" float ForeignLLVM(float val)
 {
@@ -276,6 +313,127 @@ static void Test(const char* dspFileAux)
         deleteDSPFactory(factory);
     }
     
+    cout << "=============================\n";
+    cout << "Test createDSPFactoryFromString with FAUST_DSP_CACHE\n";
+    {
+        // A factory restored from the cache has to behave like a compiled one
+        const char* argv[8];
+        int argc = 0;
+        argv[argc++] = "-cn";
+        argv[argc++] = "cached";
+        argv[argc] = nullptr; // NULL terminated argv
+        string code = "process = _ * hslider(\"gain\", 0.5, 0, 1, 0.01) : + ~ *(0.5);";
+        string cache_dir = "faust-dsp-cache";
+        mkdir(cache_dir.c_str(), 0755);
+        
+        unsetenv("FAUST_DSP_CACHE");
+        llvm_dsp_factory* factory = createDSPFactoryFromString("FaustCache", code, argc, argv, JIT_TARGET, error_msg, 2);
+        if (!factory) {
+            cerr << "Cannot create factory : " << error_msg;
+            exit(EXIT_FAILURE);
+        }
+        string name = factory->getName();
+        string ir = writeDSPFactoryToIR(factory);
+        string machine = writeDSPFactoryToMachine(factory, JIT_TARGET);
+        // Compiled again from the module at the factory optimisation level
+        string host_machine = writeDSPFactoryToMachine(factory, getDSPMachineTarget());
+        deleteDSPFactory(factory);
+        
+        // The second factory is always restored from the cache
+        setenv("FAUST_DSP_CACHE", cache_dir.c_str(), 1);
+        for (int i = 0; i < 2; i++) {
+            factory = createDSPFactoryFromString("FaustCache", code, argc, argv, JIT_TARGET, error_msg, 2);
+            if (!factory) {
+                cerr << "Cannot create factory : " << error_msg;
+                exit(EXIT_FAILURE);
+            }
+            if (factory->getName() != name) {
+                cerr << "ERROR in FAUST_DSP_CACHE getName : " << factory->getName() << " " << name << "\n";
+            }
+            // The bitcode layout depends on the LLVM context, so it is only checked to be loadable
+            llvm_dsp_factory* bitcode_factory = readDSPFactoryFromBitcode(writeDSPFactoryToBitcode(factory), JIT_TARGET, error_msg);
+            if (!bitcode_factory) {
+                cerr << "ERROR in FAUST_DSP_CACHE writeDSPFactoryToBitcode : " << error_msg;
+            } else {
+                deleteDSPFactory(bitcode_factory);
+            }
+            if (writeDSPFactoryToIR(factory) != ir) {
+                cerr << "ERROR in FAUST_DSP_CACHE writeDSPFactoryToIR\n";
+            }
+            if (writeDSPFactoryToMachine(factory, JIT_TARGET) != machine) {
+                cerr << "ERROR in FAUST_DSP_CACHE writeDSPFactoryToMachine\n";
+            }
+            if (writeDSPFactoryToMachine(factory, getDSPMachineTarget()) != host_machine) {
+                cerr << "ERROR in FAUST_DSP_CACHE optimisation level\n";
+            }
+            dsp* DSP = factory->createDSPInstance();
+            if (!DSP) {
+                cerr << "Cannot create instance "<< endl;
+                exit(EXIT_FAILURE);
+            }
+            delete DSP;
+            deleteDSPFactory(factory);
+        }
+        unsetenv("FAUST_DSP_CACHE");
+        cout << "FAUST_DSP_CACHE OK\n";
+    }
+    
+    cout << "=============================\n";
+    cout << "Test createDSPFactoryFromString with FAUST_LLVM_LAZY\n";
+    {
+        // Several living factories compiled by the shared lazy JIT have to compute like MCJIT ones
+        vector<string> codes = {
+            "process = _ * hslider(\"gain\", 0.5, 0, 1, 0.01) : + ~ *(0.5);",
+            "process = _ <: @(7), (mem : *(0.5)) :> _;",
+            "process = _ <: *(2), (+ ~ *(0.25) : sin);",
+            "process = (+(1)~_) : float : *(0.001) : sin : *(vslider(\"vol\", 0.7, 0, 1, 0.1));"
+        };
+        int count = 512;
+        
+        unsetenv("FAUST_LLVM_LAZY");
+        vector<vector<FAUSTFLOAT>> references;
+        for (const auto& code : codes) {
+            llvm_dsp_factory* factory = createDSPFactoryFromString("FaustLazy", code, 0, nullptr, JIT_TARGET, error_msg, -1);
+            if (!factory) {
+                cerr << "Cannot create factory : " << error_msg;
+                exit(EXIT_FAILURE);
+            }
+            references.push_back(computeDSP(factory, count));
+            deleteDSPFactory(factory);
+        }
+        
+        // Default levels, then per function levels
+        for (const char* levels : { "1", "compute:3,instanceInit:1,*:0" }) {
+            setenv("FAUST_LLVM_LAZY", levels, 1);
+            // Factories deleted by a round are reused by the next one
+            for (int round = 0; round < 3; round++) {
+                vector<llvm_dsp_factory*> factories;
+                for (const auto& code : codes) {
+                    llvm_dsp_factory* factory = createDSPFactoryFromString("FaustLazy", code, 0, nullptr, JIT_TARGET, error_msg, -1);
+                    if (!factory) {
+                        cerr << "Cannot create factory : " << error_msg;
+                        exit(EXIT_FAILURE);
+                    }
+                    factories.push_back(factory);
+                }
+                for (size_t i = 0; i < factories.size(); i++) {
+                    vector<FAUSTFLOAT> outputs = computeDSP(factories[i], count);
+                    for (size_t j = 0; j < outputs.size(); j++) {
+                        if (std::fabs(outputs[j] - references[i][j]) > 1e-5 * (1 + std::fabs(references[i][j]))) {
+                            cerr << "ERROR in FAUST_LLVM_LAZY " << levels << " output : " << codes[i] << " " << outputs[j] << " " << references[i][j] << "\n";
+                            break;
+                        }
+                    }
+                }
+                for (const auto& factory : factories) {
+                    deleteDSPFactory(factory);
+                }
+            }
+        }
+        unsetenv("FAUST_LLVM_LAZY");
+        cout << "FAUST_LLVM_LAZY OK\n";
+    }
+    
     // Test generateAuxFilesFromFile/generateAuxFilesFromString to generate a SVG file
     string tempDir = "/private/var/tmp/";
     int argc2 = 0;
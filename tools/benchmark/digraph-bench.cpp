@@ -0,0 +1,155 @@
+/************************************************************************
+ FAUST Architecture File
+ Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+ ---------------------------------------------------------------------
+ This Architecture section is free software; you can redistribute it
+ and/or modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 3 of
+ the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; If not, see <http://www.gnu.org/licenses/>.
+
+ EXCEPTION : As a special exception, you may create a larger work
+ that contains this FAUST architecture section and distribute
+ that work under terms of your choice, so long as this FAUST
+ architecture section is not modified.
+ ************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "CompactDigraph.hh"
+#include "DirectedGraph.hh"
+#include "DirectedGraphAlgorythm.hh"
+#include "Schedule.hh"
+#include "faust/misc.h"
+
+using namespace std;
+
+/*
+ Compare the map based digraph<N> with the frozen compactdigraph<N> used by the compiler,
+ on a random signal-like DAG : nodes are pointers (like Tree) connected to 1 to 3 previously
+ created nodes, a few of them with a non zero (delay) weight.
+ Measured operations are the ones done when scheduling signals : building the graph,
+ roots + dfschedule, parallelize and the strongly connected components.
+*/
+
+struct Node {
+    int fNum;
+};
+
+using Clock = chrono::steady_clock;
+
+static double elapsed(Clock::time_point start)
+{
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    if (isopt(argv, "-h") || isopt(argv, "-help")) {
+        cout << "digraph-bench [-nodes <num>] [-run <num>]" << endl;
+        cout << "-nodes <num> : number of nodes of the graph (default 50000)\n";
+        cout << "-run <num> : number of measures, the best one is kept (default 5)\n";
+        exit(EXIT_FAILURE);
+    }
+
+    int size = lopt(argv, "-nodes", 50000);
+    int runs = lopt(argv, "-run", 5);
+
+    // Random graph description, nodes are allocated separately so that their addresses are
+    // not in creation order
+    mt19937                       gen(1234);
+    vector<Node*>                 nodes;
+    vector<tuple<int, int, int>>  connections;
+    uniform_int_distribution<int> degree(1, 3);
+    for (int i = 0; i < size; i++) {
+        nodes.push_back(new Node{i});
+        if (i > 0) {
+            int d = degree(gen);
+            for (int k = 0; k < d; k++) {
+                uniform_int_distribution<int> dst(max(0, i - 200), i - 1);
+                connections.emplace_back(i, dst(gen), (gen() % 16 == 0) ? 1 : 0);
+            }
+        }
+    }
+    shuffle(nodes.begin(), nodes.end(), gen);
+
+    double tmap[4]     = {1e9, 1e9, 1e9, 1e9};
+    double tcompact[4] = {1e9, 1e9, 1e9, 1e9};
+    bool   same        = true;
+
+    for (int run = 0; run < runs; run++) {
+        // digraph<N>
+        auto           start = Clock::now();
+        digraph<Node*> G;
+        for (int i = 0; i < size; i++) {
+            G.add(nodes[i]);
+        }
+        for (const auto& c : connections) {
+            G.add(nodes[get<0>(c)], nodes[get<1>(c)], get<2>(c));
+        }
+        tmap[0] = min(tmap[0], elapsed(start));
+
+        start                    = Clock::now();
+        schedule<Node*> S1       = dfschedule(G);
+        tmap[1]                  = min(tmap[1], elapsed(start));
+        start                    = Clock::now();
+        vector<vector<Node*>> P1 = parallelize(G);
+        tmap[2]                  = min(tmap[2], elapsed(start));
+        start                    = Clock::now();
+        int c1                   = cycles(G);
+        tmap[3]                  = min(tmap[3], elapsed(start));
+
+        // compactdigraph<N>
+        start = Clock::now();
+        compactdigraph<Node*>::builder B;
+        for (int i = 0; i < size; i++) {
+            B.add(nodes[i]);
+        }
+        for (const auto& c : connections) {
+            B.add(nodes[get<0>(c)], nodes[get<1>(c)], get<2>(c));
+        }
+        compactdigraph<Node*> H(B);
+        tcompact[0] = min(tcompact[0], elapsed(start));
+
+        start                    = Clock::now();
+        schedule<Node*> S2       = dfschedule(H);
+        tcompact[1]              = min(tcompact[1], elapsed(start));
+        start                    = Clock::now();
+        vector<vector<Node*>> P2 = parallelize(H);
+        tcompact[2]              = min(tcompact[2], elapsed(start));
+        start                    = Clock::now();
+        int c2                   = cycles(H);
+        tcompact[3]              = min(tcompact[3], elapsed(start));
+
+        same = same && (S1.elements() == S2.elements()) && (P1 == P2) && (c1 == c2);
+    }
+
+    const char* names[4] = {"build", "dfschedule", "parallelize", "cycles"};
+    cout << "nodes : " << size << " connections : " << connections.size() << endl;
+    for (int i = 0; i < 4; i++) {
+        cout << names[i] << " : digraph " << tmap[i] << " ms, compactdigraph " << tcompact[i]
+             << " ms, speedup " << (tmap[i] / tcompact[i]) << endl;
+    }
+    if (!same) {
+        cerr << "ERROR : digraph and compactdigraph give different results" << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    for (auto n : nodes) {
+        delete n;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/************************************************************************
+ FAUST Architecture File
+ Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+ ---------------------------------------------------------------------
+ This Architecture section is free software; you can redistribute it
+ and/or modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 3 of
+ the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; If not, see <http://www.gnu.org/licenses/>.
+
+ EXCEPTION : As a special exception, you may create a larger work
+ that contains this FAUST architecture section and distribute
+ that work under terms of your choice, so long as this FAUST
+ architecture section is not modified.
+ ************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "faust/dsp/interpreter-dsp.h"
+#include "faust/dsp/llvm-dsp.h"
+#include "faust/misc.h"
+
+using namespace std;
+
+/*
+ Measure the libfaust compilation throughput when the same DSP is compiled
+ concurrently by 1, 2, 4... threads (up to -threads <num>), with the Interpreter or the LLVM backend.
+ Each compilation uses a distinct 'name_app' so that the factory cache is never hit.
+*/
+
+static atomic<int> gErrors(0);
+static bool gLLVM = false;
+
+static void compileLoop(const string& dsp_content, int thread, int runs, int argc, const char* argv[])
+{
+    for (int run = 0; run < runs; run++) {
+        string error_msg;
+        string name_app = "mt_" + to_string(thread) + "_" + to_string(run);
+        dsp_factory* factory = nullptr;
+        if (gLLVM) {
+            factory = createDSPFactoryFromString(name_app, dsp_content, argc, argv, "", error_msg, -1);
+        } else {
+            factory = createInterpreterDSPFactoryFromString(name_app, dsp_content, argc, argv, error_msg);
+        }
+        if (factory) {
+            if (gLLVM) {
+                deleteDSPFactory(static_cast<llvm_dsp_factory*>(factory));
+            } else {
+                deleteInterpreterDSPFactory(static_cast<interpreter_dsp_factory*>(factory));
+            }
+        } else {
+            cerr << error_msg;
+            gErrors++;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || isopt(argv, "-h") || isopt(argv, "-help")) {
+        cout << "faustbench-compile-mt [-llvm] [-threads <num>] [-run <num>] [additional Faust options] foo.dsp" << endl;
+        cout << "-llvm : use the LLVM backend (and its JIT) instead of the Interpreter one\n";
+        cout << "-threads <num> : maximum number of compilation threads (default 4)\n";
+        cout << "-run <num> : number of compilations done by each thread (default 10)\n";
+        exit(EXIT_FAILURE);
+    }
+
+    cout << "Libfaust version : " << getCLibFaustVersion() << endl;
+
+    int max_threads = lopt(argv, "-threads", 4);
+    int runs = lopt(argv, "-run", 10);
+    gLLVM = isopt(argv, "-llvm");
+
+    // Keep the Faust options only
+    int argc1 = 0;
+    const char* argv1[64];
+    for (int i = 1; i < argc - 1; i++) {
+        if (string(argv[i]) == "-threads" || string(argv[i]) == "-run") {
+            i++;
+            continue;
+        }
+        if (string(argv[i]) == "-llvm") {
+            continue;
+        }
+        argv1[argc1++] = argv[i];
+    }
+    argv1[argc1] = nullptr;
+
+    string dsp_content = pathToContent(argv[argc - 1]);
+    if (dsp_content == "") {
+        cerr << "ERROR : cannot read " << argv[argc - 1] << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    startMTDSPFactories();
+
+    double base = 0.;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.push_back(thread(compileLoop, dsp_content, t, runs, argc1, argv1));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double rate = (threads * runs) / elapsed;
+        if (threads == 1) base = rate;
+        cout << "threads : " << threads << " compilations/sec : " << rate << " speedup : " << (rate / base) << endl;
+    }
+
+    stopMTDSPFactories();
+
+    if (gErrors > 0) {
+        cerr << gErrors << " compilation(s) failed" << endl;
+        exit(EXIT_FAILURE);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+/************************************************************************
+ FAUST Architecture File
+ Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+ ---------------------------------------------------------------------
+ This Architecture section is free software; you can redistribute it
+ and/or modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 3 of
+ the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; If not, see <http://www.gnu.org/licenses/>.
+
+ EXCEPTION : As a special exception, you may create a larger work
+ that contains this FAUST architecture section and distribute
+ that work under terms of your choice, so long as this FAUST
+ architecture section is not modified.
+ ************************************************************************/
+
+#include <iostream>
+#include <string>
+
+#include "faust/dsp/interpreter-dsp.h"
+#include "faust/misc.h"
+
+using namespace std;
+
+/*
+ Convert an interpreter factory between the textual and the binary .fbc formats
+ (the input format is detected when reading).
+*/
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3 || isopt(argv, "-h") || isopt(argv, "-help")) {
+        cout << "fbc-convert [-binary|-text] <input.fbc> <output.fbc>" << endl;
+        cout << "-binary : write the binary container (default)\n";
+        cout << "-text : write the textual format\n";
+        exit(EXIT_FAILURE);
+    }
+
+    string                   error_msg;
+    string                   input   = argv[argc - 2];
+    string                   output  = argv[argc - 1];
+    interpreter_dsp_factory* factory = readInterpreterDSPFactoryFromBitcodeFile(input, error_msg);
+    if (!factory) {
+        cerr << "ERROR : cannot read '" << input << "' : " << error_msg;
+        exit(EXIT_FAILURE);
+    }
+
+    bool res = (isopt(argv, "-text")) ? writeInterpreterDSPFactoryToBitcodeFile(factory, output)
+                                      : writeInterpreterDSPFactoryToBinaryFile(factory, output);
+    deleteInterpreterDSPFactory(factory);
+
+    if (!res) {
+        cerr << "ERROR : cannot write '" << output << "'" << endl;
+        exit(EXIT_FAILURE);
+    }
+    return 0;
+}
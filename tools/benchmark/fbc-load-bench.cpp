@@ -0,0 +1,97 @@
+/************************************************************************
+ FAUST Architecture File
+ Copyright (C) 2024 GRAME, Centre National de Creation Musicale
+ ---------------------------------------------------------------------
+ This Architecture section is free software; you can redistribute it
+ and/or modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 3 of
+ the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; If not, see <http://www.gnu.org/licenses/>.
+
+ EXCEPTION : As a special exception, you may create a larger work
+ that contains this FAUST architecture section and distribute
+ that work under terms of your choice, so long as this FAUST
+ architecture section is not modified.
+ ************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "faust/dsp/interpreter-dsp.h"
+#include "faust/misc.h"
+
+using namespace std;
+
+/*
+ Compare the loading time of an interpreter factory from the textual and the binary .fbc formats.
+ Both versions are generated from the given .fbc (or .dsp) file, and loaded with
+ readInterpreterDSPFactoryFromBitcode, then the first DSP instance is created.
+*/
+
+using Clock = chrono::steady_clock;
+
+static double elapsed(Clock::time_point start)
+{
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Best loading time (in ms) of the given code, and first instance creation time
+static void measure(const string& name, const string& code, int runs)
+{
+    double load = 1e100, create = 1e100;
+    for (int i = 0; i < runs; i++) {
+        string                   error_msg;
+        Clock::time_point        start   = Clock::now();
+        interpreter_dsp_factory* factory = readInterpreterDSPFactoryFromBitcode(code, error_msg);
+        if (!factory) {
+            cerr << "ERROR : " << error_msg;
+            exit(EXIT_FAILURE);
+        }
+        load          = min(load, elapsed(start));
+        start         = Clock::now();
+        dsp* instance = factory->createDSPInstance();
+        create        = min(create, elapsed(start));
+        delete instance;
+        deleteInterpreterDSPFactory(factory);
+    }
+    cout << name << " : size = " << code.size() << " bytes, load = " << load
+         << " ms, first instance = " << create << " ms" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || isopt(argv, "-h") || isopt(argv, "-help")) {
+        cout << "fbc-load-bench [-run <num>] <foo.fbc|foo.dsp>" << endl;
+        cout << "-run <num> : number of measures, the best one is kept (default 10)\n";
+        exit(EXIT_FAILURE);
+    }
+
+    int                      runs = lopt(argv, "-run", 10);
+    string                   error_msg;
+    string                   input = argv[argc - 1];
+    interpreter_dsp_factory* factory =
+        (input.find(".dsp") != string::npos)
+            ? createInterpreterDSPFactoryFromFile(input, 0, nullptr, error_msg)
+            : readInterpreterDSPFactoryFromBitcodeFile(input, error_msg);
+    if (!factory) {
+        cerr << "ERROR : cannot read '" << input << "' : " << error_msg;
+        exit(EXIT_FAILURE);
+    }
+
+    string text   = writeInterpreterDSPFactoryToBitcode(factory);
+    string binary = writeInterpreterDSPFactoryToBinary(factory);
+    deleteInterpreterDSPFactory(factory);
+
+    measure("text  ", text, runs);
+    measure("binary", binary, runs);
+    return 0;
+}
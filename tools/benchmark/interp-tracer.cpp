@@ -170,19 +170,23 @@ int main(int argc, char* argv[])
     bool is_output = isopt(argv, "-output");
     bool is_control = isopt(argv, "-control");
     int time_out = lopt(argv, "-timeout", 10);
+    const char* profile = lopts(argv, "-profile", nullptr);
     
-    if (isopt(argv, "-h") || isopt(argv, "-help") || trace_mode < 0 || trace_mode > 6) {
-        cout << "interp-tracer [-trace <1-6>] [-control] [-output] [-noui] [-timeout <num>] [additional Faust options (-ftz xx)] foo.dsp" << endl;
+    if (isopt(argv, "-h") || isopt(argv, "-help") || trace_mode < 0 || trace_mode > 8) {
+        cout << "interp-tracer [-trace <1-8>] [-control] [-output] [-noui] [-timeout <num>] [-profile <file>] [additional Faust options (-ftz xx)] foo.dsp" << endl;
         cout << "-control to activate min/max control check then setting all controllers (inside their range) in a random way\n";
         cout << "-input to test effects with various test signals (impulse, noise)\n";
         cout << "-output to display output samples\n";
         cout << "-timeout <num> to stop the application after a given timeout in seconds (default = 10s)\n";
+        cout << "-profile <file> to append the optimized 'DSP' block to <file> and exit (see fbc_superinstructions.py)\n";
         cout << "-trace 1 to collect FP_SUBNORMAL only\n";
         cout << "-trace 2 to collect FP_SUBNORMAL, FP_INFINITE and FP_NAN\n";
         cout << "-trace 3 to collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW, DIV_BY_ZERO, CAST_INT_OVERFLOW and NEGATIVE_BITSHIFT\n";
         cout << "-trace 4 to collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW, DIV_BY_ZERO, CAST_INT_OVERFLOW, NEGATIVE_BITSHIFT and LOAD/STORE errors, fails at first FP_INFINITE, FP_NAN, CAST_INT_OVERFLOW or LOAD/STORE errors\n";
         cout << "-trace 5 to collect FP_SUBNORMAL, FP_INFINITE, FP_NAN, INTEGER_OVERFLOW, DIV_BY_ZERO, CAST_INT_OVERFLOW, NEGATIVE_BITSHIFT and LOAD/STORE errors, continue after FP_INFINITE, FP_NAN or CAST_INT_OVERFLOW, fails after LOAD/STORE errors\n";
         cout << "-trace 6 to only check LOAD/STORE errors and exit\n";
+        cout << "-trace 7 to only check LOAD/STORE errors and exit, and dump the program memory layout of the first cycles as DumpMem-fooXXX.txt files\n";
+        cout << "-trace 8 to profile the executed instructions, reported per block, opcode and statement\n";
         exit(EXIT_FAILURE);
     }
     
@@ -199,7 +203,7 @@ int main(int argc, char* argv[])
             || string(argv[i]) == "-input"
             || string(argv[i]) == "-output") {
             continue;
-        } else if (string(argv[i]) == "-trace" || string(argv[i]) == "-timeout") {
+        } else if (string(argv[i]) == "-trace" || string(argv[i]) == "-timeout" || string(argv[i]) == "-profile") {
             i++;
             continue;
         }
@@ -241,6 +245,20 @@ int main(int argc, char* argv[])
             exit(EXIT_FAILURE);
         }
         
+        // The blocks of the factory are optimized when the first instance is created
+        if (profile) {
+            string code = writeInterpreterDSPFactoryToBitcode(static_cast<interpreter_dsp_factory*>(factory));
+            size_t pos = code.find("\ndsp_block\n");
+            if (pos == string::npos) {
+                cerr << "Cannot find the 'DSP' block" << endl;
+                exit(EXIT_FAILURE);
+            }
+            ofstream out(profile, ios::app);
+            out << "dsp_block " << factory->getName() << endl;
+            out << code.substr(pos + 11);
+            exit(EXIT_SUCCESS);
+        }
+        
         if (isopt(argv, "-double")) {
             cout << "Running in double..." << endl;
         }